@@ -0,0 +1,87 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/benchmarks/allocation_counter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "absl/base/optimization.h"
+
+namespace xla::cpu {
+
+static std::atomic<size_t> num_heap_allocations = 0;
+
+size_t GetNumHeapAllocations() {
+  return num_heap_allocations.load(std::memory_order_relaxed);
+}
+
+static void* Allocate(size_t size) {
+  num_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size ? size : 1);
+}
+
+static void* AllocateAligned(size_t size, std::align_val_t alignment) {
+  num_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  size_t align = std::max(static_cast<size_t>(alignment), sizeof(void*));
+  void* ptr = nullptr;
+  return posix_memalign(&ptr, align, size ? size : 1) == 0 ? ptr : nullptr;
+}
+
+}  // namespace xla::cpu
+
+// Replacements for the global allocation functions. All array versions call
+// into the scalar ones by default, so we don't need to replace them. We abort
+// on allocation failure instead of throwing, as XLA might be compiled without
+// exceptions.
+
+void* operator new(size_t size) {
+  void* ptr = xla::cpu::Allocate(size);
+  if (ABSL_PREDICT_FALSE(ptr == nullptr)) std::abort();
+  return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return xla::cpu::Allocate(size);
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  void* ptr = xla::cpu::AllocateAligned(size, alignment);
+  if (ABSL_PREDICT_FALSE(ptr == nullptr)) std::abort();
+  return ptr;
+}
+
+void* operator new(size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return xla::cpu::AllocateAligned(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+void operator delete(void* ptr, std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
@@ -0,0 +1,31 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_BENCHMARKS_ALLOCATION_COUNTER_H_
+#define XLA_BACKENDS_CPU_BENCHMARKS_ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+
+namespace xla::cpu {
+
+// Returns the number of heap allocations done via the global `operator new`
+// since the process start. Allocation counting is enabled by linking this
+// library into the benchmark binary, as it replaces global `operator new` and
+// `operator delete` with counting versions that forward to malloc and free.
+size_t GetNumHeapAllocations();
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_BENCHMARKS_ALLOCATION_COUNTER_H_
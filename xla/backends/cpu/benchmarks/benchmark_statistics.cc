@@ -0,0 +1,98 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/benchmarks/benchmark_statistics.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "xla/tsl/platform/test_benchmark.h"
+
+namespace xla::cpu {
+
+namespace {
+
+double Median(std::vector<double> values) {
+  size_t mid = values.size() / 2;
+  std::nth_element(values.begin(), values.begin() + mid, values.end());
+  double median = values[mid];
+  if (values.size() % 2 == 0) {
+    median = (median + *std::max_element(values.begin(),
+                                         values.begin() + mid)) / 2;
+  }
+  return median;
+}
+
+double Mean(const std::vector<double>& values) {
+  double sum = 0;
+  for (double value : values) sum += value;
+  return sum / values.size();
+}
+
+// Two-sided 97.5% quantiles of the Student's t-distribution for 1 to 30
+// degrees of freedom. For more degrees of freedom we use the normal quantile.
+constexpr std::array<double, 30> kStudentT975 = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201,  2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080,  2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+constexpr double kNormal975 = 1.960;
+
+// Scales the median absolute deviation to be a consistent estimator of the
+// standard deviation for normally distributed values.
+constexpr double kMadToStddev = 1.4826;
+
+}  // namespace
+
+double MeanWithoutOutliers(const std::vector<double>& values) {
+  if (values.empty()) return 0;
+
+  double median = Median(values);
+  std::vector<double> deviations;
+  deviations.reserve(values.size());
+  for (double value : values) deviations.push_back(std::abs(value - median));
+  double threshold = 3 * kMadToStddev * Median(deviations);
+
+  std::vector<double> inliers;
+  inliers.reserve(values.size());
+  for (double value : values) {
+    if (std::abs(value - median) <= threshold) inliers.push_back(value);
+  }
+  return Mean(inliers);
+}
+
+double ConfidenceInterval95(const std::vector<double>& values) {
+  if (values.size() < 2) return 0;
+
+  double mean = Mean(values);
+  double sum_squares = 0;
+  for (double value : values) sum_squares += (value - mean) * (value - mean);
+  double stddev = std::sqrt(sum_squares / (values.size() - 1));
+
+  size_t degrees_of_freedom = values.size() - 1;
+  double t = degrees_of_freedom <= kStudentT975.size()
+                 ? kStudentT975[degrees_of_freedom - 1]
+                 : kNormal975;
+  return t * stddev / std::sqrt(static_cast<double>(values.size()));
+}
+
+void AddRobustStatistics(benchmark::internal::Benchmark* benchmark) {
+  benchmark->ComputeStatistics("mean_no_outliers", MeanWithoutOutliers);
+  benchmark->ComputeStatistics("ci95", ConfidenceInterval95);
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,43 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_BENCHMARKS_BENCHMARK_STATISTICS_H_
+#define XLA_BACKENDS_CPU_BENCHMARKS_BENCHMARK_STATISTICS_H_
+
+#include <vector>
+
+#include "xla/tsl/platform/test_benchmark.h"
+
+namespace xla::cpu {
+
+// Returns the mean of `values` after dropping outliers, i.e. values that are
+// more than three (normal-consistent) median absolute deviations away from
+// the median.
+double MeanWithoutOutliers(const std::vector<double>& values);
+
+// Returns the half-width of the two-sided 95% confidence interval of the mean
+// of `values`, based on the Student's t-distribution.
+double ConfidenceInterval95(const std::vector<double>& values);
+
+// Adds `mean_no_outliers` and `ci95` aggregates to `benchmark`. Aggregates are
+// computed across repetitions, so they are only reported when the benchmark
+// runs with `--benchmark_repetitions` (or `Repetitions()`) greater than one:
+//
+//   BENCHMARK(BM_Foo)->Apply(AddRobustStatistics);
+void AddRobustStatistics(benchmark::internal::Benchmark* benchmark);
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_BENCHMARKS_BENCHMARK_STATISTICS_H_
@@ -0,0 +1,47 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/benchmarks/benchmark_statistics.h"
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace xla::cpu {
+namespace {
+
+TEST(BenchmarkStatisticsTest, MeanWithoutOutliers) {
+  EXPECT_DOUBLE_EQ(MeanWithoutOutliers({}), 0);
+  EXPECT_DOUBLE_EQ(MeanWithoutOutliers({1.0, 2.0, 3.0}), 2.0);
+  // A single slow run (e.g. preempted by another process) is dropped.
+  EXPECT_DOUBLE_EQ(MeanWithoutOutliers({10.0, 11.0, 9.0, 10.0, 100.0}), 10.0);
+}
+
+TEST(BenchmarkStatisticsTest, MeanWithoutOutliersKeepsIdenticalValues) {
+  EXPECT_DOUBLE_EQ(MeanWithoutOutliers({5.0, 5.0, 5.0, 5.0}), 5.0);
+}
+
+TEST(BenchmarkStatisticsTest, ConfidenceInterval95) {
+  EXPECT_DOUBLE_EQ(ConfidenceInterval95({}), 0);
+  EXPECT_DOUBLE_EQ(ConfidenceInterval95({1.0}), 0);
+  EXPECT_DOUBLE_EQ(ConfidenceInterval95({2.0, 2.0, 2.0}), 0);
+  // Mean 2, sample stddev 1, t(2) = 4.303.
+  EXPECT_NEAR(ConfidenceInterval95({1.0, 2.0, 3.0}), 4.303 / std::sqrt(3.0),
+              1e-9);
+}
+
+}  // namespace
+}  // namespace xla::cpu
@@ -456,6 +456,15 @@ BENCHMARK(BM_Conv2D<F32>)
     ->Args({32, 64, 64, 4, 3, 3, 16})
     ->Args({32, 32, 32, 96, 3, 3, 96});
 
+// Shapes from ResNet-50 3x3 convolutions (Winograd convolution).
+BENCHMARK(BM_Conv2D<F32>)
+    ->MeasureProcessCPUTime()
+    ->Args({1, 56, 56, 64, 3, 3, 64})
+    ->Args({1, 28, 28, 128, 3, 3, 128})
+    ->Args({1, 14, 14, 256, 3, 3, 256})
+    ->Args({1, 7, 7, 512, 3, 3, 512})
+    ->Args({8, 28, 28, 128, 3, 3, 128});
+
 // -------------------------------------------------------------------------- //
 // Grouped convolution
 // -------------------------------------------------------------------------- //
@@ -464,6 +473,15 @@ BENCHMARK(BM_GroupedConv2D)
     ->MeasureProcessCPUTime()
     ->Args({1, 45, 45, 1024, 5, 5, 1024, 1024});
 
+// Shapes from MobileNet depthwise convolutions (direct convolution).
+BENCHMARK(BM_GroupedConv2D)
+    ->MeasureProcessCPUTime()
+    ->Args({1, 112, 112, 32, 3, 3, 32, 32})
+    ->Args({1, 56, 56, 128, 3, 3, 128, 128})
+    ->Args({1, 28, 28, 256, 3, 3, 256, 256})
+    ->Args({1, 14, 14, 512, 3, 3, 512, 512})
+    ->Args({1, 56, 56, 128, 3, 3, 256, 128});
+
 // -------------------------------------------------------------------------- //
 // 1D and 2D strided convolutions
 // -------------------------------------------------------------------------- //
@@ -30,9 +30,8 @@ limitations under the License.
 
 namespace xla::cpu {
 
-static void BM_DagExecution(benchmark::State& state) {
-  int64_t d0 = state.range(0);
-
+static void RunDagExecution(benchmark::State& state, int64_t d0,
+                            const HloBenchmarkOptions& benchmark_options) {
   // We use this benchmark to test how well XLA does the scheduling of the HLO
   // module to extract available parallelism, and how well ThunkExecutor
   // exploits that parallelism at run time.
@@ -88,7 +87,21 @@ static void BM_DagExecution(benchmark::State& state) {
   auto p0 = *LiteralUtil::CreateRandomLiteral<F32>(shape, &engine, 1.0f, 0.1f);
 
   std::vector<const Literal*> args = {&p0};
-  CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d0", absl::StrCat(d0)}}));
+  CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d0", absl::StrCat(d0)}},
+                           benchmark_options));
+}
+
+static void BM_DagExecution(benchmark::State& state) {
+  RunDagExecution(state, state.range(0), HloBenchmarkOptions());
+}
+
+// Runs the same DAG with a work stealing ready queue in the thunk executor and
+// a varying number of threads to show how it scales with available cores.
+static void BM_DagExecutionWorkStealing(benchmark::State& state) {
+  HloBenchmarkOptions benchmark_options;
+  benchmark_options.use_work_stealing_ready_queue = state.range(1);
+  benchmark_options.num_threads = state.range(2);
+  RunDagExecution(state, state.range(0), benchmark_options);
 }
 
 BENCHMARK(BM_DagExecution)
@@ -100,4 +113,9 @@ BENCHMARK(BM_DagExecution)
     ->Arg(8192)
     ->Arg(16384);
 
+BENCHMARK(BM_DagExecutionWorkStealing)
+    ->MeasureProcessCPUTime()
+    ->ArgNames({"d0", "work_stealing", "num_threads"})
+    ->ArgsProduct({{1024, 16384}, {0, 1}, {1, 2, 4, 8, 16}});
+
 }  // namespace xla::cpu
@@ -15,9 +15,11 @@ limitations under the License.
 
 #include <cstdint>
 #include <random>
+#include <string>
 #include <vector>
 
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "xla/backends/cpu/benchmarks/hlo_benchmark_runner.h"
@@ -102,4 +104,87 @@ static void BM_BatchedDot(benchmark::State& state) {
 BENCHMARK_BATCHED_DOT(F32);   // Shown as "11" in the benchmark name.
 BENCHMARK_BATCHED_DOT(BF16);  // Shown as "16" in the benchmark name.
 
+// Small-batch matmul with weights passed as a parameter or as a constant.
+// Constant weights are packed by DotThunk once and reused across executions.
+static void BM_DotWithWeights(benchmark::State& state) {
+  bool constant_weights = state.range(0);
+  int64_t batch = state.range(1);
+  int64_t d = state.range(2);
+
+  std::minstd_rand0 engine;
+  auto x_shape = ShapeUtil::MakeShape(F32, {batch, d});
+  auto w_shape = ShapeUtil::MakeShape(F32, {d, d});
+  Literal x = *LiteralUtil::CreateRandomLiteral<F32>(x_shape, &engine, 1.0f,
+                                                     0.1f);
+  Literal w = *LiteralUtil::CreateRandomLiteral<F32>(w_shape, &engine, 1.0f,
+                                                     0.1f);
+
+  absl::string_view hlo = R"(
+    HloModule dot_with_weights_b$batch_d$d
+
+    ENTRY e {
+      x = f32[$batch,$d] parameter(0)
+      $weights
+      ROOT dot = f32[$batch,$d] dot(x, w),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    }
+  )";
+
+  std::string weights =
+      constant_weights
+          ? absl::StrCat("w = f32[$d,$d] constant(", w.ToStringWithoutShape(),
+                         ")")
+          : "w = f32[$d,$d] parameter(1)";
+
+  std::vector<const Literal*> args = {&x};
+  if (!constant_weights) args.push_back(&w);
+
+  std::string module = absl::StrReplaceAll(hlo, {{"$weights", weights}});
+  CHECK_OK(RunHloBenchmark(
+      state, module, args,
+      {{"$batch", absl::StrCat(batch)}, {"$d", absl::StrCat(d)}}));
+}
+
+BENCHMARK(BM_DotWithWeights)
+    ->MeasureProcessCPUTime()
+    ->ArgNames({"constant", "batch", "d"})
+    ->ArgsProduct({{0, 1}, {1, 4, 16}, {256, 1024}});
+
+// Large BF16 matmul executed with AMX tile instructions or upcasted to F32 and
+// executed with Eigen (default).
+static void BM_Bf16Dot(benchmark::State& state) {
+  bool use_amx_dot = state.range(0);
+  int64_t d = state.range(1);
+
+  absl::string_view hlo = R"(
+    HloModule bf16_dot_$d
+
+    ENTRY e {
+      p0 = bf16[$d,$d] parameter(0)
+      p1 = bf16[$d,$d] parameter(1)
+      ROOT dot = bf16[$d,$d] dot(p0, p1),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    }
+  )";
+
+  std::minstd_rand0 engine;
+  auto shape = ShapeUtil::MakeShape(BF16, {d, d});
+  Literal p0 = *LiteralUtil::CreateRandomLiteral<BF16>(shape, &engine, 1.0f,
+                                                       0.1f);
+  Literal p1 = *LiteralUtil::CreateRandomLiteral<BF16>(shape, &engine, 1.0f,
+                                                       0.1f);
+
+  HloBenchmarkOptions benchmark_options;
+  benchmark_options.use_amx_dot = use_amx_dot;
+
+  std::vector<const Literal*> args = {&p0, &p1};
+  CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d", absl::StrCat(d)}},
+                           benchmark_options));
+}
+
+BENCHMARK(BM_Bf16Dot)
+    ->MeasureProcessCPUTime()
+    ->ArgNames({"amx", "d"})
+    ->ArgsProduct({{0, 1}, {128, 256, 512, 1024, 2048}});
+
 }  // namespace xla::cpu
@@ -18,6 +18,7 @@ limitations under the License.
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -27,7 +28,10 @@ limitations under the License.
 #include "absl/strings/str_replace.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/blocking_counter.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
+#include "xla/backends/cpu/benchmarks/allocation_counter.h"
 #include "xla/hlo/builder/xla_computation.h"
 #include "xla/hlo/ir/hlo_input_output_alias_config.h"
 #include "xla/hlo/ir/hlo_module.h"
@@ -42,6 +46,7 @@ limitations under the License.
 #include "xla/pjrt/pjrt_executable.h"
 #include "xla/pjrt/plugin/xla_cpu/cpu_client_options.h"
 #include "xla/pjrt/plugin/xla_cpu/xla_cpu_pjrt_client.h"
+#include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/shape_util.h"
 #include "xla/tests/test_utils.h"
@@ -140,6 +145,7 @@ absl::Status RunHloBenchmark(benchmark::State& state,
                              StrToStrMapping replacements,
                              const HloBenchmarkOptions& benchmark_options) {
   xla::CpuClientOptions client_options;
+  client_options.num_threads = benchmark_options.num_threads;
   TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtClient> client,
                       xla::GetXlaPjrtCpuClient(client_options));
   PjRtDevice* device = client->devices().front();
@@ -159,6 +165,22 @@ absl::Status RunHloBenchmark(benchmark::State& state,
     compile_options.executable_build_options.mutable_debug_options()
         ->add_xla_disable_hlo_passes("cpu-parallel-task-assigner");
   }
+  if (benchmark_options.use_work_stealing_ready_queue) {
+    compile_options.executable_build_options.mutable_debug_options()
+        ->set_xla_cpu_experimental_work_stealing_ready_queue(true);
+  }
+  if (benchmark_options.use_execute_state_pool) {
+    compile_options.executable_build_options.mutable_debug_options()
+        ->set_xla_cpu_experimental_execute_state_pool(true);
+  }
+  if (benchmark_options.use_amx_dot) {
+    compile_options.executable_build_options.mutable_debug_options()
+        ->set_xla_cpu_experimental_amx_dot(true);
+  }
+  if (benchmark_options.use_reduction_fusion_emitter) {
+    compile_options.executable_build_options.mutable_debug_options()
+        ->set_xla_cpu_experimental_reduction_fusion_emitter(true);
+  }
   std::unique_ptr<PjRtLoadedExecutable> executable;
   if (benchmark_options.aot_options) {
     auto* cpu_client = tsl::down_cast<TfrtCpuClient*>(client.get());
@@ -285,14 +307,51 @@ absl::Status RunHloBenchmark(benchmark::State& state,
     return absl::OkStatus();
   };
 
-  // Warm up executable.
-  TF_RETURN_IF_ERROR(run_benchmark_once());
+  // Warm up executable until the execution time stabilizes, so that caches,
+  // thread pools and lazily initialized runtime state don't skew results.
+  CHECK_GE(benchmark_options.max_warmup_iterations, 1);
+  std::optional<absl::Duration> previous_time;
+  int32_t num_warmup_iterations = 0;
+  while (num_warmup_iterations < benchmark_options.max_warmup_iterations) {
+    absl::Time start = absl::Now();
+    TF_RETURN_IF_ERROR(run_benchmark_once());
+    absl::Duration time = absl::Now() - start;
+    ++num_warmup_iterations;
+    if (previous_time.has_value() &&
+        absl::AbsDuration(time - *previous_time) <=
+            *previous_time * benchmark_options.warmup_tolerance) {
+      break;
+    }
+    previous_time = time;
+  }
 
   // Benchmark executable.
+  size_t num_heap_allocations = GetNumHeapAllocations();
   for (auto _ : state) {
     TF_RETURN_IF_ERROR(run_benchmark_once());
   }
 
+  // Report the average number of heap allocations per benchmark iteration.
+  state.counters["allocs_per_iter"] =
+      benchmark::Counter(GetNumHeapAllocations() - num_heap_allocations,
+                         benchmark::Counter::kAvgIterations);
+
+  if (benchmark_options.max_warmup_iterations > 1) {
+    state.counters["warmup_iters"] = num_warmup_iterations;
+  }
+
+  // Report FLOP/s and bytes/s across all parallel executions.
+  if (benchmark_options.report_cost_analysis) {
+    HloCostAnalysis cost_analysis;
+    TF_RETURN_IF_ERROR(module->entry_computation()->Accept(&cost_analysis));
+    state.counters["flops"] = benchmark::Counter(
+        cost_analysis.flop_count() * benchmark_options.num_executions,
+        benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["bytes_accessed"] = benchmark::Counter(
+        cost_analysis.bytes_accessed() * benchmark_options.num_executions,
+        benchmark::Counter::kIsIterationInvariantRate);
+  }
+
   return absl::OkStatus();
 }
 
@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstdint>
 #include <initializer_list>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "absl/status/status.h"
@@ -36,7 +37,25 @@ using StrToStrMapping =
 
 struct HloBenchmarkOptions {
   int32_t num_executions = 1;
+  // Maximum number of warmup runs before measuring. Warmup stops early once
+  // two consecutive runs take times within `warmup_tolerance` of each other.
+  int32_t max_warmup_iterations = 1;
+  double warmup_tolerance = 0.05;
+  // If true, reports `flops` and `bytes_accessed` rate counters (FLOP/s and
+  // bytes/s) computed by HloCostAnalysis of the unoptimized HLO module.
+  bool report_cost_analysis = false;
   bool disable_parallel_task_assigner = false;
+  // If true, thunk executor uses work stealing ready queue.
+  bool use_work_stealing_ready_queue = false;
+  // If true, thunk executor reuses execute states across executions.
+  bool use_execute_state_pool = false;
+  // If true, large BF16 dots are executed with AMX tile instructions.
+  bool use_amx_dot = false;
+
+  // If true, fused row reductions are emitted by the reduction fusion emitter.
+  bool use_reduction_fusion_emitter = false;
+  // If set, overrides the number of threads used by the PjRt client.
+  std::optional<int> num_threads;
   // If not null, AOT compilation will be used.
   std::unique_ptr<AotCompilationOptions> aot_options;
 };
@@ -86,6 +86,41 @@ static void BM_ReduceAddBF16(benchmark::State& state) {
   CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d0", absl::StrCat(d0)}}));
 }
 
+// Reduces `multiply(p0, p0)` so that the reduction ends up in a loop fusion.
+// The second argument selects the reduction fusion emitter.
+static void BM_ReduceSumOfSquaresF32(benchmark::State& state) {
+  int64_t d0 = state.range(0);
+
+  absl::string_view hlo = R"(
+    HloModule reduce_sum_of_squares_f32_$d0
+
+    add {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT add = f32[] add(p0, p1)
+    }
+
+    ENTRY e {
+      p0 = f32[256,$d0] parameter(0)
+      square = f32[256,$d0] multiply(p0, p0)
+      c0 = f32[] constant(0)
+      ROOT reduce = f32[256] reduce(square, c0), dimensions={1}, to_apply=add
+    }
+  )";
+
+  std::minstd_rand0 engine;
+
+  auto shape = ShapeUtil::MakeShape(F32, {256, d0});
+  auto p0 = *LiteralUtil::CreateRandomLiteral<F32>(shape, &engine, 1.0f, 0.1f);
+
+  HloBenchmarkOptions benchmark_options;
+  benchmark_options.use_reduction_fusion_emitter = state.range(1) != 0;
+
+  std::vector<const Literal*> args = {&p0};
+  CHECK_OK(RunHloBenchmark(state, hlo, args, {{"$d0", absl::StrCat(d0)}},
+                           benchmark_options));
+}
+
 #define BENCHMARK_SIZES(NAME)   \
   BENCHMARK(NAME)               \
       ->MeasureProcessCPUTime() \
@@ -99,4 +134,8 @@ static void BM_ReduceAddBF16(benchmark::State& state) {
 BENCHMARK_SIZES(BM_ReduceAddF32);
 BENCHMARK_SIZES(BM_ReduceAddBF16);
 
+BENCHMARK(BM_ReduceSumOfSquaresF32)
+    ->MeasureProcessCPUTime()
+    ->ArgsProduct({{128, 1024, 8192}, {0, 1}});
+
 }  // namespace xla::cpu
@@ -97,7 +97,13 @@ static void BM_TopK_BF16(benchmark::State& state) {
       ->Args({64, 16, 64})                 \
       ->Args({64, 64, 64})
 
-BENCHMARK_TOPK(BM_TopKCustomCall_F32);
+BENCHMARK_TOPK(BM_TopKCustomCall_F32)
+    // Large vocabulary decoding.
+    ->Args({1, 1, 256 * 1024})
+    ->Args({16, 1, 256 * 1024})
+    ->Args({64, 1, 256 * 1024})
+    ->Args({16, 8, 256 * 1024})
+    ->Args({64, 8, 256 * 1024});
 BENCHMARK_TOPK(BM_TopK_BF16);
 
 }  // namespace xla::cpu
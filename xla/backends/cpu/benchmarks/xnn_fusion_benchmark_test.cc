@@ -154,6 +154,113 @@ static void BM_XnnDotAndEltwiseF32(benchmark::State& state) {
   CHECK_OK(RunFusionBenchmark(state, hlo, /*is_xnn_fusion=*/true));
 }
 
+static absl::Status RunMlpBenchmark(benchmark::State& state,
+                                    absl::string_view hlo,
+                                    bool is_xnn_fusion = false) {
+  int64_t batch = state.range(0);
+  int64_t d = state.range(1);
+
+  std::minstd_rand0 engine;
+  auto x = *LiteralUtil::CreateRandomLiteral<F32>(
+      ShapeUtil::MakeShape(F32, {batch, d}), &engine, 1.0f, 0.1f);
+  auto w = *LiteralUtil::CreateRandomLiteral<F32>(
+      ShapeUtil::MakeShape(F32, {d, d}), &engine, 1.0f, 0.1f);
+  auto bias = *LiteralUtil::CreateRandomLiteral<F32>(
+      ShapeUtil::MakeShape(F32, {d}), &engine, 1.0f, 0.1f);
+  std::vector<const Literal*> args = {&x, &w, &bias};
+
+  HloBenchmarkOptions options;
+  if (is_xnn_fusion) options.disable_parallel_task_assigner = true;
+  return RunHloBenchmark(
+      state, hlo, args,
+      {{"$batch", absl::StrCat(batch)}, {"$d", absl::StrCat(d)}}, options);
+}
+
+// MLP block epilogue: `dot` followed by a bias add and an activation function.
+static constexpr absl::string_view kBiasRelu = R"(
+      bias_broadcast = f32[$batch,$d] broadcast(bias), dimensions={1}
+      add = f32[$batch,$d] add(dot, bias_broadcast)
+      zero = f32[] constant(0)
+      zero_broadcast = f32[$batch,$d] broadcast(zero), dimensions={}
+      ROOT relu = f32[$batch,$d] maximum(add, zero_broadcast)
+  )";
+
+static constexpr absl::string_view kBiasSilu = R"(
+      bias_broadcast = f32[$batch,$d] broadcast(bias), dimensions={1}
+      add = f32[$batch,$d] add(dot, bias_broadcast)
+      logistic = f32[$batch,$d] logistic(add)
+      ROOT silu = f32[$batch,$d] multiply(add, logistic)
+  )";
+
+static std::string MlpHlo(absl::string_view epilogue) {
+  return absl::StrCat(R"(
+    HloModule mlp
+
+    ENTRY e {
+      x = f32[$batch,$d] parameter(0)
+      w = f32[$d,$d] parameter(1)
+      bias = f32[$d] parameter(2)
+      dot = f32[$batch,$d] dot(x, w), lhs_contracting_dims={1},
+                                      rhs_contracting_dims={0}
+  )",
+                      epilogue, "}");
+}
+
+static std::string XnnMlpHlo(absl::string_view epilogue) {
+  return absl::StrCat(R"(
+    HloModule mlp
+
+    xnn_fusion {
+      x = f32[$batch,$d] parameter(0)
+      w = f32[$d,$d] parameter(1)
+      bias = f32[$d] parameter(2)
+      dot = f32[$batch,$d] dot(x, w), lhs_contracting_dims={1},
+                                      rhs_contracting_dims={0}
+  )",
+                      epilogue, R"(}
+
+    ENTRY e {
+      x = f32[$batch,$d] parameter(0)
+      w = f32[$d,$d] parameter(1)
+      bias = f32[$d] parameter(2)
+      ROOT %result = f32[$batch,$d] fusion(x, w, bias), kind=kCustom,
+        calls=xnn_fusion,
+        backend_config={"fusion_config": {kind: "__xnn_fusion"}}
+    }
+  )");
+}
+
+static void BM_MlpBiasReluF32(benchmark::State& state) {
+  CHECK_OK(RunMlpBenchmark(state, MlpHlo(kBiasRelu)));
+}
+
+static void BM_XnnMlpBiasReluF32(benchmark::State& state) {
+  CHECK_OK(RunMlpBenchmark(state, XnnMlpHlo(kBiasRelu),
+                           /*is_xnn_fusion=*/true));
+}
+
+static void BM_MlpBiasSiluF32(benchmark::State& state) {
+  CHECK_OK(RunMlpBenchmark(state, MlpHlo(kBiasSilu)));
+}
+
+static void BM_XnnMlpBiasSiluF32(benchmark::State& state) {
+  CHECK_OK(RunMlpBenchmark(state, XnnMlpHlo(kBiasSilu),
+                           /*is_xnn_fusion=*/true));
+}
+
+#define BENCHMARK_MLP(name)      \
+  BENCHMARK(name)                \
+      ->MeasureProcessCPUTime()  \
+      ->ArgNames({"batch", "d"}) \
+      ->Args({64, 256})          \
+      ->Args({256, 1024})        \
+      ->Args({1024, 1024})
+
+BENCHMARK_MLP(BM_MlpBiasReluF32);
+BENCHMARK_MLP(BM_XnnMlpBiasReluF32);
+BENCHMARK_MLP(BM_MlpBiasSiluF32);
+BENCHMARK_MLP(BM_XnnMlpBiasSiluF32);
+
 #define BENCHMARK_FUSION(name)  \
   BENCHMARK(name)               \
       ->MeasureProcessCPUTime() \
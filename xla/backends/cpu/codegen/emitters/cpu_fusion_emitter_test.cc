@@ -36,6 +36,7 @@ limitations under the License.
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Target/LLVMIR/Dialect/Builtin/BuiltinToLLVMIRTranslation.h"
 #include "mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h"
+#include "xla/backends/cpu/codegen/emitters/cpu_reduction_emitter.h"
 #include "xla/backends/cpu/codegen/emitters/cpu_scatter_emitter.h"
 #include "xla/hlo/analysis/hlo_ordering.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
@@ -191,6 +192,114 @@ TEST_F(CpuFusionEmitterTest, ScatterLlvm) {
   EXPECT_TRUE(filecheck_matched);
 }
 
+static constexpr absl::string_view kRowReductionHlo = R"(
+  add {
+    %lhs = f32[] parameter(0)
+    %rhs = f32[] parameter(1)
+    ROOT %add = f32[] add(%lhs, %rhs)
+  }
+
+  reduce_computation {
+    %p0 = f32[64,100]{1,0} parameter(0)
+    %square = f32[64,100]{1,0} multiply(%p0, %p0)
+    %c0 = f32[] constant(0)
+    ROOT %reduce = f32[64]{0} reduce(%square, %c0), dimensions={1},
+      to_apply=add
+  }
+
+  ENTRY main {
+    %p = f32[64,100]{1,0} parameter(0)
+    ROOT %wrapped_reduce = f32[64]{0} fusion(%p), kind=kLoop,
+      calls=%reduce_computation,
+      backend_config={"outer_dimension_partitions":["4"]}
+  }
+)";
+
+TEST_F(CpuFusionEmitterTest, ReductionMlir) {
+  // 100 elements are reduced with 16 accumulators: 6 full vectors, a tail of
+  // 4 elements, and 15 reductions to combine the accumulators.
+  constexpr absl::string_view kExpected = R"(
+    CHECK:       @wrapped_reduce_entry(
+    CHECK-SAME:    xla.entry
+    CHECK:         xla.loop
+    CHECK:           scf.for
+    CHECK-COUNT-16:    arith.addf
+    CHECK:             scf.yield
+    CHECK:           scf.for
+    CHECK:             arith.addf
+    CHECK:             scf.yield
+    CHECK-COUNT-15:  arith.addf
+    CHECK:           tensor.insert
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module,
+                          ParseAndReturnVerifiedModule(kRowReductionHlo));
+  TF_ASSERT_OK_AND_ASSIGN(auto buffer_assignment,
+                          RunBufferAssignment(*hlo_module));
+  auto fusion = Cast<HloFusionInstruction>(
+      hlo_module->entry_computation()->root_instruction());
+  ASSERT_TRUE(CpuReductionFusion::IsSupported(*fusion));
+  CpuReductionFusion emitter(&mlir_context_, &llvm_context_,
+                             *buffer_assignment, fusion);
+  EXPECT_EQ(emitter.num_threads(), 4);
+  EXPECT_EQ(emitter.vector_size(), 16);
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto mlir_module,
+      emitter.CreateMLIRModule(mlir_context_, *fusion,
+                               std::string(fusion->name()) + "_entry",
+                               *buffer_assignment));
+  auto mlir_dump = MlirModuleToString(*mlir_module);
+  TF_ASSERT_OK_AND_ASSIGN(bool filecheck_matched,
+                          RunFileCheck(mlir_dump, kExpected));
+  EXPECT_TRUE(filecheck_matched);
+}
+
+TEST_F(CpuFusionEmitterTest, ReductionLlvm) {
+  constexpr absl::string_view kExpected = R"(
+    CHECK-NOT:  @wrapped_reduce_entry(
+    CHECK:      @wrapped_reduce(
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module,
+                          ParseAndReturnVerifiedModule(kRowReductionHlo));
+  TF_ASSERT_OK_AND_ASSIGN(auto buffer_assignment,
+                          RunBufferAssignment(*hlo_module));
+  auto fusion = Cast<HloFusionInstruction>(
+      hlo_module->entry_computation()->root_instruction());
+  CpuReductionFusion emitter(&mlir_context_, &llvm_context_,
+                             *buffer_assignment, fusion);
+  TF_ASSERT_OK_AND_ASSIGN(auto result, emitter.Emit());
+  auto llvm_dump = LlvmModuleToString(*result.llvm_module);
+  TF_ASSERT_OK_AND_ASSIGN(bool filecheck_matched,
+                          RunFileCheck(llvm_dump, kExpected));
+  EXPECT_TRUE(filecheck_matched);
+}
+
+TEST_F(CpuFusionEmitterTest, ColumnReductionIsNotSupported) {
+  constexpr absl::string_view kHlo = R"(
+    add {
+      %lhs = f32[] parameter(0)
+      %rhs = f32[] parameter(1)
+      ROOT %add = f32[] add(%lhs, %rhs)
+    }
+
+    reduce_computation {
+      %p0 = f32[64,100]{1,0} parameter(0)
+      %c0 = f32[] constant(0)
+      ROOT %reduce = f32[100]{0} reduce(%p0, %c0), dimensions={0},
+        to_apply=add
+    }
+
+    ENTRY main {
+      %p = f32[64,100]{1,0} parameter(0)
+      ROOT %wrapped_reduce = f32[100]{0} fusion(%p), kind=kLoop,
+        calls=%reduce_computation
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module, ParseAndReturnVerifiedModule(kHlo));
+  auto fusion = Cast<HloFusionInstruction>(
+      hlo_module->entry_computation()->root_instruction());
+  EXPECT_FALSE(CpuReductionFusion::IsSupported(*fusion));
+}
+
 }  // namespace
 }  // namespace cpu
 }  // namespace xla
@@ -0,0 +1,321 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/codegen/emitters/cpu_reduction_emitter.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/log/check.h"
+#include "absl/log/log.h"
+#include "absl/numeric/bits.h"
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/Support/raw_ostream.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/AffineExpr.h"
+#include "mlir/IR/AffineMap.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/ImplicitLocOpBuilder.h"
+#include "mlir/IR/Location.h"
+#include "mlir/IR/Value.h"
+#include "mlir/IR/ValueRange.h"
+#include "xla/backends/cpu/codegen/emitters/cpu_fusion_emitter.h"
+#include "xla/codegen/emitters/computation_partitioner.h"
+#include "xla/codegen/emitters/elemental_hlo_to_mlir.h"
+#include "xla/hlo/analysis/indexing_analysis.h"
+#include "xla/hlo/analysis/indexing_map.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/layout_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/service/cpu/backend_config.pb.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/util.h"
+
+namespace xla {
+namespace cpu {
+namespace {
+
+using llvm::SmallVector;
+using mlir::ImplicitLocOpBuilder;
+using mlir::Value;
+using mlir::ValueRange;
+
+namespace ma = ::mlir::arith;
+namespace scf = ::mlir::scf;
+
+// Returns the map from (output indices..., reduced linear index) to the
+// indices of the reduce operand. The reduced dimensions are the minor-most
+// ones, so consecutive linear indices address consecutive elements.
+IndexingMap GetReducedInputIndexing(const HloReduceInstruction* reduce,
+                                    int64_t num_reduced_elements,
+                                    mlir::MLIRContext* mlir_context) {
+  const Shape& input_shape = reduce->inputs().front()->shape();
+  absl::Span<const int64_t> output_dims = reduce->shape().dimensions();
+  absl::Span<const int64_t> reduced_dims =
+      input_shape.dimensions().subspan(output_dims.size());
+
+  SmallVector<mlir::AffineExpr, 4> results;
+  for (int64_t i = 0; i < output_dims.size(); ++i) {
+    results.push_back(mlir::getAffineDimExpr(i, mlir_context));
+  }
+  auto linear_index = mlir::getAffineDimExpr(output_dims.size(), mlir_context);
+  results.append(DelinearizeInBoundsIndex(linear_index, reduced_dims));
+
+  SmallVector<int64_t> dim_upper_bounds(output_dims.begin(),
+                                        output_dims.end());
+  dim_upper_bounds.push_back(num_reduced_elements);
+  return IndexingMap::FromTensorSizes(
+      mlir::AffineMap::get(/*dimCount=*/output_dims.size() + 1,
+                           /*symbolCount=*/0, results, mlir_context),
+      dim_upper_bounds, /*symbol_upper_bounds=*/{});
+}
+
+}  // namespace
+
+bool CpuReductionFusion::IsSupported(const HloFusionInstruction& fusion) {
+  const auto* reduce =
+      DynCast<HloReduceInstruction>(fusion.fused_expression_root());
+  // Variadic reductions would need one set of accumulators per input.
+  if (reduce == nullptr || reduce->input_count() != 1 ||
+      !reduce->shape().IsArray() ||
+      ShapeUtil::IsZeroElementArray(reduce->shape())) {
+    return false;
+  }
+  const Shape& input_shape = reduce->inputs().front()->shape();
+  if (!input_shape.has_layout() ||
+      !LayoutUtil::IsMonotonicWithDim0Major(input_shape.layout())) {
+    return false;
+  }
+  // The reduced dimensions must be the minor-most ones, so that the elements
+  // reduced into one output element are contiguous.
+  std::vector<int64_t> dimensions(reduce->dimensions().begin(),
+                                  reduce->dimensions().end());
+  absl::c_sort(dimensions);
+  int64_t num_kept_dims = input_shape.dimensions().size() - dimensions.size();
+  for (int64_t i = 0; i < dimensions.size(); ++i) {
+    if (dimensions[i] != num_kept_dims + i) {
+      return false;
+    }
+  }
+  return !dimensions.empty();
+}
+
+CpuReductionFusion::CpuReductionFusion(
+    mlir::MLIRContext* mlir_context, llvm::LLVMContext* llvm_context,
+    const BufferAssignment& buffer_assignment,
+    const HloFusionInstruction* fusion)
+    : CpuFusionEmitterBase{mlir_context, llvm_context, buffer_assignment,
+                           fusion} {
+  CHECK(IsSupported(*fusion)) << "Unsupported reduction: "
+                              << fusion->ToString();
+  reduce_ = Cast<HloReduceInstruction>(fusion->fused_expression_root());
+  const Shape& input_shape = reduce_->inputs().front()->shape();
+  const Shape& output_shape = reduce_->shape();
+
+  num_reduced_elements_ = 1;
+  for (int64_t dim : reduce_->dimensions()) {
+    num_reduced_elements_ *= input_shape.dimensions(dim);
+  }
+
+  // Use as many accumulators as fit into the widest vector register, but not
+  // more than there are elements to reduce.
+  const int64_t max_vectorized_bytes = 64;
+  int64_t max_vectorized_elements = std::max<int64_t>(
+      1, max_vectorized_bytes /
+             ShapeUtil::ByteSizeOfPrimitiveType(output_shape.element_type()));
+  vector_size_ = std::max<int64_t>(
+      1, std::min<int64_t>(
+             max_vectorized_elements,
+             absl::bit_floor(static_cast<uint64_t>(num_reduced_elements_))));
+
+  SmallVector<int64_t> outer_dimension_partitions(
+      output_shape.dimensions().size(), 1);
+  auto backend_config = fusion_->backend_config<BackendConfig>();
+  if (backend_config.ok()) {
+    // Parallel task assignment may only partition the outer-most dimensions.
+    int64_t num_partitioned_dims = std::min<int64_t>(
+        backend_config->outer_dimension_partitions_size(),
+        outer_dimension_partitions.size());
+    for (int64_t i = 0; i < num_partitioned_dims; ++i) {
+      outer_dimension_partitions[i] =
+          std::max<int64_t>(1, backend_config->outer_dimension_partitions(i));
+    }
+  }
+  num_threads_ = 1;
+  thread_tile_sizes_.reserve(outer_dimension_partitions.size());
+  for (auto [count, partitions] :
+       llvm::zip(output_shape.dimensions(), outer_dimension_partitions)) {
+    thread_tile_sizes_.push_back(CeilDiv(count, partitions));
+    num_threads_ *= CeilDiv(count, thread_tile_sizes_.back());
+  }
+  if (VLOG_IS_ON(5)) {
+    llvm::errs() << "\nvector_size_: " << vector_size_ << "\n\n";
+    llvm::errs() << "\nnum_threads_: " << num_threads_ << "\n\n";
+  }
+}
+
+std::vector<emitters::EpilogueSpecification> CpuReductionFusion::GetEpilogues(
+    const HloFusionInstruction& fusion, mlir::MLIRContext* mlir_context) const {
+  // The reduce itself is emitted by EmitEntryFunction, tell the base class to
+  // not generate code for it.
+  return {emitters::EpilogueSpecification::FromIdentityIndexing(
+      reduce_, reduce_, mlir_context)};
+}
+
+std::optional<IndexingMap> CpuReductionFusion::ComputeThreadIdToOutputIndexing(
+    int64_t root_index, mlir::MLIRContext* ctx) const {
+  return GetDefaultIndexingMap(thread_tile_sizes_,
+                               reduce_->shape().dimensions(), ctx);
+}
+
+std::optional<IndexingMap> CpuReductionFusion::ComputeThreadIdToInputIndexing(
+    int64_t root_index, int64_t hero_operand_index,
+    mlir::MLIRContext* ctx) const {
+  return std::nullopt;
+}
+
+int64_t CpuReductionFusion::num_threads() const { return num_threads_; }
+
+absl::Status CpuReductionFusion::EmitEntryFunction(
+    const emitters::PartitionedComputations& computations,
+    const emitters::CallTargetProvider& call_targets,
+    mlir::func::FuncOp entry_function,
+    const HloFusionInstruction& fusion) const {
+  mlir::MLIRContext* mlir_context = entry_function.getContext();
+  ImplicitLocOpBuilder b(entry_function.getLoc(), entry_function);
+  b.setInsertionPointToStart(entry_function.addEntryBlock());
+
+  const auto& root_computation = computations.FindPartitionedComputation(
+      fusion.fused_instructions_computation());
+  auto reducer = call_targets(reduce_->to_apply()->root_instruction());
+
+  Value thread_id = entry_function.getArgument(0);
+  entry_function.setArgAttr(0, "xla.range",
+                            b.getIndexArrayAttr({0, num_threads_ - 1}));
+  // The output follows the thread id and the fusion parameters.
+  Value output_tensor =
+      entry_function.getArgument(1 + fusion.fused_parameters().size());
+
+  IndexingMap output_indexing =
+      *ComputeThreadIdToOutputIndexing(/*root_index=*/0, mlir_context);
+  output_indexing.Simplify();
+  IndexingMap input_indexing =
+      GetReducedInputIndexing(reduce_, num_reduced_elements_, mlir_context);
+
+  // Returns `reducer(accumulator, input[output_indices..., linear_index])`.
+  auto reduce_element = [&](ImplicitLocOpBuilder& builder,
+                            ValueRange output_indices, Value accumulator,
+                            Value linear_index) -> Value {
+    SmallVector<Value> dims(output_indices.begin(), output_indices.end());
+    dims.push_back(linear_index);
+    auto input_indices =
+        emitters::ApplyIndexing(input_indexing, dims, {}, builder);
+    Value element =
+        ProvideParameter(root_computation, reduce_, /*operand_index=*/0,
+                         input_indices, call_targets, entry_function,
+                         builder)[0];
+    return emitters::InlineBlock(builder, reducer.getBody().front(),
+                                 {accumulator, element})[0];
+  };
+
+  auto results = emitters::EmitXlaLoopOp(
+      b, {thread_id}, {output_tensor}, output_indexing,
+      [&](ImplicitLocOpBuilder nested_b, ValueRange ivs,
+          ValueRange output_indices,
+          ValueRange output_tensors) -> SmallVector<Value> {
+        Value init =
+            ProvideParameter(root_computation, reduce_, /*operand_index=*/1,
+                             {}, call_targets, entry_function, nested_b)[0];
+        SmallVector<Value> accumulators(vector_size_, init);
+        int64_t num_vectors = num_reduced_elements_ / vector_size_;
+        Value c0 = nested_b.create<ma::ConstantIndexOp>(0);
+        Value c1 = nested_b.create<ma::ConstantIndexOp>(1);
+
+        // Element `i * vector_size + j` goes to accumulator `j`, so every
+        // iteration reduces one vector of consecutive elements.
+        if (num_vectors > 0) {
+          auto vector_loop = nested_b.create<scf::ForOp>(
+              c0, nested_b.create<ma::ConstantIndexOp>(num_vectors), c1,
+              accumulators,
+              [&](mlir::OpBuilder& loop_builder, mlir::Location loc, Value iv,
+                  ValueRange iter_args) {
+                ImplicitLocOpBuilder body_b(loc, loop_builder);
+                Value base = body_b.create<ma::MulIOp>(
+                    iv, body_b.create<ma::ConstantIndexOp>(vector_size_));
+                SmallVector<Value> updated;
+                updated.reserve(vector_size_);
+                for (int64_t j = 0; j < vector_size_; ++j) {
+                  Value linear_index = body_b.create<ma::AddIOp>(
+                      base, body_b.create<ma::ConstantIndexOp>(j));
+                  updated.push_back(reduce_element(body_b, output_indices,
+                                                   iter_args[j], linear_index));
+                }
+                body_b.create<scf::YieldOp>(updated);
+              });
+          accumulators.assign(vector_loop.getResults().begin(),
+                              vector_loop.getResults().end());
+        }
+
+        // Remainder that doesn't fill a whole vector.
+        if (num_vectors * vector_size_ < num_reduced_elements_) {
+          auto tail_loop = nested_b.create<scf::ForOp>(
+              nested_b.create<ma::ConstantIndexOp>(num_vectors * vector_size_),
+              nested_b.create<ma::ConstantIndexOp>(num_reduced_elements_), c1,
+              ValueRange{accumulators.front()},
+              [&](mlir::OpBuilder& loop_builder, mlir::Location loc, Value iv,
+                  ValueRange iter_args) {
+                ImplicitLocOpBuilder body_b(loc, loop_builder);
+                body_b.create<scf::YieldOp>(ValueRange{reduce_element(
+                    body_b, output_indices, iter_args.front(), iv)});
+              });
+          accumulators.front() = tail_loop.getResult(0);
+        }
+
+        // Combine the accumulators pairwise. `vector_size_` is a power of two.
+        for (int64_t width = vector_size_ / 2; width > 0; width /= 2) {
+          for (int64_t j = 0; j < width; ++j) {
+            accumulators[j] = emitters::InlineBlock(
+                nested_b, reducer.getBody().front(),
+                {accumulators[j], accumulators[j + width]})[0];
+          }
+        }
+        return {nested_b.create<mlir::tensor::InsertOp>(
+            accumulators.front(), output_tensors.front(), output_indices)};
+      });
+  b.create<mlir::func::ReturnOp>(results);
+
+  if (VLOG_IS_ON(5)) {
+    entry_function->getParentOfType<mlir::ModuleOp>().dump();
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace cpu
+}  // namespace xla
@@ -0,0 +1,91 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_CODEGEN_EMITTERS_CPU_REDUCTION_EMITTER_H_
+#define XLA_BACKENDS_CPU_CODEGEN_EMITTERS_CPU_REDUCTION_EMITTER_H_
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/LLVMContext.h"
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/IR/MLIRContext.h"
+#include "xla/backends/cpu/codegen/emitters/cpu_fusion_emitter.h"
+#include "xla/codegen/emitters/computation_partitioner.h"
+#include "xla/hlo/analysis/indexing_map.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/service/buffer_assignment.h"
+
+namespace xla {
+namespace cpu {
+
+// Row reduction fusion: the fusion root is a reduce of the minor-most
+// dimensions of its operand, so the elements reduced into one output element
+// are contiguous in memory. Lowers to LLVM via MLIR.
+//
+// Each output element is reduced with `vector_size` independent accumulators
+// that walk consecutive input elements, which lets LLVM keep them in one SIMD
+// register; the accumulators are combined once at the end. Outer (kept)
+// dimensions are split across threads according to the
+// `outer_dimension_partitions` of the fusion's backend config.
+class CpuReductionFusion : public CpuFusionEmitterBase {
+ public:
+  explicit CpuReductionFusion(mlir::MLIRContext* mlir_context,
+                              llvm::LLVMContext* llvm_context,
+                              const BufferAssignment& buffer_assignment,
+                              const HloFusionInstruction* fusion);
+
+  // Returns true if `fusion` is a reduction this emitter can handle.
+  static bool IsSupported(const HloFusionInstruction& fusion);
+
+  int64_t num_threads() const override;
+
+  int64_t vector_size() const { return vector_size_; }
+
+  std::optional<IndexingMap> ComputeThreadIdToOutputIndexing(
+      int64_t root_index, mlir::MLIRContext* ctx) const override;
+
+  std::optional<IndexingMap> ComputeThreadIdToInputIndexing(
+      int64_t root_index, int64_t hero_operand_index,
+      mlir::MLIRContext* ctx) const override;
+
+ protected:
+  absl::Status EmitEntryFunction(
+      const emitters::PartitionedComputations& computations,
+      const emitters::CallTargetProvider& call_targets,
+      mlir::func::FuncOp entry_function,
+      const HloFusionInstruction& fusion) const override;
+
+  std::vector<emitters::EpilogueSpecification> GetEpilogues(
+      const HloFusionInstruction& fusion,
+      mlir::MLIRContext* mlir_context) const override;
+
+ private:
+  const HloReduceInstruction* reduce_;
+  // Number of input elements reduced into each output element.
+  int64_t num_reduced_elements_;
+  int64_t vector_size_;
+  // Number of output elements along each output dimension per thread.
+  llvm::SmallVector<int64_t> thread_tile_sizes_;
+  int64_t num_threads_;
+};
+
+}  // namespace cpu
+}  // namespace xla
+
+#endif  // XLA_BACKENDS_CPU_CODEGEN_EMITTERS_CPU_REDUCTION_EMITTER_H_
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/backends/cpu/codegen/ir_compiler.h"
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -27,7 +28,9 @@ limitations under the License.
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
@@ -65,6 +68,7 @@ limitations under the License.
 #include "xla/service/llvm_ir/llvm_util.h"
 #include "xla/util.h"
 #include "tsl/platform/cpu_info.h"
+#include "tsl/platform/fingerprint.h"
 
 namespace xla::cpu {
 
@@ -240,6 +244,17 @@ llvm::Expected<std::unique_ptr<llvm::MemoryBuffer>> IrCompiler::operator()(
     }
   }
 
+  // Check if we already have a compiled object file in the cache.
+  std::string cache_key;
+  if (options_.object_cache) {
+    cache_key = ObjectCacheKey(module, **target_machine);
+    if (std::unique_ptr<llvm::MemoryBuffer> obj_file =
+            options_.object_cache->Lookup(cache_key)) {
+      RunPostCodegenHook(module, *obj_file);
+      return std::move(obj_file);
+    }
+  }
+
   if (llvm::Error ir_passes_error =
           RunIrPasses(module, target_machine->get())) {
     return ir_passes_error;
@@ -258,22 +273,64 @@ llvm::Expected<std::unique_ptr<llvm::MemoryBuffer>> IrCompiler::operator()(
   std::unique_ptr<llvm::MemoryBuffer> mc_memory_buffer =
       EmitMachineCode(module, target_machine->get());
 
-  {  // Synchronize access to user-defined hooks.
-    absl::MutexLock lock(&mutex_);
-    if (hooks_.post_codegen) {
-      llvm::Expected<std::unique_ptr<llvm::object::ObjectFile>> obj_file =
-          llvm::object::ObjectFile::createObjectFile(*mc_memory_buffer);
-      if (obj_file) {
-        hooks_.post_codegen(module, *obj_file.get());
-      } else {
-        LOG(WARNING) << "Could not convert memory buffer to object file";
-      }
-    }
+  if (options_.object_cache) {
+    options_.object_cache->Insert(cache_key,
+                                  mc_memory_buffer->getMemBufferRef());
   }
 
+  RunPostCodegenHook(module, *mc_memory_buffer);
   return std::move(mc_memory_buffer);
 }
 
+void IrCompiler::RunPostCodegenHook(const llvm::Module& module,
+                                    const llvm::MemoryBuffer& obj_file) {
+  // Synchronize access to user-defined hooks.
+  absl::MutexLock lock(&mutex_);
+  if (hooks_.post_codegen) {
+    llvm::Expected<std::unique_ptr<llvm::object::ObjectFile>> object_file =
+        llvm::object::ObjectFile::createObjectFile(obj_file);
+    if (object_file) {
+      hooks_.post_codegen(module, *object_file.get());
+    } else {
+      LOG(WARNING) << "Could not convert memory buffer to object file";
+    }
+  }
+}
+
+std::string IrCompiler::ObjectCacheKey(
+    const llvm::Module& module,
+    const llvm::TargetMachine& target_machine) const {
+  // Bump the version to invalidate all cached object files when we change the
+  // compilation pipeline in a way that is not captured by the options below.
+  static constexpr int64_t kObjectCacheVersion = 1;
+
+  std::string fast_math_flags;
+  llvm::raw_string_ostream fast_math_flags_os(fast_math_flags);
+  options_.fast_math_flags.print(fast_math_flags_os);
+
+  const llvm::TargetOptions& target_options = target_machine.Options;
+
+  std::string fingerprint_input = absl::StrCat(
+      "version=", kObjectCacheVersion,
+      ";triple=", target_machine.getTargetTriple().str(),
+      ";cpu=", target_machine.getTargetCPU().str(),
+      ";features=", target_machine.getTargetFeatureString().str(),
+      ";opt_level=", static_cast<int>(options_.opt_level),
+      ";optimize_for_size=", options_.optimize_for_size,
+      ";fast_math_flags=", fast_math_flags,
+      ";fp_op_fusion=", static_cast<int>(target_options.AllowFPOpFusion),
+      ";disable_expensive_passes=", options_.disable_expensive_passes,
+      ";disable_slp_vectorizer=", options_.disable_slp_vectorizer,
+      ";disable_loop_unrolling=", options_.disable_loop_unrolling,
+      ";dfsan_enabled=", options_.dfsan_enabled,
+      ";dfsan_abi_list_files=",
+      absl::StrJoin(options_.dfsan_abi_list_files, ","),
+      ";module=", llvm_ir::DumpToString(&module));
+
+  tsl::Fprint128 fingerprint = tsl::Fingerprint128(fingerprint_input);
+  return absl::StrFormat("%016x%016x", fingerprint.high64, fingerprint.low64);
+}
+
 llvm::Error IrCompiler::RunIrPasses(llvm::Module& module,
                                     llvm::TargetMachine* target_machine) const {
   llvm::PipelineTuningOptions pto = GetPipelineTuningOptions(module, options_);
@@ -293,7 +350,7 @@ llvm::Error IrCompiler::RunIrPasses(llvm::Module& module,
   auto target_library_info_impl =
       std::make_unique<llvm::TargetLibraryInfoImpl>(target_triple);
   target_library_info_impl->addVectorizableFunctions(
-      PolynomialApproximationsVectorization());
+      PolynomialApproximationsVectorization(options_.fast_math_flags));
 
   fam.registerPass(
       [&] { return llvm::TargetLibraryAnalysis(*target_library_info_impl); });
@@ -34,6 +34,7 @@ limitations under the License.
 #include "llvm/Support/Error.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
+#include "xla/backends/cpu/codegen/object_cache.h"
 #include "xla/service/hlo_module_config.h"
 #include "tsl/platform/cpu_info.h"
 
@@ -73,9 +74,15 @@ class IrCompiler : public llvm::orc::IRCompileLayer::IRCompiler {
 
     bool dfsan_enabled = false;
     std::vector<std::string> dfsan_abi_list_files;
+
+    // Optional cache of compiled object files. If set, compiler will look up
+    // the object file in the cache before running the LLVM compilation
+    // pipeline, and will insert compiled object files into the cache.
+    std::shared_ptr<ObjectCache> object_cache;
   };
 
-  // Compilation hooks for intercepting IR compilation stages.
+  // Compilation hooks for intercepting IR compilation stages. On object cache
+  // hits only `pre_optimization` and `post_codegen` hooks are called.
   struct CompilationHooks {
     std::function<void(const llvm::Module&)> pre_optimization;
     std::function<void(const llvm::Module&)> post_optimization;
@@ -119,6 +126,11 @@ class IrCompiler : public llvm::orc::IRCompileLayer::IRCompiler {
   std::unique_ptr<llvm::MemoryBuffer> EmitMachineCode(
       llvm::Module& module, llvm::TargetMachine* target_machine) const;
 
+  // Returns a key for looking up compiled `module` in the object cache. Must be
+  // called before running IR passes, as they mutate the module.
+  std::string ObjectCacheKey(const llvm::Module& module,
+                             const llvm::TargetMachine& target_machine) const;
+
   static llvm::CodeGenOptLevel GetCodeGenOptLevel(
       const HloModuleConfig& module_config);
 
@@ -136,6 +148,10 @@ class IrCompiler : public llvm::orc::IRCompileLayer::IRCompiler {
   // races when calling user provided compilation hooks.
   absl::Mutex mutex_;
   CompilationHooks hooks_ ABSL_GUARDED_BY(mutex_);
+
+  // Runs the `post_codegen` hook on the compiled object file.
+  void RunPostCodegenHook(const llvm::Module& module,
+                          const llvm::MemoryBuffer& obj_file);
 };
 
 }  // namespace xla::cpu
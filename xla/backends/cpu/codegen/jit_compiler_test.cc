@@ -39,10 +39,12 @@ limitations under the License.
 #include "llvm/IR/DataLayout.h"
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
 #include "xla/backends/cpu/codegen/ir_compiler.h"
+#include "xla/backends/cpu/codegen/object_cache.h"
 #include "xla/backends/cpu/runtime/function_library.h"
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/tsl/platform/env.h"
@@ -228,4 +230,92 @@ TEST(JitCompilerTest, ExternalDefinitionGenerator) {
   EXPECT_EQ(value, 2.0f);
 }
 
+// Object cache that counts cache hits and inserts.
+class CountingObjectCache : public ObjectCache {
+ public:
+  explicit CountingObjectCache(std::unique_ptr<ObjectCache> cache)
+      : cache_(std::move(cache)) {}
+
+  std::unique_ptr<llvm::MemoryBuffer> Lookup(absl::string_view key) final {
+    auto obj_file = cache_->Lookup(key);
+    if (obj_file) num_hits++;
+    return obj_file;
+  }
+
+  void Insert(absl::string_view key, llvm::MemoryBufferRef obj_file) final {
+    num_inserts++;
+    cache_->Insert(key, obj_file);
+  }
+
+  std::atomic<int32_t> num_hits = 0;
+  std::atomic<int32_t> num_inserts = 0;
+
+ private:
+  std::unique_ptr<ObjectCache> cache_;
+};
+
+TEST(JitCompilerTest, CompileWithObjectCache) {
+  tsl::Env* env = tsl::Env::Default();
+  std::string directory;
+  ASSERT_TRUE(env->LocalTempFilename(&directory));
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<FileObjectCache> file_cache,
+                          FileObjectCache::Create(env, directory));
+  auto cache = std::make_shared<CountingObjectCache>(std::move(file_cache));
+
+  constexpr absl::string_view add_in_place_ir = R"(
+    define void @AddInplace(ptr %arg) {
+      %v0 = load float, ptr %arg
+      %v1 = fadd float %v0, %v0
+      store float %v1, ptr %arg
+      ret void
+    })";
+
+  auto compile_and_run = [&]() -> absl::StatusOr<float> {
+    auto context = std::make_unique<llvm::LLVMContext>();
+    llvm::orc::ThreadSafeContext tsc(std::move(context));
+
+    IrCompiler::Options ir_compiler_options;
+    ir_compiler_options.object_cache = cache;
+
+    TF_ASSIGN_OR_RETURN(
+        auto compiler,
+        JitCompiler::Create(JitCompiler::Options(),
+                            IrCompiler::Create(llvm::TargetOptions(),
+                                               std::move(ir_compiler_options),
+                                               IrCompiler::CompilationHooks()),
+                            /*task_runner=*/nullptr));
+
+    TF_ASSIGN_OR_RETURN(llvm::orc::ThreadSafeModule tsm,
+                        ParseModule(tsc, add_in_place_ir, "AddInplace"));
+    TF_RETURN_IF_ERROR(compiler.AddModule(std::move(tsm)));
+
+    using ScalarFn = void(float*);
+    std::vector<FunctionLibrary::Symbol> symbols = {
+        FunctionLibrary::Sym<ScalarFn>("AddInplace")};
+
+    TF_ASSIGN_OR_RETURN(auto function_library,
+                        Compile(std::move(compiler), symbols));
+    TF_ASSIGN_OR_RETURN(
+        ScalarFn * add_in_place,
+        function_library->ResolveFunction<ScalarFn>("AddInplace"));
+
+    float value = 1.0f;
+    add_in_place(&value);
+    return value;
+  };
+
+  // First compilation populates the cache.
+  TF_ASSERT_OK_AND_ASSIGN(float value0, compile_and_run());
+  EXPECT_EQ(value0, 2.0f);
+  EXPECT_EQ(cache->num_hits, 0);
+  EXPECT_EQ(cache->num_inserts, 1);
+
+  // Second compilation loads the object file from the cache.
+  TF_ASSERT_OK_AND_ASSIGN(float value1, compile_and_run());
+  EXPECT_EQ(value1, 2.0f);
+  EXPECT_EQ(cache->num_hits, 1);
+  EXPECT_EQ(cache->num_inserts, 1);
+}
+
 }  // namespace xla::cpu
@@ -0,0 +1,102 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/codegen/object_cache.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "llvm/Object/ObjectFile.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "tsl/platform/path.h"
+
+namespace xla::cpu {
+
+absl::StatusOr<std::unique_ptr<FileObjectCache>> FileObjectCache::Create(
+    tsl::Env* env, std::string directory) {
+  TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(directory));
+  return std::unique_ptr<FileObjectCache>(
+      new FileObjectCache(env, std::move(directory)));
+}
+
+FileObjectCache::FileObjectCache(tsl::Env* env, std::string directory)
+    : env_(env), directory_(std::move(directory)) {}
+
+std::string FileObjectCache::FilePath(absl::string_view key) const {
+  return tsl::io::JoinPath(directory_, absl::StrCat(key, ".o"));
+}
+
+std::unique_ptr<llvm::MemoryBuffer> FileObjectCache::Lookup(
+    absl::string_view key) {
+  std::string path = FilePath(key);
+  if (!env_->FileExists(path).ok()) {
+    VLOG(3) << "Object cache miss: " << key;
+    return nullptr;
+  }
+
+  std::string data;
+  if (absl::Status status = tsl::ReadFileToString(env_, path, &data);
+      !status.ok()) {
+    LOG(WARNING) << "Failed to read object file from cache: " << status;
+    return nullptr;
+  }
+
+  std::unique_ptr<llvm::MemoryBuffer> obj_file =
+      llvm::MemoryBuffer::getMemBufferCopy(data, path);
+
+  // Treat corrupted cache entries as a cache miss, they will be overwritten
+  // with a new object file after compilation.
+  auto parsed = llvm::object::ObjectFile::createObjectFile(*obj_file);
+  if (!parsed) {
+    LOG(WARNING) << "Ignoring corrupted object file in cache: " << path << ": "
+                 << llvm::toString(parsed.takeError());
+    return nullptr;
+  }
+
+  VLOG(3) << "Object cache hit: " << key;
+  return obj_file;
+}
+
+void FileObjectCache::Insert(absl::string_view key,
+                             llvm::MemoryBufferRef obj_file) {
+  std::string path = FilePath(key);
+
+  std::string tmp_path = path;
+  if (!env_->CreateUniqueFileName(&tmp_path, ".tmp")) {
+    LOG(WARNING) << "Failed to create temporary file name for: " << path;
+    return;
+  }
+
+  absl::Status status = tsl::WriteStringToFile(
+      env_, tmp_path,
+      absl::string_view(obj_file.getBufferStart(), obj_file.getBufferSize()));
+  if (status.ok()) status = env_->RenameFile(tmp_path, path);
+
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to write object file to cache: " << status;
+    env_->DeleteFile(tmp_path).IgnoreError();
+  }
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,75 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_CODEGEN_OBJECT_CACHE_H_
+#define XLA_BACKENDS_CPU_CODEGEN_OBJECT_CACHE_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "xla/tsl/platform/env.h"
+
+namespace xla::cpu {
+
+// A content-addressed cache of compiled object files. Keys are computed by the
+// IrCompiler from the fingerprint of the LLVM module and all compilation
+// options that affect generated machine code (target triple, CPU name and
+// features, optimization level, etc.). Implementations must be thread safe,
+// as the IrCompiler can compile multiple LLVM modules concurrently.
+class ObjectCache {
+ public:
+  virtual ~ObjectCache() = default;
+
+  // Returns the object file for the given `key`, or nullptr if not found.
+  virtual std::unique_ptr<llvm::MemoryBuffer> Lookup(absl::string_view key) = 0;
+
+  // Inserts the object file into the cache. Errors are not propagated to the
+  // caller, because the cache is a best effort optimization.
+  virtual void Insert(absl::string_view key,
+                      llvm::MemoryBufferRef obj_file) = 0;
+};
+
+// An object cache that stores object files in a directory on disk (one file
+// per key), so that they can be shared between processes. Files are written
+// to a temporary location and then atomically renamed, so concurrent
+// processes never observe partially written object files.
+//
+// WARNING: Cache keys do not include the version of the compiler itself, and
+// the cache directory must be cleared when the XLA binary is updated.
+class FileObjectCache final : public ObjectCache {
+ public:
+  static absl::StatusOr<std::unique_ptr<FileObjectCache>> Create(
+      tsl::Env* env, std::string directory);
+
+  std::unique_ptr<llvm::MemoryBuffer> Lookup(absl::string_view key) final;
+  void Insert(absl::string_view key, llvm::MemoryBufferRef obj_file) final;
+
+  const std::string& directory() const { return directory_; }
+
+ private:
+  FileObjectCache(tsl::Env* env, std::string directory);
+
+  std::string FilePath(absl::string_view key) const;
+
+  tsl::Env* env_;
+  std::string directory_;
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_CODEGEN_OBJECT_CACHE_H_
@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <functional>
+#include <limits>
 #include <vector>
 
 #include "absl/strings/string_view.h"
@@ -400,6 +401,110 @@ llvm::Value* GenerateVF32Log(llvm::IRBuilderBase* b, llvm::Value* input,
                                    result_finite_or_nan));
 }
 
+// Generates a polynomial approximation of sin(x) (or cos(x) if `compute_cos`
+// is true) using the same polynomials as Cephes `sinf` and `cosf`.
+//
+// The argument is reduced to r in [-pi/4, pi/4] with a three-part Cody-Waite
+// reduction, x = r + n * pi/2, and the quadrant n selects between the sine
+// and cosine polynomials and the sign of the result. Every product y * C_i of
+// the reduction is exact for |x| < 2^15 * pi/2, and across that range the
+// result is within a couple of ULPs of the correctly rounded value. Beyond it
+// the reduction loses precision quickly, and that's why we only rewrite sin
+// and cos if approximate functions are allowed by the fast math flags.
+llvm::Value* GenerateVF32SinCos(llvm::IRBuilderBase* b, llvm::Value* input,
+                                int32_t vector_width, bool compute_cos) {
+  VectorIrBuilder vb(F32, vector_width, b,
+                     compute_cos ? "cos_f32" : "sin_f32");
+
+  const llvm::APFloat half = GetIeeeF32(0.5);
+  const llvm::APFloat one = GetIeeeF32(1.0);
+
+  // The constant 2/pi.
+  const llvm::APFloat two_over_pi = GetIeeeF32(0.636619772367581343076);
+
+  // pi/2 = DP1 + DP2 + DP3, where DP1 and DP2 have only a few significant bits.
+  const llvm::APFloat cephes_DP1 = GetIeeeF32(1.5703125);
+  const llvm::APFloat cephes_DP2 = GetIeeeF32(4.837512969970703125e-4);
+  const llvm::APFloat cephes_DP3 = GetIeeeF32(7.54978995489188216e-8);
+
+  const llvm::APFloat cephes_sin_p0 = GetIeeeF32(-1.9515295891E-4);
+  const llvm::APFloat cephes_sin_p1 = GetIeeeF32(8.3321608736E-3);
+  const llvm::APFloat cephes_sin_p2 = GetIeeeF32(-1.6666654611E-1);
+
+  const llvm::APFloat cephes_cos_p0 = GetIeeeF32(2.443315711809948E-5);
+  const llvm::APFloat cephes_cos_p1 = GetIeeeF32(-1.388731625493765E-3);
+  const llvm::APFloat cephes_cos_p2 = GetIeeeF32(4.166664568298827E-2);
+
+  const llvm::APFloat abs_mask = GetIeeeF32FromBitwiseRep(0x7fffffff);
+
+  llvm::Type* i32_vector_type =
+      llvm::VectorType::get(b->getInt32Ty(), vector_width, false);
+  auto splat_i32 = [&](int32_t v) {
+    return b->CreateVectorSplat(vector_width, b->getInt32(v));
+  };
+
+  // Both functions are computed for |x|, sin(x) takes the sign of x below.
+  llvm::Value* x = vb.FloatAnd(input, abs_mask);
+
+  // Calculates n = floor(|x| * 2/pi + 0.5) = round(|x| / (pi/2)).
+  llvm::Value* n = vb.Floor(vb.MulAdd(x, two_over_pi, half));
+
+  // Converting nan or inf to i32 yields poison, freeze it so that a nan input
+  // still propagates through the polynomials below.
+  llvm::Value* n_i32 = b->CreateFreeze(b->CreateFPToSI(n, i32_vector_type));
+
+  // Computes r = |x| - n * pi/2 in extended precision.
+  x = vb.Sub(x, vb.Mul(cephes_DP1, n));
+  x = vb.Sub(x, vb.Mul(cephes_DP2, n));
+  x = vb.Sub(x, vb.Mul(cephes_DP3, n));
+
+  llvm::Value* z = vb.Mul(x, x);
+
+  // Polynomial to compute sin(r), accurate for r in [-pi/4, pi/4].
+  llvm::Value* sin_r = vb.MulAdd(z, cephes_sin_p0, cephes_sin_p1);
+  sin_r = vb.MulAdd(sin_r, z, cephes_sin_p2);
+  sin_r = vb.MulAdd(vb.Mul(sin_r, z), x, x);
+
+  // Polynomial to compute cos(r), accurate for r in [-pi/4, pi/4].
+  llvm::Value* cos_r = vb.MulAdd(z, cephes_cos_p0, cephes_cos_p1);
+  cos_r = vb.MulAdd(cos_r, z, cephes_cos_p2);
+  cos_r = vb.MulAdd(vb.Mul(cos_r, z), z, vb.Sub(one, vb.Mul(half, z)));
+
+  // Quadrants are numbered by n mod 4:
+  //
+  //   sin(r + n * pi/2) = { sin(r), cos(r), -sin(r), -cos(r) }
+  //   cos(r + n * pi/2) = { cos(r), -sin(r), -cos(r), sin(r) }
+  //
+  // Even quadrants use the polynomial of the function itself, and the sign
+  // is bit 1 of n (of n + 1 for cos), which we shift into the float sign bit.
+  llvm::Value* is_even =
+      b->CreateICmpEQ(b->CreateAnd(n_i32, splat_i32(1)), splat_i32(0));
+  llvm::Value* result = compute_cos ? b->CreateSelect(is_even, cos_r, sin_r)
+                                    : b->CreateSelect(is_even, sin_r, cos_r);
+
+  llvm::Value* quadrant =
+      compute_cos ? b->CreateAdd(n_i32, splat_i32(1)) : n_i32;
+  llvm::Value* sign = b->CreateShl(quadrant, splat_i32(30));
+  if (!compute_cos) {
+    sign = b->CreateXor(sign, b->CreateBitCast(input, i32_vector_type));
+  }
+  sign = b->CreateAnd(sign, splat_i32(std::numeric_limits<int32_t>::min()));
+
+  return b->CreateBitCast(
+      b->CreateXor(b->CreateBitCast(result, i32_vector_type), sign),
+      vb.vector_type());
+}
+
+llvm::Value* GenerateVF32Sin(llvm::IRBuilderBase* b, llvm::Value* input,
+                             int32_t vector_width) {
+  return GenerateVF32SinCos(b, input, vector_width, /*compute_cos=*/false);
+}
+
+llvm::Value* GenerateVF32Cos(llvm::IRBuilderBase* b, llvm::Value* input,
+                             int32_t vector_width) {
+  return GenerateVF32SinCos(b, input, vector_width, /*compute_cos=*/true);
+}
+
 // Generates an IR for computing output value via upcasting to F32:
 //   output = cast<F16>(generator(cast<F32>(input)))
 template <Generator generator>
@@ -532,9 +637,90 @@ std::vector<llvm::VecDesc> LogVectorization() {
   };
 }
 
+//===----------------------------------------------------------------------===//
+// Sin
+//===----------------------------------------------------------------------===//
+
+static constexpr absl::string_view kSinV4F32Sym = "__xla_cpu_SinV4F32";
+static constexpr absl::string_view kSinV8F32Sym = "__xla_cpu_SinV8F32";
+static constexpr absl::string_view kSinV16F32Sym = "__xla_cpu_SinV16F32";
+
+static constexpr absl::string_view kSinV8F16Sym = "__xla_cpu_SinV8F16";
+static constexpr absl::string_view kSinV16F16Sym = "__xla_cpu_SinV16F16";
+
+std::vector<llvm::VecDesc> SinVectorization() {
+  return {
+      {"sinf", kSinV4F32Sym, llvm::ElementCount::getFixed(4), false,
+       "_ZGV_LLVM_N4v"},
+      {"llvm.sin.f32", kSinV4F32Sym, llvm::ElementCount::getFixed(4), false,
+       "_ZGV_LLVM_N4v"},
+
+      {"sinf", kSinV8F32Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+      {"llvm.sin.f32", kSinV8F32Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+
+      {"sinf", kSinV16F32Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+      {"llvm.sin.f32", kSinV16F32Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+
+      {"sinf", kSinV8F16Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+      {"llvm.sin.f16", kSinV8F16Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+
+      {"sinf", kSinV16F16Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+      {"llvm.sin.f16", kSinV16F16Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+  };
+}
+
+//===----------------------------------------------------------------------===//
+// Cos
+//===----------------------------------------------------------------------===//
+
+static constexpr absl::string_view kCosV4F32Sym = "__xla_cpu_CosV4F32";
+static constexpr absl::string_view kCosV8F32Sym = "__xla_cpu_CosV8F32";
+static constexpr absl::string_view kCosV16F32Sym = "__xla_cpu_CosV16F32";
+
+static constexpr absl::string_view kCosV8F16Sym = "__xla_cpu_CosV8F16";
+static constexpr absl::string_view kCosV16F16Sym = "__xla_cpu_CosV16F16";
+
+std::vector<llvm::VecDesc> CosVectorization() {
+  return {
+      {"cosf", kCosV4F32Sym, llvm::ElementCount::getFixed(4), false,
+       "_ZGV_LLVM_N4v"},
+      {"llvm.cos.f32", kCosV4F32Sym, llvm::ElementCount::getFixed(4), false,
+       "_ZGV_LLVM_N4v"},
+
+      {"cosf", kCosV8F32Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+      {"llvm.cos.f32", kCosV8F32Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+
+      {"cosf", kCosV16F32Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+      {"llvm.cos.f32", kCosV16F32Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+
+      {"cosf", kCosV8F16Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+      {"llvm.cos.f16", kCosV8F16Sym, llvm::ElementCount::getFixed(8), false,
+       "_ZGV_LLVM_N8v"},
+
+      {"cosf", kCosV16F16Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+      {"llvm.cos.f16", kCosV16F16Sym, llvm::ElementCount::getFixed(16), false,
+       "_ZGV_LLVM_N16v"},
+  };
+}
+
 }  // namespace
 
-std::vector<llvm::VecDesc> PolynomialApproximationsVectorization() {
+std::vector<llvm::VecDesc> PolynomialApproximationsVectorization(
+    llvm::FastMathFlags fast_math_flags) {
   auto exp = ExpVectorization();
   auto log = LogVectorization();
   auto tanh = TanhVectorization();
@@ -543,6 +729,13 @@ std::vector<llvm::VecDesc> PolynomialApproximationsVectorization() {
   vec_descs.insert(vec_descs.end(), exp.begin(), exp.end());
   vec_descs.insert(vec_descs.end(), log.begin(), log.end());
   vec_descs.insert(vec_descs.end(), tanh.begin(), tanh.end());
+
+  if (fast_math_flags.approxFunc()) {
+    auto sin = SinVectorization();
+    auto cos = CosVectorization();
+    vec_descs.insert(vec_descs.end(), sin.begin(), sin.end());
+    vec_descs.insert(vec_descs.end(), cos.begin(), cos.end());
+  }
   return vec_descs;
 }
 
@@ -606,6 +799,46 @@ void RewriteToPolynomialApproximations(llvm::Module* module,
                 /*vector_width=*/8);
   rewrite_calls(kLogV16F16Sym, UpcastF16ToF32<GenerateVF32Log>,
                 /*vector_width=*/16);
+
+  // Sin and cos approximations lose precision for large arguments, so we
+  // keep the libm calls unless approximate functions are allowed.
+  if (!fast_math_flags.approxFunc()) {
+    return;
+  }
+
+  //===----------------------------------------------------------------===//
+  // Sin
+  //===----------------------------------------------------------------===//
+
+  rewrite_calls("sinf", GenerateVF32Sin, /*vector_width=*/1);
+  rewrite_calls("llvm.sin.f32", GenerateVF32Sin, /*vector_width=*/1);
+  rewrite_calls(kSinV4F32Sym, GenerateVF32Sin, /*vector_width=*/4);
+  rewrite_calls(kSinV8F32Sym, GenerateVF32Sin, /*vector_width=*/8);
+  rewrite_calls(kSinV16F32Sym, GenerateVF32Sin, /*vector_width=*/16);
+
+  rewrite_calls("llvm.sin.f16", UpcastF16ToF32<GenerateVF32Sin>,
+                /*vector_width=*/1);
+  rewrite_calls(kSinV8F16Sym, UpcastF16ToF32<GenerateVF32Sin>,
+                /*vector_width=*/8);
+  rewrite_calls(kSinV16F16Sym, UpcastF16ToF32<GenerateVF32Sin>,
+                /*vector_width=*/16);
+
+  //===----------------------------------------------------------------===//
+  // Cos
+  //===----------------------------------------------------------------===//
+
+  rewrite_calls("cosf", GenerateVF32Cos, /*vector_width=*/1);
+  rewrite_calls("llvm.cos.f32", GenerateVF32Cos, /*vector_width=*/1);
+  rewrite_calls(kCosV4F32Sym, GenerateVF32Cos, /*vector_width=*/4);
+  rewrite_calls(kCosV8F32Sym, GenerateVF32Cos, /*vector_width=*/8);
+  rewrite_calls(kCosV16F32Sym, GenerateVF32Cos, /*vector_width=*/16);
+
+  rewrite_calls("llvm.cos.f16", UpcastF16ToF32<GenerateVF32Cos>,
+                /*vector_width=*/1);
+  rewrite_calls(kCosV8F16Sym, UpcastF16ToF32<GenerateVF32Cos>,
+                /*vector_width=*/8);
+  rewrite_calls(kCosV16F16Sym, UpcastF16ToF32<GenerateVF32Cos>,
+                /*vector_width=*/16);
 }
 
 }  // namespace xla::cpu
@@ -45,14 +45,21 @@ namespace xla::cpu {
 // vectorized polynomial approximations. This enables LLVM vectorization passes
 // to vectorize scalar math functions to custom function calls, that we later
 // rewrite into LLVM IR, so we don't have any function calls in compiled code.
-std::vector<llvm::VecDesc> PolynomialApproximationsVectorization();
+//
+// Approximations that are only accurate for a limited range of inputs (sin and
+// cos) are included only if `fast_math_flags` allow approximate functions,
+// otherwise these functions are left as calls to `libm`.
+std::vector<llvm::VecDesc> PolynomialApproximationsVectorization(
+    llvm::FastMathFlags fast_math_flags);
 
 // Rewrites supported math functions into LLVM IR polynomial approximations.
 //
 // This function rewrites function calls to the builtin LLVM math functions
 // intrinsics (i.e. `llvm.tanh.f32`) and custom XLA:CPU vectorized math
 // functions (see `PolynomialApproximationsVectorization` above) into lower
-// level polynomial approximations LLVM IR.
+// level polynomial approximations LLVM IR. Must be called with the same
+// `fast_math_flags` that were passed to
+// `PolynomialApproximationsVectorization`.
 void RewriteToPolynomialApproximations(llvm::Module* module,
                                        llvm::FastMathFlags fast_math_flags);
 
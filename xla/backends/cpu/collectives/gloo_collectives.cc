@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "xla/backends/cpu/collectives/gloo_collectives.h"
 
+#include <unistd.h>
+
 #include <cstddef>
 #include <exception>
 #include <memory>
@@ -23,6 +25,7 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -39,7 +42,9 @@ limitations under the License.
 #include "xla/core/collectives/clique_key.h"
 #include "xla/core/collectives/communicator.h"
 #include "xla/service/global_device_id.h"
+#include "xla/tsl/platform/statusor.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/platform/host_info.h"
 
 namespace xla::cpu {
 
@@ -50,6 +55,68 @@ GlooCollectives::GlooCollectives(
 
 GlooCollectives::~GlooCollectives() = default;
 
+// Returns an identifier of the current process. Ranks running in the same
+// process can exchange data through shared memory.
+static std::string ProcessId() {
+  return absl::StrCat(tsl::port::Hostname(), ":", getpid());
+}
+
+// Discovers ranks of the communicator that run in the same process as `rank`,
+// and connects leaders of all processes with a separate Gloo context. Returns
+// std::nullopt if `rank` is the only rank in its process.
+static absl::StatusOr<std::optional<GlooCommunicator::LocalGroup>>
+CreateLocalGroup(gloo::rendezvous::Store& store,
+                 const std::shared_ptr<gloo::transport::Device>& device,
+                 size_t rank, size_t num_ranks) {
+  std::string process_id = ProcessId();
+  std::vector<std::string> process_ids(num_ranks);
+
+  try {
+    store.set(absl::StrCat("process/", rank),
+              std::vector<char>(process_id.begin(), process_id.end()));
+    for (size_t i = 0; i < num_ranks; ++i) {
+      std::vector<char> id = store.get(absl::StrCat("process/", i));
+      process_ids[i] = std::string(id.begin(), id.end());
+    }
+  } catch (std::exception& e) {
+    return absl::UnknownError(
+        absl::StrCat("Gloo process discovery failed: ", e.what()));
+  }
+
+  // The first rank in each process is the process leader.
+  GlooCommunicator::LocalGroup group{/*local_rank=*/0, /*num_local_ranks=*/0,
+                                     /*leaders_context=*/nullptr};
+  std::vector<size_t> leaders;
+  for (size_t i = 0; i < num_ranks; ++i) {
+    auto first = absl::c_find(process_ids, process_ids[i]);
+    if (first == process_ids.begin() + i) leaders.push_back(i);
+
+    if (process_ids[i] == process_id) {
+      if (i < rank) ++group.local_rank;
+      ++group.num_local_ranks;
+    }
+  }
+
+  if (group.num_local_ranks == 1) return std::nullopt;
+
+  if (group.local_rank == 0 && leaders.size() > 1) {
+    size_t leader_rank = absl::c_find(leaders, rank) - leaders.begin();
+    auto leaders_context = std::make_shared<gloo::rendezvous::Context>(
+        leader_rank, leaders.size());
+    auto leaders_store = gloo::rendezvous::PrefixStore("leaders", store);
+
+    try {
+      leaders_context->connectFullMesh(leaders_store, device);
+    } catch (std::exception& e) {
+      return absl::UnknownError(absl::StrCat(
+          "Gloo leaders context initialization failed: ", e.what()));
+    }
+    group.leaders_context = std::move(leaders_context);
+  }
+
+  return group;
+}
+
 absl::StatusOr<std::vector<std::unique_ptr<Communicator>>>
 GlooCollectives::CreateCommunicators(const CliqueKey& clique_key,
                                      const std::optional<CliqueIds>& clique_ids,
@@ -76,8 +143,13 @@ GlooCollectives::CreateCommunicators(const CliqueKey& clique_key,
           absl::StrCat("Gloo context initialization failed: ", e.what()));
     }
 
+    TF_ASSIGN_OR_RETURN(
+        std::optional<GlooCommunicator::LocalGroup> local_group,
+        CreateLocalGroup(prefix_store, device_, rank, clique_key.num_devices()));
+
     communicators.push_back(std::make_unique<GlooCommunicator>(
-        std::move(gloo_context), rank, clique_key.num_devices()));
+        std::move(gloo_context), rank, clique_key.num_devices(),
+        std::move(local_group)));
   }
 
   return communicators;
@@ -41,6 +41,7 @@ limitations under the License.
 #include "gloo/transport/unbound_buffer.h"
 #include "gloo/types.h"
 #include "xla/backends/cpu/collectives/cpu_collectives.h"
+#include "xla/backends/cpu/collectives/in_process_communicator.h"
 #include "xla/core/collectives/rank_id.h"
 #include "xla/primitive_util.h"
 #include "xla/service/collective_ops_utils.h"
@@ -54,8 +55,17 @@ limitations under the License.
 namespace xla::cpu {
 
 GlooCommunicator::GlooCommunicator(std::shared_ptr<gloo::Context> context,
-                                   size_t rank, size_t num_ranks)
-    : context_(std::move(context)), rank_(rank), num_ranks_(num_ranks) {}
+                                   size_t rank, size_t num_ranks,
+                                   std::optional<LocalGroup> local_group)
+    : context_(std::move(context)),
+      rank_(rank),
+      num_ranks_(num_ranks),
+      local_group_(std::move(local_group)) {
+  if (local_group_.has_value()) {
+    local_communicator_ = std::make_unique<InProcessCommunicator>(
+        local_group_->local_rank, local_group_->num_local_ranks);
+  }
+}
 
 GlooCommunicator::~GlooCommunicator() = default;
 
@@ -101,14 +111,14 @@ static absl::Status SetAllReduceOptions(ReductionKind reduction_kind,
   return absl::OkStatus();
 }
 
-absl::Status GlooCommunicator::AllReduce(se::DeviceMemoryBase send_buffer,
-                                         se::DeviceMemoryBase recv_buffer,
-                                         PrimitiveType dtype, size_t count,
-                                         ReductionKind reduction_kind,
-                                         const Executor& executor) {
-  TF_ASSIGN_OR_RETURN(auto cpu_executor, CpuCollectives::TryCast(&executor));
-
-  gloo::AllreduceOptions options(context_);
+// All-reduce across all ranks of the Gloo `context`.
+static absl::Status GlooAllReduce(std::shared_ptr<gloo::Context> context,
+                                  se::DeviceMemoryBase send_buffer,
+                                  se::DeviceMemoryBase recv_buffer,
+                                  PrimitiveType dtype, size_t count,
+                                  ReductionKind reduction_kind,
+                                  absl::Duration timeout) {
+  gloo::AllreduceOptions options(context);
   // TODO(phawkins): how to do tags?
   // options.setTag(tag);
   switch (dtype) {
@@ -173,7 +183,7 @@ absl::Status GlooCommunicator::AllReduce(se::DeviceMemoryBase send_buffer,
       return absl::InvalidArgumentError("Unknown datatype in allreduce");
   }
   options.setAlgorithm(gloo::AllreduceOptions::Algorithm::RING);
-  options.setTimeout(absl::ToChronoMilliseconds(cpu_executor->timeout()));
+  options.setTimeout(absl::ToChronoMilliseconds(timeout));
 
   try {
     gloo::allreduce(options);
@@ -184,6 +194,40 @@ absl::Status GlooCommunicator::AllReduce(se::DeviceMemoryBase send_buffer,
   return absl::OkStatus();
 }
 
+absl::Status GlooCommunicator::AllReduce(se::DeviceMemoryBase send_buffer,
+                                         se::DeviceMemoryBase recv_buffer,
+                                         PrimitiveType dtype, size_t count,
+                                         ReductionKind reduction_kind,
+                                         const Executor& executor) {
+  TF_ASSIGN_OR_RETURN(auto cpu_executor, CpuCollectives::TryCast(&executor));
+
+  if (!local_group_.has_value()) {
+    return GlooAllReduce(context_, send_buffer, recv_buffer, dtype, count,
+                         reduction_kind, cpu_executor->timeout());
+  }
+
+  // Ranks in the same process rendezvous with each other through the
+  // in-process communicator.
+  RendezvousKey local_key = cpu_executor->rendezvous_key();
+  local_key.num_local_participants = local_group_->num_local_ranks;
+  CpuCollectives::Executor local_executor(local_key, cpu_executor->timeout());
+
+  // (1) Reduce data from all ranks in the process through shared memory.
+  TF_RETURN_IF_ERROR(local_communicator_->AllReduce(
+      send_buffer, recv_buffer, dtype, count, reduction_kind, local_executor));
+
+  // (2) Leader ranks all-reduce partial results across processes.
+  if (local_group_->leaders_context) {
+    TF_RETURN_IF_ERROR(GlooAllReduce(local_group_->leaders_context,
+                                     recv_buffer, recv_buffer, dtype, count,
+                                     reduction_kind, cpu_executor->timeout()));
+  }
+
+  // (3) Broadcast the result from the leader to all ranks in the process.
+  return local_communicator_->Broadcast(recv_buffer, recv_buffer, dtype, count,
+                                        RankId(0), local_executor);
+}
+
 static constexpr uint8_t kCollectivePermuteSlotPrefix = 0x40;
 
 absl::Status GlooCommunicator::CollectivePermute(
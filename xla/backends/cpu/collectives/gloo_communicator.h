@@ -26,6 +26,7 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
 #include "gloo/context.h"
+#include "xla/backends/cpu/collectives/in_process_communicator.h"
 #include "xla/core/collectives/communicator.h"
 #include "xla/core/collectives/rank_id.h"
 #include "xla/service/collective_ops_utils.h"
@@ -36,10 +37,25 @@ limitations under the License.
 namespace xla::cpu {
 
 // XLA communicator implemented using Gloo communication library.
+//
+// If multiple ranks of the communicator run in the same process, all-reduce is
+// hierarchical: ranks in the process reduce data through shared memory, and
+// only one leader rank per process exchanges data with other processes.
 class GlooCommunicator : public Communicator {
  public:
+  // Ranks of the communicator that run in the same process as this rank.
+  struct LocalGroup {
+    size_t local_rank;
+    size_t num_local_ranks;
+
+    // Gloo context connecting leaders (local rank 0) of all processes. It is
+    // set only for leader ranks, and only if there are multiple processes.
+    std::shared_ptr<gloo::Context> leaders_context;
+  };
+
   GlooCommunicator(std::shared_ptr<gloo::Context> context, size_t rank,
-                   size_t num_ranks);
+                   size_t num_ranks,
+                   std::optional<LocalGroup> local_group = std::nullopt);
   ~GlooCommunicator() override;
 
   absl::Status AllReduce(se::DeviceMemoryBase send_buffer,
@@ -96,6 +112,9 @@ class GlooCommunicator : public Communicator {
   std::shared_ptr<gloo::Context> context_;
   size_t rank_;
   size_t num_ranks_;
+
+  std::optional<LocalGroup> local_group_;
+  std::unique_ptr<InProcessCommunicator> local_communicator_;
 };
 
 }  // namespace xla::cpu
@@ -114,6 +114,9 @@ std::vector<Participant> CollectParticipants(
   return ret;
 }
 
+// Size of the blocks (in bytes) that collective operations reduce at a time.
+static constexpr size_t kReduceBlockBytes = 16 * 1024;
+
 template <typename T>
 T GetInitialValue(ReductionKind reduction_kind) {
   switch (reduction_kind) {
@@ -233,6 +236,8 @@ static absl::Status AllReduceOp(
         primitive_util::LowercasePrimitiveTypeName(primitive_type));
   }
 
+  size_t byte_width = primitive_util::ByteWidth(primitive_type);
+
   // Each partiticipant will process a single chunk of the data and then copy
   // the result to all other participants.
   size_t chunk_size = tsl::MathUtil::CeilOfRatio(count, participants.size());
@@ -243,32 +248,41 @@ static absl::Status AllReduceOp(
   if (chunk_count == 0) return absl::OkStatus();
 
   // Returns a pointer to the chunk of data for the given participant rank.
-  auto chunk_ptr = [&](se::DeviceMemoryBase mem) -> void* {
+  auto chunk_ptr = [&](se::DeviceMemoryBase mem) -> std::byte* {
     std::byte* ptr = static_cast<std::byte*>(mem.opaque());
-    return ptr + rank * chunk_size * primitive_util::ByteWidth(primitive_type);
+    return ptr + rank * chunk_size * byte_width;
   };
 
-  // Collect reduction inputs from all participants.
+  // We reduce the chunk in blocks that fit into L1 cache, and copy each reduced
+  // block to all participants while it is still hot in cache. Reducing into a
+  // local buffer also makes in-place all-reduce (src == dest) safe, because
+  // destination chunks are not written until all inputs for them are read.
+  alignas(64) std::byte block[kReduceBlockBytes];
+  size_t block_size = kReduceBlockBytes / byte_width;
+
   std::vector<const void*> inputs(participants.size());
-  for (auto& participant : participants) {
-    inputs[participant.rank] = chunk_ptr(participant.src);
-  }
 
-  // Reduce all inputs into the destination buffer at rank 0.
-  void* output = chunk_ptr(participants[0].dest);
-
-  TF_RETURN_IF_ERROR(primitive_util::ArrayTypeSwitch<absl::Status>(
-      [&](const auto type_tag) {
-        return ReduceScatter<type_tag>(reduction_kind, inputs, output,
-                                       chunk_count);
-      },
-      primitive_type));
-
-  // Copy all-reduced output to all other participants.
-  for (size_t i = 1; i < participants.size(); ++i) {
-    std::memcpy(chunk_ptr(participants[i].dest),
-                chunk_ptr(participants[0].dest),
-                chunk_count * primitive_util::ByteWidth(primitive_type));
+  for (size_t offset = 0; offset < chunk_count; offset += block_size) {
+    size_t block_count = std::min(block_size, chunk_count - offset);
+    size_t block_offset = offset * byte_width;
+
+    // Collect reduction inputs from all participants.
+    for (auto& participant : participants) {
+      inputs[participant.rank] = chunk_ptr(participant.src) + block_offset;
+    }
+
+    TF_RETURN_IF_ERROR(primitive_util::ArrayTypeSwitch<absl::Status>(
+        [&](const auto type_tag) {
+          return ReduceScatter<type_tag>(reduction_kind, inputs, block,
+                                         block_count);
+        },
+        primitive_type));
+
+    // Copy all-reduced block to all participants.
+    for (auto& participant : participants) {
+      std::memcpy(chunk_ptr(participant.dest) + block_offset, block,
+                  block_count * byte_width);
+    }
   }
 
   return absl::OkStatus();
@@ -294,25 +308,38 @@ static absl::Status ReduceScatterOp(
   }
 
   size_t num_participants = participants.size();
-  size_t num_bytes = count * primitive_util::ByteWidth(primitive_type);
+  size_t byte_width = primitive_util::ByteWidth(primitive_type);
+  size_t num_bytes = count * byte_width;
 
   size_t offset = rank * num_bytes;
 
-  // Collect reduction inputs from all participants.
+  // Reduce in blocks that fit into L1 cache, so that partially reduced values
+  // stay in cache while we accumulate inputs from all participants.
+  size_t block_size = kReduceBlockBytes / byte_width;
   std::vector<const void*> inputs(num_participants);
-  for (size_t j = 0; j < num_participants; ++j) {
-    std::byte* src = static_cast<std::byte*>(participants[j].src.opaque());
-    inputs[j] = src + offset;
-  }
 
-  // Reduce all inputs into the destination buffer.
-  void* output = participants[rank].dest.opaque();
+  for (size_t i = 0; i < count; i += block_size) {
+    size_t block_count = std::min(block_size, count - i);
+    size_t block_offset = i * byte_width;
 
-  TF_RETURN_IF_ERROR(primitive_util::ArrayTypeSwitch<absl::Status>(
-      [&](const auto type_tag) {
-        return ReduceScatter<type_tag>(reduction_kind, inputs, output, count);
-      },
-      primitive_type));
+    // Collect reduction inputs from all participants.
+    for (size_t j = 0; j < num_participants; ++j) {
+      std::byte* src = static_cast<std::byte*>(participants[j].src.opaque());
+      inputs[j] = src + offset + block_offset;
+    }
+
+    // Reduce all inputs into the destination buffer.
+    std::byte* output =
+        static_cast<std::byte*>(participants[rank].dest.opaque()) +
+        block_offset;
+
+    TF_RETURN_IF_ERROR(primitive_util::ArrayTypeSwitch<absl::Status>(
+        [&](const auto type_tag) {
+          return ReduceScatter<type_tag>(reduction_kind, inputs, output,
+                                         block_count);
+        },
+        primitive_type));
+  }
 
   return absl::OkStatus();
 }
@@ -386,6 +413,30 @@ static absl::Status CollectivePermuteOp(
   return absl::OkStatus();
 }
 
+//===----------------------------------------------------------------------===//
+// Broadcast
+//===----------------------------------------------------------------------===//
+
+struct BroadcastParticipant {
+  size_t rank;
+  se::DeviceMemoryBase src;
+  se::DeviceMemoryBase dest;
+};
+
+static absl::Status BroadcastOp(
+    absl::Span<const BroadcastParticipant> participants, size_t rank,
+    size_t root, size_t num_bytes) {
+  const BroadcastParticipant& participant = participants[rank];
+  const void* src = participants.at(root).src.opaque();
+
+  // Root buffer can be broadcasted in place.
+  if (participant.dest.opaque() != src) {
+    std::memcpy(participant.dest.opaque(), src, num_bytes);
+  }
+
+  return absl::OkStatus();
+}
+
 }  // namespace
 
 //===----------------------------------------------------------------------===//
@@ -467,6 +518,26 @@ absl::Status InProcessCommunicator::AllToAll(
   return op->Invoke(AllToAllOp, rank_, num_bytes);
 }
 
+absl::Status InProcessCommunicator::Broadcast(se::DeviceMemoryBase send_buffer,
+                                              se::DeviceMemoryBase recv_buffer,
+                                              PrimitiveType dtype, size_t count,
+                                              RankId root,
+                                              const Executor& executor) {
+  TF_ASSIGN_OR_RETURN(auto cpu_executor, CpuCollectives::TryCast(&executor));
+  const RendezvousKey& key = cpu_executor->rendezvous_key();
+
+  std::string name = absl::StrCat("broadcast ", key.ToString());
+  BroadcastParticipant partiticipant{rank_, send_buffer, recv_buffer};
+
+  auto op = Rendezvous<OpParticipants<BroadcastParticipant>>(
+      name, key, partiticipant, key.num_local_participants,
+      CollectParticipants<BroadcastParticipant>);
+
+  size_t num_bytes = count * primitive_util::ByteWidth(dtype);
+  size_t root_rank = root.value();
+  return op->Invoke(BroadcastOp, rank_, root_rank, num_bytes);
+}
+
 absl::Status InProcessCommunicator::AllGather(se::DeviceMemoryBase send_buffer,
                                               se::DeviceMemoryBase recv_buffer,
                                               PrimitiveType dtype, size_t count,
@@ -66,11 +66,10 @@ class InProcessCommunicator : public Communicator {
                              ReductionKind reduction_kind,
                              const Executor& executor) override;
 
-  absl::Status Broadcast(se::DeviceMemoryBase, se::DeviceMemoryBase,
-                         PrimitiveType, size_t, RankId,
-                         const Executor&) override {
-    return Unimplemented("Broadcast is not implemented");
-  }
+  absl::Status Broadcast(se::DeviceMemoryBase send_buffer,
+                         se::DeviceMemoryBase recv_buffer, PrimitiveType dtype,
+                         size_t count, RankId root,
+                         const Executor& executor) override;
 
   absl::Status Send(se::DeviceMemoryBase, PrimitiveType, size_t, RankId,
                     const Executor&) override {
@@ -0,0 +1,200 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/collectives/in_process_communicator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+#include "xla/backends/cpu/collectives/cpu_collectives.h"
+#include "xla/core/collectives/rank_id.h"
+#include "xla/executable_run_options.h"
+#include "xla/service/collective_ops_utils.h"
+#include "xla/service/global_device_id.h"
+#include "xla/stream_executor/device_memory.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/test_benchmark.h"
+#include "xla/tsl/platform/threadpool.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+namespace {
+
+constexpr absl::Duration kTimeout = absl::Seconds(10);
+
+CpuCollectives::Executor MakeExecutor(size_t num_ranks, int64_t op_id) {
+  std::vector<GlobalDeviceId> global_devices;
+  for (size_t i = 0; i < num_ranks; ++i) {
+    global_devices.push_back(GlobalDeviceId(i));
+  }
+  RendezvousKey key(RunId(0), global_devices, num_ranks,
+                    RendezvousKey::CollectiveOpKind::kCrossModule, op_id);
+  return CpuCollectives::Executor(key, kTimeout);
+}
+
+// Runs `fn` for all ranks concurrently, each rank in a separate thread.
+void RunOnAllRanks(size_t num_ranks,
+                   std::function<void(InProcessCommunicator&, size_t)> fn) {
+  tsl::thread::ThreadPool pool(tsl::Env::Default(), "in_process_ranks",
+                               num_ranks);
+  for (size_t rank = 0; rank < num_ranks; ++rank) {
+    pool.Schedule([&, rank] {
+      InProcessCommunicator comm(rank, num_ranks);
+      fn(comm, rank);
+    });
+  }
+}
+
+template <typename T>
+se::DeviceMemoryBase AsDeviceMemory(std::vector<T>& data) {
+  return se::DeviceMemoryBase(data.data(), data.size() * sizeof(T));
+}
+
+TEST(InProcessCommunicatorTest, AllReduce) {
+  // Count is not a multiple of the number of ranks, and chunks of each rank
+  // are reduced in multiple blocks.
+  constexpr size_t kNumRanks = 4;
+  constexpr size_t kCount = 40003;
+
+  std::vector<std::vector<float>> src(kNumRanks), dst(kNumRanks);
+  for (size_t rank = 0; rank < kNumRanks; ++rank) {
+    src[rank].resize(kCount);
+    dst[rank].resize(kCount);
+    for (size_t i = 0; i < kCount; ++i) src[rank][i] = rank + i % 7;
+  }
+
+  RunOnAllRanks(kNumRanks, [&](InProcessCommunicator& comm, size_t rank) {
+    TF_ASSERT_OK(comm.AllReduce(
+        AsDeviceMemory(src[rank]), AsDeviceMemory(dst[rank]), F32, kCount,
+        ReductionKind::SUM, MakeExecutor(kNumRanks, /*op_id=*/0)));
+  });
+
+  for (size_t rank = 0; rank < kNumRanks; ++rank) {
+    for (size_t i = 0; i < kCount; ++i) {
+      ASSERT_EQ(dst[rank][i], 6 + 4 * (i % 7)) << "rank=" << rank << " i=" << i;
+    }
+  }
+}
+
+TEST(InProcessCommunicatorTest, InPlaceAllReduce) {
+  constexpr size_t kNumRanks = 3;
+  constexpr size_t kCount = 10000;
+
+  std::vector<std::vector<int32_t>> buf(kNumRanks);
+  for (size_t rank = 0; rank < kNumRanks; ++rank) {
+    buf[rank].assign(kCount, rank + 1);
+  }
+
+  RunOnAllRanks(kNumRanks, [&](InProcessCommunicator& comm, size_t rank) {
+    TF_ASSERT_OK(comm.AllReduce(
+        AsDeviceMemory(buf[rank]), AsDeviceMemory(buf[rank]), S32, kCount,
+        ReductionKind::MAX, MakeExecutor(kNumRanks, /*op_id=*/1)));
+  });
+
+  for (size_t rank = 0; rank < kNumRanks; ++rank) {
+    EXPECT_THAT(buf[rank], ::testing::Each(kNumRanks));
+  }
+}
+
+TEST(InProcessCommunicatorTest, ReduceScatter) {
+  constexpr size_t kNumRanks = 2;
+  constexpr size_t kCount = 5000;
+
+  std::vector<std::vector<float>> src(kNumRanks), dst(kNumRanks);
+  for (size_t rank = 0; rank < kNumRanks; ++rank) {
+    src[rank].resize(kNumRanks * kCount);
+    dst[rank].resize(kCount);
+    for (size_t i = 0; i < src[rank].size(); ++i) src[rank][i] = i;
+  }
+
+  RunOnAllRanks(kNumRanks, [&](InProcessCommunicator& comm, size_t rank) {
+    TF_ASSERT_OK(comm.ReduceScatter(
+        AsDeviceMemory(src[rank]), AsDeviceMemory(dst[rank]), F32, kCount,
+        ReductionKind::SUM, MakeExecutor(kNumRanks, /*op_id=*/2)));
+  });
+
+  for (size_t rank = 0; rank < kNumRanks; ++rank) {
+    for (size_t i = 0; i < kCount; ++i) {
+      ASSERT_EQ(dst[rank][i], 2.0f * (rank * kCount + i));
+    }
+  }
+}
+
+TEST(InProcessCommunicatorTest, Broadcast) {
+  constexpr size_t kNumRanks = 3;
+  constexpr size_t kCount = 100;
+
+  std::vector<std::vector<int32_t>> buf(kNumRanks);
+  for (size_t rank = 0; rank < kNumRanks; ++rank) {
+    buf[rank].assign(kCount, rank);
+  }
+
+  RunOnAllRanks(kNumRanks, [&](InProcessCommunicator& comm, size_t rank) {
+    TF_ASSERT_OK(comm.Broadcast(
+        AsDeviceMemory(buf[rank]), AsDeviceMemory(buf[rank]), S32, kCount,
+        RankId(1), MakeExecutor(kNumRanks, /*op_id=*/3)));
+  });
+
+  for (size_t rank = 0; rank < kNumRanks; ++rank) {
+    EXPECT_THAT(buf[rank], ::testing::Each(1));
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Performance benchmarks.
+//===----------------------------------------------------------------------===//
+
+static void BM_AllReduce(benchmark::State& state) {
+  size_t num_ranks = state.range(0);
+  size_t count = state.range(1);
+
+  std::vector<std::vector<float>> src(num_ranks), dst(num_ranks);
+  for (size_t rank = 0; rank < num_ranks; ++rank) {
+    src[rank].assign(count, 1.0f);
+    dst[rank].resize(count);
+  }
+
+  int64_t op_id = 0;
+  for (auto _ : state) {
+    RunOnAllRanks(num_ranks, [&](InProcessCommunicator& comm, size_t rank) {
+      CHECK_OK(comm.AllReduce(AsDeviceMemory(src[rank]),
+                              AsDeviceMemory(dst[rank]), F32, count,
+                              ReductionKind::SUM,
+                              MakeExecutor(num_ranks, op_id)));
+    });
+    ++op_id;
+  }
+
+  state.SetBytesProcessed(state.iterations() * num_ranks * count *
+                          sizeof(float));
+}
+
+BENCHMARK(BM_AllReduce)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->ArgNames({"ranks", "count"})
+    ->Args({8, 1024 * 1024})
+    ->Args({8, 16 * 1024 * 1024})
+    ->Args({16, 16 * 1024 * 1024});
+
+}  // namespace
+}  // namespace xla::cpu
@@ -21,6 +21,7 @@ limitations under the License.
 #include <variant>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -135,4 +136,32 @@ absl::StatusOr<std::vector<ConstantAllocation>> CreateConstantAllocations(
   return constants;
 }
 
+absl::StatusOr<std::vector<ConstantAllocation>> CreateConstantAllocations(
+    const BufferAssignment& assignment,
+    const absl::flat_hash_map<BufferAllocation::Index,
+                              absl::Span<const uint8_t>>& data,
+    std::shared_ptr<const void> storage) {
+  std::vector<ConstantAllocation> constants;
+
+  for (const BufferAllocation& allocation : assignment.Allocations()) {
+    if (!allocation.is_constant()) {
+      continue;
+    }
+
+    auto it = data.find(allocation.index());
+    if (it == data.end()) {
+      return absl::InternalError(
+          absl::StrCat("Could not find data for constant buffer ",
+                       allocation.ToString()));
+    }
+
+    VLOG(3) << "Create constant allocation for index " << allocation.index()
+            << " from external data; size=" << it->second.size();
+    constants.push_back(ConstantAllocation{allocation.index(), it->second,
+                                           storage});
+  }
+
+  return constants;
+}
+
 }  // namespace xla::cpu
@@ -21,6 +21,7 @@ limitations under the License.
 #include <variant>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xla/literal.h"
@@ -37,12 +38,25 @@ struct ConstantAllocation {
   std::variant<std::monostate, std::unique_ptr<Literal>,
                absl::Span<const uint8_t>>
       data;
+
+  // Optional owner of the memory referenced by the `absl::Span` data, i.e. a
+  // memory mapped AOT image.
+  std::shared_ptr<const void> storage;
 };
 
 // Creates a vector of constant allocations from the given buffer assignment.
 absl::StatusOr<std::vector<ConstantAllocation>> CreateConstantAllocations(
     const BufferAssignment& assignment);
 
+// Creates a vector of constant allocations from the given buffer assignment
+// using externally provided data for every constant allocation (instead of
+// constant literals), `storage` keeps the data alive.
+absl::StatusOr<std::vector<ConstantAllocation>> CreateConstantAllocations(
+    const BufferAssignment& assignment,
+    const absl::flat_hash_map<BufferAllocation::Index,
+                              absl::Span<const uint8_t>>& data,
+    std::shared_ptr<const void> storage);
+
 }  // namespace xla::cpu
 
 #endif  // XLA_BACKENDS_CPU_CONSTANT_ALLOCATION_H_
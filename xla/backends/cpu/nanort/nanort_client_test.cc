@@ -15,7 +15,11 @@ limitations under the License.
 
 #include "xla/backends/cpu/nanort/nanort_client.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -49,6 +53,19 @@ limitations under the License.
 #include "Eigen/ThreadPool"
 #include "unsupported/Eigen/CXX11/Tensor"
 
+// Counts heap allocations in the current thread, to verify that the prepared
+// call hot path does not allocate.
+static thread_local int64_t num_heap_allocations = 0;
+
+void* operator new(size_t size) {
+  ++num_heap_allocations;
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  std::abort();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
 namespace xla::cpu {
 namespace {
 
@@ -274,6 +291,143 @@ ENTRY test_module {
   EXPECT_EQ(result_span[0], expected_result);
 }
 
+TEST(NanoRtClientTest, CompileAndRunBatchedComputation) {
+  absl::string_view hlo = R"(
+    HloModule conditional
+
+    %add (x: f32[]) -> f32[] {
+      %p = f32[] parameter(0)
+      ROOT %add = f32[] add(%p, %p)
+    }
+
+    %mul (x: f32[]) -> f32[] {
+      %p = f32[] parameter(0)
+      ROOT %mul = f32[] multiply(%p, %p)
+    }
+
+    ENTRY e {
+      p0 = s32[] parameter(0)
+      p1 = f32[] parameter(1)
+      c0 = f32[] conditional(p0, p1, p1), branch_computations={%add, %mul}
+      ROOT add = f32[] add(c0, c0)
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnUnverifiedModule(hlo));
+  XlaComputation computation(module->ToProto());
+
+  NanoRtClient client;
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<NanoRtExecutable> executable,
+                          client.Compile(computation));
+
+  static constexpr int kBatchSize = 16;
+
+  // Storage for executable parameters and results of all requests.
+  alignas(32) int32_t p0_values[kBatchSize];
+  alignas(32) float p1_values[kBatchSize];
+  alignas(32) float r0_values[kBatchSize];
+
+  std::vector<Arguments> arguments(kBatchSize);
+  std::vector<Results> results(kBatchSize);
+  std::vector<NanoRtExecutable::Request> requests(kBatchSize);
+
+  for (int i = 0; i < kBatchSize; ++i) {
+    p0_values[i] = i % 2;
+    p1_values[i] = i;
+    arguments[i] = {{&p0_values[i], 1}, {&p1_values[i], 1}};
+    results[i] = {{&r0_values[i], 1}};
+    requests[i] = {arguments[i], results[i]};
+  }
+
+  NanoRtExecutable::TempPool temp_pool(executable->temp_buffer_size());
+
+  Eigen::ThreadPool tp(4);
+  Eigen::ThreadPoolDevice device(&tp, tp.NumThreads());
+
+  NanoRtExecutable::ExecuteOptions no_thread_pool;
+  NanoRtExecutable::ExecuteOptions thread_pool;
+  thread_pool.set_intra_op_thread_pool(&device);
+
+  for (auto* execute_options : {&no_thread_pool, &thread_pool}) {
+    std::fill(std::begin(r0_values), std::end(r0_values), 0.0f);
+
+    auto event =
+        executable->ExecuteBatch(requests, temp_pool, *execute_options);
+    tsl::BlockUntilReady(event);
+    ASSERT_TRUE(event.IsConcrete());
+
+    for (int i = 0; i < kBatchSize; ++i) {
+      float expected = i % 2 == 0 ? 4.0f * i : 2.0f * i * i;
+      EXPECT_EQ(r0_values[i], expected) << "request " << i;
+    }
+  }
+}
+
+TEST(NanoRtClientTest, CompileAndRunPreparedCall) {
+  absl::string_view hlo = R"(
+    HloModule conditional
+
+    %add (x: f32[]) -> f32[] {
+      %p = f32[] parameter(0)
+      ROOT %add = f32[] add(%p, %p)
+    }
+
+    %mul (x: f32[]) -> f32[] {
+      %p = f32[] parameter(0)
+      ROOT %mul = f32[] multiply(%p, %p)
+    }
+
+    ENTRY e {
+      p0 = s32[] parameter(0)
+      p1 = f32[] parameter(1)
+      c0 = f32[] conditional(p0, p1, p1), branch_computations={%add, %mul}
+      ROOT add = f32[] add(c0, c0)
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnUnverifiedModule(hlo));
+  XlaComputation computation(module->ToProto());
+
+  NanoRtClient client;
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<NanoRtExecutable> executable,
+                          client.Compile(computation));
+
+  auto call = executable->Prepare();
+
+  // Storage for executable parameters and results.
+  alignas(32) int32_t p0_value = 0;
+  alignas(32) float p1_values[2] = {2.0f, 3.0f};
+  alignas(32) float r0_values[2] = {0.0f, 0.0f};
+
+  NanoRtExecutable::ManagedTemp<32> temp(executable->temp_buffer_size());
+
+  // Re-bind different arguments and results for each call.
+  for (int i = 0; i < 2; ++i) {
+    Arguments arguments = {{&p0_value, 1}, {&p1_values[i], 1}};
+    Results results = {{&r0_values[i], 1}};
+
+    int64_t num_allocations = num_heap_allocations;
+    auto event = call->Execute(arguments, results, temp);
+    tsl::BlockUntilReady(event);
+
+    // The first call can initialize lazily created executable state.
+    if (i > 0) EXPECT_EQ(num_heap_allocations, num_allocations);
+    ASSERT_TRUE(event.IsConcrete());
+  }
+
+  EXPECT_EQ(r0_values[0], 4.0f);
+  EXPECT_EQ(r0_values[1], 6.0f);
+
+  // Arguments are validated on every call.
+  Arguments arguments = {{&p0_value, 1}};
+  Results results = {{&r0_values[0], 1}};
+  auto event = call->Execute(arguments, results, temp);
+  tsl::BlockUntilReady(event);
+  ASSERT_TRUE(event.IsError());
+  EXPECT_THAT(event.GetError().message(),
+              ::testing::HasSubstr("Expected 2 arguments, got 1"));
+}
+
 //===----------------------------------------------------------------------===//
 // Performance benchmarks below
 //===----------------------------------------------------------------------===//
@@ -368,6 +522,77 @@ BENCHMARK_CAPTURE(BM_NanoRtFibonacci, no_thread_pool, std::nullopt);
 BENCHMARK_CAPTURE(BM_NanoRtFibonacci, thread_pool,
                   std::make_optional<Eigen::ThreadPool>(2));
 
+static void BM_NanoRtFibonacciBatch(benchmark::State& state) {
+  size_t batch_size = state.range(0);
+
+  NanoRtClient client;
+
+  auto computation = CreateFibonacciComputation();
+  auto executable = client.Compile(*computation);
+
+  Eigen::ThreadPool tp(4);
+  Eigen::ThreadPoolDevice device(&tp, tp.NumThreads());
+
+  NanoRtExecutable::ExecuteOptions execute_options;
+  execute_options.set_intra_op_thread_pool(&device);
+
+  NanoRtExecutable::TempPool temp_pool((*executable)->temp_buffer_size());
+
+  // Storage for executable arguments and results.
+  alignas(32) float p0_value = 1.0f;
+  alignas(32) float p1_value = 2.0f;
+  std::vector<float> r0_values(batch_size);
+
+  Arguments arguments = {{&p0_value, 1}, {&p1_value, 1}};
+  std::vector<Results> results(batch_size);
+  std::vector<NanoRtExecutable::Request> requests(batch_size);
+  for (size_t i = 0; i < batch_size; ++i) {
+    results[i] = {{&r0_values[i], 1}};
+    requests[i] = {arguments, results[i]};
+  }
+
+  for (auto _ : state) {
+    auto event =
+        (*executable)->ExecuteBatch(requests, temp_pool, execute_options);
+    tsl::BlockUntilReady(event);
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK(BM_NanoRtFibonacciBatch)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+
+static void BM_NanoRtFibonacciPreparedCall(benchmark::State& state) {
+  NanoRtClient client;
+
+  auto computation = CreateFibonacciComputation();
+  auto executable = client.Compile(*computation);
+  auto call = (*executable)->Prepare();
+
+  // Storage for executable arguments and results.
+  alignas(32) float p0_value = 1.0f;
+  alignas(32) float p1_value = 2.0f;
+  alignas(32) float r0_value = 0.0f;
+
+  Arguments arguments = {{&p0_value, 1}, {&p1_value, 1}};
+  Results results = {{&r0_value, 1}};
+
+  // Warm up lazily initialized executable state.
+  tsl::BlockUntilReady(call->Execute(arguments, results));
+
+  int64_t num_allocations = num_heap_allocations;
+  for (auto _ : state) {
+    auto event = call->Execute(arguments, results);
+    tsl::BlockUntilReady(event);
+  }
+
+  if (num_heap_allocations != num_allocations) {
+    state.SkipWithError("Prepared call must not allocate on the heap");
+  }
+}
+
+BENCHMARK(BM_NanoRtFibonacciPreparedCall);
+
 static void BM_PjRtAddScalars(benchmark::State& state) {
   auto client = GetXlaPjrtCpuClient(/*options=*/{});
   PjRtDevice* device = (*client)->devices().front();
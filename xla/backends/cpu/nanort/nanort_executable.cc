@@ -26,6 +26,7 @@ limitations under the License.
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/backends/cpu/runtime/buffer_allocations.h"
 #include "xla/backends/cpu/runtime/function_library.h"
@@ -271,16 +272,9 @@ static se::DeviceMemoryBase ToDeviceMemory(
                               temp.size());
 }
 
-tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
+absl::Status NanoRtExecutable::BindBuffers(
     absl::Span<const Argument> arguments, absl::Span<const Result> results,
-    PreallocatedTemp temp, const ExecuteOptions& options) {
-  TraceMe trace([&] {
-    return TraceMeEncode("NanoRtExecutable::Execute",
-                         {{"name", executable_->module().name()}});
-  });
-
-  auto* executable = tsl::down_cast<cpu::CpuExecutable*>(executable_.get());
-
+    PreallocatedTemp temp, absl::Span<se::DeviceMemoryBase> buffers) const {
   size_t num_arguments = argument_to_allocation_index_.size();
   size_t num_results = result_to_allocation_index_.size();
 
@@ -294,9 +288,6 @@ tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
                            results.size());
   }
 
-  // Prepare buffer allocations for arguments, results, and temp.
-  cpu::BufferAllocations::Buffers buffers(allocation_sizes_.size());
-
   for (size_t i = 0; i < num_arguments; ++i) {
     size_t idx = argument_to_allocation_index_[i];
     buffers[idx] = ToDeviceMemory(arguments[i]);
@@ -327,6 +318,13 @@ tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
     }
   }
 
+  return absl::OkStatus();
+}
+
+void NanoRtExecutable::BindConstants(
+    absl::Span<se::DeviceMemoryBase> buffers) const {
+  auto* executable = tsl::down_cast<cpu::CpuExecutable*>(executable_.get());
+
   for (const auto& constant : executable->constants()) {
     // Constants are re-indexed by the buffer allocation index at CpuExecutable
     // construction time, and `executable->constants()` actually returns the
@@ -336,6 +334,23 @@ tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
       buffers[constant.index] = constant.AsDeviceMemoryBase();
     }
   }
+}
+
+tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
+    absl::Span<const Argument> arguments, absl::Span<const Result> results,
+    PreallocatedTemp temp, const ExecuteOptions& options) {
+  TraceMe trace([&] {
+    return TraceMeEncode("NanoRtExecutable::Execute",
+                         {{"name", executable_->module().name()}});
+  });
+
+  auto* executable = tsl::down_cast<cpu::CpuExecutable*>(executable_.get());
+
+  // Prepare buffer allocations for arguments, results, temp and constants.
+  cpu::BufferAllocations::Buffers buffers(allocation_sizes_.size());
+  TF_RETURN_IF_ERROR(
+      BindBuffers(arguments, results, temp, absl::MakeSpan(buffers)));
+  BindConstants(absl::MakeSpan(buffers));
 
   struct ExecutionContext {
     ExecutionContext(cpu::BufferAllocations::Buffers buffers,
@@ -372,6 +387,122 @@ tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent> NanoRtExecutable::Execute(
   }
 }
 
+std::unique_ptr<NanoRtExecutable::TempPool::Temp>
+NanoRtExecutable::TempPool::Acquire() {
+  {
+    absl::MutexLock lock(&mu_);
+    if (!temps_.empty()) {
+      std::unique_ptr<Temp> temp = std::move(temps_.back());
+      temps_.pop_back();
+      return temp;
+    }
+  }
+  return std::make_unique<Temp>(size_);
+}
+
+void NanoRtExecutable::TempPool::Release(std::unique_ptr<Temp> temp) {
+  absl::MutexLock lock(&mu_);
+  temps_.push_back(std::move(temp));
+}
+
+tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent>
+NanoRtExecutable::ExecuteBatch(absl::Span<const Request> requests,
+                               TempPool& temp_pool,
+                               const ExecuteOptions& options) {
+  TraceMe trace([&] {
+    return TraceMeEncode("NanoRtExecutable::ExecuteBatch",
+                         {{"name", executable_->module().name()},
+                          {"batch_size", requests.size()}});
+  });
+
+  if (ABSL_PREDICT_FALSE(temp_pool.size() != temp_buffer_size())) {
+    return InvalidArgument("Temp pool size mismatch: expected %d, got %d",
+                           temp_buffer_size(), temp_pool.size());
+  }
+
+  if (requests.empty()) {
+    return tsl::MakeAvailableAsyncValueRef<ExecuteEvent>();
+  }
+
+  // Requests are copied into the shared state, because with a thread pool we
+  // launch them after returning from this function.
+  struct BatchState {
+    std::vector<Request> requests;
+    tsl::CountDownAsyncValueRef<ExecuteEvent> count_down;
+  };
+
+  auto state = std::make_shared<BatchState>(
+      BatchState{{requests.begin(), requests.end()},
+                 tsl::CountDownAsyncValueRef<ExecuteEvent>(requests.size())});
+  auto execute_event = state->count_down.AsRef();
+
+  // Executes request `i` with a temp buffer borrowed from the pool, and returns
+  // the buffer back to the pool when the execution completes.
+  auto execute = [this, &temp_pool, &options, state](size_t i) {
+    std::unique_ptr<TempPool::Temp> temp = temp_pool.Acquire();
+    const Request& request = state->requests[i];
+
+    auto event =
+        Execute(request.arguments, request.results, temp->data(), options);
+    event.AndThen([&temp_pool, temp = std::move(temp),
+                   state](absl::Status status) mutable {
+      temp_pool.Release(std::move(temp));
+      state->count_down.CountDown(status);
+    });
+  };
+
+  const Eigen::ThreadPoolDevice* device = options.intra_op_thread_pool();
+
+  if (device == nullptr) {
+    for (size_t i = 0; i < requests.size(); ++i) execute(i);
+    return execute_event;
+  }
+
+  // Launch all requests except the first one in the thread pool, and execute
+  // the first one in the caller thread.
+  for (size_t i = 1; i < requests.size(); ++i) {
+    device->getPool()->Schedule([execute, i] { execute(i); });
+  }
+  execute(0);
+
+  return execute_event;
+}
+
+NanoRtExecutable::PreparedCall::PreparedCall(NanoRtExecutable* executable,
+                                             const ExecuteOptions& options)
+    : executable_(executable),
+      allocations_(cpu::BufferAllocations::Buffers(
+          executable->allocation_sizes_.size())),
+      execute_params_(
+          {tsl::down_cast<cpu::CpuExecutable*>(executable->executable_.get())
+               ->function_library(),
+           &allocations_, /*xfeed=*/nullptr, options.intra_op_thread_pool(),
+           options.task_runner()}) {
+  executable_->BindConstants(allocations_.mutable_buffers());
+}
+
+tsl::AsyncValueRef<NanoRtExecutable::ExecuteEvent>
+NanoRtExecutable::PreparedCall::Execute(absl::Span<const Argument> arguments,
+                                        absl::Span<const Result> results,
+                                        PreallocatedTemp temp) {
+  TraceMe trace([&] {
+    return TraceMeEncode("NanoRtExecutable::PreparedCall::Execute",
+                         {{"name", executable_->executable_->module().name()}});
+  });
+
+  TF_RETURN_IF_ERROR(executable_->BindBuffers(arguments, results, temp,
+                                               allocations_.mutable_buffers()));
+
+  auto* executable =
+      tsl::down_cast<cpu::CpuExecutable*>(executable_->executable_.get());
+  return executable->thunks().Execute(execute_params_);
+}
+
+std::unique_ptr<NanoRtExecutable::PreparedCall> NanoRtExecutable::Prepare(
+    const ExecuteOptions& options) {
+  return absl::WrapUnique(new PreparedCall(this, options));
+}
+
 size_t NanoRtExecutable::temp_buffer_size() const {
   if (temp_allocation_index_.has_value()) {
     return allocation_sizes_[*temp_allocation_index_];
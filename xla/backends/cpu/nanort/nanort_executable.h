@@ -24,12 +24,18 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/fixed_array.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/backends/cpu/alignment.h"
+#include "xla/backends/cpu/runtime/buffer_allocations.h"
+#include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/backends/cpu/runtime/thread_pool_task_runner.h"
 #include "xla/service/executable.h"
+#include "xla/stream_executor/device_memory.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/concurrency/chain.h"
 #include "tsl/platform/mem.h"
@@ -130,11 +136,85 @@ class NanoRtExecutable {
     alignas(Align()) absl::FixedArray<std::byte, n, Allocator> data_;
   };
 
+  // A thread-safe pool of temp buffers. Batched execution borrows a temp buffer
+  // from the pool for each request, so that concurrent requests never share a
+  // temp buffer, and buffers are reused across batches.
+  class TempPool {
+   public:
+    explicit TempPool(size_t size) : size_(size) {}
+
+    TempPool(const TempPool&) = delete;
+    TempPool& operator=(const TempPool&) = delete;
+
+    size_t size() const { return size_; }
+
+   private:
+    friend class NanoRtExecutable;
+    using Temp = ManagedTemp<0>;
+
+    std::unique_ptr<Temp> Acquire();
+    void Release(std::unique_ptr<Temp> temp);
+
+    size_t size_;
+
+    absl::Mutex mu_;
+    std::vector<std::unique_ptr<Temp>> temps_ ABSL_GUARDED_BY(mu_);
+  };
+
+  // Arguments and results of a single request of the batched execution.
+  struct Request {
+    absl::Span<const Argument> arguments;
+    absl::Span<const Result> results;
+  };
+
+  // A prepared call of the executable for repeated executions in latency
+  // critical code. Buffer allocations and execute parameters are constructed
+  // once, and each execution only re-binds argument, result and temp buffers,
+  // so that executing thunks inline in the caller thread does no heap
+  // allocations. Prepared call must not be executed concurrently, and it is the
+  // caller's responsibility to wait for the previous execution to complete
+  // before starting a new one, and to keep execute options alive.
+  class PreparedCall {
+   public:
+    PreparedCall(const PreparedCall&) = delete;
+    PreparedCall& operator=(const PreparedCall&) = delete;
+
+    tsl::AsyncValueRef<ExecuteEvent> Execute(
+        absl::Span<const Argument> arguments, absl::Span<const Result> results,
+        PreallocatedTemp temp = {});
+
+    template <size_t n>
+    tsl::AsyncValueRef<ExecuteEvent> Execute(
+        absl::Span<const Argument> arguments, absl::Span<const Result> results,
+        ManagedTemp<n>& temp) {
+      return Execute(arguments, results, temp.data());
+    }
+
+   private:
+    friend class NanoRtExecutable;
+
+    PreparedCall(NanoRtExecutable* executable, const ExecuteOptions& options);
+
+    NanoRtExecutable* executable_;
+    BufferAllocations allocations_;
+    Thunk::ExecuteParams execute_params_;
+  };
+
   tsl::AsyncValueRef<ExecuteEvent> Execute(absl::Span<const Argument> arguments,
                                            absl::Span<const Result> results,
                                            PreallocatedTemp temp = {},
                                            const ExecuteOptions& options = {});
 
+  // Executes a batch of independent requests. If options have an intra-op
+  // thread pool, requests run concurrently in the thread pool, otherwise they
+  // run sequentially in the caller thread. Returned async value becomes
+  // available when all requests complete, and it is the caller's
+  // responsibility to keep requests, `temp_pool` and `options` alive until
+  // then.
+  tsl::AsyncValueRef<ExecuteEvent> ExecuteBatch(
+      absl::Span<const Request> requests, TempPool& temp_pool,
+      const ExecuteOptions& options = {});
+
   template <size_t n>
   tsl::AsyncValueRef<ExecuteEvent> Execute(absl::Span<const Argument> arguments,
                                            absl::Span<const Result> results,
@@ -143,10 +223,23 @@ class NanoRtExecutable {
     return Execute(arguments, results, temp.data(), std::move(options));
   }
 
+  // Creates a prepared call for repeated executions with the given options.
+  std::unique_ptr<PreparedCall> Prepare(const ExecuteOptions& options = {});
+
   // Returns the size of the temp buffer required to run the executable.
   size_t temp_buffer_size() const;
 
  private:
+  // Binds arguments, results and temp to the corresponding buffers, and checks
+  // that their sizes match the buffer assignment.
+  absl::Status BindBuffers(absl::Span<const Argument> arguments,
+                           absl::Span<const Result> results,
+                           PreallocatedTemp temp,
+                           absl::Span<se::DeviceMemoryBase> buffers) const;
+
+  // Binds executable constants to the corresponding buffers.
+  void BindConstants(absl::Span<se::DeviceMemoryBase> buffers) const;
+
   NanoRtExecutable(std::unique_ptr<Executable> executable,
                    std::vector<size_t> allocation_sizes,
                    std::vector<size_t> argument_to_allocation_index,
@@ -0,0 +1,281 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/amx_matmul.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define XLA_CPU_HAS_AMX_INTRINSICS 1
+#endif
+
+#if defined(__linux__) && defined(XLA_CPU_HAS_AMX_INTRINSICS)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Eigen/Core"
+#include "absl/log/log.h"
+#include "xla/xla_data.pb.h"
+#include "tsl/platform/cpu_info.h"
+
+namespace xla::cpu {
+
+static constexpr int64_t kTileRows = AmxPackedMatrix::kTileRows;
+static constexpr int64_t kTileCols = AmxPackedMatrix::kTileCols;
+static constexpr int64_t kTileK = AmxPackedMatrix::kTileK;
+
+// Each AMX block computes a `kBlockRows x kBlockCols` block of the result in
+// four accumulator tiles, loading two `A` and two `B` tiles per `k` step.
+static constexpr int64_t kBlockRows = 2 * kTileRows;
+static constexpr int64_t kBlockCols = 2 * kTileCols;
+
+static int64_t RoundUp(int64_t value, int64_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+AmxPackedMatrix AmxPackedMatrix::Pack(const Eigen::bfloat16* b, int64_t k,
+                                      int64_t n, int64_t k_stride,
+                                      int64_t col_stride) {
+  int64_t padded_k = RoundUp(std::max<int64_t>(k, 1), kTileK);
+  int64_t padded_n = RoundUp(std::max<int64_t>(n, 1), kBlockCols);
+  std::vector<Eigen::bfloat16> data(padded_k * padded_n, Eigen::bfloat16(0));
+
+  // Elements are stored in `[col_tile][k / 2][kTileCols][2]` order (VNNI).
+  for (int64_t j = 0; j < n; ++j) {
+    Eigen::bfloat16* tile = data.data() + (j / kTileCols) * padded_k * kTileCols;
+    int64_t col = j % kTileCols;
+    for (int64_t kk = 0; kk < k; ++kk) {
+      tile[(kk / 2) * 2 * kTileCols + col * 2 + kk % 2] =
+          b[kk * k_stride + j * col_stride];
+    }
+  }
+
+  return AmxPackedMatrix(k, n, padded_k, std::move(data));
+}
+
+//===----------------------------------------------------------------------===//
+// AMX tiles configuration.
+//===----------------------------------------------------------------------===//
+
+#if defined(XLA_CPU_HAS_AMX_INTRINSICS)
+
+namespace {
+
+// Tile configuration in the `ldtilecfg` memory format (palette 1).
+struct alignas(64) TileConfig {
+  uint8_t palette_id;
+  uint8_t start_row;
+  uint8_t reserved[14];
+  uint16_t colsb[16];
+  uint8_t rows[16];
+};
+static_assert(sizeof(TileConfig) == 64);
+
+}  // namespace
+
+// Tiles 0-3 are F32 accumulators, tiles 4-5 are `A` tiles and tiles 6-7 are
+// VNNI-packed `B` tiles. All of them are 16 rows of 64 bytes.
+static TileConfig MakeTileConfig() {
+  TileConfig config;
+  std::memset(&config, 0, sizeof(config));
+  config.palette_id = 1;
+  for (int i = 0; i < 8; ++i) {
+    config.colsb[i] = 64;
+    config.rows[i] = 16;
+  }
+  return config;
+}
+
+// Linux requires processes to request permission to use AMX tile data before
+// the first AMX instruction, as it increases the size of the signal frame.
+static bool RequestAmxPermission() {
+#if defined(__linux__)
+  static constexpr int kArchReqXcompPerm = 0x1023;
+  static constexpr int kXFeatureXTileData = 18;
+  if (syscall(SYS_arch_prctl, kArchReqXcompPerm, kXFeatureXTileData) != 0) {
+    VLOG(1) << "Failed to request permission to use AMX tile data";
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif  // __linux__
+}
+
+// Loads our tile configuration into the calling thread. Tiles are configured
+// once per thread, and we reload the configuration only if some other library
+// (i.e. oneDNN) reconfigured tiles in the same thread.
+__attribute__((target("amx-tile"))) static void ConfigureTiles() {
+  static const TileConfig kConfig = MakeTileConfig();
+  thread_local bool configured = false;
+
+  if (configured) {
+    TileConfig current;
+    _tile_storeconfig(&current);
+    if (std::memcmp(&current, &kConfig, sizeof(TileConfig)) == 0) return;
+  }
+
+  _tile_loadconfig(&kConfig);
+  configured = true;
+}
+
+// Computes a `kBlockRows x kBlockCols` block of the result from row-major `a`
+// with `padded_k` columns and column tiles `[col_tile, col_tile + 2)` of `b`.
+__attribute__((target("amx-tile,amx-bf16"))) static void AmxBlock(
+    const Eigen::bfloat16* a, const AmxPackedMatrix& b, int64_t col_tile,
+    float* c) {
+  int64_t padded_k = b.padded_k();
+  int64_t a_stride = padded_k * sizeof(Eigen::bfloat16);
+  int64_t b_stride = 2 * kTileCols * sizeof(Eigen::bfloat16);
+  int64_t c_stride = kBlockCols * sizeof(float);
+
+  const Eigen::bfloat16* a0 = a;
+  const Eigen::bfloat16* a1 = a + kTileRows * padded_k;
+
+  _tile_zero(0);
+  _tile_zero(1);
+  _tile_zero(2);
+  _tile_zero(3);
+
+  for (int64_t kk = 0; kk < padded_k; kk += kTileK) {
+    _tile_loadd(4, a0 + kk, a_stride);
+    _tile_loadd(5, a1 + kk, a_stride);
+    _tile_loadd(6, b.tile(col_tile, kk), b_stride);
+    _tile_loadd(7, b.tile(col_tile + 1, kk), b_stride);
+    _tile_dpbf16ps(0, 4, 6);
+    _tile_dpbf16ps(1, 4, 7);
+    _tile_dpbf16ps(2, 5, 6);
+    _tile_dpbf16ps(3, 5, 7);
+  }
+
+  _tile_stored(0, c, c_stride);
+  _tile_stored(1, c + kTileCols, c_stride);
+  _tile_stored(2, c + kTileRows * kBlockCols, c_stride);
+  _tile_stored(3, c + kTileRows * kBlockCols + kTileCols, c_stride);
+}
+
+#endif  // XLA_CPU_HAS_AMX_INTRINSICS
+
+bool IsAmxBf16Available() {
+#if defined(XLA_CPU_HAS_AMX_INTRINSICS)
+  static const bool available =
+      tsl::port::TestCPUFeature(tsl::port::CPUFeature::AMX_TILE) &&
+      tsl::port::TestCPUFeature(tsl::port::CPUFeature::AMX_BF16) &&
+      RequestAmxPermission();
+  return available;
+#else
+  return false;
+#endif  // XLA_CPU_HAS_AMX_INTRINSICS
+}
+
+// Portable implementation of the AMX block computation.
+static void ReferenceBlock(const Eigen::bfloat16* a, const AmxPackedMatrix& b,
+                           int64_t col_tile, float* c) {
+  int64_t padded_k = b.padded_k();
+  std::fill(c, c + kBlockRows * kBlockCols, 0.0f);
+
+  for (int64_t t = 0; t < 2; ++t) {
+    for (int64_t kk = 0; kk < padded_k; kk += 2) {
+      const Eigen::bfloat16* b_tile = b.tile(col_tile + t, kk);
+      for (int64_t i = 0; i < kBlockRows; ++i) {
+        float a0 = static_cast<float>(a[i * padded_k + kk]);
+        float a1 = static_cast<float>(a[i * padded_k + kk + 1]);
+        float* c_row = c + i * kBlockCols + t * kTileCols;
+        for (int64_t j = 0; j < kTileCols; ++j) {
+          c_row[j] += a0 * static_cast<float>(b_tile[j * 2]) +
+                      a1 * static_cast<float>(b_tile[j * 2 + 1]);
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+static void StoreBlock(const float* block, T* c, const AmxMatMulStrides& s,
+                       int64_t rows, int64_t cols) {
+  for (int64_t i = 0; i < rows; ++i) {
+    for (int64_t j = 0; j < cols; ++j) {
+      c[i * s.c_row_stride + j * s.c_col_stride] =
+          static_cast<T>(block[i * kBlockCols + j]);
+    }
+  }
+}
+
+void AmxMatMul(const Eigen::bfloat16* a, const AmxPackedMatrix& b, void* c,
+               PrimitiveType c_type, const AmxMatMulStrides& strides,
+               int64_t row_begin, int64_t row_end) {
+  bool use_amx = IsAmxBf16Available();
+
+#if defined(XLA_CPU_HAS_AMX_INTRINSICS)
+  if (use_amx) ConfigureTiles();
+#endif  // XLA_CPU_HAS_AMX_INTRINSICS
+
+  int64_t padded_k = b.padded_k();
+
+  // Block of `A` rows packed into the row-major layout expected by AMX tile
+  // loads, and zero-padded to the tile size.
+  thread_local std::vector<Eigen::bfloat16> a_block;
+  a_block.resize(kBlockRows * padded_k);
+
+  alignas(64) float c_block[kBlockRows * kBlockCols];
+
+  for (int64_t i = row_begin; i < row_end; i += kBlockRows) {
+    int64_t rows = std::min(kBlockRows, row_end - i);
+
+    std::fill(a_block.begin(), a_block.end(), Eigen::bfloat16(0));
+    for (int64_t r = 0; r < rows; ++r) {
+      const Eigen::bfloat16* a_row = a + (i + r) * strides.a_row_stride;
+      for (int64_t kk = 0; kk < b.k(); ++kk) {
+        a_block[r * padded_k + kk] = a_row[kk * strides.a_k_stride];
+      }
+    }
+
+    for (int64_t j = 0; j < b.n(); j += kBlockCols) {
+      int64_t cols = std::min(kBlockCols, b.n() - j);
+      int64_t col_tile = j / kTileCols;
+
+#if defined(XLA_CPU_HAS_AMX_INTRINSICS)
+      if (use_amx) {
+        AmxBlock(a_block.data(), b, col_tile, c_block);
+      } else {
+        ReferenceBlock(a_block.data(), b, col_tile, c_block);
+      }
+#else
+      ReferenceBlock(a_block.data(), b, col_tile, c_block);
+#endif  // XLA_CPU_HAS_AMX_INTRINSICS
+
+      int64_t offset = i * strides.c_row_stride + j * strides.c_col_stride;
+      switch (c_type) {
+        case F32:
+          StoreBlock(c_block, static_cast<float*>(c) + offset, strides, rows,
+                     cols);
+          break;
+        case BF16:
+          StoreBlock(c_block, static_cast<Eigen::bfloat16*>(c) + offset,
+                     strides, rows, cols);
+          break;
+        default:
+          LOG(FATAL) << "Unsupported AMX matmul result type: " << c_type;
+      }
+    }
+  }
+}
+
+}  // namespace xla::cpu
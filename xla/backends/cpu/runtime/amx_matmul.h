@@ -0,0 +1,90 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_AMX_MATMUL_H_
+#define XLA_BACKENDS_CPU_RUNTIME_AMX_MATMUL_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Eigen/Core"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+
+// BF16 matrix multiplication using Intel AMX tile instructions (Sapphire
+// Rapids and later). If AMX is not available at run time, the same interface
+// is implemented by a portable (and slow) fallback.
+//
+// AMX computes `C += A x B` for 16x32 BF16 tiles of `A` and 16x16 tiles of `B`
+// with pairs of `k` elements interleaved (VNNI layout), accumulating into 16x16
+// F32 tiles of `C`. We pack `B` into the VNNI layout once per matmul, and pack
+// `A` into row-major tiles on the fly for each block of rows.
+class AmxPackedMatrix {
+ public:
+  static constexpr int64_t kTileRows = 16;
+  static constexpr int64_t kTileCols = 16;
+  static constexpr int64_t kTileK = 32;
+
+  // Packs `k x n` matrix `b` with element `(kk, j)` at `b[kk * k_stride + j *
+  // col_stride]`. Packed matrix is padded with zeros to the tile size.
+  static AmxPackedMatrix Pack(const Eigen::bfloat16* b, int64_t k, int64_t n,
+                              int64_t k_stride, int64_t col_stride);
+
+  int64_t k() const { return k_; }
+  int64_t n() const { return n_; }
+  int64_t padded_k() const { return padded_k_; }
+
+  // Returns a pointer to `kTileK / 2` rows of pairs of `k` elements for 16
+  // columns starting at column tile `col_tile` and `k` element `kk`.
+  const Eigen::bfloat16* tile(int64_t col_tile, int64_t kk) const {
+    return data_.data() + (col_tile * padded_k_ + kk) * kTileCols;
+  }
+
+ private:
+  AmxPackedMatrix(int64_t k, int64_t n, int64_t padded_k,
+                  std::vector<Eigen::bfloat16> data)
+      : k_(k), n_(n), padded_k_(padded_k), data_(std::move(data)) {}
+
+  int64_t k_;
+  int64_t n_;
+  int64_t padded_k_;
+  std::vector<Eigen::bfloat16> data_;
+};
+
+// Strides of the `A` operand and the `C` result of the AMX matmul: element
+// `(i, kk)` of `a` is at `a[i * a_row_stride + kk * a_k_stride]`, and element
+// `(i, j)` of `c` is at `c[i * c_row_stride + j * c_col_stride]`.
+struct AmxMatMulStrides {
+  int64_t a_row_stride;
+  int64_t a_k_stride;
+  int64_t c_row_stride;
+  int64_t c_col_stride;
+};
+
+// Returns true if AMX BF16 instructions are available on the current CPU and
+// the operating system allows the process to use them.
+bool IsAmxBf16Available();
+
+// Computes rows `[row_begin, row_end)` of `C = A x B`, where `A` is a `m x k`
+// BF16 matrix, and `C` is a BF16 or F32 matrix (`c_type`).
+void AmxMatMul(const Eigen::bfloat16* a, const AmxPackedMatrix& b, void* c,
+               PrimitiveType c_type, const AmxMatMulStrides& strides,
+               int64_t row_begin, int64_t row_end);
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_AMX_MATMUL_H_
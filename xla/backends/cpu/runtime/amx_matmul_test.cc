@@ -0,0 +1,128 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/amx_matmul.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Eigen/Core"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/test_benchmark.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+namespace {
+
+using bf16 = Eigen::bfloat16;
+
+TEST(AmxMatMulTest, Pack) {
+  // Column-major 3x2 matrix.
+  std::vector<bf16> b = {bf16(1), bf16(2), bf16(3),
+                         bf16(4), bf16(5), bf16(6)};
+  AmxPackedMatrix packed = AmxPackedMatrix::Pack(b.data(), /*k=*/3, /*n=*/2,
+                                                 /*k_stride=*/1,
+                                                 /*col_stride=*/3);
+
+  ASSERT_EQ(packed.padded_k(), AmxPackedMatrix::kTileK);
+
+  // Pairs of `k` elements are interleaved for each column (VNNI layout).
+  const bf16* tile = packed.tile(0, 0);
+  EXPECT_EQ(static_cast<float>(tile[0]), 1);
+  EXPECT_EQ(static_cast<float>(tile[1]), 2);
+  EXPECT_EQ(static_cast<float>(tile[2]), 4);
+  EXPECT_EQ(static_cast<float>(tile[3]), 5);
+
+  const bf16* next = packed.tile(0, 2);
+  EXPECT_EQ(static_cast<float>(next[0]), 3);
+  EXPECT_EQ(static_cast<float>(next[1]), 0);
+  EXPECT_EQ(static_cast<float>(next[2]), 6);
+  EXPECT_EQ(static_cast<float>(next[3]), 0);
+}
+
+TEST(AmxMatMulTest, MatMul) {
+  std::minstd_rand0 engine;
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+  for (int64_t m : {1, 17, 64, 100}) {
+    for (int64_t n : {1, 16, 33, 70}) {
+      for (int64_t k : {1, 31, 100}) {
+        // Row-major `a` and column-major `b` and `c` matrices.
+        std::vector<bf16> a(m * k), b(k * n);
+        for (bf16& v : a) v = bf16(distribution(engine));
+        for (bf16& v : b) v = bf16(distribution(engine));
+
+        std::vector<float> expected(m * n, 0.0f);
+        for (int64_t i = 0; i < m; ++i) {
+          for (int64_t j = 0; j < n; ++j) {
+            for (int64_t kk = 0; kk < k; ++kk) {
+              expected[i + j * m] += static_cast<float>(a[i * k + kk]) *
+                                     static_cast<float>(b[kk + j * k]);
+            }
+          }
+        }
+
+        AmxPackedMatrix packed = AmxPackedMatrix::Pack(b.data(), k, n,
+                                                       /*k_stride=*/1,
+                                                       /*col_stride=*/k);
+        AmxMatMulStrides strides = {/*a_row_stride=*/k, /*a_k_stride=*/1,
+                                    /*c_row_stride=*/1, /*c_col_stride=*/m};
+
+        std::vector<float> out(m * n);
+        AmxMatMul(a.data(), packed, out.data(), F32, strides, 0, m / 2);
+        AmxMatMul(a.data(), packed, out.data(), F32, strides, m / 2, m);
+
+        std::vector<bf16> out_bf16(m * n);
+        AmxMatMul(a.data(), packed, out_bf16.data(), BF16, strides, 0, m);
+
+        for (int64_t i = 0; i < m * n; ++i) {
+          EXPECT_NEAR(out[i], expected[i], 1e-3)
+              << "m=" << m << " n=" << n << " k=" << k;
+          EXPECT_NEAR(static_cast<float>(out_bf16[i]), expected[i],
+                      0.05 + 0.01 * std::abs(expected[i]))
+              << "m=" << m << " n=" << n << " k=" << k;
+        }
+      }
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Performance benchmarks.
+//===----------------------------------------------------------------------===//
+
+static void BM_AmxMatMul(benchmark::State& state) {
+  int64_t d = state.range(0);
+
+  std::vector<bf16> a(d * d, bf16(1)), b(d * d, bf16(1));
+  std::vector<float> out(d * d);
+  AmxPackedMatrix packed = AmxPackedMatrix::Pack(b.data(), d, d, 1, d);
+  AmxMatMulStrides strides = {1, d, 1, d};
+
+  for (auto _ : state) {
+    AmxMatMul(a.data(), packed, out.data(), F32, strides, 0, d);
+    benchmark::DoNotOptimize(out);
+  }
+
+  state.SetItemsProcessed(state.iterations() * d * d * d);
+  state.SetLabel(IsAmxBf16Available() ? "amx" : "reference");
+}
+
+BENCHMARK(BM_AmxMatMul)->ArgName("d")->Arg(64)->Arg(256)->Arg(1024);
+
+}  // namespace
+}  // namespace xla::cpu
@@ -62,6 +62,13 @@ class BufferAllocations {
   se::DeviceMemoryBase GetDeviceAddressUnchecked(
       BufferAllocation::Slice slice) const;
 
+  // Returns a mutable view of the underlying buffers. Runtimes that execute
+  // the same program repeatedly can re-bind argument and result buffers in
+  // place instead of constructing new buffer allocations for each execution.
+  absl::Span<se::DeviceMemoryBase> mutable_buffers() {
+    return absl::MakeSpan(buffers_data_, num_buffers_);
+  }
+
  private:
   absl::InlinedVector<se::DeviceMemoryBase, 8> buffers_;
   se::DeviceMemoryBase* buffers_data_;  // buffers_.data()
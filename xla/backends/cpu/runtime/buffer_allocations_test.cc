@@ -59,5 +59,18 @@ TEST(BufferAllocationsTest, GetDeviceAddressUnchecked) {
   EXPECT_EQ(slice_mem.opaque(), &data.data<float>()[2]);
 }
 
+TEST(BufferAllocationsTest, MutableBuffers) {
+  auto data0 = LiteralUtil::CreateR1<float>({1.0, 2.0, 3.0, 4.0});
+  auto data1 = LiteralUtil::CreateR1<float>({5.0, 6.0, 7.0, 8.0});
+
+  BufferAllocations allocations = CreateBufferAllocations(data0);
+  allocations.mutable_buffers()[0] = se::DeviceMemoryBase(
+      data1.untyped_data(), data1.size_bytes());
+
+  TF_ASSERT_OK_AND_ASSIGN(se::DeviceMemoryBase alloc_mem,
+                          allocations.GetDeviceAddress(0));
+  EXPECT_EQ(alloc_mem.opaque(), &data1.data<float>()[0]);
+}
+
 }  // namespace
 }  // namespace xla::cpu
@@ -18,13 +18,17 @@ limitations under the License.
 #include <memory>
 #include <utility>
 
+#include "absl/base/call_once.h"
+#include "absl/base/optimization.h"
 #include "absl/log/log.h"
 #include "absl/memory/memory.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "xla/backends/cpu/runtime/convolution_lib.h"
 #include "xla/backends/cpu/runtime/convolution_thunk_internal.h"
+#include "xla/backends/cpu/runtime/depthwise_convolution.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/winograd_convolution.h"
 #include "xla/executable_run_options.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/shape.h"
@@ -33,6 +37,7 @@ limitations under the License.
 #include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/profiler/lib/traceme.h"
 
 #define EIGEN_USE_THREADS
 #include "Eigen/Core"
@@ -107,6 +112,18 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> ConvolutionThunk::Execute(
         "multi-threaded mode.");
   }
 
+  // Direct and Winograd convolutions for F32 inputs.
+  if (convolution_slices_.input_shape.element_type() == PrimitiveType::F32) {
+    if (IsDepthwiseConvolution(convolution_canonical_dims_)) {
+      return HandleDepthwiseConvolution(params, input_data, kernel_data,
+                                        output_data);
+    }
+    if (WinogradConvolution::IsSupported(convolution_canonical_dims_)) {
+      return HandleWinogradConvolution(params, input_data, kernel_data,
+                                       output_data);
+    }
+  }
+
   // Eigen convolution
   if (convolution_canonical_dims_.convolution_rank() == 2) {
     return HandleEigen2DConvolution(params, input_data, kernel_data,
@@ -249,4 +266,103 @@ ConvolutionThunk::HandleEigen3DConvolution(const ExecuteParams& params,
   return OkExecuteEvent();
 }
 
+// Convolutions with fewer multiply-add operations run in the caller thread.
+static constexpr int64_t kMinParallelFlops = 1024 * 1024;
+
+tsl::AsyncValueRef<Thunk::ExecuteEvent>
+ConvolutionThunk::HandleDepthwiseConvolution(const ExecuteParams& params,
+                                             se::DeviceMemoryBase input,
+                                             se::DeviceMemoryBase kernel,
+                                             se::DeviceMemoryBase output) {
+  const ConvolutionCanonicalDims& dims = convolution_canonical_dims_;
+
+  const float* in = static_cast<const float*>(input.opaque());
+  const float* k = static_cast<const float*>(kernel.opaque());
+  float* out = static_cast<float*>(output.opaque());
+
+  auto compute = [&dims, in, k, out](int64_t begin, int64_t end) {
+    DepthwiseConvolution2D(dims, in, k, out, begin, end);
+  };
+
+  int64_t num_rows = DepthwiseConvolutionRows(dims);
+  int64_t row_flops = dims.output_dims.y * dims.kernel_filters *
+                      dims.kernel_dims.x * dims.kernel_dims.y;
+
+  if (!options_.multi_threaded || num_rows * row_flops < kMinParallelFlops) {
+    compute(0, num_rows);
+    return OkExecuteEvent();
+  }
+
+  int64_t row_bytes = dims.output_dims.y * dims.kernel_filters * sizeof(float);
+  Eigen::TensorOpCost cost(/*bytes_loaded=*/dims.kernel_dims.x * row_bytes,
+                           /*bytes_stored=*/row_bytes,
+                           /*compute_cycles=*/row_flops);
+
+  tsl::CountDownAsyncValueRef<ExecuteEvent> state(1);
+  params.intra_op_threadpool->parallelForAsync(
+      num_rows, cost, compute, [state]() mutable { state.CountDown(); });
+
+  return state.AsRef();
+}
+
+tsl::AsyncValueRef<Thunk::ExecuteEvent>
+ConvolutionThunk::HandleWinogradConvolution(const ExecuteParams& params,
+                                            se::DeviceMemoryBase input,
+                                            se::DeviceMemoryBase kernel,
+                                            se::DeviceMemoryBase output) {
+  const ConvolutionCanonicalDims& dims = convolution_canonical_dims_;
+  WinogradConvolution::OutputTile output_tile =
+      WinogradConvolution::SelectOutputTile(dims);
+
+  const float* k = static_cast<const float*>(kernel.opaque());
+
+  auto transform_kernel = [&] {
+    tsl::profiler::TraceMe trace("ConvolutionThunk::WinogradKernelTransform");
+    return std::make_shared<const WinogradConvolution>(
+        WinogradConvolution::Create(dims, output_tile, k));
+  };
+
+  // Transform constant kernels once, and all other kernels on every execution.
+  std::shared_ptr<const WinogradConvolution> winograd;
+  if (convolution_slices_.kernel_buffer.allocation()->is_constant()) {
+    absl::call_once(winograd_once_, [&] {
+      winograd_source_ = k;
+      winograd_ = transform_kernel();
+    });
+    // Constant must never change its address, but we check it to be safe.
+    winograd = ABSL_PREDICT_TRUE(winograd_source_ == k) ? winograd_
+                                                        : transform_kernel();
+  } else {
+    winograd = transform_kernel();
+  }
+
+  const float* in = static_cast<const float*>(input.opaque());
+  float* out = static_cast<float*>(output.opaque());
+
+  auto compute = [winograd, in, out](int64_t begin, int64_t end) {
+    winograd->Compute(in, out, begin, end);
+  };
+
+  int64_t num_blocks = winograd->num_blocks();
+  int64_t block_flops = WinogradConvolution::kTilesPerBlock *
+                        dims.input_channels * dims.kernel_filters * 9;
+
+  if (!options_.multi_threaded ||
+      num_blocks * block_flops < kMinParallelFlops) {
+    compute(0, num_blocks);
+    return OkExecuteEvent();
+  }
+
+  Eigen::TensorOpCost cost(
+      /*bytes_loaded=*/block_flops / dims.kernel_filters * sizeof(float),
+      /*bytes_stored=*/block_flops / dims.input_channels * sizeof(float),
+      /*compute_cycles=*/block_flops);
+
+  tsl::CountDownAsyncValueRef<ExecuteEvent> state(1);
+  params.intra_op_threadpool->parallelForAsync(
+      num_blocks, cost, compute, [state]() mutable { state.CountDown(); });
+
+  return state.AsRef();
+}
+
 }  // namespace xla::cpu
@@ -19,9 +19,11 @@ limitations under the License.
 #include <cstdint>
 #include <memory>
 
+#include "absl/base/call_once.h"
 #include "absl/status/statusor.h"
 #include "xla/backends/cpu/runtime/convolution_lib.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/winograd_convolution.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/shape.h"
 #include "xla/stream_executor/device_memory.h"
@@ -75,10 +77,26 @@ class ConvolutionThunk final : public Thunk {
       const ExecuteParams& params, se::DeviceMemoryBase input,
       se::DeviceMemoryBase kernel, se::DeviceMemoryBase output);
 
+  // Fast paths for F32 convolutions that Eigen handles poorly: depthwise
+  // convolutions and 3x3 stride-1 convolutions.
+  tsl::AsyncValueRef<Thunk::ExecuteEvent> HandleDepthwiseConvolution(
+      const ExecuteParams& params, se::DeviceMemoryBase input,
+      se::DeviceMemoryBase kernel, se::DeviceMemoryBase output);
+
+  tsl::AsyncValueRef<Thunk::ExecuteEvent> HandleWinogradConvolution(
+      const ExecuteParams& params, se::DeviceMemoryBase input,
+      se::DeviceMemoryBase kernel, se::DeviceMemoryBase output);
+
   Options options_;
   ConvolutionSlices convolution_slices_;
   ConvolutionCanonicalDims convolution_canonical_dims_;
 
+  // If the kernel is a constant, we transform it into the Winograd domain on
+  // the first execution and reuse it for all subsequent executions.
+  absl::once_flag winograd_once_;
+  const void* winograd_source_ = nullptr;
+  std::shared_ptr<const WinogradConvolution> winograd_;
+
   // Convolution operation parameters that were used to construct this thunk. We
   // only keep them around to be able to serialize/deserialize thunk.
   ConvolutionDimensionNumbers dnums_;
@@ -71,6 +71,26 @@ TYPED_TEST(ConvolutionThunkTypedTest, SuccessfulConvolution3D) {
   SuccessfulConvolution<TypeParam>(/*convolution_rank=*/3);
 }
 
+TEST(ConvolutionThunkTest, SuccessfulWinogradConvolution) {
+  // 3x3 stride-1 F32 convolution with enough channels for Winograd.
+  ConvolutionDimensions dims;
+  dims.input_size = 10;
+  dims.input_channels = 16;
+  dims.output_channels = 16;
+  dims.output_size = dims.input_size - dims.kernel_size + 1;
+
+  ConvolutionThunkBuilder<float> builder(dims);
+  TF_ASSERT_OK_AND_ASSIGN(auto thunk, builder.Build());
+  BufferAllocations allocations = builder.GetAllocations();
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError()) << execute_event.GetError();
+}
+
 TEST(ConvolutionThunkTest, CreationErrorOnUnsupportedType) {
   ConvolutionThunkBuilder<int> builder;
 
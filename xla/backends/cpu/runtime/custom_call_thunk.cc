@@ -85,19 +85,11 @@ absl::StatusOr<AttributesMap> ParseAttributes(
 
 // Call `instantiate` callback if passed. This function needs its own copy of
 // attributes, that's what AttributesBuilder expects, there's no way around it.
-absl::Status InstantiateHandlerState(absl::string_view target_name,
+absl::Status InstantiateHandlerState(const XLA_FFI_Handler_Bundle& bundle,
                                      ffi::ExecutionState* execution_state,
                                      AttributesMap attributes) {
-  // Find the registered FFI handler for this target.
-  auto handler = ffi::FindHandler(target_name, "Host");
-  if (!handler.ok()) {
-    return NotFound(
-        "No registered implementation for FFI custom call to %s for Host",
-        target_name);
-  }
-
   // Initialize FFI handler state if it has an instantiate callback.
-  if (handler->bundle.instantiate) {
+  if (bundle.instantiate) {
     // At FFI handler instantiation time, we don't have any arguments or results
     ffi::CallFrameBuilder builder(/*num_args=*/0, /*num_rets=*/0);
 
@@ -109,7 +101,7 @@ absl::Status InstantiateHandlerState(absl::string_view target_name,
 
     ffi::CallOptions options;
     options.execution_state = execution_state;
-    TF_RETURN_IF_ERROR(Call(handler->bundle.instantiate, instantiate_call_frame,
+    TF_RETURN_IF_ERROR(Call(bundle.instantiate, instantiate_call_frame,
                             options, XLA_FFI_ExecutionStage_INSTANTIATE));
   }
 
@@ -178,15 +170,25 @@ absl::StatusOr<ffi::CallFrame> BuildCallFrameForTypedFFI(
 absl::StatusOr<std::unique_ptr<CustomCallThunk>> CustomCallThunk::Create(
     Info info, absl::string_view target_name, OpBuffers op_buffers,
     absl::string_view backend_config, CustomCallApiVersion api_version) {
+  std::optional<XLA_FFI_Handler_Bundle> bundle;
   std::optional<ffi::CallFrame> call_frame;
   auto execution_state = std::make_unique<ffi::ExecutionState>();
 
   if (api_version == CustomCallApiVersion::API_VERSION_TYPED_FFI) {
+    // Find the registered FFI handler for this target.
+    auto handler = ffi::FindHandler(target_name, "Host");
+    if (!handler.ok()) {
+      return NotFound(
+          "No registered implementation for FFI custom call to %s for Host",
+          target_name);
+    }
+    bundle = handler->bundle;
+
     TF_ASSIGN_OR_RETURN(AttributesMap attributes,
                         ParseAttributes(backend_config));
 
-    TF_RETURN_IF_ERROR(InstantiateHandlerState(
-        target_name, execution_state.get(), attributes));
+    TF_RETURN_IF_ERROR(
+        InstantiateHandlerState(*bundle, execution_state.get(), attributes));
 
     TF_ASSIGN_OR_RETURN(call_frame, BuildCallFrameForTypedFFI(
                                         api_version, op_buffers, backend_config,
@@ -195,13 +197,14 @@ absl::StatusOr<std::unique_ptr<CustomCallThunk>> CustomCallThunk::Create(
 
   return absl::WrapUnique(
       new CustomCallThunk(std::move(info), target_name, std::move(op_buffers),
-                          api_version, std::move(backend_config),
+                          api_version, std::move(backend_config), bundle,
                           std::move(call_frame), std::move(execution_state)));
 }
 
 CustomCallThunk::CustomCallThunk(
     Info info, absl::string_view target_name, OpBuffers op_buffers,
     CustomCallApiVersion api_version, absl::string_view backend_config,
+    std::optional<XLA_FFI_Handler_Bundle> bundle,
     std::optional<ffi::CallFrame> call_frame,
     std::unique_ptr<ffi::ExecutionState> execution_state)
     : Thunk(Kind::kCustomCall, std::move(info)),
@@ -209,6 +212,7 @@ CustomCallThunk::CustomCallThunk(
       op_buffers_(std::move(op_buffers)),
       api_version_(api_version),
       backend_config_(std::move(backend_config)),
+      bundle_(bundle),
       call_frame_(std::move(call_frame)),
       execution_state_(std::move(execution_state)) {}
 
@@ -225,14 +229,6 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> CustomCallThunk::Execute(
 
 tsl::AsyncValueRef<Thunk::ExecuteEvent> CustomCallThunk::CallTypedFFI(
     const ExecuteParams& params) {
-
-  // Find the registered FFI handler for this target.
-  auto handler = ffi::FindHandler(target_name_, "Host");
-  if (!handler.ok()) {
-    return NotFound(
-        "No registered implementation for FFI custom call to %s for Host",
-        target_name_);
-  }
   if (params.custom_call_params == nullptr) {
     return Internal("CustomCallExecuteParams cannot be nullptr.");
   }
@@ -279,7 +275,10 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> CustomCallThunk::CallTypedFFI(
       custom_call_params->ffi_execution_context,
       execution_state_.get()};
 
-  return ffi::CallAsync(handler->bundle.execute, call_frame, call_options);
+  // FFI handlers can return an async value (future) to signal completion, in
+  // which case the execute event becomes available only when the handler
+  // completes, and the thunk executor is free to run independent thunks.
+  return ffi::CallAsync(bundle_->execute, call_frame, call_options);
 }
 
 tsl::AsyncValueRef<Thunk::ExecuteEvent> CustomCallThunk::CallUntypedAPI(
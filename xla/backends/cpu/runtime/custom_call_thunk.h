@@ -26,6 +26,7 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/ffi/api/c_api.h"
 #include "xla/ffi/call_frame.h"
 #include "xla/ffi/execution_state.h"
 #include "xla/service/buffer_assignment.h"
@@ -65,6 +66,7 @@ class CustomCallThunk final : public Thunk {
   CustomCallThunk(Info info, absl::string_view target_name,
                   OpBuffers op_buffers, CustomCallApiVersion api_version,
                   absl::string_view backend_config,
+                  std::optional<XLA_FFI_Handler_Bundle> bundle,
                   std::optional<ffi::CallFrame> call_frame,
                   std::unique_ptr<ffi::ExecutionState> execution_state);
 
@@ -82,6 +84,10 @@ class CustomCallThunk final : public Thunk {
   OpBuffers op_buffers_;
   CustomCallApiVersion api_version_;
   std::string backend_config_;
+
+  // FFI handler bundle resolved at thunk construction time, so that we don't
+  // have to look it up in the registry on every execution.
+  std::optional<XLA_FFI_Handler_Bundle> bundle_;
   std::optional<ffi::CallFrame> call_frame_;
 
   // Execution state bound to the FFI handler. Optional.
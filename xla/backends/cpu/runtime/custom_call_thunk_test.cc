@@ -0,0 +1,140 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/custom_call_thunk.h"
+
+#include <memory>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "xla/backends/cpu/runtime/buffer_allocations.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_testlib.h"
+#include "xla/executable_run_options.h"
+#include "xla/ffi/ffi.h"
+#include "xla/ffi/ffi_api.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/concurrency/chain.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+namespace {
+
+// Async value that signals completion of the `AsyncAddOne` FFI handler.
+static tsl::AsyncValueRef<tsl::Chain>& AsyncAddOneDone() {
+  static auto* done = new tsl::AsyncValueRef<tsl::Chain>();
+  return *done;
+}
+
+// Writes `in + 1` to `out` and signals completion via an async value that the
+// test marks as available (or error) after the thunk returns.
+static tsl::AsyncValueRef<tsl::Chain> AsyncAddOne(
+    ffi::BufferR0<PrimitiveType::F32> in,
+    ffi::Result<ffi::BufferR0<PrimitiveType::F32>> out) {
+  out->typed_data()[0] = in.typed_data()[0] + 1.0f;
+  AsyncAddOneDone() = tsl::MakeConstructedAsyncValueRef<tsl::Chain>();
+  return AsyncAddOneDone();
+}
+
+XLA_FFI_DEFINE_HANDLER(kAsyncAddOne, AsyncAddOne,
+                       ffi::Ffi::Bind()
+                           .Arg<ffi::BufferR0<PrimitiveType::F32>>()
+                           .Ret<ffi::BufferR0<PrimitiveType::F32>>());
+
+XLA_FFI_REGISTER_HANDLER(ffi::GetXlaFfiApi(), "__xla_test$$async_add_one",
+                         "Host", kAsyncAddOne);
+
+class CustomCallThunkTest : public ::testing::Test {
+ protected:
+  absl::StatusOr<std::unique_ptr<CustomCallThunk>> CreateAsyncAddOneThunk(
+      const BufferAllocation& in_alloc, const BufferAllocation& out_alloc) {
+    CustomCallThunk::OpBuffers op_buffers;
+    op_buffers.arguments_buffers = {CreateBufferAllocationSlice(in_alloc)};
+    op_buffers.arguments_shapes = {in_.shape()};
+    op_buffers.results_buffers = {CreateBufferAllocationSlice(out_alloc)};
+    op_buffers.results_shapes = {out_.shape()};
+    op_buffers.is_tuple_result = false;
+
+    return CustomCallThunk::Create({"custom-call"}, "__xla_test$$async_add_one",
+                                   std::move(op_buffers),
+                                   /*backend_config=*/"",
+                                   CustomCallApiVersion::API_VERSION_TYPED_FFI);
+  }
+
+  Literal in_ = LiteralUtil::CreateR0<float>(41.0f);
+  Literal out_ = LiteralUtil::CreateR0<float>(0.0f);
+};
+
+TEST_F(CustomCallThunkTest, AsyncHandler) {
+  BufferAllocations allocations = CreateBufferAllocations(in_, out_);
+  auto [in_alloc, out_alloc] = CreateBufferAllocation(in_, out_);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto thunk,
+                          CreateAsyncAddOneThunk(in_alloc, out_alloc));
+
+  ExecutableRunOptions run_options;
+  run_options.set_device_ordinal(0);
+  TF_ASSERT_OK_AND_ASSIGN(
+      Thunk::CustomCallExecuteParams custom_call_params,
+      Thunk::CustomCallExecuteParams::Create(&run_options));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.custom_call_params = &custom_call_params;
+
+  // Execute event must stay pending until the FFI handler signals completion.
+  auto execute_event = thunk->Execute(params);
+  EXPECT_FALSE(execute_event.IsAvailable());
+  EXPECT_EQ(out_, LiteralUtil::CreateR0<float>(42.0f));
+
+  AsyncAddOneDone().SetStateConcrete();
+  ASSERT_TRUE(execute_event.IsAvailable());
+  EXPECT_FALSE(execute_event.IsError());
+}
+
+TEST_F(CustomCallThunkTest, AsyncHandlerError) {
+  BufferAllocations allocations = CreateBufferAllocations(in_, out_);
+  auto [in_alloc, out_alloc] = CreateBufferAllocation(in_, out_);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto thunk,
+                          CreateAsyncAddOneThunk(in_alloc, out_alloc));
+
+  ExecutableRunOptions run_options;
+  run_options.set_device_ordinal(0);
+  TF_ASSERT_OK_AND_ASSIGN(
+      Thunk::CustomCallExecuteParams custom_call_params,
+      Thunk::CustomCallExecuteParams::Create(&run_options));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.custom_call_params = &custom_call_params;
+
+  auto execute_event = thunk->Execute(params);
+  EXPECT_FALSE(execute_event.IsAvailable());
+
+  AsyncAddOneDone().SetError(absl::InternalError("remote lookup failed"));
+  ASSERT_TRUE(execute_event.IsError());
+  EXPECT_EQ(execute_event.GetError(),
+            absl::InternalError("remote lookup failed"));
+}
+
+}  // namespace
+}  // namespace xla::cpu
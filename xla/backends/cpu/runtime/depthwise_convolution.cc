@@ -0,0 +1,105 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/depthwise_convolution.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "xla/backends/cpu/runtime/convolution_lib.h"
+
+namespace xla::cpu {
+
+bool IsDepthwiseConvolution(const ConvolutionCanonicalDims& dims) {
+  return dims.convolution_rank() == 2 && dims.feature_group_count > 1 &&
+         dims.feature_group_count == dims.input_channels &&
+         dims.kernel_channels == 1 &&
+         dims.kernel_filters % dims.input_channels == 0 &&
+         dims.base_dilation.x == 1 && dims.base_dilation.y == 1;
+}
+
+int64_t DepthwiseConvolutionRows(const ConvolutionCanonicalDims& dims) {
+  return dims.input_batch * dims.output_dims.x;
+}
+
+// Accumulates products of an input row and a kernel row into an output row.
+// Each input channel contributes to `kMultiplier` consecutive output channels.
+template <int64_t kMultiplier>
+static void AccumulateRow(const float* __restrict in,
+                          const float* __restrict k, float* __restrict out,
+                          int64_t channels, int64_t multiplier) {
+  if constexpr (kMultiplier == 1) {
+    for (int64_t c = 0; c < channels; ++c) {
+      out[c] += in[c] * k[c];
+    }
+  } else {
+    for (int64_t c = 0; c < channels; ++c) {
+      for (int64_t m = 0; m < multiplier; ++m) {
+        out[c * multiplier + m] += in[c] * k[c * multiplier + m];
+      }
+    }
+  }
+}
+
+template <int64_t kMultiplier>
+static void DepthwiseConvolution2D(const ConvolutionCanonicalDims& d,
+                                   const float* input, const float* kernel,
+                                   float* output, int64_t row_begin,
+                                   int64_t row_end) {
+  int64_t channels = d.input_channels;
+  int64_t filters = d.kernel_filters;
+  int64_t multiplier = filters / channels;
+
+  for (int64_t row = row_begin; row < row_end; ++row) {
+    int64_t b = row / d.output_dims.x;
+    int64_t ox = row % d.output_dims.x;
+
+    for (int64_t oy = 0; oy < d.output_dims.y; ++oy) {
+      float* out =
+          output + ((b * d.output_dims.x + ox) * d.output_dims.y + oy) * filters;
+      std::fill(out, out + filters, 0.0f);
+
+      for (int64_t kx = 0; kx < d.kernel_dims.x; ++kx) {
+        int64_t ix = ox * d.strides.x - d.padding_before.x +
+                     kx * d.window_dilation.x;
+        if (ix < 0 || ix >= d.input_dims.x) continue;
+
+        for (int64_t ky = 0; ky < d.kernel_dims.y; ++ky) {
+          int64_t iy = oy * d.strides.y - d.padding_before.y +
+                       ky * d.window_dilation.y;
+          if (iy < 0 || iy >= d.input_dims.y) continue;
+
+          const float* in =
+              input + ((b * d.input_dims.x + ix) * d.input_dims.y + iy) *
+                          channels;
+          const float* k = kernel + (kx * d.kernel_dims.y + ky) * filters;
+          AccumulateRow<kMultiplier>(in, k, out, channels, multiplier);
+        }
+      }
+    }
+  }
+}
+
+void DepthwiseConvolution2D(const ConvolutionCanonicalDims& dims,
+                            const float* input, const float* kernel,
+                            float* output, int64_t row_begin, int64_t row_end) {
+  if (dims.kernel_filters == dims.input_channels) {
+    DepthwiseConvolution2D<1>(dims, input, kernel, output, row_begin, row_end);
+  } else {
+    DepthwiseConvolution2D<0>(dims, input, kernel, output, row_begin, row_end);
+  }
+}
+
+}  // namespace xla::cpu
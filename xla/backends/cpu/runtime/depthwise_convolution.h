@@ -0,0 +1,48 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_DEPTHWISE_CONVOLUTION_H_
+#define XLA_BACKENDS_CPU_RUNTIME_DEPTHWISE_CONVOLUTION_H_
+
+#include <cstdint>
+
+#include "xla/backends/cpu/runtime/convolution_lib.h"
+
+namespace xla::cpu {
+
+// Direct implementation of the 2D depthwise convolution (feature group count
+// equal to the number of input channels) for tensors in the canonical layout:
+// NHWC input, HWIO kernel and NHWC output.
+//
+// Eigen implements grouped convolutions as a separate contraction for each
+// feature group, which for depthwise convolutions degenerates into thousands of
+// tiny matrix multiplications. Direct convolution instead accumulates products
+// of input and kernel rows that are contiguous in the channel dimension.
+
+// Returns true if the convolution can be computed by DepthwiseConvolution2D.
+bool IsDepthwiseConvolution(const ConvolutionCanonicalDims& dims);
+
+// Returns the number of output rows (rows are indexed by the batch and the
+// first spatial dimension) that DepthwiseConvolution2D computes.
+int64_t DepthwiseConvolutionRows(const ConvolutionCanonicalDims& dims);
+
+// Computes output rows `[row_begin, row_end)` of the depthwise convolution.
+void DepthwiseConvolution2D(const ConvolutionCanonicalDims& dims,
+                            const float* input, const float* kernel,
+                            float* output, int64_t row_begin, int64_t row_end);
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_DEPTHWISE_CONVOLUTION_H_
@@ -0,0 +1,179 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/depthwise_convolution.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "xla/backends/cpu/runtime/convolution_lib.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/test_benchmark.h"
+
+namespace xla::cpu {
+namespace {
+
+using Dims = ConvolutionCanonicalDims::Dims;
+
+// Returns canonical dims of the 2D depthwise convolution with `multiplier`
+// filters for each input channel.
+ConvolutionCanonicalDims DepthwiseDims(int64_t batch, int64_t size,
+                                       int64_t channels, int64_t multiplier,
+                                       int64_t kernel_size, int64_t stride,
+                                       int64_t padding, int64_t dilation) {
+  int64_t dilated_kernel = (kernel_size - 1) * dilation + 1;
+  int64_t output_size = (size + 2 * padding - dilated_kernel) / stride + 1;
+  return ConvolutionCanonicalDims{
+      batch,
+      Dims({size, size}),
+      channels,
+      Dims({kernel_size, kernel_size}),
+      /*kernel_channels=*/1,
+      /*kernel_filters=*/channels * multiplier,
+      Dims({output_size, output_size}),
+      /*strides=*/Dims({stride, stride}),
+      /*padding_before=*/Dims({padding, padding}),
+      /*padding_after=*/Dims({padding, padding}),
+      /*base_dilation=*/Dims({1, 1}),
+      /*window_dilation=*/Dims({dilation, dilation}),
+      /*feature_group_count=*/channels};
+}
+
+std::vector<float> ReferenceConvolution(const ConvolutionCanonicalDims& d,
+                                        const std::vector<float>& input,
+                                        const std::vector<float>& kernel) {
+  int64_t c_dim = d.input_channels;
+  int64_t f_dim = d.kernel_filters;
+  int64_t multiplier = f_dim / c_dim;
+
+  std::vector<float> output(
+      d.input_batch * d.output_dims.x * d.output_dims.y * f_dim, 0.0f);
+
+  for (int64_t b = 0; b < d.input_batch; ++b) {
+    for (int64_t ox = 0; ox < d.output_dims.x; ++ox) {
+      for (int64_t oy = 0; oy < d.output_dims.y; ++oy) {
+        for (int64_t kx = 0; kx < d.kernel_dims.x; ++kx) {
+          for (int64_t ky = 0; ky < d.kernel_dims.y; ++ky) {
+            int64_t ix = ox * d.strides.x - d.padding_before.x +
+                         kx * d.window_dilation.x;
+            int64_t iy = oy * d.strides.y - d.padding_before.y +
+                         ky * d.window_dilation.y;
+            if (ix < 0 || ix >= d.input_dims.x) continue;
+            if (iy < 0 || iy >= d.input_dims.y) continue;
+
+            for (int64_t f = 0; f < f_dim; ++f) {
+              float in = input[((b * d.input_dims.x + ix) * d.input_dims.y +
+                                iy) * c_dim + f / multiplier];
+              output[((b * d.output_dims.x + ox) * d.output_dims.y + oy) *
+                         f_dim + f] +=
+                  in * kernel[(kx * d.kernel_dims.y + ky) * f_dim + f];
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+TEST(DepthwiseConvolutionTest, IsDepthwiseConvolution) {
+  EXPECT_TRUE(IsDepthwiseConvolution(DepthwiseDims(1, 8, 16, 1, 3, 1, 1, 1)));
+  EXPECT_TRUE(IsDepthwiseConvolution(DepthwiseDims(1, 8, 16, 2, 3, 2, 1, 1)));
+
+  // Grouped convolution with multiple channels in each group.
+  ConvolutionCanonicalDims grouped = DepthwiseDims(1, 8, 16, 1, 3, 1, 1, 1);
+  grouped.feature_group_count = 8;
+  grouped.kernel_channels = 2;
+  EXPECT_FALSE(IsDepthwiseConvolution(grouped));
+}
+
+TEST(DepthwiseConvolutionTest, Compute) {
+  std::minstd_rand0 engine;
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+  for (int64_t channels : {1, 5, 32}) {
+    for (int64_t multiplier : {1, 3}) {
+      for (int64_t kernel_size : {1, 3, 5}) {
+        for (int64_t stride : {1, 2}) {
+          for (int64_t dilation : {1, 2}) {
+            ConvolutionCanonicalDims dims =
+                DepthwiseDims(/*batch=*/2, /*size=*/11, channels, multiplier,
+                              kernel_size, stride, /*padding=*/kernel_size / 2,
+                              dilation);
+            if (dims.output_dims.x <= 0) continue;
+
+            std::vector<float> input(2 * 11 * 11 * channels);
+            std::vector<float> kernel(kernel_size * kernel_size * channels *
+                                      multiplier);
+            for (float& v : input) v = distribution(engine);
+            for (float& v : kernel) v = distribution(engine);
+
+            std::vector<float> expected =
+                ReferenceConvolution(dims, input, kernel);
+
+            std::vector<float> output(expected.size(), NAN);
+            DepthwiseConvolution2D(dims, input.data(), kernel.data(),
+                                   output.data(), 0,
+                                   DepthwiseConvolutionRows(dims));
+
+            for (int64_t i = 0; i < expected.size(); ++i) {
+              ASSERT_NEAR(output[i], expected[i], 1e-4)
+                  << "channels=" << channels << " multiplier=" << multiplier
+                  << " kernel_size=" << kernel_size << " stride=" << stride
+                  << " dilation=" << dilation << " i=" << i;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Performance benchmarks.
+//===----------------------------------------------------------------------===//
+
+static void BM_DepthwiseConvolution(benchmark::State& state) {
+  int64_t size = state.range(0);
+  int64_t channels = state.range(1);
+
+  ConvolutionCanonicalDims dims = DepthwiseDims(1, size, channels, 1, 3, 1,
+                                                /*padding=*/1, 1);
+
+  std::vector<float> input(size * size * channels, 1.0f);
+  std::vector<float> kernel(9 * channels, 1.0f);
+  std::vector<float> output(size * size * channels);
+
+  for (auto _ : state) {
+    DepthwiseConvolution2D(dims, input.data(), kernel.data(), output.data(), 0,
+                           DepthwiseConvolutionRows(dims));
+    benchmark::DoNotOptimize(output);
+  }
+
+  state.SetItemsProcessed(state.iterations() * size * size * channels * 9);
+}
+
+BENCHMARK(BM_DepthwiseConvolution)
+    ->ArgNames({"size", "channels"})
+    ->Args({112, 32})
+    ->Args({56, 128})
+    ->Args({28, 256})
+    ->Args({14, 512});
+
+}  // namespace
+}  // namespace xla::cpu
@@ -35,6 +35,7 @@ limitations under the License.
 #include "xla/shape_util.h"
 #include "xla/status_macros.h"
 #include "xla/util.h"
+#include "xla/xla_data.pb.h"
 
 namespace xla::cpu {
 
@@ -169,4 +170,47 @@ absl::StatusOr<DotCanonicalDims> GetDotCanonicalDims(
       /*output_column_major=*/is_column_major(dot_shape.out_matmul_shape)};
 }
 
+bool IsWeightOnlyQuantizedDot(const DotDimensionNumbers& dot_dimensions,
+                              const Shape& lhs_shape, const Shape& rhs_shape,
+                              const Shape& out_shape) {
+  auto is_weight_type = [](const Shape& shape) {
+    return shape.element_type() == S8 || shape.element_type() == S4;
+  };
+
+  if (out_shape.element_type() != F32 ||
+      dot_dimensions.lhs_batch_dimensions_size() != 0 ||
+      dot_dimensions.lhs_contracting_dimensions_size() != 1 ||
+      dot_dimensions.rhs_contracting_dimensions_size() != 1) {
+    return false;
+  }
+
+  return (lhs_shape.element_type() == F32 && is_weight_type(rhs_shape)) ||
+         (is_weight_type(lhs_shape) && rhs_shape.element_type() == F32);
+}
+
+bool IsAmxEligibleDot(const DotDimensionNumbers& dot_dimensions,
+                      const Shape& lhs_shape, const Shape& rhs_shape,
+                      const Shape& out_shape) {
+  if (lhs_shape.element_type() != BF16 || rhs_shape.element_type() != BF16 ||
+      (out_shape.element_type() != BF16 && out_shape.element_type() != F32) ||
+      dot_dimensions.lhs_contracting_dimensions_size() != 1 ||
+      dot_dimensions.rhs_contracting_dimensions_size() != 1) {
+    return false;
+  }
+
+  auto product = [](const Shape& shape, absl::Span<const int64_t> dims) {
+    int64_t result = 1;
+    for (int64_t dim : dims) result *= shape.dimensions(dim);
+    return result;
+  };
+
+  int64_t batch = product(lhs_shape, dot_dimensions.lhs_batch_dimensions());
+  int64_t k = product(lhs_shape, dot_dimensions.lhs_contracting_dimensions());
+  if (batch == 0 || k == 0) return false;
+
+  int64_t m = ShapeUtil::ElementsIn(lhs_shape) / (batch * k);
+  int64_t n = ShapeUtil::ElementsIn(rhs_shape) / (batch * k);
+  return m >= kMinAmxDotDim && n >= kMinAmxDotDim && k >= kMinAmxDotDim;
+}
+
 }  // namespace xla::cpu
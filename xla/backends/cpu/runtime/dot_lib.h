@@ -23,6 +23,7 @@ limitations under the License.
 #include "xla/runtime/buffer_use.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/shape.h"
+#include "xla/xla_data.pb.h"
 
 namespace xla::cpu {
 
@@ -94,6 +95,22 @@ absl::StatusOr<DotShape> GetDotShape(const DotDimensionNumbers& dot_dimensions,
 absl::StatusOr<DotCanonicalDims> GetDotCanonicalDims(
     const DotDimensionNumbers& dot_dimensions, const DotShape& dot_shape);
 
+// Returns true if the dot operation is a weight-only quantized matmul, which
+// the XLA:CPU runtime implements without upcasting weights to F32: activations
+// and the result are F32, weights are S8 or S4 integers, and there are no
+// batch dimensions.
+bool IsWeightOnlyQuantizedDot(const DotDimensionNumbers& dot_dimensions,
+                              const Shape& lhs_shape, const Shape& rhs_shape,
+                              const Shape& out_shape);
+
+// Returns true if the dot operation is a BF16 matmul large enough to benefit
+// from AMX tile instructions: operands are BF16, the result is BF16 or F32, and
+// all matmul dimensions are at least `kMinAmxDotDim`.
+inline constexpr int64_t kMinAmxDotDim = 64;
+bool IsAmxEligibleDot(const DotDimensionNumbers& dot_dimensions,
+                      const Shape& lhs_shape, const Shape& rhs_shape,
+                      const Shape& out_shape);
+
 }  // namespace xla::cpu
 
 #endif  // XLA_BACKENDS_CPU_RUNTIME_DOT_LIB_H_
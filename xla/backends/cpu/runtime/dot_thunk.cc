@@ -15,16 +15,23 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/dot_thunk.h"
 
+#include <algorithm>
 #include <complex>
 #include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include "absl/base/call_once.h"
+#include "absl/base/optimization.h"
 #include "absl/memory/memory.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
+#include "xla/backends/cpu/runtime/amx_matmul.h"
 #include "xla/backends/cpu/runtime/dot_lib.h"
+#include "xla/backends/cpu/runtime/packed_matmul.h"
+#include "xla/backends/cpu/runtime/quantized_matmul.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/primitive_util.h"
 #include "xla/service/buffer_assignment.h"
@@ -36,6 +43,7 @@ limitations under the License.
 #include "xla/types.h"
 #include "xla/util.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/profiler/lib/traceme.h"
 
 namespace xla::cpu {
 
@@ -50,6 +58,17 @@ absl::StatusOr<std::unique_ptr<DotThunk>> DotThunk::Create(
   TF_ASSIGN_OR_RETURN(DotCanonicalDims dot_canonical_dims,
                       GetDotCanonicalDims(dot_dimensions, dot_shape));
 
+  // Operands with different element types are supported only for weight-only
+  // quantized matmuls.
+  if (lhs_shape.element_type() != rhs_shape.element_type() &&
+      !IsWeightOnlyQuantizedDot(dot_dimensions, lhs_shape, rhs_shape,
+                                out_shape)) {
+    return InvalidArgument(
+        "Unsupported mixed precision dot: lhs=%s, rhs=%s, out=%s",
+        lhs_shape.ToString(true), rhs_shape.ToString(true),
+        out_shape.ToString(true));
+  }
+
   DotSlices dot_slices{lhs_buffer, std::move(lhs_shape),
                        rhs_buffer, std::move(rhs_shape),
                        out_buffer, std::move(out_shape)};
@@ -140,15 +159,49 @@ tsl::AsyncValueRef<DotThunk::ExecuteEvent> DotThunk::Execute(
   bool transpose_rhs = (dot_canonical_dims_.rhs_canonical !=
                         dot_canonical_dims_.rhs_column_major);
 
+  bool lhs_is_constant = dot_slices_.lhs_buffer.allocation()->is_constant();
+  bool rhs_is_constant = dot_slices_.rhs_buffer.allocation()->is_constant();
+
+  PrimitiveType lhs_type = dot_shape_.lhs_matmul_shape.element_type();
+  PrimitiveType rhs_type = dot_shape_.rhs_matmul_shape.element_type();
+
   if (!dot_canonical_dims_.output_column_major) {
     std::swap(m, n);
     std::swap(lhs, rhs);
+    std::swap(lhs_is_constant, rhs_is_constant);
+    std::swap(lhs_type, rhs_type);
     std::swap(transpose_lhs, transpose_rhs);
     transpose_lhs = !transpose_lhs;
     transpose_rhs = !transpose_rhs;
   }
 
-  PrimitiveType element_type = dot_shape_.lhs_matmul_shape.element_type();
+  // Weight-only quantized matmul has operands of different types.
+  if (lhs_type != rhs_type) {
+    return ExecuteQuantizedMatMul(params, static_cast<float*>(out), lhs, rhs,
+                                  m, n, k, transpose_lhs, transpose_rhs,
+                                  lhs_type, rhs_type);
+  }
+
+  PrimitiveType element_type = lhs_type;
+
+  // BF16 matmuls accumulate in F32 and can have F32 results.
+  if (element_type == BF16) {
+    return ExecuteAmxMatMul(
+        params, out, dot_shape_.out_matmul_shape.element_type(),
+        static_cast<const bfloat16*>(lhs), static_cast<const bfloat16*>(rhs),
+        m, n, k, transpose_lhs, transpose_rhs);
+  }
+
+  // Use packed matmul for multiplying small matrices by constant weights.
+  if (element_type == F32 && dot_shape_.batch_size == 1 &&
+      (lhs_is_constant || rhs_is_constant)) {
+    if (auto event = ExecutePackedMatMul(
+            params, static_cast<float*>(out), static_cast<const float*>(lhs),
+            static_cast<const float*>(rhs), m, n, k, transpose_lhs,
+            transpose_rhs, lhs_is_constant, rhs_is_constant)) {
+      return event;
+    }
+  }
   int64_t byte_width = primitive_util::ByteWidth(element_type);
 
   int64_t lhs_stride = m * k * byte_width;
@@ -199,4 +252,220 @@ tsl::AsyncValueRef<DotThunk::ExecuteEvent> DotThunk::Execute(
   return state.AsRef();
 }
 
+// We use packed matmul only if the non-constant operand is small (i.e. batch
+// size in inference), because for large operands Eigen amortizes the cost of
+// packing the constant over the large number of output elements.
+static constexpr int64_t kMaxPackedMatMulCols = 32;
+
+tsl::AsyncValueRef<DotThunk::ExecuteEvent> DotThunk::ExecutePackedMatMul(
+    const ExecuteParams& params, float* out, const float* lhs,
+    const float* rhs, int64_t m, int64_t n, int64_t k, bool transpose_lhs,
+    bool transpose_rhs, bool lhs_is_constant, bool rhs_is_constant) {
+  // Strides of the column-major `A = op(lhs)` and `B = op(rhs)` matrices.
+  int64_t a_row_stride = transpose_lhs ? k : 1;
+  int64_t a_k_stride = transpose_lhs ? 1 : m;
+  int64_t b_k_stride = transpose_rhs ? n : 1;
+  int64_t b_col_stride = transpose_rhs ? 1 : k;
+
+  // We compute `C = A x B` as `C = W x X` where `W` is the packed constant. If
+  // the constant is `B`, we compute `C^T = B^T x A^T` instead.
+  const float* w;
+  const float* x;
+  int64_t rows, cols, w_row_stride, w_k_stride;
+  PackedMatMulStrides strides;
+
+  if (lhs_is_constant && n <= kMaxPackedMatMulCols) {
+    w = lhs;
+    x = rhs;
+    rows = m;
+    cols = n;
+    w_row_stride = a_row_stride;
+    w_k_stride = a_k_stride;
+    strides = {b_k_stride, b_col_stride, /*out_row_stride=*/1,
+               /*out_col_stride=*/m};
+  } else if (rhs_is_constant && m <= kMaxPackedMatMulCols) {
+    w = rhs;
+    x = lhs;
+    rows = n;
+    cols = m;
+    w_row_stride = b_col_stride;
+    w_k_stride = b_k_stride;
+    strides = {a_k_stride, a_row_stride, /*out_row_stride=*/m,
+               /*out_col_stride=*/1};
+  } else {
+    return nullptr;
+  }
+
+  absl::call_once(packed_once_, [&] {
+    tsl::profiler::TraceMe trace("DotThunk::PackConstant");
+    packed_source_ = w;
+    packed_ = std::make_unique<PackedMatrix>(
+        PackedMatrix::Pack(w, rows, k, w_row_stride, w_k_stride));
+  });
+
+  // Constant must never change its address, but we check it to be safe.
+  if (ABSL_PREDICT_FALSE(packed_source_ != w)) {
+    return nullptr;
+  }
+
+  const PackedMatrix& packed = *packed_;
+  auto compute = [&packed, x, out, cols, strides](int64_t begin, int64_t end) {
+    PackedMatMul(packed, x, out, cols, strides, begin, end);
+  };
+
+  // Run packed matmul in the caller thread if it's small.
+  static constexpr int64_t kMinParallelFlops = 1024 * 1024;
+  if (params.intra_op_threadpool == nullptr ||
+      rows * cols * k < kMinParallelFlops) {
+    compute(0, packed.num_panels());
+    return OkExecuteEvent();
+  }
+
+  // Cost of computing a single panel of the packed matmul.
+  Eigen::TensorOpCost cost(
+      /*bytes_loaded=*/sizeof(float) * k * (PackedMatrix::kPanelSize + cols),
+      /*bytes_stored=*/sizeof(float) * PackedMatrix::kPanelSize * cols,
+      /*compute_cycles=*/PackedMatrix::kPanelSize * k * cols);
+
+  tsl::CountDownAsyncValueRef<ExecuteEvent> state(1);
+  params.intra_op_threadpool->parallelForAsync(
+      packed.num_panels(), cost, compute,
+      [state]() mutable { state.CountDown(); });
+
+  return state.AsRef();
+}
+
+tsl::AsyncValueRef<DotThunk::ExecuteEvent> DotThunk::ExecuteQuantizedMatMul(
+    const ExecuteParams& params, float* out, const void* lhs, const void* rhs,
+    int64_t m, int64_t n, int64_t k, bool transpose_lhs, bool transpose_rhs,
+    PrimitiveType lhs_type, PrimitiveType rhs_type) {
+  // Strides of the column-major `A = op(lhs)` and `B = op(rhs)` matrices.
+  int64_t a_row_stride = transpose_lhs ? k : 1;
+  int64_t a_k_stride = transpose_lhs ? 1 : m;
+  int64_t b_k_stride = transpose_rhs ? n : 1;
+  int64_t b_col_stride = transpose_rhs ? 1 : k;
+
+  // We compute `C = A x B` as `C = W x X` where `W` is the quantized operand.
+  // If weights are in `B`, we compute `C^T = B^T x A^T` instead.
+  PrimitiveType w_type;
+  const void* w;
+  const float* x;
+  int64_t rows, cols;
+  QuantizedMatMulStrides strides;
+
+  if (IsQuantizedMatMulWeightType(lhs_type)) {
+    w_type = lhs_type;
+    w = lhs;
+    x = static_cast<const float*>(rhs);
+    rows = m;
+    cols = n;
+    strides = {a_row_stride, a_k_stride, b_k_stride, b_col_stride,
+               /*out_row_stride=*/1, /*out_col_stride=*/m};
+  } else {
+    w_type = rhs_type;
+    w = rhs;
+    x = static_cast<const float*>(lhs);
+    rows = n;
+    cols = m;
+    strides = {b_col_stride, b_k_stride, a_k_stride, a_row_stride,
+               /*out_row_stride=*/m, /*out_col_stride=*/1};
+  }
+
+  // Each task computes a block of output rows.
+  static constexpr int64_t kRowsPerTask = 64;
+  int64_t num_tasks = (rows + kRowsPerTask - 1) / kRowsPerTask;
+
+  auto compute = [=](int64_t begin, int64_t end) {
+    QuantizedMatMul(w_type, w, x, out, k, cols, strides, begin * kRowsPerTask,
+                    std::min(rows, end * kRowsPerTask));
+  };
+
+  // Run quantized matmul in the caller thread if it's small.
+  static constexpr int64_t kMinParallelFlops = 1024 * 1024;
+  if (params.intra_op_threadpool == nullptr ||
+      rows * cols * k < kMinParallelFlops) {
+    compute(0, num_tasks);
+    return OkExecuteEvent();
+  }
+
+  // Cost of computing a block of rows of the quantized matmul.
+  int64_t w_bytes = kRowsPerTask * (w_type == S4 ? (k + 1) / 2 : k);
+  Eigen::TensorOpCost cost(
+      /*bytes_loaded=*/w_bytes + sizeof(float) * k * cols,
+      /*bytes_stored=*/sizeof(float) * kRowsPerTask * cols,
+      /*compute_cycles=*/kRowsPerTask * k * cols);
+
+  tsl::CountDownAsyncValueRef<ExecuteEvent> state(1);
+  params.intra_op_threadpool->parallelForAsync(
+      num_tasks, cost, compute, [state]() mutable { state.CountDown(); });
+
+  return state.AsRef();
+}
+
+tsl::AsyncValueRef<DotThunk::ExecuteEvent> DotThunk::ExecuteAmxMatMul(
+    const ExecuteParams& params, void* out, PrimitiveType out_type,
+    const bfloat16* lhs, const bfloat16* rhs, int64_t m, int64_t n, int64_t k,
+    bool transpose_lhs, bool transpose_rhs) {
+  if (out_type != F32 && out_type != BF16) {
+    return Unimplemented(
+        "Unsupported result type for BF16 DotThunk::Execute: %s",
+        primitive_util::LowercasePrimitiveTypeName(out_type));
+  }
+
+  // Strides of the column-major `A = op(lhs)` and `B = op(rhs)` matrices.
+  int64_t a_row_stride = transpose_lhs ? k : 1;
+  int64_t a_k_stride = transpose_lhs ? 1 : m;
+  int64_t b_k_stride = transpose_rhs ? n : 1;
+  int64_t b_col_stride = transpose_rhs ? 1 : k;
+
+  AmxMatMulStrides strides = {a_row_stride, a_k_stride, /*c_row_stride=*/1,
+                              /*c_col_stride=*/m};
+
+  // Pack `B` for all batch elements before launching tasks, as all tasks
+  // computing rows of the same batch element share the packed matrix.
+  int64_t batch_size = dot_shape_.batch_size;
+  auto packed = std::make_shared<std::vector<AmxPackedMatrix>>();
+  packed->reserve(batch_size);
+  for (int64_t i = 0; i < batch_size; ++i) {
+    packed->push_back(AmxPackedMatrix::Pack(rhs + i * k * n, k, n, b_k_stride,
+                                            b_col_stride));
+  }
+
+  // Each task computes a block of output rows of a single batch element.
+  static constexpr int64_t kRowsPerTask = 64;
+  int64_t tasks_per_batch = (m + kRowsPerTask - 1) / kRowsPerTask;
+  int64_t num_tasks = batch_size * tasks_per_batch;
+  int64_t out_stride = m * n * primitive_util::ByteWidth(out_type);
+
+  auto compute = [=](int64_t begin, int64_t end) {
+    for (int64_t task = begin; task < end; ++task) {
+      int64_t i = task / tasks_per_batch;
+      int64_t row_begin = (task % tasks_per_batch) * kRowsPerTask;
+      AmxMatMul(lhs + i * m * k, (*packed)[i],
+                static_cast<uint8_t*>(out) + i * out_stride, out_type, strides,
+                row_begin, std::min(m, row_begin + kRowsPerTask));
+    }
+  };
+
+  // Run AMX matmul in the caller thread if it's small.
+  static constexpr int64_t kMinParallelFlops = 1024 * 1024;
+  if (params.intra_op_threadpool == nullptr ||
+      batch_size * m * n * k < kMinParallelFlops) {
+    compute(0, num_tasks);
+    return OkExecuteEvent();
+  }
+
+  // Cost of computing a block of rows of the AMX matmul.
+  Eigen::TensorOpCost cost(
+      /*bytes_loaded=*/sizeof(bfloat16) * k * (kRowsPerTask + n),
+      /*bytes_stored=*/primitive_util::ByteWidth(out_type) * kRowsPerTask * n,
+      /*compute_cycles=*/kRowsPerTask * k * n);
+
+  tsl::CountDownAsyncValueRef<ExecuteEvent> state(1);
+  params.intra_op_threadpool->parallelForAsync(
+      num_tasks, cost, compute, [state]() mutable { state.CountDown(); });
+
+  return state.AsRef();
+}
+
 }  // namespace xla::cpu
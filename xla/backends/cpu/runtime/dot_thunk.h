@@ -24,12 +24,15 @@ limitations under the License.
 #include <memory>
 #include <utility>
 
+#include "absl/base/call_once.h"
 #include "absl/base/optimization.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/functional/any_invocable.h"
 #include "absl/status/statusor.h"
 #include "Eigen/Core"
 #include "unsupported/Eigen/CXX11/Tensor"
+#include "xla/backends/cpu/runtime/packed_matmul.h"
+#include "xla/backends/cpu/runtime/quantized_matmul.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/shape.h"
@@ -59,6 +62,28 @@ class DotThunk final : public Thunk {
 
   using DoneCallback = absl::AnyInvocable<void()>;
 
+  // Executes F32 matmul with a constant operand using the packed copy of the
+  // constant created at the first execution. Returns nullptr if the matmul is
+  // not eligible for packing, and the caller must fall back to Eigen.
+  tsl::AsyncValueRef<ExecuteEvent> ExecutePackedMatMul(
+      const ExecuteParams& params, float* out, const float* lhs,
+      const float* rhs, int64_t m, int64_t n, int64_t k, bool transpose_lhs,
+      bool transpose_rhs, bool lhs_is_constant, bool rhs_is_constant);
+
+  // Executes weight-only quantized matmul with F32 activations and S8 or S4
+  // weights, dequantizing weights in the inner loop of the matmul kernel.
+  tsl::AsyncValueRef<ExecuteEvent> ExecuteQuantizedMatMul(
+      const ExecuteParams& params, float* out, const void* lhs,
+      const void* rhs, int64_t m, int64_t n, int64_t k, bool transpose_lhs,
+      bool transpose_rhs, PrimitiveType lhs_type, PrimitiveType rhs_type);
+
+  // Executes BF16 matmul with F32 accumulation using AMX tile instructions, or
+  // a portable fallback if AMX is not available. Result is BF16 or F32.
+  tsl::AsyncValueRef<ExecuteEvent> ExecuteAmxMatMul(
+      const ExecuteParams& params, void* out, PrimitiveType out_type,
+      const bfloat16* lhs, const bfloat16* rhs, int64_t m, int64_t n,
+      int64_t k, bool transpose_lhs, bool transpose_rhs);
+
   // Col-major x Col-major MatMul implementation as Eigen contraction.
   template <typename T, Eigen::AlignmentType alignment>
   static void MatMul(const Eigen::ThreadPoolDevice* device, T* out, T* lhs,
@@ -80,6 +105,12 @@ class DotThunk final : public Thunk {
   // Contracting dimensions of the LHS and RHS matmul shapes.
   absl::InlinedVector<int64_t, 2> lhs_matmul_contracting_dims_;
   absl::InlinedVector<int64_t, 2> rhs_matmul_contracting_dims_;
+
+  // Packed copy of the constant matmul operand. Constants are owned by the
+  // executable and have a stable address, so we pack them only once.
+  absl::once_flag packed_once_;
+  const void* packed_source_ = nullptr;
+  std::unique_ptr<PackedMatrix> packed_;
 };
 
 //===----------------------------------------------------------------------===//
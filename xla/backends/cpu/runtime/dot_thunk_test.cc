@@ -31,6 +31,7 @@ limitations under the License.
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
 #include "xla/tsl/platform/threadpool.h"
+#include "xla/types.h"
 #include "xla/xla_data.pb.h"
 
 #define EIGEN_USE_THREADS
@@ -143,6 +144,258 @@ TEST(DotThunkTest, ThreadedDot) {
   EXPECT_EQ(out, expected);
 }
 
+class DotThunkConstantTest
+    : public testing::TestWithParam<std::tuple<bool, bool, bool, bool>> {};
+
+TEST_P(DotThunkConstantTest, PackedConstantDot) {
+  Layout row_major_layout = LayoutUtil::MakeLayout({1, 0});
+  Layout column_major_layout = LayoutUtil::MakeLayout({0, 1});
+
+  const auto& [lhs_constant, lhs_col_major, rhs_col_major, out_col_major] =
+      GetParam();
+
+  auto lhs = LiteralUtil::CreateR2WithLayout<float>(
+      {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}},
+      lhs_col_major ? column_major_layout : row_major_layout);
+  auto rhs = LiteralUtil::CreateR2WithLayout<float>(
+      {{7.0, 8.0}, {9.0, 10.0}, {11.0, 12.0}},
+      rhs_col_major ? column_major_layout : row_major_layout);
+  auto out = LiteralUtil::CreateR2WithLayout<float>(
+      {{0.0, 0.0}, {0.0, 0.0}},
+      out_col_major ? column_major_layout : row_major_layout);
+
+  BufferAllocations allocations = CreateBufferAllocations(lhs, rhs, out);
+
+  auto [lhs_alloc, rhs_alloc, out_alloc] =
+      CreateBufferAllocation(lhs, rhs, out);
+  (lhs_constant ? lhs_alloc : rhs_alloc).set_constant(true);
+
+  auto [lhs_slice, rhs_slice, out_slice] =
+      CreateBufferAllocationSlice(lhs_alloc, rhs_alloc, out_alloc);
+
+  DotDimensionNumbers dot_dimensions;
+  dot_dimensions.add_lhs_contracting_dimensions(1);
+  dot_dimensions.add_rhs_contracting_dimensions(0);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      DotThunk::Create({"dot"}, dot_dimensions, lhs_slice, lhs.shape(),
+                       rhs_slice, rhs.shape(), out_slice, out.shape()));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  // Second execution reuses the packed constant.
+  for (int i = 0; i < 2; ++i) {
+    auto execute_event = thunk->Execute(params);
+    tsl::BlockUntilReady(execute_event);
+    ASSERT_FALSE(execute_event.IsError()) << execute_event.GetError();
+    EXPECT_EQ(out,
+              LiteralUtil::CreateR2<float>({{58.0, 64.0}, {139.0, 154.0}}));
+  }
+}
+
+TEST(DotThunkTest, ThreadedPackedConstantDot) {
+  auto lhs_shape = ShapeUtil::MakeShape(F32, {4, 1024});
+  auto rhs_shape = ShapeUtil::MakeShape(F32, {1024, 1024});
+  auto out_shape = ShapeUtil::MakeShape(F32, {4, 1024});
+
+  auto lhs = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      lhs_shape, [](auto) { return 1.0; });
+  auto rhs = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      rhs_shape, [](auto index) { return index[1] % 2; });
+  auto out = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      out_shape, [](auto) { return 0; });
+
+  BufferAllocations allocations = CreateBufferAllocations(lhs, rhs, out);
+
+  auto [lhs_alloc, rhs_alloc, out_alloc] =
+      CreateBufferAllocation(lhs, rhs, out);
+  rhs_alloc.set_constant(true);
+
+  auto [lhs_slice, rhs_slice, out_slice] =
+      CreateBufferAllocationSlice(lhs_alloc, rhs_alloc, out_alloc);
+
+  DotDimensionNumbers dot_dimensions;
+  dot_dimensions.add_lhs_contracting_dimensions(1);
+  dot_dimensions.add_rhs_contracting_dimensions(0);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      DotThunk::Create({"dot"}, dot_dimensions, lhs_slice, lhs_shape,
+                       rhs_slice, rhs_shape, out_slice, out_shape));
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = &device;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError()) << execute_event.GetError();
+
+  auto expected = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      out_shape, [](auto index) { return index[1] % 2 ? 1024 : 0; });
+  EXPECT_EQ(out, expected);
+}
+
+class DotThunkQuantizedTest
+    : public testing::TestWithParam<std::tuple<bool, bool, bool, bool>> {};
+
+TEST_P(DotThunkQuantizedTest, WeightOnlyQuantizedDot) {
+  Layout row_major_layout = LayoutUtil::MakeLayout({1, 0});
+  Layout column_major_layout = LayoutUtil::MakeLayout({0, 1});
+
+  const auto& [lhs_weights, lhs_col_major, rhs_col_major, out_col_major] =
+      GetParam();
+
+  Layout lhs_layout = lhs_col_major ? column_major_layout : row_major_layout;
+  Layout rhs_layout = rhs_col_major ? column_major_layout : row_major_layout;
+
+  // Either lhs or rhs are S8 weights, and the other operand is F32.
+  auto lhs = lhs_weights ? LiteralUtil::CreateR2WithLayout<int8_t>(
+                               {{1, 2, 3}, {4, 5, 6}}, lhs_layout)
+                         : LiteralUtil::CreateR2WithLayout<float>(
+                               {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}}, lhs_layout);
+  auto rhs = lhs_weights ? LiteralUtil::CreateR2WithLayout<float>(
+                               {{7.0, 8.0}, {9.0, 10.0}, {11.0, 12.0}},
+                               rhs_layout)
+                         : LiteralUtil::CreateR2WithLayout<int8_t>(
+                               {{7, 8}, {9, 10}, {11, 12}}, rhs_layout);
+  auto out = LiteralUtil::CreateR2WithLayout<float>(
+      {{0.0, 0.0}, {0.0, 0.0}},
+      out_col_major ? column_major_layout : row_major_layout);
+
+  BufferAllocations allocations = CreateBufferAllocations(lhs, rhs, out);
+
+  auto [lhs_alloc, rhs_alloc, out_alloc] =
+      CreateBufferAllocation(lhs, rhs, out);
+  auto [lhs_slice, rhs_slice, out_slice] =
+      CreateBufferAllocationSlice(lhs_alloc, rhs_alloc, out_alloc);
+
+  DotDimensionNumbers dot_dimensions;
+  dot_dimensions.add_lhs_contracting_dimensions(1);
+  dot_dimensions.add_rhs_contracting_dimensions(0);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      DotThunk::Create({"dot"}, dot_dimensions, lhs_slice, lhs.shape(),
+                       rhs_slice, rhs.shape(), out_slice, out.shape()));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError()) << execute_event.GetError();
+  EXPECT_EQ(out, LiteralUtil::CreateR2<float>({{58.0, 64.0}, {139.0, 154.0}}));
+}
+
+class DotThunkBf16Test
+    : public testing::TestWithParam<std::tuple<bool, bool>> {};
+
+TEST_P(DotThunkBf16Test, Bf16Dot) {
+  Layout row_major_layout = LayoutUtil::MakeLayout({1, 0});
+  Layout column_major_layout = LayoutUtil::MakeLayout({0, 1});
+
+  const auto& [f32_out, out_col_major] = GetParam();
+  Layout out_layout = out_col_major ? column_major_layout : row_major_layout;
+
+  auto lhs = LiteralUtil::CreateR2<bfloat16>(
+      {{bfloat16(1), bfloat16(2), bfloat16(3)},
+       {bfloat16(4), bfloat16(5), bfloat16(6)}});
+  auto rhs = LiteralUtil::CreateR2<bfloat16>({{bfloat16(7), bfloat16(8)},
+                                              {bfloat16(9), bfloat16(10)},
+                                              {bfloat16(11), bfloat16(12)}});
+  auto out = f32_out ? LiteralUtil::CreateR2WithLayout<float>(
+                           {{0.0, 0.0}, {0.0, 0.0}}, out_layout)
+                     : LiteralUtil::CreateR2WithLayout<bfloat16>(
+                           {{bfloat16(0), bfloat16(0)},
+                            {bfloat16(0), bfloat16(0)}},
+                           out_layout);
+
+  BufferAllocations allocations = CreateBufferAllocations(lhs, rhs, out);
+
+  auto [lhs_alloc, rhs_alloc, out_alloc] =
+      CreateBufferAllocation(lhs, rhs, out);
+  auto [lhs_slice, rhs_slice, out_slice] =
+      CreateBufferAllocationSlice(lhs_alloc, rhs_alloc, out_alloc);
+
+  DotDimensionNumbers dot_dimensions;
+  dot_dimensions.add_lhs_contracting_dimensions(1);
+  dot_dimensions.add_rhs_contracting_dimensions(0);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      DotThunk::Create({"dot"}, dot_dimensions, lhs_slice, lhs.shape(),
+                       rhs_slice, rhs.shape(), out_slice, out.shape()));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError()) << execute_event.GetError();
+
+  auto expected = LiteralUtil::CreateR2<float>({{58.0, 64.0}, {139.0, 154.0}});
+  EXPECT_EQ(out, f32_out ? expected : expected.Convert(BF16).value());
+}
+
+TEST(DotThunkTest, UnsupportedMixedPrecisionDot) {
+  auto lhs = LiteralUtil::CreateR2<float>({{1.0, 2.0}});
+  auto rhs = LiteralUtil::CreateR2<int32_t>({{1}, {2}});
+  auto out = LiteralUtil::CreateR2<float>({{0.0}});
+
+  auto [lhs_alloc, rhs_alloc, out_alloc] =
+      CreateBufferAllocation(lhs, rhs, out);
+  auto [lhs_slice, rhs_slice, out_slice] =
+      CreateBufferAllocationSlice(lhs_alloc, rhs_alloc, out_alloc);
+
+  DotDimensionNumbers dot_dimensions;
+  dot_dimensions.add_lhs_contracting_dimensions(1);
+  dot_dimensions.add_rhs_contracting_dimensions(0);
+
+  EXPECT_FALSE(DotThunk::Create({"dot"}, dot_dimensions, lhs_slice,
+                                lhs.shape(), rhs_slice, rhs.shape(), out_slice,
+                                out.shape())
+                   .ok());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DotThunkQuantizedTest, DotThunkQuantizedTest,
+    testing::Combine(testing::Bool(), testing::Bool(), testing::Bool(),
+                     testing::Bool()),
+    [](const testing::TestParamInfo<DotThunkQuantizedTest::ParamType>& info) {
+      return absl::StrCat(
+          std::get<0>(info.param) ? "lhs_weights" : "rhs_weights", "__",
+          std::get<1>(info.param) ? "lhs_col_major" : "lhs_row_major", "__",
+          std::get<2>(info.param) ? "rhs_col_major" : "rhs_row_major", "__",
+          std::get<3>(info.param) ? "out_col_major" : "out_row_major");
+    });
+
+INSTANTIATE_TEST_SUITE_P(
+    DotThunkBf16Test, DotThunkBf16Test,
+    testing::Combine(testing::Bool(), testing::Bool()),
+    [](const testing::TestParamInfo<DotThunkBf16Test::ParamType>& info) {
+      return absl::StrCat(
+          std::get<0>(info.param) ? "f32_out" : "bf16_out", "__",
+          std::get<1>(info.param) ? "out_col_major" : "out_row_major");
+    });
+
+INSTANTIATE_TEST_SUITE_P(
+    DotThunkConstantTest, DotThunkConstantTest,
+    testing::Combine(testing::Bool(), testing::Bool(), testing::Bool(),
+                     testing::Bool()),
+    [](const testing::TestParamInfo<DotThunkConstantTest::ParamType>& info) {
+      return absl::StrCat(
+          std::get<0>(info.param) ? "lhs_constant" : "rhs_constant", "__",
+          std::get<1>(info.param) ? "lhs_col_major" : "lhs_row_major", "__",
+          std::get<2>(info.param) ? "rhs_col_major" : "rhs_row_major", "__",
+          std::get<3>(info.param) ? "out_col_major" : "out_row_major");
+    });
+
 INSTANTIATE_TEST_SUITE_P(
     DotThunkLayoutTest, DotThunkLayoutTest,
     testing::Combine(testing::Bool(), testing::Bool(), testing::Bool(),
@@ -14,6 +14,11 @@ limitations under the License.
 ==============================================================================*/
 #include "xla/backends/cpu/runtime/fft_thunk.h"
 
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 
@@ -28,13 +33,41 @@ limitations under the License.
 #include "xla/service/cpu/runtime_fft.h"
 #include "xla/service/cpu/runtime_single_threaded_fft.h"
 #include "xla/shape.h"
-#include "xla/status_macros.h"
+#include "xla/shape_util.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+#include "unsupported/Eigen/CXX11/Tensor"
 
 namespace xla::cpu {
 
+// Minimum number of input elements transformed by a single parallel task.
+static constexpr int64_t kMinElementsPerTask = 16 * 1024;
+
+// Flattens batch dimensions of the FFT input into a single dimension.
+static absl::InlinedVector<int64_t, 4> FlattenBatchDimensions(
+    const Shape& input_shape, int64_t fft_rank) {
+  absl::InlinedVector<int64_t, 4> operand_shape_flat(fft_rank + 1);
+  int64_t input_batch = 1;
+  int64_t input_batch_length = input_shape.dimensions_size() - fft_rank;
+  for (int64_t i = 0; i < input_batch_length; i++) {
+    input_batch *= input_shape.dimensions(i);
+  }
+  operand_shape_flat[0] = input_batch;
+  for (int64_t i = 0; i < fft_rank; ++i) {
+    operand_shape_flat[i + 1] = input_shape.dimensions(i + input_batch_length);
+  }
+  return operand_shape_flat;
+}
+
+// Returns the size in bytes of a single batch of the FFT input or output.
+static int64_t BatchSizeInBytes(const Shape& shape,
+                                absl::Span<const int64_t> shape_flat) {
+  int64_t batch = shape_flat[0];
+  return batch == 0 ? 0 : ShapeUtil::ByteSizeOf(shape) / batch;
+}
+
 FftThunk::FftThunk(Info thunk_info, bool is_multi_thread_eigen,
                    int32_t fft_type, absl::Span<const int64_t> fft_length,
                    BufferAllocation::Slice input_buffer,
@@ -47,6 +80,10 @@ FftThunk::FftThunk(Info thunk_info, bool is_multi_thread_eigen,
                            input_shape.element_type() == C128),
       fft_type_(fft_type),
       fft_length_(fft_length.begin(), fft_length.end()),
+      operand_shape_flat_(
+          FlattenBatchDimensions(input_shape, fft_length.size())),
+      input_batch_bytes_(BatchSizeInBytes(input_shape, operand_shape_flat_)),
+      output_batch_bytes_(BatchSizeInBytes(output_shape, operand_shape_flat_)),
       input_buffer_(input_buffer),
       output_buffer_(output_buffer),
       input_shape_(input_shape),
@@ -57,6 +94,17 @@ absl::StatusOr<std::unique_ptr<FftThunk>> FftThunk::Create(
     absl::Span<const int64_t> fft_length, BufferAllocation::Slice input_buffer,
     const Shape& input_shape, BufferAllocation::Slice output_buffer,
     const Shape& output_shape) {
+  if (!LayoutUtil::IsMonotonicWithDim0Major(input_shape.layout()) ||
+      !LayoutUtil::IsMonotonicWithDim0Major(output_shape.layout())) {
+    return InvalidArgument(
+        "FFT operands must have a row-major layout: %s -> %s",
+        input_shape.ToString(true), output_shape.ToString(true));
+  }
+  if (input_shape.dimensions_size() != output_shape.dimensions_size() ||
+      input_shape.dimensions_size() < static_cast<int>(fft_length.size())) {
+    return InvalidArgument("Invalid FFT shapes: %s -> %s",
+                           input_shape.ToString(), output_shape.ToString());
+  }
   return absl::WrapUnique(
       new FftThunk(thunk_info, is_multi_thread_eigen, fft_type, fft_length,
                    input_buffer, input_shape, output_buffer, output_shape));
@@ -64,9 +112,6 @@ absl::StatusOr<std::unique_ptr<FftThunk>> FftThunk::Create(
 
 tsl::AsyncValueRef<Thunk::ExecuteEvent> FftThunk::Execute(
     const ExecuteParams& params) {
-  TF_RET_CHECK(LayoutUtil::IsMonotonicWithDim0Major(input_shape_.layout()));
-  TF_RET_CHECK(LayoutUtil::IsMonotonicWithDim0Major(output_shape_.layout()));
-
   TF_ASSIGN_OR_RETURN(
       se::DeviceMemoryBase input_data,
       params.buffer_allocations->GetDeviceAddress(input_buffer_));
@@ -74,35 +119,65 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> FftThunk::Execute(
       se::DeviceMemoryBase output_data,
       params.buffer_allocations->GetDeviceAddress(output_buffer_));
 
-  const int fft_rank = fft_length_.size();
+  std::byte* input = reinterpret_cast<std::byte*>(input_data.opaque());
+  std::byte* output = reinterpret_cast<std::byte*>(output_data.opaque());
 
-  // Flatten operand batches.
-  absl::InlinedVector<int64_t, 4> operand_shape_flat(fft_rank + 1);
-  int64_t input_batch = 1;
-  int64_t input_batch_length = output_shape_.dimensions_size() - fft_rank;
-  for (int i = 0; i < input_batch_length; i++) {
-    input_batch *= input_shape_.dimensions(i);
+  const int64_t fft_rank = fft_length_.size();
+  const int64_t batch_size = operand_shape_flat_[0];
+
+  // Transforms batches in the [begin, end) range with a single thread.
+  auto fft = [this, input, output, fft_rank](int64_t begin, int64_t end) {
+    absl::InlinedVector<int64_t, 4> shape = operand_shape_flat_;
+    shape[0] = end - begin;
+    __xla_cpu_runtime_DuccSingleThreadedFft(
+        nullptr, output + begin * output_batch_bytes_,
+        input + begin * input_batch_bytes_, fft_type_, is_double_precision_,
+        fft_rank, shape.data(), fft_length_.data());
+  };
+
+  int64_t num_tasks = 1;
+  if (is_multi_thread_eigen_ && params.intra_op_threadpool && batch_size > 1) {
+    int64_t max_tasks = ShapeUtil::ElementsIn(input_shape_) /
+                        kMinElementsPerTask;
+    num_tasks = std::min<int64_t>(
+        {batch_size, max_tasks,
+         params.intra_op_threadpool->numThreadsInPool()});
   }
-  operand_shape_flat[0] = input_batch;
-  for (int i = 0; i < fft_rank; ++i) {
-    operand_shape_flat[i + 1] = input_shape_.dimensions(i + input_batch_length);
+
+  if (num_tasks <= 1) {
+    // Let DUCC parallelize a single large FFT over the intra-op thread pool.
+    if (is_multi_thread_eigen_) {
+      __xla_cpu_runtime_DuccFft(params.intra_op_threadpool, output, input,
+                                fft_type_, is_double_precision_, fft_rank,
+                                operand_shape_flat_.data(), fft_length_.data());
+    } else {
+      fft(0, batch_size);
+    }
+    return OkExecuteEvent();
   }
 
-  // Args have been computed, make the call.
-  if (is_multi_thread_eigen_) {
-    __xla_cpu_runtime_DuccFft(params.intra_op_threadpool,
-                              reinterpret_cast<float*>(output_data.opaque()),
-                              reinterpret_cast<float*>(input_data.opaque()),
-                              fft_type_, is_double_precision_, fft_rank,
-                              operand_shape_flat.data(), fft_length_.data());
-  } else {
-    __xla_cpu_runtime_DuccSingleThreadedFft(
-        nullptr, reinterpret_cast<float*>(output_data.opaque()),
-        reinterpret_cast<float*>(input_data.opaque()), fft_type_,
-        is_double_precision_, fft_rank, operand_shape_flat.data(),
-        fft_length_.data());
+  // Use intra-op thread pool to transform batches in parallel.
+  auto event = tsl::MakeConstructedAsyncValueRef<ExecuteEvent>();
+  auto counter = std::make_shared<std::atomic<int64_t>>(num_tasks);
+
+  auto execute = [=](int64_t task_index) {
+    fft(batch_size * task_index / num_tasks,
+        batch_size * (task_index + 1) / num_tasks);
+
+    if (counter->load() == 1 || counter->fetch_sub(1) == 1) {
+      event.SetStateConcrete();
+    }
+  };
+
+  for (int64_t i = 1; i < num_tasks; ++i) {
+    params.intra_op_threadpool->getPool()->Schedule(
+        [i, execute] { execute(i); });
   }
-  return OkExecuteEvent();
+
+  // Transform the first range of batches in the caller thread.
+  execute(0);
+
+  return event;
 }
 
 Thunk::BufferUses FftThunk::buffer_uses() const {
@@ -20,6 +20,7 @@ limitations under the License.
 #include <memory>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xla/backends/cpu/runtime/thunk.h"
@@ -33,6 +34,11 @@ namespace xla::cpu {
 // This class stores everything that is needed to launch an FFT.
 // It is generated by IrEmitter.
 //
+// Batch dimensions are flattened once at construction time, and batched FFTs
+// are split into ranges of batches that run in parallel on the intra-op
+// thread pool (DUCC caches twiddle factors for each FFT length, so all tasks
+// share them). A single FFT is parallelized by DUCC itself.
+//
 // This is thread-compatible.
 class FftThunk final : public Thunk {
  public:
@@ -69,6 +75,11 @@ class FftThunk final : public Thunk {
   const int32_t fft_type_;
   const std::vector<int64_t> fft_length_;
 
+  // Input shape with all batch dimensions flattened into the first one.
+  const absl::InlinedVector<int64_t, 4> operand_shape_flat_;
+  const int64_t input_batch_bytes_;
+  const int64_t output_batch_bytes_;
+
   const BufferAllocation::Slice input_buffer_;
   const BufferAllocation::Slice output_buffer_;
 
@@ -0,0 +1,108 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/fft_thunk.h"
+
+#include <cstdint>
+
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xla/backends/cpu/runtime/buffer_allocations.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_testlib.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/threadpool.h"
+#include "xla/xla_data.pb.h"
+
+#define EIGEN_USE_THREADS
+#include "unsupported/Eigen/CXX11/Tensor"
+
+namespace xla::cpu {
+namespace {
+
+// Runs a forward complex FFT over the minor dimension of `input`.
+absl::StatusOr<Literal> RunFft(
+    Literal& input, const Eigen::ThreadPoolDevice* device = nullptr) {
+  Literal output = Literal::CreateFromShape(input.shape());
+
+  BufferAllocations allocations = CreateBufferAllocations(input, output);
+  auto [input_alloc, output_alloc] = CreateBufferAllocation(input, output);
+  auto [input_slice, output_slice] =
+      CreateBufferAllocationSlice(input_alloc, output_alloc);
+
+  const Shape& shape = input.shape();
+  TF_ASSIGN_OR_RETURN(
+      auto thunk,
+      FftThunk::Create(
+          {"fft"}, /*is_multi_thread_eigen=*/true, /*fft_type=*/0,
+          /*fft_length=*/{shape.dimensions(shape.dimensions_size() - 1)},
+          input_slice, shape, output_slice, shape));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = device;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  if (execute_event.IsError()) return execute_event.GetError();
+  return output;
+}
+
+TEST(FftThunkTest, Fft) {
+  auto input = LiteralUtil::CreateR2<complex64>(
+      {{{1, 0}, {0, 0}, {0, 0}, {0, 0}}, {{1, 0}, {1, 0}, {1, 0}, {1, 0}}});
+  TF_ASSERT_OK_AND_ASSIGN(Literal output, RunFft(input));
+  EXPECT_EQ(output, LiteralUtil::CreateR2<complex64>(
+                        {{{1, 0}, {1, 0}, {1, 0}, {1, 0}},
+                         {{4, 0}, {0, 0}, {0, 0}, {0, 0}}}));
+}
+
+TEST(FftThunkTest, BatchedFftInParallel) {
+  Shape shape = ShapeUtil::MakeShape(C64, {4, 16, 1024});
+  auto input = *LiteralUtil::CreateLiteralWithGenerator<C64, complex64>(
+      shape, [](absl::Span<const int64_t> idx) {
+        return complex64((idx[0] * 7 + idx[1] * 3 + idx[2]) % 11, idx[1]);
+      });
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+
+  TF_ASSERT_OK_AND_ASSIGN(Literal parallel_output, RunFft(input, &device));
+  TF_ASSERT_OK_AND_ASSIGN(Literal sequential_output, RunFft(input));
+  EXPECT_EQ(parallel_output, sequential_output);
+}
+
+TEST(FftThunkTest, RejectsColumnMajorLayout) {
+  Shape shape = ShapeUtil::MakeShapeWithDenseLayout(C64, {4, 8}, {0, 1});
+  BufferAllocation alloc(/*index=*/0, ShapeUtil::ByteSizeOf(shape),
+                         /*color=*/0);
+  BufferAllocation::Slice slice(&alloc, 0, alloc.size());
+  EXPECT_FALSE(FftThunk::Create({"fft"}, /*is_multi_thread_eigen=*/true,
+                                /*fft_type=*/0, /*fft_length=*/{8}, slice,
+                                shape, slice, shape)
+                   .ok());
+}
+
+}  // namespace
+}  // namespace xla::cpu
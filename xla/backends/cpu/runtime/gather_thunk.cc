@@ -0,0 +1,317 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/gather_thunk.h"
+
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "absl/base/dynamic_annotations.h"
+#include "absl/base/prefetch.h"
+#include "absl/memory/memory.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "absl/types/span.h"
+#include "unsupported/Eigen/CXX11/Tensor"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/layout_util.h"
+#include "xla/primitive_util.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/stream_executor/device_memory.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/logging.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+
+// Minimum number of bytes copied by a single task when we gather rows in
+// parallel, to amortize the cost of scheduling tasks.
+static constexpr int64_t kMinBytesPerTask = 64 * 1024;
+
+// Number of rows ahead of the current one that we prefetch into the cache.
+// Indices are known upfront, so we can hide the latency of loading random
+// rows behind the copies of the rows before them.
+static constexpr int64_t kPrefetchDistance = 8;
+
+bool GatherThunk::IsRowGather(const Shape& operand_shape,
+                              const Shape& indices_shape,
+                              const Shape& output_shape,
+                              const GatherDimensionNumbers& dimension_numbers,
+                              absl::Span<const int64_t> slice_sizes) {
+  if (!operand_shape.IsArray() || !indices_shape.IsArray() ||
+      !output_shape.IsArray() || operand_shape.dimensions().empty()) {
+    return false;
+  }
+
+  // We copy rows as bytes, so we don't support sub-byte types.
+  PrimitiveType element_type = operand_shape.element_type();
+  if (output_shape.element_type() != element_type ||
+      primitive_util::BitWidth(element_type) % 8 != 0) {
+    return false;
+  }
+
+  if (indices_shape.element_type() != S32 &&
+      indices_shape.element_type() != S64) {
+    return false;
+  }
+
+  for (const Shape* shape : {&operand_shape, &indices_shape, &output_shape}) {
+    if (!LayoutUtil::IsMonotonicWithDim0Major(shape->layout())) {
+      return false;
+    }
+  }
+
+  // Gather must index into the major-most operand dimension only.
+  if (dimension_numbers.start_index_map_size() != 1 ||
+      dimension_numbers.start_index_map(0) != 0 ||
+      dimension_numbers.collapsed_slice_dims_size() != 1 ||
+      dimension_numbers.collapsed_slice_dims(0) != 0 ||
+      dimension_numbers.operand_batching_dims_size() != 0) {
+    return false;
+  }
+
+  // Gather must copy whole rows of the operand.
+  int64_t rank = operand_shape.dimensions_size();
+  if (slice_sizes.size() != static_cast<size_t>(rank) || slice_sizes[0] != 1) {
+    return false;
+  }
+  for (int64_t i = 1; i < rank; ++i) {
+    if (slice_sizes[i] != operand_shape.dimensions(i)) {
+      return false;
+    }
+  }
+
+  // Start indices must be scalars, with either an implicit or a trailing
+  // degenerate index vector dimension.
+  int64_t index_vector_dim = dimension_numbers.index_vector_dim();
+  int64_t indices_rank = indices_shape.dimensions_size();
+  if (index_vector_dim < indices_rank &&
+      (index_vector_dim != indices_rank - 1 ||
+       indices_shape.dimensions(index_vector_dim) != 1)) {
+    return false;
+  }
+
+  // Offset dimensions must follow batch dimensions in the output, so that
+  // each output row is contiguous in memory.
+  int64_t num_batch_dims = index_vector_dim;
+  if (dimension_numbers.offset_dims_size() != rank - 1) {
+    return false;
+  }
+  for (int64_t i = 0; i < rank - 1; ++i) {
+    if (dimension_numbers.offset_dims(i) != num_batch_dims + i) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+absl::StatusOr<std::unique_ptr<GatherThunk>> GatherThunk::Create(
+    Info info, BufferAllocation::Slice operand_buffer,
+    const Shape& operand_shape, BufferAllocation::Slice indices_buffer,
+    const Shape& indices_shape, BufferAllocation::Slice output_buffer,
+    const Shape& output_shape) {
+  if (!operand_shape.IsArray() || operand_shape.dimensions().empty()) {
+    return InvalidArgument("Gather operand must be a non-scalar array, got %s",
+                           operand_shape.ToString(true));
+  }
+
+  if (indices_shape.element_type() != S32 &&
+      indices_shape.element_type() != S64) {
+    return InvalidArgument("Gather indices must be S32 or S64, got %s",
+                           indices_shape.ToString(true));
+  }
+
+  int64_t row_elements =
+      ShapeUtil::ElementsIn(operand_shape) / operand_shape.dimensions(0);
+  if (ShapeUtil::ElementsIn(output_shape) !=
+      ShapeUtil::ElementsIn(indices_shape) * row_elements) {
+    return InvalidArgument(
+        "Gather output %s must have a row of operand %s for every index in %s",
+        output_shape.ToString(true), operand_shape.ToString(true),
+        indices_shape.ToString(true));
+  }
+
+  if (operand_shape.dimensions(0) == 0 &&
+      ShapeUtil::ElementsIn(indices_shape) > 0) {
+    return InvalidArgument("Can't gather rows from an empty operand %s",
+                           operand_shape.ToString(true));
+  }
+
+  return absl::WrapUnique(new GatherThunk(
+      std::move(info), operand_buffer, operand_shape, indices_buffer,
+      indices_shape, output_buffer, output_shape));
+}
+
+GatherThunk::GatherThunk(Info info, BufferAllocation::Slice operand_buffer,
+                         const Shape& operand_shape,
+                         BufferAllocation::Slice indices_buffer,
+                         const Shape& indices_shape,
+                         BufferAllocation::Slice output_buffer,
+                         const Shape& output_shape)
+    : Thunk(Kind::kGather, std::move(info)),
+      operand_buffer_(operand_buffer),
+      operand_shape_(operand_shape),
+      indices_buffer_(indices_buffer),
+      indices_shape_(indices_shape),
+      output_buffer_(output_buffer),
+      output_shape_(output_shape),
+      num_rows_(operand_shape.dimensions(0)),
+      num_indices_(ShapeUtil::ElementsIn(indices_shape)),
+      row_size_(ShapeUtil::ByteSizeOf(operand_shape) /
+                std::max<int64_t>(1, operand_shape.dimensions(0))) {}
+
+// Gather clamps start indices, so that gathered rows are always in bounds.
+template <typename IndexType>
+static int64_t ClampIndex(IndexType index, int64_t num_rows) {
+  return std::clamp<int64_t>(index, 0, num_rows - 1);
+}
+
+// Gathers rows of a single element with plain loads and stores, which the
+// compiler can vectorize with hardware gathers when the target supports them
+// (i.e. AVX2 and AVX-512).
+template <typename RowType, typename IndexType>
+static void GatherElements(const std::byte* operand, const IndexType* indices,
+                           std::byte* output, int64_t num_rows, int64_t begin,
+                           int64_t end) {
+  const RowType* src = reinterpret_cast<const RowType*>(operand);
+  RowType* dst = reinterpret_cast<RowType*>(output);
+  for (int64_t i = begin; i < end; ++i) {
+    dst[i] = src[ClampIndex(indices[i], num_rows)];
+  }
+}
+
+// Gathers rows in the [begin, end) range with memcpy, and prefetches rows for
+// upcoming indices.
+template <typename IndexType>
+static void GatherRows(const std::byte* operand, const IndexType* indices,
+                       std::byte* output, int64_t num_rows, int64_t row_size,
+                       int64_t begin, int64_t end) {
+  switch (row_size) {
+    case 4:
+      return GatherElements<uint32_t>(operand, indices, output, num_rows, begin,
+                                      end);
+    case 8:
+      return GatherElements<uint64_t>(operand, indices, output, num_rows, begin,
+                                      end);
+    default:
+      break;
+  }
+
+  for (int64_t i = begin; i < end; ++i) {
+    if (i + kPrefetchDistance < end) {
+      absl::PrefetchToLocalCache(
+          operand +
+          ClampIndex(indices[i + kPrefetchDistance], num_rows) * row_size);
+    }
+    std::memcpy(output + i * row_size,
+                operand + ClampIndex(indices[i], num_rows) * row_size,
+                row_size);
+  }
+}
+
+tsl::AsyncValueRef<Thunk::ExecuteEvent> GatherThunk::Execute(
+    const ExecuteParams& params) {
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase operand,
+      params.buffer_allocations->GetDeviceAddress(operand_buffer_));
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase indices,
+      params.buffer_allocations->GetDeviceAddress(indices_buffer_));
+  TF_ASSIGN_OR_RETURN(
+      se::DeviceMemoryBase output,
+      params.buffer_allocations->GetDeviceAddress(output_buffer_));
+
+  // Annotate memory that might have been initialized by jit-compiled code.
+  ABSL_ANNOTATE_MEMORY_IS_INITIALIZED(operand.opaque(), operand.size());
+  ABSL_ANNOTATE_MEMORY_IS_INITIALIZED(indices.opaque(), indices.size());
+
+  VLOG(3) << absl::StreamFormat(
+      "Gather: num_rows=%d num_indices=%d row_size=%d bytes index_type=%s",
+      num_rows_, num_indices_, row_size_,
+      primitive_util::LowercasePrimitiveTypeName(
+          indices_shape_.element_type()));
+
+  if (num_indices_ == 0 || row_size_ == 0) {
+    return OkExecuteEvent();
+  }
+
+  const std::byte* operand_data =
+      reinterpret_cast<const std::byte*>(operand.opaque());
+  const void* indices_data = indices.opaque();
+  std::byte* output_data = reinterpret_cast<std::byte*>(output.opaque());
+
+  // Gathers rows for indices in the [begin, end) range.
+  auto gather = [=, num_rows = num_rows_, row_size = row_size_,
+                 index_type = indices_shape_.element_type()](int64_t begin,
+                                                             int64_t end) {
+    if (index_type == S32) {
+      GatherRows(operand_data, static_cast<const int32_t*>(indices_data),
+                 output_data, num_rows, row_size, begin, end);
+    } else {
+      GatherRows(operand_data, static_cast<const int64_t*>(indices_data),
+                 output_data, num_rows, row_size, begin, end);
+    }
+  };
+
+  int64_t num_tasks = 1;
+  if (params.intra_op_threadpool && num_indices_ > 1) {
+    int64_t max_tasks = num_indices_ * row_size_ / kMinBytesPerTask;
+    num_tasks = std::min<int64_t>(
+        {num_indices_, max_tasks,
+         params.intra_op_threadpool->numThreadsInPool()});
+  }
+
+  if (num_tasks <= 1) {
+    gather(0, num_indices_);
+    return OkExecuteEvent();
+  }
+
+  // Use intra-op thread pool to gather rows in parallel.
+  auto event = tsl::MakeConstructedAsyncValueRef<ExecuteEvent>();
+  auto counter = std::make_shared<std::atomic<int64_t>>(num_tasks);
+
+  auto execute = [=, num_indices = num_indices_](int64_t task_index) {
+    gather(num_indices * task_index / num_tasks,
+           num_indices * (task_index + 1) / num_tasks);
+
+    if (counter->load() == 1 || counter->fetch_sub(1) == 1) {
+      event.SetStateConcrete();
+    }
+  };
+
+  for (int64_t i = 1; i < num_tasks; ++i) {
+    params.intra_op_threadpool->getPool()->Schedule(
+        [i, execute] { execute(i); });
+  }
+
+  // Gather the first range of rows in the caller thread.
+  execute(0);
+
+  return event;
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,100 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_GATHER_THUNK_H_
+#define XLA_BACKENDS_CPU_RUNTIME_GATHER_THUNK_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "absl/status/statusor.h"
+#include "absl/types/span.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/runtime/buffer_use.h"
+#include "xla/service/buffer_assignment.h"
+#include "xla/shape.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+
+// Gathers whole rows of the operand, i.e. `output[i, ...] = operand[idx[i],
+// ...]`, which is the access pattern of embedding lookups. Gathers like that
+// are bound by memory latency, so instead of a generic elemental loop we copy
+// rows with memcpy, prefetch rows for upcoming indices and split large index
+// batches across the intra-op thread pool.
+class GatherThunk final : public Thunk {
+ public:
+  // Returns true if the gather with the given shapes and dimension numbers
+  // copies whole rows of the operand along its major-most dimension, and
+  // all shapes have dim0-major layouts, so that each output row is a
+  // contiguous copy of an operand row.
+  static bool IsRowGather(const Shape& operand_shape,
+                          const Shape& indices_shape, const Shape& output_shape,
+                          const GatherDimensionNumbers& dimension_numbers,
+                          absl::Span<const int64_t> slice_sizes);
+
+  static absl::StatusOr<std::unique_ptr<GatherThunk>> Create(
+      Info info, BufferAllocation::Slice operand_buffer,
+      const Shape& operand_shape, BufferAllocation::Slice indices_buffer,
+      const Shape& indices_shape, BufferAllocation::Slice output_buffer,
+      const Shape& output_shape);
+
+  tsl::AsyncValueRef<ExecuteEvent> Execute(const ExecuteParams& params) final;
+
+  BufferUses buffer_uses() const final {
+    return {BufferUse::Read(operand_buffer_), BufferUse::Read(indices_buffer_),
+            BufferUse::Write(output_buffer_)};
+  }
+
+  const BufferAllocation::Slice& operand_buffer() const {
+    return operand_buffer_;
+  }
+  const BufferAllocation::Slice& indices_buffer() const {
+    return indices_buffer_;
+  }
+  const BufferAllocation::Slice& output_buffer() const {
+    return output_buffer_;
+  }
+
+  const Shape& operand_shape() const { return operand_shape_; }
+  const Shape& indices_shape() const { return indices_shape_; }
+  const Shape& output_shape() const { return output_shape_; }
+
+ private:
+  GatherThunk(Info info, BufferAllocation::Slice operand_buffer,
+              const Shape& operand_shape,
+              BufferAllocation::Slice indices_buffer,
+              const Shape& indices_shape,
+              BufferAllocation::Slice output_buffer,
+              const Shape& output_shape);
+
+  BufferAllocation::Slice operand_buffer_;
+  Shape operand_shape_;
+
+  BufferAllocation::Slice indices_buffer_;
+  Shape indices_shape_;
+
+  BufferAllocation::Slice output_buffer_;
+  Shape output_shape_;
+
+  int64_t num_rows_;     // number of rows in the operand
+  int64_t num_indices_;  // number of gathered rows
+  int64_t row_size_;     // size of a single row in bytes
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_GATHER_THUNK_H_
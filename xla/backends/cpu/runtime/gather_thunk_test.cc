@@ -0,0 +1,166 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/gather_thunk.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "absl/types/span.h"
+#include "xla/backends/cpu/runtime/buffer_allocations.h"
+#include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_testlib.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/threadpool.h"
+#include "xla/xla_data.pb.h"
+
+#define EIGEN_USE_THREADS
+#include "unsupported/Eigen/CXX11/Tensor"
+
+namespace xla::cpu {
+namespace {
+
+// Returns dimension numbers of a gather that takes rows of a rank 2 operand.
+GatherDimensionNumbers RowGatherDimensionNumbers() {
+  GatherDimensionNumbers dimension_numbers;
+  dimension_numbers.add_offset_dims(1);
+  dimension_numbers.add_collapsed_slice_dims(0);
+  dimension_numbers.add_start_index_map(0);
+  dimension_numbers.set_index_vector_dim(1);
+  return dimension_numbers;
+}
+
+TEST(GatherThunkTest, IsRowGather) {
+  Shape operand = ShapeUtil::MakeShape(F32, {10, 4});
+  Shape indices = ShapeUtil::MakeShape(S32, {3, 1});
+  Shape output = ShapeUtil::MakeShape(F32, {3, 4});
+
+  GatherDimensionNumbers dimension_numbers = RowGatherDimensionNumbers();
+  EXPECT_TRUE(GatherThunk::IsRowGather(operand, indices, output,
+                                       dimension_numbers, {1, 4}));
+
+  // Partial rows are not contiguous in the operand.
+  EXPECT_FALSE(GatherThunk::IsRowGather(operand, indices,
+                                        ShapeUtil::MakeShape(F32, {3, 2}),
+                                        dimension_numbers, {1, 2}));
+
+  // Gathers along the minor dimension are column gathers.
+  GatherDimensionNumbers column_dimension_numbers = dimension_numbers;
+  column_dimension_numbers.set_collapsed_slice_dims(0, 1);
+  column_dimension_numbers.set_start_index_map(0, 1);
+  EXPECT_FALSE(GatherThunk::IsRowGather(operand, indices,
+                                        ShapeUtil::MakeShape(F32, {3, 10}),
+                                        column_dimension_numbers, {10, 1}));
+
+  // Floating point indices are not supported.
+  EXPECT_FALSE(GatherThunk::IsRowGather(operand,
+                                        ShapeUtil::MakeShape(F32, {3, 1}),
+                                        output, dimension_numbers, {1, 4}));
+}
+
+TEST(GatherThunkTest, GatherRows) {
+  auto operand = LiteralUtil::CreateR2<float>(
+      {{1.0, 2.0, 3.0}, {4.0, 5.0, 6.0}, {7.0, 8.0, 9.0}});
+  // Out of bounds indices are clamped to the valid range.
+  auto indices = LiteralUtil::CreateR2<int32_t>({{2}, {0}, {7}, {-1}});
+  auto output = LiteralUtil::CreateR2<float>(
+      {{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}});
+
+  BufferAllocations allocations =
+      CreateBufferAllocations(operand, indices, output);
+  auto [operand_alloc, indices_alloc, output_alloc] =
+      CreateBufferAllocation(operand, indices, output);
+  auto [operand_slice, indices_slice, output_slice] =
+      CreateBufferAllocationSlice(operand_alloc, indices_alloc, output_alloc);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk, GatherThunk::Create({"gather"}, operand_slice,
+                                      operand.shape(), indices_slice,
+                                      indices.shape(), output_slice,
+                                      output.shape()));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  EXPECT_EQ(output, LiteralUtil::CreateR2<float>({{7.0, 8.0, 9.0},
+                                                  {1.0, 2.0, 3.0},
+                                                  {7.0, 8.0, 9.0},
+                                                  {1.0, 2.0, 3.0}}));
+}
+
+TEST(GatherThunkTest, GatherRowsInParallel) {
+  constexpr int64_t kNumRows = 100;
+  constexpr int64_t kRowSize = 256;
+  constexpr int64_t kNumIndices = 1000;
+
+  Shape operand_shape = ShapeUtil::MakeShape(F32, {kNumRows, kRowSize});
+  Shape output_shape = ShapeUtil::MakeShape(F32, {kNumIndices, kRowSize});
+
+  auto operand = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      operand_shape, [](absl::Span<const int64_t> idx) {
+        return static_cast<float>(idx[0] * kRowSize + idx[1]);
+      });
+
+  std::vector<int64_t> index_values(kNumIndices);
+  for (int64_t i = 0; i < kNumIndices; ++i) {
+    index_values[i] = (i * 37) % kNumRows;
+  }
+  auto indices = LiteralUtil::CreateR1<int64_t>(index_values);
+  auto output = Literal::CreateFromShape(output_shape);
+
+  BufferAllocations allocations =
+      CreateBufferAllocations(operand, indices, output);
+  auto [operand_alloc, indices_alloc, output_alloc] =
+      CreateBufferAllocation(operand, indices, output);
+  auto [operand_slice, indices_slice, output_slice] =
+      CreateBufferAllocationSlice(operand_alloc, indices_alloc, output_alloc);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk,
+      GatherThunk::Create({"gather"}, operand_slice, operand_shape,
+                          indices_slice, indices.shape(), output_slice,
+                          output_shape));
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = &device;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  auto expected = *LiteralUtil::CreateLiteralWithGenerator<F32, float>(
+      output_shape, [&](absl::Span<const int64_t> idx) {
+        return static_cast<float>(index_values[idx[0]] * kRowSize + idx[1]);
+      });
+  EXPECT_EQ(output, expected);
+}
+
+}  // namespace
+}  // namespace xla::cpu
@@ -42,12 +42,7 @@ using LaunchEvent = Kernel::LaunchEvent;
 
 // Non-reference-counted async value ref for host kernels executed inline.
 static tsl::AsyncValueRef<LaunchEvent> OkLaunchEvent() {
-  static tsl::AsyncValueOwningRef<LaunchEvent>* event = [] {
-    auto* storage = new tsl::internal::AsyncValueStorage<LaunchEvent>();
-    return new tsl::AsyncValueOwningRef<LaunchEvent>(
-        tsl::MakeAvailableAsyncValueRef<LaunchEvent>(*storage));
-  }();
-  return event->AsRef();
+  return tsl::GetAvailableAsyncValueRefSingleton<LaunchEvent>();
 }
 
 static absl::InlinedVector<XLA_CPU_KernelArg, 8> ConvertBuffersToKernelArgs(
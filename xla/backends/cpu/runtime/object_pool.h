@@ -16,10 +16,13 @@ limitations under the License.
 #ifndef XLA_BACKENDS_CPU_RUNTIME_OBJECT_POOL_H_
 #define XLA_BACKENDS_CPU_RUNTIME_OBJECT_POOL_H_
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <memory>
+#include <new>
 #include <optional>
+#include <utility>
 
 #include "absl/functional/any_invocable.h"
 #include "absl/status/statusor.h"
@@ -27,11 +30,26 @@ limitations under the License.
 
 namespace xla::cpu {
 
+namespace internal {
+// Returns a small integer id of the current thread that is used to pick a
+// local free list in the object pool.
+inline size_t ObjectPoolThreadId() {
+  static std::atomic<size_t> next_thread_id(0);
+  thread_local size_t thread_id = next_thread_id.fetch_add(1);
+  return thread_id;
+}
+}  // namespace internal
+
 // A non-blocking pool of objects of type `T`. Objects in the pool are created
 // lazily when needed by calling the user-provided `builder` function.
 //
 // This object pool is intended to be used on a critical path and optimized for
 // zero-allocation in steady state.
+//
+// To avoid contention on a single free list, returned objects are pushed to
+// one of the local free lists selected by the calling thread id. When a local
+// free list grows larger than `kMaxLocalEntries`, its entries are moved to the
+// global free list in one batch, where they can be picked up by other threads.
 template <typename T, typename... Args>
 class ObjectPool {
   struct Entry {
@@ -42,6 +60,13 @@ class ObjectPool {
   };
 
  public:
+  // Number of local free lists, threads with the same id modulo
+  // `kNumLocalLists` share the local free list.
+  static constexpr size_t kNumLocalLists = 16;
+
+  // Local free list size at which entries are returned to the global list.
+  static constexpr size_t kMaxLocalEntries = 8;
+
   explicit ObjectPool(absl::AnyInvocable<absl::StatusOr<T>(Args...)> builder);
   ~ObjectPool();
 
@@ -64,29 +89,80 @@ class ObjectPool {
     std::unique_ptr<Entry> entry_;
   };
 
+  // Object pool counters that allow to monitor pool contention.
+  struct Stats {
+    size_t num_created = 0;        // number of created objects
+    size_t num_local_hits = 0;     // objects taken from a local free list
+    size_t num_global_hits = 0;    // objects taken from the global free list
+    size_t num_batch_returns = 0;  // batches returned to the global free list
+    size_t num_cas_retries = 0;    // failed compare-and-swap operations
+  };
+
   absl::StatusOr<BorrowedObject> GetOrCreate(Args... args);
 
   size_t num_created() const { return num_created_.load(); }
 
+  // Returns a snapshot of the pool counters. Counters are updated with relaxed
+  // memory ordering, and the snapshot is not guaranteed to be consistent.
+  Stats stats() const;
+
  private:
+  static constexpr size_t kAlignment =
+#if defined(__cpp_lib_hardware_interference_size)
+      std::hardware_destructive_interference_size;
+#else
+      64;
+#endif
+
+  // Align local free lists to a cache line boundary to avoid false sharing
+  // between threads using different local free lists.
+  struct alignas(kAlignment) LocalList {
+    std::atomic<Entry*> head{nullptr};
+    std::atomic<size_t> size{0};
+
+    std::atomic<size_t> num_local_hits{0};
+    std::atomic<size_t> num_global_hits{0};
+    std::atomic<size_t> num_batch_returns{0};
+    std::atomic<size_t> num_cas_retries{0};
+  };
+
   absl::StatusOr<std::unique_ptr<Entry>> CreateEntry(Args... args);
   std::unique_ptr<Entry> PopEntry();
   void PushEntry(std::unique_ptr<Entry> entry);
 
+  LocalList& local_list() {
+    return local_lists_[internal::ObjectPoolThreadId() % kNumLocalLists];
+  }
+
+  // Pushes a chain of entries [first, last] to the free list `head`.
+  static void PushChain(std::atomic<Entry*>& head, Entry* first, Entry* last,
+                        LocalList& local);
+
+  // Deletes all entries in the free list `head`.
+  static void DeleteChain(std::atomic<Entry*>& head);
+
   absl::AnyInvocable<absl::StatusOr<T>(Args...)> builder_;
-  std::atomic<Entry*> head_;
   std::atomic<size_t> num_created_;
+
+  alignas(kAlignment) std::atomic<Entry*> head_;
+  std::array<LocalList, kNumLocalLists> local_lists_;
 };
 
 template <typename T, typename... Args>
 ObjectPool<T, Args...>::ObjectPool(
     absl::AnyInvocable<absl::StatusOr<T>(Args...)> builder)
-    : builder_(std::move(builder)), head_(nullptr), num_created_(0) {}
+    : builder_(std::move(builder)), num_created_(0), head_(nullptr) {}
 
 template <typename T, typename... Args>
 ObjectPool<T, Args...>::~ObjectPool() {
-  while (Entry* entry = head_.load()) {
-    head_.store(entry->next);
+  DeleteChain(head_);
+  for (LocalList& local : local_lists_) DeleteChain(local.head);
+}
+
+template <typename T, typename... Args>
+void ObjectPool<T, Args...>::DeleteChain(std::atomic<Entry*>& head) {
+  while (Entry* entry = head.load()) {
+    head.store(entry->next);
     delete entry;
   }
 }
@@ -101,21 +177,93 @@ auto ObjectPool<T, Args...>::CreateEntry(Args... args)
   return entry;
 }
 
+template <typename T, typename... Args>
+auto ObjectPool<T, Args...>::stats() const -> Stats {
+  Stats stats;
+  stats.num_created = num_created();
+  for (const LocalList& local : local_lists_) {
+    stats.num_local_hits += local.num_local_hits.load(std::memory_order_relaxed);
+    stats.num_global_hits +=
+        local.num_global_hits.load(std::memory_order_relaxed);
+    stats.num_batch_returns +=
+        local.num_batch_returns.load(std::memory_order_relaxed);
+    stats.num_cas_retries +=
+        local.num_cas_retries.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
 template <typename T, typename... Args>
 auto ObjectPool<T, Args...>::PopEntry() -> std::unique_ptr<Entry> {
-  Entry* head = head_.load();
-  while (head && !head_.compare_exchange_weak(head, head->next)) {
+  LocalList& local = local_list();
+
+  // Try to pop an entry from the local free list first. Local free list is
+  // shared only by threads with the same id modulo `kNumLocalLists`, and in
+  // most cases it's accessed only by the current thread.
+  Entry* head = local.head.load();
+  while (head && !local.head.compare_exchange_weak(head, head->next)) {
+    local.num_cas_retries.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (head) {
+    local.size.fetch_sub(1, std::memory_order_relaxed);
+    local.num_local_hits.fetch_add(1, std::memory_order_relaxed);
+    return std::unique_ptr<Entry>(head);
   }
+
+  // Take all entries from the global free list at once and move all but the
+  // first one into the local free list.
+  head = head_.exchange(nullptr);
+  if (head == nullptr) return nullptr;
+
+  local.num_global_hits.fetch_add(1, std::memory_order_relaxed);
+
+  if (Entry* first = head->next.load()) {
+    size_t size = 1;
+    Entry* last = first;
+    for (; Entry* next = last->next.load(); last = next) ++size;
+    PushChain(local.head, first, last, local);
+    local.size.fetch_add(size, std::memory_order_relaxed);
+  }
+
+  head->next = nullptr;
   return std::unique_ptr<Entry>(head);
 }
 
 template <typename T, typename... Args>
 void ObjectPool<T, Args...>::PushEntry(std::unique_ptr<Entry> entry) {
-  Entry* head = head_.load();
+  LocalList& local = local_list();
+
   Entry* new_head = entry.release();
-  do {
-    new_head->next = head;
-  } while (!head_.compare_exchange_weak(head, new_head));
+  PushChain(local.head, new_head, new_head, local);
+
+  if (local.size.fetch_add(1, std::memory_order_relaxed) < kMaxLocalEntries) {
+    return;
+  }
+
+  // Local free list is too large, return all entries to the global free list
+  // in one batch, so they can be picked up by other threads.
+  Entry* first = local.head.exchange(nullptr);
+  if (first == nullptr) return;
+
+  size_t size = 1;
+  Entry* last = first;
+  for (; Entry* next = last->next.load(); last = next) ++size;
+
+  local.size.fetch_sub(size, std::memory_order_relaxed);
+  local.num_batch_returns.fetch_add(1, std::memory_order_relaxed);
+  PushChain(head_, first, last, local);
+}
+
+template <typename T, typename... Args>
+void ObjectPool<T, Args...>::PushChain(std::atomic<Entry*>& head, Entry* first,
+                                       Entry* last, LocalList& local) {
+  Entry* old_head = head.load();
+  last->next = old_head;
+  while (!head.compare_exchange_weak(old_head, first)) {
+    last->next = old_head;
+    local.num_cas_retries.fetch_add(1, std::memory_order_relaxed);
+  }
 }
 
 template <typename T, typename... Args>
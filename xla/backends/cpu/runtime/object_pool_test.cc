@@ -20,6 +20,7 @@ limitations under the License.
 #include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/status/statusor.h"
 #include "absl/synchronization/blocking_counter.h"
@@ -82,6 +83,47 @@ TEST(ObjectPoolTest, GetOrCreateUnderContention) {
   EXPECT_LE(counter, 8);
 }
 
+TEST(ObjectPoolTest, BatchReturnToGlobalList) {
+  int32_t counter = 0;
+  IntPool pool([&]() -> absl::StatusOr<std::unique_ptr<int32_t>> {
+    return std::make_unique<int32_t>(counter++);
+  });
+
+  static constexpr size_t kNumObjects = 2 * IntPool::kMaxLocalEntries;
+
+  {  // Borrow and return objects in the main thread.
+    std::vector<IntPool::BorrowedObject> objs;
+    for (size_t i = 0; i < kNumObjects; ++i) {
+      TF_ASSERT_OK_AND_ASSIGN(auto obj, pool.GetOrCreate());
+      objs.push_back(std::move(obj));
+    }
+  }
+
+  IntPool::Stats stats = pool.stats();
+  EXPECT_EQ(stats.num_created, kNumObjects);
+  EXPECT_EQ(stats.num_batch_returns, 1);
+
+  // Objects returned to the global list must be visible to other threads.
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 1);
+  absl::BlockingCounter blocking_counter(1);
+
+  threads.Schedule([&] {
+    std::vector<IntPool::BorrowedObject> objs;
+    for (size_t i = 0; i < IntPool::kMaxLocalEntries; ++i) {
+      TF_ASSERT_OK_AND_ASSIGN(auto obj, pool.GetOrCreate());
+      objs.push_back(std::move(obj));
+    }
+    blocking_counter.DecrementCount();
+  });
+
+  blocking_counter.Wait();
+
+  stats = pool.stats();
+  EXPECT_EQ(stats.num_created, kNumObjects);
+  EXPECT_GE(stats.num_global_hits, 1);
+  EXPECT_EQ(counter, kNumObjects);
+}
+
 //===----------------------------------------------------------------------===//
 // Performance benchmarks.
 //===----------------------------------------------------------------------===//
@@ -97,7 +139,36 @@ static void BM_GetOrCreate(benchmark::State& state) {
   }
 }
 
+static void BM_GetOrCreateUnderContention(benchmark::State& state) {
+  static constexpr size_t kNumThreads = 8;
+
+  IntPool pool([cnt = 0]() mutable -> absl::StatusOr<std::unique_ptr<int32_t>> {
+    return std::make_unique<int32_t>(cnt++);
+  });
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "bench", kNumThreads);
+
+  for (auto _ : state) {
+    absl::BlockingCounter blocking_counter(kNumThreads);
+    for (size_t t = 0; t < kNumThreads; ++t) {
+      threads.Schedule([&] {
+        for (size_t i = 0; i < 1000; ++i) {
+          auto obj = pool.GetOrCreate();
+          benchmark::DoNotOptimize(obj);
+        }
+        blocking_counter.DecrementCount();
+      });
+    }
+    blocking_counter.Wait();
+  }
+
+  IntPool::Stats stats = pool.stats();
+  state.counters["num_created"] = stats.num_created;
+  state.counters["num_cas_retries"] = stats.num_cas_retries;
+}
+
 BENCHMARK(BM_GetOrCreate);
+BENCHMARK(BM_GetOrCreateUnderContention)->MeasureProcessCPUTime();
 
 }  // namespace
 }  // namespace xla::cpu
@@ -21,6 +21,7 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/log/log.h"
 #include "absl/memory/memory.h"
 #include "absl/status/statusor.h"
@@ -62,6 +63,10 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> OutfeedThunk::Execute(
     return InvalidArgument("Xfeed must be not null to execute outfeed thunk");
   }
 
+  if (const runtime::OutfeedCallback* callback = xfeed->outfeed_callback()) {
+    return ExecuteWithCallback(params, *callback);
+  }
+
   int64_t outfeed_num = 0;
 
   for (OutfeedBuffer& outfeed_buffer : outfeed_buffers_) {
@@ -97,6 +102,27 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> OutfeedThunk::Execute(
   return OkExecuteEvent();
 }
 
+tsl::AsyncValueRef<Thunk::ExecuteEvent> OutfeedThunk::ExecuteWithCallback(
+    const ExecuteParams& params, const runtime::OutfeedCallback& callback) {
+  // Pass all outfed arrays to the consumer in a single call, without copying
+  // them into client-managed buffers.
+  absl::InlinedVector<runtime::OutfeedData, 4> outfeed_data;
+  outfeed_data.reserve(outfeed_buffers_.size());
+
+  for (const OutfeedBuffer& outfeed_buffer : outfeed_buffers_) {
+    TF_ASSIGN_OR_RETURN(
+        se::DeviceMemoryBase data,
+        params.buffer_allocations->GetDeviceAddress(outfeed_buffer.slice));
+    outfeed_data.push_back(runtime::OutfeedData{
+        &outfeed_buffer.shape,
+        absl::MakeConstSpan(static_cast<const uint8_t*>(data.opaque()),
+                            data.size())});
+  }
+
+  callback(outfeed_data);
+  return OkExecuteEvent();
+}
+
 OutfeedThunk::BufferUses OutfeedThunk::buffer_uses() const {
   BufferUses buffer_uses;
   for (const OutfeedBuffer& outfeed_buffer : outfeed_buffers_) {
@@ -25,6 +25,7 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/resource_use.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/service/buffer_assignment.h"
+#include "xla/service/cpu/xfeed_manager.h"
 #include "xla/shape.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 
@@ -63,6 +64,11 @@ class OutfeedThunk final : public Thunk {
   OutfeedThunk(Info info, absl::Span<const OutfeedBuffer> outfeed_buffers,
                OutfeedResources outfeed_resources);
 
+  // Passes outfeed buffers directly to the consumer `callback` registered in
+  // the xfeed manager instead of copying them into the outfeed queue.
+  tsl::AsyncValueRef<ExecuteEvent> ExecuteWithCallback(
+      const ExecuteParams& params, const runtime::OutfeedCallback& callback);
+
   std::vector<OutfeedBuffer> outfeed_buffers_;
   OutfeedResources outfeed_resources_;
 };
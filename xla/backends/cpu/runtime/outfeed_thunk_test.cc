@@ -15,14 +15,24 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/outfeed_thunk.h"
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <vector>
 
 #include <gtest/gtest.h>
+#include "absl/types/span.h"
+#include "xla/backends/cpu/runtime/buffer_allocations.h"
 #include "xla/backends/cpu/runtime/resource_use.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/thunk_testlib.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
 #include "xla/runtime/buffer_use.h"
 #include "xla/service/buffer_assignment.h"
+#include "xla/service/cpu/xfeed_manager.h"
 #include "xla/shape_util.h"
+#include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/statusor.h"
 #include "tsl/platform/test.h"
@@ -54,5 +64,43 @@ TEST(OutfeedThunkTest, BufferAndResourceUses) {
   EXPECT_EQ(thunk->resource_uses()[1], ResourceUse::Write(produce_token));
 }
 
+TEST(OutfeedThunkTest, OutfeedCallback) {
+  Literal src = LiteralUtil::CreateR1<float>({1.0, 2.0, 3.0, 4.0});
+
+  BufferAllocations allocations = CreateBufferAllocations(src);
+  BufferAllocation alloc = CreateBufferAllocation(0, src);
+  BufferAllocation::Slice slice = CreateBufferAllocationSlice(alloc);
+
+  OutfeedThunk::OutfeedBuffer outfeed_buffer = {slice, src.shape()};
+  auto consume_token = Resource::Create(Resource::kToken);
+  auto produce_token = Resource::Create(Resource::kToken);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto thunk,
+                          OutfeedThunk::Create({"outfeed"}, {outfeed_buffer},
+                                               {consume_token, produce_token}));
+
+  // Outfeed data goes straight to the callback, no buffers are enqueued into
+  // the outfeed queue.
+  std::vector<float> outfed;
+  runtime::XfeedManager xfeed;
+  xfeed.set_outfeed_callback(
+      [&](absl::Span<const runtime::OutfeedData> data) {
+        ASSERT_EQ(data.size(), 1);
+        EXPECT_EQ(*data[0].shape, src.shape());
+        outfed.resize(data[0].data.size() / sizeof(float));
+        std::memcpy(outfed.data(), data[0].data.data(), data[0].data.size());
+      });
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.xfeed = &xfeed;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  EXPECT_EQ(outfed, std::vector<float>({1.0, 2.0, 3.0, 4.0}));
+}
+
 }  // namespace
 }  // namespace xla::cpu
@@ -0,0 +1,96 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/packed_matmul.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace xla::cpu {
+
+static constexpr int64_t kPanelSize = PackedMatrix::kPanelSize;
+
+PackedMatrix PackedMatrix::Pack(const float* w, int64_t rows, int64_t k,
+                                int64_t row_stride, int64_t k_stride) {
+  int64_t num_panels = (rows + kPanelSize - 1) / kPanelSize;
+  std::vector<float> data(num_panels * k * kPanelSize, 0.0f);
+
+  for (int64_t p = 0; p < num_panels; ++p) {
+    float* panel = data.data() + p * k * kPanelSize;
+    int64_t row_begin = p * kPanelSize;
+    int64_t num_rows = std::min(kPanelSize, rows - row_begin);
+
+    for (int64_t r = 0; r < num_rows; ++r) {
+      const float* row = w + (row_begin + r) * row_stride;
+      for (int64_t kk = 0; kk < k; ++kk) {
+        panel[kk * kPanelSize + r] = row[kk * k_stride];
+      }
+    }
+  }
+
+  return PackedMatrix(rows, k, std::move(data));
+}
+
+// Computes a `kPanelSize x kCols` block of the output. Inner loop over the
+// panel rows is a fixed size contiguous loop that compiler vectorizes.
+template <int64_t kCols>
+static void PackedMicroKernel(const float* panel, int64_t k, const float* x,
+                              float* out, int64_t num_rows,
+                              const PackedMatMulStrides& strides) {
+  float acc[kCols][kPanelSize] = {};
+
+  for (int64_t kk = 0; kk < k; ++kk) {
+    const float* w = panel + kk * kPanelSize;
+    for (int64_t c = 0; c < kCols; ++c) {
+      float xv = x[kk * strides.x_k_stride + c * strides.x_col_stride];
+      for (int64_t r = 0; r < kPanelSize; ++r) {
+        acc[c][r] += w[r] * xv;
+      }
+    }
+  }
+
+  for (int64_t c = 0; c < kCols; ++c) {
+    for (int64_t r = 0; r < num_rows; ++r) {
+      out[r * strides.out_row_stride + c * strides.out_col_stride] = acc[c][r];
+    }
+  }
+}
+
+void PackedMatMul(const PackedMatrix& w, const float* x, float* out,
+                  int64_t cols, const PackedMatMulStrides& strides,
+                  int64_t panel_begin, int64_t panel_end) {
+  for (int64_t p = panel_begin; p < panel_end; ++p) {
+    const float* panel = w.panel(p);
+    int64_t row_begin = p * kPanelSize;
+    int64_t num_rows = std::min(kPanelSize, w.rows() - row_begin);
+    float* out_panel = out + row_begin * strides.out_row_stride;
+
+    // Process columns in blocks of 4 to reuse loaded panel elements.
+    int64_t j = 0;
+    for (; j + 4 <= cols; j += 4) {
+      PackedMicroKernel<4>(panel, w.k(), x + j * strides.x_col_stride,
+                           out_panel + j * strides.out_col_stride, num_rows,
+                           strides);
+    }
+    for (; j < cols; ++j) {
+      PackedMicroKernel<1>(panel, w.k(), x + j * strides.x_col_stride,
+                           out_panel + j * strides.out_col_stride, num_rows,
+                           strides);
+    }
+  }
+}
+
+}  // namespace xla::cpu
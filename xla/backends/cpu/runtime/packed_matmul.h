@@ -0,0 +1,78 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_PACKED_MATMUL_H_
+#define XLA_BACKENDS_CPU_RUNTIME_PACKED_MATMUL_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace xla::cpu {
+
+// A `rows x k` F32 matrix packed into a cache-blocked layout: rows are split
+// into panels of `kPanelSize` rows, and in each panel elements are stored in
+// `[k][kPanelSize]` order. With this layout a matmul kernel reads the packed
+// matrix sequentially, and computes `kPanelSize` outputs with a single vector
+// FMA per element of the other operand.
+//
+// Packing is as expensive as a matrix-vector product, and it pays off when
+// the same matrix (i.e. constant weights) is multiplied many times, as the
+// packed copy can be reused across executions.
+class PackedMatrix {
+ public:
+  static constexpr int64_t kPanelSize = 8;
+
+  // Packs matrix `w` with element `(i, kk)` at `w[i * row_stride + kk *
+  // k_stride]`. Rows in the last panel are padded with zeros.
+  static PackedMatrix Pack(const float* w, int64_t rows, int64_t k,
+                           int64_t row_stride, int64_t k_stride);
+
+  int64_t rows() const { return rows_; }
+  int64_t k() const { return k_; }
+  int64_t num_panels() const { return (rows_ + kPanelSize - 1) / kPanelSize; }
+
+  const float* panel(int64_t index) const {
+    return data_.data() + index * k_ * kPanelSize;
+  }
+
+ private:
+  PackedMatrix(int64_t rows, int64_t k, std::vector<float> data)
+      : rows_(rows), k_(k), data_(std::move(data)) {}
+
+  int64_t rows_;
+  int64_t k_;
+  std::vector<float> data_;
+};
+
+// Strides of a matrix operand of the packed matmul: element `(kk, j)` of the
+// `x` operand is at `x[kk * k_stride + j * col_stride]`, and element `(i, j)`
+// of the output is at `out[i * row_stride + j * col_stride]`.
+struct PackedMatMulStrides {
+  int64_t x_k_stride;
+  int64_t x_col_stride;
+  int64_t out_row_stride;
+  int64_t out_col_stride;
+};
+
+// Computes `out(i, j) = sum_kk w(i, kk) * x(kk, j)` for `j` in `[0, cols)` and
+// rows `i` of the packed matrix in panels `[panel_begin, panel_end)`.
+void PackedMatMul(const PackedMatrix& w, const float* x, float* out,
+                  int64_t cols, const PackedMatMulStrides& strides,
+                  int64_t panel_begin, int64_t panel_end);
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_PACKED_MATMUL_H_
@@ -0,0 +1,119 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/packed_matmul.h"
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/test_benchmark.h"
+
+namespace xla::cpu {
+namespace {
+
+TEST(PackedMatMulTest, Pack) {
+  // Row-major 3x2 matrix.
+  std::vector<float> w = {1, 2, 3, 4, 5, 6};
+  PackedMatrix packed = PackedMatrix::Pack(w.data(), /*rows=*/3, /*k=*/2,
+                                           /*row_stride=*/2, /*k_stride=*/1);
+
+  ASSERT_EQ(packed.num_panels(), 1);
+  const float* panel = packed.panel(0);
+
+  // Elements are stored in [k][kPanelSize] order padded with zeros.
+  EXPECT_EQ(panel[0], 1);
+  EXPECT_EQ(panel[1], 3);
+  EXPECT_EQ(panel[2], 5);
+  EXPECT_EQ(panel[3], 0);
+  EXPECT_EQ(panel[PackedMatrix::kPanelSize + 0], 2);
+  EXPECT_EQ(panel[PackedMatrix::kPanelSize + 1], 4);
+  EXPECT_EQ(panel[PackedMatrix::kPanelSize + 2], 6);
+}
+
+TEST(PackedMatMulTest, MatMul) {
+  std::minstd_rand0 engine;
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+  for (int64_t rows : {1, 7, 8, 17}) {
+    for (int64_t cols : {1, 4, 5, 9}) {
+      for (int64_t k : {1, 3, 64}) {
+        // Row-major `w` and `x` matrices, and column-major output.
+        std::vector<float> w(rows * k), x(k * cols);
+        for (float& v : w) v = distribution(engine);
+        for (float& v : x) v = distribution(engine);
+
+        std::vector<float> expected(rows * cols, 0.0f);
+        for (int64_t i = 0; i < rows; ++i) {
+          for (int64_t j = 0; j < cols; ++j) {
+            for (int64_t kk = 0; kk < k; ++kk) {
+              expected[i + j * rows] += w[i * k + kk] * x[kk * cols + j];
+            }
+          }
+        }
+
+        PackedMatrix packed = PackedMatrix::Pack(w.data(), rows, k,
+                                                 /*row_stride=*/k,
+                                                 /*k_stride=*/1);
+
+        std::vector<float> out(rows * cols);
+        PackedMatMulStrides strides = {/*x_k_stride=*/cols,
+                                       /*x_col_stride=*/1,
+                                       /*out_row_stride=*/1,
+                                       /*out_col_stride=*/rows};
+        PackedMatMul(packed, x.data(), out.data(), cols, strides, 0,
+                     packed.num_panels());
+
+        for (int64_t i = 0; i < rows * cols; ++i) {
+          EXPECT_NEAR(out[i], expected[i], 1e-4)
+              << "rows=" << rows << " cols=" << cols << " k=" << k;
+        }
+      }
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Performance benchmarks.
+//===----------------------------------------------------------------------===//
+
+static void BM_PackedMatMul(benchmark::State& state) {
+  int64_t rows = state.range(0);
+  int64_t cols = state.range(1);
+  int64_t k = state.range(2);
+
+  std::vector<float> w(rows * k, 1.0f), x(k * cols, 1.0f), out(rows * cols);
+  PackedMatrix packed = PackedMatrix::Pack(w.data(), rows, k, k, 1);
+  PackedMatMulStrides strides = {cols, 1, 1, rows};
+
+  for (auto _ : state) {
+    PackedMatMul(packed, x.data(), out.data(), cols, strides, 0,
+                 packed.num_panels());
+    benchmark::DoNotOptimize(out);
+  }
+
+  state.SetItemsProcessed(state.iterations() * rows * cols * k);
+}
+
+BENCHMARK(BM_PackedMatMul)
+    ->ArgNames({"rows", "cols", "k"})
+    ->Args({256, 1, 256})
+    ->Args({1024, 1, 1024})
+    ->Args({1024, 4, 1024})
+    ->Args({1024, 16, 1024});
+
+}  // namespace
+}  // namespace xla::cpu
@@ -21,11 +21,14 @@ limitations under the License.
 #include <cstdint>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <utility>
 
 #include "absl/base/attributes.h"
 #include "absl/base/optimization.h"
 #include "absl/log/check.h"
+#include "absl/time/clock.h"
+#include "xla/backends/cpu/runtime/tile_size_tuner.h"
 #include "xla/backends/cpu/runtime/work_queue.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/concurrency/chain.h"
@@ -44,16 +47,14 @@ using Task = std::function<void(size_t task_index)>;
 // Returned async value is a per-process singleton stored in a storage with a
 // static duration, and can be safely compared using pointer equality.
 static tsl::AsyncValueRef<tsl::Chain> OkDoneEventSingleton() {
-  static tsl::AsyncValueOwningRef<tsl::Chain>* singleton = [] {
-    auto* storage = new tsl::internal::AsyncValueStorage<tsl::Chain>();
-    return new tsl::AsyncValueOwningRef<tsl::Chain>(
-        tsl::MakeAvailableAsyncValueRef<tsl::Chain>(*storage));
-  }();
-  return singleton->AsRef();
+  return tsl::GetAvailableAsyncValueRefSingleton<tsl::Chain>();
 }
 
-ParallelLoopRunner::ParallelLoopRunner(const Eigen::ThreadPoolDevice* device)
-    : done_event_(OkDoneEventSingleton()), device_(device) {}
+ParallelLoopRunner::ParallelLoopRunner(const Eigen::ThreadPoolDevice* device,
+                                       size_t num_numa_nodes)
+    : done_event_(OkDoneEventSingleton()),
+      device_(device),
+      num_numa_nodes_(std::max<size_t>(num_numa_nodes, 1)) {}
 
 tsl::AsyncValueRef<tsl::Chain> ParallelLoopRunner::ResetDoneEvent() {
   auto done_event = std::move(done_event_);
@@ -101,7 +102,7 @@ ABSL_ATTRIBUTE_ALWAYS_INLINE void ParallelLoopRunner::ScheduleAll(
                       parallel_task =
                           std::forward<ParallelTask>(parallel_task)] {
     Worker::Parallelize(device_, std::move(count_down), num_tasks,
-                        std::move(parallel_task));
+                        std::move(parallel_task), num_numa_nodes_);
   };
 
   done_event_.AndThen(std::move(parallelize));
@@ -205,12 +206,45 @@ static Task3DTile2DIndex Delinearize(size_t task_index, size_t range_i,
 
 // XNNPACK tends to choose too small tile sizes that create too many tasks. For
 // dynamic versions of parallel loops we can choose tile size to be any multiple
-// of the original tile size. This function ensures that the tile size is at
-// least `min_tile_size`.
+// of the original tile size. If tile size tuner is not set, we ensure that the
+// tile size is at least `kMinDynamicTileSize`.
+static constexpr size_t kMinDynamicTileSize = 128;
+
 static size_t AdjustTileSize(size_t tile_size, size_t min_tile_size) {
-  size_t adjusted_tile_size = tile_size;
-  while (adjusted_tile_size < min_tile_size) adjusted_tile_size += tile_size;
-  return adjusted_tile_size;
+  return TileSizeTuner::AdjustTileSize(tile_size, min_tile_size);
+}
+
+struct ParallelLoopRunner::LoopTimer {
+  // Records the loop start time when the first loop task starts execution.
+  ABSL_ATTRIBUTE_ALWAYS_INLINE void Start() {
+    if (ABSL_PREDICT_TRUE(start_ns.load(std::memory_order_relaxed))) return;
+    int64_t expected = 0;
+    start_ns.compare_exchange_strong(expected, absl::GetCurrentTimeNanos(),
+                                     std::memory_order_relaxed);
+  }
+
+  std::atomic<int64_t> start_ns = 0;
+};
+
+std::pair<size_t, std::shared_ptr<ParallelLoopRunner::LoopTimer>>
+ParallelLoopRunner::GetDynamicTileSize(const TileSizeTuner::Loop& loop) {
+  if (ABSL_PREDICT_TRUE(tile_size_tuner_ == nullptr || loop.kernel == nullptr)) {
+    return {AdjustTileSize(loop.tile_j, kMinDynamicTileSize), nullptr};
+  }
+
+  auto [tile_j, measure] = tile_size_tuner_->GetTileSize(loop);
+  return {tile_j, measure ? std::make_shared<LoopTimer>() : nullptr};
+}
+
+void ParallelLoopRunner::RecordLoopDuration(const TileSizeTuner::Loop& loop,
+                                            size_t tile_j,
+                                            std::shared_ptr<LoopTimer> timer) {
+  done_event_.AndThen(
+      [tuner = tile_size_tuner_, loop, tile_j, timer = std::move(timer)] {
+        int64_t start_ns = timer->start_ns.load(std::memory_order_relaxed);
+        tuner->RecordDuration(loop, tile_j,
+                              absl::GetCurrentTimeNanos() - start_ns);
+      });
 }
 
 // In the `Parallelize` implementations below:
@@ -289,8 +323,22 @@ void ParallelLoopRunner::Parallelize(size_t range, size_t tile,
 }
 
 void ParallelLoopRunner::ParallelizeDynamic(size_t range, size_t tile,
-                                            Task1DTile1DDynamic task) {
-  Parallelize(range, AdjustTileSize(tile, 128), std::move(task));
+                                            Task1DTile1DDynamic task,
+                                            const void* kernel) {
+  TileSizeTuner::Loop loop = {kernel, 1, range, tile};
+  auto [tile_size, timer] = GetDynamicTileSize(loop);
+
+  if (ABSL_PREDICT_TRUE(timer == nullptr)) {
+    Parallelize(range, tile_size, std::move(task));
+    return;
+  }
+
+  Parallelize(range, tile_size,
+              [timer, task = std::move(task)](size_t offset, size_t count) {
+                timer->Start();
+                task(offset, count);
+              });
+  RecordLoopDuration(loop, tile_size, std::move(timer));
 }
 
 struct ParallelLoopRunner::ParallelTask2DTile1D {
@@ -329,8 +377,23 @@ void ParallelLoopRunner::Parallelize(size_t range_i, size_t range_j,
 
 void ParallelLoopRunner::ParallelizeDynamic(size_t range_i, size_t range_j,
                                             size_t tile_j,
-                                            Task2DTile1DDynamic task) {
-  Parallelize(range_i, range_j, AdjustTileSize(tile_j, 128), std::move(task));
+                                            Task2DTile1DDynamic task,
+                                            const void* kernel) {
+  TileSizeTuner::Loop loop = {kernel, range_i, range_j, tile_j};
+  auto [tile_size, timer] = GetDynamicTileSize(loop);
+
+  if (ABSL_PREDICT_TRUE(timer == nullptr)) {
+    Parallelize(range_i, range_j, tile_size, std::move(task));
+    return;
+  }
+
+  Parallelize(range_i, range_j, tile_size,
+              [timer, task = std::move(task)](size_t offset_i, size_t offset_j,
+                                              size_t count_j) {
+                timer->Start();
+                task(offset_i, offset_j, count_j);
+              });
+  RecordLoopDuration(loop, tile_size, std::move(timer));
 }
 
 struct ParallelLoopRunner::ParallelTask3DTile2D {
@@ -375,9 +438,31 @@ void ParallelLoopRunner::Parallelize(size_t range_i, size_t range_j,
 void ParallelLoopRunner::ParallelizeDynamic(size_t range_i, size_t range_j,
                                             size_t range_k, size_t tile_j,
                                             size_t tile_k,
-                                            Task3DTile2DDynamic task) {
-  Parallelize(range_i, range_j, range_k, AdjustTileSize(tile_j, 128),
-              AdjustTileSize(tile_k, 128), std::move(task));
+                                            Task3DTile2DDynamic task,
+                                            const void* kernel) {
+  size_t adjusted_tile_j = AdjustTileSize(tile_j, kMinDynamicTileSize);
+
+  // We tune only the innermost tile size, and treat `i` and `j` dimensions as
+  // a single outer dimension of the tuned loop.
+  TileSizeTuner::Loop loop = {
+      kernel, range_i * tsl::MathUtil::CeilOfRatio(range_j, adjusted_tile_j),
+      range_k, tile_k};
+  auto [tile_size, timer] = GetDynamicTileSize(loop);
+
+  if (ABSL_PREDICT_TRUE(timer == nullptr)) {
+    Parallelize(range_i, range_j, range_k, adjusted_tile_j, tile_size,
+                std::move(task));
+    return;
+  }
+
+  Parallelize(range_i, range_j, range_k, adjusted_tile_j, tile_size,
+              [timer, task = std::move(task)](size_t offset_i, size_t offset_j,
+                                              size_t offset_k, size_t count_j,
+                                              size_t count_k) {
+                timer->Start();
+                task(offset_i, offset_j, offset_k, count_j, count_k);
+              });
+  RecordLoopDuration(loop, tile_size, std::move(timer));
 }
 
 }  // namespace xla::cpu
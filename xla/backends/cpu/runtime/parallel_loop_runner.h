@@ -19,7 +19,10 @@ limitations under the License.
 #include <atomic>
 #include <cstddef>
 #include <functional>
+#include <memory>
+#include <utility>
 
+#include "xla/backends/cpu/runtime/tile_size_tuner.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/concurrency/chain.h"
 
@@ -53,11 +56,17 @@ namespace xla::cpu {
 // scheduling too many workers into the thread pool, because for tiny tasks the
 // overheads can be prohibitively expensive.
 //
+// Parallel loop runner can optionally partition parallel loops across
+// `num_numa_nodes` NUMA nodes: each node gets a contiguous range of tasks, and
+// workers steal tasks within their own node before going to the other nodes
+// (see WorkQueue for details).
+//
 // WARNING: ParallelLoopRunner is not thread-safe, and must be externally
 // synchronized by the user.
 class ParallelLoopRunner {
  public:
-  explicit ParallelLoopRunner(const Eigen::ThreadPoolDevice* device);
+  explicit ParallelLoopRunner(const Eigen::ThreadPoolDevice* device,
+                              size_t num_numa_nodes = 1);
 
   // Takes ownership of the runner and returns a done event. After the done
   // event is transferred to the caller, it is illegal to schedule more parallel
@@ -84,8 +93,9 @@ class ParallelLoopRunner {
 
   // IMPORTANT: For `dynamic` versions of the parallel loops, the runner is free
   // to adjust `count` for tiled dimensions to minimize the number of launched
-  // tasks. Today we don't take advantage of this feature, and always launch the
-  // same number of tasks as in regular parallel loops.
+  // tasks. By default we use a fixed minimum tile size, and if the tile size
+  // tuner is set, we learn the tile size for each `kernel` and loop dimensions
+  // from the measured loop execution times.
 
   // This function implements a parallel version of a following loop:
   //
@@ -100,7 +110,8 @@ class ParallelLoopRunner {
   void Parallelize(size_t range, size_t tile, Task1DTile1D task);
 
   // Implements a parallel version of 1D loop with dynamic task count.
-  void ParallelizeDynamic(size_t range, size_t tile, Task1DTile1DDynamic task);
+  void ParallelizeDynamic(size_t range, size_t tile, Task1DTile1DDynamic task,
+                          const void* kernel = nullptr);
 
   // This function implements a parallel version of a following loop:
   //
@@ -112,7 +123,8 @@ class ParallelLoopRunner {
 
   // Implements a parallel version of 2D loop with dynamic task count.
   void ParallelizeDynamic(size_t range_i, size_t range_j, size_t tile_j,
-                          Task2DTile1DDynamic task);
+                          Task2DTile1DDynamic task,
+                          const void* kernel = nullptr);
 
   // This function implements a parallel version of a following loop:
   //
@@ -126,7 +138,8 @@ class ParallelLoopRunner {
   // Implements a parallel version of 3D loop with dynamic task count.
   void ParallelizeDynamic(size_t range_i, size_t range_j, size_t range_k,
                           size_t tile_j, size_t tile_k,
-                          Task3DTile2DDynamic task);
+                          Task3DTile2DDynamic task,
+                          const void* kernel = nullptr);
 
   // Resets the parallel loop runner `done_event` and returns the previous one
   // to the caller.
@@ -143,6 +156,13 @@ class ParallelLoopRunner {
   // Returns true if the current thread belongs to the underlying thread pool.
   bool is_in_runner() const;
 
+  size_t num_numa_nodes() const { return num_numa_nodes_; }
+
+  // Sets a tile size tuner for dynamic parallel loops. Tuner must outlive the
+  // parallel loop runner and all scheduled parallel loops.
+  void set_tile_size_tuner(TileSizeTuner* tuner) { tile_size_tuner_ = tuner; }
+  TileSizeTuner* tile_size_tuner() const { return tile_size_tuner_; }
+
  private:
   // Forward declarations of the parallel tasks.
   struct ParallelTask1D;
@@ -150,6 +170,20 @@ class ParallelLoopRunner {
   struct ParallelTask2DTile1D;
   struct ParallelTask3DTile2D;
 
+  // A timer to measure dynamic parallel loop execution time.
+  struct LoopTimer;
+
+  // Returns the tile size for the dynamic parallel loop, and if the tile size
+  // tuner requested a measurement, a timer that must be started by the loop
+  // tasks and passed to `RecordLoopDuration`.
+  std::pair<size_t, std::shared_ptr<LoopTimer>> GetDynamicTileSize(
+      const TileSizeTuner::Loop& loop);
+
+  // Records the loop execution time in the tile size tuner when all scheduled
+  // parallel loops are completed.
+  void RecordLoopDuration(const TileSizeTuner::Loop& loop, size_t tile_j,
+                          std::shared_ptr<LoopTimer> timer);
+
   // Schedules `task` as the AndThen callback of the `done_event_`. Updates
   // `done_event_` to the new completion event.
   template <typename Task>
@@ -173,6 +207,12 @@ class ParallelLoopRunner {
   // pools for different NUMA nodes, and we have to be able to switch between
   // them from run to run.
   std::atomic<const Eigen::ThreadPoolDevice*> device_;
+
+  // Number of NUMA nodes to partition parallel loops across.
+  size_t num_numa_nodes_;
+
+  // Optional tile size tuner for dynamic parallel loops.
+  TileSizeTuner* tile_size_tuner_ = nullptr;
 };
 
 }  // namespace xla::cpu
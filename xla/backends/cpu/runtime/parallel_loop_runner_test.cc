@@ -58,6 +58,27 @@ TEST(ParallelLoopRunnerTest, Parallelize1D) {
                              [](int32_t value) { return value == 5; }));
 }
 
+TEST(ParallelLoopRunnerTest, Parallelize1DNumaNodes) {
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+  ParallelLoopRunner runner(&device, /*num_numa_nodes=*/2);
+
+  constexpr int32_t d0 = 128;
+
+  auto* data = new int32_t[d0]();
+  auto cleanup = absl::Cleanup([&]() { delete[] data; });
+
+  auto increment = [&](size_t offset) { data[offset] += 1; };
+
+  runner.Parallelize(d0, increment);
+  runner.Parallelize(d0, increment);
+
+  tsl::BlockUntilReady(ParallelLoopRunner::TakeDoneEvent(std::move(runner)));
+  ASSERT_TRUE(absl::c_all_of(absl::MakeSpan(&data[0], d0),
+                             [](int32_t value) { return value == 2; }));
+}
+
 TEST(ParallelLoopRunnerTest, Parallelize1DTile1D) {
   tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
   Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
@@ -0,0 +1,122 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/perf_counters.h"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif  // __linux__
+
+#include "absl/log/log.h"
+
+namespace xla::cpu {
+
+#if defined(__linux__)
+
+static int OpenPerfEvent(uint64_t config, int group_fd) {
+  perf_event_attr attr;
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = group_fd == -1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+
+  return syscall(SYS_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, group_fd,
+                 /*flags=*/0);
+}
+
+std::optional<PerfCounters> PerfCounters::Open() {
+  static constexpr std::array<uint64_t, kNumCounters> kConfigs = {
+      PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_MISSES};
+
+  std::array<int, kNumCounters> fds;
+  fds.fill(-1);
+
+  for (int i = 0; i < kNumCounters; ++i) {
+    fds[i] = OpenPerfEvent(kConfigs[i], /*group_fd=*/i == 0 ? -1 : fds[0]);
+    if (fds[i] < 0) {
+      VLOG(1) << "Failed to open perf event " << kConfigs[i] << ": "
+              << std::strerror(errno);
+      for (int j = 0; j < i; ++j) close(fds[j]);
+      return std::nullopt;
+    }
+  }
+
+  ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+  return PerfCounters(fds);
+}
+
+PerfCounters::~PerfCounters() {
+  for (int fd : fds_) {
+    if (fd >= 0) close(fd);
+  }
+}
+
+std::optional<PerfCounters::Sample> PerfCounters::Read() const {
+  // With PERF_FORMAT_GROUP the kernel returns the number of counters followed
+  // by counter values in the order they were added to the group.
+  struct {
+    uint64_t num_counters;
+    uint64_t values[kNumCounters];
+  } data;
+
+  if (read(fds_[0], &data, sizeof(data)) != sizeof(data) ||
+      data.num_counters != kNumCounters) {
+    return std::nullopt;
+  }
+
+  return Sample{data.values[kCycles], data.values[kInstructions],
+                data.values[kCacheMisses]};
+}
+
+#else  // __linux__
+
+std::optional<PerfCounters> PerfCounters::Open() { return std::nullopt; }
+
+PerfCounters::~PerfCounters() = default;
+
+std::optional<PerfCounters::Sample> PerfCounters::Read() const {
+  return std::nullopt;
+}
+
+#endif  // __linux__
+
+PerfCounters::PerfCounters(PerfCounters&& other) : fds_(other.fds_) {
+  other.fds_.fill(-1);
+}
+
+PerfCounters* PerfCounters::ThreadLocal() {
+  thread_local std::optional<PerfCounters> counters = Open();
+  return counters.has_value() ? &*counters : nullptr;
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,72 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_PERF_COUNTERS_H_
+#define XLA_BACKENDS_CPU_RUNTIME_PERF_COUNTERS_H_
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+namespace xla::cpu {
+
+// Hardware performance counters of the calling thread. On Linux counters are
+// backed by `perf_event_open`, and on other platforms (or if the kernel does
+// not allow user space to open perf events) counters are not available.
+//
+// ThunkExecutor uses per-thread counters to attribute CPU cycles and cache
+// misses to thunks that complete synchronously in the caller thread.
+class PerfCounters {
+ public:
+  struct Sample {
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t cache_misses = 0;
+
+    Sample operator-(const Sample& other) const {
+      return Sample{cycles - other.cycles, instructions - other.instructions,
+                    cache_misses - other.cache_misses};
+    }
+  };
+
+  // Returns counters for the calling thread, or nullptr if hardware counters
+  // are not available. Counters are opened lazily on the first call from each
+  // thread, and are closed when the thread exits.
+  static PerfCounters* ThreadLocal();
+
+  ~PerfCounters();
+
+  PerfCounters(PerfCounters&& other);
+  PerfCounters& operator=(PerfCounters&&) = delete;
+
+  // Reads current counter values. Returns std::nullopt if read failed.
+  std::optional<Sample> Read() const;
+
+ private:
+  enum Counter { kCycles = 0, kInstructions = 1, kCacheMisses = 2 };
+  static constexpr int kNumCounters = 3;
+
+  explicit PerfCounters(std::array<int, kNumCounters> fds) : fds_(fds) {}
+
+  static std::optional<PerfCounters> Open();
+
+  // File descriptors of the opened perf events. The first one is the group
+  // leader, and all counters are read together with a single syscall.
+  std::array<int, kNumCounters> fds_;
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_PERF_COUNTERS_H_
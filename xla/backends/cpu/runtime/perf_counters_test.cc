@@ -0,0 +1,50 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/perf_counters.h"
+
+#include <cstdint>
+#include <optional>
+
+#include "xla/tsl/platform/test.h"
+
+namespace xla::cpu {
+namespace {
+
+TEST(PerfCountersTest, ReadCounters) {
+  PerfCounters* counters = PerfCounters::ThreadLocal();
+  if (counters == nullptr) {
+    GTEST_SKIP() << "Hardware performance counters are not available";
+  }
+
+  // Counters must be cached per thread.
+  EXPECT_EQ(counters, PerfCounters::ThreadLocal());
+
+  std::optional<PerfCounters::Sample> start = counters->Read();
+  ASSERT_TRUE(start.has_value());
+
+  volatile int64_t sum = 0;
+  for (int64_t i = 0; i < 1000000; ++i) sum = sum + i;
+
+  std::optional<PerfCounters::Sample> end = counters->Read();
+  ASSERT_TRUE(end.has_value());
+
+  PerfCounters::Sample delta = *end - *start;
+  EXPECT_GT(delta.cycles, 0);
+  EXPECT_GT(delta.instructions, 1000000);
+}
+
+}  // namespace
+}  // namespace xla::cpu
@@ -0,0 +1,138 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/quantized_matmul.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+namespace {
+
+// Dequantizes S8 weights.
+struct S8Weights {
+  float operator[](int64_t index) const { return data[index]; }
+  const int8_t* data;
+};
+
+// Dequantizes S4 weights packed two elements per byte.
+struct S4Weights {
+  float operator[](int64_t index) const {
+    uint8_t byte = data[index >> 1];
+    uint8_t nibble = (index & 1) ? (byte >> 4) : (byte & 0xF);
+    // Sign-extend 4-bit value to 8 bits.
+    return static_cast<int8_t>(nibble << 4) >> 4;
+  }
+  const uint8_t* data;
+};
+
+}  // namespace
+
+// Number of weight rows we compute together when rows are not contiguous in
+// the `k` dimension. Each weight element is dequantized once into a temporary
+// buffer and reused for all columns.
+static constexpr int64_t kRowBlock = 32;
+
+// Weight rows are contiguous in the `k` dimension: computes each output as a
+// dot product of the weight row and the `x` column.
+template <typename Weights>
+static void DotProductMatMul(Weights w, const float* x, float* out, int64_t k,
+                             int64_t cols, const QuantizedMatMulStrides& s,
+                             int64_t row_begin, int64_t row_end) {
+  for (int64_t i = row_begin; i < row_end; ++i) {
+    int64_t row = i * s.w_row_stride;
+    for (int64_t j = 0; j < cols; ++j) {
+      const float* x_col = x + j * s.x_col_stride;
+      float acc = 0.0f;
+      for (int64_t kk = 0; kk < k; ++kk) {
+        acc += w[row + kk] * x_col[kk * s.x_k_stride];
+      }
+      out[i * s.out_row_stride + j * s.out_col_stride] = acc;
+    }
+  }
+}
+
+// Weight rows are strided in the `k` dimension: accumulates outer products of
+// dequantized weight columns and `x` rows into a block of outputs.
+template <typename Weights>
+static void OuterProductMatMul(Weights w, const float* x, float* out,
+                               int64_t k, int64_t cols,
+                               const QuantizedMatMulStrides& s,
+                               int64_t row_begin, int64_t row_end) {
+  std::vector<float> acc(kRowBlock * cols);
+  float dequantized[kRowBlock];
+
+  for (int64_t rb = row_begin; rb < row_end; rb += kRowBlock) {
+    int64_t num_rows = std::min(kRowBlock, row_end - rb);
+    std::fill(acc.begin(), acc.end(), 0.0f);
+
+    for (int64_t kk = 0; kk < k; ++kk) {
+      int64_t offset = rb * s.w_row_stride + kk * s.w_k_stride;
+      for (int64_t r = 0; r < num_rows; ++r) {
+        dequantized[r] = w[offset + r * s.w_row_stride];
+      }
+
+      for (int64_t j = 0; j < cols; ++j) {
+        float xv = x[kk * s.x_k_stride + j * s.x_col_stride];
+        float* acc_col = acc.data() + j * kRowBlock;
+        for (int64_t r = 0; r < num_rows; ++r) {
+          acc_col[r] += dequantized[r] * xv;
+        }
+      }
+    }
+
+    for (int64_t j = 0; j < cols; ++j) {
+      for (int64_t r = 0; r < num_rows; ++r) {
+        out[(rb + r) * s.out_row_stride + j * s.out_col_stride] =
+            acc[j * kRowBlock + r];
+      }
+    }
+  }
+}
+
+template <typename Weights>
+static void TypedQuantizedMatMul(Weights w, const float* x, float* out,
+                                 int64_t k, int64_t cols,
+                                 const QuantizedMatMulStrides& strides,
+                                 int64_t row_begin, int64_t row_end) {
+  if (strides.w_k_stride == 1) {
+    DotProductMatMul(w, x, out, k, cols, strides, row_begin, row_end);
+  } else {
+    OuterProductMatMul(w, x, out, k, cols, strides, row_begin, row_end);
+  }
+}
+
+void QuantizedMatMul(PrimitiveType w_type, const void* w, const float* x,
+                     float* out, int64_t k, int64_t cols,
+                     const QuantizedMatMulStrides& strides, int64_t row_begin,
+                     int64_t row_end) {
+  switch (w_type) {
+    case S8:
+      return TypedQuantizedMatMul(S8Weights{static_cast<const int8_t*>(w)}, x,
+                                  out, k, cols, strides, row_begin, row_end);
+    case S4:
+      return TypedQuantizedMatMul(S4Weights{static_cast<const uint8_t*>(w)},
+                                  x, out, k, cols, strides, row_begin, row_end);
+    default:
+      LOG(FATAL) << "Unsupported quantized matmul weight type: "
+                 << PrimitiveType_Name(w_type);
+  }
+}
+
+}  // namespace xla::cpu
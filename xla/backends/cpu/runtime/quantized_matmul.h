@@ -0,0 +1,61 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_QUANTIZED_MATMUL_H_
+#define XLA_BACKENDS_CPU_RUNTIME_QUANTIZED_MATMUL_H_
+
+#include <cstdint>
+
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+
+// Strides (in elements) of the weight-only quantized matmul operands: element
+// `(i, kk)` of the `w` operand is at `w[i * w_row_stride + kk * w_k_stride]`,
+// element `(kk, j)` of the `x` operand is at `x[kk * x_k_stride + j *
+// x_col_stride]`, and element `(i, j)` of the output is at `out[i *
+// out_row_stride + j * out_col_stride]`.
+struct QuantizedMatMulStrides {
+  int64_t w_row_stride;
+  int64_t w_k_stride;
+  int64_t x_k_stride;
+  int64_t x_col_stride;
+  int64_t out_row_stride;
+  int64_t out_col_stride;
+};
+
+// Returns true if `type` is a supported type of quantized matmul weights.
+inline bool IsQuantizedMatMulWeightType(PrimitiveType type) {
+  return type == S8 || type == S4;
+}
+
+// Computes `out(i, j) = sum_kk w(i, kk) * x(kk, j)` for F32 `x` and `out`, and
+// `w` quantized to S8 or S4 integers, for `j` in `[0, cols)` and rows `i` in
+// `[row_begin, row_end)`. S4 weights are packed two elements per byte, with
+// the first element in the low-order bits (XLA sub-byte packing).
+//
+// Weights are dequantized to F32 in the inner loop, which streams a quarter
+// (S8) or an eighth (S4) of the bytes of the F32 weights from memory. This is
+// the bottleneck of small batch (i.e. LLM decode) matmuls, where every weight
+// is used only a few times. Scales of the quantized weights are not part of
+// the kernel: per-channel (output row) scales are applied to the result.
+void QuantizedMatMul(PrimitiveType w_type, const void* w, const float* x,
+                     float* out, int64_t k, int64_t cols,
+                     const QuantizedMatMulStrides& strides, int64_t row_begin,
+                     int64_t row_end);
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_QUANTIZED_MATMUL_H_
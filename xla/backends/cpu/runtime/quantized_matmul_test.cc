@@ -0,0 +1,141 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/quantized_matmul.h"
+
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/test_benchmark.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::cpu {
+namespace {
+
+// Packs S4 values two per byte with the first element in the low-order bits.
+static std::vector<uint8_t> PackS4(const std::vector<int8_t>& values) {
+  std::vector<uint8_t> packed((values.size() + 1) / 2, 0);
+  for (int64_t i = 0; i < values.size(); ++i) {
+    packed[i / 2] |= (values[i] & 0xF) << (4 * (i % 2));
+  }
+  return packed;
+}
+
+class QuantizedMatMulTest
+    : public ::testing::TestWithParam<std::tuple<PrimitiveType, bool>> {};
+
+TEST_P(QuantizedMatMulTest, MatMul) {
+  auto [w_type, k_contiguous] = GetParam();
+
+  std::minstd_rand0 engine;
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  int8_t limit = w_type == S4 ? 7 : 127;
+  std::uniform_int_distribution<int> w_distribution(-limit - 1, limit);
+
+  for (int64_t rows : {1, 7, 33, 65}) {
+    for (int64_t cols : {1, 3}) {
+      for (int64_t k : {1, 16, 63}) {
+        std::vector<int8_t> w(rows * k);
+        std::vector<float> x(k * cols);
+        for (int8_t& v : w) v = w_distribution(engine);
+        for (float& v : x) v = distribution(engine);
+
+        // Weights are row-major if `k` is contiguous and col-major otherwise,
+        // `x` is row-major and output is column-major.
+        int64_t w_row_stride = k_contiguous ? k : 1;
+        int64_t w_k_stride = k_contiguous ? 1 : rows;
+        QuantizedMatMulStrides strides = {w_row_stride, w_k_stride,
+                                          /*x_k_stride=*/cols,
+                                          /*x_col_stride=*/1,
+                                          /*out_row_stride=*/1,
+                                          /*out_col_stride=*/rows};
+
+        std::vector<float> expected(rows * cols, 0.0f);
+        for (int64_t i = 0; i < rows; ++i) {
+          for (int64_t j = 0; j < cols; ++j) {
+            for (int64_t kk = 0; kk < k; ++kk) {
+              expected[i + j * rows] += w[i * w_row_stride + kk * w_k_stride] *
+                                        x[kk * cols + j];
+            }
+          }
+        }
+
+        std::vector<uint8_t> packed = PackS4(w);
+        const void* w_data = w_type == S4 ? static_cast<const void*>(
+                                                packed.data())
+                                          : static_cast<const void*>(w.data());
+
+        // Compute output in two row ranges to test partitioning.
+        std::vector<float> out(rows * cols);
+        QuantizedMatMul(w_type, w_data, x.data(), out.data(), k, cols, strides,
+                        0, rows / 2);
+        QuantizedMatMul(w_type, w_data, x.data(), out.data(), k, cols, strides,
+                        rows / 2, rows);
+
+        for (int64_t i = 0; i < rows * cols; ++i) {
+          EXPECT_NEAR(out[i], expected[i], 1e-3)
+              << "rows=" << rows << " cols=" << cols << " k=" << k;
+        }
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    QuantizedMatMul, QuantizedMatMulTest,
+    ::testing::Combine(::testing::Values(S8, S4), ::testing::Bool()),
+    [](const ::testing::TestParamInfo<QuantizedMatMulTest::ParamType>& info) {
+      return absl::StrCat(PrimitiveType_Name(std::get<0>(info.param)), "_",
+                          std::get<1>(info.param) ? "KContiguous" : "KStrided");
+    });
+
+//===----------------------------------------------------------------------===//
+// Performance benchmarks.
+//===----------------------------------------------------------------------===//
+
+static void BM_QuantizedMatMul(benchmark::State& state) {
+  PrimitiveType w_type = static_cast<PrimitiveType>(state.range(0));
+  int64_t rows = state.range(1);
+  int64_t cols = state.range(2);
+  int64_t k = state.range(3);
+
+  std::vector<int8_t> w(rows * k, 1);
+  std::vector<float> x(k * cols, 1.0f), out(rows * cols);
+  QuantizedMatMulStrides strides = {k, 1, cols, 1, 1, rows};
+
+  for (auto _ : state) {
+    QuantizedMatMul(w_type, w.data(), x.data(), out.data(), k, cols, strides, 0,
+                    rows);
+    benchmark::DoNotOptimize(out);
+  }
+
+  state.SetItemsProcessed(state.iterations() * rows * cols * k);
+}
+
+BENCHMARK(BM_QuantizedMatMul)
+    ->ArgNames({"type", "rows", "cols", "k"})
+    ->Args({S8, 1024, 1, 1024})
+    ->Args({S8, 4096, 1, 4096})
+    ->Args({S8, 4096, 4, 4096})
+    ->Args({S4, 1024, 1, 1024})
+    ->Args({S4, 4096, 1, 4096})
+    ->Args({S4, 4096, 4, 4096});
+
+}  // namespace
+}  // namespace xla::cpu
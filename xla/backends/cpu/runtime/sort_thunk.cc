@@ -15,8 +15,11 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/sort_thunk.h"
 
+#define EIGEN_USE_THREADS
+
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -42,6 +45,7 @@ limitations under the License.
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/types/span.h"
+#include "unsupported/Eigen/CXX11/Tensor"
 #include "xla/backends/cpu/runtime/function_library.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/layout_util.h"
@@ -672,6 +676,175 @@ static void Sort1DArrInplace(const SortDims& sort_dims, int64_t offset,
   }
 }
 
+// Sort dimension size starting from which we use radix sort instead of the
+// comparison-based sort for inputs of primitive types.
+static constexpr int64_t kMinRadixSortSize = 1024;
+
+// Returns true if we can sort inputs with a radix sort: we support only a
+// single 32-bit input sorted with a builtin comparator. Radix sort is stable,
+// however it orders -0.0 before +0.0 (and they compare equal with a builtin
+// comparator), so for floating point inputs we can use it only if the sort
+// doesn't have to be stable.
+static bool IsRadixSortable(absl::Span<const Shape> shapes,
+                            const SortDims& sort_dims, bool is_stable,
+                            std::optional<SortThunk::SortDirection> direction) {
+  if (shapes.size() != 1 || !direction.has_value()) return false;
+  if (sort_dims.sort_dim_size < kMinRadixSortSize) return false;
+
+  switch (shapes[0].element_type()) {
+    case S32:
+    case U32:
+      return true;
+    case F32:
+      return !is_stable;
+    default:
+      return false;
+  }
+}
+
+// Converts bits of 32-bit values to unsigned keys that have the same order as
+// the original values, and back.
+template <PrimitiveType Type>
+struct RadixKey;
+
+template <>
+struct RadixKey<U32> {
+  static uint32_t Encode(uint32_t bits) { return bits; }
+  static uint32_t Decode(uint32_t key) { return key; }
+};
+
+template <>
+struct RadixKey<S32> {
+  static uint32_t Encode(uint32_t bits) { return bits ^ 0x80000000u; }
+  static uint32_t Decode(uint32_t key) { return key ^ 0x80000000u; }
+};
+
+template <>
+struct RadixKey<F32> {
+  // Flip the sign bit of positive values, and all bits of negative values, as
+  // larger magnitude negative values must come first.
+  static uint32_t Encode(uint32_t bits) {
+    uint32_t mask = static_cast<uint32_t>(-static_cast<int32_t>(bits >> 31));
+    return bits ^ (mask | 0x80000000u);
+  }
+  static uint32_t Decode(uint32_t key) {
+    uint32_t mask = (key >> 31) - 1;
+    return key ^ (mask | 0x80000000u);
+  }
+};
+
+// Sorts `n` 32-bit values starting at `data` with the given stride using LSD
+// radix sort with 8-bit digits. `scratch` must have space for `2 * n` keys.
+//
+// We encode all values into keys and build histograms for all digits in a
+// single pass over the data (simple loops over contiguous keys are easy to
+// vectorize for the compiler), and then scatter keys for each digit, skipping
+// digits that have the same value for all keys.
+template <PrimitiveType Type>
+static void RadixSortInplace(uint32_t* data, int64_t n, int64_t stride,
+                             SortThunk::SortDirection direction,
+                             uint32_t* scratch) {
+  static constexpr size_t kNumDigits = 4;
+  static constexpr size_t kRadix = 256;
+
+  uint32_t* keys = scratch;
+  uint32_t* tmp = scratch + n;
+
+  // For descending sort we invert the keys, and sort them in ascending order.
+  uint32_t invert = direction == SortThunk::SortDirection::kDescending
+                        ? ~uint32_t{0}
+                        : uint32_t{0};
+
+  auto digit = [](uint32_t key, size_t d) { return (key >> (8 * d)) & 0xFF; };
+
+  std::array<std::array<size_t, kRadix>, kNumDigits> histograms = {};
+  for (int64_t i = 0; i < n; ++i) {
+    uint32_t key = RadixKey<Type>::Encode(data[i * stride]) ^ invert;
+    keys[i] = key;
+    for (size_t d = 0; d < kNumDigits; ++d) ++histograms[d][digit(key, d)];
+  }
+
+  for (size_t d = 0; d < kNumDigits; ++d) {
+    std::array<size_t, kRadix>& histogram = histograms[d];
+
+    // All keys have the same digit, nothing to sort.
+    if (histogram[digit(keys[0], d)] == static_cast<size_t>(n)) continue;
+
+    // Convert histogram to the offsets of the first key with each digit.
+    size_t offset = 0;
+    for (size_t& count : histogram) {
+      offset += std::exchange(count, offset);
+    }
+
+    for (int64_t i = 0; i < n; ++i) {
+      uint32_t key = keys[i];
+      tmp[histogram[digit(key, d)]++] = key;
+    }
+
+    std::swap(keys, tmp);
+  }
+
+  for (int64_t i = 0; i < n; ++i) {
+    data[i * stride] = RadixKey<Type>::Decode(keys[i] ^ invert);
+  }
+}
+
+// Sorts all 1-dimensional slices of the `data` buffer with radix sort. If
+// intra-op thread pool is available, slices are sorted in parallel, and the
+// returned event becomes available when all slices are sorted.
+template <PrimitiveType Type>
+static tsl::AsyncValueRef<SortThunk::ExecuteEvent> RadixSort(
+    se::DeviceMemoryBase data, const SortDims& sort_dims,
+    SortThunk::SortDirection direction,
+    const Eigen::ThreadPoolDevice* device) {
+  uint32_t* base = reinterpret_cast<uint32_t*>(data.opaque());
+
+  // Sorts slices in the [begin, end) range.
+  auto sort = [=](int64_t begin, int64_t end) {
+    std::vector<uint32_t> scratch(2 * sort_dims.sort_dim_size);
+    for (int64_t i = begin; i < end; ++i) {
+      int64_t inner_idx = i % sort_dims.inner_dim_size;
+      int64_t offset = inner_idx + (i - inner_idx) * sort_dims.sort_dim_size;
+      RadixSortInplace<Type>(base + offset, sort_dims.sort_dim_size,
+                             sort_dims.inner_dim_size, direction,
+                             scratch.data());
+    }
+  };
+
+  int64_t num_tasks = device == nullptr ? 1
+                                        : std::min<int64_t>(
+                                              sort_dims.num_iterations,
+                                              device->numThreadsInPool());
+
+  if (num_tasks <= 1) {
+    sort(0, sort_dims.num_iterations);
+    return Thunk::OkExecuteEvent();
+  }
+
+  // Use intra-op thread pool to sort slices in parallel.
+  auto event = tsl::MakeConstructedAsyncValueRef<SortThunk::ExecuteEvent>();
+  auto counter = std::make_shared<std::atomic<int64_t>>(num_tasks);
+
+  auto execute = [=](int64_t task_index) {
+    int64_t begin = sort_dims.num_iterations * task_index / num_tasks;
+    int64_t end = sort_dims.num_iterations * (task_index + 1) / num_tasks;
+    sort(begin, end);
+
+    if (counter->load() == 1 || counter->fetch_sub(1) == 1) {
+      event.SetStateConcrete();
+    }
+  };
+
+  for (int64_t i = 1; i < num_tasks; ++i) {
+    device->getPool()->Schedule([i, execute] { execute(i); });
+  }
+
+  // Sort the first range of slices in the caller thread.
+  execute(0);
+
+  return event;
+}
+
 // Sorts `n` buffers in place.
 template <size_t n>
 static void SortInplace(const SortDims& sort_dims, int64_t offset,
@@ -899,6 +1072,28 @@ tsl::AsyncValueRef<SortThunk::ExecuteEvent> SortThunk::Execute(
   });
 
   TF_RETURN_IF_ERROR(less_than_.status());
+
+  // Large single-input sorts with builtin comparators use radix sort.
+  SortDims sort_dims = GetSortDims(shapes[0], dimension_);
+  if (IsRadixSortable(shapes, sort_dims, is_stable_, direction_)) {
+    VLOG(3) << absl::StreamFormat("  use radix sort for %d slices of size %d",
+                                  sort_dims.num_iterations,
+                                  sort_dims.sort_dim_size);
+    switch (shapes[0].element_type()) {
+      case S32:
+        return RadixSort<S32>(data[0], sort_dims, *direction_,
+                              params.intra_op_threadpool);
+      case U32:
+        return RadixSort<U32>(data[0], sort_dims, *direction_,
+                              params.intra_op_threadpool);
+      case F32:
+        return RadixSort<F32>(data[0], sort_dims, *direction_,
+                              params.intra_op_threadpool);
+      default:
+        break;
+    }
+  }
+
   LessThan* less_than = &less_than_.value();
 
   TF_RETURN_IF_ERROR(SortInplace(absl::MakeSpan(data), shapes, dimension_,
@@ -19,11 +19,15 @@ limitations under the License.
 #include <cstdint>
 #include <functional>
 #include <optional>
+#include <random>
+#include <type_traits>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
+#include "xla/array2d.h"
 #include "xla/backends/cpu/runtime/buffer_allocations.h"
 #include "xla/backends/cpu/runtime/function_library.h"
 #include "xla/backends/cpu/runtime/thunk.h"
@@ -36,12 +40,17 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/test.h"
 #include "xla/tsl/platform/test_benchmark.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/xla_data.pb.h"
 
+#define EIGEN_USE_THREADS
+#include "unsupported/Eigen/CXX11/Tensor"
+
 namespace xla::cpu {
 namespace {
 
@@ -299,6 +308,132 @@ TEST_P(SortThunkTest, Sort2DWithLayout) {
   EXPECT_EQ(indices, LiteralUtil::CreateR2<int32_t>({{2, 3}, {0, 1}}));
 }
 
+// Returns random values of type `T` that are large enough to trigger a radix
+// sort in the sort thunk.
+template <typename T>
+static std::vector<T> RandomValues(size_t n) {
+  std::minstd_rand0 engine;
+  std::vector<T> values(n);
+  if constexpr (std::is_floating_point_v<T>) {
+    std::normal_distribution<T> distribution(0.0, 100.0);
+    for (T& value : values) value = distribution(engine);
+  } else {
+    std::uniform_int_distribution<T> distribution;
+    for (T& value : values) value = distribution(engine);
+  }
+  return values;
+}
+
+// Sorts a plain array of type `T` with a sort thunk and checks that results
+// match the std::sort results.
+template <typename T>
+static void TestRadixSortPlainArray(bool is_stable,
+                                    SortThunk::SortDirection direction) {
+  std::vector<T> values = RandomValues<T>(10000);
+  Literal data = LiteralUtil::CreateR1<T>(values);
+
+  BufferAllocations allocations = CreateBufferAllocations(data);
+  BufferAllocation alloc = CreateBufferAllocation(0, data);
+  BufferAllocation::Slice slice = CreateBufferAllocationSlice(alloc);
+
+  auto fake_less_than = [](const void** data) { return false; };
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto thunk, SortThunk::Create({"sort"}, {{slice, data.shape()}},
+                                    /*dimension=*/0, is_stable, fake_less_than,
+                                    direction));
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+
+  auto execute_event = thunk->Execute(params);
+  tsl::BlockUntilReady(execute_event);
+  ASSERT_FALSE(execute_event.IsError());
+
+  if (direction == SortThunk::SortDirection::kAscending) {
+    absl::c_sort(values, std::less<T>());
+  } else {
+    absl::c_sort(values, std::greater<T>());
+  }
+
+  EXPECT_EQ(data, LiteralUtil::CreateR1<T>(values));
+}
+
+TEST_P(SortThunkTest, RadixSortPlainArray) {
+  bool is_stable = GetParam();
+
+  for (auto direction : {SortThunk::SortDirection::kAscending,
+                         SortThunk::SortDirection::kDescending}) {
+    TestRadixSortPlainArray<int32_t>(is_stable, direction);
+    TestRadixSortPlainArray<uint32_t>(is_stable, direction);
+    TestRadixSortPlainArray<float>(is_stable, direction);
+  }
+}
+
+TEST_P(SortThunkTest, RadixSortInParallel) {
+  bool is_stable = GetParam();
+
+  static constexpr int64_t kNumRows = 16;
+  static constexpr int64_t kNumCols = 2048;
+
+  std::vector<int32_t> values = RandomValues<int32_t>(kNumRows * kNumCols);
+
+  Array2D<int32_t> array(kNumRows, kNumCols);
+  array.SetValues(values);
+  Literal rows = LiteralUtil::CreateR2FromArray2D<int32_t>(array);
+
+  // Transposed array to test sorting along the dimension with a stride.
+  Array2D<int32_t> transposed(kNumCols, kNumRows);
+  for (int64_t i = 0; i < kNumRows; ++i) {
+    for (int64_t j = 0; j < kNumCols; ++j) {
+      transposed(j, i) = array(i, j);
+    }
+  }
+  Literal cols = LiteralUtil::CreateR2FromArray2D<int32_t>(transposed);
+
+  BufferAllocations allocations = CreateBufferAllocations(rows, cols);
+  auto [rows_alloc, cols_alloc] = CreateBufferAllocation(rows, cols);
+  auto [rows_slice, cols_slice] =
+      CreateBufferAllocationSlice(rows_alloc, cols_alloc);
+
+  auto fake_less_than = [](const void** data) { return false; };
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto sort_rows,
+      SortThunk::Create({"sort"}, {{rows_slice, rows.shape()}},
+                        /*dimension=*/1, is_stable, fake_less_than,
+                        SortThunk::SortDirection::kAscending));
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto sort_cols,
+      SortThunk::Create({"sort"}, {{cols_slice, cols.shape()}},
+                        /*dimension=*/0, is_stable, fake_less_than,
+                        SortThunk::SortDirection::kAscending));
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 4);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+
+  Thunk::ExecuteParams params;
+  params.buffer_allocations = &allocations;
+  params.intra_op_threadpool = &device;
+
+  auto rows_event = sort_rows->Execute(params);
+  auto cols_event = sort_cols->Execute(params);
+  tsl::BlockUntilReady(rows_event);
+  tsl::BlockUntilReady(cols_event);
+  ASSERT_FALSE(rows_event.IsError());
+  ASSERT_FALSE(cols_event.IsError());
+
+  for (int64_t i = 0; i < kNumRows; ++i) {
+    std::sort(&array(i, 0), &array(i, 0) + kNumCols);
+    for (int64_t j = 0; j < kNumCols; ++j) {
+      ASSERT_EQ(rows.Get<int32_t>({i, j}), array(i, j));
+      ASSERT_EQ(cols.Get<int32_t>({j, i}), array(i, j));
+    }
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(SortThunk, SortThunkTest, testing::Bool(),
                          testing::PrintToStringParamName());
 
@@ -371,7 +506,61 @@ BENCHMARK(BM_Sort1D)
     ->Args({1000, 4, false, false})
     ->Args({1000, 8, false, false})
     ->Args({1000, 16, false, false})
-    ->Args({1000, 32, false, false});
+    ->Args({1000, 32, false, false})
+    // Large sorts using ascending direction (radix sort).
+    ->Args({100000, 1, false, true})
+    ->Args({1000000, 1, false, true})
+    // Large sorts using LessThan comparator.
+    ->Args({100000, 1, false, false})
+    ->Args({1000000, 1, false, false});
+
+void BM_SortRows(benchmark::State& state) {
+  int64_t num_rows = state.range(0);
+  int64_t num_cols = state.range(1);
+  bool sort_ascending = state.range(2);
+
+  auto data = LiteralUtil::CreateRandomLiteral<F32>(
+      ShapeUtil::MakeShape(F32, {num_rows, num_cols}), 1.0f, 1.0f);
+  CHECK_OK(data) << "Failed to create random literal";  // Crash OK
+
+  std::optional<SortThunk::SortDirection> direction;
+  if (sort_ascending) direction = SortThunk::SortDirection::kAscending;
+
+  BufferAllocation alloc = CreateBufferAllocation(0, *data);
+  BufferAllocation::Slice slice = CreateBufferAllocationSlice(alloc);
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "bench", 8);
+  Eigen::ThreadPoolDevice device(threads.AsEigenThreadPool(),
+                                 threads.NumThreads());
+
+  auto thunk = SortThunk::Create({"sort"}, {{slice, data->shape()}},
+                                 /*dimension=*/1, /*is_stable=*/false,
+                                 LessThan, direction);
+  CHECK_OK(thunk) << "Failed to create sort thunk";  // Crash OK
+
+  for (auto s : state) {
+    // Clone the data to avoid sorting already sorted data.
+    Literal data_copy = data->Clone();
+    BufferAllocations allocations = CreateBufferAllocations(data_copy);
+
+    Thunk::ExecuteParams params;
+    params.buffer_allocations = &allocations;
+    params.intra_op_threadpool = &device;
+
+    auto execute_event = (*thunk)->Execute(params);
+    tsl::BlockUntilReady(execute_event);
+    CHECK(execute_event.IsConcrete());
+  }
+}
+
+BENCHMARK(BM_SortRows)
+    ->MeasureProcessCPUTime()
+    ->UseRealTime()
+    ->ArgNames({"num_rows", "num_cols", "sort_ascending"})
+    ->Args({32, 32768, true})
+    ->Args({32, 32768, false})
+    ->Args({128, 4096, true})
+    ->Args({128, 4096, false});
 
 }  // namespace
 }  // namespace xla::cpu
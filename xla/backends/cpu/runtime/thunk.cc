@@ -56,6 +56,8 @@ absl::string_view Thunk::KindToString(Kind kind) {
       return "dot";
     case Kind::kFft:
       return "fft";
+    case Kind::kGather:
+      return "gather";
     case Kind::kInfeed:
       return "infeed";
     case Kind::kKernel:
@@ -149,12 +151,7 @@ Thunk::CustomCallExecuteParams::CustomCallExecuteParams(
       ffi_execution_context(ffi_execution_context) {}
 
 tsl::AsyncValueRef<Thunk::ExecuteEvent> Thunk::OkExecuteEventSingleton() {
-  static tsl::AsyncValueOwningRef<ExecuteEvent>* singleton = [] {
-    auto* storage = new tsl::internal::AsyncValueStorage<ExecuteEvent>();
-    return new tsl::AsyncValueOwningRef<ExecuteEvent>(
-        tsl::MakeAvailableAsyncValueRef<ExecuteEvent>(*storage));
-  }();
-  return singleton->AsRef();
+  return tsl::GetAvailableAsyncValueRefSingleton<ExecuteEvent>();
 }
 
 Thunk::ExecuteSession::ExecuteSession(int64_t max_workers,
@@ -71,6 +71,7 @@ class Thunk {
     kCustomCall,
     kDot,
     kFft,
+    kGather,
     kInfeed,
     kKernel,
     kOutfeed,
@@ -24,8 +24,10 @@ limitations under the License.
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -33,14 +35,18 @@ limitations under the License.
 #include "absl/base/attributes.h"
 #include "absl/base/optimization.h"
 #include "absl/log/check.h"
+#include "absl/numeric/bits.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
 #include "absl/types/span.h"
+#include "xla/backends/cpu/runtime/perf_counters.h"
 #include "xla/backends/cpu/runtime/resource_use.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/work_stealing_queue.h"
 #include "xla/runtime/buffer_use.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/platform/env.h"
@@ -50,6 +56,7 @@ limitations under the License.
 #include "tsl/profiler/lib/connected_traceme.h"
 #include "tsl/profiler/lib/context_types.h"
 #include "tsl/profiler/lib/traceme.h"
+#include "tsl/profiler/lib/traceme_encode.h"
 
 namespace xla::cpu {
 
@@ -124,6 +131,14 @@ ThunkExecutor::ThunkExecutor(ThunkSequence thunk_sequence,
   // Sanity check that all vectors are empty or all vectors are non-empty.
   DCHECK((!source_.empty() && !sink_.empty() && !thunk_sequence_.empty()) ||
          (source_.empty() && sink_.empty() && thunk_sequence_.empty()));
+
+  // Sequential execution doesn't need an execute state, don't create a pool.
+  if (options.use_execute_state_pool && !is_sequential_) {
+    execute_state_pool_ = std::make_unique<ExecuteStatePool>(
+        [](ThunkExecutor* executor, Thunk::TaskRunner* runner) {
+          return std::make_unique<ExecuteState>(executor, runner);
+        });
+  }
 }
 
 absl::StatusOr<ThunkExecutor> ThunkExecutor::Create(
@@ -197,8 +212,41 @@ ThunkExecutor::ExecuteState::ExecuteState(ThunkExecutor* executor,
   }
 }
 
+void ThunkExecutor::ExecuteState::Reset(ThunkExecutor* executor,
+                                        Thunk::TaskRunner* runner) {
+  DCHECK_EQ(nodes.size(), executor->nodes_defs().size())
+      << "Execute state must be reused with the same executor";
+
+  this->executor = executor;
+  this->runner = runner;
+
+  // Nodes are trivially destructible, and we simply construct new ones in
+  // place to reset all counters.
+  NodeStorage* node = nodes.data();
+  for (const NodeDef& node_def : executor->nodes_defs()) {
+    new (node++) Node(node_def);
+  }
+
+  execute_event = tsl::MakeConstructedAsyncValueRef<ExecuteEvent>();
+  pending_sink_nodes.store(executor->sink().size(), std::memory_order_relaxed);
+  abort.store(false, std::memory_order_relaxed);
+
+  absl::MutexLock lock(&abort_mutex);
+  abort_status = absl::OkStatus();
+}
+
+// Returns the number of bytes in all buffers accessed by the thunk.
+static int64_t BytesAccessed(const Thunk& thunk) {
+  int64_t bytes_accessed = 0;
+  for (const BufferUse& buffer_use : thunk.buffer_uses()) {
+    bytes_accessed += buffer_use.slice().size();
+  }
+  return bytes_accessed;
+}
+
 // Executes given `thunk` and adds tracing annotation to record the execution
-// start and end events for profiling.
+// start and end events for profiling. The end event carries per-thunk stats:
+// wall time, bytes accessed and, at verbose trace level, hardware counters.
 tsl::AsyncValueRef<Thunk::ExecuteEvent> ThunkExecutor::TracedExecute(
     Thunk& thunk, const Thunk::ExecuteParams& params) {
   // If profiler is not active avoid overheads of calling AndThen below.
@@ -210,15 +258,50 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> ThunkExecutor::TracedExecute(
   tsl::profiler::TraceMeProducer producer([&] { return thunk.TraceMeEncode(); },
                                           tsl::profiler::ContextType::kGeneric);
 
+  // Hardware counters are more expensive to read, and we sample them only at
+  // the verbose trace level.
+  PerfCounters* perf_counters =
+      tsl::profiler::TraceMe::Active(tsl::profiler::TraceMeLevel::kVerbose)
+          ? PerfCounters::ThreadLocal()
+          : nullptr;
+
+  std::optional<PerfCounters::Sample> start_sample;
+  if (perf_counters) start_sample = perf_counters->Read();
+
+  int64_t start_ns = absl::GetCurrentTimeNanos();
   auto execute_event = thunk.Execute(params);
 
+  // Counters are per-thread, and we can attribute them to the thunk only if
+  // it completed synchronously in the caller thread.
+  std::optional<PerfCounters::Sample> perf_sample;
+  if (start_sample && execute_event.IsAvailable()) {
+    if (auto end_sample = perf_counters->Read()) {
+      perf_sample = *end_sample - *start_sample;
+    }
+  }
+
   // When thunk execution completes, create a consumer traceme to capture the
   // end event.
-  execute_event.AndThen([context_id = producer.GetContextId(), &thunk] {
-    tsl::profiler::TraceMeConsumer(
-        [&] { return absl::StrFormat("end: %s", thunk.info().op_name); },
-        tsl::profiler::ContextType::kGeneric, context_id);
-  });
+  execute_event.AndThen(
+      [context_id = producer.GetContextId(), &thunk, start_ns, perf_sample] {
+        int64_t duration_ns = absl::GetCurrentTimeNanos() - start_ns;
+        tsl::profiler::TraceMeConsumer consumer(
+            [&] { return absl::StrFormat("end: %s", thunk.info().op_name); },
+            tsl::profiler::ContextType::kGeneric, context_id);
+        consumer.AppendMetadata([&] {
+          return tsl::profiler::TraceMeEncode(
+              {{"duration_ns", duration_ns},
+               {"bytes_accessed", BytesAccessed(thunk)}});
+        });
+        if (perf_sample) {
+          consumer.AppendMetadata([&] {
+            return tsl::profiler::TraceMeEncode(
+                {{"cycles", perf_sample->cycles},
+                 {"instructions", perf_sample->instructions},
+                 {"cache_misses", perf_sample->cache_misses}});
+          });
+        }
+      });
 
   return execute_event;
 }
@@ -243,16 +326,33 @@ tsl::AsyncValueRef<ThunkExecutor::ExecuteEvent> ThunkExecutor::Execute(
     return ExecuteSequential(params);
   }
 
+  // Borrow execute state from the pool and reset it for a new execution.
+  if (execute_state_pool_) {
+    auto state = execute_state_pool_->GetOrCreate(this, params.task_runner);
+    if (ABSL_PREDICT_FALSE(!state.ok())) {
+      return tsl::MakeErrorAsyncValueRef(std::move(state).status());
+    }
+    ExecuteState* borrowed_state = (*state)->get();
+    borrowed_state->Reset(this, params.task_runner);
+    return ExecuteAsync(borrowed_state, *std::move(state), params);
+  }
+
   // Create async execution state on heap and kick-off execution.
   auto state = std::make_unique<ExecuteState>(this, params.task_runner);
+  ExecuteState* state_ptr = state.get();
+  return ExecuteAsync(state_ptr, std::move(state), params);
+}
 
+template <typename StateOwner>
+tsl::AsyncValueRef<ThunkExecutor::ExecuteEvent> ThunkExecutor::ExecuteAsync(
+    ExecuteState* state, StateOwner owner, const Thunk::ExecuteParams& params) {
   // When we kick-off execution we don't have to grab the session lock, as the
   // main thread is not counted towards the number of concurrent workers limit.
   // This also works for thunks with nested thunk executors (i.e., WhileThunk),
   // as launching nested thunk sequence must not reduce the available
   // concurrency for the other thunks executing in parallel.
   auto execute = [&](auto ready_queue) {
-    Execute(state.get(), params, std::move(ready_queue), /*lock=*/nullptr);
+    Execute(state, params, std::move(ready_queue), /*lock=*/nullptr);
   };
 
   switch (options_.ready_queue_type) {
@@ -265,6 +365,16 @@ tsl::AsyncValueRef<ThunkExecutor::ExecuteEvent> ThunkExecutor::Execute(
     case Options::ReadyQueueType::kPriority:
       execute(PriorityReadyQueue(nodes_defs_, source_));
       break;
+    case Options::ReadyQueueType::kWorkStealing:
+      // We need one deque for each concurrent worker plus the caller thread.
+      execute(WorkStealingReadyQueue(
+          std::make_shared<WorkStealingQueues>(
+              std::min<size_t>(params.session.max_workers() + 1,
+                               WorkStealingQueues::kMaxQueues),
+              std::min(options_.work_stealing_queue_capacity,
+                       nodes_defs_.size())),
+          source_));
+      break;
   }
 
   // If execution already completed (all kernels executed in the caller thread),
@@ -276,7 +386,7 @@ tsl::AsyncValueRef<ThunkExecutor::ExecuteEvent> ThunkExecutor::Execute(
   // Move execute state to the execute event callback to ensure that it is kept
   // alive while thunk executor has pending tasks.
   tsl::AsyncValueRef<ExecuteEvent> execute_event = state->execute_event;
-  execute_event.AndThen([state = std::move(state)] {
+  execute_event.AndThen([state, owner = std::move(owner)] {
     auto cnt = state->pending_sink_nodes.load(std::memory_order_acquire);
     DCHECK_EQ(cnt, 0)
         << "All sink nodes must be completed before execute_event is marked "
@@ -414,7 +524,14 @@ void ThunkExecutor::Execute(ExecuteState* state,
                             const Thunk::ExecuteParams& params,
                             ReadyQueue ready_queue,
                             Thunk::ExecuteSession::Lock lock) {
-  DCHECK(!ready_queue.Empty()) << "Ready queue must not be empty";
+  // Work stealing ready queue might be emptied by thieves before we started
+  // processing it, and in this case execution might be already completed and
+  // `state` destroyed, so we must not touch it.
+  if constexpr (std::is_same_v<ReadyQueue, WorkStealingReadyQueue>) {
+    if (ready_queue.Empty()) return;
+  } else {
+    DCHECK(!ready_queue.Empty()) << "Ready queue must not be empty";
+  }
 
   tsl::profiler::TraceMe trace("ThunkExecutor::Execute");
   bool has_runner = state->runner != nullptr;
@@ -853,4 +970,158 @@ ThunkExecutor::PriorityReadyQueue::CreateEmptyReadyQueue() const {
   return PriorityReadyQueue(nodes_defs_, {});
 }
 
+ThunkExecutor::WorkStealingQueues::WorkStealingQueues(size_t num_queues,
+                                                     size_t capacity)
+    : owned_(0) {
+  DCHECK_GT(num_queues, 0) << "Number of queues must be positive";
+  DCHECK_LE(num_queues, kMaxQueues) << "Too many work stealing queues";
+
+  num_queues = std::clamp<size_t>(num_queues, 1, kMaxQueues);
+  queues_.reserve(num_queues);
+  for (size_t i = 0; i < num_queues; ++i) {
+    queues_.push_back(std::make_unique<WorkStealingQueue<NodeId>>(capacity));
+  }
+}
+
+std::optional<size_t> ThunkExecutor::WorkStealingQueues::Acquire() {
+  uint64_t all = queues_.size() == kMaxQueues
+                     ? std::numeric_limits<uint64_t>::max()
+                     : (uint64_t{1} << queues_.size()) - 1;
+
+  uint64_t owned = owned_.load(std::memory_order_relaxed);
+  while ((owned & all) != all) {
+    // Find the first deque that is not owned by any of the workers.
+    size_t index = absl::countr_one(owned);
+    if (owned_.compare_exchange_weak(owned, owned | (uint64_t{1} << index),
+                                     std::memory_order_acquire,
+                                     std::memory_order_relaxed)) {
+      return index;
+    }
+  }
+
+  return std::nullopt;
+}
+
+void ThunkExecutor::WorkStealingQueues::Release(size_t index) {
+  DCHECK_LT(index, queues_.size()) << "Invalid queue index";
+  owned_.fetch_and(~(uint64_t{1} << index), std::memory_order_release);
+}
+
+std::optional<ThunkExecutor::NodeId> ThunkExecutor::WorkStealingQueues::Steal(
+    size_t start_index) {
+  for (size_t i = 0; i < queues_.size(); ++i) {
+    size_t index = (start_index + i) % queues_.size();
+    if (std::optional<NodeId> id = queues_[index]->Steal()) {
+      return id;
+    }
+  }
+  return std::nullopt;
+}
+
+ThunkExecutor::WorkStealingReadyQueue::WorkerState::WorkerState(
+    std::shared_ptr<WorkStealingQueues> queues)
+    : queues(std::move(queues)) {}
+
+ThunkExecutor::WorkStealingReadyQueue::WorkerState::~WorkerState() {
+  if (queue_index) queues->Release(*queue_index);
+}
+
+ThunkExecutor::WorkStealingReadyQueue::WorkStealingReadyQueue(
+    std::shared_ptr<WorkStealingQueues> queues,
+    absl::Span<const NodeId> ready_nodes)
+    : worker_(std::make_shared<WorkerState>(std::move(queues))) {
+  for (NodeId id : ready_nodes) Push(id);
+}
+
+void ThunkExecutor::WorkStealingReadyQueue::Push(NodeId id) {
+  WorkerState& w = *worker_;
+
+  // Lazily acquire a deque on the first push, as workers resumed from async
+  // thunk callbacks might not have any nodes to push at all.
+  if (ABSL_PREDICT_FALSE(!w.queue_index)) {
+    w.queue_index = w.queues->Acquire();
+  }
+
+  // If we don't own a deque or it's full, keep node in the local storage.
+  if (ABSL_PREDICT_FALSE(!w.queue_index ||
+                         !w.queues->queue(*w.queue_index).Push(id))) {
+    w.local.push_back(id);
+  }
+}
+
+ThunkExecutor::NodeId ThunkExecutor::WorkStealingReadyQueue::Pop() {
+  WorkerState& w = *worker_;
+
+  // `Empty` moves the next node to the local storage.
+  if (ABSL_PREDICT_FALSE(w.local.empty())) {
+    bool empty = Empty();
+    DCHECK(!empty) << "Queue must not be empty";
+  }
+
+  NodeId id = w.local.back();
+  w.local.pop_back();
+  return id;
+}
+
+ThunkExecutor::WorkStealingReadyQueue
+ThunkExecutor::WorkStealingReadyQueue::PopHalf() {
+  size_t size = Size();
+  DCHECK_GT(size, 0) << "Queue must not be empty";
+  WorkerState& w = *worker_;
+
+  WorkStealingReadyQueue popped(w.queues, {});
+  size_t num_popped = size - size / 2;
+
+  // Give away the oldest nodes from the owned deque first, and then nodes from
+  // the local storage. Steal can fail only if we lost a race with a thief.
+  if (w.queue_index) {
+    WorkStealingQueue<NodeId>& queue = w.queues->queue(*w.queue_index);
+    for (; num_popped > 0; --num_popped) {
+      std::optional<NodeId> id = queue.Steal();
+      if (!id) break;
+      popped.Push(*id);
+    }
+  }
+
+  for (; num_popped > 0 && !w.local.empty(); --num_popped) {
+    popped.Push(w.local.back());
+    w.local.pop_back();
+  }
+
+  return popped;
+}
+
+size_t ThunkExecutor::WorkStealingReadyQueue::Size() const {
+  const WorkerState& w = *worker_;
+  size_t queue_size = w.queue_index ? w.queues->queue(*w.queue_index).Size() : 0;
+  return w.local.size() + queue_size;
+}
+
+bool ThunkExecutor::WorkStealingReadyQueue::Empty() {
+  WorkerState& w = *worker_;
+  if (ABSL_PREDICT_TRUE(!w.local.empty())) return false;
+
+  // Pop the most recently pushed node from the owned deque.
+  if (ABSL_PREDICT_TRUE(w.queue_index)) {
+    if (std::optional<NodeId> id = w.queues->queue(*w.queue_index).Pop()) {
+      w.local.push_back(*id);
+      return false;
+    }
+  }
+
+  // Try to steal a node from other workers starting from the next deque.
+  size_t start_index = w.queue_index ? *w.queue_index + 1 : 0;
+  if (std::optional<NodeId> id = w.queues->Steal(start_index)) {
+    w.local.push_back(*id);
+    return false;
+  }
+
+  return true;
+}
+
+ThunkExecutor::WorkStealingReadyQueue
+ThunkExecutor::WorkStealingReadyQueue::CreateEmptyReadyQueue() const {
+  return WorkStealingReadyQueue(worker_->queues, {});
+}
+
 }  // namespace xla::cpu
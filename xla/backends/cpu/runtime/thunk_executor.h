@@ -20,7 +20,9 @@ limitations under the License.
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <memory>
 #include <new>
+#include <optional>
 #include <queue>
 #include <string>
 #include <tuple>
@@ -35,7 +37,9 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
+#include "xla/backends/cpu/runtime/object_pool.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/work_stealing_queue.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 
 namespace xla::cpu {
@@ -44,7 +48,7 @@ namespace internal {
 // Clang does not allow defining a nested struct with member initializer, as
 // a workaround we define a struct in internal namespace and create an alias.
 struct ThunkExecutorOptions {
-  enum class ReadyQueueType { kFifo, kLifo, kPriority };
+  enum class ReadyQueueType { kFifo, kLifo, kPriority, kWorkStealing };
 
   // If all thunks in a sequence use buffers of size less than or equal to the
   // given threshold, we mark execution as sequential, as concurrency overheads
@@ -58,6 +62,17 @@ struct ThunkExecutorOptions {
 
   // The type of a queue for ready thunks.
   ReadyQueueType ready_queue_type = ReadyQueueType::kFifo;
+
+  // The maximum capacity of a per-worker deque used by the work stealing ready
+  // queue. Ready nodes that do not fit into the deque are kept in the worker
+  // local storage and can't be stolen by other workers.
+  size_t work_stealing_queue_capacity = 1024;
+
+  // If true, thunk executor keeps execute states of completed executions in
+  // an object pool and reuses them for the following executions. This avoids
+  // heap allocating node counters on every call at the cost of keeping the
+  // memory alive for the lifetime of the executor.
+  bool use_execute_state_pool = false;
 };
 }  // namespace internal
 
@@ -197,6 +212,76 @@ class ThunkExecutor {
     InlinedPriorityQueue queue_;
   };
 
+  // A set of work stealing deques shared by all workers processing the same
+  // thunk executor execution. Each worker owns at most one deque, and once it
+  // runs out of its own work, it steals nodes from deques owned by other
+  // workers. Up to 64 deques are supported, as we track owned deques with a
+  // bitmask.
+  class WorkStealingQueues {
+   public:
+    static constexpr size_t kMaxQueues = 64;
+
+    WorkStealingQueues(size_t num_queues, size_t capacity);
+
+    // Acquires a deque for exclusive use by the caller. Returns std::nullopt
+    // if all deques are already owned by other workers.
+    std::optional<size_t> Acquire();
+
+    // Releases a deque acquired by the `Acquire` call.
+    void Release(size_t index);
+
+    // Steals a node from any of the deques starting from `start_index`.
+    std::optional<NodeId> Steal(size_t start_index);
+
+    WorkStealingQueue<NodeId>& queue(size_t index) { return *queues_[index]; }
+    size_t num_queues() const { return queues_.size(); }
+
+   private:
+    absl::InlinedVector<std::unique_ptr<WorkStealingQueue<NodeId>>, 8> queues_;
+    std::atomic<uint64_t> owned_;
+  };
+
+  // A ready queue backed by a work stealing deque owned by the worker. Nodes
+  // pushed into the queue can be stolen by other workers processing the same
+  // execution, and if the queue runs out of work it tries to steal nodes from
+  // other workers before reporting that it is empty.
+  //
+  // If all deques are owned by other workers, the queue falls back to a worker
+  // local storage that is invisible to thieves.
+  class WorkStealingReadyQueue {
+   public:
+    WorkStealingReadyQueue(std::shared_ptr<WorkStealingQueues> queues,
+                           absl::Span<const NodeId> ready_nodes);
+
+    void Push(NodeId id);
+
+    NodeId Pop();
+    WorkStealingReadyQueue PopHalf();
+
+    size_t Size() const;
+
+    // Returns true if the queue is empty and it failed to steal a node from
+    // other workers. Stolen nodes are added to the worker local storage.
+    bool Empty();
+
+    WorkStealingReadyQueue CreateEmptyReadyQueue() const;
+
+   private:
+    // Worker state is shared between all copies of the ready queue, because
+    // thunk executor tasks must be copyable, however only one copy is used at
+    // a time. Worker releases the owned deque when the last copy is destroyed.
+    struct WorkerState {
+      explicit WorkerState(std::shared_ptr<WorkStealingQueues> queues);
+      ~WorkerState();
+
+      std::shared_ptr<WorkStealingQueues> queues;
+      std::optional<size_t> queue_index;
+      absl::InlinedVector<NodeId, 8> local;
+    };
+
+    std::shared_ptr<WorkerState> worker_;
+  };
+
  private:
   // Align all atomic counters to a cache line boundary to avoid false
   // sharing between multiple worker threads.
@@ -229,6 +314,10 @@ class ThunkExecutor {
 
     ExecuteState(ThunkExecutor* executor, Thunk::TaskRunner* runner);
 
+    // Resets the state of a completed execution, so that it can be reused for
+    // the next execution of the same executor.
+    void Reset(ThunkExecutor* executor, Thunk::TaskRunner* runner);
+
     Node& node(NodeId id) {
       DCHECK_LT(id, nodes.size()) << "Node id is out of bounds";
       return *reinterpret_cast<Node*>(&nodes.data()[id]);
@@ -253,6 +342,11 @@ class ThunkExecutor {
     absl::Status abort_status ABSL_GUARDED_BY(abort_mutex);
   };
 
+  // A pool of execute states reused across executions. We keep execute states
+  // behind a unique_ptr because they are not movable.
+  using ExecuteStatePool = ObjectPool<std::unique_ptr<ExecuteState>,
+                                      ThunkExecutor*, Thunk::TaskRunner*>;
+
   ThunkExecutor(ThunkSequence thunk_sequence, NodesEdges nodes_in_edges,
                 NodesEdges nodes_out_edges, std::vector<NodeDef> nodes_defs,
                 const Options& options);
@@ -273,6 +367,13 @@ class ThunkExecutor {
                                const Thunk::ExecuteParams& params,
                                tsl::AsyncValueRef<ExecuteEvent> event);
 
+  // Kicks off asynchronous execution of the thunk sequence using the given
+  // execute `state`. `owner` keeps the state alive until execution completes.
+  template <typename StateOwner>
+  tsl::AsyncValueRef<ExecuteEvent> ExecuteAsync(
+      ExecuteState* state, StateOwner owner,
+      const Thunk::ExecuteParams& params);
+
   // Executes nodes in the ready queue with given thunk parameters.
   template <typename ReadyQueue>
   void Execute(ExecuteState* state, const Thunk::ExecuteParams& params,
@@ -320,6 +421,9 @@ class ThunkExecutor {
   // opportunities for executing thunks concurrently, we skip the expensive
   // async execution and simply run thunks in the `thunk_sequence_` one by one.
   bool is_sequential_;
+
+  // Execute states reused across executions if enabled by the options.
+  std::unique_ptr<ExecuteStatePool> execute_state_pool_;
 };
 
 }  // namespace xla::cpu
@@ -415,6 +415,84 @@ TEST(ThunkExecutorTest, PriorityReadyQueueTest) {
   EXPECT_EQ(half2.Pop(), 1);
 }
 
+TEST(ThunkExecutorTest, WorkStealingReadyQueueTest) {
+  auto queues = std::make_shared<ThunkExecutor::WorkStealingQueues>(
+      /*num_queues=*/2, /*capacity=*/4);
+
+  ThunkExecutor::WorkStealingReadyQueue queue(queues, {});
+
+  // Check basic queue properties.
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Size(), 0);
+
+  queue.Push(1);
+  queue.Push(2);
+  queue.Push(3);
+
+  ASSERT_EQ(queue.Size(), 3);
+
+  // Owner pops nodes from the bottom of the deque.
+  EXPECT_EQ(queue.Pop(), 3);
+  EXPECT_EQ(queue.Pop(), 2);
+  EXPECT_EQ(queue.Pop(), 1);
+
+  EXPECT_TRUE(queue.Empty());
+  ASSERT_EQ(queue.Size(), 0);
+
+  // Push more nodes than the deque capacity to check local storage fallback.
+  for (int32_t i = 0; i < 6; ++i) queue.Push(i);
+  ASSERT_EQ(queue.Size(), 6);
+
+  // Pop half of the queue, oldest nodes are given away first.
+  ThunkExecutor::WorkStealingReadyQueue half0 = queue.PopHalf();
+  ASSERT_EQ(half0.Size(), 3);
+  ASSERT_EQ(queue.Size(), 3);
+
+  // Popped nodes are pushed to the deque owned by `half0`.
+  EXPECT_EQ(half0.Pop(), 2);
+  EXPECT_EQ(half0.Pop(), 1);
+  EXPECT_EQ(half0.Pop(), 0);
+
+  // Nodes from the local storage are popped first.
+  EXPECT_EQ(queue.Pop(), 5);
+  EXPECT_EQ(queue.Pop(), 4);
+  EXPECT_EQ(queue.Pop(), 3);
+
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_TRUE(half0.Empty());
+}
+
+TEST(ThunkExecutorTest, WorkStealingReadyQueueSteal) {
+  auto queues = std::make_shared<ThunkExecutor::WorkStealingQueues>(
+      /*num_queues=*/2, /*capacity=*/8);
+
+  ThunkExecutor::WorkStealingReadyQueue owner(queues, {1, 2, 3});
+  ThunkExecutor::WorkStealingReadyQueue thief = owner.CreateEmptyReadyQueue();
+
+  // Thief steals the oldest nodes from the owner deque.
+  ASSERT_FALSE(thief.Empty());
+  EXPECT_EQ(thief.Pop(), 1);
+  ASSERT_FALSE(thief.Empty());
+  EXPECT_EQ(thief.Pop(), 2);
+
+  EXPECT_EQ(owner.Pop(), 3);
+  EXPECT_TRUE(owner.Empty());
+  EXPECT_TRUE(thief.Empty());
+
+  // Thief acquires the last free deque, and the next queue falls back to the
+  // local storage that is invisible to other workers.
+  thief.Push(4);
+  ThunkExecutor::WorkStealingReadyQueue local = owner.CreateEmptyReadyQueue();
+  local.Push(5);
+
+  EXPECT_FALSE(owner.Empty());
+  EXPECT_EQ(owner.Pop(), 4);
+  EXPECT_TRUE(owner.Empty());
+
+  EXPECT_FALSE(local.Empty());
+  EXPECT_EQ(local.Pop(), 5);
+}
+
 TEST(ThunkExecutorTest, DependencyOrdering) {
   BufferAllocation alloc(/*index=*/0, /*size=*/80, /*color=*/0);
 
@@ -737,11 +815,12 @@ GenerateThunkSequence(size_t num_elements, size_t num_thunks,
 // and optionally uses a thread pool to execute thunk executor tasks.
 class ThunkExecutorStressTest
     : public testing::TestWithParam<
-          std::tuple<int32_t, bool, bool, SharedResourceUse, bool, bool>> {
+          std::tuple<int32_t, bool, bool, SharedResourceUse, bool,
+                     ThunkExecutor::Options::ReadyQueueType>> {
  public:
   void SetUp() override {
     auto& [num_thunks, use_task_runner, use_device, shared_resource_use,
-           inject_errors, use_priority_ready_queue] = GetParam();
+           inject_errors, ready_queue_type] = GetParam();
 
     use_task_runner_ = use_task_runner;
     use_device_ = use_device;
@@ -779,17 +858,15 @@ class ThunkExecutorStressTest
 
 TEST_P(ThunkExecutorStressTest, Execute) {
   auto [num_thunks, use_task_runner, use_device, shared_resource_use,
-        inject_errors, use_priority_ready_queue] = GetParam();
+        inject_errors, ready_queue_type] = GetParam();
 
   TF_ASSERT_OK_AND_ASSIGN(
       std::unique_ptr<GeneratedThunkSequence> g,
       GenerateThunkSequence(/*num_elements=*/1024, num_thunks,
                             shared_resource_use, inject_errors));
 
-  ThunkExecutor::Options executor_options = {
-      /*execute_sequential_buffer_threshold=*/0,
-      /*use_priority_ready_queue=*/use_priority_ready_queue,
-  };
+  ThunkExecutor::Options executor_options = OptionsForTest();
+  executor_options.ready_queue_type = ready_queue_type;
 
   TF_ASSERT_OK_AND_ASSIGN(
       ThunkExecutor executor,
@@ -815,6 +892,40 @@ TEST_P(ThunkExecutorStressTest, Execute) {
   }
 }
 
+TEST(ThunkExecutorTest, ExecuteWithStatePool) {
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "thunk-executor", 8);
+  ThreadPoolTaskRunner task_runner(thread_pool.AsEigenThreadPool());
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<GeneratedThunkSequence> g,
+      GenerateThunkSequence(/*num_elements=*/1024, /*num_thunks=*/100,
+                            SharedResourceUse::kNo, /*inject_errors=*/false));
+
+  ThunkExecutor::Options executor_options = OptionsForTest();
+  executor_options.use_execute_state_pool = true;
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      ThunkExecutor executor,
+      ThunkExecutor::Create(std::move(g->sequence), executor_options));
+
+  BufferAllocations allocations =
+      CreateBufferAllocations(absl::MakeSpan(g->literals));
+  Thunk::ExecuteParams params = {nullptr, &allocations, nullptr, nullptr,
+                                 &task_runner};
+
+  // Execute multiple times to check that execute states borrowed from the pool
+  // are correctly reset between executions.
+  for (int i = 0; i < 10; ++i) {
+    absl::c_fill(g->dst.data<int32_t>(), 0);
+
+    auto execute_event = executor.Execute(params);
+    tsl::BlockUntilReady(execute_event);
+
+    ASSERT_TRUE(execute_event.IsConcrete());
+    EXPECT_EQ(g->dst, g->expected);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     ThunkExecutor, ThunkExecutorStressTest,
     testing::Combine(/*num_thunks=*/testing::ValuesIn({10, 100, 1000}),
@@ -825,7 +936,11 @@ INSTANTIATE_TEST_SUITE_P(
                                      SharedResourceUse::kAll,
                                      SharedResourceUse::kRandom),
                      /*inject_errors=*/testing::Bool(),
-                     /*use_priority_ready_queue=*/testing::Bool()));
+                     /*ready_queue_type=*/
+                     testing::Values(
+                         ThunkExecutor::Options::ReadyQueueType::kFifo,
+                         ThunkExecutor::Options::ReadyQueueType::kPriority,
+                         ThunkExecutor::Options::ReadyQueueType::kWorkStealing)));
 
 //===----------------------------------------------------------------------===//
 // Performance benchmarks below
@@ -965,7 +1080,8 @@ static void BM_SyncThunkExecutor(benchmark::State& state) {
   }
 }
 
-static void BM_AsyncThunkExecutor(benchmark::State& state) {
+static void RunAsyncThunkExecutor(benchmark::State& state,
+                                  const ThunkExecutor::Options& options) {
   const size_t num_thunks = state.range(0);
 
   tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "thunk-executor", 8);
@@ -975,7 +1091,7 @@ static void BM_AsyncThunkExecutor(benchmark::State& state) {
   auto g = GenerateThunkSequence(/*num_elements=*/1024, num_thunks,
                                  /*shared_resource_use=*/SharedResourceUse::kNo,
                                  /*inject_errors=*/false);
-  auto e = ThunkExecutor::Create(std::move((*g)->sequence), OptionsForTest());
+  auto e = ThunkExecutor::Create(std::move((*g)->sequence), options);
 
   BufferAllocations allocations =
       CreateBufferAllocations(absl::MakeSpan((*g)->literals));
@@ -991,6 +1107,16 @@ static void BM_AsyncThunkExecutor(benchmark::State& state) {
   }
 }
 
+static void BM_AsyncThunkExecutor(benchmark::State& state) {
+  RunAsyncThunkExecutor(state, OptionsForTest());
+}
+
+static void BM_AsyncThunkExecutorWithStatePool(benchmark::State& state) {
+  ThunkExecutor::Options options = OptionsForTest();
+  options.use_execute_state_pool = true;
+  RunAsyncThunkExecutor(state, options);
+}
+
 #define BENCHMARK_THUNK_EXECUTOR(name) \
   BENCHMARK(name)                      \
       ->MeasureProcessCPUTime()        \
@@ -1009,6 +1135,7 @@ BENCHMARK_THUNK_EXECUTOR(BM_CreateThunkExecutor);
 BENCHMARK_THUNK_EXECUTOR(BM_SequentialThunkExecutor);
 BENCHMARK_THUNK_EXECUTOR(BM_SyncThunkExecutor);
 BENCHMARK_THUNK_EXECUTOR(BM_AsyncThunkExecutor);
+BENCHMARK_THUNK_EXECUTOR(BM_AsyncThunkExecutorWithStatePool);
 
 }  // namespace
 }  // namespace xla::cpu
@@ -42,6 +42,7 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/custom_call_thunk.h"
 #include "xla/backends/cpu/runtime/dot_thunk.h"
 #include "xla/backends/cpu/runtime/fft_thunk.h"
+#include "xla/backends/cpu/runtime/gather_thunk.h"
 #include "xla/backends/cpu/runtime/infeed_thunk.h"
 #include "xla/backends/cpu/runtime/kernel_thunk.h"
 #include "xla/backends/cpu/runtime/logical_id_thunk.h"
@@ -120,6 +121,8 @@ static absl::StatusOr<Thunk::Kind> ProtoThunkToThunkKind(
       return Thunk::Kind::kDot;
     case ThunkProto::ImplCase::kFftThunk:
       return Thunk::Kind::kFft;
+    case ThunkProto::ImplCase::kGatherThunk:
+      return Thunk::Kind::kGather;
     case ThunkProto::ImplCase::kInfeedThunk:
       return Thunk::Kind::kInfeed;
     case ThunkProto::ImplCase::kKernelThunk:
@@ -482,6 +485,21 @@ static absl::Status ToProto(const CopyThunk& thunk, ThunkProto& proto) {
   return absl::OkStatus();
 }
 
+static absl::Status ToProto(const GatherThunk& thunk, ThunkProto& proto) {
+  GatherThunkProto* gather_thunk_proto = proto.mutable_gather_thunk();
+
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.operand_buffer(), thunk.operand_shape(),
+      gather_thunk_proto->mutable_operand_buffer_shape()));
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.indices_buffer(), thunk.indices_shape(),
+      gather_thunk_proto->mutable_indices_buffer_shape()));
+  TF_RETURN_IF_ERROR(SerializeSliceShapeIntoProto(
+      thunk.output_buffer(), thunk.output_shape(),
+      gather_thunk_proto->mutable_output_buffer_shape()));
+  return absl::OkStatus();
+}
+
 static absl::Status ToProto(const CustomCallThunk& thunk, ThunkProto& proto) {
   CustomCallThunkProto* custom_call_thunk_proto =
       proto.mutable_custom_call_thunk();
@@ -712,6 +730,13 @@ static absl::Status ToProto(const XnnDotThunk& thunk, ThunkProto& proto) {
       xnn_dot_thunk_proto->mutable_out_buffer_shape()));
   proto.mutable_xnn_fusion_thunk()->mutable_options()->set_use_threadpool(
       thunk.options().use_threadpool);
+  proto.mutable_xnn_fusion_thunk()
+      ->mutable_options()
+      ->set_use_numa_aware_partitioning(
+          thunk.options().use_numa_aware_partitioning);
+  proto.mutable_xnn_fusion_thunk()
+      ->mutable_options()
+      ->set_use_adaptive_tile_size(thunk.options().use_adaptive_tile_size);
   return absl::OkStatus();
 }
 
@@ -745,6 +770,13 @@ static absl::Status ToProto(const XnnConvolutionThunk& thunk,
 
   proto.mutable_xnn_fusion_thunk()->mutable_options()->set_use_threadpool(
       thunk.options().use_threadpool);
+  proto.mutable_xnn_fusion_thunk()
+      ->mutable_options()
+      ->set_use_numa_aware_partitioning(
+          thunk.options().use_numa_aware_partitioning);
+  proto.mutable_xnn_fusion_thunk()
+      ->mutable_options()
+      ->set_use_adaptive_tile_size(thunk.options().use_adaptive_tile_size);
 
   return absl::OkStatus();
 }
@@ -868,6 +900,10 @@ absl::StatusOr<ThunkProto> ThunkSerDesProtobuf::ToProto(
       TF_RETURN_IF_ERROR(
           ::xla::cpu::ToProto(tsl::down_cast<const FftThunk&>(thunk), proto));
       break;
+    case Thunk::Kind::kGather:
+      TF_RETURN_IF_ERROR(::xla::cpu::ToProto(
+          tsl::down_cast<const GatherThunk&>(thunk), proto));
+      break;
     case Thunk::Kind::kRngGetAndUpdateState:
       TF_RETURN_IF_ERROR(::xla::cpu::ToProto(
           tsl::down_cast<const RngGetAndUpdateStateThunk&>(thunk), proto));
@@ -1146,6 +1182,33 @@ static absl::StatusOr<std::unique_ptr<CopyThunk>> CopyThunkFromProto(
                            std::move(dst_buffer), dst_shape);
 }
 
+static absl::StatusOr<std::unique_ptr<GatherThunk>> GatherThunkFromProto(
+    const ThunkProto& proto,
+    const std::vector<BufferAllocation>& buffer_allocations) {
+  TF_ASSIGN_OR_RETURN(Thunk::Info info, ThunkInfoFromProto(proto.info()));
+
+  TF_ASSIGN_OR_RETURN(
+      auto operand_slice_shape,
+      DeserializeSliceShapeFromProto(
+          proto.gather_thunk().operand_buffer_shape(), buffer_allocations));
+  TF_ASSIGN_OR_RETURN(
+      auto indices_slice_shape,
+      DeserializeSliceShapeFromProto(
+          proto.gather_thunk().indices_buffer_shape(), buffer_allocations));
+  TF_ASSIGN_OR_RETURN(
+      auto output_slice_shape,
+      DeserializeSliceShapeFromProto(proto.gather_thunk().output_buffer_shape(),
+                                     buffer_allocations));
+
+  const auto& [operand_buffer, operand_shape] = operand_slice_shape;
+  const auto& [indices_buffer, indices_shape] = indices_slice_shape;
+  const auto& [output_buffer, output_shape] = output_slice_shape;
+
+  return GatherThunk::Create(std::move(info), operand_buffer, operand_shape,
+                             indices_buffer, indices_shape, output_buffer,
+                             output_shape);
+}
+
 static absl::StatusOr<std::unique_ptr<CustomCallThunk>>
 CustomCallThunkFromProto(
     const ThunkProto& proto,
@@ -1477,6 +1540,8 @@ static absl::StatusOr<std::unique_ptr<XnnDotThunk>> XnnDotThunkFromProto(
 
   XnnDotThunk::Options options = {
       proto.xnn_fusion_thunk().options().use_threadpool(),
+      proto.xnn_fusion_thunk().options().use_numa_aware_partitioning(),
+      proto.xnn_fusion_thunk().options().use_adaptive_tile_size(),
   };
 
   TF_ASSIGN_OR_RETURN(
@@ -1514,6 +1579,8 @@ XnnConvolutionThunkFromProto(
 
   XnnConvolutionThunk::Options options = {
       proto.xnn_fusion_thunk().options().use_threadpool(),
+      proto.xnn_fusion_thunk().options().use_numa_aware_partitioning(),
+      proto.xnn_fusion_thunk().options().use_adaptive_tile_size(),
   };
 
   const auto& conv_proto = proto.xnn_fusion_thunk().xnn_convolution_thunk();
@@ -1622,6 +1689,8 @@ absl::StatusOr<std::unique_ptr<Thunk>> ThunkSerDesProtobuf::FromProto(
       return DotThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kFft:
       return FftThunkFromProto(proto, *buffer_allocations_);
+    case Thunk::Kind::kGather:
+      return GatherThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kInfeed:
       return InfeedThunkFromProto(proto, *buffer_allocations_);
     case Thunk::Kind::kKernel:
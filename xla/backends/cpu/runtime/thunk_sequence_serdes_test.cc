@@ -39,6 +39,7 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/custom_call_thunk.h"
 #include "xla/backends/cpu/runtime/dot_thunk.h"
 #include "xla/backends/cpu/runtime/fft_thunk.h"
+#include "xla/backends/cpu/runtime/gather_thunk.h"
 #include "xla/backends/cpu/runtime/infeed_thunk.h"
 #include "xla/backends/cpu/runtime/kernel_thunk.h"
 #include "xla/backends/cpu/runtime/logical_id_thunk.h"
@@ -131,6 +132,7 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateCustomCallThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateDotThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateFftThunk());
+    TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateGatherThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateInfeedThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(), CreateOutfeedThunk());
     TF_ASSIGN_OR_RETURN(thunk_sequence.emplace_back(),
@@ -421,6 +423,25 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
         /*out_shape=*/literals_[buffer_allocations_.size() - 1].shape());
   }
 
+  absl::StatusOr<std::unique_ptr<Thunk>> CreateGatherThunk() {
+    TF_RETURN_IF_ERROR(AddBufferAllocations(3));
+
+    return GatherThunk::Create(
+        Thunk::Info(),
+        /*operand_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 3]),
+        /*operand_shape=*/literals_[buffer_allocations_.size() - 3].shape(),
+        /*indices_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 2]),
+        /*indices_shape=*/ShapeUtil::MakeShape(S32, {2}),
+        /*output_buffer=*/
+        CreateBufferAllocationSlice(
+            buffer_allocations_[buffer_allocations_.size() - 1]),
+        /*output_shape=*/literals_[buffer_allocations_.size() - 1].shape());
+  }
+
   absl::StatusOr<std::unique_ptr<Thunk>> CreateFftThunk() {
     TF_RETURN_IF_ERROR(AddBufferAllocations(2));
 
@@ -839,6 +860,19 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
                                     thunk_2.dst_buffer(), thunk_2.dst_shape());
   }
 
+  bool VerifyGatherThunkEquality(const GatherThunk& thunk_1,
+                                 const GatherThunk& thunk_2) {
+    return VerifySliceShapeEquality(
+               thunk_1.operand_buffer(), thunk_1.operand_shape(),
+               thunk_2.operand_buffer(), thunk_2.operand_shape()) &&
+           VerifySliceShapeEquality(
+               thunk_1.indices_buffer(), thunk_1.indices_shape(),
+               thunk_2.indices_buffer(), thunk_2.indices_shape()) &&
+           VerifySliceShapeEquality(
+               thunk_1.output_buffer(), thunk_1.output_shape(),
+               thunk_2.output_buffer(), thunk_2.output_shape());
+  }
+
   bool VerifyConditionalThunkEquality(const ConditionalThunk& thunk_1,
                                       const ConditionalThunk& thunk_2) {
     return VerifySliceEquality(thunk_1.branch_index_buffer(),
@@ -1064,7 +1098,11 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
                       thunk_2.dot_dimensions().rhs_contracting_dimensions());
 
     const bool are_options_equal =
-        thunk_1.options().use_threadpool == thunk_2.options().use_threadpool;
+        thunk_1.options().use_threadpool == thunk_2.options().use_threadpool &&
+        thunk_1.options().use_numa_aware_partitioning ==
+            thunk_2.options().use_numa_aware_partitioning &&
+        thunk_1.options().use_adaptive_tile_size ==
+            thunk_2.options().use_adaptive_tile_size;
 
     return are_options_equal && are_dot_dimensions_equal &&
            VerifySliceShapeEquality(thunk_1.dot_slices().lhs_buffer,
@@ -1103,7 +1141,11 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
             thunk_2.dnums().output_feature_dimension();
 
     const bool are_options_equal =
-        thunk_1.options().use_threadpool == thunk_2.options().use_threadpool;
+        thunk_1.options().use_threadpool == thunk_2.options().use_threadpool &&
+        thunk_1.options().use_numa_aware_partitioning ==
+            thunk_2.options().use_numa_aware_partitioning &&
+        thunk_1.options().use_adaptive_tile_size ==
+            thunk_2.options().use_adaptive_tile_size;
 
     const bool are_windows_equal = absl::c_equal(
         thunk_1.window().dimensions(), thunk_2.window().dimensions(),
@@ -1278,6 +1320,10 @@ class ThunkSequenceSerdesTest : public ::testing::Test {
         return VerifyCopyThunkEquality(
             tsl::down_cast<const CopyThunk&>(thunk_1),
             tsl::down_cast<const CopyThunk&>(thunk_2));
+      case Thunk::Kind::kGather:
+        return VerifyGatherThunkEquality(
+            tsl::down_cast<const GatherThunk&>(thunk_1),
+            tsl::down_cast<const GatherThunk&>(thunk_2));
       case Thunk::Kind::kConditional:
         return VerifyConditionalThunkEquality(
             tsl::down_cast<const ConditionalThunk&>(thunk_1),
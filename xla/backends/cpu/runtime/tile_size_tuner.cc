@@ -0,0 +1,135 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/tile_size_tuner.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/algorithm/container.h"
+#include "absl/synchronization/mutex.h"
+#include "xla/tsl/lib/math/math_util.h"
+
+namespace xla::cpu {
+
+TileSizeTuner::TileSizeTuner(size_t min_tile_size)
+    : min_tile_size_(min_tile_size) {}
+
+TileSizeTuner* TileSizeTuner::Default() {
+  static auto* tuner = new TileSizeTuner();
+  return tuner;
+}
+
+size_t TileSizeTuner::AdjustTileSize(size_t tile_size, size_t min_tile_size) {
+  if (tile_size == 0) return min_tile_size;
+  size_t adjusted_tile_size = tile_size;
+  while (adjusted_tile_size < min_tile_size) adjusted_tile_size += tile_size;
+  return adjusted_tile_size;
+}
+
+TileSizeTuner::State TileSizeTuner::CreateState(const Loop& loop) const {
+  State state;
+
+  // We start with candidates smaller than the default tile size, as small
+  // inference loops often can't saturate all threads with the default one.
+  size_t default_tile_j = AdjustTileSize(loop.tile_j, min_tile_size_);
+  size_t tile_j = AdjustTileSize(loop.tile_j, default_tile_j / 4);
+
+  // We keep adding candidates while they produce at least two tasks, as
+  // larger tiles would degenerate into a single-threaded loop.
+  auto num_tasks = [&](size_t tile_j) {
+    return loop.range_i * tsl::MathUtil::CeilOfRatio(loop.range_j, tile_j);
+  };
+
+  while (state.candidates.size() < kMaxCandidates &&
+         (state.candidates.empty() || num_tasks(tile_j) >= 2)) {
+    state.candidates.push_back(Candidate{tile_j});
+    tile_j *= 2;
+  }
+
+  // Nothing to tune, we converged on the only candidate.
+  if (state.candidates.size() == 1) {
+    state.best_tile_j = state.candidates.front().tile_j;
+  }
+
+  return state;
+}
+
+TileSizeTuner::TileSize TileSizeTuner::GetTileSize(const Loop& loop) {
+  absl::MutexLock lock(&mu_);
+
+  auto it = loops_.find(loop);
+  if (it == loops_.end()) {
+    // If we reached the limit of tuned loops fall back on the default tile.
+    if (loops_.size() >= kMaxLoops) {
+      return {AdjustTileSize(loop.tile_j, min_tile_size_), false};
+    }
+    it = loops_.emplace(loop, CreateState(loop)).first;
+  }
+
+  State& state = it->second;
+  if (state.best_tile_j) return {state.best_tile_j, false};
+
+  // Round-robin across candidates to reduce the impact of the noise.
+  size_t index = state.next_candidate++ % state.candidates.size();
+  return {state.candidates[index].tile_j, true};
+}
+
+void TileSizeTuner::RecordDuration(const Loop& loop, size_t tile_j,
+                                   int64_t duration_ns) {
+  absl::MutexLock lock(&mu_);
+
+  auto it = loops_.find(loop);
+  if (it == loops_.end() || it->second.best_tile_j) return;
+
+  State& state = it->second;
+  auto candidate = absl::c_find_if(state.candidates, [&](const Candidate& c) {
+    return c.tile_j == tile_j;
+  });
+  if (candidate == state.candidates.end()) return;
+
+  // We keep the minimum duration as it's the most robust to the noise from
+  // other work running concurrently in the same thread pool.
+  candidate->min_duration_ns =
+      candidate->num_samples++ ? std::min(candidate->min_duration_ns,
+                                          duration_ns)
+                               : duration_ns;
+
+  // Check if we collected enough samples for all candidates.
+  bool done = absl::c_all_of(state.candidates, [](const Candidate& c) {
+    return c.num_samples >= kNumSamples;
+  });
+  if (!done) return;
+
+  state.best_tile_j =
+      absl::c_min_element(state.candidates, [](const Candidate& a,
+                                               const Candidate& b) {
+        return a.min_duration_ns < b.min_duration_ns;
+      })->tile_j;
+}
+
+size_t TileSizeTuner::converged_tile_size(const Loop& loop) const {
+  absl::MutexLock lock(&mu_);
+  auto it = loops_.find(loop);
+  return it == loops_.end() ? 0 : it->second.best_tile_j;
+}
+
+size_t TileSizeTuner::num_loops() const {
+  absl::MutexLock lock(&mu_);
+  return loops_.size();
+}
+
+}  // namespace xla::cpu
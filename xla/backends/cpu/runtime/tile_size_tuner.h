@@ -0,0 +1,117 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_TILE_SIZE_TUNER_H_
+#define XLA_BACKENDS_CPU_RUNTIME_TILE_SIZE_TUNER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/synchronization/mutex.h"
+
+namespace xla::cpu {
+
+// Tile size tuner learns the tile size for dynamic parallel loops that
+// minimizes the loop execution time. Tile sizes are tuned for each call site
+// identified by a kernel pointer and loop dimensions.
+//
+// For each new call site the tuner explores a small set of candidate tile sizes
+// (multiples of the default tile size), measures the loop execution time for
+// each candidate a few times, and then converges on the fastest one. After
+// convergence the tuner doesn't ask for measurements anymore and the only
+// run time overhead is the table lookup.
+//
+// Tile size tuner is thread safe.
+class TileSizeTuner {
+ public:
+  // Parallel loop dimensions, unused dimensions must be set to 1.
+  struct Loop {
+    const void* kernel = nullptr;
+    size_t range_i = 1;
+    size_t range_j = 1;
+    size_t tile_j = 1;
+
+    template <typename H>
+    friend H AbslHashValue(H h, const Loop& loop) {
+      return H::combine(std::move(h), loop.kernel, loop.range_i, loop.range_j,
+                        loop.tile_j);
+    }
+
+    friend bool operator==(const Loop& a, const Loop& b) {
+      return a.kernel == b.kernel && a.range_i == b.range_i &&
+             a.range_j == b.range_j && a.tile_j == b.tile_j;
+    }
+  };
+
+  struct TileSize {
+    size_t tile_j;
+    // If true, the caller must measure loop execution time and report it back
+    // to the tuner via `RecordDuration`.
+    bool measure;
+  };
+
+  static constexpr size_t kMaxCandidates = 6;
+  static constexpr size_t kNumSamples = 3;
+  static constexpr size_t kMaxLoops = 4096;
+
+  // Candidate tile sizes start at the original tile size adjusted to be at
+  // least `min_tile_size`.
+  explicit TileSizeTuner(size_t min_tile_size = 128);
+
+  // Returns a process-wide tile size tuner.
+  static TileSizeTuner* Default();
+
+  // Returns the tile size to use for the next execution of the `loop`.
+  TileSize GetTileSize(const Loop& loop);
+
+  // Records the execution time of the `loop` with the given tile size.
+  void RecordDuration(const Loop& loop, size_t tile_j, int64_t duration_ns);
+
+  // Returns the tile size tuned for the `loop` or 0 if not converged yet.
+  size_t converged_tile_size(const Loop& loop) const;
+
+  size_t num_loops() const;
+
+  // Returns the default tile size that is at least `min_tile_size`.
+  static size_t AdjustTileSize(size_t tile_size, size_t min_tile_size);
+
+ private:
+  struct Candidate {
+    size_t tile_j;
+    size_t num_samples = 0;
+    int64_t min_duration_ns = 0;
+  };
+
+  struct State {
+    absl::InlinedVector<Candidate, kMaxCandidates> candidates;
+    size_t next_candidate = 0;
+    size_t best_tile_j = 0;  // non-zero when converged
+  };
+
+  State CreateState(const Loop& loop) const;
+
+  size_t min_tile_size_;
+
+  mutable absl::Mutex mu_;
+  absl::flat_hash_map<Loop, State> loops_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_TILE_SIZE_TUNER_H_
@@ -0,0 +1,85 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/tile_size_tuner.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#include "xla/tsl/platform/test.h"
+
+namespace xla::cpu {
+namespace {
+
+static int kernel;  // used as a unique kernel address
+
+TEST(TileSizeTunerTest, AdjustTileSize) {
+  EXPECT_EQ(TileSizeTuner::AdjustTileSize(1, 128), 128);
+  EXPECT_EQ(TileSizeTuner::AdjustTileSize(48, 128), 144);
+  EXPECT_EQ(TileSizeTuner::AdjustTileSize(256, 128), 256);
+}
+
+TEST(TileSizeTunerTest, ConvergesToFastestTileSize) {
+  TileSizeTuner tuner(/*min_tile_size=*/128);
+  TileSizeTuner::Loop loop = {&kernel, /*range_i=*/1, /*range_j=*/4096,
+                              /*tile_j=*/1};
+
+  // Pretend that the 256 tile size is the fastest one.
+  auto duration = [](size_t tile_j) -> int64_t {
+    return tile_j == 256 ? 100 : 200;
+  };
+
+  for (size_t i = 0; i < 1000 && !tuner.converged_tile_size(loop); ++i) {
+    TileSizeTuner::TileSize tile_size = tuner.GetTileSize(loop);
+    ASSERT_TRUE(tile_size.measure);
+    ASSERT_GE(tile_size.tile_j, 32);
+    tuner.RecordDuration(loop, tile_size.tile_j, duration(tile_size.tile_j));
+  }
+
+  EXPECT_EQ(tuner.converged_tile_size(loop), 256);
+  EXPECT_EQ(tuner.num_loops(), 1);
+
+  // After convergence tuner doesn't ask for measurements.
+  TileSizeTuner::TileSize tile_size = tuner.GetTileSize(loop);
+  EXPECT_EQ(tile_size.tile_j, 256);
+  EXPECT_FALSE(tile_size.measure);
+}
+
+TEST(TileSizeTunerTest, SingleCandidate) {
+  TileSizeTuner tuner(/*min_tile_size=*/128);
+  TileSizeTuner::Loop loop = {&kernel, /*range_i=*/1, /*range_j=*/16,
+                              /*tile_j=*/1};
+
+  // Loop is too small to be split into multiple tasks, nothing to tune.
+  TileSizeTuner::TileSize tile_size = tuner.GetTileSize(loop);
+  EXPECT_EQ(tile_size.tile_j, 32);
+  EXPECT_FALSE(tile_size.measure);
+  EXPECT_EQ(tuner.converged_tile_size(loop), 32);
+}
+
+TEST(TileSizeTunerTest, IgnoresUnknownTileSize) {
+  TileSizeTuner tuner(/*min_tile_size=*/128);
+  TileSizeTuner::Loop loop = {&kernel, /*range_i=*/8, /*range_j=*/4096,
+                              /*tile_j=*/1};
+
+  TileSizeTuner::TileSize tile_size = tuner.GetTileSize(loop);
+  ASSERT_TRUE(tile_size.measure);
+
+  tuner.RecordDuration(loop, /*tile_j=*/3, /*duration_ns=*/1);
+  EXPECT_EQ(tuner.converged_tile_size(loop), 0);
+}
+
+}  // namespace
+}  // namespace xla::cpu
@@ -0,0 +1,192 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/topk_lib.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "absl/base/casts.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+
+namespace xla::cpu {
+
+namespace {
+
+// Converts a float value to an integer key that has a total order
+// -NaN < -Inf < -0 < +0 < +Inf < +NaN. For negative values we flip all bits
+// except the sign bit, so that larger magnitude negative values have smaller
+// keys. Conversion is branchless and vectorizable.
+inline int32_t ToKey(float value) {
+  int32_t x = absl::bit_cast<int32_t>(value);
+  return x ^ ((x >> 31) & std::numeric_limits<int32_t>::max());
+}
+
+struct Candidate {
+  int32_t key;
+  int32_t index;
+};
+
+// Returns true if candidate `a` must be ordered before candidate `b`.
+inline bool Better(const Candidate& a, const Candidate& b) {
+  return a.key > b.key || (a.key == b.key && a.index < b.index);
+}
+
+void WriteOutput(const float* values, absl::Span<const Candidate> candidates,
+                 float* out_values, int32_t* out_indices) {
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    out_indices[i] = candidates[i].index;
+    out_values[i] = values[candidates[i].index];
+  }
+}
+
+void PartialSortTopK(int64_t input_size, int64_t k, const float* values,
+                     float* out_values, int32_t* out_indices) {
+  std::vector<int32_t> indices(input_size);
+  std::iota(indices.begin(), indices.end(), 0);
+
+  std::partial_sort(indices.begin(), indices.begin() + k, indices.end(),
+                    [values](int32_t i1, int32_t i2) {
+                      return Better({ToKey(values[i1]), i1},
+                                    {ToKey(values[i2]), i2});
+                    });
+
+  std::copy(indices.begin(), indices.begin() + k, out_indices);
+  for (int64_t i = 0; i < k; ++i) out_values[i] = values[indices[i]];
+}
+
+void HeapTopK(int64_t input_size, int64_t k, const float* values,
+              float* out_values, int32_t* out_indices) {
+  // With a `Better` comparator the root of the heap is the worst candidate.
+  std::vector<Candidate> heap(k);
+  for (int32_t i = 0; i < k; ++i) heap[i] = {ToKey(values[i]), i};
+  std::make_heap(heap.begin(), heap.end(), Better);
+
+  for (int32_t i = k; i < input_size; ++i) {
+    // Elements with a key equal to the root key always lose because they have
+    // a larger index than all elements in the heap.
+    int32_t key = ToKey(values[i]);
+    if (key <= heap.front().key) continue;
+
+    std::pop_heap(heap.begin(), heap.end(), Better);
+    heap.back() = {key, i};
+    std::push_heap(heap.begin(), heap.end(), Better);
+  }
+
+  std::sort_heap(heap.begin(), heap.end(), Better);
+  WriteOutput(values, heap, out_values, out_indices);
+}
+
+void ThresholdTopK(int64_t input_size, int64_t k, const float* values,
+                   float* out_values, int32_t* out_indices) {
+  static constexpr int64_t kBlockSize = 64;
+
+  // We compact candidates back to `k` when we collect `2 * k` of them, which
+  // amortizes the cost of partial selection over the scanned elements.
+  const size_t max_candidates = 2 * k;
+
+  std::vector<Candidate> candidates;
+  candidates.reserve(max_candidates + kBlockSize);
+
+  for (int32_t i = 0; i < k; ++i) candidates.push_back({ToKey(values[i]), i});
+
+  // Keeps the best `k` candidates and returns the key of the k-th one.
+  auto compact = [&] {
+    std::nth_element(candidates.begin(), candidates.begin() + (k - 1),
+                     candidates.end(), Better);
+    candidates.resize(k);
+    return candidates.back().key;
+  };
+
+  // Candidates with a key equal to the threshold always lose to the k-th best
+  // candidate because they have a larger index.
+  int32_t threshold = compact();
+
+  for (int64_t begin = k; begin < input_size; begin += kBlockSize) {
+    int64_t end = std::min(begin + kBlockSize, input_size);
+
+    // Skip the block if it doesn't have any values above the threshold. This
+    // is the hot loop for large inputs, and it's a simple max reduction.
+    int32_t block_max = std::numeric_limits<int32_t>::min();
+    for (int64_t i = begin; i < end; ++i) {
+      block_max = std::max(block_max, ToKey(values[i]));
+    }
+    if (block_max <= threshold) continue;
+
+    for (int64_t i = begin; i < end; ++i) {
+      int32_t key = ToKey(values[i]);
+      if (key > threshold) {
+        candidates.push_back({key, static_cast<int32_t>(i)});
+      }
+    }
+
+    if (candidates.size() >= max_candidates) threshold = compact();
+  }
+
+  compact();
+  std::sort(candidates.begin(), candidates.end(), Better);
+  WriteOutput(values, candidates, out_values, out_indices);
+}
+
+}  // namespace
+
+absl::string_view TopKAlgorithmName(TopKAlgorithm algorithm) {
+  switch (algorithm) {
+    case TopKAlgorithm::kPartialSort:
+      return "partial-sort";
+    case TopKAlgorithm::kHeap:
+      return "heap";
+    case TopKAlgorithm::kThreshold:
+      return "threshold";
+  }
+}
+
+TopKAlgorithm ChooseTopKAlgorithm(int64_t input_size, int64_t k) {
+  // For small inputs and large `k` there is not much to gain from avoiding
+  // comparisons for elements that are not in the top `k`.
+  if (input_size <= 256 || 8 * k >= input_size) {
+    return TopKAlgorithm::kPartialSort;
+  }
+
+  // For large inputs most blocks do not have any candidates above the
+  // threshold, and we can skip them with a single max reduction.
+  if (input_size >= 64 * k) {
+    return TopKAlgorithm::kThreshold;
+  }
+
+  return TopKAlgorithm::kHeap;
+}
+
+void TopK(TopKAlgorithm algorithm, int64_t input_size, int64_t k,
+          const float* values, float* out_values, int32_t* out_indices) {
+  k = std::min(k, input_size);
+  if (k <= 0) return;
+
+  switch (algorithm) {
+    case TopKAlgorithm::kPartialSort:
+      return PartialSortTopK(input_size, k, values, out_values, out_indices);
+    case TopKAlgorithm::kHeap:
+      return HeapTopK(input_size, k, values, out_values, out_indices);
+    case TopKAlgorithm::kThreshold:
+      return ThresholdTopK(input_size, k, values, out_values, out_indices);
+  }
+}
+
+}  // namespace xla::cpu
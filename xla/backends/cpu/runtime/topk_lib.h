@@ -0,0 +1,59 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_TOPK_LIB_H_
+#define XLA_BACKENDS_CPU_RUNTIME_TOPK_LIB_H_
+
+#include <cstdint>
+
+#include "absl/strings/string_view.h"
+
+namespace xla::cpu {
+
+// Algorithms for selecting the top `k` elements from a row of `n` values. All
+// algorithms produce identical results: values are ordered using the total
+// order -NaN < -Inf < -0 < +0 < +Inf < +NaN, and ties are broken in favor of
+// the smaller index.
+enum class TopKAlgorithm {
+  // Partial sort of all indices, best when `k` is close to `n`.
+  kPartialSort,
+
+  // Min-heap of the best `k` elements seen so far, every element is compared
+  // against the heap root (the current k-th best element).
+  kHeap,
+
+  // Scan values in fixed-size blocks and skip blocks that do not have any
+  // value above the current threshold (the k-th best element), remaining
+  // candidates are periodically compacted with a partial selection. Best for
+  // large `n` and small `k`, as almost all blocks are skipped with a simple
+  // vectorizable max reduction.
+  kThreshold,
+};
+
+absl::string_view TopKAlgorithmName(TopKAlgorithm algorithm);
+
+// Returns the algorithm that is expected to be the fastest one for the given
+// input size and `k`.
+TopKAlgorithm ChooseTopKAlgorithm(int64_t input_size, int64_t k);
+
+// Selects the top `k` values from `input_size` values (a single row) and
+// writes them sorted in descending order to `out_values` together with their
+// indices in `out_indices`.
+void TopK(TopKAlgorithm algorithm, int64_t input_size, int64_t k,
+          const float* values, float* out_values, int32_t* out_indices);
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_TOPK_LIB_H_
@@ -0,0 +1,147 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/topk_lib.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/test_benchmark.h"
+
+namespace xla::cpu {
+namespace {
+
+using ::testing::ElementsAre;
+
+static constexpr TopKAlgorithm kAlgorithms[] = {TopKAlgorithm::kPartialSort,
+                                                TopKAlgorithm::kHeap,
+                                                TopKAlgorithm::kThreshold};
+
+TEST(TopKLibTest, ChooseAlgorithm) {
+  EXPECT_EQ(ChooseTopKAlgorithm(64, 4), TopKAlgorithm::kPartialSort);
+  EXPECT_EQ(ChooseTopKAlgorithm(1024, 512), TopKAlgorithm::kPartialSort);
+  EXPECT_EQ(ChooseTopKAlgorithm(1024, 64), TopKAlgorithm::kHeap);
+  EXPECT_EQ(ChooseTopKAlgorithm(256 * 1024, 64), TopKAlgorithm::kThreshold);
+}
+
+TEST(TopKLibTest, TotalOrder) {
+  float inf = std::numeric_limits<float>::infinity();
+  float nan = std::numeric_limits<float>::quiet_NaN();
+
+  std::vector<float> values = {1.0f, -inf, -0.0f, nan, 0.0f, inf, -nan, 1.0f};
+
+  for (TopKAlgorithm algorithm : kAlgorithms) {
+    std::vector<float> out_values(values.size());
+    std::vector<int32_t> out_indices(values.size());
+    TopK(algorithm, values.size(), values.size(), values.data(),
+         out_values.data(), out_indices.data());
+
+    // +NaN > +Inf > 1 == 1 > +0 > -0 > -Inf > -NaN.
+    EXPECT_THAT(out_indices, ElementsAre(3, 5, 0, 7, 4, 2, 1, 6))
+        << TopKAlgorithmName(algorithm);
+  }
+}
+
+TEST(TopKLibTest, AlgorithmsProduceIdenticalResults) {
+  std::minstd_rand0 engine;
+
+  for (int64_t input_size : {100, 1000, 10000, 100000}) {
+    for (int64_t k : {1, 8, 64, 100}) {
+      // Use a small range of values to get a lot of ties.
+      std::uniform_int_distribution<int32_t> distribution(0, 1000);
+      std::vector<float> values(input_size);
+      for (float& value : values) value = distribution(engine);
+
+      std::vector<float> expected_values(k);
+      std::vector<int32_t> expected_indices(k);
+      TopK(TopKAlgorithm::kPartialSort, input_size, k, values.data(),
+           expected_values.data(), expected_indices.data());
+
+      for (TopKAlgorithm algorithm : kAlgorithms) {
+        std::vector<float> out_values(k);
+        std::vector<int32_t> out_indices(k);
+        TopK(algorithm, input_size, k, values.data(), out_values.data(),
+             out_indices.data());
+
+        EXPECT_EQ(out_values, expected_values)
+            << TopKAlgorithmName(algorithm) << " input_size=" << input_size
+            << " k=" << k;
+        EXPECT_EQ(out_indices, expected_indices)
+            << TopKAlgorithmName(algorithm) << " input_size=" << input_size
+            << " k=" << k;
+      }
+    }
+  }
+}
+
+TEST(TopKLibTest, AscendingInput) {
+  // Ascending input is the worst case for the threshold algorithm, as every
+  // block has new candidates.
+  std::vector<float> values(10000);
+  for (size_t i = 0; i < values.size(); ++i) values[i] = i;
+
+  for (TopKAlgorithm algorithm : kAlgorithms) {
+    std::vector<float> out_values(4);
+    std::vector<int32_t> out_indices(4);
+    TopK(algorithm, values.size(), 4, values.data(), out_values.data(),
+         out_indices.data());
+    EXPECT_THAT(out_indices, ElementsAre(9999, 9998, 9997, 9996));
+    EXPECT_THAT(out_values, ElementsAre(9999.0f, 9998.0f, 9997.0f, 9996.0f));
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Performance benchmarks.
+//===----------------------------------------------------------------------===//
+
+static void BM_TopK(benchmark::State& state) {
+  TopKAlgorithm algorithm = static_cast<TopKAlgorithm>(state.range(0));
+  int64_t input_size = state.range(1);
+  int64_t k = state.range(2);
+
+  std::minstd_rand0 engine;
+  std::normal_distribution<float> distribution(0.0f, 1.0f);
+  std::vector<float> values(input_size);
+  for (float& value : values) value = distribution(engine);
+
+  std::vector<float> out_values(k);
+  std::vector<int32_t> out_indices(k);
+
+  for (auto _ : state) {
+    TopK(algorithm, input_size, k, values.data(), out_values.data(),
+         out_indices.data());
+    benchmark::DoNotOptimize(out_values);
+    benchmark::DoNotOptimize(out_indices);
+  }
+}
+
+static void TopKArgs(benchmark::internal::Benchmark* bench) {
+  bench->ArgNames({"algorithm", "input_size", "k"});
+  for (int64_t algorithm : {0, 1, 2}) {
+    for (int64_t input_size : {4096, 256 * 1024}) {
+      for (int64_t k : {1, 16, 64}) {
+        bench->Args({algorithm, input_size, k});
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_TopK)->Apply(TopKArgs);
+
+}  // namespace
+}  // namespace xla::cpu
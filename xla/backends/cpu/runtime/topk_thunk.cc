@@ -15,21 +15,33 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/topk_thunk.h"
 
+#define EIGEN_USE_THREADS
+
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <utility>
 
+#include "absl/base/dynamic_annotations.h"
 #include "absl/memory/memory.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_format.h"
+#include "unsupported/Eigen/CXX11/Tensor"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/topk_lib.h"
 #include "xla/service/buffer_assignment.h"
-#include "xla/service/cpu/runtime_topk.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
+#include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
 
 namespace xla::cpu {
 
+// Minimum number of input elements processed by a single task when we run
+// TopK rows in parallel, to amortize the cost of scheduling tasks.
+static constexpr int64_t kMinElementsPerTask = 64 * 1024;
+
 TopKThunk::TopKThunk(Info info, BufferAllocation::Slice values,
                      BufferAllocation::Slice output,
                      BufferAllocation::Slice indices, int64_t batch_size,
@@ -40,7 +52,8 @@ TopKThunk::TopKThunk(Info info, BufferAllocation::Slice values,
       indices_buffer_(indices),
       batch_size_(batch_size),
       input_size_(input_size),
-      k_(k) {}
+      k_(k),
+      algorithm_(ChooseTopKAlgorithm(input_size, k)) {}
 
 absl::StatusOr<std::unique_ptr<TopKThunk>> TopKThunk::Create(
     Info info, BufferAllocation::Slice values, BufferAllocation::Slice output,
@@ -62,11 +75,61 @@ tsl::AsyncValueRef<Thunk::ExecuteEvent> TopKThunk::Execute(
       se::DeviceMemoryBase indices,
       params.buffer_allocations->GetDeviceAddress(indices_buffer_));
 
-  __xla_cpu_runtime_TopKF32(batch_size_, input_size_, k_,
-                            reinterpret_cast<const float*>(values.opaque()),
-                            reinterpret_cast<float*>(output.opaque()),
-                            reinterpret_cast<int32_t*>(indices.opaque()));
-  return OkExecuteEvent();
+  const float* values_data = reinterpret_cast<const float*>(values.opaque());
+  float* output_data = reinterpret_cast<float*>(output.opaque());
+  int32_t* indices_data = reinterpret_cast<int32_t*>(indices.opaque());
+
+  // Annotate memory that might have been initialized by jit-compiled code.
+  ABSL_ANNOTATE_MEMORY_IS_INITIALIZED(values.opaque(), values.size());
+
+  VLOG(3) << absl::StreamFormat(
+      "TopK: batch_size=%d input_size=%d k=%d algorithm=%s", batch_size_,
+      input_size_, k_, TopKAlgorithmName(algorithm_));
+
+  // Computes TopK for rows in the [begin, end) range.
+  auto topk = [=, algorithm = algorithm_, input_size = input_size_,
+               k = k_](int64_t begin, int64_t end) {
+    for (int64_t row = begin; row < end; ++row) {
+      TopK(algorithm, input_size, k, values_data + row * input_size,
+           output_data + row * k, indices_data + row * k);
+    }
+  };
+
+  int64_t num_tasks = 1;
+  if (params.intra_op_threadpool && batch_size_ > 1) {
+    int64_t max_tasks = batch_size_ * input_size_ / kMinElementsPerTask;
+    num_tasks = std::min<int64_t>(
+        {batch_size_, max_tasks,
+         params.intra_op_threadpool->numThreadsInPool()});
+  }
+
+  if (num_tasks <= 1) {
+    topk(0, batch_size_);
+    return OkExecuteEvent();
+  }
+
+  // Use intra-op thread pool to process rows in parallel.
+  auto event = tsl::MakeConstructedAsyncValueRef<ExecuteEvent>();
+  auto counter = std::make_shared<std::atomic<int64_t>>(num_tasks);
+
+  auto execute = [=, batch_size = batch_size_](int64_t task_index) {
+    topk(batch_size * task_index / num_tasks,
+         batch_size * (task_index + 1) / num_tasks);
+
+    if (counter->load() == 1 || counter->fetch_sub(1) == 1) {
+      event.SetStateConcrete();
+    }
+  };
+
+  for (int64_t i = 1; i < num_tasks; ++i) {
+    params.intra_op_threadpool->getPool()->Schedule(
+        [i, execute] { execute(i); });
+  }
+
+  // Process the first range of rows in the caller thread.
+  execute(0);
+
+  return event;
 }
 
 }  // namespace xla::cpu
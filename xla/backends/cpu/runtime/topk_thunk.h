@@ -21,6 +21,7 @@ limitations under the License.
 
 #include "absl/status/statusor.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/topk_lib.h"
 #include "xla/runtime/buffer_use.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
@@ -45,6 +46,8 @@ class TopKThunk final : public Thunk {
   int64_t input_size() const { return input_size_; }
   int64_t k() const { return k_; }
 
+  TopKAlgorithm algorithm() const { return algorithm_; }
+
   const BufferAllocation::Slice& values_buffer() const {
     return values_buffer_;
   }
@@ -66,6 +69,9 @@ class TopKThunk final : public Thunk {
   int64_t batch_size_;
   int64_t input_size_;
   int64_t k_;
+
+  // TopK algorithm selected based on the input size and `k`.
+  TopKAlgorithm algorithm_;
 };
 
 }  // namespace xla::cpu
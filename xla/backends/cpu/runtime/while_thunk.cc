@@ -44,10 +44,15 @@ namespace xla::cpu {
 absl::StatusOr<std::unique_ptr<WhileThunk>> WhileThunk::Create(
     Info info, BufferAllocation::Slice cond_buffer, ThunkSequence cond_sequence,
     ThunkSequence body_sequence, std::optional<int64_t> trip_count) {
+  // Loop condition and body are executed once per iteration, reuse execute
+  // states between iterations instead of allocating new ones every time.
+  ThunkExecutor::Options options;
+  options.use_execute_state_pool = true;
+
   TF_ASSIGN_OR_RETURN(ThunkExecutor cond_executor,
-                      ThunkExecutor::Create(std::move(cond_sequence)));
+                      ThunkExecutor::Create(std::move(cond_sequence), options));
   TF_ASSIGN_OR_RETURN(ThunkExecutor body_executor,
-                      ThunkExecutor::Create(std::move(body_sequence)));
+                      ThunkExecutor::Create(std::move(body_sequence), options));
   return absl::WrapUnique(new WhileThunk(std::move(info), cond_buffer,
                                          std::move(cond_executor),
                                          std::move(body_executor), trip_count));
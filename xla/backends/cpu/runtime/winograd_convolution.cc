@@ -0,0 +1,281 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/winograd_convolution.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include "Eigen/Core"
+#include "xla/backends/cpu/runtime/convolution_lib.h"
+
+namespace xla::cpu {
+
+// Winograd transformation matrices for F(m, 3) from "Fast Algorithms for
+// Convolutional Neural Networks" by Andrew Lavin and Scott Gray.
+template <int64_t m>
+struct WinogradMatrices;
+
+template <>
+struct WinogradMatrices<2> {
+  static constexpr float kBT[4][4] = {
+      {1, 0, -1, 0}, {0, 1, 1, 0}, {0, -1, 1, 0}, {0, 1, 0, -1}};
+  static constexpr float kG[4][3] = {
+      {1, 0, 0}, {0.5, 0.5, 0.5}, {0.5, -0.5, 0.5}, {0, 0, 1}};
+  static constexpr float kAT[2][4] = {{1, 1, 1, 0}, {0, 1, -1, -1}};
+};
+
+template <>
+struct WinogradMatrices<4> {
+  static constexpr float kBT[6][6] = {
+      {4, 0, -5, 0, 1, 0},  {0, -4, -4, 1, 1, 0}, {0, 4, -4, -1, 1, 0},
+      {0, -2, -1, 2, 1, 0}, {0, 2, -1, -2, 1, 0}, {0, 4, 0, -5, 0, 1}};
+  static constexpr float kG[6][3] = {{1.0f / 4, 0, 0},
+                                     {-1.0f / 6, -1.0f / 6, -1.0f / 6},
+                                     {-1.0f / 6, 1.0f / 6, -1.0f / 6},
+                                     {1.0f / 24, 1.0f / 12, 1.0f / 6},
+                                     {1.0f / 24, -1.0f / 12, 1.0f / 6},
+                                     {0, 0, 1}};
+  static constexpr float kAT[4][6] = {{1, 1, 1, 1, 1, 0},
+                                      {0, 1, -1, 2, -2, 0},
+                                      {0, 1, 1, 4, 4, 0},
+                                      {0, 1, -1, 8, -8, 1}};
+};
+
+// We use Winograd only if channels are large enough to amortize the cost of
+// input and output transformations in the matrix multiplications.
+static constexpr int64_t kMinChannels = 16;
+
+// Computes `out[i] += scale * in[i]` for `i` in `[0, n)`.
+static void Axpy(float scale, const float* __restrict in,
+                 float* __restrict out, int64_t n) {
+  if (scale == 0.0f) return;
+  for (int64_t i = 0; i < n; ++i) out[i] += scale * in[i];
+}
+
+static int64_t CeilDiv(int64_t a, int64_t b) { return (a + b - 1) / b; }
+
+bool WinogradConvolution::IsSupported(const ConvolutionCanonicalDims& dims) {
+  return dims.convolution_rank() == 2 && dims.feature_group_count == 1 &&
+         dims.kernel_dims.x == 3 && dims.kernel_dims.y == 3 &&
+         dims.strides.x == 1 && dims.strides.y == 1 &&
+         dims.base_dilation.x == 1 && dims.base_dilation.y == 1 &&
+         dims.window_dilation.x == 1 && dims.window_dilation.y == 1 &&
+         dims.kernel_channels == dims.input_channels &&
+         dims.input_channels >= kMinChannels &&
+         dims.kernel_filters >= kMinChannels && dims.output_dims.x >= 2 &&
+         dims.output_dims.y >= 2;
+}
+
+WinogradConvolution::OutputTile WinogradConvolution::SelectOutputTile(
+    const ConvolutionCanonicalDims& dims) {
+  return dims.output_dims.x >= 8 && dims.output_dims.y >= 8
+             ? OutputTile::kF4x3
+             : OutputTile::kF2x3;
+}
+
+template <int64_t m>
+static std::vector<float> TransformKernel(const ConvolutionCanonicalDims& dims,
+                                          const float* kernel) {
+  static constexpr int64_t a = m + 2;
+  const auto& kG = WinogradMatrices<m>::kG;
+
+  int64_t channels = dims.input_channels;
+  int64_t filters = dims.kernel_filters;
+
+  std::vector<float> transformed(a * a * channels * filters, 0.0f);
+  std::vector<float> tmp(a * 3 * filters);
+
+  // Kernel element `(kx, ky, c, f)` is at `((kx * 3 + ky) * C + c) * F + f`.
+  auto g = [&](int64_t kx, int64_t ky, int64_t c) {
+    return kernel + ((kx * 3 + ky) * channels + c) * filters;
+  };
+
+  for (int64_t c = 0; c < channels; ++c) {
+    // tmp = G g
+    std::fill(tmp.begin(), tmp.end(), 0.0f);
+    for (int64_t i = 0; i < a; ++i) {
+      for (int64_t ky = 0; ky < 3; ++ky) {
+        for (int64_t kx = 0; kx < 3; ++kx) {
+          Axpy(kG[i][kx], g(kx, ky, c), &tmp[(i * 3 + ky) * filters], filters);
+        }
+      }
+    }
+
+    // U = tmp G^T
+    for (int64_t i = 0; i < a; ++i) {
+      for (int64_t j = 0; j < a; ++j) {
+        float* u = &transformed[((i * a + j) * channels + c) * filters];
+        for (int64_t ky = 0; ky < 3; ++ky) {
+          Axpy(kG[j][ky], &tmp[(i * 3 + ky) * filters], u, filters);
+        }
+      }
+    }
+  }
+
+  return transformed;
+}
+
+WinogradConvolution WinogradConvolution::Create(
+    const ConvolutionCanonicalDims& dims, OutputTile output_tile,
+    const float* kernel) {
+  if (output_tile == OutputTile::kF4x3) {
+    return WinogradConvolution(dims, 4, TransformKernel<4>(dims, kernel));
+  }
+  return WinogradConvolution(dims, 2, TransformKernel<2>(dims, kernel));
+}
+
+int64_t WinogradConvolution::num_blocks() const {
+  int64_t num_tiles = dims_.input_batch * CeilDiv(dims_.output_dims.x, m_) *
+                      CeilDiv(dims_.output_dims.y, m_);
+  return CeilDiv(num_tiles, kTilesPerBlock);
+}
+
+void WinogradConvolution::Compute(const float* input, float* output,
+                                  int64_t block_begin,
+                                  int64_t block_end) const {
+  for (int64_t block = block_begin; block < block_end; ++block) {
+    if (m_ == 4) {
+      ComputeBlock<4>(input, output, block);
+    } else {
+      ComputeBlock<2>(input, output, block);
+    }
+  }
+}
+
+template <int64_t m>
+void WinogradConvolution::ComputeBlock(const float* input, float* output,
+                                       int64_t block) const {
+  static constexpr int64_t a = m + 2;
+  const auto& kBT = WinogradMatrices<m>::kBT;
+  const auto& kAT = WinogradMatrices<m>::kAT;
+
+  using RowMajorMatrix =
+      Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  const ConvolutionCanonicalDims& d = dims_;
+  int64_t channels = d.input_channels;
+  int64_t filters = d.kernel_filters;
+
+  int64_t tiles_x = CeilDiv(d.output_dims.x, m);
+  int64_t tiles_y = CeilDiv(d.output_dims.y, m);
+  int64_t num_tiles = d.input_batch * tiles_x * tiles_y;
+
+  int64_t tile_begin = block * kTilesPerBlock;
+  int64_t num_block_tiles = std::min(kTilesPerBlock, num_tiles - tile_begin);
+
+  // Transformed input and output tiles in `[a * a][kTilesPerBlock][C or F]`
+  // order, so that for each transformed tile element we compute a matrix
+  // multiplication of contiguous matrices.
+  thread_local std::vector<float> v, mm, tmp;
+  v.resize(a * a * kTilesPerBlock * channels);
+  mm.resize(a * a * kTilesPerBlock * filters);
+  tmp.resize(a * a * std::max(channels, filters));
+
+  auto tile_coords = [&](int64_t tile) {
+    int64_t b = tile / (tiles_x * tiles_y);
+    int64_t tx = (tile / tiles_y) % tiles_x;
+    int64_t ty = tile % tiles_y;
+    return std::make_tuple(b, tx, ty);
+  };
+
+  // Input transform: V = B^T d B.
+  for (int64_t t = 0; t < num_block_tiles; ++t) {
+    auto [b, tx, ty] = tile_coords(tile_begin + t);
+
+    // tmp = B^T d, where `d` is the input tile with zero padding.
+    std::fill(tmp.begin(), tmp.begin() + a * a * channels, 0.0f);
+    for (int64_t k = 0; k < a; ++k) {
+      int64_t ix = tx * m - d.padding_before.x + k;
+      if (ix < 0 || ix >= d.input_dims.x) continue;
+
+      for (int64_t j = 0; j < a; ++j) {
+        int64_t iy = ty * m - d.padding_before.y + j;
+        if (iy < 0 || iy >= d.input_dims.y) continue;
+
+        const float* in =
+            input +
+            ((b * d.input_dims.x + ix) * d.input_dims.y + iy) * channels;
+        for (int64_t i = 0; i < a; ++i) {
+          Axpy(kBT[i][k], in, &tmp[(i * a + j) * channels], channels);
+        }
+      }
+    }
+
+    // V = tmp B
+    for (int64_t i = 0; i < a; ++i) {
+      for (int64_t j = 0; j < a; ++j) {
+        float* out = &v[((i * a + j) * kTilesPerBlock + t) * channels];
+        std::fill(out, out + channels, 0.0f);
+        for (int64_t k = 0; k < a; ++k) {
+          Axpy(kBT[j][k], &tmp[(i * a + k) * channels], out, channels);
+        }
+      }
+    }
+  }
+
+  // Element-wise products in the Winograd domain: M = U * V.
+  for (int64_t p = 0; p < a * a; ++p) {
+    Eigen::Map<const RowMajorMatrix> v_p(&v[p * kTilesPerBlock * channels],
+                                         num_block_tiles, channels);
+    Eigen::Map<const RowMajorMatrix> u_p(&kernel_[p * channels * filters],
+                                         channels, filters);
+    Eigen::Map<RowMajorMatrix> m_p(&mm[p * kTilesPerBlock * filters],
+                                   num_block_tiles, filters);
+    m_p.noalias() = v_p * u_p;
+  }
+
+  // Output transform: Y = A^T M A.
+  for (int64_t t = 0; t < num_block_tiles; ++t) {
+    auto [b, tx, ty] = tile_coords(tile_begin + t);
+
+    auto m_tile = [&](int64_t i, int64_t j) {
+      return &mm[((i * a + j) * kTilesPerBlock + t) * filters];
+    };
+
+    // tmp = A^T M
+    std::fill(tmp.begin(), tmp.begin() + m * a * filters, 0.0f);
+    for (int64_t i = 0; i < m; ++i) {
+      for (int64_t k = 0; k < a; ++k) {
+        for (int64_t j = 0; j < a; ++j) {
+          Axpy(kAT[i][k], m_tile(k, j), &tmp[(i * a + j) * filters], filters);
+        }
+      }
+    }
+
+    // Y = tmp A
+    for (int64_t i = 0; i < m; ++i) {
+      int64_t ox = tx * m + i;
+      if (ox >= d.output_dims.x) break;
+
+      for (int64_t j = 0; j < m; ++j) {
+        int64_t oy = ty * m + j;
+        if (oy >= d.output_dims.y) break;
+
+        float* out = output +
+                     ((b * d.output_dims.x + ox) * d.output_dims.y + oy) *
+                         filters;
+        std::fill(out, out + filters, 0.0f);
+        for (int64_t k = 0; k < a; ++k) {
+          Axpy(kAT[j][k], &tmp[(i * a + k) * filters], out, filters);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace xla::cpu
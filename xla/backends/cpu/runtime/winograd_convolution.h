@@ -0,0 +1,82 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_WINOGRAD_CONVOLUTION_H_
+#define XLA_BACKENDS_CPU_RUNTIME_WINOGRAD_CONVOLUTION_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "xla/backends/cpu/runtime/convolution_lib.h"
+
+namespace xla::cpu {
+
+// Winograd F(m, 3) implementation of the 2D 3x3 stride-1 convolution for
+// tensors in the canonical layout: NHWC input, HWIO kernel and NHWC output.
+//
+// Output is split into `m x m` tiles, and for each tile we compute
+//
+//   Y = A^T [(G g G^T) * (B^T d B)] A
+//
+// where `d` is the `(m + 2) x (m + 2)` input tile, `g` is the 3x3 kernel, and
+// `*` is an element-wise product, which for multiple channels becomes a matrix
+// multiplication for each of the `(m + 2)^2` transformed tile elements. F(2,3)
+// needs 2.25x and F(4,3) 4x fewer multiplications than direct convolution.
+class WinogradConvolution {
+ public:
+  // Number of output tiles transformed and multiplied together.
+  static constexpr int64_t kTilesPerBlock = 32;
+
+  enum class OutputTile { kF2x3, kF4x3 };
+
+  // Returns true if the convolution can be computed with Winograd algorithm.
+  static bool IsSupported(const ConvolutionCanonicalDims& dims);
+
+  // Returns the output tile size that we use for the given convolution: F(4,3)
+  // has fewer multiplications and F(2,3) is more accurate and has less padding
+  // overhead for small images.
+  static OutputTile SelectOutputTile(const ConvolutionCanonicalDims& dims);
+
+  // Transforms the kernel into the Winograd domain.
+  static WinogradConvolution Create(const ConvolutionCanonicalDims& dims,
+                                    OutputTile output_tile,
+                                    const float* kernel);
+
+  // Number of blocks of output tiles.
+  int64_t num_blocks() const;
+
+  // Computes output tiles in blocks `[block_begin, block_end)`.
+  void Compute(const float* input, float* output, int64_t block_begin,
+               int64_t block_end) const;
+
+ private:
+  WinogradConvolution(const ConvolutionCanonicalDims& dims, int64_t m,
+                      std::vector<float> kernel)
+      : dims_(dims), m_(m), kernel_(std::move(kernel)) {}
+
+  template <int64_t m>
+  void ComputeBlock(const float* input, float* output, int64_t block) const;
+
+  ConvolutionCanonicalDims dims_;
+  int64_t m_;  // output tile size
+
+  // Transformed kernel in `[(m + 2)^2][input_channels][kernel_filters]` order.
+  std::vector<float> kernel_;
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_WINOGRAD_CONVOLUTION_H_
@@ -0,0 +1,177 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/winograd_convolution.h"
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "xla/backends/cpu/runtime/convolution_lib.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/test_benchmark.h"
+
+namespace xla::cpu {
+namespace {
+
+using Dims = ConvolutionCanonicalDims::Dims;
+
+// Returns canonical dims of the 3x3 stride-1 convolution with 'SAME' padding.
+ConvolutionCanonicalDims Conv3x3Dims(int64_t batch, int64_t height,
+                                     int64_t width, int64_t channels,
+                                     int64_t filters) {
+  return ConvolutionCanonicalDims{
+      batch,           Dims({height, width}), channels,
+      Dims({3, 3}),    channels,              filters,
+      Dims({height, width}),
+      /*strides=*/Dims({1, 1}),
+      /*padding_before=*/Dims({1, 1}),
+      /*padding_after=*/Dims({1, 1}),
+      /*base_dilation=*/Dims({1, 1}),
+      /*window_dilation=*/Dims({1, 1}),
+      /*feature_group_count=*/1};
+}
+
+std::vector<float> ReferenceConvolution(const ConvolutionCanonicalDims& d,
+                                        const std::vector<float>& input,
+                                        const std::vector<float>& kernel) {
+  int64_t c_dim = d.input_channels;
+  int64_t f_dim = d.kernel_filters;
+
+  std::vector<float> output(
+      d.input_batch * d.output_dims.x * d.output_dims.y * f_dim, 0.0f);
+
+  for (int64_t b = 0; b < d.input_batch; ++b) {
+    for (int64_t ox = 0; ox < d.output_dims.x; ++ox) {
+      for (int64_t oy = 0; oy < d.output_dims.y; ++oy) {
+        for (int64_t kx = 0; kx < 3; ++kx) {
+          for (int64_t ky = 0; ky < 3; ++ky) {
+            int64_t ix = ox - d.padding_before.x + kx;
+            int64_t iy = oy - d.padding_before.y + ky;
+            if (ix < 0 || ix >= d.input_dims.x) continue;
+            if (iy < 0 || iy >= d.input_dims.y) continue;
+
+            for (int64_t c = 0; c < c_dim; ++c) {
+              float in = input[((b * d.input_dims.x + ix) * d.input_dims.y +
+                                iy) * c_dim + c];
+              for (int64_t f = 0; f < f_dim; ++f) {
+                output[((b * d.output_dims.x + ox) * d.output_dims.y + oy) *
+                           f_dim + f] +=
+                    in * kernel[((kx * 3 + ky) * c_dim + c) * f_dim + f];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return output;
+}
+
+TEST(WinogradConvolutionTest, IsSupported) {
+  EXPECT_TRUE(WinogradConvolution::IsSupported(Conv3x3Dims(1, 8, 8, 16, 16)));
+
+  // Too few channels to amortize the input and output transforms.
+  EXPECT_FALSE(WinogradConvolution::IsSupported(Conv3x3Dims(1, 8, 8, 4, 16)));
+
+  ConvolutionCanonicalDims strided = Conv3x3Dims(1, 8, 8, 16, 16);
+  strided.strides = Dims({2, 2});
+  EXPECT_FALSE(WinogradConvolution::IsSupported(strided));
+
+  ConvolutionCanonicalDims grouped = Conv3x3Dims(1, 8, 8, 16, 16);
+  grouped.feature_group_count = 2;
+  grouped.kernel_channels = 8;
+  EXPECT_FALSE(WinogradConvolution::IsSupported(grouped));
+}
+
+TEST(WinogradConvolutionTest, Compute) {
+  std::minstd_rand0 engine;
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+  for (auto output_tile : {WinogradConvolution::OutputTile::kF2x3,
+                           WinogradConvolution::OutputTile::kF4x3}) {
+    for (int64_t batch : {1, 3}) {
+      for (int64_t size : {2, 7, 12}) {
+        for (int64_t channels : {16, 33}) {
+          ConvolutionCanonicalDims dims =
+              Conv3x3Dims(batch, size, size + 1, channels, channels + 3);
+
+          std::vector<float> input(batch * size * (size + 1) * channels);
+          std::vector<float> kernel(9 * channels * (channels + 3));
+          for (float& v : input) v = distribution(engine);
+          for (float& v : kernel) v = distribution(engine);
+
+          std::vector<float> expected =
+              ReferenceConvolution(dims, input, kernel);
+
+          WinogradConvolution winograd =
+              WinogradConvolution::Create(dims, output_tile, kernel.data());
+          std::vector<float> output(expected.size(), NAN);
+          winograd.Compute(input.data(), output.data(), 0,
+                           winograd.num_blocks());
+
+          for (int64_t i = 0; i < expected.size(); ++i) {
+            ASSERT_NEAR(output[i], expected[i], 1e-3)
+                << "batch=" << batch << " size=" << size
+                << " channels=" << channels << " i=" << i;
+          }
+        }
+      }
+    }
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Performance benchmarks.
+//===----------------------------------------------------------------------===//
+
+static void BM_WinogradConvolution(benchmark::State& state) {
+  auto output_tile = static_cast<WinogradConvolution::OutputTile>(
+      state.range(0));
+  int64_t size = state.range(1);
+  int64_t channels = state.range(2);
+
+  ConvolutionCanonicalDims dims =
+      Conv3x3Dims(1, size, size, channels, channels);
+
+  std::vector<float> input(size * size * channels, 1.0f);
+  std::vector<float> kernel(9 * channels * channels, 1.0f);
+  std::vector<float> output(size * size * channels);
+
+  WinogradConvolution winograd =
+      WinogradConvolution::Create(dims, output_tile, kernel.data());
+
+  for (auto _ : state) {
+    winograd.Compute(input.data(), output.data(), 0, winograd.num_blocks());
+    benchmark::DoNotOptimize(output);
+  }
+
+  state.SetItemsProcessed(state.iterations() * size * size * channels *
+                          channels * 9);
+}
+
+BENCHMARK(BM_WinogradConvolution)
+    ->ArgNames({"tile", "size", "channels"})
+    ->Args({0, 56, 64})
+    ->Args({1, 56, 64})
+    ->Args({0, 28, 128})
+    ->Args({1, 28, 128})
+    ->Args({0, 14, 256})
+    ->Args({1, 14, 256});
+
+}  // namespace
+}  // namespace xla::cpu
@@ -23,6 +23,7 @@ limitations under the License.
 #include <limits>
 #include <new>
 #include <optional>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
@@ -34,6 +35,7 @@ limitations under the License.
 #include "xla/tsl/concurrency/chain.h"
 #include "xla/tsl/lib/math/math_util.h"
 #include "xla/tsl/platform/logging.h"
+#include "tsl/platform/numa.h"
 
 #define EIGEN_USE_THREADS
 #include "unsupported/Eigen/CXX11/Tensor"
@@ -42,9 +44,17 @@ namespace xla::cpu {
 
 // A work queue that partitions `num_tasks` tasks into `num_partitions`
 // partitions processed by parallel workers.
+//
+// If `num_numa_nodes` is larger than one, partitions are split into contiguous
+// groups assigned to NUMA nodes, and workers steal tasks from partitions
+// assigned to the same NUMA node before stealing from other nodes. Because
+// the partition to NUMA node assignment is stable for the same number of
+// tasks, repeated parallel loops over the same buffers touch the same memory
+// from the same NUMA node, which keeps pages placed by the first-touch policy
+// local to the threads accessing them.
 class WorkQueue {
  public:
-  WorkQueue(size_t num_tasks, size_t num_partitions);
+  WorkQueue(size_t num_tasks, size_t num_partitions, size_t num_numa_nodes = 1);
 
   // Returns the next task in the given partition. Returns std::nullopt
   // if the partition is complete.
@@ -54,6 +64,13 @@ class WorkQueue {
   std::pair<size_t, size_t> partition_range(size_t partition_index) const;
 
   size_t num_partitions() const { return partitions_.size(); }
+  size_t num_numa_nodes() const { return num_numa_nodes_; }
+
+  // Returns the NUMA node the partition is assigned to.
+  size_t partition_numa_node(size_t partition_index) const;
+
+  // Returns the [begin, end) range of partitions assigned to the NUMA node.
+  std::pair<size_t, size_t> numa_node_partitions(size_t numa_node) const;
 
  private:
   friend class Worker;
@@ -89,6 +106,8 @@ class WorkQueue {
   size_t DecrementWorkStealingWorkers(size_t max_workers);
 
   absl::FixedArray<Partition, 32> partitions_;
+  size_t num_numa_nodes_;
+
   alignas(kAtomicAlignment) std::atomic<bool> empty_;
   alignas(kAtomicAlignment) std::atomic<size_t> num_work_stealing_workers_;
 };
@@ -97,6 +116,10 @@ class WorkQueue {
 // work partition. Once the assigned partition is complete it tries to pop
 // the task from the next partition. Once the work queue is empty (the worker
 // wraps around to the initial partition) it returns and empty task.
+//
+// For NUMA-aware work queues, worker running on a thread pinned to a NUMA node
+// starts from a partition assigned to that node, and first steals tasks from
+// the partitions of the same node.
 class Worker {
  public:
   Worker(size_t worker_index, WorkQueue* queue);
@@ -109,7 +132,8 @@ class Worker {
   template <typename ParallelTask>
   static void Parallelize(const Eigen::ThreadPoolDevice* device,
                           tsl::CountDownAsyncValueRef<tsl::Chain> count_down,
-                          size_t num_tasks, ParallelTask&& parallel_task);
+                          size_t num_tasks, ParallelTask&& parallel_task,
+                          size_t num_numa_nodes = 1);
 
   // Schedule `num_workers` workers into the Eigen thread pool that process
   // `num_tasks` parallel tasks and return an async value that becomes
@@ -131,9 +155,24 @@ class Worker {
   static void ParallelizeWithContext(ParallelizeContext<ParallelTask>* ctx,
                                      uint16_t start_index, uint16_t end_index);
 
+  // Returns the NUMA node of the current thread, or kNUMANoAffinity if the
+  // thread is not pinned to a NUMA node.
+  static int CurrentThreadNumaNode();
+
+  // Returns the partition index to visit at the given work stealing step.
+  size_t StealPartitionIndex(size_t step) const;
+
   size_t worker_index_;
   size_t partition_index_;
   WorkQueue* queue_;
+
+  // Number of partitions visited in the work stealing mode.
+  size_t steal_step_;
+
+  // The [begin, end) range of partitions on the worker NUMA node, workers
+  // visit these partitions first in the work stealing mode.
+  size_t numa_begin_;
+  size_t numa_end_;
 };
 
 inline void WorkQueue::Partition::Initialize(size_t begin, size_t end) {
@@ -142,8 +181,11 @@ inline void WorkQueue::Partition::Initialize(size_t begin, size_t end) {
   this->end = end;
 }
 
-inline WorkQueue::WorkQueue(size_t num_tasks, size_t num_partitions)
+inline WorkQueue::WorkQueue(size_t num_tasks, size_t num_partitions,
+                            size_t num_numa_nodes)
     : partitions_(num_partitions),
+      num_numa_nodes_(std::max<size_t>(1, std::min(num_numa_nodes,
+                                                    num_partitions))),
       empty_(num_tasks == 0),
       num_work_stealing_workers_(0) {
   size_t partition_size =
@@ -177,6 +219,19 @@ inline std::pair<size_t, size_t> WorkQueue::partition_range(
   return {partitions_[partition_index].begin, partitions_[partition_index].end};
 }
 
+inline size_t WorkQueue::partition_numa_node(size_t partition_index) const {
+  DCHECK(partition_index < partitions_.size()) << "Invalid partition index";
+  // Inverse of the mapping in `numa_node_partitions` below.
+  return ((partition_index + 1) * num_numa_nodes_ - 1) / partitions_.size();
+}
+
+inline std::pair<size_t, size_t> WorkQueue::numa_node_partitions(
+    size_t numa_node) const {
+  DCHECK(numa_node < num_numa_nodes_) << "Invalid NUMA node";
+  return {numa_node * partitions_.size() / num_numa_nodes_,
+          (numa_node + 1) * partitions_.size() / num_numa_nodes_};
+}
+
 inline void WorkQueue::NotifyWorkStealingWorker() {
   num_work_stealing_workers_.fetch_add(1, std::memory_order_relaxed);
 }
@@ -194,10 +249,52 @@ inline size_t WorkQueue::DecrementWorkStealingWorkers(size_t max_workers) {
   return decrement;
 }
 
+inline int Worker::CurrentThreadNumaNode() {
+  // Thread affinity is set once when the thread pool is created, so we query
+  // it only once per thread as it's an expensive call.
+  static thread_local int numa_node = tsl::port::NUMAGetThreadNodeAffinity();
+  return numa_node;
+}
+
 inline Worker::Worker(size_t worker_index, WorkQueue* queue)
     : worker_index_(worker_index),
       partition_index_(worker_index),
-      queue_(queue) {}
+      queue_(queue),
+      steal_step_(0),
+      numa_begin_(0),
+      numa_end_(queue->num_partitions()) {
+  if (ABSL_PREDICT_TRUE(queue->num_numa_nodes() == 1)) return;
+
+  size_t numa_node = queue->partition_numa_node(worker_index);
+
+  // If the current thread is pinned to a different NUMA node, remap the worker
+  // to one of the partitions assigned to that node.
+  if (int node = CurrentThreadNumaNode(); node != tsl::port::kNUMANoAffinity) {
+    size_t thread_numa_node = static_cast<size_t>(node);
+    auto [begin, end] = thread_numa_node < queue->num_numa_nodes()
+                            ? queue->numa_node_partitions(thread_numa_node)
+                            : std::make_pair(size_t{0}, size_t{0});
+    if (thread_numa_node != numa_node && begin < end) {
+      numa_node = thread_numa_node;
+      worker_index_ = partition_index_ = begin + worker_index % (end - begin);
+    }
+  }
+
+  std::tie(numa_begin_, numa_end_) = queue->numa_node_partitions(numa_node);
+}
+
+inline size_t Worker::StealPartitionIndex(size_t step) const {
+  // Visit all partitions on the worker NUMA node starting from the assigned
+  // one, and then all the remaining partitions starting from the next node.
+  size_t numa_size = numa_end_ - numa_begin_;
+  if (ABSL_PREDICT_TRUE(step < numa_size)) {
+    return numa_begin_ + (worker_index_ - numa_begin_ + step) % numa_size;
+  }
+
+  size_t index = numa_end_ + (step - numa_size);
+  return index >= queue_->num_partitions() ? index - queue_->num_partitions()
+                                           : index;
+}
 
 inline std::optional<size_t> Worker::Pop() {
   std::optional<size_t> task = queue_->Pop(partition_index_);
@@ -205,22 +302,18 @@ inline std::optional<size_t> Worker::Pop() {
 
   // If we didn't find a task in the initially assigned partition, notify the
   // work queue that we are switching to work stealing mode.
-  if (ABSL_PREDICT_FALSE(partition_index_ == worker_index_)) {
+  if (ABSL_PREDICT_FALSE(steal_step_ == 0)) {
     queue_->NotifyWorkStealingWorker();
   }
 
   while (!task.has_value() && !queue_->IsEmpty()) {
-    // Wrap around to the first partition.
-    if (ABSL_PREDICT_FALSE(++partition_index_ >= queue_->num_partitions())) {
-      partition_index_ = 0;
-    }
-
     // We checked all partitions and got back to the partition we started from.
-    if (ABSL_PREDICT_FALSE(partition_index_ == worker_index_)) {
+    if (ABSL_PREDICT_FALSE(++steal_step_ >= queue_->num_partitions())) {
       queue_->SetEmpty();
       break;
     }
 
+    partition_index_ = StealPartitionIndex(steal_step_);
     task = queue_->Pop(partition_index_);
   }
 
@@ -231,7 +324,8 @@ template <typename ParallelTask>
 struct Worker::ParallelizeContext {
   ParallelizeContext(const Eigen::ThreadPoolDevice* device,
                      tsl::CountDownAsyncValueRef<tsl::Chain> count_down,
-                     size_t num_tasks, ParallelTask&& parallel_task);
+                     size_t num_tasks, ParallelTask&& parallel_task,
+                     size_t num_numa_nodes);
 
   const Eigen::ThreadPoolDevice* device;
   tsl::CountDownAsyncValueRef<tsl::Chain> count_down;
@@ -244,10 +338,11 @@ template <typename ParallelTask>
 Worker::ParallelizeContext<ParallelTask>::ParallelizeContext(
     const Eigen::ThreadPoolDevice* device,
     tsl::CountDownAsyncValueRef<tsl::Chain> count_down, size_t num_tasks,
-    ParallelTask&& parallel_task)
+    ParallelTask&& parallel_task, size_t num_numa_nodes)
     : device(device),
       count_down(std::move(count_down)),
-      work_queue(num_tasks, /*num_partitions=*/this->count_down.count()),
+      work_queue(num_tasks, /*num_partitions=*/this->count_down.count(),
+                 num_numa_nodes),
       parallel_task(std::forward<ParallelTask>(parallel_task)) {}
 
 template <typename ParallelTask>
@@ -340,7 +435,7 @@ template <typename ParallelTask>
 ABSL_ATTRIBUTE_ALWAYS_INLINE void Worker::Parallelize(
     const Eigen::ThreadPoolDevice* device,
     tsl::CountDownAsyncValueRef<tsl::Chain> count_down, size_t num_tasks,
-    ParallelTask&& parallel_task) {
+    ParallelTask&& parallel_task, size_t num_numa_nodes) {
   size_t num_workers = count_down.count();
   DCHECK_LE(num_workers, num_tasks);
 
@@ -358,7 +453,7 @@ ABSL_ATTRIBUTE_ALWAYS_INLINE void Worker::Parallelize(
 
   auto ctx = std::make_unique<ParallelizeContext<ParallelTask>>(
       device, std::move(count_down), num_tasks,
-      std::forward<ParallelTask>(parallel_task));
+      std::forward<ParallelTask>(parallel_task), num_numa_nodes);
 
   ParallelizeWithContext(ctx.release(), 0, num_workers);
 }
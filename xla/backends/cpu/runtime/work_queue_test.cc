@@ -146,6 +146,69 @@ TEST(WorkQueueTest, Worker) {
   }
 }
 
+TEST(WorkQueueTest, WorkQueueNumaNodes) {
+  auto range = [](size_t begin, size_t end) {
+    return std::make_pair(begin, end);
+  };
+
+  WorkQueue queue(/*num_tasks=*/100, /*num_partitions=*/5,
+                  /*num_numa_nodes=*/2);
+  ASSERT_EQ(queue.num_numa_nodes(), 2);
+  EXPECT_EQ(queue.numa_node_partitions(0), range(0, 2));
+  EXPECT_EQ(queue.numa_node_partitions(1), range(2, 5));
+
+  for (size_t num_partitions : {1, 2, 3, 4, 5, 6, 7, 8}) {
+    for (size_t num_numa_nodes : {1, 2, 3, 4}) {
+      WorkQueue queue(/*num_tasks=*/64, num_partitions, num_numa_nodes);
+      for (size_t i = 0; i < queue.num_partitions(); ++i) {
+        auto [begin, end] =
+            queue.numa_node_partitions(queue.partition_numa_node(i));
+        EXPECT_LE(begin, i);
+        EXPECT_LT(i, end);
+      }
+    }
+  }
+}
+
+TEST(WorkQueueTest, NumaWorker) {
+  // Two NUMA nodes with partitions [0, 3) and [3, 6).
+  WorkQueue queue(/*num_tasks=*/6, /*num_partitions=*/6,
+                  /*num_numa_nodes=*/2);
+  Worker worker(1, &queue);
+
+  std::vector<size_t> tasks;
+  while (std::optional<size_t> task = worker.Pop()) {
+    tasks.push_back(*task);
+  }
+
+  // Worker first steals tasks from its own NUMA node partitions.
+  EXPECT_THAT(tasks, testing::ElementsAre(1, 2, 0, 3, 4, 5));
+}
+
+TEST(WorkQueueTest, NumaWorkerAllPartitions) {
+  for (size_t size : {1, 2, 4, 8, 16, 32, 64}) {
+    for (size_t num_partitions : {1, 2, 3, 4, 5, 6, 7, 8}) {
+      for (size_t num_numa_nodes : {2, 3}) {
+        for (size_t i = 0; i < num_partitions; ++i) {
+          WorkQueue queue(size, num_partitions, num_numa_nodes);
+          Worker worker(i, &queue);
+
+          std::vector<size_t> expected_tasks(size);
+          absl::c_iota(expected_tasks, 0);
+
+          std::vector<size_t> tasks;
+          while (std::optional<size_t> task = worker.Pop()) {
+            tasks.push_back(*task);
+          }
+
+          absl::c_sort(tasks);
+          EXPECT_EQ(tasks, expected_tasks);
+        }
+      }
+    }
+  }
+}
+
 TEST(WorkQueueTest, WorkerConcurrency) {
   tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", 8);
 
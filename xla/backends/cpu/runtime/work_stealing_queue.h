@@ -0,0 +1,171 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_CPU_RUNTIME_WORK_STEALING_QUEUE_H_
+#define XLA_BACKENDS_CPU_RUNTIME_WORK_STEALING_QUEUE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+#include "absl/base/optimization.h"
+#include "absl/numeric/bits.h"
+
+namespace xla::cpu {
+
+// A bounded single-producer multi-consumer work stealing deque (Chase-Lev).
+//
+// The owner thread pushes and pops values at the bottom of the deque, and
+// all other threads (thieves) steal values from the top. The owner and
+// thieves synchronize only when the deque has a single value left, which
+// makes push and pop operations on the owner side nearly free.
+//
+// See: "Correct and Efficient Work-Stealing for Weak Memory Models",
+//      https://fzn.fr/readings/ppopp13.pdf
+//
+// Unlike the classic algorithm, the deque has a fixed capacity and `Push`
+// returns false if the deque is full, it's up to the caller to decide what to
+// do with the value that didn't fit (i.e. process it in the caller thread).
+template <typename T>
+class WorkStealingQueue {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "WorkStealingQueue value must be trivially copyable");
+
+ public:
+  explicit WorkStealingQueue(size_t capacity);
+
+  WorkStealingQueue(const WorkStealingQueue&) = delete;
+  WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+  // Pushes `value` to the bottom of the deque. Returns false if the deque is
+  // full. Must be called only by the owner thread.
+  bool Push(T value);
+
+  // Pops a value from the bottom of the deque. Returns std::nullopt if the
+  // deque is empty. Must be called only by the owner thread.
+  std::optional<T> Pop();
+
+  // Steals a value from the top of the deque. Returns std::nullopt if the
+  // deque is empty or if it lost a race with a concurrent steal or pop. Can be
+  // called from any thread.
+  std::optional<T> Steal();
+
+  // Returns an approximate number of values in the deque.
+  size_t Size() const;
+  bool Empty() const { return Size() == 0; }
+
+  size_t capacity() const { return mask_ + 1; }
+
+ private:
+  // Align atomic counters to a cache line boundary to avoid false sharing
+  // between the owner thread and thieves.
+  static constexpr size_t kAtomicAlignment =
+#if defined(__cpp_lib_hardware_interference_size)
+      std::hardware_destructive_interference_size;
+#else
+      64;
+#endif
+
+  alignas(kAtomicAlignment) std::atomic<int64_t> top_;
+  alignas(kAtomicAlignment) std::atomic<int64_t> bottom_;
+
+  int64_t mask_;
+  std::unique_ptr<std::atomic<T>[]> buffer_;
+};
+
+template <typename T>
+WorkStealingQueue<T>::WorkStealingQueue(size_t capacity)
+    : top_(0),
+      bottom_(0),
+      mask_(absl::bit_ceil(std::max<size_t>(capacity, 1)) - 1),
+      buffer_(new std::atomic<T>[mask_ + 1]) {}
+
+template <typename T>
+bool WorkStealingQueue<T>::Push(T value) {
+  int64_t b = bottom_.load(std::memory_order_relaxed);
+  int64_t t = top_.load(std::memory_order_acquire);
+
+  if (ABSL_PREDICT_FALSE(b - t > mask_)) {
+    return false;
+  }
+
+  buffer_[b & mask_].store(value, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom_.store(b + 1, std::memory_order_relaxed);
+  return true;
+}
+
+template <typename T>
+std::optional<T> WorkStealingQueue<T>::Pop() {
+  int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+  bottom_.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t t = top_.load(std::memory_order_relaxed);
+
+  // Deque is empty, restore the bottom index.
+  if (ABSL_PREDICT_FALSE(t > b)) {
+    bottom_.store(b + 1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+
+  T value = buffer_[b & mask_].load(std::memory_order_relaxed);
+
+  // More than one value left in the deque, no need to synchronize with
+  // thieves as they can't reach the bottom value.
+  if (ABSL_PREDICT_TRUE(t < b)) {
+    return value;
+  }
+
+  // Single value left in the deque, race with thieves for it.
+  bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed);
+  bottom_.store(b + 1, std::memory_order_relaxed);
+  return won ? std::make_optional(value) : std::nullopt;
+}
+
+template <typename T>
+std::optional<T> WorkStealingQueue<T>::Steal() {
+  int64_t t = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t b = bottom_.load(std::memory_order_acquire);
+
+  if (t >= b) {
+    return std::nullopt;
+  }
+
+  T value = buffer_[t & mask_].load(std::memory_order_relaxed);
+  if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return std::nullopt;
+  }
+
+  return value;
+}
+
+template <typename T>
+size_t WorkStealingQueue<T>::Size() const {
+  int64_t b = bottom_.load(std::memory_order_relaxed);
+  int64_t t = top_.load(std::memory_order_relaxed);
+  return b > t ? static_cast<size_t>(b - t) : 0;
+}
+
+}  // namespace xla::cpu
+
+#endif  // XLA_BACKENDS_CPU_RUNTIME_WORK_STEALING_QUEUE_H_
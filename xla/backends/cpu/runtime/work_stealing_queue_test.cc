@@ -0,0 +1,152 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/cpu/runtime/work_stealing_queue.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "absl/synchronization/blocking_counter.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/test_benchmark.h"
+#include "xla/tsl/platform/threadpool.h"
+
+namespace xla::cpu {
+namespace {
+
+TEST(WorkStealingQueueTest, PushPop) {
+  WorkStealingQueue<int32_t> queue(/*capacity=*/3);
+  EXPECT_EQ(queue.capacity(), 4);
+  EXPECT_TRUE(queue.Empty());
+
+  EXPECT_TRUE(queue.Push(1));
+  EXPECT_TRUE(queue.Push(2));
+  EXPECT_TRUE(queue.Push(3));
+  EXPECT_TRUE(queue.Push(4));
+  EXPECT_FALSE(queue.Push(5));
+  EXPECT_EQ(queue.Size(), 4);
+
+  // Owner pops values in LIFO order.
+  EXPECT_EQ(queue.Pop(), 4);
+  EXPECT_EQ(queue.Pop(), 3);
+
+  // Thieves steal values in FIFO order.
+  EXPECT_EQ(queue.Steal(), 1);
+  EXPECT_EQ(queue.Steal(), 2);
+
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.Pop(), std::nullopt);
+  EXPECT_EQ(queue.Steal(), std::nullopt);
+}
+
+TEST(WorkStealingQueueTest, WrapAround) {
+  WorkStealingQueue<int32_t> queue(/*capacity=*/2);
+
+  for (int32_t i = 0; i < 100; ++i) {
+    ASSERT_TRUE(queue.Push(i));
+    ASSERT_TRUE(queue.Push(i + 1));
+    EXPECT_EQ(queue.Steal(), i);
+    EXPECT_EQ(queue.Pop(), i + 1);
+  }
+
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(WorkStealingQueueTest, ConcurrentSteal) {
+  static constexpr int32_t kNumValues = 100000;
+  static constexpr size_t kNumThieves = 4;
+
+  tsl::thread::ThreadPool threads(tsl::Env::Default(), "test", kNumThieves);
+
+  WorkStealingQueue<int32_t> queue(/*capacity=*/128);
+  std::vector<std::atomic<int32_t>> popped(kNumValues);
+
+  std::atomic<bool> done = false;
+  absl::BlockingCounter counter(kNumThieves);
+
+  for (size_t t = 0; t < kNumThieves; ++t) {
+    threads.Schedule([&] {
+      while (!done.load(std::memory_order_acquire) || !queue.Empty()) {
+        if (std::optional<int32_t> value = queue.Steal()) {
+          popped[*value].fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      counter.DecrementCount();
+    });
+  }
+
+  // Owner pushes all values and pops some of them back.
+  for (int32_t i = 0; i < kNumValues;) {
+    if (queue.Push(i)) {
+      ++i;
+    } else if (std::optional<int32_t> value = queue.Pop()) {
+      popped[*value].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  while (std::optional<int32_t> value = queue.Pop()) {
+    popped[*value].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  done.store(true, std::memory_order_release);
+  counter.Wait();
+
+  // Every value must be popped or stolen exactly once.
+  for (int32_t i = 0; i < kNumValues; ++i) {
+    ASSERT_EQ(popped[i].load(), 1) << "value=" << i;
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Performance benchmarks.
+//===----------------------------------------------------------------------===//
+
+static void BM_PushPop(benchmark::State& state) {
+  WorkStealingQueue<int32_t> queue(/*capacity=*/1024);
+  const size_t num_push_pop = state.range(0);
+
+  for (auto _ : state) {
+    for (int32_t i = 0; i < num_push_pop; ++i) {
+      queue.Push(i);
+    }
+    for (int32_t i = 0; i < num_push_pop; ++i) {
+      benchmark::DoNotOptimize(queue.Pop());
+    }
+  }
+}
+
+static void BM_PushSteal(benchmark::State& state) {
+  WorkStealingQueue<int32_t> queue(/*capacity=*/1024);
+  const size_t num_push_pop = state.range(0);
+
+  for (auto _ : state) {
+    for (int32_t i = 0; i < num_push_pop; ++i) {
+      queue.Push(i);
+    }
+    for (int32_t i = 0; i < num_push_pop; ++i) {
+      benchmark::DoNotOptimize(queue.Steal());
+    }
+  }
+}
+
+BENCHMARK(BM_PushPop)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(BM_PushSteal)->Arg(1)->Arg(8)->Arg(64);
+
+}  // namespace
+}  // namespace xla::cpu
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/backends/cpu/runtime/xnnpack/xnn_fusion_thunk.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -35,6 +36,7 @@ limitations under the License.
 #include "pthreadpool.h"
 #include "xla/backends/cpu/runtime/parallel_loop_runner.h"
 #include "xla/backends/cpu/runtime/thunk.h"
+#include "xla/backends/cpu/runtime/tile_size_tuner.h"
 #include "xla/backends/cpu/runtime/xnnpack/xnn_interop.h"
 #include "xla/backends/cpu/runtime/xnnpack/xnn_threadpool.h"
 #include "xla/runtime/buffer_use.h"
@@ -43,6 +45,7 @@ limitations under the License.
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/logging.h"
 #include "xla/tsl/platform/statusor.h"
+#include "tsl/platform/numa.h"
 
 namespace xla::cpu {
 
@@ -200,7 +203,14 @@ absl::StatusOr<XnnFusionThunk::XnnRuntime> XnnFusionThunk::CreateXnnRuntime(
 
   // Configure XNNPACK runtime thread pool if parallelization is enabled.
   if (parallelization_mode == ParallelizationMode::kParallelLoopRunner) {
-    runtime.runner = std::make_unique<ParallelLoopRunner>(device);
+    size_t num_numa_nodes = options_.use_numa_aware_partitioning
+                                ? std::max(tsl::port::NUMANumNodes(), 1)
+                                : 1;
+    runtime.runner =
+        std::make_unique<ParallelLoopRunner>(device, num_numa_nodes);
+    if (options_.use_adaptive_tile_size) {
+      runtime.runner->set_tile_size_tuner(TileSizeTuner::Default());
+    }
     runtime.threadpool = CreateCustomPthreadpool(runtime.runner.get());
   } else if (parallelization_mode == ParallelizationMode::kPThreadPool) {
     runtime.threadpool = DefaultPthreadpool();
@@ -61,6 +61,11 @@ class XnnFusionThunk : public Thunk {
 
   struct Options {
     bool use_threadpool = true;
+    // If true, parallel loops are partitioned across NUMA nodes, and workers
+    // steal tasks within their own NUMA node first.
+    bool use_numa_aware_partitioning = false;
+    // If true, tile sizes of dynamic parallel loops are tuned at run time.
+    bool use_adaptive_tile_size = false;
   };
 
   struct Argument {
@@ -205,7 +205,8 @@ static void Parallelize1DTile1DDynamic(  // NOLINT
       [function, context](size_t offset, size_t count) {
         (*function)(context, offset, count);
       };
-  Cast(threadpool)->runner()->ParallelizeDynamic(range, tile, std::move(task));
+  Cast(threadpool)->runner()->ParallelizeDynamic(
+      range, tile, std::move(task), reinterpret_cast<const void*>(function));
 }
 
 static void Parallelize2DTile1D(pthreadpool_t threadpool,  // NOLINT
@@ -247,7 +248,8 @@ static void Parallelize2DTile1DDynamic(  // NOLINT
       };
   Cast(threadpool)
       ->runner()
-      ->ParallelizeDynamic(range_i, range_j, tile_j, std::move(task));
+      ->ParallelizeDynamic(range_i, range_j, tile_j, std::move(task),
+                           reinterpret_cast<const void*>(function));
 }
 
 static void Parallelize3DTile2D(pthreadpool_t threadpool,  // NOLINT
@@ -296,7 +298,8 @@ static void Parallelize3DTile2DDynamic(  // NOLINT
   Cast(threadpool)
       ->runner()
       ->ParallelizeDynamic(range_i, range_j, range_k, tile_j, tile_k,
-                           std::move(task));
+                           std::move(task),
+                           reinterpret_cast<const void*>(function));
 }
 
 }  // namespace xla::cpu
@@ -18,7 +18,9 @@ limitations under the License.
 #include <cstdint>
 #include <string>
 
+#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
+#include "absl/status/statusor.h"
 #include "xla/backends/cpu/xnn_fusion.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -26,15 +28,41 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/service/cpu/backend_config.pb.h"
 #include "xla/service/instruction_fusion.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
 #include "xla/tsl/platform/status.h"
+#include "xla/xla_data.pb.h"
 
 namespace xla {
 namespace cpu {
 
+// Maximum depth of the elementwise epilogue we look through to find a dot.
+static constexpr int64_t kMaxEpilogueDepth = 16;
+
+static bool IsXnnElementType(const Shape& shape) {
+  return shape.IsArray() &&
+         (shape.element_type() == F32 || shape.element_type() == F16);
+}
+
+// Returns true if `broadcasted` value can be implicitly broadcasted by the
+// binary `user`: the other operand must have the shape of the result.
+static bool IsFoldableBroadcastUser(const HloInstruction* broadcasted,
+                                    const HloInstruction* user) {
+  if (!IsXnnBinaryOpSupported(user)) {
+    return false;
+  }
+  const HloInstruction* other = user->operand(0) == broadcasted
+                                    ? user->operand(1)
+                                    : user->operand(0);
+  return other != broadcasted && other->opcode() != HloOpcode::kBroadcast &&
+         ShapeUtil::SameDimensions(other->shape(), user->shape());
+}
+
 FusionDecision XnnGraphFusion::ShouldFuse(HloInstruction* consumer,
                                           int64_t operand_index) {
   if (!IsXnnGraphFusion(consumer)) {
-    if (!(consumer->IsRoot() && IsOpSupported(consumer)))
+    if (!((consumer->IsRoot() || IsDotEpilogue(consumer, kMaxEpilogueDepth)) &&
+          IsOpSupported(consumer)))
       return FusionDecision::Forbid("Unsupported consumer");
   }
 
@@ -43,6 +71,21 @@ FusionDecision XnnGraphFusion::ShouldFuse(HloInstruction* consumer,
         producer->opcode() == HloOpcode::kConstant || IsOpSupported(producer)))
     return FusionDecision::Forbid("Unsupported producer");
 
+  if (!IsXnnElementType(producer->shape()))
+    return FusionDecision::Forbid("Unsupported producer element type");
+
+  // Broadcasts are folded into the consuming binary ops, and can't be fused
+  // into any other kind of consumer.
+  if (producer->opcode() == HloOpcode::kBroadcast) {
+    const HloInstruction* broadcasted =
+        IsXnnGraphFusion(consumer) ? consumer->fused_parameter(operand_index)
+                                   : producer;
+    if (!absl::c_all_of(broadcasted->users(), [&](const HloInstruction* user) {
+          return IsFoldableBroadcastUser(broadcasted, user);
+        }))
+      return FusionDecision::Forbid("Unsupported broadcast consumer");
+  }
+
   return FusionDecision::Allow();
 }
 
@@ -66,15 +109,45 @@ HloInstruction* XnnGraphFusion::Fuse(HloInstruction* producer,
 }
 
 bool XnnGraphFusion::IsOpSupported(HloInstruction* instr) const {
-  switch (instr->opcode()) {
-    case HloOpcode::kAdd:
-    case HloOpcode::kSubtract:
-    case HloOpcode::kMultiply:
-      return true;
-    default:
-      return false;
+  if (!IsXnnElementType(instr->shape())) {
+    return false;
   }
+
+  if (instr->opcode() == HloOpcode::kDot) {
+    absl::StatusOr<bool> is_supported = IsXnnDotSupported(
+        instr->dot_dimension_numbers(), instr->operand(0)->shape(),
+        instr->operand(1)->shape(), instr->shape());
+    return is_supported.ok() && *is_supported;
+  }
+
+  if (instr->opcode() == HloOpcode::kBroadcast) {
+    // Broadcast users are checked when we decide to fuse it into a consumer.
+    return IsXnnBroadcastSupported(instr) && !instr->IsRoot();
+  }
+
+  return IsXnnUnaryOpSupported(instr) || IsXnnBinaryOpSupported(instr);
 }
+
+bool XnnGraphFusion::IsDotEpilogue(const HloInstruction* instr,
+                                   int64_t depth) const {
+  if (depth == 0) {
+    return false;
+  }
+  if (!IsXnnUnaryOpSupported(instr) && !IsXnnBinaryOpSupported(instr)) {
+    return false;
+  }
+  return absl::c_any_of(instr->operands(), [&](const HloInstruction* operand) {
+    if (operand->opcode() == HloOpcode::kDot) return true;
+    if (IsXnnGraphFusion(operand)) {
+      return absl::c_any_of(
+          operand->fused_instructions(), [](const HloInstruction* fused) {
+            return fused->opcode() == HloOpcode::kDot;
+          });
+    }
+    return IsDotEpilogue(operand, depth - 1);
+  });
+}
+
 bool XnnGraphFusion::IsXnnGraphFusion(const HloInstruction* instr) const {
   if (instr->opcode() != HloOpcode::kFusion) {
     return false;
@@ -41,6 +41,12 @@ class XnnGraphFusion : public InstructionFusion {
 
   bool IsOpSupported(HloInstruction* instr) const;
 
+  // Returns true if `instr` is a part of an elementwise epilogue (bias add,
+  // activation function, etc.) of a dot operation, looking through at most
+  // `depth` elementwise operations. Epilogues are fused together with the dot
+  // into a single XNNPACK subgraph even if they are not the root instruction.
+  bool IsDotEpilogue(const HloInstruction* instr, int64_t depth) const;
+
   bool IsXnnGraphFusion(const HloInstruction* instr) const;
 };
 
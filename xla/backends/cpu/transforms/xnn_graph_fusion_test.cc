@@ -67,5 +67,68 @@ ENTRY entry {
   EXPECT_EQ(backend_config.fusion_config().kind(), kXnnFusionKind);
 }
 
+TEST_F(XnnGraphFusionTest, DotBiasReluEpilogue) {
+  std::string hlo_string = R"(
+HloModule DotBiasRelu
+
+ENTRY entry {
+   %x = f32[64,64] parameter(0)
+   %w = f32[64,64] parameter(1)
+   %bias = f32[64] parameter(2)
+   %dot = f32[64,64] dot(%x, %w),
+     lhs_contracting_dims={1}, rhs_contracting_dims={0}
+   %bias_broadcast = f32[64,64] broadcast(%bias), dimensions={1}
+   %add = f32[64,64] add(%dot, %bias_broadcast)
+   %zero = f32[] constant(0)
+   %zero_broadcast = f32[64,64] broadcast(%zero), dimensions={}
+   %relu = f32[64,64] maximum(%add, %zero_broadcast)
+   ROOT %result = (f32[64,64]) tuple(%relu)
+}
+
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, XnnGraphFusion().Run(module.get()));
+  ASSERT_TRUE(changed);
+
+  // Dot together with the bias and activation epilogue must be fused into a
+  // single XNN fusion, even though the epilogue is not a root instruction.
+  HloInstruction* root = module->entry_computation()->root_instruction();
+  ASSERT_THAT(root, op::Tuple(op::Fusion(op::Parameter(0), op::Parameter(1),
+                                         op::Parameter(2))));
+  HloInstruction* fusion = root->mutable_operand(0);
+  EXPECT_THAT(fusion->fused_expression_root(),
+              op::Maximum(op::Add(op::Dot(), op::Broadcast(op::Parameter())),
+                          op::Broadcast(op::Constant())));
+}
+
+TEST_F(XnnGraphFusionTest, DoNotFuseUnsupportedBroadcast) {
+  std::string hlo_string = R"(
+HloModule UnsupportedBroadcast
+
+ENTRY entry {
+   %x = f32[64,32] parameter(0)
+   %y = f32[64] parameter(1)
+   %broadcast = f32[64,32] broadcast(%y), dimensions={0}
+   ROOT %add = f32[64,32] add(%x, %broadcast)
+}
+
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  ASSERT_TRUE(XnnGraphFusion().Run(module.get()).ok());
+
+  // Broadcast into the leading dimension can't be implicitly broadcasted by
+  // XNNPACK and must stay outside of fusions.
+  for (HloInstruction* instr : module->entry_computation()->instructions()) {
+    if (instr->opcode() != HloOpcode::kFusion) continue;
+    for (HloInstruction* fused : instr->fused_instructions()) {
+      EXPECT_NE(fused->opcode(), HloOpcode::kBroadcast);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace xla::cpu
@@ -21,6 +21,7 @@ limitations under the License.
 #include <vector>
 
 #include "xnnpack.h"
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/functional/any_invocable.h"
 #include "absl/status/statusor.h"
@@ -67,12 +68,45 @@ static absl::StatusOr<xnn_binary_operator> XnnBinaryOperator(
       return xnn_binary_multiply;
     case HloOpcode::kSubtract:
       return xnn_binary_subtract;
+    case HloOpcode::kDivide:
+      return xnn_binary_divide;
+    case HloOpcode::kMaximum:
+      return xnn_binary_maximum;
+    case HloOpcode::kMinimum:
+      return xnn_binary_minimum;
     default:
       return InvalidArgument("Unsupported XNNPACK binary operator: %s",
                              HloOpcodeString(opcode));
   }
 }
 
+static absl::StatusOr<xnn_unary_operator> XnnUnaryOperator(
+    const HloOpcode& opcode) {
+  switch (opcode) {
+    case HloOpcode::kAbs:
+      return xnn_unary_abs;
+    case HloOpcode::kConvert:
+      return xnn_unary_convert;
+    case HloOpcode::kExp:
+      return xnn_unary_exp;
+    case HloOpcode::kLog:
+      return xnn_unary_log;
+    case HloOpcode::kLogistic:
+      return xnn_unary_sigmoid;
+    case HloOpcode::kNegate:
+      return xnn_unary_negate;
+    case HloOpcode::kRsqrt:
+      return xnn_unary_reciprocal_square_root;
+    case HloOpcode::kSqrt:
+      return xnn_unary_square_root;
+    case HloOpcode::kTanh:
+      return xnn_unary_tanh;
+    default:
+      return InvalidArgument("Unsupported XNNPACK unary operator: %s",
+                             HloOpcodeString(opcode));
+  }
+}
+
 static std::vector<size_t> XnnDimensions(const Shape& shape) {
   std::vector<size_t> dims;
   for (auto& dim : shape.dimensions()) {
@@ -139,6 +173,71 @@ static absl::StatusOr<uint32_t> DefineParameter(xnn_subgraph_t subgraph,
   return tensor_id;
 }
 
+static absl::StatusOr<uint32_t> DefineConstant(xnn_subgraph_t subgraph,
+                                               const HloInstruction* constant) {
+  VLOG(3) << absl::StreamFormat("Define tensor value for constant: %s",
+                                constant->ToString());
+
+  // Root constants must be copied to the result buffer, which is not supported
+  // by the subgraph emitter.
+  if (constant->parent()->root_instruction() == constant) {
+    return InvalidArgument("Unsupported XNNPACK root constant: %s",
+                           constant->ToString());
+  }
+
+  auto dims = XnnDimensions(constant->shape());
+  TF_ASSIGN_OR_RETURN(auto type, XnnDatatype(constant->shape().element_type()));
+
+  // Constant literal is owned by the HLO instruction, which outlives the
+  // subgraph, and XNNPACK defines a static tensor pointing to it.
+  uint32_t tensor_id = XNN_INVALID_VALUE_ID;
+  XNN_RETURN_IF_ERROR(xnn_define_tensor_value(
+      subgraph, type, dims.size(), dims.data(),
+      constant->literal().untyped_data(),
+      /*external_id=*/XNN_INVALID_VALUE_ID, /*flags=*/0, &tensor_id));
+
+  return tensor_id;
+}
+
+static absl::StatusOr<uint32_t> DefineBroadcast(TensorIdMap& tensor_ids,
+                                                const HloInstruction* instr) {
+  VLOG(3) << absl::StreamFormat("Define tensor value for broadcast: %s",
+                                instr->ToString());
+
+  // Broadcasts are folded into the elementwise binary ops that consume them,
+  // and we reuse the operand tensor relying on implicit broadcasting.
+  bool folds_into_users = absl::c_all_of(
+      instr->users(),
+      [](const HloInstruction* user) { return IsXnnBinaryOpSupported(user); });
+
+  if (!IsXnnBroadcastSupported(instr) || !folds_into_users ||
+      instr->parent()->root_instruction() == instr) {
+    return InvalidArgument("Unsupported XNNPACK broadcast: %s",
+                           instr->ToString());
+  }
+
+  return FindTensorValue(tensor_ids, instr->operand(0));
+}
+
+static absl::StatusOr<uint32_t> DefineUnaryOp(xnn_subgraph_t subgraph,
+                                              TensorIdMap& tensor_ids,
+                                              const HloInstruction* instr) {
+  VLOG(3) << absl::StreamFormat("Define tensor value for unary op: %s",
+                                instr->ToString());
+
+  TF_ASSIGN_OR_RETURN(auto unary_op, XnnUnaryOperator(instr->opcode()));
+
+  TF_ASSIGN_OR_RETURN(auto in, FindTensorValue(tensor_ids, instr->operand(0)));
+  TF_ASSIGN_OR_RETURN(auto out, DefineTensorValue(subgraph, instr));
+
+  VLOG(3) << absl::StreamFormat("  tensors: in=%d, out=%d", in, out);
+
+  XNN_RETURN_IF_ERROR(xnn_define_unary(subgraph, unary_op, /*params=*/nullptr,
+                                       in, out, /*flags=*/0));
+
+  return out;
+}
+
 static absl::StatusOr<uint32_t> DefineBinaryOp(xnn_subgraph_t subgraph,
                                                TensorIdMap& tensor_ids,
                                                const HloInstruction* instr) {
@@ -147,6 +246,15 @@ static absl::StatusOr<uint32_t> DefineBinaryOp(xnn_subgraph_t subgraph,
 
   TF_ASSIGN_OR_RETURN(auto binary_op, XnnBinaryOperator(instr->opcode()));
 
+  // With implicit broadcasting the result shape is inferred from operands, so
+  // at least one of them must have the shape of the result.
+  if (instr->operand(0)->opcode() == HloOpcode::kBroadcast &&
+      instr->operand(1)->opcode() == HloOpcode::kBroadcast) {
+    return InvalidArgument(
+        "Unsupported XNNPACK binary op with broadcasted operands: %s",
+        instr->ToString());
+  }
+
   TF_ASSIGN_OR_RETURN(auto lhs, FindTensorValue(tensor_ids, instr->operand(0)));
   TF_ASSIGN_OR_RETURN(auto rhs, FindTensorValue(tensor_ids, instr->operand(1)));
   TF_ASSIGN_OR_RETURN(auto out, DefineTensorValue(subgraph, instr));
@@ -225,7 +333,32 @@ static absl::StatusOr<xnn_subgraph_t> EmitXnnSubgraph(
                             DefineParameter(subgraph, instr));
       } break;
 
+      case HloOpcode::kConstant: {
+        TF_ASSIGN_OR_RETURN(tensor_ids[instr], DefineConstant(subgraph, instr));
+      } break;
+
+      case HloOpcode::kBroadcast: {
+        TF_ASSIGN_OR_RETURN(tensor_ids[instr],
+                            DefineBroadcast(tensor_ids, instr));
+      } break;
+
+      case HloOpcode::kAbs:
+      case HloOpcode::kConvert:
+      case HloOpcode::kExp:
+      case HloOpcode::kLog:
+      case HloOpcode::kLogistic:
+      case HloOpcode::kNegate:
+      case HloOpcode::kRsqrt:
+      case HloOpcode::kSqrt:
+      case HloOpcode::kTanh: {
+        TF_ASSIGN_OR_RETURN(tensor_ids[instr],
+                            DefineUnaryOp(subgraph, tensor_ids, instr));
+      } break;
+
       case HloOpcode::kAdd:
+      case HloOpcode::kDivide:
+      case HloOpcode::kMaximum:
+      case HloOpcode::kMinimum:
       case HloOpcode::kSubtract:
       case HloOpcode::kMultiply: {
         TF_ASSIGN_OR_RETURN(tensor_ids[instr],
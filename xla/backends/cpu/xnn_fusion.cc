@@ -104,4 +104,58 @@ absl::StatusOr<bool> IsXnnDotSupported(
          !dot_canonical_dims.rhs_column_major;
 }
 
+bool IsXnnBroadcastSupported(const HloInstruction* hlo) {
+  if (hlo->opcode() != HloOpcode::kBroadcast) {
+    return false;
+  }
+
+  int64_t operand_rank = hlo->operand(0)->shape().dimensions_size();
+  int64_t result_rank = hlo->shape().dimensions_size();
+
+  // Operand dimensions must be mapped to the trailing result dimensions in
+  // order, which is what numpy-style broadcasting does.
+  for (int64_t i = 0; i < operand_rank; ++i) {
+    if (hlo->dimensions(i) != result_rank - operand_rank + i) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsXnnUnaryOpSupported(const HloInstruction* hlo) {
+  switch (hlo->opcode()) {
+    case HloOpcode::kAbs:
+    case HloOpcode::kExp:
+    case HloOpcode::kLog:
+    case HloOpcode::kLogistic:
+    case HloOpcode::kNegate:
+    case HloOpcode::kRsqrt:
+    case HloOpcode::kSqrt:
+    case HloOpcode::kTanh:
+      return true;
+    case HloOpcode::kConvert: {
+      // XNNPACK supports conversions between floating point types.
+      PrimitiveType from = hlo->operand(0)->shape().element_type();
+      PrimitiveType to = hlo->shape().element_type();
+      return (from == F32 && to == F16) || (from == F16 && to == F32);
+    }
+    default:
+      return false;
+  }
+}
+
+bool IsXnnBinaryOpSupported(const HloInstruction* hlo) {
+  switch (hlo->opcode()) {
+    case HloOpcode::kAdd:
+    case HloOpcode::kDivide:
+    case HloOpcode::kMaximum:
+    case HloOpcode::kMinimum:
+    case HloOpcode::kMultiply:
+    case HloOpcode::kSubtract:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace xla::cpu
@@ -39,6 +39,18 @@ absl::StatusOr<bool> IsXnnDotSupported(
     const DotDimensionNumbers& dot_dimensions, const Shape& lhs_shape,
     const Shape& rhs_shape, const Shape& out_shape);
 
+// Returns true if the broadcast can be folded into the elementwise binary op
+// consuming it. XNNPACK binary ops implicitly broadcast operands following
+// numpy rules, which corresponds to HLO broadcasts into the trailing
+// dimensions of the result (i.e. bias vector or scalar broadcasts).
+bool IsXnnBroadcastSupported(const HloInstruction* hlo);
+
+// Returns true if the elementwise unary op is supported by XNNPACK.
+bool IsXnnUnaryOpSupported(const HloInstruction* hlo);
+
+// Returns true if the elementwise binary op is supported by XNNPACK.
+bool IsXnnBinaryOpSupported(const HloInstruction* hlo);
+
 }  // namespace xla::cpu
 
 #endif  // XLA_BACKENDS_CPU_XNN_FUSION_H_
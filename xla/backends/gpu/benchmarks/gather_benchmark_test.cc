@@ -0,0 +1,85 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "xla/array2d.h"
+#include "xla/backends/gpu/benchmarks/hlo_benchmark_runner.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/logging.h"
+#include "xla/tsl/platform/test_benchmark.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::gpu {
+
+static void BM_GatherF32(benchmark::State& state) {
+  int64_t d0 = state.range(0);
+  int64_t d1 = state.range(1);
+  int64_t slice_size = state.range(2);
+
+  absl::string_view hlo = R"(
+    HloModule gather_f32_d$d0_d$d1_s$slice_size
+
+    ENTRY e {
+      operand = f32[$d0,$d1] parameter(0)
+      indices = s32[$slice_size, 1] parameter(1)
+      ROOT gather = f32[$slice_size, $d1] gather(operand, indices),
+          offset_dims={1},
+          collapsed_slice_dims={0},
+          start_index_map={0},
+          index_vector_dim=1,
+          slice_sizes={1, $d1}
+    }
+  )";
+
+  std::minstd_rand0 engine;
+
+  auto operand_shape = ShapeUtil::MakeShape(F32, {d0, d1});
+  auto operand = *LiteralUtil::CreateRandomLiteral<F32>(
+      operand_shape, &engine, /*mean=*/1.0f, /*stddev=*/0.1f);
+
+  // Generate random indices to be used in the gather.
+  std::vector<int32_t> random_indices(slice_size);
+  std::uniform_int_distribution<int32_t> dist(0, d0 - 1);
+  absl::c_generate(random_indices, [&]() { return dist(engine); });
+
+  Array2D<int32_t> indices_2d(slice_size, 1);
+  for (int i = 0; i < slice_size; ++i) {
+    indices_2d(i, 0) = random_indices[i];
+  }
+  auto indices = LiteralUtil::CreateR2FromArray2D(indices_2d);
+
+  std::vector<const Literal*> args = {&operand, &indices};
+  CHECK_OK(RunHloBenchmark(state, hlo, args,
+                           {{"$d0", absl::StrCat(d0)},
+                            {"$d1", absl::StrCat(d1)},
+                            {"$slice_size", absl::StrCat(slice_size)}}));
+}
+
+BENCHMARK(BM_GatherF32)
+    ->UseManualTime()
+    ->Args({1024, 128, 1024})
+    ->Args({1024, 1024, 1024})
+    ->Args({65536, 128, 4096})
+    ->Args({65536, 1024, 16384});
+
+}  // namespace xla::gpu
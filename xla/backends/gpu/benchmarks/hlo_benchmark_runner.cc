@@ -0,0 +1,202 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/gpu/benchmarks/hlo_benchmark_runner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_replace.h"
+#include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "xla/hlo/builder/xla_computation.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/parser/hlo_parser.h"
+#include "xla/literal.h"
+#include "xla/pjrt/local_device_state.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/pjrt/pjrt_stream_executor_client.h"
+#include "xla/pjrt/plugin/xla_gpu/xla_gpu_client_options.h"
+#include "xla/pjrt/plugin/xla_gpu/xla_gpu_pjrt_client.h"
+#include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
+#include "xla/service/hlo_cost_analysis.h"
+#include "xla/service/hlo_module_config.h"
+#include "xla/stream_executor/device_description.h"
+#include "xla/stream_executor/event_based_timer.h"
+#include "xla/stream_executor/stream.h"
+#include "xla/tests/test_utils.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test_benchmark.h"
+#include "tsl/platform/casts.h"
+
+namespace xla::gpu {
+
+namespace {
+
+// Returns the time it takes to execute `flops` and to move `bytes` between
+// the device memory and the cores at the peak throughput of `device`.
+absl::Duration RooflineTime(const se::DeviceDescription& device, double flops,
+                            double bytes) {
+  double flops_per_second = /*fma:*/ 2.0 * device.core_count() *
+                            device.fpus_per_core() * device.clock_rate_ghz() *
+                            1e9;
+  double compute_seconds = flops / flops_per_second;
+  double memory_seconds = bytes / device.memory_bandwidth();
+  return absl::Seconds(std::max(compute_seconds, memory_seconds));
+}
+
+// Executes `executable` once and returns the execution time measured with
+// events recorded on the compute `stream` that PjRt launches work on.
+absl::StatusOr<absl::Duration> ExecuteAndTime(
+    PjRtLoadedExecutable* executable, absl::Span<PjRtBuffer* const> args,
+    PjRtDevice* device, se::Stream* stream) {
+  TF_ASSIGN_OR_RETURN(
+      std::unique_ptr<se::EventBasedTimer> timer,
+      stream->CreateEventBasedTimer(/*use_delay_kernel=*/false));
+  TF_ASSIGN_OR_RETURN(std::vector<std::unique_ptr<PjRtBuffer>> results,
+                      executable->ExecuteSharded(args, device, {}));
+  TF_ASSIGN_OR_RETURN(absl::Duration time, timer->GetElapsedDuration());
+  for (const std::unique_ptr<PjRtBuffer>& result : results) {
+    TF_RETURN_IF_ERROR(result->GetReadyFuture().Await());
+  }
+  return time;
+}
+
+}  // namespace
+
+absl::Status RunHloBenchmark(benchmark::State& state,
+                             absl::string_view hlo_module,
+                             absl::Span<const Literal* const> args,
+                             StrToStrMapping replacements,
+                             const HloBenchmarkOptions& benchmark_options) {
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtClient> client,
+                      GetXlaPjrtGpuClient(GpuClientOptions()));
+  PjRtDevice* device = client->addressable_devices().front();
+  TF_ASSIGN_OR_RETURN(PjRtMemorySpace * memory_space,
+                      device->default_memory_space());
+  LocalDeviceState* device_state =
+      tsl::down_cast<PjRtStreamExecutorDevice*>(device)->local_device_state();
+  const se::DeviceDescription& device_description =
+      device_state->executor()->GetDeviceDescription();
+
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<HloModule> module,
+                      ParseAndReturnUnverifiedModule(
+                          absl::StrReplaceAll(hlo_module, replacements),
+                          HloModuleConfig() /* unused */));
+
+  XlaComputation computation(module->ToProto());
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtLoadedExecutable> executable,
+                      client->CompileAndLoad(computation, CompileOptions()));
+
+  // If the user has not passed any arguments we need to generate fake
+  // arguments based on the parameters of the HLO module.
+  std::vector<Literal> fake_args;
+  std::vector<const Literal*> literals(args.begin(), args.end());
+  if (args.empty()) {
+    TF_ASSIGN_OR_RETURN(fake_args, MakeFakeArguments(module.get()));
+    for (const Literal& arg : fake_args) {
+      literals.push_back(&arg);
+    }
+  } else if (module->entry_computation()->num_parameters() !=
+             static_cast<int64_t>(args.size())) {
+    return absl::InvalidArgumentError(
+        "Number of arguments does not match the number of parameters in "
+        "the HLO module.");
+  }
+
+  std::vector<std::unique_ptr<PjRtBuffer>> args_buffers;
+  std::vector<PjRtBuffer*> args_ptrs;
+  args_buffers.reserve(literals.size());
+  args_ptrs.reserve(literals.size());
+  for (const Literal* literal : literals) {
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtBuffer> buffer,
+                        client->BufferFromHostLiteral(*literal, memory_space));
+    TF_RETURN_IF_ERROR(buffer->GetReadyFuture().Await());
+    args_ptrs.push_back(buffer.get());
+    args_buffers.push_back(std::move(buffer));
+  }
+
+  se::Stream* stream = device_state->compute_stream();
+
+  // Warm up executable until the execution time stabilizes, so that autotuning
+  // caches, lazily loaded kernels and clocks ramping up don't skew results.
+  CHECK_GE(benchmark_options.max_warmup_iterations, 1);
+  std::optional<absl::Duration> previous_time;
+  int32_t num_warmup_iterations = 0;
+  while (num_warmup_iterations < benchmark_options.max_warmup_iterations) {
+    TF_ASSIGN_OR_RETURN(
+        absl::Duration time,
+        ExecuteAndTime(executable.get(), args_ptrs, device, stream));
+    ++num_warmup_iterations;
+    if (previous_time.has_value() &&
+        absl::AbsDuration(time - *previous_time) <=
+            *previous_time * benchmark_options.warmup_tolerance) {
+      break;
+    }
+    previous_time = time;
+  }
+
+  // Benchmark executable.
+  absl::Duration total_time;
+  for (auto _ : state) {
+    TF_ASSIGN_OR_RETURN(
+        absl::Duration time,
+        ExecuteAndTime(executable.get(), args_ptrs, device, stream));
+    state.SetIterationTime(absl::ToDoubleSeconds(time));
+    total_time += time;
+  }
+
+  if (benchmark_options.max_warmup_iterations > 1) {
+    state.counters["warmup_iters"] = num_warmup_iterations;
+  }
+
+  // Report FLOP/s, bytes/s and the fraction of the roofline we achieve for
+  // the module after fusion.
+  TF_ASSIGN_OR_RETURN(std::vector<std::shared_ptr<HloModule>> optimized,
+                      executable->GetHloModules());
+  GpuHloCostAnalysis cost_analysis(HloCostAnalysis::Options{},
+                                   device_description);
+  TF_RETURN_IF_ERROR(
+      optimized.front()->entry_computation()->Accept(&cost_analysis));
+
+  state.counters["flops"] =
+      benchmark::Counter(cost_analysis.flop_count(),
+                         benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["bytes_accessed"] =
+      benchmark::Counter(cost_analysis.bytes_accessed(),
+                         benchmark::Counter::kIsIterationInvariantRate);
+
+  if (state.iterations() > 0 && total_time > absl::ZeroDuration()) {
+    absl::Duration roofline_time =
+        RooflineTime(device_description, cost_analysis.flop_count(),
+                     cost_analysis.bytes_accessed());
+    state.counters["sol_fraction"] = absl::FDivDuration(
+        roofline_time, total_time / state.iterations());
+  }
+
+  return absl::OkStatus();
+}
+
+}  // namespace xla::gpu
@@ -0,0 +1,66 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_BACKENDS_GPU_BENCHMARKS_HLO_BENCHMARK_RUNNER_H_
+#define XLA_BACKENDS_GPU_BENCHMARKS_HLO_BENCHMARK_RUNNER_H_
+
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+
+#include "absl/status/status.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/literal.h"
+#include "xla/tsl/platform/test_benchmark.h"
+
+namespace xla::gpu {
+
+// A string-to-string mapping that allows to parametrize HLO benchmarks.
+using StrToStrMapping =
+    std::initializer_list<std::pair<absl::string_view, absl::string_view>>;
+
+struct HloBenchmarkOptions {
+  // Maximum number of warmup runs before measuring. Warmup stops early once
+  // two consecutive runs take times within `warmup_tolerance` of each other.
+  int32_t max_warmup_iterations = 1;
+  double warmup_tolerance = 0.05;
+};
+
+// Runs the given HLO module as a benchmark on the first GPU.
+//
+// The HLO text can be interpolated using the given string replacements. If
+// `args` is empty, fake arguments are generated for the module parameters.
+//
+// Every iteration is timed on the device with events recorded on the compute
+// stream around the execution and reported with `state.SetIterationTime`, so
+// the benchmark must be registered with `UseManualTime()`.
+//
+// Besides the time, the benchmark reports:
+//   - `flops` and `bytes_accessed`: FLOP/s and bytes/s of the optimized HLO
+//     module according to GpuHloCostAnalysis.
+//   - `sol_fraction`: the speed-of-light (roofline) time of the module on the
+//     device, i.e. the maximum of its compute and memory time at peak
+//     throughput, divided by the measured time. 1.0 means the module runs at
+//     the roofline.
+absl::Status RunHloBenchmark(benchmark::State& state,
+                             absl::string_view hlo_module,
+                             absl::Span<const Literal* const> args,
+                             StrToStrMapping replacements = {},
+                             const HloBenchmarkOptions& benchmark_options = {});
+
+}  // namespace xla::gpu
+
+#endif  // XLA_BACKENDS_GPU_BENCHMARKS_HLO_BENCHMARK_RUNNER_H_
@@ -0,0 +1,106 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "xla/backends/gpu/benchmarks/hlo_benchmark_runner.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/logging.h"
+#include "xla/tsl/platform/test_benchmark.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::gpu {
+
+static void BM_RowReduceAddF32(benchmark::State& state) {
+  int64_t d0 = state.range(0);
+  int64_t d1 = state.range(1);
+
+  absl::string_view hlo = R"(
+    HloModule row_reduce_add_f32_$d0_$d1
+
+    add {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT add = f32[] add(p0, p1)
+    }
+
+    ENTRY e {
+      p0 = f32[$d0,$d1] parameter(0)
+      c0 = f32[] constant(0)
+      ROOT reduce = f32[$d0] reduce(p0, c0), dimensions={1}, to_apply=add
+    }
+  )";
+
+  std::minstd_rand0 engine;
+
+  auto shape = ShapeUtil::MakeShape(F32, {d0, d1});
+  auto p0 = *LiteralUtil::CreateRandomLiteral<F32>(shape, &engine, 1.0f, 0.1f);
+
+  std::vector<const Literal*> args = {&p0};
+  CHECK_OK(RunHloBenchmark(
+      state, hlo, args,
+      {{"$d0", absl::StrCat(d0)}, {"$d1", absl::StrCat(d1)}}));
+}
+
+static void BM_ColumnReduceAddF32(benchmark::State& state) {
+  int64_t d0 = state.range(0);
+  int64_t d1 = state.range(1);
+
+  absl::string_view hlo = R"(
+    HloModule column_reduce_add_f32_$d0_$d1
+
+    add {
+      p0 = f32[] parameter(0)
+      p1 = f32[] parameter(1)
+      ROOT add = f32[] add(p0, p1)
+    }
+
+    ENTRY e {
+      p0 = f32[$d0,$d1] parameter(0)
+      c0 = f32[] constant(0)
+      ROOT reduce = f32[$d1] reduce(p0, c0), dimensions={0}, to_apply=add
+    }
+  )";
+
+  std::minstd_rand0 engine;
+
+  auto shape = ShapeUtil::MakeShape(F32, {d0, d1});
+  auto p0 = *LiteralUtil::CreateRandomLiteral<F32>(shape, &engine, 1.0f, 0.1f);
+
+  std::vector<const Literal*> args = {&p0};
+  CHECK_OK(RunHloBenchmark(
+      state, hlo, args,
+      {{"$d0", absl::StrCat(d0)}, {"$d1", absl::StrCat(d1)}}));
+}
+
+#define BENCHMARK_SIZES(NAME)   \
+  BENCHMARK(NAME)               \
+      ->UseManualTime()         \
+      ->Args({1024, 1024})      \
+      ->Args({8192, 128})       \
+      ->Args({128, 8192})       \
+      ->Args({8192, 8192})      \
+      ->Args({32, 1048576})
+
+BENCHMARK_SIZES(BM_RowReduceAddF32);
+BENCHMARK_SIZES(BM_ColumnReduceAddF32);
+
+}  // namespace xla::gpu
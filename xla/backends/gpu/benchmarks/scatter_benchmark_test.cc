@@ -0,0 +1,96 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "xla/array2d.h"
+#include "xla/backends/gpu/benchmarks/hlo_benchmark_runner.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/logging.h"
+#include "xla/tsl/platform/test_benchmark.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::gpu {
+
+static void BM_ScatterAddF32(benchmark::State& state) {
+  int64_t d0 = state.range(0);
+  int64_t d1 = state.range(1);
+  int64_t num_updates = state.range(2);
+
+  absl::string_view hlo = R"(
+    HloModule scatter_add_f32_d$d0_d$d1_u$num_updates
+
+    add {
+      lhs = f32[] parameter(0)
+      rhs = f32[] parameter(1)
+      ROOT add = f32[] add(lhs, rhs)
+    }
+
+    ENTRY e {
+      operand = f32[$d0,$d1] parameter(0)
+      indices = s32[$num_updates,1] parameter(1)
+      updates = f32[$num_updates,$d1] parameter(2)
+      ROOT scatter = f32[$d0,$d1] scatter(operand, indices, updates),
+          update_window_dims={1},
+          inserted_window_dims={0},
+          scatter_dims_to_operand_dims={0},
+          index_vector_dim=1,
+          to_apply=add
+    }
+  )";
+
+  std::minstd_rand0 engine;
+
+  auto operand_shape = ShapeUtil::MakeShape(F32, {d0, d1});
+  auto updates_shape = ShapeUtil::MakeShape(F32, {num_updates, d1});
+  auto operand = *LiteralUtil::CreateRandomLiteral<F32>(
+      operand_shape, &engine, /*mean=*/1.0f, /*stddev=*/0.1f);
+  auto updates = *LiteralUtil::CreateRandomLiteral<F32>(
+      updates_shape, &engine, /*mean=*/1.0f, /*stddev=*/0.1f);
+
+  // Scatter to unique rows, so that the benchmark doesn't measure contention
+  // on atomics.
+  std::vector<int32_t> rows(d0);
+  std::iota(rows.begin(), rows.end(), 0);
+  std::shuffle(rows.begin(), rows.end(), engine);
+  Array2D<int32_t> indices_2d(num_updates, 1);
+  for (int i = 0; i < num_updates; ++i) {
+    indices_2d(i, 0) = rows[i % d0];
+  }
+  auto indices = LiteralUtil::CreateR2FromArray2D(indices_2d);
+
+  std::vector<const Literal*> args = {&operand, &indices, &updates};
+  CHECK_OK(RunHloBenchmark(state, hlo, args,
+                           {{"$d0", absl::StrCat(d0)},
+                            {"$d1", absl::StrCat(d1)},
+                            {"$num_updates", absl::StrCat(num_updates)}}));
+}
+
+BENCHMARK(BM_ScatterAddF32)
+    ->UseManualTime()
+    ->Args({1024, 128, 256})
+    ->Args({1024, 1024, 1024})
+    ->Args({65536, 128, 4096})
+    ->Args({65536, 1024, 16384});
+
+}  // namespace xla::gpu
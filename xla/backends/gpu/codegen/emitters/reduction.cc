@@ -36,6 +36,7 @@ limitations under the License.
 #include "absl/types/span.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MathExtras.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
@@ -960,13 +961,6 @@ std::unique_ptr<ReductionFusion> MultiRowReductionFusion::TryCreate(
   auto reduction_dimensions =
       GetReductionKindAndContiguousComponents(*hero_reduction);
   auto shape = reduction_dimensions.dimensions;
-  // This emitter only supports reductions where the reduced dimension is a
-  // power of 2.
-  if (shape[kRowMinorReduced] & (shape[kRowMinorReduced] - 1)) {
-    VLOG(3) << "MultiRowReductionFusion::TryCreate shape[kRowMinorReduced] = "
-            << shape[kRowMinorReduced] << " is not a power of 2";
-    return nullptr;
-  }
 
   // Normally, we only consider input types for vectorization. However, in
   // multi-row reductions, the input:output ratio is much higher, so we consider
@@ -989,6 +983,11 @@ std::unique_ptr<ReductionFusion> MultiRowReductionFusion::TryCreate(
   // outputs.
   int vector_size = std::min(static_cast<int>(shape[kRowMinorReduced]),
                              64 / smallest_input_or_output_bits);
+  // Vectors must not straddle rows, so the vector size has to divide the
+  // reduced dimension. If it is not a power of 2, the number of threads per row
+  // is padded to one (see GetNumThreads) and the padding threads are masked.
+  vector_size = std::min<int64_t>(
+      vector_size, shape[kRowMinorReduced] & -shape[kRowMinorReduced]);
 
   // Very large vector sizes for f32 can be detrimental, so we limit the vector
   // size to 16 bytes if we have some >= 32 bit inputs or outputs. This is still
@@ -1003,7 +1002,7 @@ std::unique_ptr<ReductionFusion> MultiRowReductionFusion::TryCreate(
 
   // The reduced dimension must fit into a single warp.
   const int64_t warp_size = analysis.device_info().threads_per_warp();
-  if (shape[kRowMinorReduced] > warp_size * vector_size) {
+  if (GetNumThreads(reduction_dimensions, vector_size).back() > warp_size) {
     VLOG(3) << "MultiRowReductionFusion::TryCreate reduced dimension "
             << shape[kRowMinorReduced] << " is larger than warp size "
             << warp_size << " * vector size " << vector_size
@@ -1025,7 +1024,7 @@ std::unique_ptr<ReductionFusion> MultiRowReductionFusion::TryCreate(
 
   // Check again that the reduced dimension fits after potentially reducing the
   // vector size.
-  if (shape[kRowMinorReduced] > warp_size * vector_size) {
+  if (GetNumThreads(reduction_dimensions, vector_size).back() > warp_size) {
     VLOG(3) << "MultiRowReductionFusion::TryCreate reduced dimension "
             << shape[kRowMinorReduced] << " is larger than warp size "
             << warp_size << " * vector size " << vector_size
@@ -1040,8 +1039,9 @@ std::unique_ptr<ReductionFusion> MultiRowReductionFusion::TryCreate(
 
 absl::InlinedVector<int64_t, 4> MultiRowReductionFusion::GetNumThreads(
     const ReductionDimensions& reduction_dimensions, int vector_size) {
-  int64_t num_threads_reduced =
-      reduction_dimensions.dimensions[kRowMinorReduced] / vector_size;
+  // Shuffle reductions need a power of 2 number of threads per row.
+  int64_t num_threads_reduced = llvm::PowerOf2Ceil(
+      reduction_dimensions.dimensions[kRowMinorReduced] / vector_size);
 
   constexpr int64_t kThreadsPerBlockTarget = 256;
   int64_t kept_size = reduction_dimensions.dimensions[kRowKept];
@@ -81,6 +81,11 @@ TransposeSpec GetTransposeSpec(const HloTransposeInstruction* transpose);
 
 // This is similar to the following CUDA algorithm in TensorFlow:
 // https://goo.gl/MStRV6.
+//
+// Tiles are staged through statically allocated shared memory. Using TMA bulk
+// tensor copies on sm_90+ would additionally require passing tensor map
+// descriptors as kernel arguments and emitting mbarrier synchronization, which
+// so far only the Triton emitters support.
 class TransposeFusion : public EmitterBase {
  public:
   explicit TransposeFusion(const HloFusionAnalysis& analysis);
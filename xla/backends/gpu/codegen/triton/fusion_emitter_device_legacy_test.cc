@@ -770,6 +770,36 @@ ENTRY e {
   EXPECT_TRUE(RunAndCompare(hlo_text, ErrorSpec{/*aabs=*/1e-3, /*arel=*/1e-3}));
 }
 
+TEST_F(TritonGemmTest, PersistentScheduleProducesCorrectResult) {
+  // 64 * 64 output tiles are more than a single wave of programs on any GPU,
+  // so every program computes several tiles.
+  constexpr absl::string_view kHloText = R"(
+HloModule m
+
+triton_gemm {
+  p0 = f16[2048,256] parameter(0)
+  p1 = f16[256,2048] parameter(1)
+  ROOT dot = f16[2048,2048] dot(p0, p1),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+}
+
+ENTRY e {
+  p0 = f16[2048,256] parameter(0)
+  p1 = f16[256,2048] parameter(1)
+  ROOT fusion = f16[2048,2048] fusion(p0, p1),
+       kind=kCustom, calls=triton_gemm,
+       backend_config={
+         "fusion_backend_config":{
+           "kind":"__triton_gemm","triton_gemm_config":{
+             "block_m":"32","block_n":"32","block_k":"32","split_k":"1",
+             "num_stages":"1","num_warps":"4","num_ctas":"1",
+             "is_persistent":true}}}
+})";
+
+  EXPECT_TRUE(RunAndCompareNoHloPasses(
+      kHloText, ErrorSpec{/*aabs=*/1e-3, /*arel=*/1e-3}));
+}
+
 TEST_F(TritonGemmTest, S8xS8) {
   const std::string hlo_text = R"(
 HloModule t
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/backends/gpu/codegen/triton/fusion_emitter_legacy_matmul.h"
 
+#include <algorithm>
 #include <array>
 #include <climits>
 #include <cstddef>
@@ -787,6 +788,10 @@ struct MatMulLaunchConfig {
 
   int64_t grid_m;
   int64_t grid_n;
+  // Number of programs along the non-contracting program ID dimension. These
+  // cover all grid_m * grid_n output tiles, each program looping over several
+  // of them if the schedule is persistent.
+  int64_t num_tile_programs;
   LaunchDimensions launch_dims;
   mt::ProgramIDDim batch_program_id_dim;
   mt::ProgramIDDim noncontracting_program_id_dim;
@@ -914,7 +919,8 @@ MatMulLaunchConfig::MatMulLaunchConfig(const TritonGemmConfig& config,
                                        const MatMulDims& dims,
                                        const se::DeviceDescription& device_info)
     : grid_m((dims.m + config.block_m - 1) / config.block_m),
-      grid_n((dims.n + config.block_n - 1) / config.block_n) {
+      grid_n((dims.n + config.block_n - 1) / config.block_n),
+      num_tile_programs(grid_m * grid_n) {
   int64_t batch_size = dims.lhs_noncontracting_split.value_or(
       dims.out_batch_dim_idx.has_value()
           ? dot.shape().dimensions(*dims.out_batch_dim_idx)
@@ -928,18 +934,25 @@ MatMulLaunchConfig::MatMulLaunchConfig(const TritonGemmConfig& config,
   CHECK_LT(batch_size * grid_m * grid_n,
            kBlockCountYZLimit * kBlockCountYZLimit);
 
+  // Persistent programs loop over output tiles, so that a single wave of
+  // programs covers the whole output.
+  if (config.is_persistent) {
+    num_tile_programs =
+        std::min<int64_t>(num_tile_programs, device_info.core_count());
+  }
+
   const bool large_batch = batch_size >= kBlockCountYZLimit;
   if (large_batch) {
     batch_program_id_dim = mt::ProgramIDDim::X;
     noncontracting_program_id_dim = mt::ProgramIDDim::Y;
     launch_dims = LaunchDimensions(
-        se::BlockDim(batch_size, grid_m * grid_n, config.split_k),
+        se::BlockDim(batch_size, num_tile_programs, config.split_k),
         se::ThreadDim(config.num_warps * WarpSize(device_info), 1, 1));
   } else {
     batch_program_id_dim = mt::ProgramIDDim::Y;
     noncontracting_program_id_dim = mt::ProgramIDDim::X;
     launch_dims = LaunchDimensions(
-        se::BlockDim(grid_m * grid_n, batch_size, config.split_k),
+        se::BlockDim(num_tile_programs, batch_size, config.split_k),
         se::ThreadDim(config.num_warps * WarpSize(device_info), 1, 1));
   }
 }
@@ -950,6 +963,8 @@ absl::Status ValidateMatMulConfig(const TritonGemmConfig& config,
   TF_RET_CHECK(config.block_m >= 16);
   TF_RET_CHECK(config.block_k >= 16);
   TF_RET_CHECK(config.block_n >= 16);
+  // Persistent programs only loop over output tiles.
+  TF_RET_CHECK(!config.is_persistent || config.split_k == 1);
 
   const auto& dims = dot.dot_dimension_numbers();
   int num_batch_dims =
@@ -1900,17 +1915,17 @@ absl::Status CheckGemmTilingComplexityHeuristic(
 
 class Scopes {
  public:
+  // `pid_nc` is the linear index of the output tile.
   Scopes(EmitterLocOpBuilder& b, const HloInstruction* dot_instr,
          const TritonFusionAnalysis& analysis, const MatMulDims& dims,
-         const TritonGemmConfig& config, const MatMulLaunchConfig launch_config)
+         const TritonGemmConfig& config, const MatMulLaunchConfig launch_config,
+         Value pid_nc)
       : lhs_(TritonFusionAnalysis::Scope::LHS),
         rhs_(TritonFusionAnalysis::Scope::RHS),
         out_(TritonFusionAnalysis::Scope::OUTPUT) {
     constexpr int group_m = 8;
     const int64_t width = group_m * launch_config.grid_n;
 
-    auto pid_nc = b.create<mt::GetProgramIdOp>(
-        launch_config.noncontracting_program_id_dim);
     pid_k_ = (config.split_k > 1)
                  ? b.create<mt::GetProgramIdOp>(mt::ProgramIDDim::Z)
                  : Value{};
@@ -2324,8 +2339,23 @@ absl::StatusOr<std::optional<stream_executor::gpu::TmaMetadata>> EmitMatMul(
   ma::ConstantOp accumulator_init =
       CreateConst(b, acc_ty, 0, {block_m, block_n});
 
+  Value pid_nc =
+      b.create<mt::GetProgramIdOp>(launch_config.noncontracting_program_id_dim);
+  // Persistent programs emit the rest of the kernel in a loop over the output
+  // tiles, strided by the number of programs.
+  std::optional<mlir::OpBuilder::InsertionGuard> tile_loop_guard;
+  if (config.is_persistent) {
+    auto tile_loop = b.create<mlir::scf::ForOp>(
+        /*lowerBound=*/pid_nc,
+        /*upperBound=*/Cst32(b, launch_config.grid_m * launch_config.grid_n),
+        /*step=*/Cst32(b, launch_config.num_tile_programs));
+    tile_loop_guard.emplace(b);
+    b.setInsertionPoint(tile_loop.getBody()->getTerminator());
+    pid_nc = tile_loop.getInductionVar();
+  }
+
   // Calculate the sizes of the lhs, rhs, meta, and output sides.
-  Scopes scopes(b, dot_instr, analysis, dims, config, launch_config);
+  Scopes scopes(b, dot_instr, analysis, dims, config, launch_config, pid_nc);
 
   llvm::SmallVector<IterableInput> inputs;
 
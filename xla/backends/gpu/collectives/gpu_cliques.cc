@@ -49,6 +49,7 @@ limitations under the License.
 #include "xla/debug_options_flags.h"
 #include "xla/executable_run_options.h"
 #include "xla/service/global_device_id.h"
+#include "xla/service/gpu/metrics.h"
 #include "xla/service/lockable.h"
 #include "xla/service/rendezvous.h"
 #include "xla/stream_executor/stream_executor.h"
@@ -291,10 +292,13 @@ InitializeGpuClique(GpuCollectives* collectives, se::StreamExecutor* device,
         clique_key.ToString(), DeviceRanksToString(ranks), nroots,
         clique_ids.fingerprint(), peer_access_enabled);
 
+    absl::Time start_time = absl::Now();
     TF_ASSIGN_OR_RETURN(
         std::vector<std::unique_ptr<Communicator>> created_comms,
         collectives->CreateCommunicators(clique_key, clique_ids, ranks,
                                          config));
+    RecordGpuCliqueCreationDuration(
+        /*split=*/false, absl::ToInt64Microseconds(absl::Now() - start_time));
 
     absl::btree_map<RankId, std::unique_ptr<Communicator>> comms;
     for (size_t i = 0; i < ranks.size(); ++i) {
@@ -464,9 +468,12 @@ InitializeGpuClique(GpuCollectives* collectives, se::StreamExecutor* device,
         peer_access_enabled,
         absl::StrJoin(rank_mapping, ",", rank_mapping_formatter));
 
+    absl::Time start_time = absl::Now();
     TF_ASSIGN_OR_RETURN(
         auto splitted_comms,
         collectives->SplitCommunicators(parent_comms, color, keys, config));
+    RecordGpuCliqueCreationDuration(
+        /*split=*/true, absl::ToInt64Microseconds(absl::Now() - start_time));
 
     absl::btree_map<RankId, std::unique_ptr<Communicator>> comms;
     for (size_t i = 0; i < splitted_comms.size(); ++i) {
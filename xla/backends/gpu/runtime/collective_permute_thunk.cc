@@ -58,7 +58,6 @@ limitations under the License.
 
 namespace xla {
 namespace gpu {
-namespace {
 
 absl::StatusOr<const int64_t> GetCurrentId(
     Thunk::CollectiveExecuteParams* collective_params,
@@ -74,6 +73,8 @@ absl::StatusOr<const int64_t> GetCurrentId(
   return current_id;
 }
 
+namespace {
+
 bool IsLocalPeerTransfer(const P2PConfig::SourceTargetMapEntry& source_target,
                          const int64_t current_id, const int64_t device_count) {
   const std::optional<int64_t> source_id = source_target.source;
@@ -260,6 +261,18 @@ absl::Status CollectivePermuteStartThunk::RunCollective(
                     p2p_memcpy_enabled_;
 
   TF_ASSIGN_OR_RETURN(GpuCollectives * collectives, GetGpuCollectives(params));
+
+  // Number of local participants in the rendezvous that order memcpy p2p
+  // transfers with the receiving side. Computed once for both rendezvous.
+  size_t num_local_participants = 0;
+  if (use_memcpy) {
+    TF_ASSIGN_OR_RETURN(
+        num_local_participants,
+        GetNumLocalParticipants(*params.collective_params,
+                                config().replica_groups, config().group_mode));
+  }
+  auto rendezvous_key = CallRendezvousKey{params.collective_params->run_id};
+
   if (use_memcpy) {
     std::optional<int64_t> source_id = source_target.source;
     std::optional<int64_t> target_id = source_target.target;
@@ -272,17 +285,11 @@ absl::Status CollectivePermuteStartThunk::RunCollective(
       auto receiver_event = receiver_barrier_events_.find(current_id);
       TF_RETURN_IF_ERROR(stream.RecordEvent(receiver_event->second.get()));
     }
-    TF_ASSIGN_OR_RETURN(
-        size_t num_local_participants,
-        GetNumLocalParticipants(*params.collective_params,
-                                config().replica_groups, config().group_mode));
-
     auto rendezvous_name = absl::StrFormat(
         "rendezvous before calling collective-permute; run_id=%d; op id:%d; "
         "num_local_participants:%d",
         params.collective_params->run_id.ToInt(), config_.config.op_id,
         num_local_participants);
-    auto rendezvous_key = CallRendezvousKey{params.collective_params->run_id};
 
     // Perform a rendezvous to make sure all receivers have their events
     // recorded.
@@ -313,17 +320,11 @@ absl::Status CollectivePermuteStartThunk::RunCollective(
       auto sender_event = sender_barrier_events_.find(current_id);
       TF_RETURN_IF_ERROR(stream.RecordEvent(sender_event->second.get()));
     }
-    TF_ASSIGN_OR_RETURN(
-        size_t num_local_participants,
-        GetNumLocalParticipants(*params.collective_params,
-                                config().replica_groups, config().group_mode));
-
     auto rendezvous_name = absl::StrFormat(
         "rendezvous after calling collective-permute; run_id=%d; op id:%d; "
         "num_local_participants:%d",
         params.collective_params->run_id.ToInt(), config_.config.op_id,
         num_local_participants);
-    auto rendezvous_key = CallRendezvousKey{params.collective_params->run_id};
 
     // Perform a rendezvous to make sure all senders have their events
     // recorded.
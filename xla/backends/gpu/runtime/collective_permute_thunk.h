@@ -29,6 +29,7 @@ limitations under the License.
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "xla/backends/gpu/collectives/gpu_collectives.h"
 #include "xla/backends/gpu/runtime/collective_thunk.h"
 #include "xla/backends/gpu/runtime/p2p_thunk_common.h"
@@ -110,6 +111,11 @@ class CollectivePermuteStartThunk : public CollectiveThunk {
 
   static const char* GetHloOpName() { return "collective-permute-start"; }
 
+  const P2PConfig& p2p_config() const { return config_; }
+  absl::Span<const Buffer> buffers() const { return buffers_; }
+  bool p2p_memcpy_enabled() const { return p2p_memcpy_enabled_; }
+  AsyncStreamKind stream_kind() const { return GetAsyncStreamKind(); }
+
  protected:
   const CollectiveConfig& config() const override { return config_.config; }
   absl::Status RunCollective(const ExecuteParams& params, se::Stream& stream,
@@ -129,6 +135,11 @@ class CollectivePermuteStartThunk : public CollectiveThunk {
   int64_t device_count_;
 };
 
+// Returns the id of the current device in the collective permute source-target
+// pairs: replica id for cross-replica and partition id for other group modes.
+absl::StatusOr<const int64_t> GetCurrentId(
+    Thunk::CollectiveExecuteParams* collective_params, const P2PConfig& config);
+
 absl::Status RunCollectivePermute(
     GpuCollectives* collectives, P2PConfig::SourceTargetMapEntry source_target,
     std::vector<DeviceBufferPair>& buffers, se::Stream& stream,
@@ -303,12 +303,27 @@ absl::Status RegisterBufferOnce(GpuCollectives* collectives,
     // Device ordinal, communicator, and base pointer address.
     absl::flat_hash_set<std::tuple<int, Communicator*, void*>> records
         ABSL_GUARDED_BY(mu);
+    // Device ordinal, communicator, and buffer address of all buffers that
+    // are known to be inside registered chunks. Collective buffers keep their
+    // addresses across executions, and we use this set to skip the memory
+    // range query on the hot path.
+    absl::flat_hash_set<std::tuple<int, Communicator*, void*>> buffers
+        ABSL_GUARDED_BY(mu);
     // Buffers could be deregistered with ncclCommDeregister.
     std::vector<std::unique_ptr<Communicator::RegisteredBufferHandle>> handles
         ABSL_GUARDED_BY(mu);
   };
   static auto& all_registered = *new RegisteredBuffers;
 
+  std::tuple<int, Communicator*, void*> buffer_record = {
+      executor->device_ordinal(), comm, buffer.opaque()};
+  {
+    absl::MutexLock lock(&all_registered.mu);
+    if (all_registered.buffers.contains(buffer_record)) {
+      return absl::OkStatus();
+    }
+  }
+
   // Since each XLA buffer is a slice into a larger BFCAllocator chunk, first
   // get the base address of buffer. We will use the base address to keep track
   // of which chunks we have registered.
@@ -325,6 +340,7 @@ absl::Status RegisterBufferOnce(GpuCollectives* collectives,
     all_registered.records.insert(
         {executor->device_ordinal(), comm, base_buffer.opaque()});
   }
+  all_registered.buffers.insert(buffer_record);
   return absl::OkStatus();
 }
 
@@ -48,8 +48,10 @@ limitations under the License.
 #include "xla/backends/gpu/runtime/all_to_all_thunk.h"
 #include "xla/backends/gpu/runtime/annotation.h"
 #include "xla/backends/gpu/runtime/collective_broadcast_thunk.h"
+#include "xla/backends/gpu/runtime/collective_permute_thunk.h"
 #include "xla/backends/gpu/runtime/collective_thunk.h"
 #include "xla/backends/gpu/runtime/dynamic_slice_thunk.h"
+#include "xla/backends/gpu/runtime/p2p_thunk_common.h"
 #include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/debug_options_flags.h"
 #include "xla/executable_run_options.h"
@@ -66,6 +68,7 @@ limitations under the License.
 #include "xla/service/gpu/kernels/custom_kernel.h"
 #include "xla/service/gpu/launch_dimensions.h"
 #include "xla/service/gpu/matmul_utils.h"
+#include "xla/service/gpu/metrics.h"
 #include "xla/service/gpu/stream_executor_util.h"
 #include "xla/shape_util.h"
 #include "xla/status_macros.h"
@@ -205,7 +208,14 @@ void CommandBufferCmdSequence::Append(std::unique_ptr<CommandBufferCmd> cmd) {
 
   if (requires_barrier) ClearTrackedBuffers();
 
-  commands_.push_back({std::move(cmd), requires_barrier});
+  absl::flat_hash_set<BufferAllocation::Index> cmd_allocs_indices;
+  for (const BufferUse& buffer : buffers) {
+    cmd_allocs_indices.insert(buffer.slice().index());
+  }
+
+  commands_.push_back(
+      {std::move(cmd), requires_barrier,
+       {cmd_allocs_indices.begin(), cmd_allocs_indices.end()}});
   TrackBuffers(buffers);
 }
 
@@ -272,6 +282,16 @@ static absl::string_view RecordModeString(
   }
 }
 
+bool CommandBufferCmdSequence::RequiresUpdate(
+    const CommandInfo& command,
+    const absl::flat_hash_set<BufferAllocation::Index>& updated_allocs) {
+  return command.cmd->force_update() ||
+         absl::c_any_of(command.allocs_indices,
+                        [&](BufferAllocation::Index index) {
+                          return updated_allocs.contains(index);
+                        });
+}
+
 absl::Status CommandBufferCmdSequence::Record(
     const Thunk::ExecuteParams& execute_params,
     const CommandBufferCmd::RecordParams& record_params,
@@ -286,12 +306,43 @@ absl::Status CommandBufferCmdSequence::Record(
     }
   }
 
+  // Checkpoints are tracked only for exclusive command buffers, as sequences
+  // recorded into conditional command buffers might be recorded more than once
+  // into different command buffers (i.e. while loop condition).
+  std::vector<se::CommandBuffer::Checkpoint>* checkpoints =
+      mode == RecordMode::kExclusive ? record_params.checkpoints : nullptr;
+
+  // We can skip updating commands that do not use any of the updated buffer
+  // allocations if we know where recorded commands are in the command buffer.
+  bool is_update =
+      command_buffer->state() == se::CommandBuffer::State::kUpdate;
+  bool skip_updates = is_update && checkpoints &&
+                      record_params.updated_allocs &&
+                      checkpoints->size() == commands_.size();
+  if (checkpoints && !skip_updates) checkpoints->clear();
+
   // Track the number of commands recorded between barriers.
   int64_t num_recorded_commands = 0;
 
-  for (CommandInfo& command : commands_) {
+  // Track the number of commands updated and skipped for metrics.
+  int64_t num_updated_commands = 0;
+  int64_t num_skipped_commands = 0;
+
+  for (size_t i = 0; i < commands_.size(); ++i) {
+    CommandInfo& command = commands_[i];
+
+    if (skip_updates &&
+        !RequiresUpdate(command, *record_params.updated_allocs)) {
+      TF_RETURN_IF_ERROR(command_buffer->SkipUpdatesTo((*checkpoints)[i]));
+      ++num_skipped_commands;
+      continue;
+    }
+
     if (execute_params.mock_collectives &&
         dynamic_cast<CollectiveCmd*>(command.cmd.get())) {
+      if (checkpoints && !skip_updates) {
+        checkpoints->push_back(command_buffer->checkpoint());
+      }
       continue;
     }
 
@@ -308,16 +359,27 @@ absl::Status CommandBufferCmdSequence::Record(
     TF_RETURN_IF_ERROR(
         command.cmd->Record(execute_params, record_params, command_buffer));
     ++num_recorded_commands;
+    ++num_updated_commands;
+
+    if (checkpoints && !skip_updates) {
+      checkpoints->push_back(command_buffer->checkpoint());
+    }
   }
 
   if (mode == RecordMode::kExclusive) {
     TF_RETURN_IF_ERROR(command_buffer->Finalize());
   }
 
+  if (is_update && mode == RecordMode::kExclusive) {
+    RecordCommandBufferUpdate(num_updated_commands, num_skipped_commands);
+  }
+
   uint64_t end_micros = tsl::Env::Default()->NowMicros();
   VLOG(3) << "Recorded " << commands_.size()
           << " commands into command buffer in " << (end_micros - start_micros)
-          << " μs; mode=" << RecordModeString(mode);
+          << " μs; mode=" << RecordModeString(mode)
+          << "; updated=" << num_updated_commands
+          << "; skipped=" << num_skipped_commands;
 
   return absl::OkStatus();
 }
@@ -1832,6 +1894,79 @@ CommandBufferCmd::BufferUseVector CollectiveBroadcastCmd::buffers() {
   return buffer_usage;
 }
 
+//===----------------------------------------------------------------------===//
+// CollectivePermuteCmd
+//===----------------------------------------------------------------------===//
+
+CollectivePermuteCmd::CollectivePermuteCmd(
+    ExecutionStreamId execution_stream_id,
+    ExecutionStreamId async_from_stream_id, P2PConfig p2p_config,
+    AsyncStreamKind stream_kind,
+    absl::Span<const CollectiveThunk::Buffer> buffers)
+    : CollectiveCmd(CommandBufferCmdType::kCollectivePermuteCmd,
+                    execution_stream_id, async_from_stream_id,
+                    p2p_config.config),
+      p2p_config_(std::move(p2p_config)),
+      stream_kind_(stream_kind),
+      buffers_(buffers.begin(), buffers.end()) {}
+
+absl::Status CollectivePermuteCmd::Record(
+    const Thunk::ExecuteParams& execute_params,
+    const RecordParams& record_params, se::CommandBuffer* command_buffer) {
+  TF_ASSIGN_OR_RETURN(
+      std::vector<DeviceBufferPair> device_buffers,
+      ConvertToDeviceBuffers(execute_params.buffer_allocations, buffers_,
+                             config().operand_element_type));
+
+  VLOG(5) << "CollectivePermuteCmd:";
+
+  for (size_t i = 0; i < device_buffers.size(); ++i) {
+    VLOG(5) << "  Src: " << buffers_[i].source_buffer << " ("
+            << device_buffers[i].source_buffer.opaque() << ")";
+    VLOG(5) << "  Dst: " << buffers_[i].destination_buffer << " ("
+            << device_buffers[i].destination_buffer.opaque() << ")";
+  }
+
+  if (!execute_params.collective_params || !execute_params.collective_cliques) {
+    return absl::InvalidArgumentError(
+        "CollectivePermuteCmd requires collective parameters and cliques");
+  }
+
+  TF_ASSIGN_OR_RETURN(
+      const int64_t current_id,
+      GetCurrentId(execute_params.collective_params, p2p_config_));
+  std::string device_string =
+      CollectiveThunk::GetDeviceString(*execute_params.collective_params);
+  P2PConfig::SourceTargetMapEntry source_target =
+      P2PConfig::GetSourceTarget(p2p_config_.id_to_source_target, current_id);
+
+  TF_ASSIGN_OR_RETURN(GpuCollectives * collectives,
+                      Thunk::GetGpuCollectives(execute_params));
+
+  TF_ASSIGN_OR_RETURN(
+      CommunicatorHandle comm_handle,
+      GetComm(collectives, *execute_params.collective_params,
+              *execute_params.collective_cliques, config().replica_groups,
+              config().group_mode, GetAsyncStreamKind()));
+
+  return AddTracedCommandBuffer(
+      execute_params, record_params, command_buffer, [&](se::Stream* stream) {
+        return RunCollectivePermute(collectives, source_target, device_buffers,
+                                    *stream, comm_handle.comm, device_string,
+                                    current_id, /*use_memcpy=*/false,
+                                    recv_ptr_map_);
+      });
+}
+
+CommandBufferCmd::BufferUseVector CollectivePermuteCmd::buffers() {
+  BufferUseVector buffer_usage;
+  for (auto& buffer : buffers_) {
+    buffer_usage.emplace_back(buffer.source_buffer, MemoryAccess::kRead);
+    buffer_usage.emplace_back(buffer.destination_buffer, MemoryAccess::kWrite);
+  }
+  return buffer_usage;
+}
+
 //===----------------------------------------------------------------------===//
 // DynamicSliceFusionCmd
 //===----------------------------------------------------------------------===//
@@ -1951,38 +2086,23 @@ absl::Status DynamicSliceFusionCmd::Record(
   };
 
   VLOG(2) << "Execute address computation thunk: slices=" << slices_.size();
-  for (auto [argument_idx, slice] : llvm::enumerate(slices_)) {
-    // Skip arguments that do not have buffer slices (tokens).
-    if (!slice.embedded_thunk_argument.has_value()) {
-      continue;
-    }
 
-    // `argument_buffer` will contain the original offset for slice
-    // `argument_slice` within `orig_allocations`
-    se::DeviceMemoryBase argument_buffer =
-        orig_allocations.GetDeviceAddress(*slice.embedded_thunk_argument);
+  // Number of issued d2h transfers to copy offset values from device to host.
+  int64_t num_transfers = 0;
 
-    // If argument is not sliced, just use the original buffer.
-    if (!slice.offsets.has_value()) {
-      slice_buffers[argument_idx] = argument_buffer;
+  // Collect offset values for all sliced arguments first, so that we wait for
+  // the completion of all device to host transfers only once.
+  for (auto [argument_idx, slice] : llvm::enumerate(slices_)) {
+    // Skip arguments that do not have buffer slices (tokens) or that are not
+    // sliced.
+    if (!slice.embedded_thunk_argument.has_value() ||
+        !slice.offsets.has_value()) {
       continue;
     }
 
-    const Shape& src_shape = *slice.orig_shape;
-    const Shape& dst_shape = *slice.sliced_shape;
-
-    absl::InlinedVector<int64_t, 4> slice_starts;
-    slice_starts.reserve(dst_shape.dimensions_size());
-
-    // Number of issues d2h transfers to copy offset values from device to
-    // host.
-    int64_t num_transfers = 0;
-
     // Get offset for `argument_idx`-th argument, which has
     // `dst_shape.dimensions_size()` components.
-    for (auto [offset_idx, values] : llvm::enumerate(llvm::zip(
-             *slice.offsets, src_shape.dimensions(), dst_shape.dimensions()))) {
-      auto [offset, src_dim, dst_dim] = values;
+    for (auto [offset_idx, offset] : llvm::enumerate(*slice.offsets)) {
       if (int64_t* const_offset = std::get_if<int64_t>(&offset)) {
         // Forward slice offsets that are known constant values
         VLOG(2) << "  - arg " << argument_idx << "[" << offset_idx
@@ -2006,13 +2126,37 @@ absl::Status DynamicSliceFusionCmd::Record(
         ++num_transfers;
       }
     }
+  }
+
+  // Wait for the completion of all transfers.
+  if (num_transfers > 0) {
+    VLOG(2) << "Wait for completion of " << num_transfers << " transfer";
+    TF_RETURN_IF_ERROR(stream.BlockHostUntilDone());
+  }
+
+  for (auto [argument_idx, slice] : llvm::enumerate(slices_)) {
+    // Skip arguments that do not have buffer slices (tokens).
+    if (!slice.embedded_thunk_argument.has_value()) {
+      continue;
+    }
+
+    // `argument_buffer` will contain the original offset for slice
+    // `argument_slice` within `orig_allocations`
+    se::DeviceMemoryBase argument_buffer =
+        orig_allocations.GetDeviceAddress(*slice.embedded_thunk_argument);
 
-    // Wait for the completion of all transfers.
-    if (num_transfers > 0) {
-      VLOG(2) << "Wait for completion of " << num_transfers << " transfer";
-      TF_RETURN_IF_ERROR(stream.BlockHostUntilDone());
+    // If argument is not sliced, just use the original buffer.
+    if (!slice.offsets.has_value()) {
+      slice_buffers[argument_idx] = argument_buffer;
+      continue;
     }
 
+    const Shape& src_shape = *slice.orig_shape;
+    const Shape& dst_shape = *slice.sliced_shape;
+
+    absl::InlinedVector<int64_t, 4> slice_starts;
+    slice_starts.reserve(dst_shape.dimensions_size());
+
     // Clamp start indices:
     // start_indices[i] = min(max(start_indices[i], 0),
     //                        operand.dimension_size[i] - size_indices[i])
@@ -2060,8 +2204,11 @@ absl::Status DynamicSliceFusionCmd::Record(
       execute_params.stream->parent()
           ->CreateCommandBuffer(se::CommandBuffer::Mode::kNested)
           .value();
-  TF_RETURN_IF_ERROR(embedded_commands_->Record(new_params, record_params,
-                                                nested_command_buffer.get()));
+  // Embedded commands are recorded into a new nested command buffer, and do
+  // not share update checkpoints with the parent command buffer.
+  CommandBufferCmd::RecordParams nested_record_params = {record_params.state};
+  TF_RETURN_IF_ERROR(embedded_commands_->Record(
+      new_params, nested_record_params, nested_command_buffer.get()));
   return command_buffer->AddNestedCommandBuffer(*nested_command_buffer);
 }
 
@@ -36,9 +36,11 @@ limitations under the License.
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/backends/gpu/collectives/gpu_clique_key.h"
+#include "xla/backends/gpu/runtime/collective_permute_thunk.h"
 #include "xla/backends/gpu/runtime/collective_thunk.h"
 #include "xla/backends/gpu/runtime/custom_call_thunk.h"
 #include "xla/backends/gpu/runtime/dynamic_slice_thunk.h"
+#include "xla/backends/gpu/runtime/p2p_thunk_common.h"
 #include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/ffi/api/c_api.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -86,6 +88,7 @@ namespace xla::gpu {
   V(kAllToAll, "AllToAllCmd")                            \
   V(kAllGatherCmd, "AllGatherCmd")                       \
   V(kCollectiveBroadcastCmd, "CollectiveBroadcastCmd")   \
+  V(kCollectivePermuteCmd, "CollectivePermuteCmd")       \
   V(kDynamicSliceFusionCmd, "DynamicSliceFusionCmd")     \
   V(kUnknownCmd, "UnknownCmd") \
   // clang-format on
@@ -178,6 +181,18 @@ class CommandBufferCmd {
     // An external state manager that gives efficient access to per-device state
     // to commands without a need to add expensive synchronization.
     StateManager& state;
+
+    // Indices of buffer allocations with device addresses that changed since
+    // the last time the command sequence was recorded into the command buffer.
+    // If set, updates of exclusive command buffers skip commands that do not
+    // use any of these allocations and do not require an update on every call.
+    const absl::flat_hash_set<BufferAllocation::Index>* updated_allocs =
+        nullptr;
+
+    // Command buffer checkpoints after each command of an exclusive command
+    // sequence. Filled when the sequence is recorded, and required for
+    // skipping commands at update time.
+    std::vector<se::CommandBuffer::Checkpoint>* checkpoints = nullptr;
   };
 
   // See Thunk documentation for XLA execution stages (prepare, initialize,
@@ -334,8 +349,17 @@ class CommandBufferCmdSequence {
   struct CommandInfo {
     std::unique_ptr<CommandBufferCmd> cmd;
     bool requires_barrier;
+
+    // Buffer allocations indices referenced by the command.
+    std::vector<BufferAllocation::Index> allocs_indices;
   };
 
+  // Returns true if the command must be updated in a command buffer given the
+  // set of buffer allocations with changed device addresses.
+  static bool RequiresUpdate(
+      const CommandInfo& command,
+      const absl::flat_hash_set<BufferAllocation::Index>& updated_allocs);
+
   // Functions for tracking buffer usage of recorded commands and figuring out
   // when the next command requires a barrier for correctness.
   bool HasConflicts(const CommandBufferCmd::BufferUseVector& buffers);
@@ -1071,8 +1095,43 @@ class CollectiveBroadcastCmd : public CollectiveCmd {
 
   BufferUseVector buffers() override;
 
+  AsyncStreamKind GetAsyncStreamKind() override {
+    return AsyncStreamKind::kCollective;
+  };
+
+ private:
+  std::vector<CollectiveThunk::Buffer> buffers_;
+};
+
+//===----------------------------------------------------------------------===//
+// CollectivePermuteCmd
+//===----------------------------------------------------------------------===//
+
+// Collective permute recorded into a command buffer. Only supports transfers
+// via collectives, because memcpy-based local peer transfers require host-side
+// rendezvous between participating devices.
+class CollectivePermuteCmd : public CollectiveCmd {
+ public:
+  CollectivePermuteCmd(ExecutionStreamId execution_stream_id,
+                       ExecutionStreamId async_from_stream_id,
+                       P2PConfig p2p_config, AsyncStreamKind stream_kind,
+                       absl::Span<const CollectiveThunk::Buffer> buffers);
+
+  absl::Status Record(const Thunk::ExecuteParams& execute_params,
+                      const RecordParams& record_params,
+                      se::CommandBuffer* command_buffer) override;
+
+  BufferUseVector buffers() override;
+
+  AsyncStreamKind GetAsyncStreamKind() override { return stream_kind_; };
+
  private:
+  P2PConfig p2p_config_;
+  AsyncStreamKind stream_kind_;
   std::vector<CollectiveThunk::Buffer> buffers_;
+
+  // Receive pointers are used only by memcpy-based transfers.
+  CollectivePermuteStartThunk::RecvPtrMap recv_ptr_map_;
 };
 
 //===----------------------------------------------------------------------===//
@@ -27,6 +27,8 @@ limitations under the License.
 #include "xla/backends/gpu/runtime/all_gather_thunk.h"
 #include "xla/backends/gpu/runtime/all_reduce_thunk.h"
 #include "xla/backends/gpu/runtime/all_to_all_thunk.h"
+#include "xla/backends/gpu/runtime/collective_broadcast_thunk.h"
+#include "xla/backends/gpu/runtime/collective_permute_thunk.h"
 #include "xla/backends/gpu/runtime/command_buffer_cmd.h"
 #include "xla/backends/gpu/runtime/conditional_thunk.h"
 #include "xla/backends/gpu/runtime/copy_thunk.h"
@@ -197,6 +199,26 @@ static absl::StatusOr<Command> Convert(const AllGatherStartThunk& thunk) {
                                         thunk.config(), thunk.buffers());
 }
 
+static absl::StatusOr<Command> Convert(
+    const CollectiveBroadcastStartThunk& thunk) {
+  return std::make_unique<CollectiveBroadcastCmd>(
+      thunk.nccl_execution_stream_id(), thunk.execution_stream_id(),
+      thunk.config(), thunk.buffers());
+}
+
+static absl::StatusOr<Command> Convert(
+    const CollectivePermuteStartThunk& thunk) {
+  // Memcpy-based transfers synchronize with peers on the host and can't be
+  // captured into a command buffer.
+  if (thunk.p2p_memcpy_enabled()) {
+    return absl::UnimplementedError(
+        "Memcpy-based collective permute is not supported in command buffers");
+  }
+  return std::make_unique<CollectivePermuteCmd>(
+      thunk.nccl_execution_stream_id(), thunk.execution_stream_id(),
+      thunk.p2p_config(), thunk.stream_kind(), thunk.buffers());
+}
+
 static absl::StatusOr<Command> Convert(const DynamicSliceThunk& thunk) {
   auto cmd_sequence = std::make_unique<CommandBufferCmdSequence>();
   auto embed_thunk = thunk.get_embedded_thunk();
@@ -307,6 +329,10 @@ static absl::Status AppendCommands(
       return append(Convert<ReduceScatterStartThunk>(thunk));
     case Thunk::Kind::kAllToAllStart:
       return append(Convert<AllToAllStartThunk>(thunk));
+    case Thunk::Kind::kCollectiveBroadcastStart:
+      return append(Convert<CollectiveBroadcastStartThunk>(thunk));
+    case Thunk::Kind::kCollectivePermuteStart:
+      return append(Convert<CollectivePermuteStartThunk>(thunk));
     case Thunk::Kind::kPartitionId:
       return append(Convert<PartitionIdThunk>(thunk));
     case Thunk::Kind::kReplicaId:
@@ -331,6 +357,8 @@ static absl::Status AppendCommands(
     case Thunk::Kind::kAllReduceDone:
     case Thunk::Kind::kReduceScatterDone:
     case Thunk::Kind::kAllToAllDone:
+    case Thunk::Kind::kCollectiveBroadcastDone:
+    case Thunk::Kind::kCollectivePermuteDone:
     case Thunk::Kind::kWaitForStreams:
       return absl::OkStatus();
 
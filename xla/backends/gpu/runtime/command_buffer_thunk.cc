@@ -22,10 +22,13 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/base/thread_annotations.h"
 #include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "xla/backends/gpu/runtime/annotation.h"
 #include "xla/backends/gpu/runtime/command_buffer_cmd.h"
 #include "xla/backends/gpu/runtime/sequential_thunk.h"
@@ -59,12 +62,14 @@ CommandBufferThunk::ExecutorCommandBuffer::ExecutorCommandBuffer(
 CommandBufferThunk::CommandBufferThunk(
     CommandBufferCmdSequence commands, ThunkInfo thunk_info,
     std::unique_ptr<SequentialThunk> thunks,
-    bool enable_command_buffers_during_profiling)
+    bool enable_command_buffers_during_profiling,
+    int64_t command_buffer_cache_size)
     : Thunk(Thunk::kCommandBuffer, std::move(thunk_info)),
       commands_(std::move(commands)),
       thunks_(std::move(thunks)),
       enable_command_buffers_during_profiling_(
           enable_command_buffers_during_profiling),
+      command_buffer_cache_size_(command_buffer_cache_size),
       state_(std::make_shared<State>()) {
   // When we create a new command buffer thunk (which happens when we
   // instantiate a new Gpu executable) we evict command buffers for all
@@ -85,13 +90,11 @@ CommandBufferThunk::CommandBufferThunk(
 bool CommandBufferThunk::ExecutorCommandBuffer::ShouldUpdateCommandBuffer(
     const CommandBufferCmdSequence& commands,
     const Thunk::ExecuteParams& params) {
-  if (commands.force_update()) {
-    return true;
-  }
-
-  bool should_update = false;
+  bool should_update = commands.force_update();
   const BufferAllocations* allocs = params.buffer_allocations;
 
+  updated_allocs.clear();
+
   // We check only allocations referenced by commands in a cmd sequence, and
   // leave every other entry default initialized (nullptr device memory).
   for (BufferAllocation::Index index : commands.allocs_indices()) {
@@ -104,6 +107,7 @@ bool CommandBufferThunk::ExecutorCommandBuffer::ShouldUpdateCommandBuffer(
 
     if (!recorded_allocs[index].IsSameAs(alloc)) {
       recorded_allocs[index] = alloc;
+      updated_allocs.insert(index);
       should_update = true;
     }
   }
@@ -111,6 +115,65 @@ bool CommandBufferThunk::ExecutorCommandBuffer::ShouldUpdateCommandBuffer(
   return should_update;
 }
 
+absl::StatusOr<bool>
+CommandBufferThunk::ExecutorCommandBuffer::SwitchCommandBuffer(
+    const CommandBufferCmdSequence& commands,
+    const Thunk::ExecuteParams& params, int64_t cache_size) {
+  // Command buffers with commands that require an update on every call are
+  // always re-recorded, and an empty command buffer has nothing to cache.
+  if (cache_size <= 0 || commands.force_update() ||
+      command_buffer->state() == se::CommandBuffer::State::kCreate) {
+    return false;
+  }
+
+  const BufferAllocations* allocs = params.buffer_allocations;
+
+  // Returns true if `recorded` addresses match addresses in `params` for all
+  // allocations referenced by commands in a cmd sequence.
+  auto is_same_allocs = [&](absl::Span<const se::DeviceMemoryBase> recorded) {
+    return absl::c_all_of(
+        commands.allocs_indices(), [&](BufferAllocation::Index index) {
+          return index < static_cast<int64_t>(recorded.size()) &&
+                 recorded[index].IsSameAs(allocs->GetDeviceAddress(index));
+        });
+  };
+
+  if (is_same_allocs(recorded_allocs)) return false;
+
+  auto cached = absl::c_find_if(
+      cached_command_buffers, [&](const CachedCommandBuffer& cached) {
+        return is_same_allocs(cached.recorded_allocs);
+      });
+
+  // Move the current command buffer to the front of the cache (most recently
+  // used). List iterators are not invalidated by insertions.
+  cached_command_buffers.push_front({std::move(recorded_allocs),
+                                     std::move(command_buffer),
+                                     std::move(checkpoints)});
+
+  if (cached != cached_command_buffers.end()) {
+    recorded_allocs = std::move(cached->recorded_allocs);
+    command_buffer = std::move(cached->command_buffer);
+    checkpoints = std::move(cached->checkpoints);
+    cached_command_buffers.erase(cached);
+    num_executions = 0;
+    return true;
+  }
+
+  if (static_cast<int64_t>(cached_command_buffers.size()) > cache_size) {
+    cached_command_buffers.pop_back();
+  }
+
+  // Create a new empty command buffer that will be recorded for the new
+  // buffer allocation addresses.
+  TF_ASSIGN_OR_RETURN(command_buffer,
+                      params.stream->parent()->CreateCommandBuffer(
+                          se::CommandBuffer::Mode::kPrimary));
+  recorded_allocs.clear();
+  checkpoints.clear();
+  return false;
+}
+
 absl::Status CommandBufferThunk::Prepare(
     const PrepareParams& params, ResourceRequestsInterface& resource_requests) {
   // We might end up with empty command sequence if all of the captured fusions
@@ -186,7 +249,9 @@ absl::Status CommandBufferThunk::Initialize(const InitializeParams& params) {
 
     uint64_t start_micros = tsl::Env::Default()->NowMicros();
 
-    CommandBufferCmd::RecordParams record_params = {cmd_buffer->state};
+    CommandBufferCmd::RecordParams record_params = {
+        cmd_buffer->state, &cmd_buffer->updated_allocs,
+        &cmd_buffer->checkpoints};
     TF_RETURN_IF_ERROR(commands_.Record(execute_params, record_params,
                                         cmd_buffer->command_buffer.get()));
 
@@ -223,6 +288,17 @@ absl::Status CommandBufferThunk::ExecuteOnStream(const ExecuteParams& params) {
 
   absl::MutexLock lock(&cmd_buffer->mutex);
 
+  if (!params.requires_exclusive_lock_on_gpu) {
+    TF_ASSIGN_OR_RETURN(bool switched, cmd_buffer->SwitchCommandBuffer(
+                                           commands_, params,
+                                           command_buffer_cache_size_));
+    if (switched) {
+      VLOG(3) << "Switched to a cached command buffer on device #"
+              << executor->device_ordinal() << "; num_cached_command_buffers="
+              << cmd_buffer->cached_command_buffers.size();
+    }
+  }
+
   if ((!params.requires_exclusive_lock_on_gpu) &&
       cmd_buffer->ShouldUpdateCommandBuffer(commands_, params)) {
     VLOG(3) << "Update command buffer on device #" << executor->device_ordinal()
@@ -240,7 +316,9 @@ absl::Status CommandBufferThunk::ExecuteOnStream(const ExecuteParams& params) {
 
     uint64_t start_micros = tsl::Env::Default()->NowMicros();
 
-    CommandBufferCmd::RecordParams record_params = {cmd_buffer->state};
+    CommandBufferCmd::RecordParams record_params = {
+        cmd_buffer->state, &cmd_buffer->updated_allocs,
+        &cmd_buffer->checkpoints};
     TF_RETURN_IF_ERROR(commands_.Record(params, record_params,
                                         cmd_buffer->command_buffer.get()));
 
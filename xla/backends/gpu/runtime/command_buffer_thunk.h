@@ -17,12 +17,14 @@ limitations under the License.
 #define XLA_BACKENDS_GPU_RUNTIME_COMMAND_BUFFER_THUNK_H_
 
 #include <cstdint>
+#include <list>
 #include <memory>
 #include <optional>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/functional/function_ref.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -40,7 +42,8 @@ class CommandBufferThunk : public Thunk {
  public:
   CommandBufferThunk(CommandBufferCmdSequence commands, ThunkInfo thunk_info,
                      std::unique_ptr<SequentialThunk> thunks = nullptr,
-                     bool enable_command_buffers_during_profiling = false);
+                     bool enable_command_buffers_during_profiling = false,
+                     int64_t command_buffer_cache_size = 0);
 
   const std::unique_ptr<SequentialThunk>& thunks() const { return thunks_; }
 
@@ -70,6 +73,16 @@ class CommandBufferThunk : public Thunk {
                                    const Thunk::ExecuteParams& params)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex);
 
+    // If buffer allocation addresses in `params` changed since the last call
+    // to `ShouldUpdateCommandBuffer`, switches to a cached command buffer
+    // recorded for the new addresses. If there is no such command buffer,
+    // moves the current command buffer to the cache and replaces it with a new
+    // empty command buffer. Returns true if switched to a cached command buffer.
+    absl::StatusOr<bool> SwitchCommandBuffer(
+        const CommandBufferCmdSequence& commands,
+        const Thunk::ExecuteParams& params, int64_t cache_size)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex);
+
     // se::CommandBuffer is not thread safe, and we guard it with a mutex to
     // guarantee that we do not mutate it concurrently.
     absl::Mutex mutex;
@@ -92,8 +105,30 @@ class CommandBufferThunk : public Thunk {
     // change.
     std::vector<se::DeviceMemoryBase> recorded_allocs ABSL_GUARDED_BY(mutex);
 
+    // Indices of allocations with device addresses that changed in the last
+    // call to `ShouldUpdateCommandBuffer`. Commands that do not use any of them
+    // are skipped when updating `command_buffer`.
+    absl::flat_hash_set<BufferAllocation::Index> updated_allocs
+        ABSL_GUARDED_BY(mutex);
+
+    // Checkpoints of commands recorded into `command_buffer`.
+    std::vector<se::CommandBuffer::Checkpoint> checkpoints
+        ABSL_GUARDED_BY(mutex);
+
     // Number of command buffer executions since last update.
     int64_t num_executions ABSL_GUARDED_BY(mutex) = 0;
+
+    // Command buffer recorded for a particular set of buffer allocation
+    // addresses and kept for reuse.
+    struct CachedCommandBuffer {
+      std::vector<se::DeviceMemoryBase> recorded_allocs;
+      std::unique_ptr<se::CommandBuffer> command_buffer;
+      std::vector<se::CommandBuffer::Checkpoint> checkpoints;
+    };
+
+    // Cached command buffers, from the most to the least recently used. All
+    // command buffers share the same commands `state`.
+    std::list<CachedCommandBuffer> cached_command_buffers ABSL_GUARDED_BY(mutex);
   };
 
   // Command buffer thunk owns commands buffers instantiated on all executors.
@@ -136,6 +171,10 @@ class CommandBufferThunk : public Thunk {
   // TODO(b/355487968): Remove this option when validation complete.
   bool enable_command_buffers_during_profiling_;
 
+  // The number of command buffers cached for previously seen buffer allocation
+  // addresses on each executor (see `ExecutorCommandBuffer`).
+  int64_t command_buffer_cache_size_;
+
   // Command buffer thunk state allocated in heap to allow global (per-process)
   // management of instantiated command buffers.
   std::shared_ptr<State> state_;
@@ -186,6 +186,135 @@ TEST(CommandBufferThunkTest, MemcpyCmd) {
   ASSERT_EQ(dst, std::vector<int32_t>(4, 42));
 }
 
+TEST(CommandBufferThunkTest, MemcpyCmdsPartialUpdate) {
+  se::StreamExecutor* executor = GpuExecutor();
+
+  TF_ASSERT_OK_AND_ASSIGN(auto stream, executor->CreateStream());
+
+  int64_t length = 4;
+  int64_t byte_length = sizeof(int32_t) * length;
+
+  // Prepare arguments: a=42, b=0, c=43, d=0
+  se::DeviceMemory<int32_t> a = executor->AllocateArray<int32_t>(length, 0);
+  se::DeviceMemory<int32_t> b = executor->AllocateArray<int32_t>(length, 0);
+  se::DeviceMemory<int32_t> c = executor->AllocateArray<int32_t>(length, 0);
+  se::DeviceMemory<int32_t> d = executor->AllocateArray<int32_t>(length, 0);
+
+  TF_ASSERT_OK(stream->Memset32(&a, 42, byte_length));
+  TF_ASSERT_OK(stream->MemZero(&b, byte_length));
+  TF_ASSERT_OK(stream->Memset32(&c, 43, byte_length));
+  TF_ASSERT_OK(stream->MemZero(&d, byte_length));
+
+  // Prepare buffer allocations for recording command buffer.
+  BufferAllocation alloc_a(/*index=*/0, byte_length, /*color=*/0);
+  BufferAllocation alloc_b(/*index=*/1, byte_length, /*color=*/0);
+  BufferAllocation alloc_c(/*index=*/2, byte_length, /*color=*/0);
+  BufferAllocation alloc_d(/*index=*/3, byte_length, /*color=*/0);
+
+  BufferAllocation::Slice slice_a(&alloc_a, 0, byte_length);
+  BufferAllocation::Slice slice_b(&alloc_b, 0, byte_length);
+  BufferAllocation::Slice slice_c(&alloc_c, 0, byte_length);
+  BufferAllocation::Slice slice_d(&alloc_d, 0, byte_length);
+
+  // Prepare commands sequence for constructing command buffer.
+  CommandBufferCmdSequence commands;
+  commands.Emplace<MemcpyDeviceToDeviceCmd>(s0, slice_b, slice_a, byte_length);
+  commands.Emplace<MemcpyDeviceToDeviceCmd>(s0, slice_d, slice_c, byte_length);
+
+  // Construct a thunk with command sequence.
+  CommandBufferThunk thunk(std::move(commands), Thunk::ThunkInfo());
+
+  se::StreamExecutorMemoryAllocator allocator(executor);
+  ServiceExecutableRunOptions run_options;
+  BufferAllocations allocations({a, b, c, d}, 0, &allocator);
+
+  Thunk::ExecuteParams params = Thunk::ExecuteParams::Create(
+      run_options, allocations, stream.get(), stream.get(), nullptr, nullptr);
+
+  TF_ASSERT_OK(thunk.ExecuteOnStream(params));
+  TF_ASSERT_OK(stream->BlockHostUntilDone());
+
+  // Update only the destination of the second copy. The first command is
+  // skipped during the update and must keep copying `a` into `b`.
+  se::DeviceMemory<int32_t> e = executor->AllocateArray<int32_t>(length, 0);
+  TF_ASSERT_OK(stream->MemZero(&b, byte_length));
+  TF_ASSERT_OK(stream->MemZero(&e, byte_length));
+
+  allocations = BufferAllocations({a, b, c, e}, 0, &allocator);
+
+  TF_ASSERT_OK(thunk.ExecuteOnStream(params));
+  TF_ASSERT_OK(stream->BlockHostUntilDone());
+
+  std::vector<int32_t> dst(4, 0);
+  TF_ASSERT_OK(stream->Memcpy(dst.data(), b, byte_length));
+  ASSERT_EQ(dst, std::vector<int32_t>(4, 42));
+
+  std::fill(dst.begin(), dst.end(), 0);
+  TF_ASSERT_OK(stream->Memcpy(dst.data(), e, byte_length));
+  ASSERT_EQ(dst, std::vector<int32_t>(4, 43));
+}
+
+TEST(CommandBufferThunkTest, MemcpyCmdWithCommandBufferCache) {
+  se::StreamExecutor* executor = GpuExecutor();
+
+  TF_ASSERT_OK_AND_ASSIGN(auto stream, executor->CreateStream());
+
+  int64_t length = 4;
+  int64_t byte_length = sizeof(int32_t) * length;
+
+  // Prepare arguments: a=42, b=0, c=43, d=0
+  se::DeviceMemory<int32_t> a = executor->AllocateArray<int32_t>(length, 0);
+  se::DeviceMemory<int32_t> b = executor->AllocateArray<int32_t>(length, 0);
+  se::DeviceMemory<int32_t> c = executor->AllocateArray<int32_t>(length, 0);
+  se::DeviceMemory<int32_t> d = executor->AllocateArray<int32_t>(length, 0);
+
+  TF_ASSERT_OK(stream->Memset32(&a, 42, byte_length));
+  TF_ASSERT_OK(stream->Memset32(&c, 43, byte_length));
+
+  // Prepare buffer allocations for recording command buffer.
+  BufferAllocation alloc_src(/*index=*/0, byte_length, /*color=*/0);
+  BufferAllocation alloc_dst(/*index=*/1, byte_length, /*color=*/0);
+
+  BufferAllocation::Slice slice_src(&alloc_src, 0, byte_length);
+  BufferAllocation::Slice slice_dst(&alloc_dst, 0, byte_length);
+
+  // Prepare commands sequence for constructing command buffer.
+  CommandBufferCmdSequence commands;
+  commands.Emplace<MemcpyDeviceToDeviceCmd>(s0, slice_dst, slice_src,
+                                            byte_length);
+
+  // Construct a thunk with command sequence and a command buffer cache.
+  CommandBufferThunk thunk(std::move(commands), Thunk::ThunkInfo(),
+                           /*thunks=*/nullptr,
+                           /*enable_command_buffers_during_profiling=*/false,
+                           /*command_buffer_cache_size=*/2);
+
+  se::StreamExecutorMemoryAllocator allocator(executor);
+  ServiceExecutableRunOptions run_options;
+
+  // Alternate between two buffer configurations, and check that the command
+  // buffer copies from the right source into the right destination.
+  for (int i = 0; i < 4; ++i) {
+    bool first = i % 2 == 0;
+    se::DeviceMemory<int32_t> dst_mem = first ? b : d;
+
+    BufferAllocations allocations =
+        first ? BufferAllocations({a, b}, 0, &allocator)
+              : BufferAllocations({c, d}, 0, &allocator);
+    Thunk::ExecuteParams params = Thunk::ExecuteParams::Create(
+        run_options, allocations, stream.get(), stream.get(), nullptr,
+        nullptr);
+
+    TF_ASSERT_OK(stream->MemZero(&dst_mem, byte_length));
+    TF_ASSERT_OK(thunk.ExecuteOnStream(params));
+    TF_ASSERT_OK(stream->BlockHostUntilDone());
+
+    std::vector<int32_t> dst(4, 0);
+    TF_ASSERT_OK(stream->Memcpy(dst.data(), dst_mem, byte_length));
+    ASSERT_EQ(dst, std::vector<int32_t>(4, first ? 42 : 43));
+  }
+}
+
 TEST(CommandBufferThunkTest, MemzeroCmd) {
   se::StreamExecutor* executor = GpuExecutor();
 
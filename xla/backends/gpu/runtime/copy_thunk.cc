@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "absl/log/log.h"
@@ -56,6 +57,77 @@ absl::Status DeviceToDeviceCopyThunk::ExecuteOnStream(
   return params.stream->Memcpy(&destination_data, source_data, mem_size_);
 }
 
+namespace {
+
+// Returns the slice that covers `first` immediately followed by `second`, or
+// nullopt if they are not contiguous slices of the same allocation.
+std::optional<BufferAllocation::Slice> ConcatSlices(
+    const BufferAllocation::Slice& first,
+    const BufferAllocation::Slice& second) {
+  if (first.allocation() != second.allocation() ||
+      first.offset() + first.size() != second.offset()) {
+    return std::nullopt;
+  }
+  return BufferAllocation::Slice(first.allocation(), first.offset(),
+                                 first.size() + second.size());
+}
+
+// Returns a copy thunk that is equivalent to running `first` and then
+// `second`, or nullptr if they can't be merged into a single memcpy.
+std::unique_ptr<DeviceToDeviceCopyThunk> MergeCopies(
+    const DeviceToDeviceCopyThunk& first,
+    const DeviceToDeviceCopyThunk& second) {
+  if (first.execution_stream_id() != second.execution_stream_id() ||
+      first.size_bytes() != first.source().size() ||
+      second.size_bytes() != second.source().size()) {
+    return nullptr;
+  }
+
+  std::optional<BufferAllocation::Slice> source =
+      ConcatSlices(first.source(), second.source());
+  std::optional<BufferAllocation::Slice> destination =
+      ConcatSlices(first.destination(), second.destination());
+  if (!source || !destination || source->OverlapsWith(*destination)) {
+    return nullptr;
+  }
+
+  Thunk::ThunkInfo thunk_info;
+  thunk_info.profile_annotation = first.profile_annotation();
+  thunk_info.execution_stream_id = first.execution_stream_id();
+  return std::make_unique<DeviceToDeviceCopyThunk>(
+      std::move(thunk_info), *source, *destination,
+      first.size_bytes() + second.size_bytes());
+}
+
+}  // namespace
+
+int64_t MergeAdjacentDeviceToDeviceCopyThunks(ThunkSequence& thunks) {
+  int64_t num_removed = 0;
+
+  ThunkSequence merged;
+  merged.reserve(thunks.size());
+
+  for (std::unique_ptr<Thunk>& thunk : thunks) {
+    auto* copy = dynamic_cast<DeviceToDeviceCopyThunk*>(thunk.get());
+    auto* prev = merged.empty() ? nullptr
+                                : dynamic_cast<DeviceToDeviceCopyThunk*>(
+                                      merged.back().get());
+    if (copy != nullptr && prev != nullptr) {
+      if (auto merged_copy = MergeCopies(*prev, *copy)) {
+        VLOG(3) << "Merge copy " << copy->profile_annotation() << " into "
+                << prev->profile_annotation();
+        merged.back() = std::move(merged_copy);
+        ++num_removed;
+        continue;
+      }
+    }
+    merged.push_back(std::move(thunk));
+  }
+
+  thunks = std::move(merged);
+  return num_removed;
+}
+
 //===----------------------------------------------------------------------===//
 // CopyThunk
 //===----------------------------------------------------------------------===//
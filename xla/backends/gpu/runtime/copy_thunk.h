@@ -63,6 +63,15 @@ class DeviceToDeviceCopyThunk : public Thunk {
   const uint64_t mem_size_;
 };
 
+// Merges runs of adjacent top-level DeviceToDeviceCopyThunks in `thunks` that
+// copy between contiguous slices of the same source and destination
+// allocations into a single copy, so that many small copies (e.g. from tuple
+// shuffling or parameter updates) pay for one memcpy launch, or become one
+// memcpy node in a command buffer. Copies are merged only if they run on the
+// same execution stream and the merged source and destination ranges don't
+// overlap. Returns the number of removed thunks.
+int64_t MergeAdjacentDeviceToDeviceCopyThunks(ThunkSequence& thunks);
+
 //===----------------------------------------------------------------------===//
 // CopyThunk
 //===----------------------------------------------------------------------===//
@@ -0,0 +1,86 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "xla/backends/gpu/runtime/copy_thunk.h"
+
+#include <cstdint>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "xla/backends/gpu/runtime/thunk.h"
+#include "xla/service/buffer_assignment.h"
+
+namespace xla::gpu {
+namespace {
+
+std::unique_ptr<Thunk> Copy(const BufferAllocation& src, int64_t src_offset,
+                            const BufferAllocation& dst, int64_t dst_offset,
+                            int64_t size, int64_t stream_id = 0) {
+  Thunk::ThunkInfo thunk_info;
+  thunk_info.execution_stream_id = ExecutionStreamId(stream_id);
+  return std::make_unique<DeviceToDeviceCopyThunk>(
+      thunk_info, BufferAllocation::Slice(&src, src_offset, size),
+      BufferAllocation::Slice(&dst, dst_offset, size), size);
+}
+
+const DeviceToDeviceCopyThunk& AsCopy(const std::unique_ptr<Thunk>& thunk) {
+  return *static_cast<const DeviceToDeviceCopyThunk*>(thunk.get());
+}
+
+TEST(CopyThunkTest, MergesContiguousCopies) {
+  BufferAllocation src(/*index=*/0, /*size=*/1024, /*color=*/0);
+  BufferAllocation dst(/*index=*/1, /*size=*/1024, /*color=*/0);
+
+  ThunkSequence thunks;
+  thunks.push_back(Copy(src, 0, dst, 64, 16));
+  thunks.push_back(Copy(src, 16, dst, 80, 32));
+  thunks.push_back(Copy(src, 48, dst, 112, 16));
+
+  EXPECT_EQ(MergeAdjacentDeviceToDeviceCopyThunks(thunks), 2);
+  ASSERT_EQ(thunks.size(), 1);
+  EXPECT_EQ(AsCopy(thunks[0]).source(), BufferAllocation::Slice(&src, 0, 64));
+  EXPECT_EQ(AsCopy(thunks[0]).destination(),
+            BufferAllocation::Slice(&dst, 64, 64));
+  EXPECT_EQ(AsCopy(thunks[0]).size_bytes(), 64);
+}
+
+TEST(CopyThunkTest, KeepsNonContiguousCopies) {
+  BufferAllocation src(/*index=*/0, /*size=*/1024, /*color=*/0);
+  BufferAllocation dst(/*index=*/1, /*size=*/1024, /*color=*/0);
+
+  ThunkSequence thunks;
+  thunks.push_back(Copy(src, 0, dst, 0, 16));
+  // Source is contiguous, but destination is not.
+  thunks.push_back(Copy(src, 16, dst, 32, 16));
+  // Contiguous, but runs on a different execution stream.
+  thunks.push_back(Copy(src, 32, dst, 48, 16, /*stream_id=*/1));
+
+  EXPECT_EQ(MergeAdjacentDeviceToDeviceCopyThunks(thunks), 0);
+  EXPECT_EQ(thunks.size(), 3);
+}
+
+TEST(CopyThunkTest, KeepsOverlappingCopies) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/1024, /*color=*/0);
+
+  // The second copy reads bytes written by the first one.
+  ThunkSequence thunks;
+  thunks.push_back(Copy(alloc, 0, alloc, 16, 16));
+  thunks.push_back(Copy(alloc, 16, alloc, 32, 16));
+
+  EXPECT_EQ(MergeAdjacentDeviceToDeviceCopyThunks(thunks), 0);
+  EXPECT_EQ(thunks.size(), 2);
+}
+
+}  // namespace
+}  // namespace xla::gpu
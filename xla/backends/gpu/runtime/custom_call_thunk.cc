@@ -22,10 +22,12 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
+#include "absl/types/span.h"
 #include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/executable_run_options.h"
 #include "xla/ffi/api/c_api.h"
@@ -41,6 +43,7 @@ limitations under the License.
 #include "xla/stream_executor/device_memory_allocator.h"
 #include "xla/stream_executor/stream.h"
 #include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
 
 namespace xla {
@@ -59,6 +62,40 @@ absl::StatusOr<std::unique_ptr<CustomCallThunk>> CustomCallThunk::Create(
       std::move(operands), std::move(results), opaque));
 }
 
+// Builds a call frame prototype for typed-FFI custom calls with placeholder
+// device memory addresses. This is called once when creating the CustomCall
+// thunk, and at run time we only patch device memory addresses.
+static CallFrame BuildCallFramePrototype(
+    absl::Span<const std::optional<CustomCallThunk::Slice>> operands,
+    absl::Span<const std::optional<CustomCallThunk::Slice>> results,
+    const CustomCallThunk::AttributesMap& attributes) {
+  CallFrameBuilder builder(operands.size(), results.size());
+
+  for (const std::optional<CustomCallThunk::Slice>& operand : operands) {
+    if (!operand.has_value()) {
+      builder.AddTokenArg();
+      continue;
+    }
+    builder.AddBufferArg(se::DeviceMemoryBase{}, operand->shape.element_type(),
+                         operand->shape.dimensions());
+  }
+
+  for (const std::optional<CustomCallThunk::Slice>& result : results) {
+    if (!result.has_value()) {
+      builder.AddTokenRet();
+      continue;
+    }
+    builder.AddBufferRet(se::DeviceMemoryBase{}, result->shape.element_type(),
+                         result->shape.dimensions());
+  }
+
+  CallFrameBuilder::AttributesBuilder attrs;
+  attrs.Append(attributes);
+
+  builder.AddAttributes(attrs.Build());
+  return builder.Build();
+}
+
 absl::StatusOr<std::unique_ptr<CustomCallThunk>> CustomCallThunk::Create(
     ThunkInfo thunk_info, std::string target_name,
     XLA_FFI_Handler_Bundle bundle, std::vector<std::optional<Slice>> operands,
@@ -84,10 +121,12 @@ absl::StatusOr<std::unique_ptr<CustomCallThunk>> CustomCallThunk::Create(
                             XLA_FFI_ExecutionStage_INSTANTIATE));
   }
 
+  CallFrame call_frame = BuildCallFramePrototype(operands, results, attributes);
+
   return absl::WrapUnique(new CustomCallThunk(
       thunk_info, std::move(target_name), bundle, std::move(operands),
-      std::move(results), std::move(attributes), std::move(execution_state),
-      called_computation));
+      std::move(results), std::move(attributes), std::move(call_frame),
+      std::move(execution_state), called_computation));
 }
 
 CustomCallThunk::CustomCallThunk(ThunkInfo thunk_info, std::string target_name,
@@ -106,7 +145,7 @@ CustomCallThunk::CustomCallThunk(
     ThunkInfo thunk_info, std::string target_name,
     XLA_FFI_Handler_Bundle bundle, std::vector<std::optional<Slice>> operands,
     std::vector<std::optional<Slice>> results, AttributesMap attributes,
-    std::unique_ptr<ffi::ExecutionState> execution_state,
+    CallFrame call_frame, std::unique_ptr<ffi::ExecutionState> execution_state,
     const HloComputation* called_computation)
     : Thunk(Thunk::kCustomCall, thunk_info),
       target_name_(std::move(target_name)),
@@ -114,6 +153,7 @@ CustomCallThunk::CustomCallThunk(
       results_(std::move(results)),
       bundle_(bundle),
       attributes_(std::move(attributes)),
+      call_frame_(std::move(call_frame)),
       execution_state_(std::move(execution_state)),
       called_computation_(called_computation) {}
 
@@ -159,10 +199,6 @@ absl::Status CustomCallThunk::ExecuteFfiHandler(
     return absl::InternalError("buffer allocations and stream are required");
   }
 
-  // TODO(ezhulenev): This is not the most optimal approach, as we'll be doing
-  // a lot of extra allocation on every call. We have to keep attributes
-  // separate from arguments, as they do not change after thunk is constructed.
-  CallFrameBuilder builder(operands_.size(), results_.size());
   auto device_address =
       [buffer_allocations](
           BufferAllocation::Slice slice) -> se::DeviceMemoryBase {
@@ -170,39 +206,40 @@ absl::Status CustomCallThunk::ExecuteFfiHandler(
                               : se::DeviceMemoryBase{};
   };
 
+  absl::InlinedVector<se::DeviceMemoryBase, 8> arguments;
+  arguments.reserve(operands_.size());
   for (auto& operand : operands_) {
     if (!operand.has_value()) {
-      builder.AddTokenArg();
+      arguments.push_back(se::DeviceMemoryBase{});
       continue;
     }
 
     if (!operand->slice.allocation())
       return Internal("custom call argument missing buffer allocation");
 
-    builder.AddBufferArg(device_address(operand->slice),
-                         operand->shape.element_type(),
-                         operand->shape.dimensions());
+    arguments.push_back(device_address(operand->slice));
   }
 
+  absl::InlinedVector<se::DeviceMemoryBase, 4> results;
+  results.reserve(results_.size());
   for (auto& result : results_) {
     if (!result.has_value()) {
-      builder.AddTokenRet();
+      results.push_back(se::DeviceMemoryBase{});
       continue;
     }
 
     if (!result->slice.allocation())
       return Internal("custom call result missing buffer allocation");
 
-    builder.AddBufferRet(device_address(result->slice),
-                         result->shape.element_type(),
-                         result->shape.dimensions());
+    results.push_back(device_address(result->slice));
   }
 
-  CallFrameBuilder::AttributesBuilder attrs;
-  attrs.Append(attributes_);
-
-  builder.AddAttributes(attrs.Build());
-  CallFrame call_frame = builder.Build();
+  // Attributes, argument types and dimensions are known at thunk construction
+  // time, and we only patch device memory addresses in a copy of the call
+  // frame prototype. We don't update the prototype in place, as the same thunk
+  // can be executed concurrently on multiple streams.
+  TF_ASSIGN_OR_RETURN(CallFrame call_frame,
+                      call_frame_->CopyWithBuffers(arguments, results));
 
   int32_t device_ordinal = -1;
   se::DeviceMemoryAllocator* allocator = nullptr;
@@ -109,7 +109,7 @@ class CustomCallThunk : public Thunk {
                   XLA_FFI_Handler_Bundle bundle,
                   std::vector<std::optional<Slice>> operands,
                   std::vector<std::optional<Slice>> results,
-                  AttributesMap attributes,
+                  AttributesMap attributes, ffi::CallFrame call_frame,
                   std::unique_ptr<ffi::ExecutionState> execution_state,
                   const HloComputation* called_computation);
 
@@ -137,6 +137,11 @@ class CustomCallThunk : public Thunk {
   std::optional<XLA_FFI_Handler_Bundle> bundle_;
   AttributesMap attributes_;
 
+  // Reference call frame pre-initialized at construction time from attributes
+  // and argument and result shapes. Device memory addresses are patched in on
+  // every execution.
+  std::optional<ffi::CallFrame> call_frame_;
+
   // Execution state bound to the FFI handler. Optional.
   std::unique_ptr<ffi::ExecutionState> execution_state_;
 
@@ -180,39 +180,23 @@ absl::Status DynamicSliceThunk::ExecuteOnStream(const ExecuteParams& params) {
   };
 
   VLOG(2) << "Execute address computation thunk: slices=" << slices_.size();
-  for (auto [argument_idx, slice] : llvm::enumerate(slices_)) {
-    // Skip arguments that do not have buffer slices (tokens).
-    if (!slice.embedded_thunk_argument.has_value()) {
-      continue;
-    }
 
-    // `argument_buffer` will contain the original offset for slice
-    // `argument_slice` within `orig_allocations`
-    se::DeviceMemoryBase argument_buffer =
-        orig_allocations.GetDeviceAddress(*slice.embedded_thunk_argument);
+  // Number of issued d2h transfers to copy offset values from device to host.
+  int64_t num_transfers = 0;
 
-    // If argument is not sliced, just use the original buffer.
-    if (!slice.offsets.has_value()) {
-      slice_buffers[argument_idx] = argument_buffer;
+  // Collect offset values for all sliced arguments first, so that we wait for
+  // the completion of all device to host transfers only once.
+  for (auto [argument_idx, slice] : llvm::enumerate(slices_)) {
+    // Skip arguments that do not have buffer slices (tokens) or that are not
+    // sliced.
+    if (!slice.embedded_thunk_argument.has_value() ||
+        !slice.offsets.has_value()) {
       continue;
     }
 
-    const Shape& src_shape = *slice.orig_shape;
-    const Shape& dst_shape = *slice.sliced_shape;
-
-    absl::InlinedVector<int64_t, 4> slice_starts;
-    slice_starts.reserve(dst_shape.dimensions_size());
-
-    // Number of issues d2h transfers to copy offset values from device to
-    // host.
-    int64_t num_transfers = 0;
-
     // Get offset for `argument_idx`-th argument, which has
     // `dst_shape.dimensions_size()` components.
-    for (auto [offset_idx, values] : llvm::enumerate(llvm::zip(
-             *slice.offsets, src_shape.dimensions(), dst_shape.dimensions()))) {
-      auto [offset, src_dim, dst_dim] = values;
-
+    for (auto [offset_idx, offset] : llvm::enumerate(*slice.offsets)) {
       if (int64_t* const_offset = std::get_if<int64_t>(&offset)) {
         // Forward slice offsets that are known constant values
         VLOG(2) << "  - arg " << argument_idx << "[" << offset_idx
@@ -250,13 +234,37 @@ absl::Status DynamicSliceThunk::ExecuteOnStream(const ExecuteParams& params) {
         ++num_transfers;
       }
     }
+  }
 
-    // Wait for the completion of all transfers.
-    if (num_transfers > 0) {
-      VLOG(2) << "Wait for completion of " << num_transfers << " transfer";
-      TF_RETURN_IF_ERROR(stream.BlockHostUntilDone());
+  // Wait for the completion of all transfers.
+  if (num_transfers > 0) {
+    VLOG(2) << "Wait for completion of " << num_transfers << " transfer";
+    TF_RETURN_IF_ERROR(stream.BlockHostUntilDone());
+  }
+
+  for (auto [argument_idx, slice] : llvm::enumerate(slices_)) {
+    // Skip arguments that do not have buffer slices (tokens).
+    if (!slice.embedded_thunk_argument.has_value()) {
+      continue;
+    }
+
+    // `argument_buffer` will contain the original offset for slice
+    // `argument_slice` within `orig_allocations`
+    se::DeviceMemoryBase argument_buffer =
+        orig_allocations.GetDeviceAddress(*slice.embedded_thunk_argument);
+
+    // If argument is not sliced, just use the original buffer.
+    if (!slice.offsets.has_value()) {
+      slice_buffers[argument_idx] = argument_buffer;
+      continue;
     }
 
+    const Shape& src_shape = *slice.orig_shape;
+    const Shape& dst_shape = *slice.sliced_shape;
+
+    absl::InlinedVector<int64_t, 4> slice_starts;
+    slice_starts.reserve(dst_shape.dimensions_size());
+
     // Clamp start indices:
     // start_indices[i] = min(max(start_indices[i], 0),
     //                        operand.dimension_size[i] - size_indices[i])
@@ -15,16 +15,20 @@ limitations under the License.
 
 #include "xla/backends/gpu/runtime/fft_thunk.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/backends/gpu/runtime/thunk.h"
+#include "xla/service/gpu/buffer_allocations.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
@@ -96,8 +100,90 @@ absl::StatusOr<stream_executor::fft::FftSupport*> GetFft(se::Stream* stream) {
   }
   return fft;
 }
+
+FftPlanKey MakeFftPlanKey(int device_ordinal, se::fft::Type fft_type,
+                          absl::Span<const int64_t> fft_length,
+                          const Shape& input_shape, const Shape& output_shape) {
+  return FftPlanKey{
+      device_ordinal, fft_type,
+      std::vector<int64_t>(fft_length.begin(), fft_length.end()),
+      std::vector<int64_t>(input_shape.dimensions().begin(),
+                           input_shape.dimensions().end()),
+      std::vector<int64_t>(output_shape.dimensions().begin(),
+                           output_shape.dimensions().end())};
+}
+
+// Creates a cuFFT plan for the given FFT and stores it in `fft_plan`.
+absl::Status CreateFftPlan(FftPlan& fft_plan, se::fft::FftSupport* fft,
+                           se::Stream* stream, const Shape& input_shape,
+                           const Shape& output_shape, se::fft::Type fft_type,
+                           absl::Span<const int64_t> fft_len,
+                           se::ScratchAllocator* scratch_allocator)
+    ABSL_EXCLUSIVE_LOCKS_REQUIRED(fft_plan.mu) {
+  const int64_t fft_rank = fft_len.size();
+  CHECK_LE(fft_rank, 3);
+  int batch_size = 1;
+  for (int i = 0; i < input_shape.dimensions_size() - fft_rank; ++i) {
+    batch_size *= input_shape.dimensions(i);
+  }
+  uint64_t fft_length[3];
+  uint64_t input_embed[3];
+  const uint64_t input_stride = 1;
+  uint64_t input_distance = 1;
+  uint64_t output_embed[3];
+  const uint64_t output_stride = 1;
+  uint64_t output_distance = 1;
+
+  for (int i = 0; i < fft_rank; ++i) {
+    auto dim_offset = input_shape.dimensions_size() - fft_rank + i;
+    fft_length[i] = static_cast<uint64_t>(fft_len[i]);
+    input_embed[i] = input_shape.dimensions(dim_offset);
+    input_distance *= input_shape.dimensions(dim_offset);
+    output_embed[i] = output_shape.dimensions(dim_offset);
+    output_distance *= output_shape.dimensions(dim_offset);
+  }
+
+  constexpr bool kInPlaceFft = false;
+  fft_plan.plan = fft->CreateBatchedPlanWithScratchAllocator(
+      stream, fft_rank, fft_length, input_embed, input_stride, input_distance,
+      output_embed, output_stride, output_distance, fft_type, kInPlaceFft,
+      batch_size, scratch_allocator);
+  TF_RET_CHECK(fft_plan.plan != nullptr)
+      << "Failed to create cuFFT batched plan with scratch allocator";
+  fft_plan.scale_factor = output_distance;
+  return absl::OkStatus();
+}
 }  // namespace
 
+FftPlanCache& FftPlanCache::Global() {
+  static auto* cache = new FftPlanCache();
+  return *cache;
+}
+
+std::shared_ptr<FftPlan> FftPlanCache::GetOrCreate(const FftPlanKey& key) {
+  absl::MutexLock lock(&mu_);
+  auto it = fft_plans_.find(key);
+  if (it != fft_plans_.end()) {
+    lru_list_.splice(lru_list_.begin(), lru_list_, it->second.lru_position);
+    return it->second.plan;
+  }
+
+  if (fft_plans_.size() >= capacity_ && !lru_list_.empty()) {
+    fft_plans_.erase(lru_list_.back());
+    lru_list_.pop_back();
+  }
+
+  lru_list_.push_front(key);
+  auto plan = std::make_shared<FftPlan>();
+  fft_plans_.emplace(key, Entry{plan, lru_list_.begin()});
+  return plan;
+}
+
+size_t FftPlanCache::size() const {
+  absl::MutexLock lock(&mu_);
+  return fft_plans_.size();
+}
+
 FftThunk::FftThunk(ThunkInfo thunk_info, FftType fft_type,
                    absl::Span<const int64_t> fft_length,
                    const BufferAllocation::Slice& input_buffer,
@@ -113,6 +199,30 @@ FftThunk::FftThunk(ThunkInfo thunk_info, FftType fft_type,
       input_shape_(input_shape),
       output_shape_(output_shape) {}
 
+absl::Status FftThunk::Initialize(const InitializeParams& params) {
+  if (params.stream == nullptr || params.buffer_allocations == nullptr) {
+    return absl::OkStatus();
+  }
+
+  const BufferAllocations& buffer_allocations = *params.buffer_allocations;
+  const int device_ordinal = buffer_allocations.device_ordinal();
+  std::shared_ptr<FftPlan> fft_plan =
+      FftPlanCache::Global().GetOrCreate(MakeFftPlanKey(
+          device_ordinal, fft_type_, fft_length_, input_shape_, output_shape_));
+
+  absl::MutexLock lock(&fft_plan->mu);
+  if (fft_plan->plan != nullptr) return absl::OkStatus();
+
+  VLOG(3) << "Create FFT plan at initialization: " << FftTypeToString(fft_type_)
+          << " " << ShapeUtil::HumanStringWithLayout(input_shape_);
+  se::OwningScratchAllocator<2> scratch_allocator(
+      device_ordinal, buffer_allocations.memory_allocator());
+  TF_ASSIGN_OR_RETURN(auto fft, GetFft(params.stream));
+  return CreateFftPlan(*fft_plan, fft, params.stream, input_shape_,
+                       output_shape_, fft_type_, fft_length_,
+                       &scratch_allocator);
+}
+
 absl::Status FftThunk::ExecuteOnStream(const ExecuteParams& params) {
   auto& buffer_allocations = *params.buffer_allocations;
 
@@ -120,7 +230,8 @@ absl::Status FftThunk::ExecuteOnStream(const ExecuteParams& params) {
       buffer_allocations.GetDeviceAddress(input_buffer_), input_shape_,
       buffer_allocations.GetDeviceAddress(output_buffer_), output_shape_,
       fft_type_, fft_length_, buffer_allocations.device_ordinal(),
-      &fft_plan_cache_, params.stream, buffer_allocations.memory_allocator());
+      &FftPlanCache::Global(), params.stream,
+      buffer_allocations.memory_allocator());
 }
 
 absl::Status RunFft(se::DeviceMemoryBase input, const Shape& input_shape,
@@ -136,8 +247,10 @@ absl::Status RunFft(se::DeviceMemoryBase input, const Shape& input_shape,
   se::OwningScratchAllocator<2> scratch_allocator(device_ordinal,
                                                   memory_allocator);
 
-  // Get the Fft plan for the given device ordinal.
-  FftPlan* fft_plan_ptr = fft_plan_cache->GetOrCreate(device_ordinal);
+  // Get the Fft plan for the given device and shapes.
+  std::shared_ptr<FftPlan> fft_plan_ptr =
+      fft_plan_cache->GetOrCreate(MakeFftPlanKey(
+          device_ordinal, fft_type, fft_len, input_shape, output_shape));
 
   // CuFFT thread-safety requires that separate host threads not share plans;
   // protect each plan with a mutex.
@@ -145,37 +258,9 @@ absl::Status RunFft(se::DeviceMemoryBase input, const Shape& input_shape,
   std::unique_ptr<se::fft::Plan>& fft_plan = fft_plan_ptr->plan;
   TF_ASSIGN_OR_RETURN(auto fft, GetFft(stream));
   if (fft_plan == nullptr) {
-    const int64_t fft_rank = fft_len.size();
-    CHECK_LE(fft_rank, 3);
-    int batch_size = 1;
-    for (int i = 0; i < input_shape.dimensions_size() - fft_rank; ++i) {
-      batch_size *= input_shape.dimensions(i);
-    }
-    uint64_t fft_length[3];
-    uint64_t input_embed[3];
-    const uint64_t input_stride = 1;
-    uint64_t input_distance = 1;
-    uint64_t output_embed[3];
-    const uint64_t output_stride = 1;
-    uint64_t output_distance = 1;
-
-    for (int i = 0; i < fft_rank; ++i) {
-      auto dim_offset = input_shape.dimensions_size() - fft_rank + i;
-      fft_length[i] = static_cast<uint64_t>(fft_len[i]);
-      input_embed[i] = input_shape.dimensions(dim_offset);
-      input_distance *= input_shape.dimensions(dim_offset);
-      output_embed[i] = output_shape.dimensions(dim_offset);
-      output_distance *= output_shape.dimensions(dim_offset);
-    }
-
-    constexpr bool kInPlaceFft = false;
-    fft_plan = fft->CreateBatchedPlanWithScratchAllocator(
-        stream, fft_rank, fft_length, input_embed, input_stride, input_distance,
-        output_embed, output_stride, output_distance, fft_type, kInPlaceFft,
-        batch_size, &scratch_allocator);
-    TF_RET_CHECK(fft_plan != nullptr)
-        << "Failed to create cuFFT batched plan with scratch allocator";
-    fft_plan_ptr->scale_factor = output_distance;
+    TF_RETURN_IF_ERROR(CreateFftPlan(*fft_plan_ptr, fft, stream, input_shape,
+                                     output_shape, fft_type, fft_len,
+                                     &scratch_allocator));
   } else {
     fft->UpdatePlanWithScratchAllocator(stream, fft_plan.get(),
                                         &scratch_allocator);
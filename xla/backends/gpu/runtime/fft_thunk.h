@@ -16,8 +16,11 @@ limitations under the License.
 #ifndef XLA_BACKENDS_GPU_RUNTIME_FFT_THUNK_H_
 #define XLA_BACKENDS_GPU_RUNTIME_FFT_THUNK_H_
 
+#include <cstddef>
 #include <cstdint>
+#include <list>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
@@ -45,25 +48,70 @@ struct FftPlan {
   uint64_t scale_factor ABSL_GUARDED_BY(mu);
 };
 
+// FFT plans don't depend on the stream (it is set for every launch) or on the
+// work area (it is allocated from the scratch allocator for every launch), so
+// all FFTs with the same device, type and shapes can share a plan.
+struct FftPlanKey {
+  int device_ordinal;
+  se::fft::Type fft_type;
+  std::vector<int64_t> fft_length;
+  std::vector<int64_t> input_dimensions;
+  std::vector<int64_t> output_dimensions;
+
+  template <typename H>
+  friend H AbslHashValue(H h, const FftPlanKey& key) {
+    return H::combine(std::move(h), key.device_ordinal, key.fft_type,
+                      key.fft_length, key.input_dimensions,
+                      key.output_dimensions);
+  }
+
+  bool operator==(const FftPlanKey& other) const {
+    return device_ordinal == other.device_ordinal &&
+           fft_type == other.fft_type && fft_length == other.fft_length &&
+           input_dimensions == other.input_dimensions &&
+           output_dimensions == other.output_dimensions;
+  }
+};
+
+// An LRU cache of FFT plans shared by all FFT thunks in the process, so that
+// executables with the same FFTs don't create (slow to build) cuFFT plans
+// again. Evicted plans stay alive while they are in use.
 class FftPlanCache {
  public:
-  // Returnes Fft plan cached for the given device ordinal or creates a new one.
-  FftPlan* GetOrCreate(int device_ordinal) {
-    absl::MutexLock lock(&mu_);
-    std::unique_ptr<FftPlan>& plan = fft_plans_[device_ordinal];
-    if (!plan) plan = std::make_unique<FftPlan>();
-    return plan.get();
-  }
+  static constexpr size_t kDefaultCapacity = 128;
+
+  explicit FftPlanCache(size_t capacity = kDefaultCapacity)
+      : capacity_(capacity) {}
+
+  // Returns the process-wide FFT plan cache.
+  static FftPlanCache& Global();
+
+  // Returns Fft plan cached for the given key or creates a new (empty) one.
+  std::shared_ptr<FftPlan> GetOrCreate(const FftPlanKey& key);
+
+  size_t size() const;
 
  private:
-  absl::Mutex mu_;
-  absl::flat_hash_map<int, std::unique_ptr<FftPlan>> fft_plans_
-      ABSL_GUARDED_BY(mu_);
+  using LruList = std::list<FftPlanKey>;
+
+  struct Entry {
+    std::shared_ptr<FftPlan> plan;
+    LruList::iterator lru_position;
+  };
+
+  const size_t capacity_;
+
+  mutable absl::Mutex mu_;
+  LruList lru_list_ ABSL_GUARDED_BY(mu_);
+  absl::flat_hash_map<FftPlanKey, Entry> fft_plans_ ABSL_GUARDED_BY(mu_);
 };
 
 // This class stores everything that StreamExecutor needs to launch an FFT.
 // It is generated by IrEmitter.
 //
+// FFT plans are taken from the process-wide FftPlanCache and created at
+// initialization time, so that the first execution doesn't pay for it.
+//
 // This is thread-compatible.
 class FftThunk : public Thunk {
  public:
@@ -75,8 +123,11 @@ class FftThunk : public Thunk {
            const BufferAllocation::Slice& output_buffer,
            const Shape& input_shape, const Shape& output_shape);
 
-  FftThunk(const FftThunk&) = delete;             // Cannot share fft_plan_
-  FftThunk& operator=(const FftThunk&) = delete;  // Cannot share fft_plan_
+  FftThunk(const FftThunk&) = delete;
+  FftThunk& operator=(const FftThunk&) = delete;
+
+  // Creates the FFT plan for the device if it is not in the plan cache yet.
+  absl::Status Initialize(const InitializeParams& params) override;
 
   // Does the FFT for the thunk on "stream".
   absl::Status ExecuteOnStream(const ExecuteParams& params) override;
@@ -85,8 +136,6 @@ class FftThunk : public Thunk {
   const se::fft::Type fft_type_;
   const std::vector<int64_t> fft_length_;
 
-  FftPlanCache fft_plan_cache_;
-
   const BufferAllocation::Slice input_buffer_;
   const BufferAllocation::Slice output_buffer_;
 
@@ -0,0 +1,59 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/gpu/runtime/fft_thunk.h"
+
+#include <cstdint>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "xla/stream_executor/fft.h"
+
+namespace xla::gpu {
+namespace {
+
+FftPlanKey MakeKey(int device_ordinal, int64_t fft_length) {
+  return FftPlanKey{device_ordinal,
+                    se::fft::Type::kC2CForward,
+                    {fft_length},
+                    {8, fft_length},
+                    {8, fft_length}};
+}
+
+TEST(FftPlanCacheTest, SharesPlansWithTheSameKey) {
+  FftPlanCache cache;
+  std::shared_ptr<FftPlan> plan = cache.GetOrCreate(MakeKey(0, 16));
+  EXPECT_EQ(cache.GetOrCreate(MakeKey(0, 16)), plan);
+  EXPECT_NE(cache.GetOrCreate(MakeKey(1, 16)), plan);
+  EXPECT_NE(cache.GetOrCreate(MakeKey(0, 32)), plan);
+  EXPECT_EQ(cache.size(), 3);
+}
+
+TEST(FftPlanCacheTest, EvictsLeastRecentlyUsedPlan) {
+  FftPlanCache cache(/*capacity=*/2);
+  std::shared_ptr<FftPlan> plan16 = cache.GetOrCreate(MakeKey(0, 16));
+  std::shared_ptr<FftPlan> plan32 = cache.GetOrCreate(MakeKey(0, 32));
+
+  // Use the first plan again, so the second one is evicted.
+  EXPECT_EQ(cache.GetOrCreate(MakeKey(0, 16)), plan16);
+  std::shared_ptr<FftPlan> plan64 = cache.GetOrCreate(MakeKey(0, 64));
+  EXPECT_EQ(cache.size(), 2);
+
+  EXPECT_EQ(cache.GetOrCreate(MakeKey(0, 16)), plan16);
+  EXPECT_NE(cache.GetOrCreate(MakeKey(0, 32)), plan32);
+}
+
+}  // namespace
+}  // namespace xla::gpu
@@ -15,14 +15,16 @@ limitations under the License.
 
 #include "xla/backends/gpu/runtime/host_memory_pool.h"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <utility>
 
 #include "absl/memory/memory.h"
+#include "absl/numeric/bits.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
-#include "absl/synchronization/mutex.h"
 #include "xla/primitive_util.h"
 #include "xla/stream_executor/memory_allocation.h"
 #include "xla/stream_executor/stream_executor.h"
@@ -40,17 +42,33 @@ absl::StatusOr<std::unique_ptr<HostMemoryPool>> HostMemoryPool::Create(
 }
 
 absl::StatusOr<HostMemoryPool::Handle> HostMemoryPool::Acquire() {
-  absl::MutexLock lock(&mutex_);
-  if (free_list_.empty()) {
-    return absl::ResourceExhaustedError(
-        absl::StrCat("All ", kNumElems,
-                     " elements in the host memory pool are in use. This is "
-                     "likely because there are more than ",
-                     kNumElems, " concurrent calls to an XLA executable."));
+  int64_t byte_width = primitive_util::ByteWidth(type_);
+  for (int64_t word = 0; word < kNumWords; ++word) {
+    uint64_t in_use = in_use_[word].load(std::memory_order_relaxed);
+    while (in_use != ~uint64_t{0}) {
+      int bit = absl::countr_one(in_use);
+      if (in_use_[word].compare_exchange_weak(in_use,
+                                              in_use | (uint64_t{1} << bit),
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed)) {
+        return Handle(this, static_cast<char*>(allocation_->opaque()) +
+                                (word * 64 + bit) * byte_width);
+      }
+    }
   }
-  void* ptr = free_list_.front();
-  free_list_.pop();
-  return Handle(this, ptr);
+  return absl::ResourceExhaustedError(
+      absl::StrCat("All ", kNumElems,
+                   " elements in the host memory pool are in use. This is "
+                   "likely because there are more than ",
+                   kNumElems, " concurrent calls to an XLA executable."));
+}
+
+void HostMemoryPool::Release(void* ptr) {
+  int64_t index = (static_cast<char*>(ptr) -
+                   static_cast<char*>(allocation_->opaque())) /
+                  primitive_util::ByteWidth(type_);
+  in_use_[index / 64].fetch_and(~(uint64_t{1} << (index % 64)),
+                                std::memory_order_release);
 }
 
 HostMemoryPool::Handle::Handle(Handle&& other)
@@ -76,11 +94,7 @@ HostMemoryPool::Handle::~Handle() {
 }
 HostMemoryPool::HostMemoryPool(std::unique_ptr<se::MemoryAllocation> allocation,
                                PrimitiveType type)
-    : allocation_(std::move(allocation)), type_(type) {
-  for (int i = 0; i < kNumElems; ++i) {
-    free_list_.push(static_cast<char*>(allocation_->opaque()) +
-                    i * primitive_util::ByteWidth(type_));
-  }
-}
+    : allocation_(std::move(allocation)), type_(type) {}
+
 }  // namespace gpu
 }  // namespace xla
@@ -16,12 +16,12 @@ limitations under the License.
 #ifndef XLA_BACKENDS_GPU_RUNTIME_HOST_MEMORY_POOL_H_
 #define XLA_BACKENDS_GPU_RUNTIME_HOST_MEMORY_POOL_H_
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <memory>
-#include <queue>
 
 #include "absl/log/check.h"
-#include "absl/synchronization/mutex.h"
 #include "xla/primitive_util.h"
 #include "xla/stream_executor/memory_allocation.h"
 #include "xla/stream_executor/stream_executor.h"
@@ -39,6 +39,10 @@ namespace gpu {
 // if there are more than kNumElems simultaneous executions of an XLA program,
 // an error may be raised. kNumElems is high so this is unlikely to occur in
 // practice.
+//
+// The page-locked allocation is made by the StreamExecutor, which places it on
+// the NUMA node of the device. Acquire and Release are lock-free, so that
+// concurrent executions do not contend on the pool.
 class HostMemoryPool {
  public:
   static constexpr int64_t kNumElems = 128;
@@ -87,15 +91,16 @@ class HostMemoryPool {
   HostMemoryPool(std::unique_ptr<se::MemoryAllocation> allocation,
                  PrimitiveType type);
 
-  void Release(void* ptr) {
-    absl::MutexLock lock(&mutex_);
-    free_list_.push(ptr);
-  }
+  static constexpr int64_t kNumWords = kNumElems / 64;
+  static_assert(kNumElems % 64 == 0);
+
+  void Release(void* ptr);
 
   const std::unique_ptr<se::MemoryAllocation> allocation_;
   const PrimitiveType type_;
-  absl::Mutex mutex_;
-  std::queue<void*> free_list_ ABSL_GUARDED_BY(mutex_);
+
+  // Bit `i % 64` of `in_use_[i / 64]` is set while value `i` is acquired.
+  std::array<std::atomic<uint64_t>, kNumWords> in_use_{};
 };
 
 }  // namespace gpu
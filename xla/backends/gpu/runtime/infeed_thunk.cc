@@ -16,12 +16,14 @@ limitations under the License.
 #include "xla/backends/gpu/runtime/infeed_thunk.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <vector>
 
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/types/span.h"
 #include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/service/gpu/buffer_allocations.h"
 #include "xla/service/gpu/gpu_transfer_manager.h"
@@ -31,7 +33,6 @@ limitations under the License.
 #include "xla/shape_util.h"
 #include "xla/status_macros.h"
 #include "xla/stream_executor/device_memory.h"
-#include "xla/stream_executor/device_memory_handle.h"
 #include "xla/stream_executor/stream_executor.h"
 #include "xla/util.h"
 #include "tsl/platform/errors.h"
@@ -48,17 +49,17 @@ absl::Status InfeedThunk::ExecuteOnStream(const ExecuteParams& params) {
   const BufferAllocations& buffer_allocations = *params.buffer_allocations;
 
   VLOG(2) << "Infeeding to GPU";
-  ShapeTree<se::DeviceMemoryHandle> source_buffers =
-      GpuTransferManager::GetOrCreateInfeedManager(stream.parent())
-          ->BlockingGetNextDestination();
+  InfeedManager* infeed_manager =
+      GpuTransferManager::GetOrCreateInfeedManager(stream.parent());
+  InfeedBuffers source_buffers = infeed_manager->BlockingGetNextDestination();
 
   size_t index = 0;
-  for (auto& source : source_buffers.leaves()) {
+  for (auto& source : source_buffers.leaves.leaves()) {
     // Assert that the shapes are compatible.
     const ShapeIndex& shape_index = source.first;
-    se::DeviceMemoryHandle& buffer = source.second;
+    absl::Span<const uint8_t> buffer = source.second;
     const Shape& source_shape =
-        ShapeUtil::GetSubshape(source_buffers.shape(), shape_index);
+        ShapeUtil::GetSubshape(source_buffers.leaves.shape(), shape_index);
     TF_RET_CHECK(
         ShapeUtil::ReshapeIsBitcast(dest_slices_[index].shape, source_shape))
         << "Mismatch between infeed source buffer shape "
@@ -67,8 +68,9 @@ absl::Status InfeedThunk::ExecuteOnStream(const ExecuteParams& params) {
         << ShapeUtil::HumanStringWithLayout(dest_slices_[index].shape);
     se::DeviceMemoryBase dest_address =
         buffer_allocations.GetDeviceAddress(dest_slices_[index++].slice);
+    // Copy directly from the pinned host staging buffer.
     TF_RETURN_IF_ERROR(
-        stream.Memcpy(&dest_address, buffer.memory(), buffer.memory().size()));
+        stream.Memcpy(&dest_address, buffer.data(), buffer.size()));
   }
 
   // Make sure that all dest slices have been copied into.
@@ -81,6 +83,9 @@ absl::Status InfeedThunk::ExecuteOnStream(const ExecuteParams& params) {
                     &stream, block_status.message());
   }
 
+  // The staging buffer can be reused once the copies are complete.
+  infeed_manager->ReleaseStagingBuffer(std::move(source_buffers.staging));
+
   VLOG(2) << "Infeeding to GPU complete";
   return absl::OkStatus();
 }
@@ -15,7 +15,15 @@ limitations under the License.
 
 #include "xla/backends/gpu/runtime/memset_thunk.h"
 
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "xla/backends/gpu/runtime/thunk.h"
+#include "xla/service/buffer_assignment.h"
 #include "xla/stream_executor/stream_executor.h"
 
 namespace xla {
@@ -34,5 +42,92 @@ absl::Status Memset32BitValueThunk::ExecuteOnStream(
   return params.stream->Memset32(&dest_data, value_, dest_data.size());
 }
 
+namespace {
+
+// Returns the slice that covers both `a` and `b`, or nullopt if they are not
+// contiguous slices of the same allocation.
+std::optional<BufferAllocation::Slice> ConcatSlices(
+    const BufferAllocation::Slice& a, const BufferAllocation::Slice& b) {
+  if (a.allocation() != b.allocation()) {
+    return std::nullopt;
+  }
+  if (a.offset() + a.size() == b.offset()) {
+    return BufferAllocation::Slice(a.allocation(), a.offset(),
+                                   a.size() + b.size());
+  }
+  if (b.offset() + b.size() == a.offset()) {
+    return BufferAllocation::Slice(b.allocation(), b.offset(),
+                                   a.size() + b.size());
+  }
+  return std::nullopt;
+}
+
+// Returns a memset thunk that is equivalent to running `first` and then
+// `second`, or nullptr if they can't be merged into a single memset.
+std::unique_ptr<Thunk> MergeMemsets(const Thunk& first, const Thunk& second) {
+  if (first.kind() != second.kind() ||
+      first.execution_stream_id() != second.execution_stream_id()) {
+    return nullptr;
+  }
+
+  Thunk::ThunkInfo thunk_info;
+  thunk_info.profile_annotation = first.profile_annotation();
+  thunk_info.execution_stream_id = first.execution_stream_id();
+
+  if (first.kind() == Thunk::kMemzero) {
+    std::optional<BufferAllocation::Slice> destination =
+        ConcatSlices(static_cast<const MemzeroThunk&>(first).destination(),
+                     static_cast<const MemzeroThunk&>(second).destination());
+    if (!destination) {
+      return nullptr;
+    }
+    return std::make_unique<MemzeroThunk>(std::move(thunk_info), *destination);
+  }
+
+  if (first.kind() == Thunk::kMemset32BitValue) {
+    const auto& first_memset =
+        static_cast<const Memset32BitValueThunk&>(first);
+    const auto& second_memset =
+        static_cast<const Memset32BitValueThunk&>(second);
+    if (first_memset.value() != second_memset.value()) {
+      return nullptr;
+    }
+    std::optional<BufferAllocation::Slice> destination = ConcatSlices(
+        first_memset.destination(), second_memset.destination());
+    if (!destination) {
+      return nullptr;
+    }
+    return std::make_unique<Memset32BitValueThunk>(
+        std::move(thunk_info), first_memset.value(), *destination);
+  }
+
+  return nullptr;
+}
+
+}  // namespace
+
+int64_t MergeAdjacentMemsetThunks(ThunkSequence& thunks) {
+  int64_t num_removed = 0;
+
+  ThunkSequence merged;
+  merged.reserve(thunks.size());
+
+  for (std::unique_ptr<Thunk>& thunk : thunks) {
+    if (!merged.empty()) {
+      if (auto merged_memset = MergeMemsets(*merged.back(), *thunk)) {
+        VLOG(3) << "Merge memset " << thunk->profile_annotation() << " into "
+                << merged.back()->profile_annotation();
+        merged.back() = std::move(merged_memset);
+        ++num_removed;
+        continue;
+      }
+    }
+    merged.push_back(std::move(thunk));
+  }
+
+  thunks = std::move(merged);
+  return num_removed;
+}
+
 }  // namespace gpu
 }  // namespace xla
@@ -63,6 +63,14 @@ class Memset32BitValueThunk : public Thunk {
   const BufferAllocation::Slice dest_;
 };
 
+// Merges runs of adjacent top-level memset thunks in `thunks` that set
+// contiguous slices of the same allocation to the same value into a single
+// memset, so that zero-initialization of many small buffers (e.g. scatter and
+// reduction outputs packed into one allocation) pays for one launch, or
+// becomes one memset node in a command buffer. Memsets are merged only if they
+// run on the same execution stream. Returns the number of removed thunks.
+int64_t MergeAdjacentMemsetThunks(ThunkSequence& thunks);
+
 }  // namespace gpu
 }  // namespace xla
 
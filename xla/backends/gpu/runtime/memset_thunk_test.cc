@@ -0,0 +1,93 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/gpu/runtime/memset_thunk.h"
+
+#include <cstdint>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "xla/backends/gpu/runtime/thunk.h"
+#include "xla/service/buffer_assignment.h"
+
+namespace xla::gpu {
+namespace {
+
+std::unique_ptr<Thunk> Memzero(const BufferAllocation& alloc, int64_t offset,
+                               int64_t size, int64_t stream_id = 0) {
+  Thunk::ThunkInfo thunk_info;
+  thunk_info.execution_stream_id = ExecutionStreamId(stream_id);
+  return std::make_unique<MemzeroThunk>(
+      thunk_info, BufferAllocation::Slice(&alloc, offset, size));
+}
+
+std::unique_ptr<Thunk> Memset32(const BufferAllocation& alloc, int64_t offset,
+                                int64_t size, uint32_t value) {
+  return std::make_unique<Memset32BitValueThunk>(
+      Thunk::ThunkInfo(), value, BufferAllocation::Slice(&alloc, offset, size));
+}
+
+TEST(MemsetThunkTest, MergesContiguousMemzeros) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/1024, /*color=*/0);
+
+  ThunkSequence thunks;
+  thunks.push_back(Memzero(alloc, 64, 16));
+  thunks.push_back(Memzero(alloc, 80, 32));
+  // Memsets commute, so the slice may also precede the merged one.
+  thunks.push_back(Memzero(alloc, 0, 64));
+
+  EXPECT_EQ(MergeAdjacentMemsetThunks(thunks), 2);
+  ASSERT_EQ(thunks.size(), 1);
+  ASSERT_EQ(thunks[0]->kind(), Thunk::kMemzero);
+  EXPECT_EQ(static_cast<const MemzeroThunk&>(*thunks[0]).destination(),
+            BufferAllocation::Slice(&alloc, 0, 112));
+}
+
+TEST(MemsetThunkTest, MergesMemset32WithSameValue) {
+  BufferAllocation alloc(/*index=*/0, /*size=*/1024, /*color=*/0);
+
+  ThunkSequence thunks;
+  thunks.push_back(Memset32(alloc, 0, 16, /*value=*/7));
+  thunks.push_back(Memset32(alloc, 16, 16, /*value=*/7));
+  thunks.push_back(Memset32(alloc, 32, 16, /*value=*/8));
+
+  EXPECT_EQ(MergeAdjacentMemsetThunks(thunks), 1);
+  ASSERT_EQ(thunks.size(), 2);
+  const auto& memset = static_cast<const Memset32BitValueThunk&>(*thunks[0]);
+  EXPECT_EQ(memset.destination(), BufferAllocation::Slice(&alloc, 0, 32));
+  EXPECT_EQ(memset.value(), 7);
+}
+
+TEST(MemsetThunkTest, KeepsNonContiguousMemsets) {
+  BufferAllocation alloc0(/*index=*/0, /*size=*/1024, /*color=*/0);
+  BufferAllocation alloc1(/*index=*/1, /*size=*/1024, /*color=*/0);
+
+  ThunkSequence thunks;
+  thunks.push_back(Memzero(alloc0, 0, 16));
+  // Gap between the slices.
+  thunks.push_back(Memzero(alloc0, 32, 16));
+  // Contiguous, but runs on a different execution stream.
+  thunks.push_back(Memzero(alloc0, 48, 16, /*stream_id=*/1));
+  // Different allocation.
+  thunks.push_back(Memzero(alloc1, 64, 16, /*stream_id=*/1));
+  // Contiguous, but sets a different value.
+  thunks.push_back(Memset32(alloc1, 80, 16, /*value=*/1));
+
+  EXPECT_EQ(MergeAdjacentMemsetThunks(thunks), 0);
+  EXPECT_EQ(thunks.size(), 5);
+}
+
+}  // namespace
+}  // namespace xla::gpu
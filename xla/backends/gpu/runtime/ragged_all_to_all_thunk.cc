@@ -129,8 +129,9 @@ absl::Status RunAllToAllOnIndexBuffer(
                                   RankId(peer), GpuCollectives::On(stream)));
   }
 
-  TF_RETURN_IF_ERROR(collectives->GroupEnd());
-  return stream.BlockHostUntilDone();
+  // We don't wait for the completion of the AllToAll here, because users of
+  // the destination buffer are ordered after it on the same stream.
+  return collectives->GroupEnd();
 }
 
 absl::Status RunRaggedAllToAll(
@@ -155,7 +156,8 @@ absl::Status RunRaggedAllToAll(
   // that `output_offset[i]` is an offset in the i-th peer output buffer. To
   // make it work for NCCL model with send/recv, we need to know offsets in the
   // local output buffer. To get the correct offsets we perform an AllToAll on
-  // the output_offsets buffer.
+  // the output_offsets buffer. Exchanged offsets are loaded to the host
+  // together with the rest of the metadata, after a single synchronization.
   DeviceBufferPair& output_offsets_buffer_pair = buffers[4];
   TF_RETURN_IF_ERROR(RunAllToAllOnIndexBuffer(
       collectives, output_offsets_buffer_pair.source_buffer,
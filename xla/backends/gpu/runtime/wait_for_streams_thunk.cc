@@ -15,6 +15,12 @@ limitations under the License.
 
 #include "xla/backends/gpu/runtime/wait_for_streams_thunk.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "xla/backends/gpu/runtime/thunk.h"
@@ -35,4 +41,104 @@ absl::Status WaitForStreamsThunk::ExecuteOnStream(const ExecuteParams& params) {
   return stream->WaitFor(wait_on_stream);
 }
 
+namespace {
+
+// Vector clocks of execution streams. Every stream has a counter of enqueued
+// operations, and for every stream we keep the counters of other streams that
+// it waited for. All streams start with one unknown operation, because
+// streams can have work enqueued before the thunk sequence starts.
+class StreamClocks {
+ public:
+  // Records an operation enqueued on the `stream_id`.
+  void Enqueue(ExecutionStreamId stream_id) {
+    ++counters_.try_emplace(stream_id, 1).first->second;
+  }
+
+  // Returns true if the `stream_id` already waits for all the operations
+  // enqueued on the `wait_for_stream_id`.
+  bool IsSynchronized(ExecutionStreamId stream_id,
+                      ExecutionStreamId wait_for_stream_id) const {
+    if (stream_id == wait_for_stream_id) return true;
+
+    auto clock = clocks_.find(stream_id);
+    if (clock == clocks_.end()) return false;
+    auto counter = clock->second.find(wait_for_stream_id);
+    return counter != clock->second.end() &&
+           counter->second >= Counter(wait_for_stream_id);
+  }
+
+  // Records that `stream_id` waits for all the operations enqueued on the
+  // `wait_for_stream_id`, and transitively for everything it waited for.
+  void Wait(ExecutionStreamId stream_id, ExecutionStreamId wait_for_stream_id) {
+    Clock wait_for_clock = clocks_[wait_for_stream_id];
+    Clock& clock = clocks_[stream_id];
+    for (auto& [id, counter] : wait_for_clock) {
+      clock[id] = std::max(clock[id], counter);
+    }
+    clock[wait_for_stream_id] = Counter(wait_for_stream_id);
+    Enqueue(stream_id);
+  }
+
+ private:
+  using Clock = absl::flat_hash_map<ExecutionStreamId, int64_t>;
+
+  int64_t Counter(ExecutionStreamId stream_id) const {
+    auto it = counters_.find(stream_id);
+    return it == counters_.end() ? 1 : it->second;
+  }
+
+  Clock counters_;
+  absl::flat_hash_map<ExecutionStreamId, Clock> clocks_;
+};
+
+// Returns true if thunks of the given kind launch all their work on the stream
+// returned by Thunk::GetStreamForExecution for their execution stream id.
+bool UsesExecutionStream(Thunk::Kind kind) {
+  return kind == Thunk::kCopy || kind == Thunk::kGemm ||
+         kind == Thunk::kKernel;
+}
+
+}  // namespace
+
+int64_t RemoveRedundantWaitForStreamsThunks(ThunkSequence& thunks) {
+  StreamClocks clocks;
+  int64_t num_removed = 0;
+
+  ThunkSequence pruned;
+  pruned.reserve(thunks.size());
+
+  for (std::unique_ptr<Thunk>& thunk : thunks) {
+    if (thunk->kind() == Thunk::kWaitForStreams) {
+      auto* wait = static_cast<WaitForStreamsThunk*>(thunk.get());
+      if (clocks.IsSynchronized(wait->stream_id(),
+                                wait->wait_for_stream_id())) {
+        VLOG(3) << "Remove redundant wait of stream " << wait->stream_id()
+                << " for stream " << wait->wait_for_stream_id() << ": "
+                << wait->profile_annotation();
+        ++num_removed;
+        continue;
+      }
+      clocks.Wait(wait->stream_id(), wait->wait_for_stream_id());
+      pruned.push_back(std::move(thunk));
+      continue;
+    }
+
+    thunk->ForAllThunks([&](const Thunk* nested) {
+      if (nested->kind() == Thunk::kWaitForStreams) {
+        clocks.Enqueue(
+            static_cast<const WaitForStreamsThunk*>(nested)->stream_id());
+        return;
+      }
+      clocks.Enqueue(nested->execution_stream_id());
+      if (!UsesExecutionStream(nested->kind())) {
+        clocks.Enqueue(Thunk::kDefaultExecutionStreamId);
+      }
+    });
+    pruned.push_back(std::move(thunk));
+  }
+
+  thunks = std::move(pruned);
+  return num_removed;
+}
+
 }  // namespace xla::gpu
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_BACKENDS_GPU_RUNTIME_WAIT_FOR_STREAMS_THUNK_H_
 #define XLA_BACKENDS_GPU_RUNTIME_WAIT_FOR_STREAMS_THUNK_H_
 
+#include <cstdint>
 #include <vector>
 
 #include "absl/status/status.h"
@@ -45,6 +46,17 @@ class WaitForStreamsThunk : public Thunk {
   ExecutionStreamId wait_for_stream_id_;
 };
 
+// Removes top-level WaitForStreamsThunks from `thunks` that are implied by the
+// previous waits: if a stream already waited (directly or transitively through
+// other streams) for all the work enqueued on the other stream, waiting again
+// is a no-op. Returns the number of removed thunks.
+//
+// Work enqueued by thunks is tracked conservatively: thunks that don't launch
+// on their execution stream via Thunk::GetStreamForExecution are assumed to
+// also launch work on the default execution stream, and nested thunks (i.e.
+// bodies of control flow thunks) never make waits redundant.
+int64_t RemoveRedundantWaitForStreamsThunks(ThunkSequence& thunks);
+
 }  // namespace xla::gpu
 
 #endif  // XLA_BACKENDS_GPU_RUNTIME_WAIT_FOR_STREAMS_THUNK_H_
@@ -0,0 +1,138 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/backends/gpu/runtime/wait_for_streams_thunk.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "xla/backends/gpu/runtime/thunk.h"
+
+namespace xla::gpu {
+namespace {
+
+// A thunk that launches work on its execution stream.
+class KernelLikeThunk : public Thunk {
+ public:
+  explicit KernelLikeThunk(ExecutionStreamId stream_id, Kind kind = kKernel)
+      : Thunk(kind, ThunkInfo()) {
+    set_execution_stream_id(stream_id);
+  }
+
+  absl::Status ExecuteOnStream(const ExecuteParams& params) final {
+    return absl::OkStatus();
+  }
+};
+
+class ThunkSequenceBuilder {
+ public:
+  ThunkSequenceBuilder& Launch(int64_t stream_id,
+                               Thunk::Kind kind = Thunk::kKernel) {
+    thunks_.push_back(
+        std::make_unique<KernelLikeThunk>(ExecutionStreamId(stream_id), kind));
+    return *this;
+  }
+
+  ThunkSequenceBuilder& Wait(int64_t stream_id, int64_t wait_for_stream_id) {
+    thunks_.push_back(std::make_unique<WaitForStreamsThunk>(
+        Thunk::ThunkInfo(), ExecutionStreamId(stream_id),
+        ExecutionStreamId(wait_for_stream_id)));
+    return *this;
+  }
+
+  ThunkSequence Build() { return std::move(thunks_); }
+
+ private:
+  ThunkSequence thunks_;
+};
+
+// Returns (stream_id, wait_for_stream_id) pairs of all waits in `thunks`.
+std::vector<std::pair<int64_t, int64_t>> GetWaits(const ThunkSequence& thunks) {
+  std::vector<std::pair<int64_t, int64_t>> waits;
+  for (const std::unique_ptr<Thunk>& thunk : thunks) {
+    if (thunk->kind() == Thunk::kWaitForStreams) {
+      auto* wait = static_cast<const WaitForStreamsThunk*>(thunk.get());
+      waits.emplace_back(wait->stream_id().value(),
+                         wait->wait_for_stream_id().value());
+    }
+  }
+  return waits;
+}
+
+TEST(WaitForStreamsThunkTest, KeepsWaitsForNewWork) {
+  ThunkSequence thunks =
+      ThunkSequenceBuilder().Wait(1, 0).Launch(1).Launch(0).Wait(0, 1).Build();
+
+  EXPECT_EQ(RemoveRedundantWaitForStreamsThunks(thunks), 0);
+  EXPECT_EQ(thunks.size(), 4);
+}
+
+TEST(WaitForStreamsThunkTest, RemovesRepeatedWait) {
+  ThunkSequence thunks = ThunkSequenceBuilder()
+                             .Wait(1, 0)
+                             .Launch(1)
+                             .Wait(1, 0)
+                             .Launch(1)
+                             .Build();
+
+  EXPECT_EQ(RemoveRedundantWaitForStreamsThunks(thunks), 1);
+  EXPECT_EQ(thunks.size(), 3);
+  EXPECT_EQ(GetWaits(thunks), (std::vector<std::pair<int64_t, int64_t>>{
+                                  {1, 0}}));
+}
+
+TEST(WaitForStreamsThunkTest, RemovesTransitiveWait) {
+  // Stream 2 waits for stream 1 that already waited for stream 0, so it
+  // doesn't need to wait for stream 0 again.
+  ThunkSequence thunks = ThunkSequenceBuilder()
+                             .Launch(0)
+                             .Wait(1, 0)
+                             .Wait(2, 1)
+                             .Wait(2, 0)
+                             .Launch(2)
+                             .Build();
+
+  EXPECT_EQ(RemoveRedundantWaitForStreamsThunks(thunks), 1);
+  EXPECT_EQ(GetWaits(thunks), (std::vector<std::pair<int64_t, int64_t>>{
+                                  {1, 0}, {2, 1}}));
+}
+
+TEST(WaitForStreamsThunkTest, KeepsWaitAfterNonStreamAwareThunk) {
+  // Custom calls can launch work on the default stream even if assigned to a
+  // different execution stream.
+  ThunkSequence thunks = ThunkSequenceBuilder()
+                             .Wait(1, 0)
+                             .Launch(1, Thunk::kCustomCall)
+                             .Wait(1, 0)
+                             .Build();
+
+  EXPECT_EQ(RemoveRedundantWaitForStreamsThunks(thunks), 0);
+  EXPECT_EQ(thunks.size(), 3);
+}
+
+TEST(WaitForStreamsThunkTest, KeepsFirstWait) {
+  // Streams can have work enqueued before the thunk sequence starts.
+  ThunkSequence thunks = ThunkSequenceBuilder().Wait(1, 0).Build();
+
+  EXPECT_EQ(RemoveRedundantWaitForStreamsThunks(thunks), 0);
+  EXPECT_EQ(thunks.size(), 1);
+}
+
+}  // namespace
+}  // namespace xla::gpu
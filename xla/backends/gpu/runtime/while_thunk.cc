@@ -27,12 +27,15 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "xla/backends/gpu/runtime/host_memory_pool.h"
 #include "xla/backends/gpu/runtime/sequential_thunk.h"
 #include "xla/backends/gpu/runtime/thunk.h"
 #include "xla/service/buffer_assignment.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/stream_executor/memory_allocation.h"
+#include "xla/stream_executor/stream.h"
 #include "xla/tsl/platform/statusor.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/logging.h"
@@ -56,6 +59,39 @@ static std::list<RunningLoop>& RunningLoops() {
   return loops;
 }
 
+// Value of the page-locked loop predicate while the device-to-host copy of the
+// condition result is still in flight. Valid predicates are 0 or 1.
+static constexpr uint8_t kPredicateNotReady = 0xFF;
+
+// Maximum time to busy poll the page-locked loop predicate before falling back
+// to a blocking stream synchronization.
+static constexpr absl::Duration kMaxPredicateSpinTime = absl::Microseconds(50);
+
+// Waits until the device-to-host copy of the loop predicate into `predicate`
+// (initialized to kPredicateNotReady) is complete. Condition computations are
+// usually tiny, and polling the page-locked value detects the completed copy
+// much sooner than a stream synchronization that may put the calling thread to
+// sleep. If the predicate does not arrive within kMaxPredicateSpinTime (long
+// running condition, or a failed stream that will never write it) falls back
+// to the stream synchronization, which also surfaces execution errors.
+static absl::Status AwaitPredicate(se::Stream& stream,
+                                   const volatile uint8_t* predicate) {
+  const int64_t deadline_ns =
+      absl::GetCurrentTimeNanos() +
+      absl::ToInt64Nanoseconds(kMaxPredicateSpinTime);
+  while (*predicate == kPredicateNotReady) {
+    if (absl::GetCurrentTimeNanos() > deadline_ns) {
+      if (absl::Status blocked = stream.BlockHostUntilDone(); !blocked.ok()) {
+        return absl::InternalError(absl::StrFormat(
+            "Failed to complete all kernels launched on stream %p: %s",
+            &stream, blocked.message()));
+      }
+      return absl::OkStatus();
+    }
+  }
+  return absl::OkStatus();
+}
+
 absl::StatusOr<int64_t> WhileThunk::CurrentLoopIteration(int64_t depth) {
   if (depth >= RunningLoops().size()) {
     return absl::InvalidArgumentError(absl::StrFormat(
@@ -151,14 +187,11 @@ absl::Status WhileThunk::ExecuteOnStream(const ExecuteParams& params) {
     TF_RETURN_IF_ERROR(condition_thunk_sequence_->ExecuteOnStream(params));
 
     // Copy the result of condition computation and break the loop if 'false'.
+    auto* predicate = reinterpret_cast<volatile uint8_t*>(condition_result);
+    *predicate = kPredicateNotReady;
     TF_RETURN_IF_ERROR(
         stream.Memcpy(condition_result, condition_result_data, sizeof(bool)));
-
-    if (absl::Status blocked = stream.BlockHostUntilDone(); !blocked.ok()) {
-      return absl::InternalError(absl::StrFormat(
-          "Failed to complete all kernels launched on stream %p: %s", &stream,
-          blocked.message()));
-    }
+    TF_RETURN_IF_ERROR(AwaitPredicate(stream, predicate));
 
     VLOG(3) << "condition_result = " << *condition_result;
     if (!*condition_result) {
@@ -43,8 +43,9 @@ namespace gpu {
 // allocation:
 //   init, condition.parameter, body.parameter, body.root, while.result
 //
-// WhileThunk synchronizes the stream to test the result of the 'condition'
-// computation.
+// WhileThunk copies the result of the 'condition' computation to page-locked
+// host memory and waits for it to test the result, by briefly polling the host
+// value and then falling back to synchronizing the stream.
 //
 // If `trip_count` is available it means that the while loop trip count is known
 // statically and while loop is actually a for loop, and in this case at run
@@ -71,6 +71,19 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_backend_optimization_level(3);
   opts.set_xla_gpu_autotune_level(4);
   opts.set_xla_gpu_autotune_max_solutions(0);
+  opts.set_xla_gpu_experimental_autotune_max_triton_configs(0);
+  opts.set_xla_gpu_experimental_activation_offloading_min_size_bytes(0);
+  opts.set_xla_gpu_scatter_sort_min_updates_per_index(0);
+  opts.set_xla_gpu_experimental_enable_persistent_triton_gemm_autotuning(false);
+  opts.set_xla_gpu_experimental_enable_dot_batching(false);
+  opts.set_xla_gpu_experimental_enable_spmd_dot_cost_model(false);
+  opts.set_xla_gpu_enable_thunk_timing(false);
+  opts.set_xla_gpu_experimental_enable_concurrent_fusions(false);
+  opts.set_xla_gpu_pipelined_all_gather_memory_limit_bytes(0);
+  opts.set_xla_gpu_experimental_copy_aware_dot_operand_layouts(false);
+  opts.set_xla_dump_async(false);
+  opts.set_xla_dump_compress_text(false);
+  opts.set_xla_dump_skip_unchanged_modules(false);
   opts.set_xla_cpu_multi_thread_eigen(true);
   opts.set_xla_gpu_cuda_data_dir("./cuda_sdk_lib");
   opts.set_xla_gpu_generate_debug_info(false);
@@ -105,6 +118,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_cpu_use_fusion_emitters(true);
   opts.set_xla_cpu_use_thunk_runtime(true);
   opts.set_xla_cpu_use_xnnpack(false);
+  opts.set_xla_cpu_use_huge_pages_for_temp_buffers(false);
   opts.set_xla_cpu_experimental_xnn_graph_fusion_mode(
       DebugOptions::XNN_GRAPH_FUSION_MODE_DISABLED);
   opts.set_xla_cpu_parallel_codegen_split_count(32);
@@ -113,6 +127,14 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_cpu_prefer_vector_width(256);
   opts.set_xla_cpu_max_isa(DefaultMaxIsa());
   opts.set_xla_cpu_generate_unique_c_style_kernel_entry_points(false);
+  opts.set_xla_cpu_experimental_work_stealing_ready_queue(false);
+  opts.set_xla_cpu_experimental_execute_state_pool(false);
+  opts.set_xla_cpu_experimental_numa_aware_parallel_loops(false);
+  opts.set_xla_cpu_experimental_adaptive_tile_size(false);
+  opts.set_xla_cpu_experimental_weight_only_quantized_dot(false);
+  opts.set_xla_cpu_experimental_amx_dot(false);
+  opts.set_xla_cpu_experimental_reduction_fusion_emitter(false);
+  opts.set_xla_cpu_experimental_native_bf16(false);
 
   opts.set_xla_cpu_enable_fast_math(false);
   // Disable forms of fast math that have caused users problems in the past.
@@ -134,9 +156,12 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.add_xla_gpu_enable_command_buffer(DebugOptions::CUSTOM_CALL);
   opts.add_xla_gpu_enable_command_buffer(DebugOptions::CUDNN);
   opts.add_xla_gpu_enable_command_buffer(DebugOptions::CONDITIONAL);
+  opts.add_xla_gpu_enable_command_buffer(DebugOptions::WHILE);
   opts.set_xla_gpu_graph_min_graph_size(5);
+  opts.set_xla_gpu_graph_capture_launch_bound_fusions(false);
   opts.set_xla_gpu_graph_enable_concurrent_region(false);
   opts.set_xla_cmd_buffer_trace_cache_size(16);
+  opts.set_xla_gpu_command_buffer_cache_size(0);
 
   opts.set_xla_gpu_collectives_use_persistent_cliques(false);
 
@@ -172,6 +197,9 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_gpu_nccl_termination_timeout_seconds(-1);
   opts.set_xla_gpu_enable_shared_constants(true);
   opts.set_xla_gpu_enable_nccl_user_buffers(false);
+  opts.set_xla_gpu_experimental_enable_compressed_all_reduce(false);
+  opts.set_xla_gpu_all_reduce_blueconnect_use_topology(false);
+  opts.set_xla_gpu_all_reduce_blueconnect_min_bytes(0);
   opts.set_xla_gpu_enable_nccl_comm_splitting(true);
   opts.set_xla_gpu_nccl_init_max_rank_per_root_ratio(0);
 
@@ -311,6 +339,7 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
       DebugOptions::AUTOTUNE_CACHE_MODE_UPDATE);
 
   opts.set_xla_gpu_autotune_gemm_rtol(0.1f);
+  opts.set_xla_gpu_experimental_autotune_num_profiling_devices(1);
 
   opts.set_xla_enable_command_buffers_during_profiling(false);
 
@@ -336,7 +365,10 @@ DebugOptions DefaultDebugOptionsIgnoringFlags() {
   opts.set_xla_gpu_experimental_pack_dot_operands_along_k_dimension(true);
   opts.set_xla_unsupported_crash_on_hlo_pass_fix_max_iterations(false);
   opts.set_xla_hlo_pass_fix_detect_cycles(false);
+  opts.set_xla_auto_donate_input_buffers(false);
+  opts.set_xla_report_missed_buffer_donation(false);
   opts.set_xla_gpu_experimental_enable_sync_collective_combining(false);
+  opts.set_xla_gpu_experimental_enable_cost_model_combiner_threshold(false);
   opts.set_xla_allow_get_default_platform(true);
   opts.set_xla_unsupported_crash_on_hlo_pass_silent_hlo_change(false);
   opts.set_xla_unsupported_crash_on_hlo_pass_noop_change(false);
@@ -992,6 +1024,13 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
                 bool_setter_for(&DebugOptions::set_xla_cpu_use_xnnpack),
                 debug_options->xla_cpu_use_xnnpack(),
                 "Use XNNPACK for supported operations."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_use_huge_pages_for_temp_buffers",
+      bool_setter_for(
+          &DebugOptions::set_xla_cpu_use_huge_pages_for_temp_buffers),
+      debug_options->xla_cpu_use_huge_pages_for_temp_buffers(),
+      "Align large temporary buffers to the huge page size and back them with "
+      "transparent huge pages."));
   flag_list->push_back(tsl::Flag(
       "xla_cpu_experimental_xnn_graph_fusion_mode",
       setter_for_xla_cpu_experimental_xnn_graph_fusion_mode,
@@ -1007,6 +1046,66 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       debug_options->xla_cpu_parallel_codegen_split_count(),
       "Split LLVM module into at most this many parts before codegen to enable "
       "parallel compilation for the CPU backend."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_experimental_work_stealing_ready_queue",
+      bool_setter_for(
+          &DebugOptions::set_xla_cpu_experimental_work_stealing_ready_queue),
+      debug_options->xla_cpu_experimental_work_stealing_ready_queue(),
+      "Use per-worker work stealing deques for ready thunks in the XLA:CPU "
+      "thunk executor."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_experimental_execute_state_pool",
+      bool_setter_for(
+          &DebugOptions::set_xla_cpu_experimental_execute_state_pool),
+      debug_options->xla_cpu_experimental_execute_state_pool(),
+      "Reuse execute states across executions in the XLA:CPU thunk executor "
+      "to avoid per-call heap allocations."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_experimental_numa_aware_parallel_loops",
+      bool_setter_for(
+          &DebugOptions::set_xla_cpu_experimental_numa_aware_parallel_loops),
+      debug_options->xla_cpu_experimental_numa_aware_parallel_loops(),
+      "Partition XNNPACK parallel loops across NUMA nodes in XLA:CPU and "
+      "steal work within a NUMA node first."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_experimental_adaptive_tile_size",
+      bool_setter_for(
+          &DebugOptions::set_xla_cpu_experimental_adaptive_tile_size),
+      debug_options->xla_cpu_experimental_adaptive_tile_size(),
+      "Learn tile sizes of XNNPACK dynamic parallel loops in XLA:CPU from "
+      "measured loop execution times."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_object_cache_dir",
+      string_setter_for(&DebugOptions::set_xla_cpu_object_cache_dir),
+      debug_options->xla_cpu_object_cache_dir(),
+      "If not empty, XLA:CPU caches compiled object files in this directory "
+      "and skips LLVM compilation for modules found in the cache."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_experimental_weight_only_quantized_dot",
+      bool_setter_for(
+          &DebugOptions::set_xla_cpu_experimental_weight_only_quantized_dot),
+      debug_options->xla_cpu_experimental_weight_only_quantized_dot(),
+      "Execute F32 dots with S8 and S4 weights in XLA:CPU as weight-only "
+      "quantized matmuls without upcasting weights to F32."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_experimental_amx_dot",
+      bool_setter_for(&DebugOptions::set_xla_cpu_experimental_amx_dot),
+      debug_options->xla_cpu_experimental_amx_dot(),
+      "Execute large BF16 dots in XLA:CPU with AMX tile instructions on CPUs "
+      "that support AMX BF16, instead of upcasting them to F32."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_experimental_reduction_fusion_emitter",
+      bool_setter_for(
+          &DebugOptions::set_xla_cpu_experimental_reduction_fusion_emitter),
+      debug_options->xla_cpu_experimental_reduction_fusion_emitter(),
+      "Emit loop fusions rooted at row reductions with the XLA:CPU fusion "
+      "emitters, using multiple SIMD accumulators per output element."));
+  flag_list->push_back(tsl::Flag(
+      "xla_cpu_experimental_native_bf16",
+      bool_setter_for(&DebugOptions::set_xla_cpu_experimental_native_bf16),
+      debug_options->xla_cpu_experimental_native_bf16(),
+      "Keep BF16 data movement ops, and on CPUs with AVX512-BF16 also simple "
+      "elementwise ops, in BF16 instead of upcasting them to F32."));
   flag_list->push_back(tsl::Flag(
       "xla_cpu_copy_insertion_use_region_analysis",
       bool_setter_for(
@@ -1064,11 +1163,98 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       debug_options->xla_gpu_autotune_max_solutions(),
       "Maximal number of GEMM solutions to consider for autotuning: 0 means "
       "consider all solutions returned by the GEMM library."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_autotune_max_triton_configs",
+      int64_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_autotune_max_triton_configs),
+      debug_options->xla_gpu_experimental_autotune_max_triton_configs(),
+      "Maximal number of Triton tiling configs to profile for each GEMM "
+      "fusion, picked by the performance model: 0 means profile all "
+      "configs."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_activation_offloading_min_size_bytes",
+      int64_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_activation_offloading_min_size_bytes),
+      debug_options
+          ->xla_gpu_experimental_activation_offloading_min_size_bytes(),
+      "Minimal size in bytes of long-lived activations that are automatically "
+      "offloaded to host memory: 0 disables automatic offloading."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_scatter_sort_min_updates_per_index",
+      int64_setter_for(
+          &DebugOptions::set_xla_gpu_scatter_sort_min_updates_per_index),
+      debug_options->xla_gpu_scatter_sort_min_updates_per_index(),
+      "Minimal number of updates per possible distinct index for which "
+      "scatters sort and combine colliding updates instead of using atomics: "
+      "0 disables the rewrite."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_persistent_triton_gemm_autotuning",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_enable_persistent_triton_gemm_autotuning),
+      debug_options
+          ->xla_gpu_experimental_enable_persistent_triton_gemm_autotuning(),
+      "Also autotune persistent Triton GEMM schedules, where a single wave of "
+      "programs loops over all output tiles."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_dot_batching",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_enable_dot_batching),
+      debug_options->xla_gpu_experimental_enable_dot_batching(),
+      "Stack independent small dots with identical shapes into a single "
+      "batched dot. Dots are eligible if their inputs and output fit into "
+      "xla_gpu_dot_merger_threshold_mb."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_spmd_dot_cost_model",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_enable_spmd_dot_cost_model),
+      debug_options->xla_gpu_experimental_enable_spmd_dot_cost_model(),
+      "Use the GPU performance models to estimate partitioned dots and their "
+      "collectives when choosing SPMD dot partitioning strategies."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_enable_thunk_timing",
+      bool_setter_for(&DebugOptions::set_xla_gpu_enable_thunk_timing),
+      debug_options->xla_gpu_enable_thunk_timing(),
+      "Time every thunk of a GPU executable with device events and record the "
+      "durations in a per-module histogram. Synchronizes the host with the "
+      "device after every thunk."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_concurrent_fusions",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_enable_concurrent_fusions),
+      debug_options->xla_gpu_experimental_enable_concurrent_fusions(),
+      "Run independent fusions that are too small to occupy the whole GPU "
+      "concurrently on additional compute streams."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_pipelined_all_gather_memory_limit_bytes",
+      int64_setter_for(
+          &DebugOptions::set_xla_gpu_pipelined_all_gather_memory_limit_bytes),
+      debug_options->xla_gpu_pipelined_all_gather_memory_limit_bytes(),
+      "Maximum total size in bytes of all-gather results prefetched for the "
+      "next iteration of a single while loop by the collective pipeliner. "
+      "Zero means no limit."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_copy_aware_dot_operand_layouts",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_copy_aware_dot_operand_layouts),
+      debug_options->xla_gpu_experimental_copy_aware_dot_operand_layouts(),
+      "Prefer dot operand layouts that make the transposes feeding the "
+      "operand bitcasts of an already constrained buffer."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_autotune_gemm_rtol",
       float_setter_for(&DebugOptions::set_xla_gpu_autotune_gemm_rtol),
       debug_options->xla_gpu_autotune_gemm_rtol(),
       "Relative precision for comparing GEMM solutions vs the reference one"));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_autotune_num_profiling_devices",
+      int64_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_autotune_num_profiling_devices),
+      debug_options->xla_gpu_experimental_autotune_num_profiling_devices(),
+      "Maximum number of local devices used to profile GEMM fusion autotuning "
+      "candidates in parallel."));
   flag_list->push_back(tsl::Flag(
       "xla_force_host_platform_device_count",
       int32_setter_for(&DebugOptions::set_xla_force_host_platform_device_count),
@@ -1230,6 +1416,22 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
                 bool_setter_for(&DebugOptions::set_xla_dump_compress_protos),
                 debug_options->xla_dump_compress_protos(),
                 "Gzip-compress protos dumped by --xla_dump_hlo_as_proto."));
+  flag_list->push_back(tsl::Flag(
+      "xla_dump_async", bool_setter_for(&DebugOptions::set_xla_dump_async),
+      debug_options->xla_dump_async(),
+      "Writes dump files on a background thread, so that compilation doesn't "
+      "wait for file I/O and compression."));
+  flag_list->push_back(tsl::Flag(
+      "xla_dump_compress_text",
+      bool_setter_for(&DebugOptions::set_xla_dump_compress_text),
+      debug_options->xla_dump_compress_text(),
+      "Gzip-compress HLO modules dumped by --xla_dump_hlo_as_text."));
+  flag_list->push_back(tsl::Flag(
+      "xla_dump_skip_unchanged_modules",
+      bool_setter_for(&DebugOptions::set_xla_dump_skip_unchanged_modules),
+      debug_options->xla_dump_skip_unchanged_modules(),
+      "Skips dumping a module between passes if it hasn't changed since its "
+      "previous dump."));
   flag_list->push_back(tsl::Flag(
       "xla_hlo_graph_addresses",
       bool_setter_for(&DebugOptions::set_xla_hlo_graph_addresses),
@@ -1419,6 +1621,31 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "ReduceScatter-AllReduce-AllGather sequence, with the initial "
       "ReduceScatter being performed over all of the devices in the same host. "
       "Set to < 1 to disable all-reduce decomposition."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_all_reduce_blueconnect_use_topology",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_all_reduce_blueconnect_use_topology),
+      debug_options->xla_gpu_all_reduce_blueconnect_use_topology(),
+      "If xla_gpu_all_reduce_blueconnect_num_devices_per_host is not set, "
+      "derive the first stage of the BlueConnect decomposition from the GPU "
+      "cluster topology: the devices of a slice (an NVLink domain, or a host "
+      "without multi-node NVLink)."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_all_reduce_blueconnect_min_bytes",
+      int64_setter_for(
+          &DebugOptions::set_xla_gpu_all_reduce_blueconnect_min_bytes),
+      debug_options->xla_gpu_all_reduce_blueconnect_min_bytes(),
+      "All-reduces smaller than this many bytes are not decomposed by the "
+      "BlueConnect pass."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_compressed_all_reduce",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_experimental_enable_compressed_all_reduce),
+      debug_options->xla_gpu_experimental_enable_compressed_all_reduce(),
+      "Decompose sum all-reduces of f32 (or wider) values into an all-to-all "
+      "and an all-gather that transfer bf16 values, and accumulate partial "
+      "sums in the original type. Reduces all-reduce traffic at the expense of "
+      "precision."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_enable_while_loop_reduce_scatter_code_motion",
       bool_setter_for(
@@ -1511,6 +1738,14 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       debug_options->xla_gpu_graph_min_graph_size(),
       "Capture a region as a function to be launched as cuda graph if the "
       "number of moved instructions reaches this threshold."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_graph_capture_launch_bound_fusions",
+      bool_setter_for(
+          &DebugOptions::set_xla_gpu_graph_capture_launch_bound_fusions),
+      debug_options->xla_gpu_graph_capture_launch_bound_fusions(),
+      "Capture sequences of loop fusions that are estimated to be dominated "
+      "by kernel launch overhead as cuda graphs, even if they are shorter "
+      "than xla_gpu_graph_min_graph_size."));
   flag_list->push_back(
       tsl::Flag("xla_gpu_graph_enable_concurrent_region",
                 bool_setter_for(
@@ -1525,6 +1760,12 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       "Set the command buffer trace cache size, increasing the cache size may "
       "sometimes reduces the chances of doing command buffer tracing for "
       "updating command buffer instance."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_command_buffer_cache_size",
+      int64_setter_for(&DebugOptions::set_xla_gpu_command_buffer_cache_size),
+      debug_options->xla_gpu_command_buffer_cache_size(),
+      "The number of command buffers per command buffer thunk cached for "
+      "previously seen buffer allocation addresses. Zero disables the cache."));
   flag_list->push_back(
       tsl::Flag("xla_dump_disable_metadata",
                 bool_setter_for(&DebugOptions::set_xla_dump_disable_metadata),
@@ -2292,6 +2533,19 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
       bool_setter_for(&DebugOptions::set_xla_hlo_pass_fix_detect_cycles),
       debug_options->xla_hlo_pass_fix_detect_cycles(),
       "Perform hash-based cycle detection in fixed-point loops."));
+  flag_list->push_back(tsl::Flag(
+      "xla_auto_donate_input_buffers",
+      bool_setter_for(&DebugOptions::set_xla_auto_donate_input_buffers),
+      debug_options->xla_auto_donate_input_buffers(),
+      "Treat every entry parameter as a buffer donor, so that parameters can "
+      "alias outputs of the same size. Callers must not use argument buffers "
+      "after execution."));
+  flag_list->push_back(tsl::Flag(
+      "xla_report_missed_buffer_donation",
+      bool_setter_for(&DebugOptions::set_xla_report_missed_buffer_donation),
+      debug_options->xla_report_missed_buffer_donation(),
+      "Log a warning listing entry parameters that could alias an output if "
+      "they were donated."));
   flag_list->push_back(tsl::Flag(
       "xla_gpu_experimental_enable_sync_collective_combining",
       bool_setter_for(
@@ -2299,6 +2553,15 @@ void MakeDebugOptionsFlags(std::vector<tsl::Flag>* flag_list,
               set_xla_gpu_experimental_enable_sync_collective_combining),
       debug_options->xla_gpu_experimental_enable_sync_collective_combining(),
       "Enable sync collective combining."));
+  flag_list->push_back(tsl::Flag(
+      "xla_gpu_experimental_enable_cost_model_combiner_threshold",
+      bool_setter_for(
+          &DebugOptions::
+              set_xla_gpu_experimental_enable_cost_model_combiner_threshold),
+      debug_options
+          ->xla_gpu_experimental_enable_cost_model_combiner_threshold(),
+      "Pick the all-reduce combiner threshold from the collective performance "
+      "model."));
   flag_list->push_back(tsl::Flag(
       "xla_allow_get_default_platform",
       bool_setter_for(&DebugOptions::set_xla_allow_get_default_platform),
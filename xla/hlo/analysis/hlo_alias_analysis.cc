@@ -325,9 +325,8 @@ std::vector<const HloBuffer*> HloAliasAnalysis::ComputeBuffersAt(
 absl::Status HloAliasAnalysis::Verify() const {
   // Verify consistency between the value_to_buffer_ map and
   // HloBuffer::values().
-  for (const auto& pair : value_to_buffer_) {
-    const HloValue* value = pair.first;
-    const HloBuffer& buffer = *pair.second;
+  for (const HloValue* value : dataflow_analysis_->values()) {
+    const HloBuffer& buffer = GetBufferContainingValue(*value);
     TF_RET_CHECK(absl::c_linear_search(buffer.values(), value));
   }
 
@@ -399,17 +398,23 @@ absl::StatusOr<std::unique_ptr<HloAliasAnalysis>> HloAliasAnalysis::Run(
                                                /*bitcast_defines_value=*/false,
                                                can_share_buffer));
 
-  size_t num_values = alias_analysis->dataflow_analysis_->values().size();
+  const std::vector<HloValue*>& values =
+      alias_analysis->dataflow_analysis_->values();
   alias_analysis->buffers_ = CreateBuffers(alias_analysis->dataflow_analysis());
-  alias_analysis->value_to_buffer_.reserve(num_values);
+  // Values are sorted by id, and ids are dense up to a few deleted values.
+  alias_analysis->value_to_buffer_.resize(
+      values.empty() ? 0 : values.back()->id() + 1, nullptr);
 
+  size_t num_mapped_values = 0;
   for (HloBuffer& buffer : alias_analysis->buffers_) {
     for (const HloValue* value : buffer.values()) {
-      alias_analysis->value_to_buffer_[value] = &buffer;
+      HloBuffer*& value_buffer = alias_analysis->value_to_buffer_[value->id()];
+      num_mapped_values += value_buffer == nullptr;
+      value_buffer = &buffer;
     }
   }
 
-  CHECK_EQ(alias_analysis->value_to_buffer_.size(), num_values);
+  CHECK_EQ(num_mapped_values, values.size());
   TF_DCHECK_OK(alias_analysis->Verify());
 
   HloInstruction* root = module->entry_computation()->root_instruction();
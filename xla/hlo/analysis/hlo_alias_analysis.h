@@ -21,7 +21,6 @@ limitations under the License.
 #include <vector>
 
 #include "absl/algorithm/container.h"
-#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -49,10 +48,10 @@ class HloAliasAnalysis {
 
   // Return the buffer containing the given value.
   const HloBuffer& GetBufferContainingValue(const HloValue& value) const {
-    return *value_to_buffer_.at(&value);
+    return *value_to_buffer_.at(value.id());
   }
   HloBuffer& GetBufferContainingValue(const HloValue& value) {
-    return *value_to_buffer_.at(&value);
+    return *value_to_buffer_.at(value.id());
   }
 
   // Return the HloBuffer with the given ID.
@@ -115,8 +114,8 @@ class HloAliasAnalysis {
   // The underlying dataflow analysis used by this alias analysis.
   std::unique_ptr<HloDataflowAnalysis> dataflow_analysis_;
 
-  // A map indicating which buffer a value is contained in.
-  absl::flat_hash_map<const HloValue*, HloBuffer*> value_to_buffer_;
+  // The buffer each value is contained in, indexed by HloValue::Id.
+  std::vector<HloBuffer*> value_to_buffer_;
 
   // A lazily constructed vector containing all HloBuffers sorted by
   // HloBuffer::Id.
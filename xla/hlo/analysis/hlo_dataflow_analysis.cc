@@ -330,14 +330,13 @@ HloValue* HloDataflowAnalysis::NewHloValue(HloInstruction* instruction,
                                            const ShapeIndex& index,
                                            bool is_phi) {
   const int64_t value_id = next_value_id_++;
-  auto result =
-      values_.insert({value_id, std::make_unique<HloValue>(
-                                    value_id, instruction, index, is_phi)});
-  CHECK(result.second);
+  CHECK_EQ(value_id, values_.size());
+  values_.push_back(
+      std::make_unique<HloValue>(value_id, instruction, index, is_phi));
 
-  VLOG(4) << "NewHloValue = " << result.first->second->ToShortString();
+  VLOG(4) << "NewHloValue = " << values_.back()->ToShortString();
 
-  return result.first->second.get();
+  return values_.back().get();
 }
 
 void HloDataflowAnalysis::MarkValueForDeletion(HloValue::Id value_id) {
@@ -370,7 +369,7 @@ void HloDataflowAnalysis::DeleteMarkedValues() {
 #endif
 
   for (HloValue::Id value_id : id_set) {
-    values_.erase(value_id);
+    values_[value_id].reset();
   }
   value_ids_to_delete_.clear();
 }
@@ -535,13 +534,17 @@ bool HloDataflowAnalysis::Phi(
 }
 
 const HloValue& HloDataflowAnalysis::GetValue(HloValue::Id value_id) const {
-  DCHECK(values_.contains(value_id)) << "Value not found: " << value_id;
-  return *values_.find(value_id)->second;
+  DCHECK(value_id >= 0 && value_id < values_.size() &&
+         values_[value_id] != nullptr)
+      << "Value not found: " << value_id;
+  return *values_[value_id];
 }
 
 HloValue& HloDataflowAnalysis::GetValue(HloValue::Id value_id) {
-  DCHECK(values_.contains(value_id)) << "Value not found: " << value_id;
-  return *values_.find(value_id)->second;
+  DCHECK(value_id >= 0 && value_id < values_.size() &&
+         values_[value_id] != nullptr)
+      << "Value not found: " << value_id;
+  return *values_[value_id];
 }
 
 HloValueSet HloDataflowAnalysis::GetFlattenedValueSet(
@@ -1749,18 +1752,16 @@ absl::StatusOr<std::unique_ptr<HloDataflowAnalysis>> HloDataflowAnalysis::Run(
       }
     }
   }
-  for (auto& pair : dataflow_analysis->values_) {
-    HloValue::Id value_id = pair.first;
-    HloValue& value = *pair.second;
-    value.SetPositions(value_positions[value_id]);
-  }
-
-  // Construct vector of values.
+  // Set the positions and construct the vector of values, which is sorted by
+  // id because values_ is indexed by id.
   dataflow_analysis->values_vector_.reserve(dataflow_analysis->values_.size());
-  for (const auto& pair : dataflow_analysis->values_) {
-    dataflow_analysis->values_vector_.push_back(pair.second.get());
+  for (std::unique_ptr<HloValue>& value : dataflow_analysis->values_) {
+    if (value == nullptr) {
+      continue;
+    }
+    value->SetPositions(value_positions[value->id()]);
+    dataflow_analysis->values_vector_.push_back(value.get());
   }
-  absl::c_sort(dataflow_analysis->values_vector_, HloValue::IdLessThan);
 
   TF_DCHECK_OK(dataflow_analysis->Verify());
 
@@ -179,7 +179,7 @@ class HloDataflowAnalysis {
   HloValue& GetValue(HloValue::Id value_id);
 
   // Returns the total number of HloValues.
-  int64_t value_count() const { return values_.size(); }
+  int64_t value_count() const { return values_vector_.size(); }
 
   // Returns a vector of all HloValues stabily sorted by HloValue::Id.
   const std::vector<HloValue*>& values() const { return values_vector_; }
@@ -351,10 +351,11 @@ class HloDataflowAnalysis {
 
   std::unique_ptr<CallGraph> call_graph_;
 
-  // The map of all HloValues in the module. We pass around pointers to the
-  // mapped HloValues, so the underlying container must keep them valid despite
-  // mutations touching other map entries.
-  absl::flat_hash_map<HloValue::Id, std::unique_ptr<HloValue>> values_;
+  // All HloValues in the module, indexed by HloValue::Id. Ids are assigned
+  // densely, and entries of deleted values are null. We pass around pointers
+  // to the HloValues, so they are individually allocated to stay valid while
+  // the vector grows.
+  std::vector<std::unique_ptr<HloValue>> values_;
 
   // A map from instruction to InstructionValueSet.
   absl::flat_hash_map<const HloInstruction*,
@@ -21,6 +21,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/functional/function_ref.h"
 #include "absl/types/span.h"
@@ -148,13 +149,23 @@ std::unique_ptr<HloReachabilityMap> HloReachabilityMap::Build(
 void HloReachabilityMap::UpdateReachabilityThroughInstruction(
     const HloInstruction* instruction) {
   std::queue<const HloInstruction*> worklist;
-  worklist.push(instruction);
+  // Instructions currently in the worklist. An instruction reached through
+  // several changed predecessors only needs to be recomputed once, as long as
+  // it hasn't been popped yet.
+  absl::flat_hash_set<const HloInstruction*> in_worklist;
+  auto enqueue = [&](const HloInstruction* item) {
+    if (in_worklist.insert(item).second) {
+      worklist.push(item);
+    }
+  };
+  enqueue(instruction);
 
   std::vector<HloInstruction*> inputs;
 
   while (!worklist.empty()) {
     const HloInstruction* item = worklist.front();
     worklist.pop();
+    in_worklist.erase(item);
 
     inputs.assign(item->operands().begin(), item->operands().end());
     inputs.insert(inputs.end(), item->control_predecessors().begin(),
@@ -163,10 +174,10 @@ void HloReachabilityMap::UpdateReachabilityThroughInstruction(
     if (SetReachabilityToUnion(inputs, item)) {
       // Add immediate successors to worklist.
       for (const HloInstruction* user : item->users()) {
-        worklist.push(user);
+        enqueue(user);
       }
       for (const HloInstruction* succ : item->control_successors()) {
-        worklist.push(succ);
+        enqueue(succ);
       }
     }
   }
@@ -1840,6 +1840,68 @@ IndexingMap ComposeIndexingMaps(const IndexingMap& first,
   return composed_indexing_map;
 }
 
+bool IndexingMapCache::Simplify(
+    IndexingMap& map,
+    IndexingMap::SimplifyPointDimensions simplify_point_dimensions) {
+  SimplifyKey key(map, map.IsKnownEmpty(), simplify_point_dimensions);
+  if (auto it = simplified_.find(key); it != simplified_.end()) {
+    ++hits_;
+    const auto& [simplified_map, was_simplified] = it->second;
+    IndexingMap result = simplified_map;
+    CopyVariableNames(map.dim_vars_, result.dim_vars_);
+    CopyVariableNames(map.range_vars_, result.range_vars_);
+    CopyVariableNames(map.rt_vars_, result.rt_vars_);
+    map = std::move(result);
+    return was_simplified;
+  }
+  ++misses_;
+  bool was_simplified = map.Simplify(simplify_point_dimensions);
+  if (simplified_.size() >= max_entries_) {
+    simplified_.clear();
+  }
+  simplified_.try_emplace(std::move(key), map, was_simplified);
+  return was_simplified;
+}
+
+IndexingMap IndexingMapCache::Compose(const IndexingMap& first,
+                                      const IndexingMap& second) {
+  ComposeKey key(first, second);
+  if (auto it = composed_.find(key); it != composed_.end()) {
+    ++hits_;
+    IndexingMap result = it->second;
+    if (result.IsUndefined()) {
+      return result;
+    }
+    // See ComposeIndexingMaps for the order of the composed variables.
+    CopyVariableNames(first.dim_vars_, result.dim_vars_);
+    std::vector<IndexingMap::Variable> range_vars = second.range_vars_;
+    range_vars.insert(range_vars.end(), first.range_vars_.begin(),
+                      first.range_vars_.end());
+    CopyVariableNames(range_vars, result.range_vars_);
+    std::vector<IndexingMap::Variable> rt_vars = second.rt_vars_;
+    rt_vars.insert(rt_vars.end(), first.rt_vars_.begin(),
+                   first.rt_vars_.end());
+    CopyVariableNames(rt_vars, result.rt_vars_);
+    return result;
+  }
+  ++misses_;
+  IndexingMap composed = ComposeIndexingMaps(first, second);
+  if (composed_.size() >= max_entries_) {
+    composed_.clear();
+  }
+  composed_.try_emplace(std::move(key), composed);
+  return composed;
+}
+
+void IndexingMapCache::CopyVariableNames(
+    absl::Span<const IndexingMap::Variable> from,
+    std::vector<IndexingMap::Variable>& to) {
+  CHECK_EQ(from.size(), to.size());
+  for (auto [from_var, to_var] : llvm::zip(from, to)) {
+    to_var.name = from_var.name;
+  }
+}
+
 bool IndexingMap::RescaleSymbols() {
   MergeModConstraints();
 
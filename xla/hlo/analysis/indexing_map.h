@@ -22,9 +22,11 @@ limitations under the License.
 #include <optional>
 #include <ostream>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "llvm/ADT/DenseMap.h"
@@ -386,6 +388,8 @@ class IndexingMap {
   IndexingMap ConvertSymbolsToDimensions() const;
 
  private:
+  friend class IndexingMapCache;
+
   IndexingMap() = default;
 
   // Merges "mod" constraints for the same AffineExpr.
@@ -477,6 +481,51 @@ H AbslHashValue(H h, const IndexingMap& indexing_map) {
   return h;
 }
 
+// Memoizes IndexingMap simplification and composition.
+//
+// Fusion and tiling analyses simplify and compose structurally identical maps
+// many times, and simplification (range evaluation and constraint
+// propagation) dominates their cost. Cached results are equal to the result of
+// the uncached operation, with variable names taken from the arguments.
+//
+// The cache holds affine expressions, so it must be used with a single
+// MLIRContext and must not outlive it. It is cleared once it holds more than
+// `max_entries` results. Not thread-safe.
+class IndexingMapCache {
+ public:
+  explicit IndexingMapCache(size_t max_entries = 4096)
+      : max_entries_(max_entries) {}
+
+  // Same as `map.Simplify(simplify_point_dimensions)`.
+  bool Simplify(IndexingMap& map,
+                IndexingMap::SimplifyPointDimensions simplify_point_dimensions =
+                    IndexingMap::SimplifyPointDimensions::kReplace);
+
+  // Same as `ComposeIndexingMaps(first, second)`.
+  IndexingMap Compose(const IndexingMap& first, const IndexingMap& second);
+
+  int64_t hits() const { return hits_; }
+  int64_t misses() const { return misses_; }
+
+ private:
+  // Simplification also depends on whether the map is known to be empty,
+  // which is not part of IndexingMap equality.
+  using SimplifyKey =
+      std::tuple<IndexingMap, bool, IndexingMap::SimplifyPointDimensions>;
+  using ComposeKey = std::pair<IndexingMap, IndexingMap>;
+
+  // Copies the names of the variables in `from` to the variables in `to`.
+  static void CopyVariableNames(
+      absl::Span<const IndexingMap::Variable> from,
+      std::vector<IndexingMap::Variable>& to);
+
+  size_t max_entries_;
+  absl::flat_hash_map<SimplifyKey, std::pair<IndexingMap, bool>> simplified_;
+  absl::flat_hash_map<ComposeKey, IndexingMap> composed_;
+  int64_t hits_ = 0;
+  int64_t misses_ = 0;
+};
+
 std::vector<IndexingMap::Variable> DimVarsFromTensorSizes(
     absl::Span<const int64_t> tensor_sizes);
 
@@ -260,6 +260,56 @@ TEST_F(IndexingMapTest, Composition_ProducerAndConsumerHaveConstraints) {
                         )"));
 }
 
+TEST_F(IndexingMapTest, CacheComposeAndSimplify) {
+  IndexingMap producer = Parse(R"(
+     (d0, d1)[s0, s1] -> (d1, d0, s1, s0),
+     domain:
+     d0 in [0, 49],
+     d1 in [0, 59],
+     s0 in [0, 69],
+     s1 in [0, 19],
+     d0 mod 8 in [0, 0],
+     s0 mod 3 in [1, 1]
+  )");
+  IndexingMap consumer = Parse(R"(
+     (d0)[s0] -> (d0, s0),
+     domain:
+     d0 in [0, 9],
+     s0 in [0, 7],
+     d0 + s0 in [0, 20],
+     s0 mod 4 in [0, 0]
+  )");
+
+  IndexingMap expected = ComposeIndexingMaps(consumer, producer);
+  bool expected_simplified = expected.Simplify();
+
+  IndexingMapCache cache;
+  for (int i = 0; i < 2; ++i) {
+    IndexingMap composed = cache.Compose(consumer, producer);
+    EXPECT_EQ(cache.Simplify(composed), expected_simplified);
+    EXPECT_EQ(composed, expected);
+  }
+  EXPECT_EQ(cache.misses(), 2);
+  EXPECT_EQ(cache.hits(), 2);
+}
+
+TEST_F(IndexingMapTest, CacheKeepsVariableNames) {
+  IndexingMap indexing_map = Parse(R"(
+     (d0) -> (d0 floordiv 8),
+     domain:
+     d0 in [0, 7]
+  )");
+  IndexingMap renamed = indexing_map;
+  renamed.RenameDimVar(0, "thread_id");
+
+  IndexingMapCache cache;
+  cache.Simplify(indexing_map);
+  cache.Simplify(renamed);
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_EQ(renamed, indexing_map);
+  EXPECT_EQ(renamed.GetDimVar(0).name, "thread_id");
+}
+
 TEST_F(IndexingMapTest, Composition_RTVar) {
   std::vector<IndexingMap::Variable> rt_vars{
       IndexingMap::Variable{Interval{0, 0}},
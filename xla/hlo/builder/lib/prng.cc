@@ -433,6 +433,91 @@ std::pair<Philox4x32State, XlaOp> GeneratePhiloxBits(int64_t num_elems,
   return std::make_pair(outputs, new_state);
 }
 
+// Returns the row-major linear index of every element of `shape` as U64.
+XlaOp LinearIndex(XlaBuilder* builder, const Shape& shape) {
+  Shape index_shape = ShapeUtil::MakeShape(U64, shape.dimensions());
+  XlaOp index = Broadcast(ConstantR0<uint64_t>(builder, 0), shape.dimensions());
+  uint64_t stride = 1;
+  for (int64_t i = shape.dimensions_size() - 1; i >= 0; --i) {
+    index = index + Iota(builder, index_shape, i) *
+                        ConstantR0<uint64_t>(builder, stride);
+    stride *= shape.dimensions(i);
+  }
+  return index;
+}
+
+// Computes the Philox block of the counter `state + block` for every element
+// of `shape`, where `block` is the linear index of the element divided by
+// `1 << log2_elems_per_block`. Returns the block and the index of the element
+// within the block.
+std::pair<Philox4x32State, XlaOp> GeneratePhiloxBlocksElementwise(
+    XlaOp initial_state, Philox4x32Key key, const Shape& shape,
+    int64_t log2_elems_per_block) {
+  XlaBuilder* builder = initial_state.builder();
+  XlaOp index = LinearIndex(builder, shape);
+  XlaOp block = ShiftRightLogical(
+      index, ConstantR0<uint64_t>(builder, log2_elems_per_block));
+  XlaOp lane = And(index, ConstantR0<uint64_t>(
+                              builder, (1 << log2_elems_per_block) - 1));
+
+  auto state_u128 = Uint128FromOp(initial_state);
+  auto inputs = Uint128ToUint32s(
+      Uint128AddUint64(state_u128, block, shape.dimensions()));
+  return std::make_pair(Philox4x32(inputs, key), lane);
+}
+
+// Returns the state of the Philox generator after generating `num_blocks`
+// blocks of 128 random bits.
+XlaOp PhiloxUpdatedState(XlaOp initial_state, int64_t num_blocks) {
+  return Uint128ToOp(Uint128AddUint64(
+      Uint128FromOp(initial_state),
+      ConstantR0<uint64_t>(initial_state.builder(), num_blocks)));
+}
+
+// Same as PhiloxRngBit32, but every element computes the Philox block it
+// belongs to and selects its 32 bits from it. This generates exactly the same
+// bits, and is a purely elementwise computation that can be fused into the
+// consumers of the random bits, at the cost of computing every Philox block
+// four times.
+RngOutput PhiloxRngBit32Elementwise(XlaOp op_key, XlaOp initial_state,
+                                    const Shape& shape) {
+  XlaBuilder* builder = op_key.builder();
+  const int64_t num_elems = ShapeUtil::ElementsIn(shape);
+
+  Philox4x32Key key = Uint64ToUint32s(op_key);
+  Philox4x32State bits;
+  XlaOp lane;
+  std::tie(bits, lane) = GeneratePhiloxBlocksElementwise(
+      initial_state, key, shape, /*log2_elems_per_block=*/2);
+  auto lane_is = [&](uint64_t i) {
+    return Eq(lane, ConstantR0<uint64_t>(builder, i));
+  };
+  XlaOp numbers =
+      Select(lane_is(0), bits[0],
+             Select(lane_is(1), bits[1], Select(lane_is(2), bits[2], bits[3])));
+  return {numbers, PhiloxUpdatedState(initial_state,
+                                      CeilOfRatio<int64_t>(num_elems, 4))};
+}
+
+// Same as PhiloxRngBit64, but computed elementwise like
+// PhiloxRngBit32Elementwise.
+RngOutput PhiloxRngBit64Elementwise(XlaOp op_key, XlaOp initial_state,
+                                    const Shape& shape) {
+  XlaBuilder* builder = op_key.builder();
+  const int64_t num_elems = ShapeUtil::ElementsIn(shape);
+
+  Philox4x32Key key = Uint64ToUint32s(op_key);
+  Philox4x32State bits32;
+  XlaOp lane;
+  std::tie(bits32, lane) = GeneratePhiloxBlocksElementwise(
+      initial_state, key, shape, /*log2_elems_per_block=*/1);
+  XlaOp numbers = Select(Eq(lane, ConstantR0<uint64_t>(builder, 0)),
+                         Uint32sToUint64({bits32[0], bits32[1]}),
+                         Uint32sToUint64({bits32[2], bits32[3]}));
+  return {numbers, PhiloxUpdatedState(initial_state,
+                                      CeilOfRatio<int64_t>(num_elems, 2))};
+}
+
 // Generates an array of primitive type U32 with the given shape containing
 // random bits generated by the Philox algorithm. Returns the array and the new
 // state of the random number generator.
@@ -464,13 +549,15 @@ RngOutput PhiloxRngBit32(XlaOp op_key, XlaOp initial_state,
 // random bits generated by the Philox algorithm. Returns the array and the new
 // state of the random number generator.
 RngOutput PhiloxRngBitNarrow(XlaOp op_key, XlaOp initial_state,
-                             const Shape& shape) {
+                             const Shape& shape, bool elementwise) {
   // We use PhiloxRngBit32 and throw away the upper 16 bits here, to align with
   // the non-XLA kernels.
   // TODO(b/256713018): Use a better approach to not waste the upper 16 bits.
   auto new_shape = shape;
   new_shape.set_element_type(U32);
-  auto output = PhiloxRngBit32(op_key, initial_state, new_shape);
+  auto output =
+      elementwise ? PhiloxRngBit32Elementwise(op_key, initial_state, new_shape)
+                  : PhiloxRngBit32(op_key, initial_state, new_shape);
   output.value = ConvertElementType(
       output.value, primitive_util::UnsignedIntegralTypeForBitWidth(
                         primitive_util::BitWidth(shape.element_type())));
@@ -639,8 +726,8 @@ RngOutput ThreeFryBitGenerator(XlaOp key, XlaOp initial_state,
       type);
 }
 
-RngOutput PhiloxBitGenerator(XlaOp key, XlaOp initial_state,
-                             const Shape& shape) {
+static RngOutput PhiloxBitGeneratorImpl(XlaOp key, XlaOp initial_state,
+                                        const Shape& shape, bool elementwise) {
   PrimitiveType type = shape.element_type();
   return primitive_util::PrimitiveTypeSwitch<RngOutput>(
       [&](auto primitive_type_constant) -> RngOutput {
@@ -649,13 +736,17 @@ RngOutput PhiloxBitGenerator(XlaOp key, XlaOp initial_state,
                       primitive_type_constant != PRED) {
           const int kBits = primitive_util::BitWidth(primitive_type_constant);
           if (kBits < 32) {
-            return PhiloxRngBitNarrow(key, initial_state, shape);
+            return PhiloxRngBitNarrow(key, initial_state, shape, elementwise);
           }
           if (kBits == 32) {
-            return PhiloxRngBit32(key, initial_state, shape);
+            return elementwise
+                       ? PhiloxRngBit32Elementwise(key, initial_state, shape)
+                       : PhiloxRngBit32(key, initial_state, shape);
           }
           if (kBits == 64) {
-            return PhiloxRngBit64(key, initial_state, shape);
+            return elementwise
+                       ? PhiloxRngBit64Elementwise(key, initial_state, shape)
+                       : PhiloxRngBit64(key, initial_state, shape);
           }
         }
         return {
@@ -668,6 +759,18 @@ RngOutput PhiloxBitGenerator(XlaOp key, XlaOp initial_state,
       type);
 }
 
+RngOutput PhiloxBitGenerator(XlaOp key, XlaOp initial_state,
+                             const Shape& shape) {
+  return PhiloxBitGeneratorImpl(key, initial_state, shape,
+                                /*elementwise=*/false);
+}
+
+RngOutput PhiloxElementwiseBitGenerator(XlaOp key, XlaOp initial_state,
+                                        const Shape& shape) {
+  return PhiloxBitGeneratorImpl(key, initial_state, shape,
+                                /*elementwise=*/true);
+}
+
 std::pair<XlaOp, XlaOp> ScramblePhiloxKey(XlaOp key) {
   Philox4x32Key pkey = Uint64ToUint32s(key);
   auto state_key = ScramblePhiloxKey(pkey);
@@ -64,6 +64,14 @@ RngOutput ThreeFryBitGenerator(XlaOp key, XlaOp initial_state,
 //   . The authors recommend the 10-round variant, and TensorFlow also uses it.
 RngOutput PhiloxBitGenerator(XlaOp key, XlaOp initial_state,
                              const Shape& shape);
+
+// Generates exactly the same bits as PhiloxBitGenerator, but every element
+// computes the Philox block it belongs to on its own. The result is a purely
+// elementwise function of the element index that backends can fuse into the
+// consumers of the random bits, instead of materializing them in memory.
+RngOutput PhiloxElementwiseBitGenerator(XlaOp key, XlaOp initial_state,
+                                        const Shape& shape);
+
 // Returns a scrambled pair of (state, key) from a single key.
 std::pair<XlaOp, XlaOp> ScramblePhiloxKey(XlaOp key);
 
@@ -20,11 +20,13 @@ limitations under the License.
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "xla/hlo/builder/lib/arithmetic.h"
 #include "xla/hlo/builder/lib/constants.h"
 #include "xla/hlo/builder/xla_builder.h"
 #include "xla/hlo/testlib/test.h"
 #include "xla/primitive_util.h"
 #include "xla/shape.h"
+#include "xla/shape_util.h"
 #include "xla/tests/client_library_test_base.h"
 #include "xla/tests/test_macros.h"
 #include "xla/xla_data.pb.h"
@@ -92,5 +94,35 @@ XLA_TEST_F(PrngTest, RandomBitsToUniformFloatingPointInvalidArguments) {
                                                                  1.0f);
 }
 
+// Checks that the elementwise Philox generator generates exactly the same bits
+// and state as the default one.
+class PhiloxElementwiseBitGeneratorTest
+    : public PrngTest,
+      public ::testing::WithParamInterface<Shape> {};
+
+XLA_TEST_P(PhiloxElementwiseBitGeneratorTest, GeneratesSameBits) {
+  const Shape& shape = GetParam();
+
+  XlaBuilder builder("philox_elementwise_bit_generator");
+  XlaOp key = ConstantR0<uint64_t>(&builder, 0x1234567890abcdef);
+  XlaOp state = ConstantR1<uint64_t>(
+      &builder, {0xfffffffffffffff0, 0x0123456789abcdef});
+
+  RngOutput expected = PhiloxBitGenerator(key, state, shape);
+  RngOutput output = PhiloxElementwiseBitGenerator(key, state, shape);
+  And(Not(Any(Ne(expected.value, output.value))),
+      Not(Any(Ne(expected.state, output.state))));
+
+  ComputeAndCompareR0<bool>(&builder, /*expected=*/true, {});
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    PhiloxElementwiseBitGeneratorTests, PhiloxElementwiseBitGeneratorTest,
+    ::testing::Values(ShapeUtil::MakeShape(U32, {}),
+                      ShapeUtil::MakeShape(U32, {3, 5}),
+                      ShapeUtil::MakeShape(U16, {2, 3, 7}),
+                      ShapeUtil::MakeShape(U64, {7}),
+                      ShapeUtil::MakeShape(F64, {4, 3})));
+
 }  // namespace
 }  // namespace xla
@@ -3244,6 +3244,25 @@ TEST_P(HloEvaluatorBf16Test, SetAndGetNestedTuples) {
   EXPECT_TRUE(LiteralTestUtil::Equal(expected, result));
 }
 
+TEST_F(HloEvaluatorTest, Iota) {
+  const char* hlo_text = R"(
+HloModule Iota
+
+ENTRY main {
+  iota0 = s32[2,3] iota(), iota_dimension=0
+  iota1 = f32[2,3] iota(), iota_dimension=1
+  ROOT tuple = (s32[2,3], f32[2,3]) tuple(iota0, iota1)
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(m_, ParseAndReturnVerifiedModule(hlo_text));
+  TF_ASSERT_OK_AND_ASSIGN(Literal result, Evaluate());
+  auto expected_s32 = LiteralUtil::CreateR2<int32_t>({{0, 0, 0}, {1, 1, 1}});
+  auto expected_f32 =
+      LiteralUtil::CreateR2<float>({{0.0f, 1.0f, 2.0f}, {0.0f, 1.0f, 2.0f}});
+  auto expected = LiteralUtil::MakeTuple({&expected_s32, &expected_f32});
+  EXPECT_TRUE(LiteralTestUtil::Equal(expected, result));
+}
+
 TEST_P(HloEvaluatorBf16Test, Reverse) {
   HloComputation::Builder b(TestName());
 
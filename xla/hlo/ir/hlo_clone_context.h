@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_HLO_IR_HLO_CLONE_CONTEXT_H_
 #define XLA_HLO_IR_HLO_CLONE_CONTEXT_H_
 
+#include <cstdint>
 #include <string>
 
 #include "absl/container/flat_hash_map.h"
@@ -41,6 +42,13 @@ class HloCloneContext {
 
   const std::string& suffix() const { return suffix_; }
 
+  // Reserves space for mapping the given number of instructions and
+  // computations, to avoid rehashing when cloning large modules.
+  void Reserve(int64_t num_instructions, int64_t num_computations) {
+    instructions_.reserve(num_instructions);
+    computations_.reserve(num_computations);
+  }
+
   void MapInstruction(const HloInstruction* old_instruction,
                       HloInstruction* new_instruction) {
     instructions_[old_instruction] = new_instruction;
@@ -156,6 +156,7 @@ HloComputation::HloComputation(
       instruction_count_(0),
       name_(NameUniquer::GetSanitizedName(name)) {
   param_instructions_.resize(parameter_count, nullptr);
+  instructions_.reserve(instructions->size());
   bool root_found = false;
   for (auto& instruction : *instructions) {
     if (instruction->opcode() == HloOpcode::kParameter) {
@@ -1156,15 +1157,38 @@ HloComputation::CreateFromProto(
     const HloComputationProto& proto,
     const absl::flat_hash_map<int64_t, HloComputation*>& computation_map,
     bool prohibit_empty_literal) {
+  return CreateFromProtoImpl(proto, computation_map, prohibit_empty_literal,
+                             /*release_literals=*/nullptr);
+}
+
+/* static */ absl::StatusOr<std::unique_ptr<HloComputation>>
+HloComputation::CreateFromProto(
+    HloComputationProto&& proto,
+    const absl::flat_hash_map<int64_t, HloComputation*>& computation_map,
+    bool prohibit_empty_literal) {
+  return CreateFromProtoImpl(proto, computation_map, prohibit_empty_literal,
+                             /*release_literals=*/&proto);
+}
+
+/* static */ absl::StatusOr<std::unique_ptr<HloComputation>>
+HloComputation::CreateFromProtoImpl(
+    const HloComputationProto& proto,
+    const absl::flat_hash_map<int64_t, HloComputation*>& computation_map,
+    bool prohibit_empty_literal, HloComputationProto* release_literals) {
+  DCHECK(release_literals == nullptr || release_literals == &proto);
   absl::flat_hash_map<int64_t, HloInstruction*> instruction_map;
   absl::flat_hash_map<HloInstruction*, int64_t> to_proto_id;
   std::vector<std::unique_ptr<HloInstruction>> instructions;
   int64_t parameter_count = 0;
-  for (const HloInstructionProto& instruction_proto : proto.instructions()) {
+  for (int i = 0; i < proto.instructions_size(); ++i) {
+    const HloInstructionProto& instruction_proto = proto.instructions(i);
     TF_ASSIGN_OR_RETURN(std::unique_ptr<HloInstruction> instruction,
                         HloInstruction::CreateFromProto(
                             instruction_proto, instruction_map, computation_map,
                             prohibit_empty_literal));
+    if (release_literals != nullptr) {
+      release_literals->mutable_instructions(i)->clear_literal();
+    }
     if (instruction->opcode() == HloOpcode::kParameter) {
       parameter_count++;
     }
@@ -1859,14 +1883,16 @@ std::unique_ptr<HloComputation> HloComputation::CloneInContext(
   }
 
   std::vector<std::unique_ptr<HloInstruction>> instructions;
+  instructions.reserve(extra_parameters.size() + postorder.size());
   // First add the extra parameters to 'instructions'.
   for (const auto& instr : extra_parameters) {
     CHECK_EQ(instr->opcode(), HloOpcode::kParameter)
         << "Only parameter instructions are allowed in 'extra_parameters'";
     instructions.emplace_back(instr->Clone());
   }
+  std::vector<HloInstruction*> new_operands;
   for (auto instr : postorder) {
-    std::vector<HloInstruction*> new_operands;
+    new_operands.clear();
     for (auto operand : instr->operands()) {
       auto replaced_operand = replace(operand);
       CHECK_NE(replaced_operand, nullptr)
@@ -415,6 +415,14 @@ class HloComputation {
       const absl::flat_hash_map<int64_t, HloComputation*>& computation_map,
       bool prohibit_empty_literal = true);
 
+  // Same as above, but releases the literal of every constant in `proto` as
+  // soon as it has been converted, so that large constants are not held by
+  // both the proto and the computation.
+  static absl::StatusOr<std::unique_ptr<HloComputation>> CreateFromProto(
+      HloComputationProto&& proto,
+      const absl::flat_hash_map<int64_t, HloComputation*>& computation_map,
+      bool prohibit_empty_literal = true);
+
   // Generates a hash value of an HLO computation. Hash considers
   // information on opcode, shape, operands, and typically a root instruction.
   // This function returns the same hash value for equivalent HLO computations,
@@ -994,6 +1002,13 @@ class HloComputation {
       std::vector<std::unique_ptr<HloInstruction>>* instructions,
       HloInstruction* root_instruction);
 
+  // Implements CreateFromProto. If `release_literals` is not null, it must
+  // point to `proto`, and literals are cleared from it once converted.
+  static absl::StatusOr<std::unique_ptr<HloComputation>> CreateFromProtoImpl(
+      const HloComputationProto& proto,
+      const absl::flat_hash_map<int64_t, HloComputation*>& computation_map,
+      bool prohibit_empty_literal, HloComputationProto* release_literals);
+
   // Internal helper for adding instructions.
   HloInstruction* AddInstructionInternal(
       std::unique_ptr<HloInstruction> instruction);
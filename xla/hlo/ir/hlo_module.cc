@@ -598,6 +598,26 @@ absl::StatusOr<std::unique_ptr<HloModule>> HloModule::CreateFromProto(
     const HloModuleProto& proto, const HloModuleConfig& module_config,
     bool prohibit_empty_literal,
     std::unique_ptr<CompilationEnvironments> comp_envs) {
+  return CreateFromProtoImpl(proto, module_config, prohibit_empty_literal,
+                             std::move(comp_envs),
+                             /*release_literals=*/nullptr);
+}
+
+absl::StatusOr<std::unique_ptr<HloModule>> HloModule::CreateFromProto(
+    HloModuleProto&& proto, const HloModuleConfig& module_config,
+    bool prohibit_empty_literal,
+    std::unique_ptr<CompilationEnvironments> comp_envs) {
+  return CreateFromProtoImpl(proto, module_config, prohibit_empty_literal,
+                             std::move(comp_envs),
+                             /*release_literals=*/&proto);
+}
+
+absl::StatusOr<std::unique_ptr<HloModule>> HloModule::CreateFromProtoImpl(
+    const HloModuleProto& proto, const HloModuleConfig& module_config,
+    bool prohibit_empty_literal,
+    std::unique_ptr<CompilationEnvironments> comp_envs,
+    HloModuleProto* release_literals) {
+  DCHECK(release_literals == nullptr || release_literals == &proto);
   VLOG(2) << "CreateFromProto()";
   XLA_VLOG_LINES(3, proto.DebugString());
 
@@ -632,11 +652,22 @@ absl::StatusOr<std::unique_ptr<HloModule>> HloModule::CreateFromProto(
   absl::flat_hash_map<HloComputation*, int64_t> to_proto_id;
   std::vector<std::unique_ptr<HloComputation>> computations;
   HloComputation* entry = nullptr;
-  for (const HloComputationProto& computation_proto : proto.computations()) {
-    TF_ASSIGN_OR_RETURN(
-        std::unique_ptr<HloComputation> computation,
-        HloComputation::CreateFromProto(computation_proto, computation_map,
-                                        prohibit_empty_literal));
+  for (int i = 0; i < proto.computations_size(); ++i) {
+    const HloComputationProto& computation_proto = proto.computations(i);
+    std::unique_ptr<HloComputation> computation;
+    if (release_literals != nullptr) {
+      // Only the literals are released, so `computation_proto` stays valid.
+      TF_ASSIGN_OR_RETURN(
+          computation,
+          HloComputation::CreateFromProto(
+              std::move(*release_literals->mutable_computations(i)),
+              computation_map, prohibit_empty_literal));
+    } else {
+      TF_ASSIGN_OR_RETURN(
+          computation,
+          HloComputation::CreateFromProto(computation_proto, computation_map,
+                                          prohibit_empty_literal));
+    }
     CHECK_NE(computation.get(), nullptr);
     int64_t computation_id = computation_proto.id();
     TF_RET_CHECK(computation_id != -1);
@@ -1194,6 +1225,7 @@ std::unique_ptr<HloModule> HloModule::Clone(
   auto module = CreateModule(suffix, config_in, *this);
 
   HloCloneContext context(module.get(), suffix);
+  context.Reserve(instruction_count(), computation_count());
   if (entry_computation_) {
     auto cloned_computation = entry_computation_->Clone(suffix, &context);
     module->AddEntryComputation(std::move(cloned_computation));
@@ -431,6 +431,13 @@ class HloModule {
       const HloModuleProto& proto, const HloModuleConfig& module_config,
       bool prohibit_empty_literal = true,
       std::unique_ptr<CompilationEnvironments> comp_envs = nullptr);
+  // Same as above, but releases the literals of constants in `proto` as soon
+  // as they are converted, which roughly halves peak memory when loading
+  // modules with large embedded constants.
+  static absl::StatusOr<std::unique_ptr<HloModule>> CreateFromProto(
+      HloModuleProto&& proto, const HloModuleConfig& module_config,
+      bool prohibit_empty_literal = true,
+      std::unique_ptr<CompilationEnvironments> comp_envs = nullptr);
 
   // Convert an HloModule to or from a proto that includes module configuration
   HloModuleProtoWithConfig ToProtoWithConfig() const;
@@ -710,6 +717,14 @@ class HloModule {
       std::unique_ptr<HloComputation> computation, bool is_entry,
       bool uniquify_identifiers, bool preserve_entry_layouts);
 
+  // Implements CreateFromProto. If `release_literals` is not null, it must
+  // point to `proto`, and literals are cleared from it once converted.
+  static absl::StatusOr<std::unique_ptr<HloModule>> CreateFromProtoImpl(
+      const HloModuleProto& proto, const HloModuleConfig& module_config,
+      bool prohibit_empty_literal,
+      std::unique_ptr<CompilationEnvironments> comp_envs,
+      HloModuleProto* release_literals);
+
   std::string name_;
 
   // Sharabled copy-on-write instance.
@@ -366,6 +366,11 @@ int64_t IotaTileAssignment::value_at(absl::Span<const int64_t> index) const {
     linear_index *= dims[i];
     linear_index += index[i];
   }
+  return value_at_linear_index(linear_index);
+}
+
+int64_t IotaTileAssignment::value_at_linear_index(int64_t linear_index) const {
+  DCHECK_LT(linear_index, num_elements());
   auto reshape_dims = this->reshape_dims();
   auto transpose_perm = this->transpose_perm();
   absl::InlinedVector<int64_t, 6> reshape_index(reshape_ndims_);
@@ -387,7 +392,23 @@ bool TileAssignment::operator==(const TileAssignment& other) const {
   if (iota_ && other.iota_) {
     return *iota_ == *other.iota_;
   }
-  return array() == other.array();
+  if (dimensions() != other.dimensions()) {
+    return false;
+  }
+  if (array_ && other.array_) {
+    return *array_ == *other.array_;
+  }
+  // One side is an iota tile assignment that is not materialized yet, compare
+  // it with the other side device by device instead of materializing it.
+  const TileAssignment& iota = array_ ? other : *this;
+  const TileAssignment& array = array_ ? *this : other;
+  for (int64_t i = 0, n = num_elements(); i < n; ++i) {
+    if (iota.iota_->value_at_linear_index(i) !=
+        array.value_at_linear_index(i)) {
+      return false;
+    }
+  }
+  return true;
 }
 
 int64_t TileAssignment::operator()(absl::Span<const int64_t> indexes) const {
@@ -493,6 +514,11 @@ std::shared_ptr<Array<int64_t>> TileAssignment::shared_array_clone() const {
   return std::make_shared<Array<int64_t>>(*array_);
 }
 
+int64_t TileAssignment::value_at_linear_index(int64_t linear_index) const {
+  return array_ ? array_->begin()[linear_index]
+                : iota_->value_at_linear_index(linear_index);
+}
+
 void TileAssignment::MaybeMaterializeFullArray() const {
   if (array_ == nullptr) {
     DCHECK(shared_array_ == nullptr);
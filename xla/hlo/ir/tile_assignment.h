@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_HLO_IR_TILE_ASSIGNMENT_H_
 #define XLA_HLO_IR_TILE_ASSIGNMENT_H_
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <functional>
@@ -83,6 +84,9 @@ class IotaTileAssignment {
 
   int64_t value_at(absl::Span<const int64_t> index) const;
 
+  // Returns the device at `linear_index` in the row-major order of dims().
+  int64_t value_at_linear_index(int64_t linear_index) const;
+
   int64_t ndims() const { return ndims_; }
 
   absl::Span<const int64_t> dims() const {
@@ -247,11 +251,17 @@ class TileAssignment {
 
   template <typename H>
   friend H AbslHashValue(H h, const TileAssignment& tile) {
-    // TODO(b/281892190): Ideally hashing a TileAssignment should not force iota
-    // -> full array conversion, but a requirement is that they should have
-    // equivalence. Consider providing a faster hash function for iota tile
-    // assignment.
-    return H::combine(std::move(h), tile.array());
+    // Hashes the dimensions and a bounded sample of devices, which gives equal
+    // hashes for equivalent iota and array formats without materializing the
+    // full array of an iota tile assignment.
+    h = H::combine(std::move(h), tile.dimensions());
+    const int64_t num_elements = tile.num_elements();
+    const int64_t stride =
+        std::max<int64_t>(1, num_elements / kMaxHashedDevices);
+    for (int64_t i = 0; i < num_elements; i += stride) {
+      h = H::combine(std::move(h), tile.value_at_linear_index(i));
+    }
+    return h;
   }
 
  private:
@@ -264,6 +274,13 @@ class TileAssignment {
         shared_array_(std::move(shared_array)),
         array_(shared_array_.get()) {}
 
+  // Maximum number of devices that contribute to the hash of a tile
+  // assignment.
+  static constexpr int64_t kMaxHashedDevices = 64;
+
+  // Returns the device at `linear_index` without materializing the full array.
+  int64_t value_at_linear_index(int64_t linear_index) const;
+
   void MaybeMaterializeFullArray() const;
 
   static const Array<int64_t>* ReplicatedArray() {
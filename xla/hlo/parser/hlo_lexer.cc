@@ -393,8 +393,55 @@ TokKind HloLexer::LexPercent() {
 // int ::=  [-]?[0-9]+
 // negative inf ::= '-inf'
 TokKind HloLexer::LexNumberOrPattern() {
-  absl::string_view consumable = StringViewFromPointers(
-      token_state_.token_start, buf_.data() + buf_.size());
+  auto lex_int = [this]() {
+    auto slice = StringViewFromPointers(token_state_.token_start, current_ptr_);
+    if (absl::SimpleAtoi(slice, &token_state_.int64_val)) {
+      return TokKind::kInt;
+    }
+    uint64_t uint64_val;
+    if (absl::SimpleAtoi(slice, &uint64_val)) {
+      token_state_.int64_val = absl::bit_cast<int64_t>(uint64_val);
+      return TokKind::kInt;
+    }
+    LOG(ERROR) << "Failed to parse int literal: " << slice;
+    return TokKind::kError;
+  };
+
+  // Fast path for plain integers and decimals without an exponent, which make
+  // up the bulk of large constant literals. If the number is followed by a
+  // character that can continue one of the patterns below, fall back to them.
+  const char* end = buf_.data() + buf_.size();
+  const char* ptr = token_state_.token_start;
+  if (ptr < end && *ptr == '-') {
+    ++ptr;
+  }
+  const char* digits_start = ptr;
+  while (ptr < end && absl::ascii_isdigit(*ptr)) {
+    ++ptr;
+  }
+  if (ptr != digits_start) {
+    bool is_decimal = ptr < end && *ptr == '.';
+    if (is_decimal) {
+      ++ptr;
+      while (ptr < end && absl::ascii_isdigit(*ptr)) {
+        ++ptr;
+      }
+    }
+    if (ptr == end || !(absl::ascii_isalnum(*ptr) || *ptr == '.' ||
+                        *ptr == '_' || *ptr == '?')) {
+      current_ptr_ = ptr;
+      if (!is_decimal) {
+        return lex_int();
+      }
+      CHECK(absl::SimpleAtod(
+          StringViewFromPointers(token_state_.token_start, current_ptr_),
+          &token_state_.decimal_val));
+      return TokKind::kDecimal;
+    }
+  }
+
+  absl::string_view consumable =
+      StringViewFromPointers(token_state_.token_start, end);
   static LazyRE2 float_pattern = {
       R"([-]?((\d+|\d+[.]\d*|\d*[.]\d+)([eE][+-]?\d+))|[-]?(\d+[.]\d*|\d*[.]\d+))"};
   if (RE2::Consume(&consumable, *float_pattern)) {
@@ -431,17 +478,7 @@ TokKind HloLexer::LexNumberOrPattern() {
   static LazyRE2 int_pattern = {R"([-]?\d+)"};
   if (RE2::Consume(&consumable, *int_pattern)) {
     current_ptr_ = consumable.data();
-    auto slice = StringViewFromPointers(token_state_.token_start, current_ptr_);
-    if (absl::SimpleAtoi(slice, &token_state_.int64_val)) {
-      return TokKind::kInt;
-    }
-    uint64_t uint64_val;
-    if (absl::SimpleAtoi(slice, &uint64_val)) {
-      token_state_.int64_val = absl::bit_cast<int64_t>(uint64_val);
-      return TokKind::kInt;
-    }
-    LOG(ERROR) << "Failed to parse int literal: " << slice;
-    return TokKind::kError;
+    return lex_int();
   }
 
   static LazyRE2 neg_inf = {"-inf"};
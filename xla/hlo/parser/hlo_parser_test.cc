@@ -46,6 +46,7 @@ limitations under the License.
 #include "xla/hlo/testlib/verified_hlo_module.h"
 #include "xla/layout.h"
 #include "xla/layout_util.h"
+#include "xla/literal.h"
 #include "xla/protobuf_util.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/service/pattern_matcher.h"
@@ -3035,6 +3036,28 @@ ENTRY %SelectScalarS32True.v4 () -> s32[] {
   // but the constant names will not be exactly the same.
 }
 
+TEST_F(HloParserTest, ConstantNumberForms) {
+  const std::string original = R"(HloModule AModule
+ENTRY %constants() -> (f32[6], s32[3]) {
+  %f = f32[6]{0} constant({1, -2.5, 3., 1e2, -0.25, .5})
+  %s = s32[3]{0} constant({7,-8,9})
+  ROOT %tuple = (f32[6]{0}, s32[3]{0}) tuple(%f, %s)
+})";
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(original));
+  const HloInstruction* root = module->entry_computation()->root_instruction();
+  const Literal& f = root->operand(0)->literal();
+  EXPECT_EQ(f.Get<float>({0}), 1.0f);
+  EXPECT_EQ(f.Get<float>({1}), -2.5f);
+  EXPECT_EQ(f.Get<float>({2}), 3.0f);
+  EXPECT_EQ(f.Get<float>({3}), 100.0f);
+  EXPECT_EQ(f.Get<float>({4}), -0.25f);
+  EXPECT_EQ(f.Get<float>({5}), 0.5f);
+  const Literal& s = root->operand(1)->literal();
+  EXPECT_EQ(s.Get<int32_t>({0}), 7);
+  EXPECT_EQ(s.Get<int32_t>({1}), -8);
+  EXPECT_EQ(s.Get<int32_t>({2}), 9);
+}
+
 TEST_F(HloParserTest, ConfigurationField) {
   const std::string original = R"(HloModule AModule
 ENTRY %configuration_test() -> s32[] {
@@ -28,6 +28,7 @@ limitations under the License.
 #include "absl/strings/string_view.h"
 #include "xla/hlo/ir/hlo_module_group.h"
 #include "xla/hlo/pass/hlo_pass_interface.h"
+#include "xla/service/compilation_stats.h"
 #include "xla/service/dump.h"
 #include "xla/service/hlo_graph_dumper.h"
 #include "xla/service/hlo_proto_util.h"
@@ -40,6 +41,7 @@ limitations under the License.
 #include "xla/xla.pb.h"
 #include "tsl/profiler/lib/scoped_annotation.h"
 #include "tsl/profiler/lib/traceme.h"
+#include "tsl/profiler/lib/traceme_encode.h"
 
 namespace xla {
 
@@ -107,6 +109,20 @@ void RecordPassEndMetadata(HloModuleGroup& module_group,
   }
 }
 
+void RecordPassModuleSize(CompilationStats& stats, absl::string_view pass_name,
+                          const HloModule& module) {
+  stats.RecordPassModuleSize(pass_name, module.unique_id(),
+                             module.computation_count(),
+                             module.instruction_count());
+}
+
+void RecordPassModuleSize(CompilationStats& stats, absl::string_view pass_name,
+                          const HloModuleGroup& module_group) {
+  for (const HloModule* module : module_group.modules()) {
+    RecordPassModuleSize(stats, pass_name, *module);
+  }
+}
+
 }  // namespace
 
 template <typename HloT>
@@ -241,8 +257,15 @@ absl::StatusOr<bool> HloPassPipeline::RunPassesInternal(
       TF_RETURN_IF_ERROR(status);
     }
     if (!pass->IsPassPipeline()) {
+      RecordPassModuleSize(*compilation_stats_, pass_name, *hlo);
       compilation_stats_->EndPass(pass_name);
     }
+    traceme.AppendMetadata([&] {
+      return tsl::profiler::TraceMeEncode(
+          {{"module_id", UniqueId(*hlo)},
+           {"changed", static_cast<int>(pass_changed)},
+           {"peak_rss_bytes", GetPeakRssBytes()}});
+    });
   }
   return changed;
 }
@@ -0,0 +1,169 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/activation_offload_annotator.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/memory_annotations.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+
+namespace xla {
+namespace {
+
+using memory_annotations::kMoveToDeviceCustomCallTarget;
+using memory_annotations::kMoveToHostCustomCallTarget;
+
+struct OffloadCandidate {
+  HloInstruction* activation;
+  // Users that are scheduled after the longest stretch without uses.
+  std::vector<HloInstruction*> late_users;
+  int64_t size_in_bytes;
+  int64_t unused_instructions;
+};
+
+// Returns true if `instruction` produces an activation that may be offloaded.
+// Parameters and values that are cheap to rematerialize are not offloaded,
+// and neither are values that are already annotated.
+bool IsOffloadableActivation(const HloInstruction* instruction) {
+  if (!instruction->shape().IsArray() || instruction->user_count() == 0 ||
+      instruction->IsCustomCall(
+          {kMoveToHostCustomCallTarget, kMoveToDeviceCustomCallTarget})) {
+    return false;
+  }
+  switch (instruction->opcode()) {
+    case HloOpcode::kParameter:
+    case HloOpcode::kConstant:
+    case HloOpcode::kIota:
+    case HloOpcode::kBroadcast:
+    case HloOpcode::kBitcast:
+      return false;
+    default:
+      break;
+  }
+  return absl::c_none_of(instruction->users(), [](const HloInstruction* user) {
+    return user->IsCustomCall(kMoveToHostCustomCallTarget) ||
+           user->IsRoot();
+  });
+}
+
+}  // namespace
+
+absl::StatusOr<bool> ActivationOffloadAnnotator::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  HloComputation* computation = module->entry_computation();
+  if (!HloInstruction::IsThreadIncluded(computation->execution_thread(),
+                                        execution_threads)) {
+    return false;
+  }
+
+  std::vector<HloInstruction*> post_order =
+      computation->MakeInstructionPostOrder();
+  absl::flat_hash_map<const HloInstruction*, int64_t> position;
+  position.reserve(post_order.size());
+  for (int64_t i = 0; i < post_order.size(); ++i) {
+    position[post_order[i]] = i;
+  }
+
+  std::vector<OffloadCandidate> candidates;
+  for (HloInstruction* instruction : post_order) {
+    if (!IsOffloadableActivation(instruction)) {
+      continue;
+    }
+    int64_t size_in_bytes = ShapeUtil::ByteSizeOf(instruction->shape());
+    if (size_in_bytes < options_.min_size_in_bytes) {
+      continue;
+    }
+
+    std::vector<HloInstruction*> users(instruction->users().begin(),
+                                       instruction->users().end());
+    absl::c_sort(users, [&](const HloInstruction* a, const HloInstruction* b) {
+      return position.at(a) < position.at(b);
+    });
+
+    // Find the longest stretch of instructions in which the activation is live
+    // but not used.
+    int64_t previous_use = position.at(instruction);
+    int64_t longest_gap = 0;
+    int64_t first_late_user = 0;
+    for (int64_t i = 0; i < users.size(); ++i) {
+      int64_t gap = position.at(users[i]) - previous_use - 1;
+      if (gap > longest_gap) {
+        longest_gap = gap;
+        first_late_user = i;
+      }
+      previous_use = position.at(users[i]);
+    }
+    if (longest_gap < options_.min_unused_instructions) {
+      continue;
+    }
+    candidates.push_back(OffloadCandidate{
+        instruction,
+        std::vector<HloInstruction*>(users.begin() + first_late_user,
+                                     users.end()),
+        size_in_bytes, longest_gap});
+  }
+
+  // Prefer the activations that free the most memory for the longest time.
+  absl::c_stable_sort(candidates, [](const OffloadCandidate& a,
+                                     const OffloadCandidate& b) {
+    return a.size_in_bytes * a.unused_instructions >
+           b.size_in_bytes * b.unused_instructions;
+  });
+
+  bool changed = false;
+  int64_t offloaded_bytes = 0;
+  for (const OffloadCandidate& candidate : candidates) {
+    if (candidate.size_in_bytes >
+        options_.max_offloaded_bytes - offloaded_bytes) {
+      continue;
+    }
+    offloaded_bytes += candidate.size_in_bytes;
+
+    HloInstruction* activation = candidate.activation;
+    VLOG(2) << "Offloading " << activation->name() << " ("
+            << candidate.size_in_bytes << " bytes) across "
+            << candidate.unused_instructions << " instructions";
+    HloInstruction* move_to_host =
+        computation->AddInstruction(HloInstruction::CreateCustomCall(
+            activation->shape(), {activation}, kMoveToHostCustomCallTarget));
+    HloInstruction* move_to_device =
+        computation->AddInstruction(HloInstruction::CreateCustomCall(
+            activation->shape(), {move_to_host},
+            kMoveToDeviceCustomCallTarget));
+    for (HloInstruction* user : candidate.late_users) {
+      TF_RETURN_IF_ERROR(activation->ReplaceUseWith(user, move_to_device));
+    }
+    changed = true;
+  }
+
+  VLOG(1) << "Offloaded " << offloaded_bytes << " bytes of activations";
+  return changed;
+}
+
+}  // namespace xla
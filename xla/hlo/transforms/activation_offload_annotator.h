@@ -0,0 +1,78 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_HLO_TRANSFORMS_ACTIVATION_OFFLOAD_ANNOTATOR_H_
+#define XLA_HLO_TRANSFORMS_ACTIVATION_OFFLOAD_ANNOTATOR_H_
+
+#include <cstdint>
+#include <limits>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+
+namespace xla {
+
+// Automatically annotates long-lived activations of the entry computation for
+// host offloading.
+//
+// An activation is offloaded if it is large, and if there is a long stretch of
+// the computation, measured in instructions of its post order, in which it is
+// not used. That is typically the case for forward pass activations that are
+// only used again by the backward pass. Users after the gap are rewired to
+//
+//   activation -> MoveToHost -> MoveToDevice -> late users
+//
+// while users before the gap keep using the activation directly. Candidates
+// are picked greedily by size times gap length, until the offloaded bytes
+// budget is spent. HostOffloader later turns the annotations into copies to
+// and from host memory, and the scheduler overlaps them with compute.
+//
+// The pass must run before host offload legalization and layout assignment,
+// like user provided annotations.
+class ActivationOffloadAnnotator : public HloModulePass {
+ public:
+  struct Options {
+    // Activations smaller than this are never offloaded.
+    int64_t min_size_in_bytes = 16 * 1024 * 1024;
+
+    // The minimum number of instructions between two consecutive uses of an
+    // activation for it to be offloaded across them.
+    int64_t min_unused_instructions = 64;
+
+    // The maximum total size of the offloaded activations.
+    int64_t max_offloaded_bytes = std::numeric_limits<int64_t>::max();
+  };
+
+  explicit ActivationOffloadAnnotator(Options options) : options_(options) {}
+
+  absl::string_view name() const override {
+    return "activation-offload-annotator";
+  }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  Options options_;
+};
+
+}  // namespace xla
+
+#endif  // XLA_HLO_TRANSFORMS_ACTIVATION_OFFLOAD_ANNOTATOR_H_
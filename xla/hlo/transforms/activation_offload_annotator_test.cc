@@ -0,0 +1,109 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/hlo/transforms/activation_offload_annotator.h"
+
+#include <memory>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
+#include "xla/hlo/testlib/pattern_matcher_gmock.h"
+#include "xla/service/memory_annotations.h"
+#include "xla/service/pattern_matcher.h"
+#include "xla/tsl/platform/statusor.h"
+#include "tsl/platform/status_matchers.h"
+
+namespace xla {
+namespace {
+
+using ::tsl::testing::IsOkAndHolds;
+namespace m = ::xla::match;
+
+using ActivationOffloadAnnotatorTest = HloHardwareIndependentTestBase;
+
+// `a` is used by `b` right away and then only by `f`, after a stretch of four
+// unrelated instructions in post order: c, d, p1 and e.
+constexpr absl::string_view kHloString = R"(
+HloModule module
+
+ENTRY main {
+  p0 = f32[1024] parameter(0)
+  p1 = f32[1024] parameter(1)
+  a = f32[1024] exponential(p0)
+  b = f32[1024] negate(a)
+  c = f32[1024] sine(b)
+  d = f32[1024] cosine(c)
+  e = f32[1024] add(d, p1)
+  f = f32[1024] multiply(e, a)
+  ROOT g = f32[1024] negate(f)
+})";
+
+TEST_F(ActivationOffloadAnnotatorTest, OffloadsActivationAcrossLongGap) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+
+  ActivationOffloadAnnotator::Options options;
+  options.min_size_in_bytes = 4096;
+  options.min_unused_instructions = 3;
+  EXPECT_THAT(ActivationOffloadAnnotator(options).Run(module.get()),
+              IsOkAndHolds(true));
+
+  HloInstruction* a = FindInstruction(module.get(), "a");
+  EXPECT_THAT(FindInstruction(module.get(), "b"),
+              GmockMatch(m::Negate(m::Op().Is(a))));
+  EXPECT_THAT(
+      FindInstruction(module.get(), "f"),
+      GmockMatch(m::Multiply(
+          m::Op(),
+          m::CustomCall({memory_annotations::kMoveToDeviceCustomCallTarget},
+                        m::CustomCall(
+                            {memory_annotations::kMoveToHostCustomCallTarget},
+                            m::Op().Is(a))))));
+}
+
+TEST_F(ActivationOffloadAnnotatorTest, SkipsSmallOrShortLivedActivations) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+
+  ActivationOffloadAnnotator::Options options;
+  options.min_size_in_bytes = 8192;
+  options.min_unused_instructions = 3;
+  EXPECT_THAT(ActivationOffloadAnnotator(options).Run(module.get()),
+              IsOkAndHolds(false));
+
+  options.min_size_in_bytes = 4096;
+  options.min_unused_instructions = 5;
+  EXPECT_THAT(ActivationOffloadAnnotator(options).Run(module.get()),
+              IsOkAndHolds(false));
+}
+
+TEST_F(ActivationOffloadAnnotatorTest, RespectsOffloadedBytesBudget) {
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+
+  ActivationOffloadAnnotator::Options options;
+  options.min_size_in_bytes = 4096;
+  options.min_unused_instructions = 3;
+  options.max_offloaded_bytes = 4095;
+  EXPECT_THAT(ActivationOffloadAnnotator(options).Run(module.get()),
+              IsOkAndHolds(false));
+}
+
+}  // namespace
+}  // namespace xla
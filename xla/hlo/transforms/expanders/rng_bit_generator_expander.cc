@@ -74,8 +74,13 @@ RngBitGeneratorExpander::GetGeneratorComputation(const Shape& data_shape,
                                     data_shape);
       break;
     case RandomAlgorithm::RNG_PHILOX:
-      output = PhiloxBitGenerator(
-          key_op, GetPhiloxStateOp(state_param, state_shape), data_shape);
+      output = elementwise_philox_
+                   ? PhiloxElementwiseBitGenerator(
+                         key_op, GetPhiloxStateOp(state_param, state_shape),
+                         data_shape)
+                   : PhiloxBitGenerator(
+                         key_op, GetPhiloxStateOp(state_param, state_shape),
+                         data_shape);
       output.state = GetPhiloxOutputStateOp(output.state, state_shape);
       break;
     default:
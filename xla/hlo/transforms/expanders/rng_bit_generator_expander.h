@@ -30,8 +30,14 @@ namespace xla {
 
 class RngBitGeneratorExpander : public OpExpanderPass {
  public:
-  explicit RngBitGeneratorExpander(RandomAlgorithm default_algorithm)
-      : default_algorithm_(default_algorithm) {
+  // If `elementwise_philox` is true, Philox random bits are expanded into an
+  // elementwise computation of the element index (see
+  // PhiloxElementwiseBitGenerator), which generates the same bits and can be
+  // fused into the consumers of the random bits.
+  explicit RngBitGeneratorExpander(RandomAlgorithm default_algorithm,
+                                   bool elementwise_philox = false)
+      : default_algorithm_(default_algorithm),
+        elementwise_philox_(elementwise_philox) {
     CHECK_NE(default_algorithm_, RandomAlgorithm::RNG_DEFAULT);
   }
 
@@ -66,6 +72,7 @@ class RngBitGeneratorExpander : public OpExpanderPass {
       RandomAlgorithm algorithm, HloModule* module);
 
   const RandomAlgorithm default_algorithm_;
+  const bool elementwise_philox_;
   absl::flat_hash_map<RngGeneratorKey, HloComputation*> computation_cache_;
 };
 
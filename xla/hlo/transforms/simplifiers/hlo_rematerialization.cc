@@ -553,7 +553,26 @@ class MemoryUsageTracker {
 
     CHECK_GT(memory_reduced, 0);
     // Return the inverse of the benefit of rematerialization.
-    return memory_limit_bytes / memory_reduced;
+    const int64_t cost = memory_limit_bytes / memory_reduced;
+    if (!options_.rank_recompute_by_flops) {
+      return cost;
+    }
+
+    // Penalize blocks that are expensive to recompute relative to the memory
+    // they save. Instructions that move data without computing anything (e.g.
+    // broadcasts) keep their memory based cost.
+    double flops = 0;
+    for (auto* item : items) {
+      flops += options_.hlo_cost_analysis.flop_count(*item->instruction);
+    }
+    const double scaled_cost =
+        static_cast<double>(cost) * (1.0 + flops / memory_reduced);
+    // Stay strictly below the "no candidate" sentinel used by the caller.
+    if (scaled_cost >= static_cast<double>(
+                           std::numeric_limits<int64_t>::max() - 1)) {
+      return std::numeric_limits<int64_t>::max() - 1;
+    }
+    return static_cast<int64_t>(scaled_cost);
   }
 
   // Finishes the placement of the current instruction. This frees any dead
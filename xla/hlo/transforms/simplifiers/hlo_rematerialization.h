@@ -154,6 +154,12 @@ class HloRematerialization : public HloModulePass {
     // Collection of async entry computations and their number of parallel
     // invocations.
     absl::flat_hash_map<HloComputation*, int64_t> async_computation_parallelism;
+
+    // If true, the cost of a kRecompute candidate is scaled by the FLOPs (as
+    // reported by `hlo_cost_analysis`) needed to recompute it per byte of
+    // memory saved. Among candidates saving similar amounts of memory, cheap
+    // to recompute instructions are then preferred over e.g. convolutions.
+    bool rank_recompute_by_flops = false;
   };
 
   explicit HloRematerialization(Options options, RematerializationSizes& sizes)
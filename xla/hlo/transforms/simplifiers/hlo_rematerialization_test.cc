@@ -137,9 +137,9 @@ ENTRY %main {
 class RecomputeAndCompressHloRematerializationTest
     : public RematerializationTestBase {
  protected:
-  absl::StatusOr<bool> RunHloRematerialization(int64_t memory_limit_bytes,
-                                               HloModule* module,
-                                               int64_t min_remat_size = 0) {
+  absl::StatusOr<bool> RunHloRematerialization(
+      int64_t memory_limit_bytes, HloModule* module, int64_t min_remat_size = 0,
+      bool rank_recompute_by_flops = false) {
     TF_EXPECT_OK(verifier().Run(module).status());
     if (!module->has_schedule()) {
       HloMemoryScheduler scheduler(
@@ -167,6 +167,7 @@ class RecomputeAndCompressHloRematerializationTest
         min_remat_size, /*compact_shape_function=*/nullptr,
         /*host_memory_offload_config=*/std::nullopt,
         /*async_threads=*/{});
+    options.rank_recompute_by_flops = rank_recompute_by_flops;
     HloRematerialization::RematerializationSizes sizes;
     HloRematerialization remat(options, sizes);
     absl::StatusOr<bool> result = remat.Run(module);
@@ -289,6 +290,47 @@ TEST_F(RecomputeAndCompressHloRematerializationTest,
   EXPECT_EQ(computation->instruction_count(), 8);
 }
 
+// Test that ranking by recompute FLOPs picks the cheap negate over the dot when
+// both save the same amount of memory.
+TEST_F(RecomputeAndCompressHloRematerializationTest,
+       RankRecomputeByFlopsPrefersCheapInstruction) {
+  const std::string hlo_string = R"(
+HloModule fusion, is_scheduled=true
+
+ENTRY %entry {
+  %p0 = f32[16,16]{1,0} parameter(0)
+  %p1 = f32[16,16]{1,0} parameter(1)
+  %p2 = f32[] parameter(2)
+  %dot = f32[16,16]{1,0} dot(%p0, %p1), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  %negate = f32[16,16]{1,0} negate(%p0)
+  %add.0 = f32[16,16]{1,0} add(%dot, %negate)
+  %broadcast = f32[512]{0} broadcast(%p2), dimensions={}
+  %slice = f32[1]{0} slice(%broadcast), slice={[0:1]}
+  %add.1 = f32[16,16]{1,0} add(%dot, %negate)
+  ROOT %tuple = (f32[16,16]{1,0}, f32[16,16]{1,0}, f32[1]{0}) tuple(%add.0, %add.1, %slice)
+}
+)";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  const HloInstruction* dot = FindInstruction(module.get(), "dot");
+  const HloInstruction* negate = FindInstruction(module.get(), "negate");
+
+  // Peak memory is reached at %slice with %dot, %negate and %broadcast live.
+  // Rematerializing either %dot or %negate gets under the limit.
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool changed,
+      RunHloRematerialization(/*memory_limit_bytes=*/3584, module.get(),
+                              /*min_remat_size=*/0,
+                              /*rank_recompute_by_flops=*/true));
+  EXPECT_TRUE(changed);
+
+  const HloInstruction* add_1 = FindInstruction(module.get(), "add.1");
+  EXPECT_EQ(add_1->operand(0), dot);
+  EXPECT_THAT(add_1->operand(1), op::Negate(op::Parameter(0)));
+  EXPECT_NE(add_1->operand(1), negate);
+}
+
 // Test rematerialization of a computation which calls another computation via a
 // while. Both the entry computation and while body computation can have memory
 // usage reduced via rematerialization however the memory limit is set such that
@@ -1177,9 +1219,9 @@ class CompressingRematerializationTest : public RematerializationTestBase {
     return result;
   }
 
-  absl::StatusOr<bool> RunHloRematerialization(int64_t memory_limit_bytes,
-                                               HloModule* module,
-                                               int64_t min_remat_size = 0) {
+  absl::StatusOr<bool> RunHloRematerialization(
+      int64_t memory_limit_bytes, HloModule* module, int64_t min_remat_size = 0,
+      bool rank_recompute_by_flops = false) {
     TF_EXPECT_OK(verifier().Run(module).status());
     HloRematerialization::RematerializationModeConfig config(
         /*recompute=*/false, /*compress=*/true, /*host_offload=*/false);
@@ -1373,9 +1415,9 @@ ENTRY %entry {
 
 class OffloadingRematerializationTest : public RematerializationTestBase {
  protected:
-  absl::StatusOr<bool> RunHloRematerialization(int64_t memory_limit_bytes,
-                                               HloModule* module,
-                                               int64_t min_remat_size = 0) {
+  absl::StatusOr<bool> RunHloRematerialization(
+      int64_t memory_limit_bytes, HloModule* module, int64_t min_remat_size = 0,
+      bool rank_recompute_by_flops = false) {
     TF_EXPECT_OK(verifier().Run(module).status());
     if (!module->has_schedule()) {
       HloMemoryScheduler scheduler(
@@ -15,6 +15,7 @@ limitations under the License.
 #include "xla/hlo/transforms/simplifiers/optimize_input_output_buffer_alias.h"
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include "absl/algorithm/container.h"
@@ -22,6 +23,8 @@ limitations under the License.
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_input_output_alias_config.h"
@@ -30,7 +33,10 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/status_macros.h"
+#include "xla/xla.pb.h"
 #include "tsl/platform/errors.h"
+#include "tsl/platform/numbers.h"
+#include "tsl/platform/statusor.h"
 
 namespace xla {
 
@@ -142,6 +148,42 @@ absl::StatusOr<bool> OptimizeInputOutputBufferAlias::Build(
   return changed;
 }
 
+absl::StatusOr<std::vector<OptimizeInputOutputBufferAlias::MissedDonation>>
+OptimizeInputOutputBufferAlias::FindMissedDonations(
+    absl::Span<const Shape> input_shapes, const Shape& output_shape,
+    const HloInputOutputAliasConfig& alias_config,
+    const HloBufferDonorConfig& buffer_donor_config) {
+  // Redo the matching on copies of the configs as if every parameter was a
+  // buffer donor. The registered donors left over by the first matching have
+  // no donee of their size left, so every new alias is a missed donation.
+  HloInputOutputAliasConfig all_donors_alias_config = alias_config;
+  HloBufferDonorConfig all_donors_buffer_donor_config = buffer_donor_config;
+  OptimizeInputOutputBufferAlias all_donors(
+      /*registered_buffer_donor_only=*/false, shape_size_fn_);
+  TF_RETURN_IF_ERROR(all_donors
+                         .Build(input_shapes, output_shape,
+                                &all_donors_alias_config,
+                                &all_donors_buffer_donor_config)
+                         .status());
+
+  std::vector<MissedDonation> missed_donations;
+  all_donors_alias_config.ForEachAlias(
+      [&](const ShapeIndex& output_index,
+          const HloInputOutputAliasConfig::Alias& alias) {
+        if (alias_config.OutputHasAlias(output_index) ||
+            buffer_donor_config.ParameterIsBufferDonor(alias.parameter_number,
+                                                       alias.parameter_index)) {
+          return;
+        }
+        const Shape& subshape =
+            ShapeUtil::GetSubshape(output_shape, output_index);
+        missed_donations.push_back(
+            MissedDonation{alias.parameter_number, alias.parameter_index,
+                           output_index, shape_size_fn_(subshape)});
+      });
+  return missed_donations;
+}
+
 absl::StatusOr<bool> OptimizeInputOutputBufferAlias::Run(
     HloModule* module,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
@@ -159,8 +201,54 @@ absl::StatusOr<bool> OptimizeInputOutputBufferAlias::Run(
       &module->input_output_alias_config();
   HloBufferDonorConfig* buffer_donor_config = &module->buffer_donor_config();
 
+  // Auto-donation makes every parameter a buffer donor candidate, as if the
+  // caller had donated all arguments.
+  const DebugOptions& debug_options = module->config().debug_options();
+  if (registered_buffer_donor_only_ &&
+      debug_options.xla_auto_donate_input_buffers()) {
+    OptimizeInputOutputBufferAlias all_donors(
+        /*registered_buffer_donor_only=*/false, shape_size_fn_);
+    TF_ASSIGN_OR_RETURN(
+        bool changed, all_donors.Build(input_shapes, output_shape,
+                                       alias_config, buffer_donor_config));
+    TF_RETURN_IF_ERROR(alias_config->Verify(*module, shape_size_fn_));
+    return changed;
+  }
+
   TF_ASSIGN_OR_RETURN(bool changed, Build(input_shapes, output_shape,
                                           alias_config, buffer_donor_config));
+
+  if (registered_buffer_donor_only_ &&
+      debug_options.xla_report_missed_buffer_donation()) {
+    TF_ASSIGN_OR_RETURN(
+        std::vector<MissedDonation> missed_donations,
+        FindMissedDonations(input_shapes, output_shape, *alias_config,
+                            *buffer_donor_config));
+    if (!missed_donations.empty()) {
+      int64_t missed_bytes = 0;
+      for (const MissedDonation& missed : missed_donations) {
+        missed_bytes += missed.shape_size;
+      }
+      LOG(WARNING) << "Module " << module->name() << ": "
+                   << missed_donations.size()
+                   << " parameter buffer(s) could alias an output if they "
+                      "were donated, saving "
+                   << tsl::strings::HumanReadableNumBytes(missed_bytes)
+                   << ": "
+                   << absl::StrJoin(
+                          missed_donations, ", ",
+                          [](std::string* out, const MissedDonation& missed) {
+                            absl::StrAppend(
+                                out, "parameter ", missed.param_number,
+                                missed.param_index.ToString(), " -> output ",
+                                missed.output_index.ToString());
+                          })
+                   << ". Donate these arguments, or set "
+                      "xla_auto_donate_input_buffers if the caller never "
+                      "reuses them.";
+    }
+  }
+
   TF_RETURN_IF_ERROR(alias_config->Verify(*module, shape_size_fn_));
 
   return changed;
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <functional>
+#include <vector>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
@@ -43,6 +44,17 @@ namespace xla {
 //  Outputs    : { O1(s32[3]), O2(f32[3]), O3(f32[16,12]), ... }
 //
 // one potential aliasing would be (O1, P2), (O2, P1), (O3, P4), ..
+//
+// When constructed with `registered_buffer_donor_only`, the pass respects the
+// caller's donation choices and only aliases parameters registered in the
+// HloBufferDonorConfig. Two debug options change that behavior:
+//
+//  * xla_auto_donate_input_buffers: all parameters are donor candidates, as if
+//    the caller had donated every argument. The pass can't prove that the
+//    caller doesn't use an argument after the call, so this is an opt-in.
+//  * xla_report_missed_buffer_donation: logs the parameters that were not
+//    donated but could alias an output, with the bytes that donating them
+//    would save.
 class OptimizeInputOutputBufferAlias : public HloModulePass {
  public:
   OptimizeInputOutputBufferAlias() = default;
@@ -54,6 +66,14 @@ class OptimizeInputOutputBufferAlias : public HloModulePass {
         shape_size_fn_(shape_size_fn) {}
   ~OptimizeInputOutputBufferAlias() override = default;
 
+  // A parameter buffer that could alias an output if it was donated.
+  struct MissedDonation {
+    int64_t param_number;
+    ShapeIndex param_index;
+    ShapeIndex output_index;
+    int64_t shape_size;
+  };
+
   absl::string_view name() const override {
     return "optimize_input_output_buffer_alias";
   }
@@ -79,6 +99,14 @@ class OptimizeInputOutputBufferAlias : public HloModulePass {
                              HloInputOutputAliasConfig* alias_config,
                              HloBufferDonorConfig* buffer_donor_config);
 
+  // Returns the parameter buffers that are not registered as buffer donors but
+  // would be matched with a donee that has no alias in `alias_config` if all
+  // parameters were buffer donors.
+  absl::StatusOr<std::vector<MissedDonation>> FindMissedDonations(
+      absl::Span<const Shape> input_shapes, const Shape& output_shape,
+      const HloInputOutputAliasConfig& alias_config,
+      const HloBufferDonorConfig& buffer_donor_config);
+
   std::function<int64_t(const Shape&)> shape_size_fn_ = [](const Shape& shape) {
     return ShapeUtil::ByteSizeOf(shape);
   };
@@ -21,11 +21,13 @@ limitations under the License.
 
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
+#include "absl/strings/string_view.h"
 #include "xla/hlo/ir/hlo_input_output_alias_config.h"
 #include "xla/hlo/testlib/hlo_hardware_independent_test_base.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/platform/statusor.h"
 #include "tsl/platform/test.h"
 
 namespace xla {
@@ -75,6 +77,16 @@ class OptimizeInputOutputBufferAliasTest
     return changed.value();
   }
 
+  std::vector<OptimizeInputOutputBufferAlias::MissedDonation>
+  FindMissedDonations(const std::vector<Shape>& input_shapes,
+                      const Shape& output_shape) {
+    auto missed_donations = optimize_pass_->FindMissedDonations(
+        input_shapes, output_shape, alias_config_, buffer_donor_config_);
+    TF_CHECK_OK(missed_donations.status());
+
+    return missed_donations.value();
+  }
+
   std::unique_ptr<OptimizeInputOutputBufferAlias> optimize_pass_;
 
   HloInputOutputAliasConfig alias_config_;
@@ -202,6 +214,58 @@ TEST_F(OptimizeInputOutputBufferAliasTest, BufferDonorOnly) {
   EXPECT_FALSE(alias_config_.GetAliasedOutput(0, {1}));
 }
 
+TEST_F(OptimizeInputOutputBufferAliasTest, FindMissedDonations) {
+  CreatePassAndBufferDonorConfig(true);
+  std::vector<Shape> input = {ShapeUtil::MakeTupleShape({r1f32_, r2f32_}),
+                              r3f32_};
+  Shape output = ShapeUtil::MakeTupleShape({r2f32_, r1f32_, r4f32_});
+
+  TF_CHECK_OK(buffer_donor_config_.AddBufferDonor(0, {0}));
+  EXPECT_TRUE(BuildAliasConfig(input, output));
+  EXPECT_EQ(AliasCount(), 1);
+
+  std::vector<OptimizeInputOutputBufferAlias::MissedDonation>
+      missed_donations = FindMissedDonations(input, output);
+
+  // Only parameter 0 {1} has a donee of the same size left.
+  ASSERT_EQ(missed_donations.size(), 1);
+  const auto& missed = missed_donations.front();
+  EXPECT_EQ(missed.param_number, 0);
+  EXPECT_EQ(missed.param_index, ShapeIndex{1});
+  EXPECT_EQ(missed.output_index, ShapeIndex{0});
+  EXPECT_EQ(missed.shape_size, ShapeUtil::ByteSizeOf(r2f32_));
+
+  // Finding missed donations doesn't change the configs.
+  EXPECT_EQ(AliasCount(), 1);
+  EXPECT_FALSE(alias_config_.OutputHasAlias({0}));
+}
+
+TEST_F(OptimizeInputOutputBufferAliasTest, AutoDonateInputBuffers) {
+  constexpr absl::string_view kHlo = R"(
+    HloModule m
+
+    ENTRY main {
+      p0 = f32[4] parameter(0)
+      p1 = f32[4,5] parameter(1)
+      ROOT add = f32[4] add(p0, p0)
+    })";
+
+  OptimizeInputOutputBufferAlias pass(/*registered_buffer_donor_only=*/true);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHlo));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, RunHloPass(&pass, module.get()));
+  EXPECT_FALSE(changed);
+
+  module->mutable_config()
+      .mutable_debug_options()
+      .set_xla_auto_donate_input_buffers(true);
+  TF_ASSERT_OK_AND_ASSIGN(changed, RunHloPass(&pass, module.get()));
+  EXPECT_TRUE(changed);
+  EXPECT_EQ(module->input_output_alias_config().GetAliasedOutput(0, {}),
+            ShapeIndex{});
+  EXPECT_FALSE(module->input_output_alias_config().ParameterHasAlias(1, {}));
+}
+
 // No aliasing on dynamic shapes with tuple.
 TEST_F(OptimizeInputOutputBufferAliasTest, DynamicShapeWithTuple) {
   CreatePassAndBufferDonorConfig(false);
@@ -412,6 +412,9 @@ std::string Layout::ToString() const {
 }
 
 bool Layout::Equal::operator()(const Layout& lhs, const Layout& rhs) {
+  if (&lhs == &rhs) {
+    return true;
+  }
   if (!LayoutUtil::IsDense(lhs) || !LayoutUtil::IsDense(rhs)) {
     // dim_level_types
     if (lhs.dim_level_types_size() != rhs.dim_level_types_size()) {
@@ -34,6 +34,7 @@ limitations under the License.
 
 #include "absl/base/attributes.h"
 #include "absl/base/casts.h"
+#include "absl/base/config.h"
 #include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
@@ -569,6 +570,19 @@ class LiteralBase {
   absl::Status SerializeWithShapeProto(const ShapeProto& proto,
                                        OutputIterator output) const;
 
+  // Elements whose serialized form matches their in-memory representation can
+  // be copied in bulk from or to contiguous character buffers. That is the case
+  // for all types of at least one byte on little endian hosts.
+  template <typename NativeT, typename Iterator>
+  static constexpr bool kCanCopyElements =
+#ifdef ABSL_IS_LITTLE_ENDIAN
+      primitive_util::BitWidth(
+          primitive_util::NativeToPrimitiveType<NativeT>()) >= 8 &&
+      (std::is_same_v<Iterator, char*> || std::is_same_v<Iterator, const char*>);
+#else
+      false;
+#endif
+
   template <typename OutputIterator>
   class SerializeState {
    public:
@@ -638,6 +652,15 @@ class LiteralBase {
           }
           WriteElement(byte);
         }
+      } else if constexpr (kCanCopyElements<NativeT, OutputIterator>) {
+        // The serialized format is the little endian in-memory representation,
+        // so contiguous outputs can be written with a single copy.
+        int64_t bytes = elements.size() * sizeof(NativeT);
+        if (bytes > 0) {
+          std::memcpy(output_, elements.data(), bytes);
+        }
+        output_ += bytes;
+        num_written_ += bytes;
       } else {
         for (NativeT element : elements) {
           WriteElement(element);
@@ -758,6 +781,16 @@ class LiteralBase {
             byte >>= bits_per_element;
           }
         }
+      } else if constexpr (kCanCopyElements<NativeT, InputIterator>) {
+        int64_t bytes = elements.size() * sizeof(NativeT);
+        if (end_ - input_ < bytes) {
+          return false;
+        }
+        if (bytes > 0) {
+          std::memcpy(elements.data(), input_, bytes);
+        }
+        input_ += bytes;
+        num_read_ += bytes;
       } else {
         for (NativeT& element : elements) {
           if (!ReadElement(element)) {
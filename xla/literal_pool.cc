@@ -21,6 +21,7 @@ limitations under the License.
 #include <memory>
 #include <vector>
 
+#include "absl/hash/hash.h"
 #include "absl/synchronization/mutex.h"
 #include "xla/literal.h"
 #include "xla/shape.h"
@@ -35,10 +36,11 @@ LiteralPool* LiteralPool::Default() {
 
 // Erases expired weak pointers from the vector and returns the number of
 // elements that were erased.
-static size_t EraseExpiredLiterals(
-    std::vector<std::weak_ptr<Literal>>& literals) {
-  auto it = std::remove_if(literals.begin(), literals.end(),
-                           [](auto& ptr) { return ptr.expired(); });
+template <typename Entry>
+static size_t EraseExpiredLiterals(std::vector<Entry>& literals) {
+  auto it = std::remove_if(literals.begin(), literals.end(), [](auto& entry) {
+    return entry.literal.expired();
+  });
   size_t num_erased = std::distance(it, literals.end());
 
   literals.erase(it, literals.end());
@@ -70,11 +72,19 @@ size_t LiteralPool::GarbageCollect(Shape shape) {
   return num_erased;
 }
 
+// Returns the hash of the literal contents. Hashing is layout sensitive to be
+// consistent with the layout sensitive comparison used by the pool.
+static size_t HashLiteral(const Literal& literal) {
+  return absl::HashOf(Literal::AbslHashable<true>(literal));
+}
+
 // Tried to find a canonical literal in the pool. Return nullptr if not found.
+template <typename Entry>
 static std::shared_ptr<Literal> FindCanonicalLiteral(
-    std::vector<std::weak_ptr<Literal>>& literals, const Literal& literal) {
-  for (std::weak_ptr<Literal>& ptr : literals) {
-    if (auto locked_ptr = ptr.lock()) {
+    std::vector<Entry>& literals, const Literal& literal, size_t hash) {
+  for (Entry& entry : literals) {
+    if (entry.hash != hash) continue;
+    if (auto locked_ptr = entry.literal.lock()) {
       if (locked_ptr->Equal(literal, /*layout_sensitive=*/true)) {
         return locked_ptr;
       }
@@ -86,28 +96,31 @@ static std::shared_ptr<Literal> FindCanonicalLiteral(
 
 std::shared_ptr<Literal> LiteralPool::GetCanonicalLiteral(
     const Literal& literal) {
+  // Hash outside of the critical section, it touches every byte of the data.
+  size_t hash = HashLiteral(literal);
   absl::MutexLock lock(&mu_);
 
   auto& literals = literals_[literal.shape()];
-  if (auto ptr = FindCanonicalLiteral(literals, literal)) {
+  if (auto ptr = FindCanonicalLiteral(literals, literal, hash)) {
     return ptr;
   }
 
   std::shared_ptr<Literal> new_literal = literal.CloneToUnique();
-  literals.push_back(new_literal);
+  literals.push_back({hash, new_literal});
   return new_literal;
 }
 
 std::shared_ptr<Literal> LiteralPool::GetCanonicalLiteral(
     std::shared_ptr<Literal> literal) {
+  size_t hash = HashLiteral(*literal);
   absl::MutexLock lock(&mu_);
 
   auto& literals = literals_[literal->shape()];
-  if (auto ptr = FindCanonicalLiteral(literals, *literal)) {
+  if (auto ptr = FindCanonicalLiteral(literals, *literal, hash)) {
     return ptr;
   }
 
-  literals.push_back(literal);
+  literals.push_back({hash, literal});
   return literal;
 }
 
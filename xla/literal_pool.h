@@ -54,12 +54,19 @@ class LiteralPool {
   size_t GarbageCollect(Shape shape);
 
  private:
+  // A pooled literal together with the hash of its contents. Comparing hashes
+  // first avoids comparing the contents of large literals that have the same
+  // shape but different values.
+  struct Entry {
+    size_t hash;
+    std::weak_ptr<Literal> literal;
+  };
+
   // We keep weak pointers to the literals in the pool to allow for garbage
   // collection when owning HLO modules are destroyed. We run periodic garbage
   // collection to clean up the literals that are no longer referenced.
   absl::Mutex mu_;
-  absl::flat_hash_map<Shape, std::vector<std::weak_ptr<Literal>>> literals_
-      ABSL_GUARDED_BY(mu_);
+  absl::flat_hash_map<Shape, std::vector<Entry>> literals_ ABSL_GUARDED_BY(mu_);
 };
 
 }  // namespace xla
@@ -20,6 +20,7 @@ limitations under the License.
 #include <complex>
 #include <cstdint>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <random>
 #include <string>
@@ -3074,6 +3075,22 @@ INSTANTIATE_TEST_SUITE_P(
     Tuples, LiteralSerializationTest,
     ::testing::ValuesIn(LiteralSerializationTest::GenerateTupleParams()));
 
+TEST(LiteralSerializationFormatTest, BulkCopyMatchesElementwiseFormat) {
+  Literal literal = LiteralUtil::CreateR2<float>({{1.0f, -2.0f}, {3.5f, 4.0f}});
+  TF_ASSERT_OK_AND_ASSIGN(std::string serialized, literal.SerializeAsString());
+
+  // Serializing through a non-contiguous iterator writes element by element.
+  std::string elementwise;
+  TF_ASSERT_OK(literal.Serialize(std::back_inserter(elementwise)));
+  EXPECT_EQ(serialized, elementwise);
+
+  // Truncated data is rejected instead of being read past the end.
+  EXPECT_FALSE(Literal::DeserializeFromString(
+                   absl::string_view(serialized).substr(
+                       0, serialized.size() - 1))
+                   .ok());
+}
+
 //===----------------------------------------------------------------------===//
 // Literal::Broadcast perfrormance benchmarks below.
 //===----------------------------------------------------------------------===//
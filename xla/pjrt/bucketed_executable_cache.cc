@@ -0,0 +1,150 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/bucketed_executable_cache.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "xla/hlo/builder/xla_computation.h"
+#include "xla/literal.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+
+int64_t BatchSizeBucket(int64_t batch_size) {
+  CHECK_GT(batch_size, 0);
+  return static_cast<int64_t>(
+      absl::bit_ceil(static_cast<uint64_t>(batch_size)));
+}
+
+absl::StatusOr<Literal> PadBatchDimension(const LiteralSlice& literal,
+                                          int64_t batch_size) {
+  const Shape& shape = literal.shape();
+  if (!shape.IsArray() || shape.dimensions().empty()) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Expected an array with a batch dimension, got ",
+        ShapeUtil::HumanString(shape)));
+  }
+  if (shape.dimensions(0) > batch_size) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Can't pad batch dimension of ",
+                     ShapeUtil::HumanString(shape), " to ", batch_size));
+  }
+  if (shape.dimensions(0) == batch_size) {
+    return literal.Clone();
+  }
+
+  Shape padded_shape = shape;
+  padded_shape.set_dimensions(0, batch_size);
+  Literal padded = Literal::CreateFromShape(padded_shape);
+
+  std::vector<int64_t> base(shape.dimensions().size(), 0);
+  TF_RETURN_IF_ERROR(
+      padded.CopySliceFrom(literal, base, base, shape.dimensions()));
+  return padded;
+}
+
+BucketedExecutableCache::BucketedExecutableCache(PjRtClient* client,
+                                                 ComputationFactory factory,
+                                                 CompileOptions options,
+                                                 int capacity)
+    : client_(client),
+      factory_(std::move(factory)),
+      options_(std::move(options)),
+      lru_list_(capacity),
+      cache_(&lru_list_) {}
+
+absl::StatusOr<std::shared_ptr<PjRtLoadedExecutable>>
+BucketedExecutableCache::GetOrCompile(int64_t batch_size) {
+  if (batch_size <= 0) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("Batch size must be positive, got ", batch_size));
+  }
+  absl::MutexLock lock(&mu_);
+  bool compiled = false;
+  auto executable = cache_.GetOrCreateIfAbsent(
+      BatchSizeBucket(batch_size),
+      [&](const int64_t& bucket)
+          -> absl::StatusOr<std::shared_ptr<PjRtLoadedExecutable>> {
+        compiled = true;
+        TF_ASSIGN_OR_RETURN(XlaComputation computation, factory_(bucket));
+        TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtLoadedExecutable> executable,
+                            client_->CompileAndLoad(computation, options_));
+        return std::shared_ptr<PjRtLoadedExecutable>(std::move(executable));
+      });
+  if (compiled) {
+    ++num_compilations_;
+  }
+  return executable;
+}
+
+absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>>
+BucketedExecutableCache::Execute(absl::Span<const LiteralSlice> arguments,
+                                 PjRtDevice* device,
+                                 const ExecuteOptions& options) {
+  int64_t batch_size = 0;
+  for (const LiteralSlice& argument : arguments) {
+    if (!argument.shape().IsArray() || argument.shape().dimensions().empty()) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Expected arguments with a batch dimension, got ",
+          ShapeUtil::HumanString(argument.shape())));
+    }
+    batch_size = std::max(batch_size, argument.shape().dimensions(0));
+  }
+
+  TF_ASSIGN_OR_RETURN(std::shared_ptr<PjRtLoadedExecutable> executable,
+                      GetOrCompile(batch_size));
+  const int64_t bucket = BatchSizeBucket(batch_size);
+
+  TF_ASSIGN_OR_RETURN(PjRtMemorySpace * memory_space,
+                      device->default_memory_space());
+  std::vector<std::unique_ptr<PjRtBuffer>> buffers;
+  std::vector<PjRtBuffer*> argument_handles;
+  buffers.reserve(arguments.size());
+  argument_handles.reserve(arguments.size());
+  for (const LiteralSlice& argument : arguments) {
+    TF_ASSIGN_OR_RETURN(Literal padded, PadBatchDimension(argument, bucket));
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtBuffer> buffer,
+                        client_->BufferFromHostLiteral(padded, memory_space));
+    // `padded` goes out of scope, wait for the transfer to read it.
+    TF_RETURN_IF_ERROR(buffer->GetReadyFuture().Await());
+    argument_handles.push_back(buffer.get());
+    buffers.push_back(std::move(buffer));
+  }
+
+  return executable->ExecuteSharded(argument_handles, device, options);
+}
+
+int64_t BucketedExecutableCache::num_compilations() const {
+  absl::MutexLock lock(&mu_);
+  return num_compilations_;
+}
+
+}  // namespace xla
@@ -0,0 +1,100 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_PJRT_BUCKETED_EXECUTABLE_CACHE_H_
+#define XLA_PJRT_BUCKETED_EXECUTABLE_CACHE_H_
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
+#include "xla/hlo/builder/xla_computation.h"
+#include "xla/literal.h"
+#include "xla/pjrt/lru_cache.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+
+namespace xla {
+
+// Returns the batch size bucket for `batch_size`: the smallest power of two
+// that is greater than or equal to it.
+int64_t BatchSizeBucket(int64_t batch_size);
+
+// Returns a copy of `literal` with its major-most dimension zero-padded to
+// `batch_size`.
+absl::StatusOr<Literal> PadBatchDimension(const LiteralSlice& literal,
+                                          int64_t batch_size);
+
+// An LRU cache of executables specialized for power-of-two batch sizes.
+//
+// Serving workloads with varying batch sizes would otherwise compile a new
+// executable for every batch size they see. Instead, the cache compiles the
+// program once per bucket (see BatchSizeBucket) and pads inputs to the bucket
+// size, so at most log2(max batch size) programs are ever compiled and
+// requests only pay for a compilation the first time a bucket is used.
+//
+// Thread-safe. Compilation happens under the cache lock, so concurrent
+// requests for a bucket that is not cached yet wait for a single compilation.
+class BucketedExecutableCache {
+ public:
+  // Builds the program for the given (bucketed) batch size.
+  using ComputationFactory =
+      std::function<absl::StatusOr<XlaComputation>(int64_t batch_size)>;
+
+  BucketedExecutableCache(PjRtClient* client, ComputationFactory factory,
+                          CompileOptions options, int capacity);
+
+  BucketedExecutableCache(const BucketedExecutableCache&) = delete;
+  BucketedExecutableCache& operator=(const BucketedExecutableCache&) = delete;
+
+  // Returns the executable for the bucket of `batch_size`, compiling it if it
+  // is not in the cache.
+  absl::StatusOr<std::shared_ptr<PjRtLoadedExecutable>> GetOrCompile(
+      int64_t batch_size);
+
+  // Pads `arguments` along their major-most (batch) dimension to the bucket of
+  // the largest batch size among them, transfers them to `device` and runs
+  // the matching executable. Results keep the bucketed batch size; callers
+  // slice off the padding if they need to.
+  absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>> Execute(
+      absl::Span<const LiteralSlice> arguments, PjRtDevice* device,
+      const ExecuteOptions& options = {});
+
+  // Number of compilations performed so far.
+  int64_t num_compilations() const;
+
+ private:
+  using Cache =
+      LRUCache<int64_t,
+               absl::StatusOr<std::shared_ptr<PjRtLoadedExecutable>>>;
+
+  PjRtClient* client_;
+  ComputationFactory factory_;
+  CompileOptions options_;
+
+  mutable absl::Mutex mu_;
+  Cache::LRUList lru_list_ ABSL_GUARDED_BY(mu_);
+  Cache cache_ ABSL_GUARDED_BY(mu_);
+  int64_t num_compilations_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace xla
+
+#endif  // XLA_PJRT_BUCKETED_EXECUTABLE_CACHE_H_
@@ -0,0 +1,121 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/bucketed_executable_cache.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_replace.h"
+#include "xla/hlo/builder/xla_computation.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/parser/hlo_parser.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/pjrt/plugin/xla_cpu/cpu_client_options.h"
+#include "xla/pjrt/plugin/xla_cpu/xla_cpu_pjrt_client.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+// Builds `x + x` for `f32[batch_size, 2]` inputs.
+absl::StatusOr<XlaComputation> MakeAddComputation(int64_t batch_size) {
+  constexpr char kProgram[] = R"(
+    HloModule add
+    ENTRY add {
+      x = f32[$batch,2] parameter(0)
+      ROOT add = f32[$batch,2] add(x, x)
+    })";
+  TF_ASSIGN_OR_RETURN(
+      std::unique_ptr<HloModule> module,
+      ParseAndReturnUnverifiedModule(absl::StrReplaceAll(
+          kProgram, {{"$batch", absl::StrCat(batch_size)}})));
+  return XlaComputation(module->ToProto());
+}
+
+TEST(BucketedExecutableCacheTest, BatchSizeBucket) {
+  EXPECT_EQ(BatchSizeBucket(1), 1);
+  EXPECT_EQ(BatchSizeBucket(2), 2);
+  EXPECT_EQ(BatchSizeBucket(3), 4);
+  EXPECT_EQ(BatchSizeBucket(4), 4);
+  EXPECT_EQ(BatchSizeBucket(17), 32);
+}
+
+TEST(BucketedExecutableCacheTest, PadBatchDimension) {
+  Literal literal = LiteralUtil::CreateR2<float>({{1, 2}, {3, 4}, {5, 6}});
+  TF_ASSERT_OK_AND_ASSIGN(Literal padded, PadBatchDimension(literal, 4));
+  EXPECT_EQ(padded,
+            LiteralUtil::CreateR2<float>({{1, 2}, {3, 4}, {5, 6}, {0, 0}}));
+
+  EXPECT_FALSE(PadBatchDimension(literal, 2).ok());
+  EXPECT_FALSE(PadBatchDimension(LiteralUtil::CreateR0<float>(1), 2).ok());
+}
+
+TEST(BucketedExecutableCacheTest, CompilesOncePerBucket) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetXlaPjrtCpuClient(CpuClientOptions()));
+  BucketedExecutableCache cache(client.get(), MakeAddComputation,
+                                CompileOptions(), /*capacity=*/4);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto executable_3, cache.GetOrCompile(3));
+  TF_ASSERT_OK_AND_ASSIGN(auto executable_4, cache.GetOrCompile(4));
+  EXPECT_EQ(executable_3, executable_4);
+  EXPECT_EQ(cache.num_compilations(), 1);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto executable_5, cache.GetOrCompile(5));
+  EXPECT_NE(executable_4, executable_5);
+  EXPECT_EQ(cache.num_compilations(), 2);
+
+  EXPECT_FALSE(cache.GetOrCompile(0).ok());
+}
+
+TEST(BucketedExecutableCacheTest, EvictsLeastRecentlyUsedBucket) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetXlaPjrtCpuClient(CpuClientOptions()));
+  BucketedExecutableCache cache(client.get(), MakeAddComputation,
+                                CompileOptions(), /*capacity=*/1);
+
+  TF_ASSERT_OK(cache.GetOrCompile(1).status());
+  TF_ASSERT_OK(cache.GetOrCompile(2).status());
+  TF_ASSERT_OK(cache.GetOrCompile(1).status());
+  EXPECT_EQ(cache.num_compilations(), 3);
+}
+
+TEST(BucketedExecutableCacheTest, ExecutePadsArguments) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetXlaPjrtCpuClient(CpuClientOptions()));
+  BucketedExecutableCache cache(client.get(), MakeAddComputation,
+                                CompileOptions(), /*capacity=*/4);
+
+  Literal argument = LiteralUtil::CreateR2<float>({{1, 2}, {3, 4}, {5, 6}});
+  std::vector<LiteralSlice> arguments = {argument};
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::vector<std::unique_ptr<PjRtBuffer>> results,
+      cache.Execute(arguments, client->addressable_devices()[0]));
+  ASSERT_EQ(results.size(), 1);
+
+  TF_ASSERT_OK_AND_ASSIGN(std::shared_ptr<Literal> result,
+                          results[0]->ToLiteralSync());
+  EXPECT_EQ(*result,
+            LiteralUtil::CreateR2<float>({{2, 4}, {6, 8}, {10, 12}, {0, 0}}));
+}
+
+}  // namespace
+}  // namespace xla
@@ -82,6 +82,9 @@ PJRT_Error* PJRT_Client_Create(PJRT_Client_Create_Args* args) {
           {"preallocate", PJRT_NamedValue_Type::PJRT_NamedValue_kBool},
           {"collective_memory_size",
            PJRT_NamedValue_Type::PJRT_NamedValue_kInt64},
+          {"garbage_collection", PJRT_NamedValue_Type::PJRT_NamedValue_kBool},
+          {"small_allocation_threshold",
+           PJRT_NamedValue_Type::PJRT_NamedValue_kInt64},
           {"visible_devices", PJRT_NamedValue_Type::PJRT_NamedValue_kInt64List},
           {"node_id", PJRT_NamedValue_Type::PJRT_NamedValue_kInt64},
           {"num_nodes", PJRT_NamedValue_Type::PJRT_NamedValue_kInt64},
@@ -129,6 +132,15 @@ PJRT_Error* PJRT_Client_Create(PJRT_Client_Create_Args* args) {
       it != create_options.end()) {
     allocator_config.collective_memory_size = std::get<int64_t>(it->second);
   }
+  if (auto it = create_options.find("garbage_collection");
+      it != create_options.end()) {
+    allocator_config.garbage_collection = std::get<bool>(it->second);
+  }
+  if (auto it = create_options.find("small_allocation_threshold");
+      it != create_options.end()) {
+    allocator_config.small_allocation_threshold =
+        std::get<int64_t>(it->second);
+  }
   std::optional<std::set<int>> visible_devices;
   if (auto it = create_options.find("visible_devices");
       it != create_options.end()) {
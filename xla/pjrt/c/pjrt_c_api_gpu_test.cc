@@ -595,6 +595,10 @@ TEST(PjrtCApiGpuAllocatorTest, ValidOptionsParsing) {
     if (allocator_option == "bfc" || allocator_option == "cuda_async") {
       options["memory_fraction"] = 0.5f;
     }
+    if (allocator_option == "bfc") {
+      options["garbage_collection"] = true;
+      options["small_allocation_threshold"] = int64_t{4096};
+    }
     if (allocator_option == "cuda_async") {
       options["preallocate"] = true;
     }
@@ -674,7 +674,7 @@ void AbstractTfrtCpuBuffer::CopyFromLiteral(
     const LiteralSlice& literal, const Shape& shape,
     absl::InlinedVector<tsl::RCReference<tsl::AsyncValue>, 4>* avs,
     AsyncWorkRunner* async_work_runner) {
-  auto usage_event = tsl::MakeAvailableAsyncValueRef<CpuEvent>();
+  auto usage_event = tsl::GetAvailableAsyncValueRefSingleton<CpuEvent>();
   auto* device_buffer = AcquireUsage(std::move(usage_event));
   CHECK(device_buffer);
   if (!shape.IsTuple()) {
@@ -1051,7 +1051,7 @@ AbstractAsyncHostToHostMemoryTransferManager::PopulateAsyncTransferManagerData(
   for (const auto& buffer : buffers) {
     // We can make the usage event available right away because the buffer's
     // definition event will be made available after the usage has completed.
-    auto usage_event = tsl::MakeAvailableAsyncValueRef<CpuEvent>();
+    auto usage_event = tsl::GetAvailableAsyncValueRefSingleton<CpuEvent>();
     auto* device_buffer = buffer->AcquireUsage(std::move(usage_event));
     CHECK(device_buffer);
     device_buffers.push_back(device_buffer);
@@ -73,6 +73,7 @@ limitations under the License.
 #include "xla/pjrt/cpu/abstract_tfrt_cpu_buffer.h"
 #include "xla/pjrt/cpu/cpu_async_execution_tracker.h"
 #include "xla/pjrt/cpu/cpu_device.h"
+#include "xla/pjrt/cpu/cpu_device_memory_pool.h"
 #include "xla/pjrt/cpu/cpu_event.h"
 #include "xla/pjrt/cpu/tracked_cpu_device_buffer.h"
 #include "xla/pjrt/host_callback.h"
@@ -305,7 +306,13 @@ absl::StatusOr<std::unique_ptr<PjRtClient>> GetTfrtCpuClient(
     CpuClientOptions options) {
   // Need at least CpuDeviceCount threads to launch one collective.
   int cpu_device_count = options.cpu_device_count.value_or(CpuDeviceCount());
-  size_t num_threads = std::max(DefaultThreadPoolSize(), cpu_device_count);
+  size_t num_threads = std::max(
+      options.num_threads.value_or(DefaultThreadPoolSize()), cpu_device_count);
+
+  if (options.device_memory_pool_bytes > 0) {
+    CpuDeviceMemoryPool::Global().ReserveCapacity(
+        options.device_memory_pool_bytes);
+  }
 
   std::vector<std::unique_ptr<TfrtCpuDevice>> devices;
   for (int i = 0; i < cpu_device_count; ++i) {
@@ -356,7 +363,7 @@ TfrtCpuClient::TfrtCpuClient(
       async_work_runner_(std::make_unique<ThreadPoolAsyncWorkRunner>(
           pjrt_client_thread_pool_.get())),
       last_collective_launch_event_(
-          tsl::MakeAvailableAsyncValueRef<CpuEvent>()),
+          tsl::GetAvailableAsyncValueRefSingleton<CpuEvent>()),
       transpose_cache_(1024),
       collectives_(std::move(collectives)),
       topology_(CpuTopologyDescription::Create(
@@ -992,7 +999,8 @@ TfrtCpuClient::CreateViewOfDeviceBuffer(
   buffers.push_back(std::move(non_owning_buffer));
   auto tracked_device_buffer = std::make_unique<TrackedCpuDeviceBuffer>(
       /*is_tuple=*/false, /*owns_buffers=*/false, std::move(buffers),
-      /*definition_event=*/tsl::MakeAvailableAsyncValueRef<CpuEvent>(),
+      /*definition_event=*/
+      tsl::GetAvailableAsyncValueRefSingleton<CpuEvent>(),
       std::move(on_delete_callback));
   CHECK_EQ(memory_space->devices().size(), 1);
   auto* device = memory_space->devices().front();
@@ -1270,10 +1278,14 @@ struct BufferAlloc {
   // All data members should have the same size.
   absl::InlinedVector<tsl::AsyncValueRef<CpuDeviceMemory>, 4> buffers;
   absl::InlinedVector<size_t, 4> allocation_sizes;
+  absl::InlinedVector<bool, 4> use_huge_pages;
 
   void Allocate() {
     for (int i = 0; i < buffers.size(); ++i) {
-      auto memory = CpuDeviceMemory::Allocate(allocation_sizes[i]);
+      auto memory =
+          use_huge_pages[i]
+              ? CpuDeviceMemory::AllocateHugePages(allocation_sizes[i])
+              : CpuDeviceMemory::Allocate(allocation_sizes[i]);
       if (!memory.ok()) {
         buffers[i].SetError(memory.status());
         return;
@@ -1314,7 +1326,8 @@ static absl::StatusOr<BufferInfo> MemoryForAllocation(
     const BufferAllocation& allocation,
     absl::Span<const cpu::ConstantAllocation> constants,
     absl::Span<std::pair<bool, TrackedCpuDeviceBuffer*> const> arguments,
-    BufferAlloc& buffer_alloc, BufferAllocAndCopy& buffer_alloc_and_copy) {
+    BufferAlloc& buffer_alloc, BufferAllocAndCopy& buffer_alloc_and_copy,
+    bool use_huge_pages_for_temp_buffers) {
   BufferInfo buffer_info;
   if (allocation.is_entry_computation_parameter()) {
     auto [can_donate, arg] = arguments[allocation.parameter_number()];
@@ -1367,6 +1380,8 @@ static absl::StatusOr<BufferInfo> MemoryForAllocation(
 
   buffer_alloc.buffers.push_back(out);
   buffer_alloc.allocation_sizes.push_back(allocation.size());
+  buffer_alloc.use_huge_pages.push_back(use_huge_pages_for_temp_buffers &&
+                                        allocation.IsPreallocatedTempBuffer());
 
   buffer_info.buffer = std::move(out);
   buffer_info.owns_buffer = true;
@@ -1378,14 +1393,16 @@ static absl::StatusOr<std::vector<BufferInfo>> CreateBufferTable(
     const BufferAssignment& assignment,
     absl::Span<const cpu::ConstantAllocation> constants,
     absl::Span<std::pair<bool, TrackedCpuDeviceBuffer*> const> arguments,
-    BufferAlloc& buffer_alloc, BufferAllocAndCopy& buffer_alloc_and_copy) {
+    BufferAlloc& buffer_alloc, BufferAllocAndCopy& buffer_alloc_and_copy,
+    bool use_huge_pages_for_temp_buffers) {
   std::vector<BufferInfo> buffer_table(assignment.Allocations().size());
   for (BufferAllocation::Index i = 0; i < buffer_table.size(); ++i) {
     const BufferAllocation& allocation = assignment.GetAllocation(i);
     TF_ASSIGN_OR_RETURN(
         buffer_table[i],
         MemoryForAllocation(allocation, constants, arguments, buffer_alloc,
-                            buffer_alloc_and_copy));
+                            buffer_alloc_and_copy,
+                            use_huge_pages_for_temp_buffers));
   }
   return std::move(buffer_table);
 }
@@ -1422,6 +1439,18 @@ absl::Status TfrtCpuExecutable::CheckBufferCompatibilities(
   return absl::OkStatus();
 }
 
+std::shared_ptr<DeviceAssignment>
+TfrtCpuExecutable::GetPortableDeviceAssignment(TfrtCpuDevice* device) {
+  absl::MutexLock lock(&portable_device_assignments_mu_);
+  std::shared_ptr<DeviceAssignment>& device_assignment =
+      portable_device_assignments_[device];
+  if (device_assignment == nullptr) {
+    device_assignment = std::make_shared<DeviceAssignment>(1, 1);
+    (*device_assignment)(0, 0) = device->id();
+  }
+  return device_assignment;
+}
+
 absl::StatusOr<PjRtLoadedExecutable::Result> TfrtCpuExecutable::ExecuteHelper(
     absl::Span<PjRtBuffer* const> argument_handles, int replica, int partition,
     const RunId& run_id, const ExecuteOptions& options,
@@ -1443,8 +1472,7 @@ absl::StatusOr<PjRtLoadedExecutable::Result> TfrtCpuExecutable::ExecuteHelper(
     CHECK_EQ(replica, 0);
     CHECK_EQ(partition, 0);
     CHECK(addressable_devices_.empty());
-    device_assignment = std::make_shared<DeviceAssignment>(1, 1);
-    (*device_assignment)(0, 0) = device->id();
+    device_assignment = GetPortableDeviceAssignment(device);
   }
   CHECK_EQ(device->process_index(), client_->process_index());
 
@@ -1484,9 +1512,13 @@ absl::StatusOr<PjRtLoadedExecutable::Result> TfrtCpuExecutable::ExecuteHelper(
 
   auto donate_it = parameters_that_must_be_donated_.begin();
 
-  // State for `TestBufferDonationClashes`.
+  // State for `TestBufferDonationClashes`. Clashes are impossible without
+  // donated parameters, so we skip tracking them for the common case.
+  bool check_donation_clashes = !parameters_that_must_be_donated_.empty();
   absl::flat_hash_map<const void*, std::pair<bool, int>> donation_clashes;
-  donation_clashes.reserve(argument_handles.size());
+  if (check_donation_clashes) {
+    donation_clashes.reserve(argument_handles.size());
+  }
   for (int i = 0; i < argument_handles.size(); ++i) {
     PjRtBuffer* handle = argument_handles[i];
     auto* tfrt_buffer = tensorflow::down_cast<TfrtCpuBuffer*>(handle);
@@ -1502,8 +1534,10 @@ absl::StatusOr<PjRtLoadedExecutable::Result> TfrtCpuExecutable::ExecuteHelper(
     auto get_buffer = [&](int i) -> absl::Status {
       bool must_donate = donate_it != parameters_that_must_be_donated_.end() &&
                          *donate_it == i;
-      TF_RETURN_IF_ERROR(TestBufferDonationClashes(
-          tfrt_buffer, donation_clashes, must_donate, i, replica, partition));
+      if (check_donation_clashes) {
+        TF_RETURN_IF_ERROR(TestBufferDonationClashes(
+            tfrt_buffer, donation_clashes, must_donate, i, replica, partition));
+      }
       if (must_donate) {
         ++donate_it;
         absl::StatusOr<TfrtCpuBuffer::DonationTransaction>
@@ -1583,11 +1617,18 @@ absl::StatusOr<PjRtLoadedExecutable::Result> TfrtCpuExecutable::ExecuteHelper(
   // allocation and copy work.
   BufferAlloc buffer_alloc;
   BufferAllocAndCopy buffer_alloc_and_copy;
+  bool use_huge_pages_for_temp_buffers =
+      cpu_executable->has_module() &&
+      cpu_executable->module()
+          .config()
+          .debug_options()
+          .xla_cpu_use_huge_pages_for_temp_buffers();
   TF_ASSIGN_OR_RETURN(
       std::vector<BufferInfo> buffer_table,
       CreateBufferTable(cpu_executable->buffer_assignment(),
                         cpu_executable->constants(), tracked_buffers,
-                        buffer_alloc, buffer_alloc_and_copy));
+                        buffer_alloc, buffer_alloc_and_copy,
+                        use_huge_pages_for_temp_buffers));
   auto result_buffers_info =
       CreateResultBufferInfo(result_buffer_indices_, buffer_table);
 
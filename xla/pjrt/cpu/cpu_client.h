@@ -291,7 +291,7 @@ class TfrtCpuClient final : public PjRtClient {
   // TODO(yueshengys): Consider moving the enqueuing/ordering logic to JAX via
   // token threading.
   inline static thread_local tsl::AsyncValueRef<CpuEvent> last_enqueue_event_ =
-      tsl::MakeAvailableAsyncValueRef<CpuEvent>();
+      tsl::GetAvailableAsyncValueRefSingleton<CpuEvent>();
 };
 
 class TfrtCpuBuffer final : public AbstractTfrtCpuBuffer {
@@ -451,6 +451,11 @@ class TfrtCpuExecutable final : public PjRtLoadedExecutable {
       tsl::AsyncValueRef<CpuEvent> last_collective_launch_event,
       bool fill_future, TfrtCpuDevice* device = nullptr);
 
+  // Returns a single-device assignment for executing a portable executable on
+  // `device`. Assignments are cached to keep them off the execute hot path.
+  std::shared_ptr<DeviceAssignment> GetPortableDeviceAssignment(
+      TfrtCpuDevice* device);
+
   TfrtCpuClient* client_;
 
   int num_replicas_;
@@ -477,6 +482,12 @@ class TfrtCpuExecutable final : public PjRtLoadedExecutable {
   // be donated when executing the computation.
   std::vector<int> parameters_that_must_be_donated_;
 
+  // Device assignments of portable executions, keyed by the device.
+  absl::Mutex portable_device_assignments_mu_;
+  absl::flat_hash_map<const TfrtCpuDevice*, std::shared_ptr<DeviceAssignment>>
+      portable_device_assignments_
+          ABSL_GUARDED_BY(portable_device_assignments_mu_);
+
   // The replica and partition indices of device_assignment_ to be run by this
   // client. On single-host platforms without partitioning, this is all
   // replicas (i.e. addressable_device_logical_ids_[i] = (i, 0)), but this may
@@ -151,6 +151,44 @@ ENTRY DonationWithExecutionError() -> f32[2, 2] {
               HasSubstr("buffer has been deleted or donated."));
 }
 
+TEST(TfrtCpuClientTest, AutoDonateInputBuffers) {
+  static constexpr char kProgram[] = R"(
+    HloModule AutoDonateInputBuffers
+
+    ENTRY main {
+      x = f32[2,2] parameter(0)
+      ROOT add = f32[2,2] add(x, x)
+    })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetTfrtCpuClient(CpuClientOptions()));
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module,
+                          ParseAndReturnUnverifiedModule(kProgram, {}));
+  XlaComputation xla_computation(hlo_module->ToProto());
+
+  CompileOptions options;
+  options.executable_build_options.mutable_debug_options()
+      ->set_xla_auto_donate_input_buffers(true);
+  TF_ASSERT_OK_AND_ASSIGN(auto pjrt_executable,
+                          client->CompileAndLoad(xla_computation, options));
+
+  Literal literal = LiteralUtil::CreateR2<float>({{1, 2}, {3, 4}});
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto buffer,
+      client->BufferFromHostLiteral(literal, client->memory_spaces()[0]));
+  TF_ASSERT_OK(buffer->GetReadyFuture().Await());
+
+  // The argument is not donated by the caller, but it aliases the result.
+  TF_ASSERT_OK_AND_ASSIGN(auto result,
+                          pjrt_executable->Execute({{buffer.get()}}, {}));
+  EXPECT_TRUE(buffer->IsDeleted());
+
+  ASSERT_EQ(result.size(), 1);
+  ASSERT_EQ(result[0].size(), 1);
+  TF_ASSERT_OK_AND_ASSIGN(auto result_literal, result[0][0]->ToLiteralSync());
+  EXPECT_TRUE(LiteralTestUtil::Equal(
+      LiteralUtil::CreateR2<float>({{2, 4}, {6, 8}}), *result_literal));
+}
+
 TEST(TfrtCpuClientTest, HloSnapshot) {
   static constexpr char kProgram[] = R"(
     HloModule add
@@ -771,6 +809,51 @@ TEST(TfrtCpuClientTest, SubByteLiteralToBufferRoundtrip) {
   EXPECT_TRUE(LiteralTestUtil::Equal(literal, literal_result));
 }
 
+TEST(TfrtCpuClientTest, ExecutePortableOnMultipleDevices) {
+  static constexpr char kProgram[] =
+      R"(
+HloModule Add
+ENTRY Add() -> f32[2] {
+    %p = f32[2] parameter(0)
+    ROOT %add = f32[2] add(%p, %p)
+})";
+
+  CpuClientOptions options;
+  options.cpu_device_count = 2;
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetTfrtCpuClient(options));
+
+  TF_ASSERT_OK_AND_ASSIGN(auto hlo_module,
+                          ParseAndReturnUnverifiedModule(kProgram, {}));
+  XlaComputation xla_computation(hlo_module->ToProto());
+
+  CompileOptions compile_options;
+  compile_options.compile_portable_executable = true;
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto pjrt_executable,
+      client->CompileAndLoad(xla_computation, compile_options));
+
+  // Portable executions reuse cached device assignments on repeated calls.
+  for (int i = 0; i < 4; ++i) {
+    PjRtDevice* device = client->addressable_devices()[i % 2];
+    TF_ASSERT_OK_AND_ASSIGN(auto* memory_space,
+                            device->default_memory_space());
+
+    Literal literal = LiteralUtil::CreateR1<float>({1.0f * i, 2.0f * i});
+    TF_ASSERT_OK_AND_ASSIGN(
+        auto buffer, client->BufferFromHostLiteral(literal, memory_space));
+
+    TF_ASSERT_OK_AND_ASSIGN(
+        auto result, pjrt_executable->ExecutePortable({buffer.get()}, device,
+                                                      /*options=*/{}));
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result[0]->device(), device);
+
+    TF_ASSERT_OK_AND_ASSIGN(auto result_literal, result[0]->ToLiteralSync());
+    EXPECT_TRUE(LiteralTestUtil::Equal(
+        LiteralUtil::CreateR1<float>({2.0f * i, 4.0f * i}), *result_literal));
+  }
+}
+
 }  // namespace
 
 //===----------------------------------------------------------------------===//
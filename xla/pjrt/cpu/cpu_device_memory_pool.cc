@@ -0,0 +1,162 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/cpu/cpu_device_memory_pool.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "absl/synchronization/mutex.h"
+#include "xla/backends/cpu/alignment.h"
+#include "xla/pjrt/metrics.h"
+#include "tsl/platform/mem.h"
+
+namespace xla {
+
+// Smallest size class, and the number of size classes per power of two.
+static constexpr size_t kMinClassBytes = 64;
+static constexpr int kMinClassLog2 = 6;
+static constexpr int kClassesPerPowerOfTwo = 4;
+
+// Size class of allocations that are never cached.
+static constexpr int32_t kUnpooled = -1;
+
+// Header in front of every allocation, that keeps the allocation aligned to
+// `cpu::Align()` and allows `Free` to find the owning pool and size class.
+struct CpuDeviceMemoryPool::Header {
+  CpuDeviceMemoryPool* pool;
+  int32_t size_class;
+};
+
+static constexpr size_t kHeaderBytes = cpu::Align();
+
+static int32_t SizeClassIndex(size_t size_bytes) {
+  if (size_bytes <= kMinClassBytes) return 0;
+  // Find the power of two `2^e <= size_bytes - 1 < 2^(e + 1)` and split it
+  // into `kClassesPerPowerOfTwo` equally sized steps.
+  int e = absl::bit_width(size_bytes - 1) - 1;
+  size_t step = size_t{1} << (e - 2);
+  size_t sub = (size_bytes - 1 - (size_t{1} << e)) / step;
+  return (e - kMinClassLog2) * kClassesPerPowerOfTwo + static_cast<int>(sub) +
+         1;
+}
+
+static size_t SizeClassIndexBytes(int32_t index) {
+  if (index == 0) return kMinClassBytes;
+  int e = kMinClassLog2 + (index - 1) / kClassesPerPowerOfTwo;
+  size_t sub = (index - 1) % kClassesPerPowerOfTwo;
+  return (size_t{1} << e) + (sub + 1) * (size_t{1} << (e - 2));
+}
+
+static const int32_t kNumSizeClasses =
+    SizeClassIndex(CpuDeviceMemoryPool::kMaxPooledBytes) + 1;
+
+CpuDeviceMemoryPool& CpuDeviceMemoryPool::Global() {
+  static auto* pool = new CpuDeviceMemoryPool();
+  return *pool;
+}
+
+CpuDeviceMemoryPool::CpuDeviceMemoryPool(size_t max_cached_bytes)
+    : max_cached_bytes_(max_cached_bytes), free_lists_(kNumSizeClasses) {}
+
+CpuDeviceMemoryPool::~CpuDeviceMemoryPool() {
+  absl::MutexLock lock(&mu_);
+  for (auto& free_list : free_lists_) {
+    for (Header* header : free_list) tsl::port::AlignedFree(header);
+  }
+}
+
+void CpuDeviceMemoryPool::ReserveCapacity(size_t max_cached_bytes) {
+  size_t current = max_cached_bytes_.load(std::memory_order_relaxed);
+  while (current < max_cached_bytes &&
+         !max_cached_bytes_.compare_exchange_weak(current, max_cached_bytes,
+                                                  std::memory_order_relaxed)) {
+  }
+}
+
+bool CpuDeviceMemoryPool::enabled() const {
+  return max_cached_bytes_.load(std::memory_order_relaxed) > 0;
+}
+
+size_t CpuDeviceMemoryPool::SizeClassBytes(size_t size_bytes) {
+  if (size_bytes > kMaxPooledBytes) return size_bytes;
+  return SizeClassIndexBytes(SizeClassIndex(size_bytes));
+}
+
+void* CpuDeviceMemoryPool::Allocate(size_t size_bytes) {
+  int32_t size_class =
+      size_bytes > kMaxPooledBytes ? kUnpooled : SizeClassIndex(size_bytes);
+
+  Header* header = nullptr;
+  if (size_class != kUnpooled) {
+    absl::MutexLock lock(&mu_);
+    std::vector<Header*>& free_list = free_lists_[size_class];
+    if (!free_list.empty()) {
+      header = free_list.back();
+      free_list.pop_back();
+      cached_bytes_ -= SizeClassIndexBytes(size_class);
+      metrics::RecordCpuDeviceMemoryPoolCachedBytes(cached_bytes_);
+    }
+  }
+
+  bool hit = header != nullptr;
+  (hit ? hits_ : misses_).fetch_add(1, std::memory_order_relaxed);
+  metrics::RecordCpuDeviceMemoryPoolAllocation(hit);
+
+  if (!hit) {
+    size_t bytes = size_class == kUnpooled ? size_bytes
+                                           : SizeClassIndexBytes(size_class);
+    void* data = tsl::port::AlignedMalloc(kHeaderBytes + bytes, cpu::Align());
+    if (data == nullptr) return nullptr;
+    header = new (data) Header{this, size_class};
+  }
+
+  return reinterpret_cast<std::byte*>(header) + kHeaderBytes;
+}
+
+void CpuDeviceMemoryPool::Free(void* data) {
+  if (data == nullptr) return;
+  auto* header = reinterpret_cast<Header*>(static_cast<std::byte*>(data) -
+                                           kHeaderBytes);
+  header->pool->Release(header);
+}
+
+void CpuDeviceMemoryPool::Release(Header* header) {
+  if (header->size_class != kUnpooled) {
+    size_t bytes = SizeClassIndexBytes(header->size_class);
+    size_t max_cached_bytes = max_cached_bytes_.load(std::memory_order_relaxed);
+
+    absl::MutexLock lock(&mu_);
+    if (cached_bytes_ + bytes <= max_cached_bytes) {
+      free_lists_[header->size_class].push_back(header);
+      cached_bytes_ += bytes;
+      metrics::RecordCpuDeviceMemoryPoolCachedBytes(cached_bytes_);
+      return;
+    }
+  }
+  tsl::port::AlignedFree(header);
+}
+
+CpuDeviceMemoryPool::Stats CpuDeviceMemoryPool::stats() const {
+  absl::MutexLock lock(&mu_);
+  return Stats{hits_.load(std::memory_order_relaxed),
+               misses_.load(std::memory_order_relaxed), cached_bytes_};
+}
+
+}  // namespace xla
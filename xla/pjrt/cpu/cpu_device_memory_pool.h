@@ -0,0 +1,95 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_PJRT_CPU_CPU_DEVICE_MEMORY_POOL_H_
+#define XLA_PJRT_CPU_CPU_DEVICE_MEMORY_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/synchronization/mutex.h"
+
+namespace xla {
+
+// A pool of CPU device memory that caches freed allocations in size classes
+// and reuses them for later allocations of a similar size. Programs executed
+// over and over allocate output buffers of the same sizes on every execution,
+// and the pool turns these allocations into free list operations.
+//
+// Size classes are spaced four per power of two, so an allocation wastes at
+// most 25% of its size. Allocations larger than `kMaxPooledBytes` are not
+// cached. The pool caches at most `max_cached_bytes` of free memory, and with
+// zero capacity it frees all memory immediately. This class is thread-safe.
+class CpuDeviceMemoryPool {
+ public:
+  // Allocations larger than this are never cached.
+  static constexpr size_t kMaxPooledBytes = 64 * 1024 * 1024;
+
+  struct Stats {
+    int64_t hits = 0;
+    int64_t misses = 0;
+    size_t cached_bytes = 0;
+  };
+
+  // Returns the process-wide pool used for CPU device memory allocations. The
+  // global pool is disabled (has zero capacity) unless a client enables it.
+  static CpuDeviceMemoryPool& Global();
+
+  explicit CpuDeviceMemoryPool(size_t max_cached_bytes = 0);
+  ~CpuDeviceMemoryPool();
+
+  CpuDeviceMemoryPool(const CpuDeviceMemoryPool&) = delete;
+  CpuDeviceMemoryPool& operator=(const CpuDeviceMemoryPool&) = delete;
+
+  // Increases the pool capacity to at least `max_cached_bytes`. The global pool
+  // is shared by all clients in the process, and the largest capacity wins.
+  void ReserveCapacity(size_t max_cached_bytes);
+
+  bool enabled() const;
+
+  // Allocates `size_bytes` of memory aligned to `cpu::Align()`. Returns nullptr
+  // if the allocation fails. Memory must be freed with `Free`, and the pool
+  // must outlive all of its allocations.
+  void* Allocate(size_t size_bytes);
+
+  // Returns memory to the pool that allocated it. Has the signature of the
+  // `CpuDeviceMemory::OwnedData` deleter.
+  static void Free(void* data);
+
+  Stats stats() const;
+
+  // Returns the number of bytes actually allocated for `size_bytes`.
+  static size_t SizeClassBytes(size_t size_bytes);
+
+ private:
+  struct Header;
+
+  void Release(Header* header);
+
+  std::atomic<size_t> max_cached_bytes_;
+  std::atomic<int64_t> hits_ = 0;
+  std::atomic<int64_t> misses_ = 0;
+
+  mutable absl::Mutex mu_;
+  size_t cached_bytes_ ABSL_GUARDED_BY(mu_) = 0;
+  std::vector<std::vector<Header*>> free_lists_ ABSL_GUARDED_BY(mu_);
+};
+
+}  // namespace xla
+
+#endif  // XLA_PJRT_CPU_CPU_DEVICE_MEMORY_POOL_H_
@@ -0,0 +1,125 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/cpu/cpu_device_memory_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "xla/backends/cpu/alignment.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/test_benchmark.h"
+
+namespace xla {
+namespace {
+
+TEST(CpuDeviceMemoryPoolTest, SizeClassBytes) {
+  EXPECT_EQ(CpuDeviceMemoryPool::SizeClassBytes(1), 64);
+  EXPECT_EQ(CpuDeviceMemoryPool::SizeClassBytes(64), 64);
+  EXPECT_EQ(CpuDeviceMemoryPool::SizeClassBytes(65), 80);
+  EXPECT_EQ(CpuDeviceMemoryPool::SizeClassBytes(81), 96);
+  EXPECT_EQ(CpuDeviceMemoryPool::SizeClassBytes(128), 128);
+  EXPECT_EQ(CpuDeviceMemoryPool::SizeClassBytes(129), 160);
+  EXPECT_EQ(CpuDeviceMemoryPool::SizeClassBytes(1000), 1024);
+
+  size_t max_pooled = CpuDeviceMemoryPool::kMaxPooledBytes;
+  EXPECT_EQ(CpuDeviceMemoryPool::SizeClassBytes(max_pooled), max_pooled);
+  EXPECT_EQ(CpuDeviceMemoryPool::SizeClassBytes(max_pooled + 1),
+            max_pooled + 1);
+}
+
+TEST(CpuDeviceMemoryPoolTest, ReusesFreedMemory) {
+  CpuDeviceMemoryPool pool(/*max_cached_bytes=*/1024 * 1024);
+  ASSERT_TRUE(pool.enabled());
+
+  void* data0 = pool.Allocate(1000);
+  ASSERT_NE(data0, nullptr);
+  std::memset(data0, 0xFF, 1000);
+  CpuDeviceMemoryPool::Free(data0);
+  EXPECT_EQ(pool.stats().cached_bytes, 1024);
+
+  // Allocation from the same size class reuses the cached memory.
+  void* data1 = pool.Allocate(900);
+  EXPECT_EQ(data1, data0);
+
+  CpuDeviceMemoryPool::Stats stats = pool.stats();
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 1);
+  EXPECT_EQ(stats.cached_bytes, 0);
+
+  CpuDeviceMemoryPool::Free(data1);
+}
+
+TEST(CpuDeviceMemoryPoolTest, ZeroCapacity) {
+  CpuDeviceMemoryPool pool;
+  EXPECT_FALSE(pool.enabled());
+
+  void* data = pool.Allocate(1000);
+  ASSERT_NE(data, nullptr);
+  CpuDeviceMemoryPool::Free(data);
+  EXPECT_EQ(pool.stats().cached_bytes, 0);
+
+  pool.ReserveCapacity(1024);
+  EXPECT_TRUE(pool.enabled());
+
+  // Smaller capacity does not shrink the pool.
+  pool.ReserveCapacity(1);
+  CpuDeviceMemoryPool::Free(pool.Allocate(1000));
+  EXPECT_EQ(pool.stats().cached_bytes, 1024);
+}
+
+TEST(CpuDeviceMemoryPoolTest, DoesNotCacheLargeAllocations) {
+  CpuDeviceMemoryPool pool(/*max_cached_bytes=*/size_t{1} << 30);
+
+  void* data = pool.Allocate(CpuDeviceMemoryPool::kMaxPooledBytes + 1);
+  ASSERT_NE(data, nullptr);
+  CpuDeviceMemoryPool::Free(data);
+  EXPECT_EQ(pool.stats().cached_bytes, 0);
+}
+
+TEST(CpuDeviceMemoryPoolTest, Alignment) {
+  CpuDeviceMemoryPool pool(/*max_cached_bytes=*/1024 * 1024);
+  for (size_t size : {1, 17, 64, 100, 4096, 100000}) {
+    void* data = pool.Allocate(size);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(data) % cpu::Align(), 0);
+    CpuDeviceMemoryPool::Free(data);
+  }
+}
+
+//===----------------------------------------------------------------------===//
+// Performance benchmarks.
+//===----------------------------------------------------------------------===//
+
+static void BM_AllocateAndFree(benchmark::State& state) {
+  CpuDeviceMemoryPool pool(/*max_cached_bytes=*/state.range(0));
+  size_t size = state.range(1);
+
+  for (auto _ : state) {
+    void* data = pool.Allocate(size);
+    benchmark::DoNotOptimize(data);
+    CpuDeviceMemoryPool::Free(data);
+  }
+}
+
+BENCHMARK(BM_AllocateAndFree)
+    ->ArgNames({"capacity", "size"})
+    ->Args({0, 1024})
+    ->Args({0, 1024 * 1024})
+    ->Args({64 * 1024 * 1024, 1024})
+    ->Args({64 * 1024 * 1024, 1024 * 1024});
+
+}  // namespace
+}  // namespace xla
@@ -28,8 +28,10 @@ limitations under the License.
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/backends/cpu/alignment.h"
+#include "xla/pjrt/cpu/cpu_device_memory_pool.h"
 #include "xla/pjrt/cpu/cpu_event.h"
 #include "xla/shape_util.h"
+#include "xla/stream_executor/host/huge_pages.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/util.h"
@@ -43,7 +45,9 @@ namespace {
 // propagated through the returned async value.
 tsl::AsyncValueRef<CpuEvent> AfterAll(
     absl::Span<const tsl::AsyncValueRef<CpuEvent>> events) {
-  if (events.empty()) return tsl::MakeAvailableAsyncValueRef<CpuEvent>();
+  if (events.empty()) {
+    return tsl::GetAvailableAsyncValueRefSingleton<CpuEvent>();
+  }
 
   struct State {
     State(int count, tsl::AsyncValueRef<CpuEvent> after_all)
@@ -100,6 +104,16 @@ CpuDeviceMemory::AllocateAvailable(size_t size_bytes) {
 
 // Allocates raw owning memory. The typical usage is for delayed allocation.
 absl::StatusOr<CpuDeviceMemory> CpuDeviceMemory::Allocate(size_t size_bytes) {
+  if (CpuDeviceMemoryPool& pool = CpuDeviceMemoryPool::Global();
+      pool.enabled()) {
+    if (void* data = pool.Allocate(size_bytes)) {
+      return CpuDeviceMemory(
+          OwnedData{static_cast<uint8_t*>(data), CpuDeviceMemoryPool::Free},
+          size_bytes);
+    }
+    return ResourceExhausted("Out of memory allocating %d bytes.", size_bytes);
+  }
+
   if (void* data = tsl::port::AlignedMalloc(size_bytes, cpu::MinAlign())) {
     return CpuDeviceMemory(
         OwnedData{static_cast<uint8_t*>(data), tsl::port::AlignedFree},
@@ -108,6 +122,19 @@ absl::StatusOr<CpuDeviceMemory> CpuDeviceMemory::Allocate(size_t size_bytes) {
   return ResourceExhausted("Out of memory allocating %d bytes.", size_bytes);
 }
 
+absl::StatusOr<CpuDeviceMemory> CpuDeviceMemory::AllocateHugePages(
+    size_t size_bytes) {
+  if (size_bytes < stream_executor::host::kHugePageSize) {
+    return Allocate(size_bytes);
+  }
+  if (void* data = stream_executor::host::HugePageAllocate(size_bytes)) {
+    return CpuDeviceMemory(OwnedData{static_cast<uint8_t*>(data),
+                                     stream_executor::host::HugePageFree},
+                           size_bytes);
+  }
+  return ResourceExhausted("Out of memory allocating %d bytes.", size_bytes);
+}
+
 TrackedCpuDeviceBuffer::TrackedCpuDeviceBuffer(
     bool is_tuple, bool owns_buffers,
     absl::InlinedVector<tsl::AsyncValueRef<CpuDeviceMemory>, 4> buffers,
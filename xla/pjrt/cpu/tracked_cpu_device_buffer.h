@@ -54,6 +54,12 @@ class CpuDeviceMemory {
   // Allocates raw owning memory. The typical usage is for delayed allocation.
   static absl::StatusOr<CpuDeviceMemory> Allocate(size_t size_bytes);
 
+  // Allocates raw owning memory aligned to the huge page size and advises the
+  // OS to back it with transparent huge pages. Large temporary buffers are
+  // accessed all over during execution, and huge pages reduce TLB misses.
+  // Allocations smaller than a huge page fall back to `Allocate`.
+  static absl::StatusOr<CpuDeviceMemory> AllocateHugePages(size_t size_bytes);
+
   void* untyped_data() const { return data_; }
   size_t size_bytes() const { return size_bytes_; }
 
@@ -15,11 +15,14 @@ limitations under the License.
 
 #include "xla/pjrt/cpu/tracked_cpu_device_buffer.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <string>
 
 #include <gtest/gtest.h>
 #include "xla/pjrt/cpu/cpu_event.h"
+#include "xla/stream_executor/host/huge_pages.h"
 #include "xla/tsl/concurrency/async_value.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/tsl/platform/env.h"
@@ -255,5 +258,21 @@ TEST(TrackedCpuDeviceBufferTest, DelayedAllocationTuple) {
             expected_1);
 }
 
+TEST(TrackedCpuDeviceBufferTest, AllocateHugePages) {
+  constexpr size_t kSize = 3 * stream_executor::host::kHugePageSize + 1;
+  TF_ASSERT_OK_AND_ASSIGN(CpuDeviceMemory memory,
+                          CpuDeviceMemory::AllocateHugePages(kSize));
+  EXPECT_EQ(memory.size_bytes(), kSize);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(memory.untyped_data()) %
+                stream_executor::host::kHugePageSize,
+            0);
+  std::memset(memory.untyped_data(), 1, kSize);
+
+  // Small allocations don't need huge page alignment.
+  TF_ASSERT_OK_AND_ASSIGN(CpuDeviceMemory small,
+                          CpuDeviceMemory::AllocateHugePages(64));
+  EXPECT_EQ(small.size_bytes(), 64);
+}
+
 }  // namespace
 }  // namespace xla
@@ -16,13 +16,17 @@ limitations under the License.
 #include "xla/pjrt/distributed/in_memory_key_value_store.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 
 namespace xla {
 
@@ -65,4 +69,45 @@ absl::Status InMemoryKeyValueStore::Set(absl::string_view key,
   return absl::OkStatus();
 }
 
+absl::StatusOr<std::vector<std::string>> InMemoryKeyValueStore::MultiGet(
+    absl::Span<const std::string> keys, absl::Duration timeout) {
+  absl::MutexLock lock(&mu_);
+  auto cond = [&]() {
+    mu_.AssertHeld();
+    return absl::c_all_of(
+        keys, [&](const std::string& key) { return kv_store_.contains(key); });
+  };
+  if (!mu_.AwaitWithTimeout(absl::Condition(&cond), timeout)) {
+    for (const std::string& key : keys) {
+      if (!kv_store_.contains(key)) {
+        return absl::NotFoundError(
+            absl::StrCat(key, " is not found in the kv store."));
+      }
+    }
+  }
+  std::vector<std::string> values;
+  values.reserve(keys.size());
+  for (const std::string& key : keys) {
+    values.push_back(kv_store_.find(key)->second);
+  }
+  return values;
+}
+
+absl::Status InMemoryKeyValueStore::MultiSet(
+    absl::Span<const std::pair<std::string, std::string>> kvs) {
+  absl::MutexLock lock(&mu_);
+  if (!allow_overwrite_) {
+    for (const auto& [key, value] : kvs) {
+      if (kv_store_.contains(key)) {
+        return absl::AlreadyExistsError(
+            absl::StrCat(key, " already exists in the kv store."));
+      }
+    }
+  }
+  for (const auto& [key, value] : kvs) {
+    kv_store_[key] = value;
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace xla
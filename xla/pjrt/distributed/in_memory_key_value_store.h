@@ -17,6 +17,8 @@ limitations under the License.
 #define XLA_PJRT_DISTRIBUTED_IN_MEMORY_KEY_VALUE_STORE_H_
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
@@ -24,6 +26,7 @@ limitations under the License.
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "xla/pjrt/distributed/key_value_store_interface.h"
 
 namespace xla {
@@ -42,6 +45,12 @@ class InMemoryKeyValueStore : public KeyValueStoreInterface {
 
   absl::Status Set(absl::string_view key, absl::string_view value) override;
 
+  absl::StatusOr<std::vector<std::string>> MultiGet(
+      absl::Span<const std::string> keys, absl::Duration timeout) override;
+
+  absl::Status MultiSet(
+      absl::Span<const std::pair<std::string, std::string>> kvs) override;
+
  private:
   absl::Mutex mu_;
   absl::flat_hash_map<std::string, std::string> kv_store_ ABSL_GUARDED_BY(mu_);
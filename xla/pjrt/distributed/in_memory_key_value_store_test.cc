@@ -0,0 +1,63 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/distributed/in_memory_key_value_store.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/status/status.h"
+#include "absl/time/time.h"
+#include "xla/tsl/platform/status_matchers.h"
+
+namespace xla {
+namespace {
+
+using ::testing::ElementsAre;
+using ::tsl::testing::IsOk;
+using ::tsl::testing::IsOkAndHolds;
+using ::tsl::testing::StatusIs;
+
+TEST(InMemoryKeyValueStoreTest, MultiSetAndMultiGet) {
+  InMemoryKeyValueStore store;
+  ASSERT_THAT(store.MultiSet({{"a", "1"}, {"b", "2"}}), IsOk());
+  ASSERT_THAT(store.Set("c", "3"), IsOk());
+
+  EXPECT_THAT(store.MultiGet({"c", "a", "b"}, absl::Seconds(1)),
+              IsOkAndHolds(ElementsAre("3", "1", "2")));
+}
+
+TEST(InMemoryKeyValueStoreTest, MultiGetReportsMissingKey) {
+  InMemoryKeyValueStore store;
+  ASSERT_THAT(store.Set("a", "1"), IsOk());
+
+  EXPECT_THAT(store.MultiGet({"a", "b"}, absl::Milliseconds(10)),
+              StatusIs(absl::StatusCode::kNotFound));
+}
+
+TEST(InMemoryKeyValueStoreTest, MultiSetWithoutOverwriteIsAtomic) {
+  InMemoryKeyValueStore store(/*allow_overwrite=*/false);
+  ASSERT_THAT(store.Set("b", "2"), IsOk());
+
+  EXPECT_THAT(store.MultiSet({{"a", "1"}, {"b", "3"}}),
+              StatusIs(absl::StatusCode::kAlreadyExists));
+  EXPECT_THAT(store.TryGet("a"), StatusIs(absl::StatusCode::kNotFound));
+}
+
+}  // namespace
+}  // namespace xla
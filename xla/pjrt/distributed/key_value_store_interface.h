@@ -16,13 +16,18 @@ limitations under the License.
 #ifndef XLA_PJRT_DISTRIBUTED_KEY_VALUE_STORE_INTERFACE_H_
 #define XLA_PJRT_DISTRIBUTED_KEY_VALUE_STORE_INTERFACE_H_
 
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
 #include "absl/time/time.h"
+#include "absl/types/span.h"
 
 namespace xla {
 
@@ -51,6 +56,38 @@ class KeyValueStoreInterface {
   virtual absl::StatusOr<std::string> TryGet(absl::string_view key) = 0;
 
   virtual absl::Status Set(absl::string_view key, absl::string_view value) = 0;
+
+  // Blocking Get() of several keys, which all have to become available within
+  // `timeout`. Returns the values in the order of `keys`. Implementations
+  // should override this if they can fetch several keys in one round trip.
+  virtual absl::StatusOr<std::vector<std::string>> MultiGet(
+      absl::Span<const std::string> keys, absl::Duration timeout) {
+    const absl::Time deadline = absl::Now() + timeout;
+    std::vector<std::string> values;
+    values.reserve(keys.size());
+    for (const std::string& key : keys) {
+      absl::StatusOr<std::string> value =
+          Get(key, std::max(deadline - absl::Now(), absl::ZeroDuration()));
+      if (!value.ok()) {
+        return value.status();
+      }
+      values.push_back(*std::move(value));
+    }
+    return values;
+  }
+
+  // Sets several key-value pairs. Implementations should override this if they
+  // can set several keys in one round trip.
+  virtual absl::Status MultiSet(
+      absl::Span<const std::pair<std::string, std::string>> kvs) {
+    for (const auto& [key, value] : kvs) {
+      absl::Status status = Set(key, value);
+      if (!status.ok()) {
+        return status;
+      }
+    }
+    return absl::OkStatus();
+  }
 };
 
 struct MultiProcessKeyValueStore {
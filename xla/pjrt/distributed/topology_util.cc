@@ -16,6 +16,8 @@ limitations under the License.
 #include "xla/pjrt/distributed/topology_util.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <map>
 #include <set>
@@ -28,6 +30,7 @@ limitations under the License.
 #include "absl/strings/ascii.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
 #include "absl/strings/substitute.h"
 #include "absl/synchronization/blocking_counter.h"
 #include "absl/synchronization/mutex.h"
@@ -43,6 +46,7 @@ limitations under the License.
 #include "tsl/platform/logging.h"
 #include "tsl/platform/statusor.h"
 #include "tsl/platform/threadpool.h"
+#include "zlib.h"
 
 namespace xla {
 
@@ -105,6 +109,52 @@ static std::string GetGlobalTopologyKey(absl::string_view platform) {
   return absl::StrCat("global_topology/", platform);
 }
 
+// The global topology grows linearly with the number of nodes and is read by
+// every node, so it is stored zlib-compressed in the key-value store, prefixed
+// with its uncompressed size.
+static absl::StatusOr<std::string> CompressGlobalTopology(
+    const GlobalTopologyProto& global_topology) {
+  const std::string serialized = global_topology.SerializeAsString();
+  const uint64_t serialized_size = serialized.size();
+  uLongf compressed_size = compressBound(serialized.size());
+  std::string compressed(sizeof(serialized_size) + compressed_size, '\0');
+  std::memcpy(compressed.data(), &serialized_size, sizeof(serialized_size));
+  int err = compress2(
+      reinterpret_cast<Bytef*>(compressed.data() + sizeof(serialized_size)),
+      &compressed_size, reinterpret_cast<const Bytef*>(serialized.data()),
+      serialized.size(), Z_BEST_SPEED);
+  if (err != Z_OK) {
+    return absl::InternalError(
+        absl::StrCat("Failed to compress global topology: zlib error ", err));
+  }
+  compressed.resize(sizeof(serialized_size) + compressed_size);
+  return compressed;
+}
+
+static absl::Status DecompressGlobalTopology(
+    absl::string_view compressed, GlobalTopologyProto* global_topology) {
+  uint64_t serialized_size;
+  if (compressed.size() < sizeof(serialized_size)) {
+    return absl::InternalError("Truncated global topology");
+  }
+  std::memcpy(&serialized_size, compressed.data(), sizeof(serialized_size));
+  compressed.remove_prefix(sizeof(serialized_size));
+  std::string serialized(serialized_size, '\0');
+  uLongf uncompressed_size = serialized_size;
+  int err = uncompress(reinterpret_cast<Bytef*>(serialized.data()),
+                       &uncompressed_size,
+                       reinterpret_cast<const Bytef*>(compressed.data()),
+                       compressed.size());
+  if (err != Z_OK || uncompressed_size != serialized_size) {
+    return absl::InternalError(
+        absl::StrCat("Failed to decompress global topology: zlib error ", err));
+  }
+  if (!global_topology->ParseFromString(serialized)) {
+    return absl::InternalError("Failed to parse global topology");
+  }
+  return absl::OkStatus();
+}
+
 static absl::StatusOr<std::vector<LocalTopologyProto>> GetAllLocalTopologies(
     absl::string_view platform, int num_nodes, KeyValueStoreInterface* kv_store,
     absl::Duration timeout) {
@@ -242,13 +292,16 @@ absl::Status ExchangeTopologies(absl::string_view platform, int node_id,
     *global_topology =
         BuildGlobalTopology(absl::Span<LocalTopologyProto>(local_topologies),
                             assign_global_device_ids);
-    TF_RETURN_IF_ERROR(kv_store->Set(global_topology_key,
-                                     global_topology->SerializeAsString()));
+    TF_ASSIGN_OR_RETURN(std::string compressed_global_topology,
+                        CompressGlobalTopology(*global_topology));
+    TF_RETURN_IF_ERROR(
+        kv_store->Set(global_topology_key, compressed_global_topology));
   } else {
     TF_ASSIGN_OR_RETURN(
         std::string global_topology_str,
         kv_store->Get(global_topology_key, get_global_topology_timeout));
-    global_topology->ParseFromString(global_topology_str);
+    TF_RETURN_IF_ERROR(
+        DecompressGlobalTopology(global_topology_str, global_topology));
   }
   VLOG(3) << "Global topology for platform " << platform << ":\n"
           << global_topology->DebugString();
@@ -89,6 +89,43 @@ TEST(TopologyTest, ExchangeTopology) {
   }
 }
 
+TEST(TopologyTest, ExchangeTopology_StoresCompressedGlobalTopology) {
+  int num_nodes = 32;
+  std::vector<LocalTopologyProto> locals(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) {
+    locals[i].set_node_id(i);
+    for (int j = 0; j < 8; ++j) {
+      DeviceProto* device = locals[i].add_devices();
+      device->set_local_device_ordinal(j);
+      device->set_device_kind("NVIDIA H100 80GB HBM3");
+    }
+  }
+
+  InMemoryKeyValueStore kv_store;
+  std::vector<GlobalTopologyProto> globals(num_nodes);
+  {
+    tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "TestPool",
+                                        num_nodes);
+    for (int i = 0; i < num_nodes; i++) {
+      thread_pool.Schedule([&, i] {
+        TF_ASSERT_OK(ExchangeTopologies(
+            /*platform=*/"cuda", /*node_id=*/i, num_nodes,
+            /*get_local_topology_timeout=*/
+            absl::Seconds(10), /*get_global_topology_timeout=*/
+            absl::Seconds(10), &kv_store, locals[i], &globals[i],
+            /*assign_global_device_ids=*/true));
+      });
+    }
+  }
+  for (const GlobalTopologyProto& global : globals) {
+    EXPECT_EQ(global.SerializeAsString(), globals[0].SerializeAsString());
+    EXPECT_EQ(global.nodes_size(), num_nodes);
+  }
+  TF_ASSERT_OK_AND_ASSIGN(std::string stored,
+                          kv_store.TryGet("global_topology/cuda"));
+  EXPECT_LT(stored.size(), globals[0].ByteSizeLong());
+}
+
 TEST(TopologyTest, ExchangeTopology_Twice_Succeeds) {
   int num_nodes = 2;
   std::vector<LocalTopologyProto> locals(num_nodes);
@@ -36,6 +36,7 @@ limitations under the License.
 #include "xla/client/client_library.h"
 #include "xla/client/local_client.h"
 #include "xla/service/platform_util.h"
+#include "xla/stream_executor/host/huge_pages.h"
 #include "xla/stream_executor/integrations/device_mem_allocator.h"
 #include "xla/stream_executor/integrations/stream_executor_allocator.h"
 #include "xla/stream_executor/platform.h"
@@ -49,6 +50,67 @@ limitations under the License.
 #include "xla/util.h"
 
 namespace xla {
+namespace {
+
+// Allocates pinned host memory backed by transparent huge pages: memory is
+// allocated with huge page alignment and then registered with the GPU driver,
+// instead of being allocated by the driver with regular pages.
+class HugePageHostMemoryAllocator : public tsl::SubAllocator {
+ public:
+  explicit HugePageHostMemoryAllocator(se::StreamExecutor* executor)
+      : tsl::SubAllocator(/*alloc_visitors=*/{}, /*free_visitors=*/{}),
+        executor_(executor) {}
+
+  void* Alloc(size_t alignment, size_t num_bytes,
+              size_t* bytes_received) override {
+    *bytes_received = 0;
+    if (num_bytes == 0) {
+      return nullptr;
+    }
+    void* ptr = se::host::HugePageAllocate(num_bytes);
+    if (ptr == nullptr) {
+      LOG(WARNING) << "could not allocate host memory of size: " << num_bytes;
+      return nullptr;
+    }
+    if (!executor_->HostMemoryRegister(ptr, num_bytes)) {
+      LOG(WARNING) << "could not pin host memory of size: " << num_bytes;
+      se::host::HugePageFree(ptr);
+      return nullptr;
+    }
+    // Registration faults in all pages, so the huge page coverage is known.
+    if (VLOG_IS_ON(1)) {
+      absl::StatusOr<size_t> backed_bytes =
+          se::host::GetHugePageBackedBytes(ptr, num_bytes);
+      VLOG(1) << "Allocated " << num_bytes << " bytes of pinned host memory, "
+              << (backed_bytes.ok() ? absl::StrCat(*backed_bytes)
+                                    : backed_bytes.status().ToString())
+              << " bytes backed by huge pages";
+    }
+    VisitAlloc(ptr, /*index=*/0, num_bytes);
+    *bytes_received = num_bytes;
+    return ptr;
+  }
+
+  void Free(void* ptr, size_t num_bytes) override {
+    if (ptr == nullptr) {
+      return;
+    }
+    VisitFree(ptr, /*index=*/0, num_bytes);
+    executor_->HostMemoryUnregister(ptr);
+    se::host::HugePageFree(ptr);
+  }
+
+  bool SupportsCoalescing() const override { return false; }
+
+  tsl::AllocatorMemoryType GetMemoryType() const override {
+    return tsl::AllocatorMemoryType::kHostPinned;
+  }
+
+ private:
+  se::StreamExecutor* executor_;
+};
+
+}  // namespace
 
 // Builds an xla::LocalClient for the GPU platform.
 absl::StatusOr<LocalClient*> GetGpuXlaClient(
@@ -90,7 +152,8 @@ void EnablePeerAccess(absl::Span<se::StreamExecutor* const> executors) {
 // Builds a BFCAllocator for all local GPUs.
 absl::StatusOr<std::unique_ptr<tsl::BFCAllocator>> CreateBFCAllocator(
     se::StreamExecutor* executor, double memory_fraction, bool preallocate,
-    std::optional<int64_t> gpu_system_memory_size) {
+    std::optional<int64_t> gpu_system_memory_size, bool garbage_collection,
+    size_t small_allocation_threshold) {
   bool enable_unified_memory;
   absl::Status status = tsl::ReadBoolFromEnvVar("TF_FORCE_UNIFIED_MEMORY",
                                                 false, &enable_unified_memory);
@@ -142,6 +205,8 @@ absl::StatusOr<std::unique_ptr<tsl::BFCAllocator>> CreateBFCAllocator(
 
   tsl::BFCAllocator::Options opts;
   opts.allow_growth = !preallocate;
+  opts.garbage_collection = garbage_collection;
+  opts.small_allocation_threshold = small_allocation_threshold;
   return std::make_unique<tsl::BFCAllocator>(
       std::move(sub_allocator), allocator_memory,
       absl::StrCat("GPU_", device_ordinal, "_bfc"), opts);
@@ -196,17 +261,30 @@ absl::StatusOr<std::unique_ptr<tsl::BFCAllocator>> CreateCollectiveBFCAllocator(
 // preallocated, and the preallocated size is controlled by
 // XLA_PJRT_GPU_HOST_MEMORY_LIMIT_GB environment variable, which defaults to
 // 16GB in this case.
+//
+// If XLA_PJRT_GPU_HOST_MEMORY_HUGE_PAGES is set to true, the pool is backed by
+// transparent huge pages.
 absl::StatusOr<std::unique_ptr<tsl::BFCAllocator>> GetGpuHostAllocator(
     se::StreamExecutor* executor) {
-  TF_ASSIGN_OR_RETURN(
-      auto host_memory_allocator,
-      executor->CreateMemoryAllocator(stream_executor::MemoryType::kHost));
-  std::unique_ptr<tsl::SubAllocator> sub_allocator(
-      new se::StreamExecutorAllocator(std::move(host_memory_allocator),
-                                      stream_executor::MemoryType::kHost,
-                                      /*index=*/0,
-                                      /*alloc_visitors=*/{},
-                                      /*free_visitors=*/{}));
+  bool xla_pjrt_gpu_host_memory_huge_pages;
+  TF_RETURN_IF_ERROR(
+      tsl::ReadBoolFromEnvVar("XLA_PJRT_GPU_HOST_MEMORY_HUGE_PAGES", false,
+                              &xla_pjrt_gpu_host_memory_huge_pages));
+
+  std::unique_ptr<tsl::SubAllocator> sub_allocator;
+  if (xla_pjrt_gpu_host_memory_huge_pages) {
+    sub_allocator = std::make_unique<HugePageHostMemoryAllocator>(executor);
+  } else {
+    TF_ASSIGN_OR_RETURN(
+        auto host_memory_allocator,
+        executor->CreateMemoryAllocator(stream_executor::MemoryType::kHost));
+    sub_allocator.reset(
+        new se::StreamExecutorAllocator(std::move(host_memory_allocator),
+                                        stream_executor::MemoryType::kHost,
+                                        /*index=*/0,
+                                        /*alloc_visitors=*/{},
+                                        /*free_visitors=*/{}));
+  }
   bool xla_pjrt_gpu_host_memory_preallocate;
   TF_RETURN_IF_ERROR(
       tsl::ReadBoolFromEnvVar("XLA_PJRT_GPU_HOST_MEMORY_PREALLOCATE", false,
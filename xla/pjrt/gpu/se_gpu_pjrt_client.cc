@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/pjrt/gpu/se_gpu_pjrt_client.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -130,6 +131,12 @@ limitations under the License.
 #include "xla/util.h"
 
 namespace xla {
+
+// Staged host-to-device transfers are split into chunks of at most this size,
+// so that large transfers go through a bounded pinned staging buffer instead of
+// allocating one as large as the transfer.
+constexpr int64_t kMaxStagingChunkSize = int64_t{64} << 20;
+
 class AsyncHostToDeviceTransferManager
     : public xla::PjRtClient::AsyncHostToDeviceTransferManager {
  public:
@@ -358,7 +365,8 @@ class AsyncHostToDeviceTransferManager
       }
 
       void* ptr = host_memory_allocator->AllocateRaw(
-          tsl::Allocator::kAllocatorAlignment, transfer_size);
+          tsl::Allocator::kAllocatorAlignment,
+          std::min(transfer_size, kMaxStagingChunkSize));
       staging_buffer = std::shared_ptr<void>(
           ptr, [host_memory_allocator = host_memory_allocator](void* ptr) {
             host_memory_allocator->DeallocateRaw(ptr);
@@ -405,19 +413,31 @@ class AsyncHostToDeviceTransferManager
 
     if (transfer_size != 0) {
       if (staging_buffer != nullptr) {
-        auto copy_to_staging_buffer = [data, transfer_size,
-                                       staging_buffer]() mutable {
-          std::memcpy(staging_buffer.get(), data, transfer_size);
-        };
-        if (auto status =
-                stream->DoHostCallback(std::move(copy_to_staging_buffer));
-            !status.ok()) {
-          return status;
-        }
-        if (auto status = stream->Memcpy(&sub_buffer, staging_buffer.get(),
-                                         transfer_size);
-            !status.ok()) {
-          return status;
+        // All chunks go through the same staging buffer. Stream order
+        // guarantees that a chunk is copied to the device before the next one
+        // overwrites the staging buffer.
+        for (int64_t chunk_offset = 0; chunk_offset < transfer_size;
+             chunk_offset += kMaxStagingChunkSize) {
+          int64_t chunk_size =
+              std::min(kMaxStagingChunkSize, transfer_size - chunk_offset);
+          const char* chunk_data =
+              static_cast<const char*>(data) + chunk_offset;
+          auto copy_to_staging_buffer = [chunk_data, chunk_size,
+                                         staging_buffer]() mutable {
+            std::memcpy(staging_buffer.get(), chunk_data, chunk_size);
+          };
+          if (auto status =
+                  stream->DoHostCallback(std::move(copy_to_staging_buffer));
+              !status.ok()) {
+            return status;
+          }
+          se::DeviceMemoryBase device_chunk =
+              sub_buffer.GetByteSlice(chunk_offset, chunk_size);
+          if (auto status = stream->Memcpy(&device_chunk,
+                                           staging_buffer.get(), chunk_size);
+              !status.ok()) {
+            return status;
+          }
         }
       } else if (auto status = stream->Memcpy(&sub_buffer, data, transfer_size);
                  !status.ok()) {
@@ -871,9 +891,28 @@ PjRtFuture<> StreamExecutorGpuClient::CopyRawDeviceToHost(
       });
 }
 
+// Returns the number of devices in the first stage of the BlueConnect
+// all-reduce decomposition for `topology`: the devices of a slice, which share
+// the fastest interconnect. Returns 0 if the decomposition does not apply,
+// i.e. for single-slice or asymmetric topologies.
+static int32_t GetBlueConnectNumDevicesPerStage(const GpuTopology& topology) {
+  if (topology.number_of_hosts() < 0 || topology.num_slices() < 2) {
+    return 0;
+  }
+  return topology.num_hosts_per_slice() * topology.num_devices_per_host();
+}
+
 absl::StatusOr<std::unique_ptr<PjRtLoadedExecutable>>
 StreamExecutorGpuClient::CompileAndLoad(const XlaComputation& computation,
                                         CompileOptions options) {
+  DebugOptions& debug_options =
+      *options.executable_build_options.mutable_debug_options();
+  if (debug_options.xla_gpu_all_reduce_blueconnect_use_topology() &&
+      debug_options.xla_gpu_all_reduce_blueconnect_num_devices_per_host() < 1) {
+    debug_options.set_xla_gpu_all_reduce_blueconnect_num_devices_per_host(
+        GetBlueConnectNumDevicesPerStage(topology_.gpu_topology()));
+  }
+
   auto executable =
       PjRtStreamExecutorClient::CompileAndLoad(computation, options);
 
@@ -1044,7 +1083,9 @@ GetStreamExecutorGpuDeviceAllocator(
             CreateBFCAllocator(ordinal_and_device.second->executor(),
                                allocator_config.memory_fraction,
                                allocator_config.preallocate,
-                               allocator_config.gpu_system_memory_size));
+                               allocator_config.gpu_system_memory_size,
+                               allocator_config.garbage_collection,
+                               allocator_config.small_allocation_threshold));
         allocators.emplace_back(std::move(bfc_allocator),
                                 ordinal_and_device.second->compute_stream(),
                                 /*memory_space=*/0);
@@ -27,6 +27,7 @@ limitations under the License.
 #include <string>
 #include <tuple>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -57,6 +58,7 @@ limitations under the License.
 #include "xla/pjrt/gpu/gpu_topology.h"
 #include "xla/pjrt/gpu/gpu_topology.pb.h"
 #include "xla/pjrt/host_memory_spaces.h"
+#include "xla/pjrt/local_device_state.h"
 #include "xla/pjrt/mlir_to_hlo.h"
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/pjrt/pjrt_compiler.h"
@@ -73,6 +75,7 @@ limitations under the License.
 #include "xla/status_macros.h"
 #include "xla/stream_executor/cuda/cuda_compute_capability.h"
 #include "xla/stream_executor/device_memory.h"
+#include "xla/stream_executor/platform.h"
 #include "xla/stream_executor/stream.h"
 #include "xla/tests/literal_test_util.h"
 #include "xla/tsl/lib/core/status_test_util.h"
@@ -2101,6 +2104,31 @@ TEST(StreamExecutorGpuClientTest, DmaMapUnmap) {
   free(host_dma_ptr);
 }
 
+TEST(StreamExecutorGpuClientTest, StreamPriorities) {
+  TF_ASSERT_OK_AND_ASSIGN(auto gpu_client,
+                          GetStreamExecutorGpuClient(GpuClientOptions()));
+  auto* client =
+      tensorflow::down_cast<PjRtStreamExecutorClient*>(gpu_client.get());
+  se::StreamExecutor* executor =
+      client->client()->backend().stream_executors()[0];
+
+  LocalDeviceState::StreamOptions stream_options;
+  stream_options.compute_priority = se::StreamPriority::Highest;
+  stream_options.transfer_priority = se::StreamPriority::Lowest;
+  LocalDeviceState local_device_state(
+      executor, client->client(), LocalDeviceState::kComputeSynchronized,
+      /*max_inflight_computations=*/32, /*allow_event_reuse=*/true,
+      /*use_callback_stream=*/true, /*device_ordinal=*/-1, stream_options);
+
+  using Priority = std::variant<se::StreamPriority, int>;
+  EXPECT_EQ(local_device_state.compute_stream()->priority(),
+            Priority(se::StreamPriority::Highest));
+  EXPECT_EQ(local_device_state.host_to_device_stream()->priority(),
+            Priority(se::StreamPriority::Lowest));
+  EXPECT_EQ(local_device_state.GetDeviceToHostStream()->priority(),
+            Priority(se::StreamPriority::Lowest));
+}
+
 TEST(StreamExecutorGpuClientTest, MultipleDeviceShareDmaMapping) {
   GpuClientOptions options = GpuClientOptions();
 
@@ -16,12 +16,14 @@ limitations under the License.
 #include "xla/pjrt/host_callback.h"
 
 #include <cstddef>
+#include <deque>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "xla/ffi/ffi_api.h"
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/pjrt/pjrt_executable.h"
@@ -72,6 +74,16 @@ absl::Status HostCallbackContext::OnSend(int arg_num,
   // supposed to be invoked sequentially.
   ready_count_.store(args_.size());
 
+  // Callbacks without results don't block the XLA program, and we hand over
+  // the arguments to the thread pool, and leave `args_` ready for the next
+  // invocation.
+  if (IsAsync()) {
+    std::vector<PjRtChunk> args(args_.size());
+    args.swap(args_);
+    ScheduleAsync(std::move(args));
+    return absl::OkStatus();
+  }
+
   std::vector<void*> arg_ptrs;
   arg_ptrs.reserve(args_.size());
   for (auto& arg : args_) {
@@ -111,6 +123,53 @@ absl::Status HostCallbackContext::OnSend(int arg_num,
   return status;
 }
 
+HostCallbackContext::~HostCallbackContext() {
+  absl::MutexLock lock(&async_mu_);
+  async_mu_.Await(absl::Condition(
+      +[](bool* running) { return !*running; }, &async_running_));
+}
+
+void HostCallbackContext::ScheduleAsync(std::vector<PjRtChunk> args) {
+  {
+    absl::MutexLock lock(&async_mu_);
+    async_args_.push_back(std::move(args));
+    if (async_running_) return;
+    async_running_ = true;
+  }
+  host_callback_.async_thread_pool->Schedule([this] { RunAsync(); });
+}
+
+void HostCallbackContext::RunAsync() {
+  while (true) {
+    std::deque<std::vector<PjRtChunk>> batch;
+    {
+      absl::MutexLock lock(&async_mu_);
+      if (async_args_.empty()) {
+        async_running_ = false;
+        return;
+      }
+      batch.swap(async_args_);
+    }
+
+    for (std::vector<PjRtChunk>& args : batch) {
+      std::vector<void*> arg_ptrs;
+      arg_ptrs.reserve(args.size());
+      for (auto& arg : args) {
+        arg_ptrs.push_back(arg.data());
+      }
+
+      EnterHostCallback();
+      auto status = host_callback_.callback(/*results=*/nullptr,
+                                            arg_ptrs.data());
+      LeaveHostCallback();
+
+      if (!status.ok()) {
+        LOG(ERROR) << "Asynchronous host callback failed: " << status;
+      }
+    }
+  }
+}
+
 void HostCallbackContext::Receive(int res_num,
                                   const PjRtTransferMetadata& metadata,
                                   std::unique_ptr<CopyToDeviceStream> stream) {
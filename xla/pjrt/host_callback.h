@@ -33,6 +33,7 @@ limitations under the License.
 #include "xla/pjrt/pjrt_executable.h"
 #include "xla/pjrt/pjrt_future.h"
 #include "xla/shape.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "tsl/platform/logging.h"
 
 // The following provides an API for implementing host callbacks on top of
@@ -105,6 +106,15 @@ struct HostCallback {
   // callback can also return error status to indicate the entire execution
   // should fail.
   std::function<absl::Status(void**, void**)> callback;
+
+  // If set, and the host callback has no results (e.g. logging or metrics
+  // callbacks), the callback is executed asynchronously on this thread pool
+  // and XLA program execution doesn't wait for it to complete. Invocations
+  // queued while the callback is running (e.g. from later loop iterations) are
+  // processed in batches in FIFO order by a single task, however they are
+  // not ordered with respect to the rest of the XLA program, and errors
+  // returned by the callback are logged instead of failing the execution.
+  tsl::thread::ThreadPool* async_thread_pool = nullptr;
 };
 
 // A helper class that maintains the send/recv states for a host callback.
@@ -129,6 +139,9 @@ class HostCallbackContext {
     }
   }
 
+  // Waits for all asynchronous callback invocations to complete.
+  ~HostCallbackContext();
+
   absl::Status OnSend(int arg_num, const PjRtTransferMetadata& metadata,
                       PjRtChunk data);
 
@@ -138,12 +151,29 @@ class HostCallbackContext {
   const HostCallback& host_callback() const { return host_callback_; }
 
  private:
+  // Returns true if the host callback must run asynchronously.
+  bool IsAsync() const {
+    return host_callback_.async_thread_pool && result_channels_.empty();
+  }
+
+  // Queues host callback invocation with given arguments and schedules a task
+  // to process pending invocations if there isn't one already.
+  void ScheduleAsync(std::vector<PjRtChunk> args);
+
+  // Processes pending invocations until the queue is empty.
+  void RunAsync();
+
   HostCallback host_callback_;
   bool use_major_to_minor_data_layout_for_callbacks_;
   PjRtHostMemoryForDeviceManager* host_memory_for_device_manager_ = nullptr;
   std::vector<PjRtChunk> args_;
   std::vector<std::unique_ptr<ThreadSafePjRtChunkQueue>> result_channels_;
   std::atomic<int> ready_count_;
+
+  // Pending asynchronous invocations of the host callback.
+  absl::Mutex async_mu_;
+  std::deque<std::vector<PjRtChunk>> async_args_ ABSL_GUARDED_BY(async_mu_);
+  bool async_running_ ABSL_GUARDED_BY(async_mu_) = false;
 };
 
 // The execution states for host callbacks for all replicas. The states are kept
@@ -18,12 +18,16 @@ limitations under the License.
 #include <cstring>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "absl/status/status.h"
+#include "absl/synchronization/notification.h"
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/tests/literal_test_util.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/threadpool.h"
 
 namespace xla {
 namespace {
@@ -170,5 +174,52 @@ TEST(HostCallbackTest, NonBlockingRecv) {
   EXPECT_TRUE(LiteralTestUtil::Equal(literal, borrowing_literal));
 }
 
+TEST(HostCallbackTest, AsyncCallbackWithoutResults) {
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "host-callback", 1);
+
+  HostCallback host_callback;
+
+  Shape shape = ShapeUtil::MakeShape(F32, {});
+  size_t byte_size = ShapeUtil::ByteSizeOf(shape);
+
+  // Callback blocks until `release` is notified, which would deadlock the test
+  // if it was executed synchronously from `OnSend`.
+  absl::Notification release;
+  std::vector<float> values;
+
+  host_callback.operands = {HostCallbackArgInfo{/*channel_id=*/1, shape}};
+  host_callback.callback = [&](void** outputs, void** inputs) {
+    release.WaitForNotification();
+    values.push_back(*reinterpret_cast<float*>(inputs[0]));
+    return absl::OkStatus();
+  };
+  host_callback.async_thread_pool = &thread_pool;
+
+  HostCallbackStates states;
+
+  auto& send_callbacks = states.send_callbacks.emplace_back();
+  auto& recv_callbacks = states.recv_callbacks.emplace_back();
+
+  auto context = CreateHostCallbackStateAndAppendSendRecvCallbacks(
+      std::move(host_callback), /*host_memory_for_device_manager=*/nullptr,
+      send_callbacks, recv_callbacks,
+      /*use_major_to_minor_data_layout_for_callbacks=*/true);
+
+  PjRtTransferMetadata metadata;
+  metadata.device_shape = shape;
+
+  for (float value : {1.0f, 2.0f, 3.0f}) {
+    auto chunk = PjRtChunk::AllocateDefault(/*size=*/byte_size);
+    std::memcpy(chunk.data(), &value, byte_size);
+    TF_ASSERT_OK(context->OnSend(/*arg_num=*/0, metadata, std::move(chunk)));
+  }
+
+  release.Notify();
+
+  // Destroying the context waits for all pending invocations.
+  context.reset();
+  EXPECT_EQ(values, std::vector<float>({1.0f, 2.0f, 3.0f}));
+}
+
 }  // namespace
 }  // namespace xla
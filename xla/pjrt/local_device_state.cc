@@ -27,6 +27,9 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/strings/str_format.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "xla/pjrt/semaphore.h"
+#include "xla/stream_executor/allocator_stats.h"
 #include "xla/stream_executor/stream.h"
 #include "xla/tsl/protobuf/error_codes.pb.h"
 #include "xla/tsl/util/env_var.h"
@@ -68,6 +71,18 @@ LocalDeviceState::LocalDeviceState(se::StreamExecutor* executor,
                << status;
   }
 
+  bool adaptive_inflight_computations = false;
+  status = tsl::ReadBoolFromEnvVar("XLA_PJRT_ADAPTIVE_INFLIGHT_COMPUTATIONS",
+                                   false, &adaptive_inflight_computations);
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to read XLA_PJRT_ADAPTIVE_INFLIGHT_COMPUTATIONS: "
+               << status;
+  }
+  if (adaptive_inflight_computations && max_inflight_computations > 0) {
+    adaptive_inflight_window_ = std::make_unique<AdaptiveInflightWindow>(
+        &compute_semaphore_, max_inflight_computations);
+  }
+
   local_hardware_id_ = executor_->device_ordinal();
   local_device_id_ =
       device_ordinal != -1 ? device_ordinal : executor_->device_ordinal();
@@ -78,9 +93,33 @@ LocalDeviceState::LocalDeviceState(se::StreamExecutor* executor,
   int num_device_to_device_streams =
       stream_options.has_value() ? stream_options->num_device_to_device_streams
                                  : kNumDeviceToDeviceStreams;
-  auto create_stream = [executor, &stream_options](std::string const& name) {
+  // On CUDA the default priority is also the lowest one, so raising the
+  // compute stream is what lets it preempt transfers.
+  bool prioritize_compute_stream = false;
+  status = tsl::ReadBoolFromEnvVar("XLA_PJRT_PRIORITIZE_COMPUTE_STREAM", false,
+                                   &prioritize_compute_stream);
+  if (!status.ok()) {
+    LOG(ERROR) << "Failed to read XLA_PJRT_PRIORITIZE_COMPUTE_STREAM: "
+               << status;
+  }
+  std::optional<se::StreamPriority> compute_priority;
+  std::optional<se::StreamPriority> transfer_priority;
+  if (stream_options.has_value()) {
+    compute_priority = stream_options->compute_priority;
+    transfer_priority = stream_options->transfer_priority;
+  }
+  if (prioritize_compute_stream && !compute_priority.has_value()) {
+    compute_priority = se::StreamPriority::Highest;
+  }
+
+  auto create_stream = [executor, &stream_options](
+                           std::string const& name,
+                           std::optional<se::StreamPriority> priority =
+                               std::nullopt) {
     std::unique_ptr<stream_executor::Stream> stream;
-    if (stream_options.has_value()) {
+    if (priority.has_value()) {
+      stream = executor->CreateStream(*priority).value();
+    } else if (stream_options.has_value()) {
       stream = executor->CreateStream(stream_options->priority).value();
     } else {
       stream = executor->CreateStream().value();
@@ -90,21 +129,21 @@ LocalDeviceState::LocalDeviceState(se::StreamExecutor* executor,
     }
     return stream;
   };
-  compute_stream_ = create_stream("Compute");
-  host_to_device_stream_ = create_stream("Host-to-device");
+  compute_stream_ = create_stream("Compute", compute_priority);
+  host_to_device_stream_ = create_stream("Host-to-device", transfer_priority);
   if (use_callback_stream) {
     callback_stream_map_ =
         absl::flat_hash_map<se::Stream*, std::unique_ptr<se::Stream>>();
   }
   device_to_host_streams_.reserve(num_device_to_host_streams);
   for (int i = 0; i < num_device_to_host_streams; ++i) {
-    device_to_host_streams_.emplace_back(
-        create_stream(absl::StrFormat("Device-to-host #%d", i)));
+    device_to_host_streams_.emplace_back(create_stream(
+        absl::StrFormat("Device-to-host #%d", i), transfer_priority));
   }
   device_to_device_streams_.reserve(num_device_to_device_streams);
   for (int i = 0; i < num_device_to_device_streams; ++i) {
-    device_to_device_streams_.emplace_back(
-        create_stream(absl::StrFormat("Device-to-device #%d", i)));
+    device_to_device_streams_.emplace_back(create_stream(
+        absl::StrFormat("Device-to-device #%d", i), transfer_priority));
   }
   fixed_size_pool_usage_streams_.reserve(kNumFixedSizePoolUsageStreams);
   for (int i = 0; i < kNumFixedSizePoolUsageStreams; ++i) {
@@ -116,8 +155,10 @@ LocalDeviceState::LocalDeviceState(se::StreamExecutor* executor,
     external_ready_event_streams_.emplace_back(
         create_stream(absl::StrFormat("External ready event #%d", i)));
   }
-  execute_thread_ =
-      std::make_unique<WorkerThread>(tsl::Env::Default(), "py_xla_execute");
+  // Executions are usually dispatched back to back, so let the execute thread
+  // spin briefly before parking to shorten the handoff from the caller.
+  execute_thread_ = std::make_unique<WorkerThread>(
+      tsl::Env::Default(), "py_xla_execute", absl::Microseconds(50));
   callback_thread_ =
       std::make_unique<WorkerThread>(tsl::Env::Default(), "py_xla_callback");
   cleanup_thread_ =
@@ -287,6 +328,27 @@ void LocalDeviceState::ReturnStreamToPool(std::unique_ptr<se::Stream> stream) {
   usage_stream_pool_.push(std::move(stream));
 }
 
+Semaphore::ScopedReservation LocalDeviceState::AcquireComputeReservation() {
+  if (adaptive_inflight_window_) {
+    return adaptive_inflight_window_->Acquire();
+  }
+  return compute_semaphore_.ScopedAcquire(1);
+}
+
+void LocalDeviceState::OnComputationCompleted() {
+  if (!adaptive_inflight_window_) {
+    return;
+  }
+  std::optional<double> memory_usage;
+  if (std::optional<se::AllocatorStats> stats = executor_->GetAllocatorStats();
+      stats.has_value() && stats->bytes_limit.has_value() &&
+      *stats->bytes_limit > 0) {
+    memory_usage = static_cast<double>(stats->bytes_in_use) /
+                   static_cast<double>(*stats->bytes_limit);
+  }
+  adaptive_inflight_window_->OnCompleted(memory_usage);
+}
+
 int LocalDeviceState::GetNewPrngSeed() {
   absl::MutexLock lock(&mu_);
   int x = 0;
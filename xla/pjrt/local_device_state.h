@@ -94,6 +94,12 @@ class LocalDeviceState {
   // Options for stream creations.
   struct StreamOptions {
     int priority = 0;
+    // If set, override `priority` for the compute stream and for the
+    // host-to-device, device-to-host and device-to-device transfer streams.
+    // Separating them lets latency-critical computations preempt bulk
+    // transfers such as host offloading or checkpointing on the same device.
+    std::optional<se::StreamPriority> compute_priority;
+    std::optional<se::StreamPriority> transfer_priority;
     int num_device_to_host_streams = 1;
     int num_device_to_device_streams = 1;
   };
@@ -198,6 +204,20 @@ class LocalDeviceState {
 
   Semaphore& compute_semaphore() { return compute_semaphore_; }
 
+  // Acquires a slot in the compute semaphore for a computation launch. With
+  // XLA_PJRT_ADAPTIVE_INFLIGHT_COMPUTATIONS=true, the number of slots adapts
+  // to the observed device queue depth and memory headroom, with
+  // `max_inflight_computations` as the upper bound.
+  Semaphore::ScopedReservation AcquireComputeReservation();
+
+  // Must be called when a computation launched with a reservation from
+  // AcquireComputeReservation completes on the device.
+  void OnComputationCompleted();
+
+  bool adaptive_inflight_computations() const {
+    return adaptive_inflight_window_ != nullptr;
+  }
+
   // Returns a fresh, PRNG-generated random seed for an XLA computation.
   int GetNewPrngSeed();
 
@@ -218,6 +238,9 @@ class LocalDeviceState {
   // stream by the host ahead of the device.
   Semaphore compute_semaphore_;
 
+  // If set, adaptively sizes `compute_semaphore_`.
+  std::unique_ptr<AdaptiveInflightWindow> adaptive_inflight_window_;
+
   PjRtLocalDeviceId local_device_id_;
   PjRtLocalHardwareId local_hardware_id_;
   se::StreamExecutor* const executor_;
@@ -41,6 +41,18 @@ auto* pjrt_compiler_is_compiling_module = tsl::monitoring::Gauge<bool, 0>::New(
     metrics::kPjrtCompilerCompileModuleMetricName,
     "Whether the PjRT compiler is compiling modules.");
 
+auto* pjrt_cpu_device_memory_pool_allocations =
+    tsl::monitoring::Counter<1>::New(
+        "/jax/pjrt/cpu/device_memory_pool_allocations",
+        "The number of CPU device memory pool allocations, by whether the "
+        "allocation was served from the pool.",
+        "hit");
+
+auto* pjrt_cpu_device_memory_pool_cached_bytes =
+    tsl::monitoring::Gauge<int64_t, 0>::New(
+        "/jax/pjrt/cpu/device_memory_pool_cached_bytes",
+        "The number of free bytes cached by the CPU device memory pool.");
+
 }  // namespace
 
 namespace metrics {
@@ -64,5 +76,18 @@ void RecordPjrtCompilerCompileModuleStatus(bool is_compiling) {
   pjrt_compiler_is_compiling_module->GetCell()->Set(is_compiling);
 }
 
+void RecordCpuDeviceMemoryPoolAllocation(bool hit) {
+  static auto* hit_cell =
+      pjrt_cpu_device_memory_pool_allocations->GetCell("true");
+  static auto* miss_cell =
+      pjrt_cpu_device_memory_pool_allocations->GetCell("false");
+  (hit ? hit_cell : miss_cell)->IncrementBy(1);
+}
+
+void RecordCpuDeviceMemoryPoolCachedBytes(int64_t cached_bytes) {
+  static auto* cell = pjrt_cpu_device_memory_pool_cached_bytes->GetCell();
+  cell->Set(cached_bytes);
+}
+
 }  // namespace metrics
 }  // namespace xla
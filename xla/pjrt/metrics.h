@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef XLA_PJRT_METRICS_H_
 #define XLA_PJRT_METRICS_H_
 
+#include <cstdint>
+
 #include "absl/base/attributes.h"
 #include "absl/strings/string_view.h"
 #include "xla/tsl/lib/monitoring/counter.h"
@@ -36,6 +38,13 @@ void RecordPjrtCompilerCompileComputationStatus(bool is_compiling);
 
 void RecordPjrtCompilerCompileModuleStatus(bool is_compiling);
 
+// Records an allocation from the CPU device memory pool, that was either served
+// from the pool free list (hit) or from the system allocator (miss).
+void RecordCpuDeviceMemoryPoolAllocation(bool hit);
+
+// Records the number of free bytes cached by the CPU device memory pool.
+void RecordCpuDeviceMemoryPoolCachedBytes(int64_t cached_bytes);
+
 }  // namespace metrics
 }  // namespace xla
 
@@ -1451,6 +1451,16 @@ PjRtCApiLoadedExecutable::PjRtCApiLoadedExecutable(
   executable_ =
       std::make_unique<PjRtCApiExecutable>(pjrt_c_api(), args.executable);
   InitDevices();
+
+  // The number of outputs is fixed, so it is queried once instead of on every
+  // Execute call.
+  PJRT_Executable_NumOutputs_Args numoutputs_args;
+  numoutputs_args.struct_size = PJRT_Executable_NumOutputs_Args_STRUCT_SIZE;
+  numoutputs_args.extension_start = nullptr;
+  numoutputs_args.executable = c_executable();
+  pjrt::LogFatalIfPjrtError(
+      pjrt_c_api()->PJRT_Executable_NumOutputs(&numoutputs_args), pjrt_c_api());
+  num_outputs_ = numoutputs_args.num_outputs;
 }
 
 void PjRtCApiLoadedExecutable::InitDevices() {
@@ -1475,19 +1485,25 @@ void PjRtCApiLoadedExecutable::InitDevices() {
   }
 }
 
-static std::vector<std::vector<PJRT_Buffer*>> Convert2DCppBuffersToCBuffers(
-    absl::Span<const std::vector<PjRtBuffer*>> cpp_lists) {
-  std::vector<std::vector<PJRT_Buffer*>> c_lists;
-  c_lists.reserve(cpp_lists.size());
+// Converts `cpp_lists` into one contiguous array of C buffers, so that the
+// argument lists of all devices take a single allocation. All lists must have
+// the same size.
+static void Convert2DCppBuffersToCBuffers(
+    absl::Span<const std::vector<PjRtBuffer*>> cpp_lists,
+    std::vector<PJRT_Buffer*>& c_buffers, std::vector<PJRT_Buffer**>& c_lists) {
+  const size_t inner_size = cpp_lists.empty() ? 0 : cpp_lists[0].size();
+  c_buffers.reserve(cpp_lists.size() * inner_size);
   for (const auto& cpp_list : cpp_lists) {
-    auto& c_list = c_lists.emplace_back();
-    c_list.reserve(cpp_list.size());
+    CHECK_EQ(cpp_list.size(), inner_size);
     for (PjRtBuffer* buffer : cpp_list) {
       auto* c_api_argument = tensorflow::down_cast<PjRtCApiBuffer*>(buffer);
-      c_list.push_back(c_api_argument->c_buffer());
+      c_buffers.push_back(c_api_argument->c_buffer());
     }
   }
-  return c_lists;
+  c_lists.reserve(cpp_lists.size());
+  for (size_t i = 0; i < cpp_lists.size(); ++i) {
+    c_lists.push_back(c_buffers.data() + i * inner_size);
+  }
 }
 
 static std::vector<std::vector<std::unique_ptr<PjRtBuffer>>>
@@ -1701,9 +1717,9 @@ absl::StatusOr<PJRT_LoadedExecutable_Execute_Args>
 PjRtCApiLoadedExecutable::GetCommonExecuteArgs(
     absl::Span<const std::vector<PjRtBuffer*>> argument_handles,
     const ExecuteOptions& options, PJRT_ExecuteOptions& c_options,
-    std::vector<std::vector<PJRT_Buffer*>>& c_argument_lists_storage,
+    std::vector<PJRT_Buffer*>& c_argument_lists_storage,
     std::vector<PJRT_Buffer**>& c_arguments,
-    std::vector<std::vector<PJRT_Buffer*>>& c_output_lists_storage,
+    std::vector<PJRT_Buffer*>& c_output_lists_storage,
     std::vector<PJRT_Buffer**>& c_output_lists,
     std::optional<std::vector<PJRT_Event*>>& device_complete_events,
     SendRecvCallbackData& callback_data,
@@ -1741,29 +1757,18 @@ PjRtCApiLoadedExecutable::GetCommonExecuteArgs(
   }
 
   // Populates `args.argument_lists` from `argument_handles`.
-  c_argument_lists_storage = Convert2DCppBuffersToCBuffers(argument_handles);
-  c_arguments.reserve(c_argument_lists_storage.size());
-  for (auto& argument_list : c_argument_lists_storage) {
-    c_arguments.push_back(argument_list.data());
-  }
+  Convert2DCppBuffersToCBuffers(argument_handles, c_argument_lists_storage,
+                                c_arguments);
   args.argument_lists = c_arguments.data();
 
   // Allocates memory for output. `c_buffer_lists_storage` and `c_buffer_lists`
   // needs to stay alive during the call of `PJRT_LoadedExecutable_Execute`.
-
-  PJRT_Executable_NumOutputs_Args numoutputs_args;
-  numoutputs_args.struct_size = PJRT_Executable_NumOutputs_Args_STRUCT_SIZE;
-  numoutputs_args.extension_start = nullptr;
-  numoutputs_args.executable = c_executable();
-  RETURN_STATUS_IF_PJRT_ERROR(
-      pjrt_c_api()->PJRT_Executable_NumOutputs(&numoutputs_args), pjrt_c_api());
   size_t outer_size = args.num_devices;
-  size_t inner_size = numoutputs_args.num_outputs;
-  c_output_lists_storage.resize(outer_size);
+  size_t inner_size = num_outputs_;
+  c_output_lists_storage.resize(outer_size * inner_size);
   c_output_lists.resize(outer_size);
   for (int i = 0; i < outer_size; ++i) {
-    c_output_lists_storage[i].resize(inner_size);
-    c_output_lists[i] = c_output_lists_storage[i].data();
+    c_output_lists[i] = c_output_lists_storage.data() + i * inner_size;
   }
   args.output_lists = c_output_lists.data();
 
@@ -1836,8 +1841,8 @@ PjRtCApiLoadedExecutable::Execute(
     absl::Span<const std::vector<PjRtBuffer*>> argument_handles,
     const ExecuteOptions& options,
     std::optional<std::vector<PjRtFuture<>>>& returned_futures) {
-  std::vector<std::vector<PJRT_Buffer*>> c_argument_lists_storage;
-  std::vector<std::vector<PJRT_Buffer*>> c_output_lists_storage;
+  std::vector<PJRT_Buffer*> c_argument_lists_storage;
+  std::vector<PJRT_Buffer*> c_output_lists_storage;
   std::vector<PJRT_Buffer**> c_output_lists;
   std::vector<int64_t> non_donatable_input_indices_storage;
   std::vector<PJRT_Buffer**> c_arguments;
@@ -1903,8 +1908,7 @@ PjRtCApiLoadedExecutable::Execute(
   }
 
   return Convert2DCBuffersToCppBuffers(args.output_lists, args.num_devices,
-                                       c_output_lists_storage[0].size(),
-                                       client_);
+                                       num_outputs_, client_);
 }
 
 absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>>
@@ -1921,8 +1925,8 @@ PjRtCApiLoadedExecutable::ExecuteWithSingleDevice(
   std::vector<std::vector<PjRtBuffer*>> argument_handles_vec = {
       {argument_handles.begin(), argument_handles.end()}};
 
-  std::vector<std::vector<PJRT_Buffer*>> c_argument_lists_storage;
-  std::vector<std::vector<PJRT_Buffer*>> c_output_lists_storage;
+  std::vector<PJRT_Buffer*> c_argument_lists_storage;
+  std::vector<PJRT_Buffer*> c_output_lists_storage;
   std::vector<PJRT_Buffer**> c_output_lists;
   std::vector<int64_t> non_donatable_input_indices_storage;
   std::vector<PJRT_Buffer**> c_arguments;
@@ -1958,8 +1962,7 @@ PjRtCApiLoadedExecutable::ExecuteWithSingleDevice(
         args.device_complete_events[0], pjrt_c_api());
   }
   return std::move(Convert2DCBuffersToCppBuffers(
-      args.output_lists, args.num_devices, c_output_lists_storage[0].size(),
-      client_)[0]);
+      args.output_lists, args.num_devices, num_outputs_, client_)[0]);
 }
 
 absl::StatusOr<std::vector<std::unique_ptr<PjRtBuffer>>>
@@ -2076,6 +2076,12 @@ absl::Status CheckCompatibleShapes(bool strict_shape_checking,
                                    const Shape& execution_shape,
                                    const TransferManager& transfer_manager,
                                    int parameter_index) {
+  // Fast path for the common case of a buffer produced with exactly the shape
+  // and layout the executable expects, which passes both strict and size-based
+  // checking below.
+  if (buffer_on_device_shape == execution_shape) {
+    return absl::OkStatus();
+  }
   // Handle the special case: the underlying pjrt buffer of a JAX token may have
   // shape `pred[0]`.
   if (execution_shape.IsToken() &&
@@ -2881,7 +2887,11 @@ PjRtStreamExecutorLoadedExecutable::EnqueueExecution(
   {
     tsl::profiler::TraceMe traceme("ComputeSemaphoreAcquire");
     compute_reservation = std::make_shared<Semaphore::ScopedReservation>(
-        device_state->compute_semaphore().ScopedAcquire(1));
+        device_state->AcquireComputeReservation());
+  }
+  if (device_state->adaptive_inflight_computations()) {
+    compute_callbacks.push_back(
+        [device_state]() { device_state->OnComputationCompleted(); });
   }
 
   auto start_time_ns = std::make_shared<uint64_t>();
@@ -37,6 +37,7 @@ limitations under the License.
 #include "xla/pjrt/pjrt_client.h"
 #include "xla/pjrt/pjrt_executable.h"
 #include "xla/pjrt/pjrt_future.h"
+#include "xla/pjrt/tracked_device_buffer.h"
 #include "xla/service/platform_util.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
@@ -46,6 +47,7 @@ limitations under the License.
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "xla/tsl/platform/statusor.h"
 #include "xla/xla_data.pb.h"
+#include "tsl/platform/casts.h"
 
 namespace xla {
 namespace {
@@ -174,5 +176,37 @@ TEST(PjRtStreamExecutorClientTest, DonateWithControlDependency) {
   TF_ASSERT_OK(literal_comparison::Equal(literal, *result_literal));
 }
 
+TEST(PjRtStreamExecutorClientTest, OutputsShareDefinitionEvent) {
+  auto shape = xla::ShapeUtil::MakeScalarShape(xla::F32);
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetClient());
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<PjRtBuffer> buffer,
+      client->BufferFromHostLiteral(LiteralUtil::CreateR0<float>(1.0f),
+                                    client->memory_spaces()[0]));
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto executable,
+      ToyExecutable(*client, shape, [](XlaBuilder& builder) {}));
+
+  ExecuteOptions options;
+  options.untuple_result = true;
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto results,
+      executable->Execute({{buffer.get(), buffer.get()}}, options));
+  ASSERT_EQ(results.size(), 1);
+  ASSERT_EQ(results[0].size(), 2);
+
+  // A single event recorded after the launch defines every output, so the
+  // number of events per execution does not grow with the number of outputs.
+  std::vector<BufferSequencingEvent*> definition_events;
+  for (const std::unique_ptr<PjRtBuffer>& output : results[0]) {
+    auto hold = tensorflow::down_cast<PjRtStreamExecutorBuffer*>(output.get())
+                    ->GetBufferWithUsageHold();
+    ASSERT_TRUE(hold.ok());
+    ASSERT_EQ(hold->definition_events().size(), 1);
+    definition_events.push_back(hold->definition_events()[0].get());
+  }
+  EXPECT_EQ(definition_events[0], definition_events[1]);
+}
+
 }  // namespace
 }  // namespace xla
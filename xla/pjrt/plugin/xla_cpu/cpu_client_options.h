@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_PJRT_PLUGIN_XLA_CPU_CPU_CLIENT_OPTIONS_H_
 #define XLA_PJRT_PLUGIN_XLA_CPU_CPU_CLIENT_OPTIONS_H_
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -40,6 +41,15 @@ struct CpuClientOptions {
 
   int max_inflight_computations_per_device = 32;
 
+  // Maximum number of bytes of freed device memory cached for reuse by later
+  // buffer allocations. The pool is shared by all clients in the process, and
+  // zero disables it.
+  size_t device_memory_pool_bytes = 0;
+
+  // Number of threads in the intra-op and client thread pools. If not
+  // provided, the number of threads matches the number of available cores.
+  std::optional<int> num_threads = std::nullopt;
+
   // My process ID.
   int process_id = 0;
 
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_PJRT_PLUGIN_XLA_GPU_XLA_GPU_ALLOCATOR_CONFIG_H_
 #define XLA_PJRT_PLUGIN_XLA_GPU_XLA_GPU_ALLOCATOR_CONFIG_H_
 
+#include <cstddef>
 #include <cstddef>
 #include <cstdint>
 #include <optional>
@@ -51,6 +52,17 @@ struct GpuAllocatorConfig {
   // allocator will allocate more memory as allocations are requested.
   bool preallocate = true;
 
+  // Only used if kind == kBFC. If true, when an allocation fails the allocator
+  // returns free regions to the device and retries. This lets fragmented
+  // memory be reclaimed as one contiguous region. Has no effect when
+  // `preallocate` is true.
+  bool garbage_collection = false;
+
+  // Only used if kind == kBFC. Allocations of at most this many bytes are
+  // packed at the end of free chunks, away from the large free space needed by
+  // big allocations. 0 disables it.
+  size_t small_allocation_threshold = 0;
+
   // Amount of collective memory (ncclMemAlloc) to preallocate. If this value is
   // 0, collective memory space will be grown as needed to fit the application's
   // usage, with the drawback of potentially higher fragmentation. If set,
@@ -15,13 +15,22 @@ limitations under the License.
 
 #include "xla/pjrt/raw_buffer.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <vector>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_future.h"
 #include "xla/tsl/concurrency/ref_count.h"
+#include "xla/tsl/platform/file_system.h"
 
 namespace xla {
 
@@ -46,6 +55,56 @@ PjRtRawBuffer::CreateRawAliasOfBuffer(PjRtBuffer* buffer) {
                    buffer->client()->platform_version()));
 }
 
+PjRtFuture<> PjRtRawBuffer::CopyRawFileToDevice(
+    const tsl::RandomAccessFile& file, uint64_t file_offset, int64_t offset,
+    int64_t transfer_size) {
+  constexpr int64_t kChunkSize = int64_t{16} << 20;
+  int64_t chunk_buffer_size = std::min(transfer_size, kChunkSize);
+
+  // Two chunk buffers, so that reading a chunk overlaps with the transfer of
+  // the previous one. They are released once all transfers are done.
+  auto chunk_buffers =
+      std::make_shared<std::array<std::unique_ptr<char[]>, 2>>();
+  std::array<std::optional<PjRtFuture<>>, 2> chunk_transfers;
+  std::vector<PjRtFuture<>> transfers;
+  for (int64_t chunk_offset = 0, i = 0; chunk_offset < transfer_size;
+       chunk_offset += kChunkSize, ++i) {
+    int64_t chunk_size = std::min(kChunkSize, transfer_size - chunk_offset);
+    std::unique_ptr<char[]>& chunk_buffer = (*chunk_buffers)[i % 2];
+    if (chunk_buffer == nullptr) {
+      chunk_buffer = std::make_unique<char[]>(chunk_buffer_size);
+    }
+    // Wait until the previous transfer from this chunk buffer is done.
+    if (std::optional<PjRtFuture<>>& transfer = chunk_transfers[i % 2];
+        transfer.has_value()) {
+      if (absl::Status status = transfer->Await(); !status.ok()) {
+        return PjRtFuture<>(status);
+      }
+    }
+
+    absl::string_view chunk;
+    if (absl::Status status =
+            file.Read(file_offset + chunk_offset, chunk_size, chunk,
+                      absl::MakeSpan(chunk_buffer.get(), chunk_size));
+        !status.ok()) {
+      return PjRtFuture<>(status);
+    }
+    if (chunk.size() != chunk_size) {
+      return PjRtFuture<>(absl::OutOfRangeError(absl::StrCat(
+          "Read ", chunk.size(), " bytes instead of ", chunk_size,
+          " at offset ", file_offset + chunk_offset)));
+    }
+    chunk_transfers[i % 2] =
+        CopyRawHostToDevice(chunk.data(), offset + chunk_offset, chunk_size);
+    transfers.push_back(*chunk_transfers[i % 2]);
+  }
+
+  PjRtFuture<> done = JoinFutures(transfers);
+  done.OnReady(
+      [chunk_buffers = std::move(chunk_buffers)](const absl::Status&) {});
+  return done;
+}
+
 RegisterRawBufferFactory::RegisterRawBufferFactory(
     RegisterRawBufferFactory::FactoryFuncT func) {
   GetFactoryFuncs().push_back(func);
@@ -16,11 +16,13 @@ limitations under the License.
 #ifndef XLA_PJRT_RAW_BUFFER_H_
 #define XLA_PJRT_RAW_BUFFER_H_
 
+#include <cstdint>
 #include <optional>
 
 #include "absl/status/statusor.h"
 #include "xla/pjrt/pjrt_future.h"
 #include "xla/tsl/concurrency/ref_count.h"
+#include "xla/tsl/platform/file_system.h"
 
 namespace xla {
 
@@ -63,6 +65,20 @@ class PjRtRawBuffer : public tsl::ReferenceCounted<PjRtRawBuffer> {
   // this method for specific alignment requirements.
   virtual PjRtFuture<> CopyRawDeviceToHost(void* dst, int64_t offset,
                                            int64_t transfer_size) = 0;
+
+  // Transfers `transfer_size` bytes of `file`, starting at `file_offset`, to a
+  // sub-range of the on-device representation starting at `offset`. `file`
+  // must outlive the returned future, which transitions to ready on error, or
+  // after the transfer has completed.
+  //
+  // The default implementation reads the file in chunks into host memory and
+  // transfers them with CopyRawHostToDevice, reading the next chunk while the
+  // previous one is in flight. It blocks the calling thread until the last
+  // chunk has been read. Implementations may override it with a direct
+  // storage-to-device path.
+  virtual PjRtFuture<> CopyRawFileToDevice(const tsl::RandomAccessFile& file,
+                                           uint64_t file_offset, int64_t offset,
+                                           int64_t transfer_size);
 };
 
 class RegisterRawBufferFactory {
@@ -15,14 +15,24 @@ limitations under the License.
 
 #include "xla/pjrt/raw_buffer.h"
 
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <optional>
+#include <string>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/pjrt/pjrt_future.h"
 #include "xla/tsl/concurrency/ref_count.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/file_system.h"
 #include "xla/tsl/platform/status_matchers.h"
 #include "xla/tsl/platform/test.h"
+#include "tsl/platform/path.h"
 
 namespace xla {
 
@@ -53,4 +63,53 @@ TEST(RawBufferTest, FactoryError) {
                                      testing::HasSubstr("MockFactory")));
 }
 
+// A raw buffer backed by host memory.
+class HostRawBuffer : public PjRtRawBuffer {
+ public:
+  explicit HostRawBuffer(size_t size) : data_(size, '\0') {}
+
+  PjRtMemorySpace* memory_space() const override { return nullptr; }
+
+  absl::StatusOr<size_t> GetOnDeviceSizeInBytes() const override {
+    return data_.size();
+  }
+
+  PjRtFuture<> CopyRawHostToDevice(const void* src, int64_t offset,
+                                   int64_t transfer_size) override {
+    std::memcpy(data_.data() + offset, src, transfer_size);
+    return PjRtFuture<>(absl::OkStatus());
+  }
+
+  PjRtFuture<> CopyRawDeviceToHost(void* dst, int64_t offset,
+                                   int64_t transfer_size) override {
+    std::memcpy(dst, data_.data() + offset, transfer_size);
+    return PjRtFuture<>(absl::OkStatus());
+  }
+
+  absl::string_view data() const { return data_; }
+
+ private:
+  std::string data_;
+};
+
+TEST(RawBufferTest, CopyRawFileToDevice) {
+  tsl::Env* env = tsl::Env::Default();
+  std::string path = tsl::io::JoinPath(tsl::testing::TmpDir(), "raw_buffer");
+  TF_ASSERT_OK(tsl::WriteStringToFile(env, path, "0123456789"));
+  std::unique_ptr<tsl::RandomAccessFile> file;
+  TF_ASSERT_OK(env->NewRandomAccessFile(path, &file));
+
+  auto buffer = tsl::MakeRef<HostRawBuffer>(6);
+  TF_EXPECT_OK(buffer->CopyRawFileToDevice(*file, /*file_offset=*/2,
+                                           /*offset=*/1, /*transfer_size=*/4)
+                   .Await());
+  EXPECT_EQ(buffer->data(), absl::string_view("\0002345\0", 6));
+
+  EXPECT_THAT(buffer
+                  ->CopyRawFileToDevice(*file, /*file_offset=*/8,
+                                        /*offset=*/0, /*transfer_size=*/4)
+                  .Await(),
+              tsl::testing::StatusIs(tsl::error::OUT_OF_RANGE));
+}
+
 }  // namespace xla
@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "xla/pjrt/semaphore.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <optional>
 
 #include "absl/synchronization/mutex.h"
 #include "tsl/platform/logging.h"
@@ -59,6 +61,13 @@ void Semaphore::Release(int64_t amount) {
   value_ += amount;
 }
 
+void Semaphore::SetCapacity(int64_t capacity) {
+  CHECK_GE(capacity, 0);
+  absl::MutexLock lock(&mu_);
+  value_ += capacity - max_capacity_;
+  max_capacity_ = capacity;
+}
+
 Semaphore::ScopedReservation::~ScopedReservation() {
   if (semaphore_) {
     semaphore_->Release(amount_);
@@ -85,4 +94,56 @@ Semaphore::ScopedReservation Semaphore::ScopedAcquire(int64_t amount) {
   return ScopedReservation(this, amount);
 }
 
+AdaptiveInflightWindow::AdaptiveInflightWindow(Semaphore* semaphore,
+                                               int64_t max_capacity,
+                                               double high_memory_watermark)
+    : semaphore_(semaphore),
+      max_capacity_(max_capacity),
+      high_memory_watermark_(high_memory_watermark),
+      window_(max_capacity) {
+  CHECK_GE(max_capacity, 1);
+  semaphore_->SetCapacity(max_capacity);
+}
+
+Semaphore::ScopedReservation AdaptiveInflightWindow::Acquire() {
+  if (!semaphore_->TryAcquire(1)) {
+    {
+      absl::MutexLock lock(&mu_);
+      ++num_waiting_;
+    }
+    semaphore_->Acquire(1);
+    absl::MutexLock lock(&mu_);
+    --num_waiting_;
+  }
+  absl::MutexLock lock(&mu_);
+  ++num_inflight_;
+  return Semaphore::ScopedReservation(semaphore_, 1);
+}
+
+void AdaptiveInflightWindow::OnCompleted(std::optional<double> memory_usage) {
+  absl::MutexLock lock(&mu_);
+  --num_inflight_;
+
+  if (memory_usage.has_value() && *memory_usage > high_memory_watermark_) {
+    if (window_ > 1) {
+      window_ = std::max<int64_t>(1, window_ / 2);
+      VLOG(2) << "Shrink in-flight window to " << window_
+              << " at memory usage " << *memory_usage;
+      semaphore_->SetCapacity(window_);
+    }
+    return;
+  }
+
+  if (num_inflight_ == 0 && num_waiting_ > 0 && window_ < max_capacity_) {
+    ++window_;
+    VLOG(2) << "Grow in-flight window to " << window_;
+    semaphore_->SetCapacity(window_);
+  }
+}
+
+int64_t AdaptiveInflightWindow::window() const {
+  absl::MutexLock lock(&mu_);
+  return window_;
+}
+
 }  // namespace xla
@@ -17,7 +17,9 @@ limitations under the License.
 #define XLA_PJRT_SEMAPHORE_H_
 
 #include <cstdint>
+#include <optional>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/synchronization/mutex.h"
 #include "xla/types.h"
 
@@ -38,7 +40,15 @@ class Semaphore {
   void Release(int64_t amount);
 
   // Returns the capacity of the semaphore.
-  int64_t capacity() const { return max_capacity_; }
+  int64_t capacity() const {
+    absl::MutexLock lock(&mu_);
+    return max_capacity_;
+  }
+
+  // Changes the capacity of the semaphore. If the new capacity is smaller than
+  // the number of acquired units, acquisitions block until enough units are
+  // released.
+  void SetCapacity(int64_t capacity);
 
   class ScopedReservation {
    public:
@@ -68,9 +78,46 @@ class Semaphore {
   static bool CanAcquire(CanAcquireArgs* args)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(args->semaphore->mu_);
 
-  absl::Mutex mu_;
+  mutable absl::Mutex mu_;
   int64_t value_ ABSL_GUARDED_BY(mu_);
+  int64_t max_capacity_ ABSL_GUARDED_BY(mu_);
+};
+
+// Adaptively sizes the capacity of a semaphore that limits the number of
+// computations in flight on a device, between 1 and `max_capacity`.
+//
+// A fixed limit either adds latency, because the device drains its queue and
+// idles while the host waits for a slot to launch the next computation, or
+// lets the host run too far ahead and hold on to too much device memory. The
+// window starts at `max_capacity`. It shrinks by half when a computation
+// completes with device memory usage above `high_memory_watermark`, and grows
+// by one slot when a computation completes and leaves the device with an empty
+// queue while a launch is waiting for a slot.
+class AdaptiveInflightWindow {
+ public:
+  AdaptiveInflightWindow(Semaphore* semaphore, int64_t max_capacity,
+                         double high_memory_watermark = 0.9);
+
+  // Acquires a slot for a computation launch, blocking until it's available.
+  Semaphore::ScopedReservation Acquire();
+
+  // Records completion on the device of a computation launched with a slot
+  // from `Acquire`. `memory_usage` is the fraction of device memory in use, if
+  // it's known.
+  void OnCompleted(std::optional<double> memory_usage);
+
+  // Returns the current size of the in-flight window.
+  int64_t window() const;
+
+ private:
+  Semaphore* semaphore_;
   const int64_t max_capacity_;
+  const double high_memory_watermark_;
+
+  mutable absl::Mutex mu_;
+  int64_t window_ ABSL_GUARDED_BY(mu_);
+  int64_t num_inflight_ ABSL_GUARDED_BY(mu_) = 0;
+  int64_t num_waiting_ ABSL_GUARDED_BY(mu_) = 0;
 };
 
 }  // namespace xla
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "xla/pjrt/semaphore.h"
 
+#include <optional>
+
 #include <gtest/gtest.h>
 #include "absl/synchronization/notification.h"
 #include "xla/hlo/testlib/test.h"
@@ -80,5 +82,88 @@ TEST(SemaphoreTest, ConcurrentTest) {
   a_done.WaitForNotification();
 }
 
+TEST(SemaphoreTest, SetCapacity) {
+  Semaphore semaphore(2);
+  semaphore.Acquire(2);
+
+  // Shrinking below the acquired amount blocks new acquisitions until enough
+  // units are released.
+  semaphore.SetCapacity(1);
+  EXPECT_EQ(semaphore.capacity(), 1);
+  semaphore.Release(1);
+  EXPECT_FALSE(semaphore.TryAcquire(1));
+  semaphore.Release(1);
+  EXPECT_TRUE(semaphore.TryAcquire(1));
+  EXPECT_FALSE(semaphore.TryAcquire(1));
+
+  semaphore.SetCapacity(3);
+  EXPECT_TRUE(semaphore.TryAcquire(2));
+  EXPECT_FALSE(semaphore.TryAcquire(1));
+  semaphore.Release(3);
+}
+
+TEST(AdaptiveInflightWindowTest, ShrinksUnderMemoryPressure) {
+  Semaphore semaphore(4);
+  AdaptiveInflightWindow window(&semaphore, /*max_capacity=*/4,
+                                /*high_memory_watermark=*/0.8);
+  EXPECT_EQ(window.window(), 4);
+
+  {
+    auto reservation = window.Acquire();
+    window.OnCompleted(/*memory_usage=*/0.5);
+  }
+  EXPECT_EQ(window.window(), 4);
+
+  {
+    auto reservation = window.Acquire();
+    window.OnCompleted(/*memory_usage=*/0.9);
+  }
+  EXPECT_EQ(window.window(), 2);
+  EXPECT_EQ(semaphore.capacity(), 2);
+
+  {
+    auto reservation = window.Acquire();
+    window.OnCompleted(/*memory_usage=*/0.9);
+  }
+  {
+    auto reservation = window.Acquire();
+    window.OnCompleted(/*memory_usage=*/0.9);
+  }
+  EXPECT_EQ(window.window(), 1);
+
+  // Without launches waiting for a slot the window doesn't grow back.
+  {
+    auto reservation = window.Acquire();
+    window.OnCompleted(/*memory_usage=*/std::nullopt);
+  }
+  EXPECT_EQ(window.window(), 1);
+}
+
+TEST(AdaptiveInflightWindowTest, GrowsWhenLaunchesWait) {
+  Semaphore semaphore(2);
+  AdaptiveInflightWindow window(&semaphore, /*max_capacity=*/2,
+                                /*high_memory_watermark=*/0.8);
+  {
+    auto reservation = window.Acquire();
+    window.OnCompleted(/*memory_usage=*/0.9);
+  }
+  ASSERT_EQ(window.window(), 1);
+
+  tsl::thread::ThreadPool pool(tsl::Env::Default(), "test", 1);
+  auto reservation = window.Acquire();
+  absl::Notification acquired;
+  pool.Schedule([&]() {
+    auto waiting = window.Acquire();
+    acquired.Notify();
+  });
+
+  // Give the launch time to block on the window, then complete the only
+  // in-flight computation: the device would idle while a launch is waiting.
+  tsl::Env::Default()->SleepForMicroseconds(50 * 1000);
+  window.OnCompleted(/*memory_usage=*/std::nullopt);
+  EXPECT_EQ(window.window(), 2);
+  acquired.WaitForNotification();
+}
+
 }  // namespace
 }  // namespace xla
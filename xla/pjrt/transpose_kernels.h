@@ -203,6 +203,32 @@ inline __m256i Unpack<8, Extract::kHi>(__m256i a, __m256i b) {
 #endif
 #endif
 
+#ifdef __AVX512F__
+// AVX-512 unpacks operate on each of the four 128-bit lanes independently, the
+// same as AVX unpacks operate on each of the two 128-bit lanes. We only need
+// 4-byte and 8-byte unpacks for the 16x16 and 8x8 square transposes.
+template <size_t element_size, Extract>
+__m512i Unpack(__m512i a, __m512i b);
+
+template <>
+inline __m512i Unpack<4, Extract::kLo>(__m512i a, __m512i b) {
+  return _mm512_unpacklo_epi32(a, b);
+}
+template <>
+inline __m512i Unpack<4, Extract::kHi>(__m512i a, __m512i b) {
+  return _mm512_unpackhi_epi32(a, b);
+}
+
+template <>
+inline __m512i Unpack<8, Extract::kLo>(__m512i a, __m512i b) {
+  return _mm512_unpacklo_epi64(a, b);
+}
+template <>
+inline __m512i Unpack<8, Extract::kHi>(__m512i a, __m512i b) {
+  return _mm512_unpackhi_epi64(a, b);
+}
+#endif
+
 #ifdef XLA_HAS_SSE2
 template <size_t element_size, Extract>
 __m128i Unpack(__m128i a, __m128i b);
@@ -657,6 +683,52 @@ struct AvxRectangularTransposeMicroKernelImpl {
 };
 #endif
 
+#ifdef __AVX512F__
+// Square transpose of a block of `bs` rows of 64 bytes each, i.e. 16x16 for
+// 4-byte and 8x8 for 8-byte elements. This is a generalization of the AVX
+// square transpose to four 128-bit lanes: vector `q * bs / 4 + i` holds the
+// 128-bit chunk `q` of rows `i`, `i + bs / 4`, `i + bs / 2` and
+// `i + 3 * bs / 4`, and unpacks within each lane complete the transpose.
+template <typename T, int bs>
+struct Avx512SquareTransposeMicroKernelImpl {
+  XLA_FLATTEN static void Apply(const char* __restrict a, int64_t lda,
+                                char* __restrict b, int64_t ldb) {
+    constexpr size_t element_size = sizeof(T);
+    static_assert(element_size == 4 || element_size == 8);
+    static_assert(bs % 4 == 0);
+    static_assert(element_size * bs == sizeof(__m512i));
+    constexpr int kLanes = sizeof(__m512i) / sizeof(__m128i);
+    std::array<__m512i, bs> last_transpose;
+    XLA_UNROLL
+    for (int i = 0; i < bs / kLanes; ++i) {
+      auto* row0 = reinterpret_cast<const __m128i*>(a + lda * (i + 0));
+      auto* row1 = reinterpret_cast<const __m128i*>(a + lda * (i + bs / 4));
+      auto* row2 = reinterpret_cast<const __m128i*>(a + lda * (i + bs / 2));
+      auto* row3 = reinterpret_cast<const __m128i*>(a + lda * (i + bs * 3 / 4));
+      XLA_UNROLL
+      for (int q = 0; q < kLanes; ++q) {
+        __m256i lo = _mm256_set_m128i(_mm_loadu_si128(row1 + q),
+                                      _mm_loadu_si128(row0 + q));
+        __m256i hi = _mm256_set_m128i(_mm_loadu_si128(row3 + q),
+                                      _mm_loadu_si128(row2 + q));
+        last_transpose[q * (bs / kLanes) + i] =
+            _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1);
+      }
+    }
+
+    last_transpose =
+        UnpackSequence<element_size, /*step_size=*/1,
+                       /*unpack_limit=*/sizeof(__m128i)>(last_transpose);
+
+    XLA_UNROLL
+    for (int i = 0; i < bs; ++i) {
+      _mm512_storeu_si512(reinterpret_cast<__m512i*>(b + ldb * i),
+                          last_transpose[i]);
+    }
+  }
+};
+#endif
+
 // The transpose kernel requires its input to be contiguous in one of the two
 // dimensions being transposed, and the output to be contiguous in the other
 // dimension.
@@ -667,6 +739,13 @@ struct TransposeMicroKernel {
   static void Apply(const char* __restrict a, int64_t lda, char* __restrict b,
                     int64_t ldb) {
     if constexpr (bs % 2 == 0) {
+#ifdef __AVX512F__
+      if constexpr ((sizeof(T) == 4 || sizeof(T) == 8) &&
+                    sizeof(T) * bs == sizeof(__m512i)) {
+        return Avx512SquareTransposeMicroKernelImpl<T, bs>::Apply(a, lda, b,
+                                                                  ldb);
+      }
+#endif
 #ifdef __AVX__
       if constexpr (sizeof(T) * bs == sizeof(__m256i)) {
         return AvxSquareTransposeMicroKernelImpl<T, bs>::Apply(a, lda, b, ldb);
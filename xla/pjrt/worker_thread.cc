@@ -21,10 +21,14 @@ limitations under the License.
 #include "absl/functional/any_invocable.h"
 #include "absl/log/check.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 
 namespace xla {
 
-WorkerThread::WorkerThread(tsl::Env* env, const std::string& name) {
+WorkerThread::WorkerThread(tsl::Env* env, const std::string& name,
+                           absl::Duration spin_duration)
+    : spin_duration_(spin_duration) {
   thread_.reset(
       env->StartThread(tsl::ThreadOptions(), name, [this]() { WorkLoop(); }));
 }
@@ -32,24 +36,37 @@ WorkerThread::WorkerThread(tsl::Env* env, const std::string& name) {
 WorkerThread::~WorkerThread() {
   absl::MutexLock lock(&mu_);
   work_queue_.push(nullptr);
+  num_queued_.fetch_add(1, std::memory_order_release);
 }
 
 void WorkerThread::Schedule(absl::AnyInvocable<void() &&> fn) {
   CHECK(fn != nullptr);
   absl::MutexLock lock(&mu_);
   work_queue_.push(std::move(fn));
+  num_queued_.fetch_add(1, std::memory_order_release);
 }
 
 bool WorkerThread::WorkAvailable() { return !work_queue_.empty(); }
 
+void WorkerThread::SpinUntilWorkAvailable() {
+  absl::Time deadline = absl::Now() + spin_duration_;
+  while (num_queued_.load(std::memory_order_acquire) == 0 &&
+         absl::Now() < deadline) {
+  }
+}
+
 void WorkerThread::WorkLoop() {
   while (true) {
+    if (spin_duration_ > absl::ZeroDuration()) {
+      SpinUntilWorkAvailable();
+    }
     absl::AnyInvocable<void() &&> fn;
     {
       absl::MutexLock lock(&mu_);
       mu_.Await(absl::Condition(this, &WorkerThread::WorkAvailable));
       fn = std::move(work_queue_.front());
       work_queue_.pop();
+      num_queued_.fetch_sub(1, std::memory_order_relaxed);
     }
     if (!fn) {
       return;
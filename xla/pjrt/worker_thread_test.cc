@@ -0,0 +1,100 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/pjrt/worker_thread.h"
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "xla/tsl/platform/test_benchmark.h"
+#include "tsl/platform/env.h"
+
+namespace xla {
+namespace {
+
+TEST(WorkerThreadTest, RunsClosuresInOrder) {
+  std::vector<int> order;
+  {
+    WorkerThread thread(tsl::Env::Default(), "test");
+    for (int i = 0; i < 100; ++i) {
+      thread.Schedule([&order, i] { order.push_back(i); });
+    }
+  }
+  ASSERT_EQ(order.size(), 100);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(order[i], i);
+  }
+}
+
+TEST(WorkerThreadTest, SpinningThreadRunsClosures) {
+  WorkerThread thread(tsl::Env::Default(), "test", absl::Milliseconds(1));
+  absl::Mutex mu;
+  int done = 0;
+  for (int i = 0; i < 10; ++i) {
+    thread.Schedule([&] {
+      absl::MutexLock lock(&mu);
+      ++done;
+    });
+    // Let the thread go idle and spin before the next closure arrives.
+    absl::SleepFor(absl::Microseconds(100));
+  }
+  absl::MutexLock lock(&mu);
+  mu.Await(absl::Condition(
+      +[](int* done) { return *done == 10; }, &done));
+}
+
+//===----------------------------------------------------------------------===//
+// Performance benchmarks.
+//===----------------------------------------------------------------------===//
+
+// Mirrors the per-device launch fan-out in PjRtStreamExecutorLoadedExecutable:
+// schedule one closure on every worker thread and wait for all of them.
+static void BM_FanOut(benchmark::State& state) {
+  const int num_threads = state.range(0);
+  const absl::Duration spin_duration = absl::Microseconds(state.range(1));
+
+  std::vector<std::unique_ptr<WorkerThread>> threads;
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(std::make_unique<WorkerThread>(
+        tsl::Env::Default(), "bench", spin_duration));
+  }
+
+  for (auto _ : state) {
+    absl::Mutex mu;
+    int running = num_threads;
+    for (auto& thread : threads) {
+      thread->Schedule([&] {
+        absl::MutexLock lock(&mu);
+        --running;
+      });
+    }
+    absl::MutexLock lock(&mu);
+    mu.Await(absl::Condition(
+        +[](int* running) { return *running == 0; }, &running));
+  }
+}
+
+BENCHMARK(BM_FanOut)
+    ->UseRealTime()
+    ->Args({8, 0})
+    ->Args({8, 50})
+    ->Args({16, 0})
+    ->Args({16, 50});
+
+}  // namespace
+}  // namespace xla
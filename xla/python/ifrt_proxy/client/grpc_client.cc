@@ -14,6 +14,8 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 
 #include "absl/functional/any_invocable.h"
@@ -38,6 +40,7 @@
 #include "xla/python/ifrt_proxy/client/version.h"
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.pb.h"
 #include "xla/python/ifrt_proxy/common/ifrt_service.pb.h"
+#include "xla/tsl/platform/env.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/statusor.h"
 
@@ -97,6 +100,7 @@ absl::StatusOr<std::unique_ptr<Client>> AttemptConnection(
   };
 
   GrpcIfrtSessionMetadata metadata;
+  std::optional<std::string> shared_memory_directory;
   {
     GrpcGetVersionRequest request;
     request.mutable_min_version()->set_protocol_version(kClientMinVersion);
@@ -110,6 +114,16 @@ absl::StatusOr<std::unique_ptr<Client>> AttemptConnection(
     CHECK_GE(response.version().protocol_version(), kClientMinVersion);
     CHECK_LE(response.version().protocol_version(), kClientMaxVersion);
     *metadata.mutable_version() = response.version();
+    // The server's probe file is only visible if the client shares its
+    // filesystem, in which case host buffers can bypass gRPC.
+    if (response.has_shared_memory() &&
+        tsl::Env::Default()
+            ->FileExists(response.shared_memory().probe_file())
+            .ok()) {
+      shared_memory_directory = response.shared_memory().directory();
+      VLOG(0) << "Staging host buffers in shared memory at "
+              << *shared_memory_directory;
+    }
   }
   *metadata.mutable_initialization_data() = initialization_data.ToProto();
 
@@ -140,7 +154,8 @@ absl::StatusOr<std::unique_ptr<Client>> AttemptConnection(
                             : CreateGrpcStub(server_address);
 
   auto host_buffer_store = std::make_unique<GrpcClientHostBufferStore>(
-      data_path_stub, metadata.version(), init_response->session_id());
+      data_path_stub, metadata.version(), init_response->session_id(),
+      std::move(shared_memory_directory));
   rpc_helper->set_host_buffer_store(std::move(host_buffer_store));
 
   return Client::Create(std::move(rpc_helper), std::move(*init_response));
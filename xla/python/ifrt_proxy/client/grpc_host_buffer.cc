@@ -15,7 +15,9 @@
 #include "xla/python/ifrt_proxy/client/grpc_host_buffer.h"
 
 #include <cstdint>
+#include <initializer_list>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -34,6 +36,10 @@
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.grpc.pb.h"
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.pb.h"
 #include "xla/python/ifrt_proxy/common/prof_util.h"
+#include "xla/python/ifrt_proxy/common/shared_memory_host_buffer.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/file_system.h"
 #include "xla/tsl/protobuf/status.pb.h"
 #include "tsl/platform/unbounded_work_queue.h"
 #include "tsl/profiler/lib/traceme.h"
@@ -54,12 +60,27 @@ static void SetDataFromStringView(GrpcHostBufferStoreRequest& req,
 #endif
 }
 
+// Writes `chunks` to the file from which the server picks up the host buffer,
+// bypassing the gRPC stream.
+template <typename Chunks>
+static absl::Status WriteSharedMemoryHostBuffer(const std::string& path,
+                                                const Chunks& chunks) {
+  std::unique_ptr<tsl::WritableFile> file;
+  TF_RETURN_IF_ERROR(tsl::Env::Default()->NewWritableFile(path, &file));
+  for (absl::string_view chunk : chunks) {
+    TF_RETURN_IF_ERROR(file->Append(chunk));
+  }
+  return file->Close();
+}
+
 GrpcClientHostBufferStore::GrpcClientHostBufferStore(
     std::shared_ptr<grpc::GrpcIfrtService::StubInterface> stub,
-    IfrtProxyVersion version, uint64_t session_id)
+    IfrtProxyVersion version, uint64_t session_id,
+    std::optional<std::string> shared_memory_directory)
     : stub_(std::move(stub)),
       version_(std::move(version)),
       session_id_(session_id),
+      shared_memory_directory_(std::move(shared_memory_directory)),
       work_queue_(std::make_unique<tsl::UnboundedWorkQueue>(
           tsl::Env::Default(), "HostBufferStoreLookupsWorkQueue")) {}
 
@@ -84,6 +105,17 @@ Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
     metadata.set_session_id(session_id_);
     metadata.set_handle(handle);
     metadata.set_buffer_size(data.size());
+    if (shared_memory_directory_.has_value()) {
+      absl::Status status = WriteSharedMemoryHostBuffer(
+          SharedMemoryHostBufferPath(*shared_memory_directory_, session_id_,
+                                     handle),
+          std::initializer_list<absl::string_view>{data});
+      if (!status.ok()) {
+        promise.Set(status);
+        return;
+      }
+      metadata.set_shared_memory(true);
+    }
     VLOG(3) << "GrpcClientHostBufferStore::Store start "
             << metadata.ShortDebugString();
 
@@ -99,7 +131,9 @@ Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
         return tsl::profiler::TraceMeEncode(
             "GrpcClientHostBufferStore::StoreAsync_Send", {{"size", size}});
       });
-      for (int64_t offset = 0; offset < data.size(); offset += kChunkSize) {
+      for (int64_t offset = 0;
+           !metadata.shared_memory() && offset < data.size();
+           offset += kChunkSize) {
         GrpcHostBufferStoreRequest request;
         SetDataFromStringView(request, data.substr(offset, kChunkSize));
         writer->Write(request);
@@ -131,6 +165,16 @@ Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
   metadata.set_session_id(session_id_);
   metadata.set_handle(handle);
   metadata.set_buffer_size(data.size());
+  if (shared_memory_directory_.has_value()) {
+    absl::Status status = WriteSharedMemoryHostBuffer(
+        SharedMemoryHostBufferPath(*shared_memory_directory_, session_id_,
+                                   handle),
+        data.Chunks());
+    if (!status.ok()) {
+      return Future<>(status);
+    }
+    metadata.set_shared_memory(true);
+  }
   VLOG(3) << "GrpcClientHostBufferStore::Store start "
           << metadata.ShortDebugString();
 
@@ -147,6 +191,7 @@ Future<> GrpcClientHostBufferStore::Store(uint64_t handle,
           "GrpcClientHostBufferStore::StoreAsync_Send", {{"size", size}});
     });
     for (absl::string_view chunk : data.Chunks()) {
+      if (metadata.shared_memory()) break;
       for (int64_t offset = 0; offset < chunk.size(); offset += kChunkSize) {
         GrpcHostBufferStoreRequest request;
         SetDataFromStringView(request, chunk.substr(offset, kChunkSize));
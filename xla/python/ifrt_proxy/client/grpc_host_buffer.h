@@ -19,6 +19,8 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 
 #include "absl/strings/cord.h"
 #include "absl/strings/string_view.h"
@@ -36,7 +38,8 @@ class GrpcClientHostBufferStore : public ClientHostBufferStore {
  public:
   GrpcClientHostBufferStore(
       std::shared_ptr<grpc::GrpcIfrtService::StubInterface> stub,
-      IfrtProxyVersion version, uint64_t session_id);
+      IfrtProxyVersion version, uint64_t session_id,
+      std::optional<std::string> shared_memory_directory = std::nullopt);
 
   ~GrpcClientHostBufferStore() override;
 
@@ -52,6 +55,10 @@ class GrpcClientHostBufferStore : public ClientHostBufferStore {
   const IfrtProxyVersion version_;
   const uint64_t session_id_;
 
+  // If set, `Store()` stages data in this directory, which the server reads
+  // directly, instead of streaming it over gRPC.
+  const std::optional<std::string> shared_memory_directory_;
+
   // Implementation note: `work_queue_` may have closures that invoke
   // user-defined code. Each `Store()` and `Lookup()` call is associated with a
   // scheduled closure, and the closure is used to first perform synchronous
@@ -52,6 +52,10 @@ namespace {
 
 constexpr absl::Duration kPeriodicFlushInterval = absl::Microseconds(50);
 
+// How long the periodic flusher sleeps while there are no batched operations
+// before re-checking whether the batcher has finished.
+constexpr absl::Duration kIdleFlushCheckInterval = absl::Milliseconds(10);
+
 // Thread-safe data structure for holding batched operations.
 class BatchedOps {
  public:
@@ -89,7 +93,22 @@ class BatchedOps {
     return result;
   }
 
+  // Blocks until at least one operation has been added or `timeout` expires.
+  void WaitForOps(absl::Duration timeout) {
+    absl::MutexLock l(&mu_);
+    mu_.AwaitWithTimeout(absl::Condition(this, &BatchedOps::HasOps), timeout);
+  }
+
  private:
+  bool HasOps() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    for (const auto& handles : batched_) {
+      if (!handles.empty()) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   absl::Mutex mu_;
   std::array<std::vector<ArrayHandle>, BatchOperation::kSentinelDoNotUse>
       batched_ ABSL_GUARDED_BY(mu_);
@@ -152,6 +171,10 @@ class RpcHelper::Batcher {
  private:
   void PeriodicFlusher() {
     while (true) {
+      // Rather than waking up every kPeriodicFlushInterval, sleep until there
+      // is something to send, then wait one more interval so that operations
+      // issued in quick succession share a batch.
+      batched_.WaitForOps(kIdleFlushCheckInterval);
       absl::SleepFor(kPeriodicFlushInterval);
       absl::MutexLock l(&mu_);
       if (finished_) {
@@ -0,0 +1,38 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/python/ifrt_proxy/common/shared_memory_host_buffer.h"
+
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "tsl/platform/path.h"
+
+namespace xla {
+namespace ifrt {
+namespace proxy {
+
+std::string SharedMemoryHostBufferPath(absl::string_view directory,
+                                       uint64_t session_id, uint64_t handle) {
+  return tsl::io::JoinPath(
+      directory, absl::StrCat("ifrt_proxy_host_buffer_", session_id, "_",
+                              handle));
+}
+
+}  // namespace proxy
+}  // namespace ifrt
+}  // namespace xla
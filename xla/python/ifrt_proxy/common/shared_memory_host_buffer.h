@@ -0,0 +1,42 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_PYTHON_IFRT_PROXY_COMMON_SHARED_MEMORY_HOST_BUFFER_H_
+#define XLA_PYTHON_IFRT_PROXY_COMMON_SHARED_MEMORY_HOST_BUFFER_H_
+
+#include <cstdint>
+#include <string>
+
+#include "absl/strings/string_view.h"
+
+namespace xla {
+namespace ifrt {
+namespace proxy {
+
+// Returns the path of the file through which a client co-located with the
+// server hands the host buffer `handle` of session `session_id` to the server,
+// instead of streaming it over gRPC. `directory` is expected to be on a
+// memory-backed filesystem such as /dev/shm.
+//
+// Both sides derive the path from the metadata of the store request, so a
+// client cannot make the server read arbitrary files.
+std::string SharedMemoryHostBufferPath(absl::string_view directory,
+                                       uint64_t session_id, uint64_t handle);
+
+}  // namespace proxy
+}  // namespace ifrt
+}  // namespace xla
+
+#endif  // XLA_PYTHON_IFRT_PROXY_COMMON_SHARED_MEMORY_HOST_BUFFER_H_
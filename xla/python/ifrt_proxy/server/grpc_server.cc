@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -37,6 +38,7 @@
 #include "xla/python/ifrt_proxy/server/grpc_service_impl.h"
 #include "xla/python/ifrt_proxy/server/host_buffer.h"
 #include "xla/python/ifrt_proxy/server/ifrt_backend.h"
+#include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/statusor.h"
 
 namespace xla {
@@ -78,7 +80,8 @@ GrpcServer::CreateFromIfrtClientFactory(
     absl::string_view address,
     absl::AnyInvocable<absl::StatusOr<std::shared_ptr<xla::ifrt::Client>>(
         AttributeMap initialization_data)>
-        backend_ifrt_client_factory) {
+        backend_ifrt_client_factory,
+    std::optional<std::string> shared_memory_directory) {
   if (backend_ifrt_client_factory == nullptr) {
     return absl::InvalidArgumentError(
         "backend_ifrt_client_factory cannot be nullptr.");
@@ -96,6 +99,10 @@ GrpcServer::CreateFromIfrtClientFactory(
         return IfrtBackend::Create(version, session_id, std::move(ifrt_client),
                                    std::move(host_buffer_store));
       });
+  if (shared_memory_directory.has_value()) {
+    TF_RETURN_IF_ERROR(service->EnableSharedMemoryHostBuffers(
+        *std::move(shared_memory_directory)));
+  }
 
   return Create(address, std::move(service));
 }
@@ -18,6 +18,7 @@
 #define XLA_PYTHON_IFRT_PROXY_SERVER_GRPC_SERVER_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -50,7 +51,8 @@ class GrpcServer {
       absl::string_view address,
       absl::AnyInvocable<absl::StatusOr<std::shared_ptr<xla::ifrt::Client>>(
           AttributeMap initialization_data)>
-          backend_ifrt_client_factory);
+          backend_ifrt_client_factory,
+      std::optional<std::string> shared_memory_directory = std::nullopt);
 
   // Starts shutting down the server and waits until it properly shuts down.
   ~GrpcServer();
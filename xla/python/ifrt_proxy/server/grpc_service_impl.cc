@@ -17,6 +17,7 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -34,14 +35,46 @@
 #include "xla/python/ifrt/attribute_map.h"
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.pb.h"
 #include "xla/python/ifrt_proxy/common/proto_util.h"
+#include "xla/python/ifrt_proxy/common/shared_memory_host_buffer.h"
 #include "xla/python/ifrt_proxy/server/host_buffer.h"
 #include "xla/python/ifrt_proxy/server/version.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "tsl/platform/path.h"
+#include "tsl/platform/random.h"
 #include "tsl/profiler/lib/traceme.h"
 
 namespace xla {
 namespace ifrt {
 namespace proxy {
 
+GrpcServiceImpl::~GrpcServiceImpl() {
+  if (shared_memory_config_.has_value()) {
+    tsl::Env::Default()
+        ->DeleteFile(shared_memory_config_->probe_file())
+        .IgnoreError();
+  }
+}
+
+absl::Status GrpcServiceImpl::EnableSharedMemoryHostBuffers(
+    std::string directory) {
+  if (shared_memory_config_.has_value()) {
+    return absl::FailedPreconditionError(
+        "Shared memory host buffers are already enabled");
+  }
+  // A probe file with an unpredictable name only visible to clients that share
+  // the filesystem with the server, which tells them apart from remote clients
+  // that happen to have a directory with the same name.
+  GrpcSharedMemoryConfig config;
+  config.set_probe_file(tsl::io::JoinPath(
+      directory, absl::StrCat("ifrt_proxy_probe_", tsl::random::New64())));
+  TF_RETURN_IF_ERROR(tsl::WriteStringToFile(tsl::Env::Default(),
+                                            config.probe_file(), ""));
+  config.set_directory(std::move(directory));
+  shared_memory_config_ = std::move(config);
+  return absl::OkStatus();
+}
+
 ::grpc::Status GrpcServiceImpl::GetVersion(::grpc::ServerContext* context,
                                            const GrpcGetVersionRequest* request,
                                            GrpcGetVersionResponse* response) {
@@ -52,6 +85,9 @@ namespace proxy {
     return xla::ToGrpcStatus(protocol_version.status());
   }
   response->mutable_version()->set_protocol_version(*protocol_version);
+  if (shared_memory_config_.has_value()) {
+    *response->mutable_shared_memory() = *shared_memory_config_;
+  }
   return ::grpc::Status::OK;
 }
 
@@ -164,11 +200,28 @@ namespace proxy {
   VLOG(3) << "HostBufferStore starting to receive data "
           << metadata.ShortDebugString();
   std::string data;
-  data.reserve(metadata.buffer_size());
+  if (metadata.shared_memory()) {
+    if (!shared_memory_config_.has_value()) {
+      return ::grpc::Status(
+          ::grpc::StatusCode::FAILED_PRECONDITION,
+          "Shared memory host buffers are not enabled on this server");
+    }
+    const std::string path =
+        SharedMemoryHostBufferPath(shared_memory_config_->directory(),
+                                   metadata.session_id(), metadata.handle());
+    absl::Status status =
+        tsl::ReadFileToString(tsl::Env::Default(), path, &data);
+    tsl::Env::Default()->DeleteFile(path).IgnoreError();
+    if (!status.ok()) {
+      return xla::ToGrpcStatus(status);
+    }
+  } else {
+    data.reserve(metadata.buffer_size());
 
-  GrpcHostBufferStoreRequest request;
-  while (stream->Read(&request)) {
-    data.append(request.data());
+    GrpcHostBufferStoreRequest request;
+    while (stream->Read(&request)) {
+      data.append(request.data());
+    }
   }
   VLOG(3) << "HostBufferStore received all data "
           << metadata.ShortDebugString();
@@ -20,12 +20,15 @@
 #include <atomic>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
 #include <utility>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/functional/any_invocable.h"
 #include "absl/log/die_if_null.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
 #include "grpcpp/server_context.h"
@@ -54,6 +57,13 @@ class GrpcServiceImpl : public grpc::GrpcIfrtService::Service {
   explicit GrpcServiceImpl(BackendFactory backend_factory)
       : backend_factory_(ABSL_DIE_IF_NULL(std::move(backend_factory))) {}
 
+  ~GrpcServiceImpl() override;
+
+  // Lets clients that run on the same host hand host buffers to the server
+  // through files in `directory` instead of streaming them over gRPC. Must be
+  // called before the service starts handling requests.
+  absl::Status EnableSharedMemoryHostBuffers(std::string directory);
+
   ::grpc::Status GetVersion(::grpc::ServerContext* context,
                             const GrpcGetVersionRequest* request,
                             GrpcGetVersionResponse* response) override;
@@ -95,6 +105,8 @@ class GrpcServiceImpl : public grpc::GrpcIfrtService::Service {
   BackendFactory backend_factory_;
   std::atomic<uint64_t> next_session_id_ = 1;
 
+  std::optional<GrpcSharedMemoryConfig> shared_memory_config_;
+
   absl::Mutex host_buffer_store_mu_;
   absl::flat_hash_map<uint64_t,
                       std::shared_ptr<xla::ifrt::proxy::HostBufferStore>>
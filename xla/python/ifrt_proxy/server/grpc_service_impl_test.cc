@@ -34,9 +34,11 @@
 #include "xla/python/ifrt_proxy/client/grpc_host_buffer.h"
 #include "xla/python/ifrt_proxy/common/grpc_ifrt_service.grpc.pb.h"
 #include "xla/python/ifrt_proxy/common/ifrt_service.pb.h"
+#include "xla/python/ifrt_proxy/common/shared_memory_host_buffer.h"
 #include "xla/python/ifrt_proxy/server/grpc_server.h"
 #include "xla/python/ifrt_proxy/server/host_buffer.h"
 #include "xla/python/ifrt_proxy/server/version.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/status_matchers.h"
 #include "xla/tsl/platform/test.h"
 
@@ -175,6 +177,50 @@ TEST_P(GrpcIfrtServiceImplHostBufferTest, Delete) {
   EXPECT_TRUE(impl_.Test_DeleteHostBufferStore(kSessionId));
 }
 
+TEST_P(GrpcIfrtServiceImplHostBufferTest, StoreThroughSharedMemory) {
+  static constexpr uint64_t kSessionId = 1;
+
+  const std::string directory = tsl::testing::TmpDir();
+  ASSERT_THAT(impl_.EnableSharedMemoryHostBuffers(directory), IsOk());
+  auto store = std::make_shared<HostBufferStore>();
+  ASSERT_TRUE(impl_.Test_InsertHostBufferStore(kSessionId, store));
+  GrpcClientHostBufferStore client(stub_, Version(), kSessionId, directory);
+
+  constexpr uint64_t kHandle = 2;
+  const std::string data = GetTestData();
+  absl::string_view source(data);
+  absl::Cord cord(data);
+
+  ASSERT_THAT(client.Store(kHandle, source).Await(), IsOk());
+  EXPECT_THAT(client.Lookup(kHandle).Await(), IsOkAndHolds(data));
+  ASSERT_THAT(client.Store(kHandle + 1, cord).Await(), IsOk());
+  EXPECT_THAT(client.Lookup(kHandle + 1).Await(), IsOkAndHolds(data));
+
+  // The server consumes the staged files.
+  EXPECT_FALSE(tsl::Env::Default()
+                   ->FileExists(SharedMemoryHostBufferPath(
+                       directory, kSessionId, kHandle))
+                   .ok());
+
+  EXPECT_TRUE(impl_.Test_DeleteHostBufferStore(kSessionId));
+}
+
+TEST_P(GrpcIfrtServiceImplHostBufferTest,
+       SharedMemoryStoreFailsIfNotEnabled) {
+  static constexpr uint64_t kSessionId = 1;
+
+  auto store = std::make_shared<HostBufferStore>();
+  ASSERT_TRUE(impl_.Test_InsertHostBufferStore(kSessionId, store));
+  GrpcClientHostBufferStore client(stub_, Version(), kSessionId,
+                                   tsl::testing::TmpDir());
+
+  const std::string data = GetTestData();
+  EXPECT_THAT(client.Store(/*handle=*/2, absl::string_view(data)).Await(),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+
+  EXPECT_TRUE(impl_.Test_DeleteHostBufferStore(kSessionId));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     DataSize, GrpcIfrtServiceImplHostBufferTest,
     testing::Values(0,                  // Empty host buffer.
@@ -34,6 +34,10 @@ class PjRtCompatibleClient;
 
 // Common implementation of `xla::ifrt::Client::RemapArrays` for
 // `PjRtCompatibleClient`.
+//
+// Remapping never moves data: output shards are the `PjRtBuffer`s of the
+// mapped input shards, shared with the inputs for `kReuseInput` and taken
+// from them for `kDonateInput`.
 absl::StatusOr<std::vector<tsl::RCReference<xla::ifrt::Array>>>
 PjRtCompatibleClientRemapArrays(
     PjRtCompatibleClient* client, const RemapPlan& plan,
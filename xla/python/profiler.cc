@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/python/profiler.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
@@ -35,6 +36,7 @@ limitations under the License.
 #include "xla/python/aggregate_profile.h"
 #include "xla/python/profiler/profile_data.h"
 #include "xla/python/profiler_utils.h"
+#include "xla/python/sampled_profiler.h"
 #include "xla/python/xplane_to_profile_instructions.h"
 #include "xla/tsl/platform/macros.h"
 #include "xla/tsl/profiler/rpc/client/capture_profile.h"
@@ -217,6 +219,39 @@ void BuildProfilerSubmodule(nb::module_& m) {
                  /* also_export_trace_json= */ true));
            });
 
+  nb::class_<SampledProfiler> sampled_profiler_class(profiler,
+                                                     "SampledProfiler");
+  sampled_profiler_class
+      .def(
+          "__init__",
+          [](SampledProfiler* self, nb::callable sink,
+             int64_t sample_every_n_steps, int64_t max_buffered_profiles,
+             int64_t export_every_n_samples, int percentile) {
+            SampledProfiler::Options options;
+            options.sample_every_n_steps = sample_every_n_steps;
+            options.max_buffered_profiles = max_buffered_profiles;
+            options.export_every_n_samples = export_every_n_samples;
+            options.percentile = percentile;
+            // The sink runs from step_end, which holds the GIL.
+            new (self) SampledProfiler(
+                options,
+                [sink = std::move(sink)](
+                    const tensorflow::profiler::ProfiledInstructionsProto&
+                        profile) {
+                  std::string serialized = profile.SerializeAsString();
+                  sink(nb::bytes(serialized.data(), serialized.size()));
+                });
+          },
+          nb::arg("sink"), nb::arg("sample_every_n_steps") = 100,
+          nb::arg("max_buffered_profiles") = 16,
+          nb::arg("export_every_n_samples") = 1, nb::arg("percentile") = 50)
+      .def("step_start",
+           [](SampledProfiler* self) { xla::ThrowIfError(self->StepStart()); })
+      .def("step_end",
+           [](SampledProfiler* self) { xla::ThrowIfError(self->StepEnd()); })
+      .def_prop_ro("num_steps", &SampledProfiler::num_steps)
+      .def_prop_ro("num_samples", &SampledProfiler::num_samples);
+
   nb::class_<tensorflow::ProfileOptions> profile_options_class(
       profiler, "ProfileOptions");
   profile_options_class
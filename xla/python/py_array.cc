@@ -1104,9 +1104,12 @@ PyArray::Storage::~PyArray_Storage() {
   }
   // Release GIL and then explicitly destroy `ifrt_array` to prevent deadlock on
   // CPU backend caused by interactions between argument donations and host
-  // callbacks.
-  nb::gil_scoped_release gil_release;
-  ifrt_array.reset();
+  // callbacks. Deleted and donated arrays have nothing to destroy, so skip the
+  // GIL round trip for them.
+  if (ifrt_array) {
+    nb::gil_scoped_release gil_release;
+    ifrt_array.reset();
+  }
 }
 
 absl::StatusOr<std::vector<PyArray>> PyArray::BatchedCopyToDeviceWithSharding(
@@ -1173,7 +1176,7 @@ absl::StatusOr<std::vector<PyArray>> PyArray::BatchedCopyToDeviceWithSharding(
 
   std::vector<std::pair<int, tsl::RCReference<ifrt::Array>>> ifrt_arrays;
   {
-    GlobalPyRefManager()->CollectGarbage();
+    GlobalPyRefManager()->MaybeCollectGarbage();
     nb::gil_scoped_release gil_release;
 
     for (auto& [key, batch] : batches) {
@@ -1227,7 +1230,7 @@ absl::StatusOr<PyArray> PyArray::BatchedDevicePut(
         ", dst_sharding=", nb::cast<absl::string_view>(nb::repr(sharding)));
   };
 
-  GlobalPyRefManager()->CollectGarbage();
+  GlobalPyRefManager()->MaybeCollectGarbage();
 
   auto n_devices = dst_devices.size();
 
@@ -1459,6 +1462,24 @@ absl::Status PyArray::BatchedBlockUntilReady(std::vector<nb::object> objs) {
   return AwaitBuffersReady(absl::MakeConstSpan(ifrt_arrays));
 }
 
+absl::Status PyArray::BatchedCopyToHostAsync(std::vector<nb::object> objs) {
+  std::vector<PyArray> py_arrays;
+  py_arrays.reserve(objs.size());
+  for (nb::handle obj : objs) {
+    if (!obj.type().is(PyArray::type())) {
+      return absl::InvalidArgumentError(
+          "PyArray::BatchedCopyToHostAsync can take PyArray only");
+    }
+    py_arrays.push_back(nb::borrow<PyArray>(obj));
+  }
+
+  GlobalPyRefManager()->MaybeCollectGarbage();
+  for (PyArray& py_array : py_arrays) {
+    TF_RETURN_IF_ERROR(py_array.CopySingleDeviceArrayToHostAsync());
+  }
+  return absl::OkStatus();
+}
+
 std::vector<PyArray> PyClient::LiveArrays() const {
   std::vector<PyArray> result;
   for (auto& shard : arrays_) {
@@ -1660,18 +1681,27 @@ std::optional<std::vector<int64_t>> ByteStridesOrDefaultForShapeInt64(
   return ByteStridesForShape(shape);
 }
 
+// Returns true if an array with `layout` is dense and can be described by
+// NumPy byte strides, i.e. it is a permutation of the dimensions without
+// tiling, element packing or padding.
+bool HasStridedLayout(const Layout& layout) {
+  return layout.tiles().empty() && layout.element_size_in_bits() == 0 &&
+         layout.tail_padding_alignment_in_elements() <= 1;
+}
+
 bool IsZeroCopyableCpuBuffer(const PjRtBuffer* buf) {
   // For CPU buffers with device-specific layouts, we must delinearize
   // to unpack the array. This could happen for the host buffer
   // pre-mapped to the TPU device, a.k.a., pinned host buffers for the
-  // device.
-  bool has_default_layout =
-      buf->layout() == nullptr || HasDefaultLayout(buf->layout()->xla_layout());
+  // device. Dense layouts with a non-default dimension order are fine, since
+  // the NumPy view uses byte strides computed from the layout.
+  bool has_strided_layout =
+      buf->layout() == nullptr || HasStridedLayout(buf->layout()->xla_layout());
   // On CPU for values >= 8 bits, we can return the value in a zero-copy way.
   // For sub-byte values, we must copy in order to unpack the array.
   return buf->IsOnCpu() &&
          !primitive_util::IsSubByteNonPredType(buf->element_type()) &&
-         has_default_layout;
+         has_strided_layout;
 }
 }  // namespace
 
@@ -2041,6 +2071,10 @@ absl::Status PyArray::RegisterTypes(nb::module_& m) {
         return xla::ValueOrThrow(PyArray::BatchedCopyToDeviceWithSharding(
             arrays, device_lists, shardings, array_copy_semantics));
       });
+  m.attr("batched_copy_array_to_host_async") = nb::cpp_function(
+      [](std::vector<nb::object> objs) {
+        xla::ThrowIfError(PyArray::BatchedCopyToHostAsync(std::move(objs)));
+      });
   m.attr("array_result_handler") = nb::cpp_function(
       [](nb::object aval, nb::object sharding, bool committed,
          bool skip_checks) -> nb_class_ptr<PyArrayResultHandler> {
@@ -313,6 +313,12 @@ class PyArray : public nanobind::object {
   static absl::Status BatchedBlockUntilReady(
       std::vector<nanobind::object> objs);
 
+  // Starts device-to-host copies of all `objs` before returning, so that the
+  // transfers of many small arrays are enqueued back to back instead of being
+  // interleaved with Python dispatch of each fetch.
+  static absl::Status BatchedCopyToHostAsync(
+      std::vector<nanobind::object> objs);
+
  private:
   absl::StatusOr<PyArray> AssertUnsharded(absl::string_view api);
 
@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "absl/container/inlined_vector.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
 #include "absl/types/span.h"
 #include "nanobind/nanobind.h"
 
@@ -55,17 +56,26 @@ PythonRefManager::ManageReferences(absl::Span<nb::object> objects) {
   return std::make_shared<ManagedPyObjects>(this, objects);
 }
 
+void PythonRefManager::IncrementGarbageCount(int weight) {
+  if (garbage_count_.fetch_add(weight, std::memory_order_relaxed) == 0) {
+    oldest_garbage_nanos_.store(absl::GetCurrentTimeNanos(),
+                                std::memory_order_relaxed);
+  }
+}
+
 void PythonRefManager::AddGarbage(nb::object garbage) {
   absl::MutexLock lock(&mu_);
-  // We want to collect arbitrary python garbage (e.g., buffers) aggressively.
-  garbage_count_.fetch_add(100, std::memory_order_relaxed);
+  // We want to collect arbitrary python garbage (e.g., buffers) more often
+  // than tracebacks, but batch it so that transfer threads releasing arrays
+  // don't force a collection on every API call. MaybeCollectGarbage() bounds
+  // how long the garbage can wait.
+  IncrementGarbageCount(10);
   python_garbage_.push_back(std::move(garbage));
 }
 
 void PythonRefManager::AddGarbage(absl::Span<nb::object> garbage) {
   absl::MutexLock lock(&mu_);
-  // We want to collect arbitrary python garbage (e.g., buffers) aggressively.
-  garbage_count_.fetch_add(100, std::memory_order_relaxed);
+  IncrementGarbageCount(10);
   for (nb::object& o : garbage) {
     python_garbage_.push_back(std::move(o));
   }
@@ -77,7 +87,7 @@ void PythonRefManager::AddGarbage(
   // We don't care about collecting stack frame objects often. We grab a lot of
   // tracebacks and the code objects are most likely live for the entire
   // process.
-  garbage_count_.fetch_add(1, std::memory_order_relaxed);
+  IncrementGarbageCount(1);
   for (const auto& o : garbage) {
     python_garbage_.push_back(nb::steal(reinterpret_cast<PyObject*>(o.first)));
   }
@@ -85,6 +95,9 @@ void PythonRefManager::AddGarbage(
 
 void PythonRefManager::CollectGarbage() {
   // TODO(phawkins): we should CHECK(PyGILState_Check());
+  if (garbage_count_.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
   std::deque<nanobind::object> garbage;
   {
     absl::MutexLock lock(&mu_);
@@ -19,6 +19,7 @@ limitations under the License.
 #include <Python.h>
 
 #include <atomic>
+#include <cstdint>
 #include <deque>
 #include <memory>
 #include <utility>
@@ -26,6 +27,7 @@ limitations under the License.
 #include "absl/base/thread_annotations.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
 #include "absl/types/span.h"
 #include "nanobind/nanobind.h"
 
@@ -78,24 +80,43 @@ class PythonRefManager {
 
   // Releases the contents of python_garbage_. Requires that the GIL is held.
   // The client calls this method during API entry points where the GIL is held
-  // to free any garbage that has accumulated.
+  // to free any garbage that has accumulated. Returns without taking the lock
+  // if there is no garbage.
   void CollectGarbage();
 
   // Cheaper version of CollectGarbage() with relaxed consistency and frequency.
-  // The purpose of this function is to amortize lock acquisition costs over
-  // a larger number of API calls.
+  // The purpose of this function is to amortize lock acquisition and decref
+  // costs over a larger number of API calls: garbage is released in batches of
+  // kGarbageBatchSize, or once the oldest garbage has waited for longer than
+  // kMaxGarbageAgeNanos, so that device memory held by released arrays is not
+  // kept alive indefinitely.
   void MaybeCollectGarbage() {
-    if (garbage_count_.load(std::memory_order_relaxed) >= 100) {
+    int count = garbage_count_.load(std::memory_order_relaxed);
+    if (count == 0) {
+      return;
+    }
+    int64_t age_nanos = absl::GetCurrentTimeNanos() -
+                        oldest_garbage_nanos_.load(std::memory_order_relaxed);
+    if (count >= kGarbageBatchSize || age_nanos >= kMaxGarbageAgeNanos) {
       CollectGarbage();
     }
   }
 
  private:
+  static constexpr int kGarbageBatchSize = 100;
+  static constexpr int64_t kMaxGarbageAgeNanos = 1000 * 1000;
+
+  // Adds `weight` to garbage_count_, recording the time when the first
+  // garbage is added after a collection.
+  void IncrementGarbageCount(int weight) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   absl::Mutex mu_;
   std::deque<nanobind::object> python_garbage_ ABSL_GUARDED_BY(mu_);
 
-  // Writes to garbage_count_ are protected by mu_, reads are not protected.
+  // Writes to garbage_count_ and oldest_garbage_nanos_ are protected by mu_,
+  // reads are not protected.
   std::atomic<int> garbage_count_{0};
+  std::atomic<int64_t> oldest_garbage_nanos_{0};
 };
 
 // A global PythonRefManager. Unless `CollectGarbage()` is called before
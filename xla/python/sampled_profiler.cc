@@ -0,0 +1,85 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/python/sampled_profiler.h"
+
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "xla/python/aggregate_profile.h"
+#include "xla/python/xplane_to_profile_instructions.h"
+#include "xla/tsl/platform/errors.h"
+#include "tsl/profiler/lib/profiler_session.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace xla {
+
+SampledProfiler::SampledProfiler(Options options, Sink sink)
+    : options_(std::move(options)), sink_(std::move(sink)) {
+  CHECK_GT(options_.sample_every_n_steps, 0);
+  CHECK_GT(options_.max_buffered_profiles, 0);
+  CHECK_GT(options_.export_every_n_samples, 0);
+}
+
+absl::Status SampledProfiler::StepStart() {
+  if (session_ != nullptr) {
+    return absl::FailedPreconditionError(
+        "StepStart called twice without StepEnd");
+  }
+  if (num_steps_++ % options_.sample_every_n_steps != 0) {
+    return absl::OkStatus();
+  }
+  session_ = tsl::ProfilerSession::Create(options_.profile_options);
+  if (absl::Status status = session_->Status(); !status.ok()) {
+    // Most likely another session is active; skip this sample.
+    VLOG(1) << "Skipping sampled step " << num_steps_ - 1 << ": " << status;
+    session_.reset();
+  }
+  return absl::OkStatus();
+}
+
+absl::Status SampledProfiler::StepEnd() {
+  if (session_ == nullptr) {
+    return absl::OkStatus();
+  }
+  std::vector<tensorflow::profiler::XSpace> xspaces(1);
+  absl::Status collected = session_->CollectData(&xspaces[0]);
+  session_.reset();
+  TF_RETURN_IF_ERROR(collected);
+
+  tensorflow::profiler::ProfiledInstructionsProto profile;
+  TF_RETURN_IF_ERROR(
+      ConvertXplaneToProfiledInstructionsProto(std::move(xspaces), &profile));
+  if (profiles_.size() >= options_.max_buffered_profiles) {
+    profiles_.pop_front();
+  }
+  profiles_.push_back(std::move(profile));
+
+  if (++num_samples_ % options_.export_every_n_samples == 0) {
+    std::vector<tensorflow::profiler::ProfiledInstructionsProto> profiles(
+        profiles_.begin(), profiles_.end());
+    tensorflow::profiler::ProfiledInstructionsProto aggregated;
+    AggregateProfiledInstructionsProto(profiles, options_.percentile,
+                                       &aggregated);
+    sink_(aggregated);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace xla
@@ -0,0 +1,90 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_PYTHON_SAMPLED_PROFILER_H_
+#define XLA_PYTHON_SAMPLED_PROFILER_H_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/status/status.h"
+#include "tsl/profiler/lib/profiler_session.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+#include "tsl/profiler/protobuf/profiler_options.pb.h"
+
+namespace xla {
+
+// Always-on profiler that traces one of every `sample_every_n_steps` steps and
+// periodically exports per-HLO-op latencies, aggregated over the most recently
+// sampled steps, to a user provided sink. Steps that are not sampled only pay
+// for a counter increment, which makes it suitable for production jobs.
+//
+// Only one profiler session can be active in a process, so sampled steps are
+// skipped while another session (e.g. a user requested trace) is running.
+//
+// This class is not thread-safe; steps are expected to be delimited by a
+// single thread, typically the training or serving loop.
+class SampledProfiler {
+ public:
+  struct Options {
+    // Trace one of every `sample_every_n_steps` steps.
+    int64_t sample_every_n_steps = 100;
+    // Maximum number of sampled step profiles kept for aggregation. Older
+    // profiles are dropped first.
+    int64_t max_buffered_profiles = 16;
+    // Export aggregated stats after every `export_every_n_samples` samples.
+    int64_t export_every_n_samples = 1;
+    // Percentile of per-op latencies across buffered profiles to export.
+    int percentile = 50;
+    tensorflow::ProfileOptions profile_options =
+        tsl::ProfilerSession::DefaultOptions();
+  };
+
+  using Sink = absl::AnyInvocable<void(
+      const tensorflow::profiler::ProfiledInstructionsProto&)>;
+
+  SampledProfiler(Options options, Sink sink);
+
+  SampledProfiler(const SampledProfiler&) = delete;
+  SampledProfiler& operator=(const SampledProfiler&) = delete;
+
+  // Marks the beginning of a step, and starts tracing if it is sampled.
+  absl::Status StepStart();
+
+  // Marks the end of the step started by the last StepStart call. For sampled
+  // steps, collects the trace and exports aggregated stats when due.
+  absl::Status StepEnd();
+
+  int64_t num_steps() const { return num_steps_; }
+  int64_t num_samples() const { return num_samples_; }
+
+ private:
+  Options options_;
+  Sink sink_;
+
+  int64_t num_steps_ = 0;
+  int64_t num_samples_ = 0;
+
+  // Session tracing the current step, if it is sampled.
+  std::unique_ptr<tsl::ProfilerSession> session_;
+  // Bounded window of the most recent sampled step profiles.
+  std::deque<tensorflow::profiler::ProfiledInstructionsProto> profiles_;
+};
+
+}  // namespace xla
+
+#endif  // XLA_PYTHON_SAMPLED_PROFILER_H_
@@ -0,0 +1,86 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/python/sampled_profiler.h"
+
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "xla/tsl/platform/test.h"
+#include "tsl/platform/status_matchers.h"
+#include "tsl/profiler/lib/profiler_session.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+
+namespace xla {
+namespace {
+
+using ::tsl::testing::IsOk;
+using ::tsl::testing::StatusIs;
+
+TEST(SampledProfilerTest, SamplesEveryNSteps) {
+  int num_exports = 0;
+  SampledProfiler::Options options;
+  options.sample_every_n_steps = 3;
+  options.export_every_n_samples = 2;
+  SampledProfiler profiler(
+      options, [&](const tensorflow::profiler::ProfiledInstructionsProto&) {
+        ++num_exports;
+      });
+
+  for (int i = 0; i < 12; ++i) {
+    ASSERT_THAT(profiler.StepStart(), IsOk());
+    ASSERT_THAT(profiler.StepEnd(), IsOk());
+  }
+  EXPECT_EQ(profiler.num_steps(), 12);
+  EXPECT_EQ(profiler.num_samples(), 4);
+  EXPECT_EQ(num_exports, 2);
+}
+
+TEST(SampledProfilerTest, SkipsSamplesWhileAnotherSessionIsActive) {
+  int num_exports = 0;
+  SampledProfiler::Options options;
+  options.sample_every_n_steps = 1;
+  SampledProfiler profiler(
+      options, [&](const tensorflow::profiler::ProfiledInstructionsProto&) {
+        ++num_exports;
+      });
+
+  {
+    std::unique_ptr<tsl::ProfilerSession> session =
+        tsl::ProfilerSession::Create(tsl::ProfilerSession::DefaultOptions());
+    ASSERT_THAT(profiler.StepStart(), IsOk());
+    ASSERT_THAT(profiler.StepEnd(), IsOk());
+  }
+  EXPECT_EQ(profiler.num_samples(), 0);
+
+  ASSERT_THAT(profiler.StepStart(), IsOk());
+  ASSERT_THAT(profiler.StepEnd(), IsOk());
+  EXPECT_EQ(profiler.num_samples(), 1);
+  EXPECT_EQ(num_exports, 1);
+}
+
+TEST(SampledProfilerTest, RejectsNestedSteps) {
+  SampledProfiler::Options options;
+  options.sample_every_n_steps = 1;
+  SampledProfiler profiler(
+      options, [](const tensorflow::profiler::ProfiledInstructionsProto&) {});
+  ASSERT_THAT(profiler.StepStart(), IsOk());
+  EXPECT_THAT(profiler.StepStart(),
+              StatusIs(absl::StatusCode::kFailedPrecondition));
+  ASSERT_THAT(profiler.StepEnd(), IsOk());
+}
+
+}  // namespace
+}  // namespace xla
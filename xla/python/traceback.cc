@@ -24,11 +24,13 @@ limitations under the License.
 #include <vector>
 
 #include "absl/base/casts.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/hash/hash.h"
 #include "absl/log/check.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "nanobind/nanobind.h"
 #include "nanobind/stl/optional.h"  // IWYU pragma: keep
 #include "nanobind/stl/string.h"  // IWYU pragma: keep
@@ -49,8 +51,35 @@ namespace xla {
 namespace nb = nanobind;
 
 bool Traceback::enabled_ = true;
+int Traceback::sample_rate_ = 1;
+int Traceback::sample_count_ = 0;
+
+namespace {
+
+// Tracebacks returned by Traceback::Get(), keyed by their frames. Keys point
+// into the frames of the interned tracebacks, which are immutable. The table
+// keeps the interned tracebacks alive, so it is cleared when it grows past
+// kMaxInternedTracebacks. Protected by GIL.
+using InternedTracebacks =
+    absl::flat_hash_map<absl::Span<const std::pair<PyCodeObject*, int>>,
+                        nb_traceback>;
+constexpr size_t kMaxInternedTracebacks = 4096;
+
+InternedTracebacks& GetInternedTracebacks() {
+  static auto* tracebacks = new InternedTracebacks();
+  return *tracebacks;
+}
+
+}  // namespace
 
 Traceback::Traceback() {
+  DCHECK(PyGILState_Check());
+  CaptureFrames(frames_);
+}
+
+Traceback::Traceback(RawFrames frames) : frames_(std::move(frames)) {}
+
+void Traceback::CaptureFrames(RawFrames& frames) {
   DCHECK(PyGILState_Check());
   PyThreadState* thread_state = PyThreadState_GET();
 
@@ -63,7 +92,7 @@ Traceback::Traceback() {
   for (PyFrameObject* py_frame = thread_state->frame; py_frame != nullptr;
        py_frame = py_frame->f_back) {
     Py_INCREF(py_frame->f_code);
-    frames_.emplace_back(py_frame->f_code, py_frame->f_lasti * kLastiWordBytes);
+    frames.emplace_back(py_frame->f_code, py_frame->f_lasti * kLastiWordBytes);
   }
 #else  // PY_VERSION_HEX < 0x030b0000
 
@@ -77,14 +106,14 @@ Traceback::Traceback() {
        f != nullptr; f = f->previous) {
     if (_PyFrame_IsIncomplete(f)) continue;
     Py_INCREF(f->f_code);
-    frames_.emplace_back(f->f_code,
-                         _PyInterpreterFrame_LASTI(f) * sizeof(_Py_CODEUNIT));
+    frames.emplace_back(f->f_code,
+                        _PyInterpreterFrame_LASTI(f) * sizeof(_Py_CODEUNIT));
   }
 #else   // PLATFORM_GOOGLE
   PyFrameObject* next;
   for (PyFrameObject* py_frame = PyThreadState_GetFrame(thread_state);
        py_frame != nullptr; py_frame = next) {
-    frames_.emplace_back(PyFrame_GetCode(py_frame), PyFrame_GetLasti(py_frame));
+    frames.emplace_back(PyFrame_GetCode(py_frame), PyFrame_GetLasti(py_frame));
     next = PyFrame_GetBack(py_frame);
     Py_XDECREF(py_frame);
   }
@@ -141,11 +170,40 @@ std::optional<nb_class_ptr<Traceback>> Traceback::Get() {
   if (!enabled_) {
     return std::nullopt;
   }
-  return make_nb_class<Traceback>();
+  if (sample_rate_ > 1 && ++sample_count_ < sample_rate_) {
+    return std::nullopt;
+  }
+  sample_count_ = 0;
+
+  RawFrames frames;
+  CaptureFrames(frames);
+
+  // Repeated call sites return the same traceback object instead of
+  // allocating a new one.
+  InternedTracebacks& interned = GetInternedTracebacks();
+  auto it = interned.find(absl::MakeConstSpan(frames));
+  if (it != interned.end()) {
+    for (const auto& frame : frames) {
+      Py_DECREF(frame.first);
+    }
+    return it->second;
+  }
+  if (interned.size() >= kMaxInternedTracebacks) {
+    interned.clear();
+  }
+  nb_traceback traceback = make_nb_class<Traceback>(std::move(frames));
+  interned.emplace(absl::MakeConstSpan(traceback->raw_frames()), traceback);
+  return traceback;
 }
 
 void Traceback::SetEnabled(bool enabled) { enabled_ = enabled; }
 
+void Traceback::SetSampleRate(int sample_rate) {
+  CHECK_GE(sample_rate, 1);
+  sample_rate_ = sample_rate;
+  sample_count_ = 0;
+}
+
 nb::object Traceback::AsPythonTraceback() const {
   nb::object traceback = nb::none();
   nb::dict globals;
@@ -243,6 +301,15 @@ void BuildTracebackSubmodule(nb::module_& m) {
       [](nb::object /* cls */, bool enabled) {
         return Traceback::SetEnabled(enabled);
       });
+  traceback.def_prop_rw_static(
+      "sample_rate",
+      [](nb::object /* cls */) { return Traceback::sample_rate(); },
+      [](nb::object /* cls */, int sample_rate) {
+        if (sample_rate < 1) {
+          throw nb::value_error("Traceback.sample_rate must be positive");
+        }
+        return Traceback::SetSampleRate(sample_rate);
+      });
   traceback.def_static(
       "get_traceback", []() { return Traceback::Get(); },
       R"doc(
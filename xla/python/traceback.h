@@ -42,8 +42,20 @@ class Traceback {
   // Requires GIL.
   static void SetEnabled(bool enabled);
 
+  // Requires GIL. Get() captures a traceback for one in every `sample_rate`
+  // calls and returns std::nullopt for the others. A sample rate of 1 (the
+  // default) captures every traceback.
+  static int sample_rate() { return sample_rate_; }
+  // Requires GIL.
+  static void SetSampleRate(int sample_rate);
+
+  using RawFrames = absl::InlinedVector<std::pair<PyCodeObject*, int>, 32>;
+
   // Requires GIL. Don't call this directly, you're looking for Get().
   Traceback();
+  // Requires GIL. Takes ownership of the references to the code objects in
+  // `frames`.
+  explicit Traceback(RawFrames frames);
   // Requires GIL.
   ~Traceback();
 
@@ -65,21 +77,18 @@ class Traceback {
   };
   std::vector<Frame> Frames() const;
 
-  const absl::InlinedVector<std::pair<PyCodeObject*, int>, 32>& raw_frames()
-      const {
-    return frames_;
-  }
+  const RawFrames& raw_frames() const { return frames_; }
 
   // Returns the traceback as a fake Python Traceback object, suitable for
   // using as an exception traceback.
   nanobind::object AsPythonTraceback() const;
 
+  // Tracebacks returned by Get() are interned, so repeated call sites
+  // usually compare equal by identity.
   bool operator==(const Traceback& other) const {
-    return frames_ == other.frames_;
-  }
-  bool operator!=(const Traceback& other) const {
-    return frames_ != other.frames_;
+    return this == &other || frames_ == other.frames_;
   }
+  bool operator!=(const Traceback& other) const { return !(*this == other); }
 
  private:
   // Each frame is a pair of a code object and a "lasti" instruction location
@@ -87,10 +96,16 @@ class Traceback {
   // versions; the lasti value here has already been multiplied by
   // sizeof(_Py_CODEUNIT) if needed and is suitable for passing to functions
   // like PyCode_Addr2Line().
-  absl::InlinedVector<std::pair<PyCodeObject*, int>, 32> frames_;
+  RawFrames frames_;
+
+  // Appends the frames of the calling thread's Python stack to `frames`,
+  // acquiring a reference to each code object.
+  static void CaptureFrames(RawFrames& frames);
 
   // Protected by GIL.
   static bool enabled_;
+  static int sample_rate_;
+  static int sample_count_;
 };
 
 using nb_traceback = nb_class_ptr<Traceback>;
@@ -28,6 +28,7 @@ limitations under the License.
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
+#include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "nanobind/nanobind.h"
 #include "nanobind/stl/array.h"  // IWYU pragma: keep
@@ -192,9 +193,13 @@ class PyTransferServerConnection {
 class PyTransferServer {
  public:
   PyTransferServer() = default;
+  // `transport` selects the bulk transport used for `transport_addresses`:
+  // "socket" for the built-in socket transport or the name of a transport
+  // registered with RegisterBulkTransportFactory().
   absl::Status Start(xla::ifrt::Client* client, size_t max_num_parallel_copies,
                      size_t xfer_size, const SocketAddress& addr,
-                     const std::vector<SocketAddress>& transport_addresses) {
+                     absl::string_view transport,
+                     const std::vector<std::string>& transport_addresses) {
     std::shared_ptr<BulkTransportFactory> factory;
     if (transport_addresses.empty()) {
       factory = BulkTransportFactory::CreateLocal();
@@ -204,8 +209,22 @@ class PyTransferServer {
       SlabAllocator uallocator(xla::ValueOrThrow(MapPjrtMemory(
                                    client, tmp->data(), tmp->size(), tmp)),
                                xfer_size);
-      factory = xla::ValueOrThrow(CreateSocketBulkTransportFactory(
-          transport_addresses, std::nullopt, uallocator));
+      if (transport == "socket") {
+        std::vector<SocketAddress> socket_addresses;
+        socket_addresses.reserve(transport_addresses.size());
+        for (const std::string& transport_address : transport_addresses) {
+          TF_ASSIGN_OR_RETURN(SocketAddress socket_address,
+                              SocketAddress::Parse(transport_address));
+          socket_addresses.push_back(socket_address);
+        }
+        TF_ASSIGN_OR_RETURN(factory, CreateSocketBulkTransportFactory(
+                                         std::move(socket_addresses),
+                                         std::nullopt, uallocator));
+      } else {
+        TF_ASSIGN_OR_RETURN(factory, CreateRegisteredBulkTransportFactory(
+                                         transport, transport_addresses,
+                                         uallocator));
+      }
     }
 
     server_ = std::make_shared<SocketServer>();
@@ -384,26 +403,21 @@ void RegisterTransferServerTypes(nanobind::module_& m) {
   m.def(
       "start_transfer_server",
       [](xla::nb_class_ptr<xla::PyClient> py_client, std::string address,
-         std::vector<std::string> transport_addresses_str,
-         size_t max_num_parallel_copies,
-         size_t transfer_size) -> PyTransferServer {
+         std::vector<std::string> transport_addresses,
+         size_t max_num_parallel_copies, size_t transfer_size,
+         std::string transport) -> PyTransferServer {
         PyTransferServer result;
-        std::vector<SocketAddress> transport_addresses;
-        transport_addresses.reserve(transport_addresses_str.size());
-        for (const std::string& addr : transport_addresses_str) {
-          transport_addresses.push_back(
-              xla::ValueOrThrow(SocketAddress::Parse(addr)));
-        }
         xla::ThrowIfError(result.Start(
             py_client->ifrt_client(), max_num_parallel_copies, transfer_size,
-            xla::ValueOrThrow(SocketAddress::Parse(address)),
+            xla::ValueOrThrow(SocketAddress::Parse(address)), transport,
             transport_addresses));
         return result;
       },
       nb::arg("client"), nb::arg("address") = SocketAddress().ToString(),
       nb::arg("transport_addresses") = std::vector<std::string>(),
       nb::arg("max_num_parallel_copies") = 8,
-      nb::arg("transfer_size") = 256 * 1024 * 1024);
+      nb::arg("transfer_size") = 256 * 1024 * 1024,
+      nb::arg("transport") = "socket");
 }
 
 }  // namespace aux
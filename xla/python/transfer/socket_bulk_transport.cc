@@ -17,6 +17,8 @@ limitations under the License.
 #include <linux/errqueue.h>
 #include <linux/tcp.h>
 #include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
 #include <sys/socket.h>
 
 #include <algorithm>
@@ -412,10 +414,23 @@ void SharedSendMsgQueue::StartSubConnectionSender(
 }
 
 RecvThreadState::RecvThreadState(std::optional<SlabAllocator> allocator,
-                                 SlabAllocator uallocator)
-    : allocator_(std::move(allocator)), uallocator_(std::move(uallocator)) {}
+                                 SlabAllocator uallocator,
+                                 std::optional<int> cpu)
+    : allocator_(std::move(allocator)),
+      uallocator_(std::move(uallocator)),
+      cpu_(cpu) {}
 
 void RecvThreadState::DoRecvWork() {
+  if (cpu_.has_value()) {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(*cpu_, &cpus);
+    int err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (err != 0) {
+      LOG(WARNING) << "Failed to pin recv-thread to cpu " << *cpu_ << ": "
+                   << strerror(err);
+    }
+  }
   size_t i = 0;
   size_t zc_send_count = 0;
   size_t non_zc_send_count = 0;
@@ -456,9 +471,11 @@ void RecvThreadState::ScheduleRecvWork(
 }
 
 std::shared_ptr<RecvThreadState> RecvThreadState::Create(
-    std::optional<SlabAllocator> allocator, SlabAllocator uallocator) {
+    std::optional<SlabAllocator> allocator, SlabAllocator uallocator,
+    std::optional<int> cpu) {
   auto result = std::shared_ptr<RecvThreadState>(
-      new RecvThreadState(allocator, uallocator), [](RecvThreadState* result) {
+      new RecvThreadState(allocator, uallocator, cpu),
+      [](RecvThreadState* result) {
         {
           absl::MutexLock l(&result->recv_mu_);
           result->recv_shutdown_ = true;
@@ -756,7 +773,8 @@ class SocketBulkTransportFactory : public BulkTransportFactory {
 absl::StatusOr<std::shared_ptr<BulkTransportFactory>>
 CreateSocketBulkTransportFactory(std::vector<SocketAddress> addrs,
                                  std::optional<SlabAllocator> allocator,
-                                 SlabAllocator unpinned_allocator) {
+                                 SlabAllocator unpinned_allocator,
+                                 std::vector<int> recv_thread_cpus) {
   size_t num_connections = addrs.size();
 
   std::vector<std::shared_ptr<RecvThreadState>> thread_states;
@@ -764,8 +782,12 @@ CreateSocketBulkTransportFactory(std::vector<SocketAddress> addrs,
   thread_states.reserve(num_connections);
   send_work_queues.reserve(num_connections);
   for (int i = 0; i < num_connections; ++i) {
+    std::optional<int> cpu;
+    if (!recv_thread_cpus.empty()) {
+      cpu = recv_thread_cpus[i % recv_thread_cpus.size()];
+    }
     thread_states.push_back(
-        RecvThreadState::Create(allocator, unpinned_allocator));
+        RecvThreadState::Create(allocator, unpinned_allocator, cpu));
     send_work_queues.push_back(SharedSendWorkQueue::Start());
   }
   return SocketBulkTransportFactory::Create(addrs, std::move(thread_states),
@@ -149,13 +149,15 @@ class RecvThreadState {
           void(absl::StatusOr<aux::BulkTransportInterface::Message> msg) &&>
           on_recv);
 
-  // Starts the worker thread.
+  // Starts the worker thread. If `cpu` is set, the thread is pinned to it so
+  // that it stays close to the NIC queue which serves its connection.
   static std::shared_ptr<RecvThreadState> Create(
-      std::optional<SlabAllocator> allocator, SlabAllocator uallocator);
+      std::optional<SlabAllocator> allocator, SlabAllocator uallocator,
+      std::optional<int> cpu = std::nullopt);
 
  private:
   RecvThreadState(std::optional<SlabAllocator> allocator,
-                  SlabAllocator uallocator);
+                  SlabAllocator uallocator, std::optional<int> cpu);
   ~RecvThreadState() = default;
 
   void DoRecvWork();
@@ -173,6 +175,7 @@ class RecvThreadState {
 
   std::optional<SlabAllocator> allocator_;
   SlabAllocator uallocator_;
+  std::optional<int> cpu_;
   absl::Mutex recv_mu_;
   bool recv_shutdown_ = false;
   std::deque<recv_work_item> recv_work_items_;
@@ -181,10 +184,18 @@ class RecvThreadState {
 
 // Create a socket transport factory that allocates out of allocator and
 // unpinned_allocator and communicates over all addrs in parallel.
+//
+// Every address gets its own connection, and messages are striped across
+// connections as they become ready to send. Repeating an address opens several
+// connections over the same interface, which is needed to saturate fast NICs.
+// The recv thread of connection i is pinned to
+// recv_thread_cpus[i % recv_thread_cpus.size()] if recv_thread_cpus is not
+// empty.
 absl::StatusOr<std::shared_ptr<BulkTransportFactory>>
 CreateSocketBulkTransportFactory(std::vector<SocketAddress> addrs,
                                  std::optional<SlabAllocator> allocator,
-                                 SlabAllocator unpinned_allocator);
+                                 SlabAllocator unpinned_allocator,
+                                 std::vector<int> recv_thread_cpus = {});
 
 }  // namespace aux
 
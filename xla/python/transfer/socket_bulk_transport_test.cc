@@ -36,6 +36,7 @@ limitations under the License.
 #include "absl/synchronization/notification.h"
 #include "xla/python/transfer/event_loop.h"
 #include "xla/python/transfer/streaming.h"
+#include "xla/tsl/platform/test_benchmark.h"
 
 namespace aux {
 
@@ -291,5 +292,83 @@ TEST(AckTableTest, Basic) {
   EXPECT_EQ(cbs_count, 0);
 }
 
+//===----------------------------------------------------------------------===//
+// Performance benchmarks.
+//===----------------------------------------------------------------------===//
+
+// Measures loopback throughput of 1MiB messages striped across
+// state.range(0) connections, optionally with pinned recv threads.
+static void BM_StripedTransfer(benchmark::State& state) {
+  const int num_connections = state.range(0);
+  const bool pin_recv_threads = state.range(1) != 0;
+  constexpr size_t kPacketSize = 1024 * 1024;
+  constexpr int kNumMessages = 64;
+
+  SlabAllocator allocator(
+      AllocateNetworkPinnedMemory(kPacketSize * 4 * num_connections).value(),
+      kPacketSize);
+  SlabAllocator uallocator(
+      AllocateAlignedMemory(kPacketSize * 4 * num_connections).value(),
+      kPacketSize);
+  std::vector<SocketAddress> addrs(num_connections);
+  std::vector<int> recv_thread_cpus;
+  if (pin_recv_threads) {
+    for (int i = 0; i < num_connections; ++i) {
+      recv_thread_cpus.push_back(i);
+    }
+  }
+  auto send_factory =
+      CreateSocketBulkTransportFactory(addrs, allocator, uallocator).value();
+  auto recv_factory = CreateSocketBulkTransportFactory(addrs, allocator,
+                                                       uallocator,
+                                                       recv_thread_cpus)
+                          .value();
+
+  auto init_res = send_factory->InitBulkTransport();
+  auto recv_res = recv_factory->RecvBulkTransport(init_res.request);
+  std::move(init_res.start_bulk_transport)(recv_res.request);
+  std::unique_ptr<BulkTransportInterface> send_transport =
+      std::move(init_res.bulk_transport);
+  std::unique_ptr<BulkTransportInterface> recv_transport =
+      std::move(recv_res.bulk_transport);
+
+  std::string data(kPacketSize, 'x');
+  for (auto _ : state) {
+    absl::Mutex mu;
+    int pending = 2 * kNumMessages;
+    auto done = [&mu, &pending]() {
+      absl::MutexLock l(&mu);
+      --pending;
+    };
+    for (int i = 0; i < kNumMessages; ++i) {
+      BulkTransportInterface::SendMessage msg;
+      msg.data = data.data();
+      msg.size = data.size();
+      msg.on_send = [&](int bond_id, size_t size) {
+        recv_transport->Recv(
+            size, bond_id,
+            [&](absl::StatusOr<BulkTransportInterface::Message> msg) {
+              CHECK_OK(msg.status());
+              std::move(msg->on_done)();
+              done();
+            });
+      };
+      msg.on_done = done;
+      send_transport->Send(std::move(msg));
+    }
+    absl::MutexLock l(&mu);
+    auto cond = [&]() { return pending == 0; };
+    mu.Await(absl::Condition(&cond));
+  }
+  state.SetBytesProcessed(state.iterations() * kNumMessages * kPacketSize);
+}
+
+BENCHMARK(BM_StripedTransfer)
+    ->UseRealTime()
+    ->Args({1, 0})
+    ->Args({2, 0})
+    ->Args({4, 0})
+    ->Args({4, 1});
+
 }  // namespace
 }  // namespace aux
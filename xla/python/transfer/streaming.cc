@@ -23,17 +23,21 @@ limitations under the License.
 #include <cerrno>
 #include <cstdlib>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/functional/any_invocable.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/pjrt/pjrt_future.h"
@@ -206,6 +210,52 @@ std::shared_ptr<BulkTransportFactory> BulkTransportFactory::CreateLocal() {
   return std::make_shared<LocalBulkTransportFactory>();
 }
 
+namespace {
+
+struct BulkTransportRegistry {
+  absl::Mutex mu;
+  absl::flat_hash_map<std::string, BulkTransportFactoryCreator> creators
+      ABSL_GUARDED_BY(mu);
+};
+
+BulkTransportRegistry* bulk_transport_registry() {
+  static auto* registry = new BulkTransportRegistry();
+  return registry;
+}
+
+}  // namespace
+
+void RegisterBulkTransportFactory(absl::string_view transport_name,
+                                  BulkTransportFactoryCreator creator) {
+  BulkTransportRegistry* registry = bulk_transport_registry();
+  absl::MutexLock l(&registry->mu);
+  const bool inserted =
+      registry->creators
+          .insert({std::string(transport_name), std::move(creator)})
+          .second;
+  CHECK(inserted) << "Bulk transport '" << transport_name
+                  << "' already registered";
+}
+
+absl::StatusOr<std::shared_ptr<BulkTransportFactory>>
+CreateRegisteredBulkTransportFactory(
+    absl::string_view transport_name,
+    const std::vector<std::string>& transport_addresses,
+    SlabAllocator allocator) {
+  BulkTransportFactoryCreator creator;
+  {
+    BulkTransportRegistry* registry = bulk_transport_registry();
+    absl::MutexLock l(&registry->mu);
+    auto it = registry->creators.find(transport_name);
+    if (it == registry->creators.end()) {
+      return absl::NotFoundError(absl::StrCat(
+          "Bulk transport '", transport_name, "' is not registered"));
+    }
+    creator = it->second;
+  }
+  return creator(transport_addresses, std::move(allocator));
+}
+
 SlabAllocator::SlabAllocator(std::shared_ptr<absl::Span<uint8_t>> data,
                              size_t max_allocation_size) {
   state_ = tsl::TakeRef(new State);
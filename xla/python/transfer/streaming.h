@@ -17,6 +17,7 @@ limitations under the License.
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -26,6 +27,7 @@ limitations under the License.
 #include "absl/functional/any_invocable.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xla/pjrt/pjrt_future.h"
@@ -169,6 +171,27 @@ class BulkTransportFactory {
   static std::shared_ptr<BulkTransportFactory> CreateLocal();
 };
 
+// Creates a BulkTransportFactory which transfers data over transport-specific
+// addresses and stages received chunks in allocations from `allocator`.
+using BulkTransportFactoryCreator =
+    std::function<absl::StatusOr<std::shared_ptr<BulkTransportFactory>>(
+        const std::vector<std::string>& transport_addresses,
+        SlabAllocator allocator)>;
+
+// Registers a bulk transport implementation (e.g. one backed by ibverbs) under
+// `transport_name`, so that it can be selected at runtime in place of the
+// socket transport. Crashes if the same name is registered more than once.
+void RegisterBulkTransportFactory(absl::string_view transport_name,
+                                  BulkTransportFactoryCreator creator);
+
+// Creates a factory using the implementation registered under
+// `transport_name`.
+absl::StatusOr<std::shared_ptr<BulkTransportFactory>>
+CreateRegisteredBulkTransportFactory(
+    absl::string_view transport_name,
+    const std::vector<std::string>& transport_addresses,
+    SlabAllocator allocator);
+
 // Implementations may subclass this to represent the state of a connection.
 class ConnectionState : public tsl::ReferenceCounted<ConnectionState> {
  public:
@@ -23,6 +23,7 @@ limitations under the License.
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include "absl/container/flat_hash_map.h"
@@ -241,5 +242,27 @@ TEST(InvalidAllocator, InvalidAlignedAlloc) {
   ASSERT_FALSE(alloc2_or.ok());
 }
 
+TEST(BulkTransportRegistry, CreatesRegisteredTransport) {
+  std::vector<std::string> seen_addresses;
+  RegisterBulkTransportFactory(
+      "test-local", [&](const std::vector<std::string>& transport_addresses,
+                        SlabAllocator allocator) {
+        seen_addresses = transport_addresses;
+        return BulkTransportFactory::CreateLocal();
+      });
+  SlabAllocator allocator(AllocateAlignedMemory(4096).value(), 4096);
+
+  auto factory =
+      CreateRegisteredBulkTransportFactory("test-local", {"dev0"}, allocator);
+  ASSERT_TRUE(factory.ok()) << factory.status();
+  EXPECT_NE(*factory, nullptr);
+  EXPECT_EQ(seen_addresses, std::vector<std::string>({"dev0"}));
+
+  EXPECT_EQ(CreateRegisteredBulkTransportFactory("missing", {}, allocator)
+                .status()
+                .code(),
+            absl::StatusCode::kNotFound);
+}
+
 }  // namespace
 }  // namespace aux
@@ -765,6 +765,15 @@ absl::StatusOr<HloInstruction*> CloneBackwardChain(
   return last_cloned;
 }
 
+// Returns the total size of all arrays in `shape`.
+static int64_t ByteSizeOfArrays(const Shape& shape) {
+  int64_t size = 0;
+  ShapeUtil::ForEachLeafShape(shape, [&](const Shape& leaf, const ShapeIndex&) {
+    if (leaf.IsArray()) size += ShapeUtil::ByteSizeOfElements(leaf);
+  });
+  return size;
+}
+
 // Analyzes a loop and collects information to understand if this transformation
 // can be performed or if it should be performed (because there are collectives
 // to optimize).
@@ -774,10 +783,12 @@ class WhileLoopAnalysis {
       HloInstruction* while_instr, int64_t max_pipelining_per_loop,
       bool pipeline_use_tree, bool process_different_sized_options,
       TuplePointsToAnalysis* tuple_points_to_analysis, CallGraph* call_graph,
-      std::optional<ConstantValue> known_start = std::nullopt)
+      std::optional<ConstantValue> known_start = std::nullopt,
+      int64_t max_pipelined_bytes_per_loop = INT64_MAX)
       : while_(while_instr),
         loop_start_(known_start),
         max_pipelining_per_loop_(max_pipelining_per_loop),
+        max_pipelined_bytes_per_loop_(max_pipelined_bytes_per_loop),
         tuple_points_to_analysis_(tuple_points_to_analysis),
         call_graph_(call_graph),
         pipeline_use_tree_(pipeline_use_tree),
@@ -874,6 +885,7 @@ class WhileLoopAnalysis {
   absl::flat_hash_set<const HloInstruction*> invariant_loop_parameters_;
   absl::flat_hash_set<const HloInstruction*> invariant_loop_instructions_;
   int64_t max_pipelining_per_loop_;
+  int64_t max_pipelined_bytes_per_loop_;
 
   // Precomputed TuplePointsToAnalysis for the HLO module containing `while_`.
   // May be null, in which case the analysis will be performed from scratch.
@@ -1289,6 +1301,7 @@ void WhileLoopAnalysis::CollectCollectivesToMove(
                         /*is_linear=*/true};
   }
   int64_t count = 0;
+  int64_t pipelined_bytes = 0;
   absl::flat_hash_map<const HloInstruction*, int64_t> instruction_order;
   std::vector<HloInstruction*> instructions_post_order =
       while_body->MakeInstructionPostOrder();
@@ -1311,6 +1324,13 @@ void WhileLoopAnalysis::CollectCollectivesToMove(
     if (!should_process(instr)) {
       continue;
     }
+    int64_t instr_bytes = ByteSizeOfArrays(instr->shape());
+    if (pipelined_bytes + instr_bytes > max_pipelined_bytes_per_loop_) {
+      VLOG(5) << "Skipping " << instr->name() << " because pipelining it would"
+              << " exceed the memory limit of " << max_pipelined_bytes_per_loop_
+              << " bytes per loop";
+      continue;
+    }
     if (direction == CollectivePipeliner::PipeliningDirection::kForward ||
         direction == CollectivePipeliner::PipeliningDirection::kForwardSink) {
       auto [dyn_updates, formatting_ops] = CheckStoreIntoSliceIsCompatible(
@@ -1409,6 +1429,7 @@ void WhileLoopAnalysis::CollectCollectivesToMove(
       move_infos_.push_back(
           WhileMoveInfo{{instr}, {}, std::move(*chain_collected), {}, {}});
     }
+    pipelined_bytes += instr_bytes;
     if (move_infos_.size() >= max_pipelining_per_loop_) {
       break;
     }
@@ -3074,7 +3095,8 @@ absl::StatusOr<bool> CollectivePipeliner::RunPipeliner(
       auto loop_analysis = std::make_unique<WhileLoopAnalysis>(
           instruction, config_.max_pipelining_per_loop,
           config_.pipeline_use_tree, config_.process_different_sized_ops,
-          tuple_points_to_analysis.get(), call_graph.get());
+          tuple_points_to_analysis.get(), call_graph.get(),
+          /*known_start=*/std::nullopt, config_.max_pipelined_bytes_per_loop);
       loop_analysis->ComputeLoopStatistics();
       if (loop_analysis->GetLoopIterationCount() &&
           loop_analysis->GetLoopIterationCount()->GetUnsignedValue() > 1) {
@@ -113,6 +113,10 @@ class CollectivePipeliner : public HloModulePass {
     // Postprocessing hook which runs for every successfully pipelined op.
     HloPostprocessor postprocess_pipelined_ops = std::nullopt;
     int64_t collective_size_threshold_to_stop_sinking = INT64_MAX;
+    // Maximum total size in bytes of the results of collectives pipelined per
+    // loop. Pipelined results are carried across loop iterations in the loop
+    // state, so this bounds the extra memory used by the transformation.
+    int64_t max_pipelined_bytes_per_loop = INT64_MAX;
   };
   static const char* const kInsertedByPreviousStep;
   static const char* const kSunkByPreviousStep;
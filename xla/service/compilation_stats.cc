@@ -15,12 +15,22 @@ limitations under the License.
 
 #include "xla/service/compilation_stats.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "xla/service/metrics.pb.h"
 #include "xla/types.h"
 #include "tsl/platform/env.h"
 
@@ -40,6 +50,12 @@ class NoopStats : public CompilationStats {
 
   void RecordPassError(absl::string_view pass_name,
                        absl::string_view err) override{};
+
+  void RecordPassModuleSize(absl::string_view pass_name, uint64_t module_id,
+                            int64_t num_computations,
+                            int64_t num_instructions) override {}
+
+  std::vector<PassMetrics> GetPassMetrics() override { return {}; }
 };
 
 class Stats : public CompilationStats {
@@ -57,6 +73,12 @@ class Stats : public CompilationStats {
   void RecordPassError(absl::string_view pass_name,
                        absl::string_view err) override{};
 
+  void RecordPassModuleSize(absl::string_view pass_name, uint64_t module_id,
+                            int64_t num_computations,
+                            int64_t num_instructions) override;
+
+  std::vector<PassMetrics> GetPassMetrics() override;
+
  private:
   struct PassInfo {
     PassInfo(absl::string_view name, double duration)
@@ -65,6 +87,13 @@ class Stats : public CompilationStats {
     std::string name;
     int num_runs = 1;
     double duration_ms;
+    uint64_t module_id = 0;
+    int64_t num_computations = 0;
+    int64_t num_instructions = 0;
+    // Peak resident set size of the process at the end of the pass, and how
+    // much it grew while the pass was running.
+    int64_t peak_rss_bytes = 0;
+    int64_t peak_rss_growth_bytes = 0;
   };
 
   // Info about the passes that have been run so far.
@@ -74,8 +103,32 @@ class Stats : public CompilationStats {
   std::string current_pass_;
   // The start time of the currently running pass.
   uint64_t start_micros_;
+  // The peak resident set size when the currently running pass started.
+  int64_t start_peak_rss_bytes_ = 0;
+  // Module size recorded for the currently running pass.
+  uint64_t current_module_id_ = 0;
+  int64_t current_num_computations_ = 0;
+  int64_t current_num_instructions_ = 0;
 };
 
+int64_t GetPeakRssBytes() {
+#if defined(__linux__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+#if defined(__APPLE__)
+  // macOS reports the maximum resident set size in bytes.
+  return usage.ru_maxrss;
+#else
+  // Linux reports the maximum resident set size in kilobytes.
+  return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+#else
+  return 0;
+#endif
+}
+
 /* static */
 std::unique_ptr<CompilationStats> CompilationStats::MakeNoopStats() {
   return std::make_unique<NoopStats>();
@@ -91,16 +144,36 @@ void Stats::StartPass(absl::string_view pass_name) {
                         << current_pass_;
   pass_running_ = true;
   current_pass_ = std::string(pass_name);
+  current_module_id_ = 0;
+  current_num_computations_ = 0;
+  current_num_instructions_ = 0;
+  start_peak_rss_bytes_ = GetPeakRssBytes();
   start_micros_ = tsl::Env::Default()->NowMicros();
 }
 
+void Stats::RecordPassModuleSize(absl::string_view pass_name,
+                                 uint64_t module_id, int64_t num_computations,
+                                 int64_t num_instructions) {
+  CHECK(pass_running_);
+  CHECK_EQ(current_pass_, std::string(pass_name));
+  current_module_id_ = module_id;
+  current_num_computations_ += num_computations;
+  current_num_instructions_ += num_instructions;
+}
+
 void Stats::EndPass(absl::string_view pass_name) {
   CHECK(pass_running_);
   CHECK_EQ(current_pass_, std::string(pass_name));
   pass_running_ = false;
   uint64_t end_micros = tsl::Env::Default()->NowMicros();
   double duration_ms = (end_micros - start_micros_) / 1000.0;
-  passes_.push_back(PassInfo(current_pass_, duration_ms));
+  PassInfo& info = passes_.emplace_back(current_pass_, duration_ms);
+  info.module_id = current_module_id_;
+  info.num_computations = current_num_computations_;
+  info.num_instructions = current_num_instructions_;
+  info.peak_rss_bytes = GetPeakRssBytes();
+  info.peak_rss_growth_bytes =
+      std::max<int64_t>(0, info.peak_rss_bytes - start_peak_rss_bytes_);
 }
 
 void Stats::CompilationReport() {
@@ -115,8 +188,12 @@ void Stats::CompilationReport() {
     if (it == summary.end()) {
       summary.insert(std::make_pair(pass_name, pass_run));
     } else {
-      ++summary.at(pass_name).num_runs;
-      summary.at(pass_name).duration_ms += pass_run.duration_ms;
+      PassInfo& info = it->second;
+      ++info.num_runs;
+      info.duration_ms += pass_run.duration_ms;
+      info.num_instructions =
+          std::max(info.num_instructions, pass_run.num_instructions);
+      info.peak_rss_growth_bytes += pass_run.peak_rss_growth_bytes;
     }
   }
 
@@ -131,13 +208,73 @@ void Stats::CompilationReport() {
            std::make_pair(a.duration_ms, b.name);
   });
   LOG(INFO) << "Total runtime (ms) of HLO passes: " << total_duration;
-  LOG(INFO) << "Pass name, num runs, time (ms)";
+  LOG(INFO) << "Pass name, num runs, time (ms), max instructions, peak RSS "
+               "growth (MiB)";
   for (auto& pass_info : sorted_summary) {
     LOG(INFO) << pass_info.name << ", " << pass_info.num_runs << ", "
-              << pass_info.duration_ms;
+              << pass_info.duration_ms << ", " << pass_info.num_instructions
+              << ", " << pass_info.peak_rss_growth_bytes / (1024.0 * 1024.0);
   }
 }
 
 int Stats::GetPassesSize() { return passes_.size(); }
 
+std::vector<PassMetrics> Stats::GetPassMetrics() {
+  CHECK(!pass_running_) << "EndPass never called for " << current_pass_;
+  struct Aggregate {
+    int64_t num_runs = 0;
+    uint64_t duration_micros = 0;
+    int64_t max_num_computations = 0;
+    int64_t max_num_instructions = 0;
+    int64_t peak_rss_bytes = 0;
+    int64_t peak_rss_growth_bytes = 0;
+  };
+
+  // Keep the order in which (module, pass) pairs were first run.
+  std::vector<std::pair<uint64_t, std::string>> order;
+  absl::flat_hash_map<std::pair<uint64_t, std::string>, Aggregate> aggregates;
+  for (const PassInfo& pass_run : passes_) {
+    auto key = std::make_pair(pass_run.module_id, pass_run.name);
+    auto [it, inserted] = aggregates.try_emplace(key);
+    if (inserted) {
+      order.push_back(key);
+    }
+    Aggregate& aggregate = it->second;
+    ++aggregate.num_runs;
+    aggregate.duration_micros +=
+        static_cast<uint64_t>(pass_run.duration_ms * 1000.0);
+    aggregate.max_num_computations =
+        std::max(aggregate.max_num_computations, pass_run.num_computations);
+    aggregate.max_num_instructions =
+        std::max(aggregate.max_num_instructions, pass_run.num_instructions);
+    aggregate.peak_rss_bytes =
+        std::max(aggregate.peak_rss_bytes, pass_run.peak_rss_bytes);
+    aggregate.peak_rss_growth_bytes += pass_run.peak_rss_growth_bytes;
+  }
+
+  std::vector<PassMetrics> metrics;
+  metrics.reserve(order.size());
+  for (const auto& key : order) {
+    const Aggregate& aggregate = aggregates.at(key);
+    PassMetrics& pass_metrics = metrics.emplace_back();
+    pass_metrics.set_module_id(key.first);
+    pass_metrics.set_pass_name(key.second);
+    pass_metrics.mutable_pass_duration()->set_seconds(
+        aggregate.duration_micros / 1000000);
+    pass_metrics.mutable_pass_duration()->set_nanos(
+        (aggregate.duration_micros % 1000000) * 1000);
+    auto add_metric = [&](absl::string_view name, int64_t value) {
+      KeyValueMetric* metric = pass_metrics.add_kv_metrics();
+      metric->set_key(name);
+      metric->set_value(value);
+    };
+    add_metric("num_runs", aggregate.num_runs);
+    add_metric("num_computations", aggregate.max_num_computations);
+    add_metric("num_instructions", aggregate.max_num_instructions);
+    add_metric("peak_rss_bytes", aggregate.peak_rss_bytes);
+    add_metric("peak_rss_growth_bytes", aggregate.peak_rss_growth_bytes);
+  }
+  return metrics;
+}
+
 }  // namespace xla
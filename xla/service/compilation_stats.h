@@ -16,19 +16,23 @@ limitations under the License.
 #ifndef XLA_SERVICE_COMPILATION_STATS_H_
 #define XLA_SERVICE_COMPILATION_STATS_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
+#include "xla/service/metrics.pb.h"
 
 namespace xla {
 
 // This class is used to collect information about HLO passes and print some
 // statistics at the end of compilation. From HloPassPipeline, we call StartPass
-// before the execution of a pass, and EndPass after. Currently, we only collect
-// timing information and how many times each pass was run. In the future, we
-// can add more things, such as the size of the HLO graph after each pass.
+// before the execution of a pass, and EndPass after. We collect timing
+// information, how many times each pass was run, the size of the HLO module
+// each pass ran on and how much the peak resident memory of the process grew
+// while the pass was running.
 class CompilationStats {
  public:
   virtual ~CompilationStats() = default;
@@ -47,8 +51,24 @@ class CompilationStats {
 
   virtual void RecordPassError(absl::string_view pass_name,
                                absl::string_view err) = 0;
+
+  // Records the size of a module the running pass `pass_name` was run on. Must
+  // be called between StartPass and EndPass. Sizes recorded for several
+  // modules (e.g. of a module group) are added up.
+  virtual void RecordPassModuleSize(absl::string_view pass_name,
+                                    uint64_t module_id,
+                                    int64_t num_computations,
+                                    int64_t num_instructions) = 0;
+
+  // Returns metrics of all passes run so far, aggregated over the runs of each
+  // pass on the same module.
+  virtual std::vector<PassMetrics> GetPassMetrics() = 0;
 };
 
+// Returns the peak resident set size of the process in bytes, or 0 if it is
+// not available on this platform.
+int64_t GetPeakRssBytes();
+
 }  // namespace xla
 
 #endif  // XLA_SERVICE_COMPILATION_STATS_H_
@@ -0,0 +1,102 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/compilation_stats.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "xla/service/metrics.pb.h"
+
+namespace xla {
+namespace {
+
+// Returns the value of the key-value metric `key` of `metrics`, or -1.
+int64_t GetMetric(const PassMetrics& metrics, const std::string& key) {
+  for (const KeyValueMetric& metric : metrics.kv_metrics()) {
+    if (metric.key() == key) {
+      return metric.value();
+    }
+  }
+  return -1;
+}
+
+TEST(CompilationStatsTest, AggregatesPassMetricsPerModule) {
+  std::unique_ptr<CompilationStats> stats = CompilationStats::MakeStats();
+  for (int i = 0; i < 2; ++i) {
+    stats->StartPass("dce");
+    stats->RecordPassModuleSize("dce", /*module_id=*/1,
+                                /*num_computations=*/2,
+                                /*num_instructions=*/10 + i);
+    stats->EndPass("dce");
+  }
+  stats->StartPass("dce");
+  stats->RecordPassModuleSize("dce", /*module_id=*/2, /*num_computations=*/1,
+                              /*num_instructions=*/3);
+  stats->EndPass("dce");
+  stats->StartPass("cse");
+  stats->RecordPassModuleSize("cse", /*module_id=*/1, /*num_computations=*/2,
+                              /*num_instructions=*/11);
+  stats->EndPass("cse");
+  EXPECT_EQ(stats->GetPassesSize(), 4);
+
+  std::vector<PassMetrics> metrics = stats->GetPassMetrics();
+  ASSERT_EQ(metrics.size(), 3);
+
+  EXPECT_EQ(metrics[0].pass_name(), "dce");
+  EXPECT_EQ(metrics[0].module_id(), 1);
+  EXPECT_EQ(GetMetric(metrics[0], "num_runs"), 2);
+  EXPECT_EQ(GetMetric(metrics[0], "num_computations"), 2);
+  EXPECT_EQ(GetMetric(metrics[0], "num_instructions"), 11);
+  EXPECT_GE(GetMetric(metrics[0], "peak_rss_growth_bytes"), 0);
+
+  EXPECT_EQ(metrics[1].pass_name(), "dce");
+  EXPECT_EQ(metrics[1].module_id(), 2);
+  EXPECT_EQ(GetMetric(metrics[1], "num_runs"), 1);
+  EXPECT_EQ(GetMetric(metrics[1], "num_instructions"), 3);
+
+  EXPECT_EQ(metrics[2].pass_name(), "cse");
+  EXPECT_EQ(GetMetric(metrics[2], "num_runs"), 1);
+}
+
+TEST(CompilationStatsTest, AddsUpSizesOfModulesInOneRun) {
+  std::unique_ptr<CompilationStats> stats = CompilationStats::MakeStats();
+  stats->StartPass("dce");
+  stats->RecordPassModuleSize("dce", /*module_id=*/1, /*num_computations=*/2,
+                              /*num_instructions=*/10);
+  stats->RecordPassModuleSize("dce", /*module_id=*/1, /*num_computations=*/1,
+                              /*num_instructions=*/5);
+  stats->EndPass("dce");
+
+  std::vector<PassMetrics> metrics = stats->GetPassMetrics();
+  ASSERT_EQ(metrics.size(), 1);
+  EXPECT_EQ(GetMetric(metrics[0], "num_computations"), 3);
+  EXPECT_EQ(GetMetric(metrics[0], "num_instructions"), 15);
+}
+
+TEST(CompilationStatsTest, NoopStatsHasNoMetrics) {
+  std::unique_ptr<CompilationStats> stats = CompilationStats::MakeNoopStats();
+  stats->StartPass("dce");
+  stats->RecordPassModuleSize("dce", /*module_id=*/1, /*num_computations=*/1,
+                              /*num_instructions=*/1);
+  stats->EndPass("dce");
+  EXPECT_TRUE(stats->GetPassMetrics().empty());
+}
+
+}  // namespace
+}  // namespace xla
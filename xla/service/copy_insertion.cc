@@ -63,6 +63,7 @@ limitations under the License.
 #include "xla/status_macros.h"
 #include "xla/util.h"
 #include "tsl/platform/errors.h"
+#include "tsl/platform/numbers.h"
 #include "tsl/platform/status.h"
 #include "tsl/platform/statusor.h"
 
@@ -2405,6 +2406,37 @@ static int64_t GetNumExistingCopies(
   return num_existing_copies;
 }
 
+// Logs how many copies are left in the module and how many bytes they move.
+// Copies in while loop computations run once per iteration, so they are
+// reported separately as bytes moved per loop step.
+static void LogRemainingCopies(
+    const HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  int64_t num_copies = 0, num_loop_copies = 0;
+  int64_t bytes = 0, loop_bytes_per_step = 0;
+  for (HloComputation* computation : module->computations(execution_threads)) {
+    const bool in_loop =
+        !computation->caller_instructions(HloOpcode::kWhile).empty();
+    for (HloInstruction* instruction : computation->instructions()) {
+      if (instruction->opcode() != HloOpcode::kCopy) continue;
+      // Tuple copies are shallow and only move the tuple index table.
+      int64_t size = ShapeUtil::ByteSizeOf(instruction->shape(), sizeof(void*));
+      if (in_loop) {
+        ++num_loop_copies;
+        loop_bytes_per_step += size;
+      } else {
+        ++num_copies;
+        bytes += size;
+      }
+    }
+  }
+  VLOG(1) << "Remaining copies outside of while loops: " << num_copies << " ("
+          << tsl::strings::HumanReadableNumBytes(bytes) << ")";
+  VLOG(1) << "Remaining copies in while loops: " << num_loop_copies << " ("
+          << tsl::strings::HumanReadableNumBytes(loop_bytes_per_step)
+          << " per iteration)";
+}
+
 absl::Status CopyInsertion::RemoveUnnecessaryCopies(
     HloModule* module, bool check_live_range_ordering,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
@@ -2433,7 +2465,19 @@ absl::Status CopyInsertion::RemoveUnnecessaryCopies(
     }
   }
 
-  int64_t num_existing_copies = GetNumExistingCopies(module, execution_threads);
+  // Collect the copies once instead of rescanning every instruction of the
+  // module in each fixpoint iteration. Elided copies are dropped from the
+  // worklist, so later iterations only revisit the copies that are left.
+  std::vector<HloInstruction*> copies;
+  for (HloComputation* computation : module->computations(execution_threads)) {
+    for (HloInstruction* instruction : computation->instructions()) {
+      if (instruction->opcode() == HloOpcode::kCopy) {
+        copies.push_back(instruction);
+      }
+    }
+  }
+
+  int64_t num_existing_copies = copies.size();
   bool changed = true;
   int64_t num_iterations = -1;
   VLOG(6) << "Copy Insertion analyzing module with instruction count = "
@@ -2443,37 +2487,38 @@ absl::Status CopyInsertion::RemoveUnnecessaryCopies(
     CHECK_LE(++num_iterations, num_existing_copies);
     changed = false;
     VLOG(2) << "Running fixpoint iteration " << num_iterations
-            << " of copy elision";
-    for (HloComputation* computation :
-         module->computations(execution_threads)) {
-      VLOG(2) << "computation:" << computation->name();
-      for (HloInstruction* instruction : computation->instructions()) {
-        if (instruction->opcode() != HloOpcode::kCopy) continue;
-
-        // The region_analysis_cost_now is always set to
-        // use_region_based_live_range_analysis_ if it is < 0, in which case the
-        // analysis is always performed.
-        int64_t region_analysis_cost_now =
-            (use_region_based_live_range_analysis_ == 0)
-                ? 0
-                : std::min(allowance.analysis_allowance(),
-                           use_region_based_live_range_analysis_);
-        if (copy_remover.TryElideCopy(instruction, &region_analysis_cost_now)) {
-          changed = true;
-          TF_RETURN_IF_ERROR(StripControlDependenciesFrom(instruction));
-          TF_RETURN_IF_ERROR(
-              instruction->ReplaceAllUsesWith(instruction->mutable_operand(0)));
-          VLOG(6) << "succeeded in eliminating copy.";
-        }
-        if (allowance.ContinueAnalysis() && region_analysis_cost_now > 0) {
-          VLOG(6) << "Copy Insertion analyzing module cost: "
-                  << region_analysis_cost_now;
-          VLOG(6) << "instruction:" << instruction->ToString();
-          allowance.DeductCost(region_analysis_cost_now);
-          VLOG(6) << "allowance:" << allowance.analysis_allowance();
-        }
+            << " of copy elision over " << copies.size() << " copies";
+    for (HloInstruction*& instruction : copies) {
+      // The region_analysis_cost_now is always set to
+      // use_region_based_live_range_analysis_ if it is < 0, in which case the
+      // analysis is always performed.
+      int64_t region_analysis_cost_now =
+          (use_region_based_live_range_analysis_ == 0)
+              ? 0
+              : std::min(allowance.analysis_allowance(),
+                         use_region_based_live_range_analysis_);
+      bool elided = false;
+      if (copy_remover.TryElideCopy(instruction, &region_analysis_cost_now)) {
+        changed = true;
+        TF_RETURN_IF_ERROR(StripControlDependenciesFrom(instruction));
+        TF_RETURN_IF_ERROR(
+            instruction->ReplaceAllUsesWith(instruction->mutable_operand(0)));
+        VLOG(6) << "succeeded in eliminating copy.";
+        elided = true;
+      }
+      if (allowance.ContinueAnalysis() && region_analysis_cost_now > 0) {
+        VLOG(6) << "Copy Insertion analyzing module cost: "
+                << region_analysis_cost_now;
+        VLOG(6) << "instruction:" << instruction->ToString();
+        allowance.DeductCost(region_analysis_cost_now);
+        VLOG(6) << "allowance:" << allowance.analysis_allowance();
+      }
+      if (elided) {
+        instruction = nullptr;
       }
     }
+    copies.erase(std::remove(copies.begin(), copies.end(), nullptr),
+                 copies.end());
   }
   return absl::OkStatus();
 }
@@ -2543,6 +2588,9 @@ absl::StatusOr<bool> CopyInsertion::Run(
   VLOG(1) << "Num copies before copy-insertion: " << num_copies_before;
   VLOG(1) << "Num copies after copy-insertion: "
           << GetNumExistingCopies(module, execution_threads);
+  if (VLOG_IS_ON(1)) {
+    LogRemainingCopies(module, execution_threads);
+  }
 
   return true;
 }
@@ -0,0 +1,196 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/cpu/cpu_aot_image.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/base/config.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/file_system.h"
+#include "xla/util.h"
+
+namespace xla::cpu {
+
+#if !defined(ABSL_IS_LITTLE_ENDIAN)
+#error "CpuAotImage supports only little endian platforms"
+#endif
+
+namespace {
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t num_sections;
+  uint64_t size;
+};
+
+struct SectionHeader {
+  uint32_t kind;
+  uint32_t reserved;
+  int64_t id;
+  uint64_t offset;
+  uint64_t size;
+};
+
+static_assert(sizeof(Header) == 24);
+static_assert(sizeof(SectionHeader) == 32);
+
+}  // namespace
+
+void CpuAotImage::Builder::AddSection(SectionKind kind, int64_t id,
+                                      absl::Span<const uint8_t> data) {
+  sections_.push_back(PendingSection{
+      kind, id,
+      std::string(reinterpret_cast<const char*>(data.data()), data.size())});
+}
+
+void CpuAotImage::Builder::AddSection(SectionKind kind, int64_t id,
+                                      absl::string_view data) {
+  sections_.push_back(PendingSection{kind, id, std::string(data)});
+}
+
+std::string CpuAotImage::Builder::Build() const {
+  uint64_t offset = RoundUpTo<uint64_t>(
+      sizeof(Header) + sections_.size() * sizeof(SectionHeader),
+      kSectionAlignment);
+
+  std::vector<SectionHeader> headers;
+  headers.reserve(sections_.size());
+  for (const PendingSection& section : sections_) {
+    headers.push_back(SectionHeader{static_cast<uint32_t>(section.kind), 0,
+                                    section.id, offset, section.data.size()});
+    offset = RoundUpTo<uint64_t>(offset + section.data.size(),
+                                 kSectionAlignment);
+  }
+
+  Header header;
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.num_sections = sections_.size();
+  header.size = offset;
+
+  std::string image(offset, '\0');
+  std::memcpy(image.data(), &header, sizeof(Header));
+  std::memcpy(image.data() + sizeof(Header), headers.data(),
+              headers.size() * sizeof(SectionHeader));
+  for (size_t i = 0; i < sections_.size(); ++i) {
+    std::memcpy(image.data() + headers[i].offset, sections_[i].data.data(),
+                sections_[i].data.size());
+  }
+
+  return image;
+}
+
+absl::StatusOr<std::shared_ptr<const CpuAotImage>> CpuAotImage::FromBuffer(
+    absl::Span<const uint8_t> data, std::shared_ptr<const void> storage) {
+  if (reinterpret_cast<uintptr_t>(data.data()) % kSectionAlignment != 0) {
+    return InvalidArgument("CpuAotImage data must be aligned to %d bytes",
+                           kSectionAlignment);
+  }
+
+  if (data.size() < sizeof(Header)) {
+    return InvalidArgument("CpuAotImage is too small: %d bytes", data.size());
+  }
+
+  Header header;
+  std::memcpy(&header, data.data(), sizeof(Header));
+
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    return InvalidArgument("CpuAotImage has invalid magic");
+  }
+
+  if (header.version != kVersion) {
+    return InvalidArgument("Unsupported CpuAotImage version %d (expected %d)",
+                           header.version, kVersion);
+  }
+
+  if (header.size != data.size()) {
+    return InvalidArgument("CpuAotImage size mismatch: %d vs %d bytes",
+                           header.size, data.size());
+  }
+
+  uint64_t headers_size = header.num_sections * sizeof(SectionHeader);
+  if (headers_size > data.size() - sizeof(Header)) {
+    return InvalidArgument("CpuAotImage section table is out of bounds");
+  }
+
+  std::vector<Section> sections;
+  sections.reserve(header.num_sections);
+
+  for (size_t i = 0; i < header.num_sections; ++i) {
+    SectionHeader section;
+    std::memcpy(&section,
+                data.data() + sizeof(Header) + i * sizeof(SectionHeader),
+                sizeof(SectionHeader));
+
+    if (section.offset % kSectionAlignment != 0 ||
+        section.offset > data.size() ||
+        section.size > data.size() - section.offset) {
+      return InvalidArgument("CpuAotImage section #%d is out of bounds", i);
+    }
+
+    sections.push_back(Section{static_cast<SectionKind>(section.kind),
+                               section.id,
+                               data.subspan(section.offset, section.size)});
+  }
+
+  return std::shared_ptr<const CpuAotImage>(
+      new CpuAotImage(std::move(sections), std::move(storage)));
+}
+
+absl::StatusOr<std::shared_ptr<const CpuAotImage>> CpuAotImage::MapFile(
+    tsl::Env* env, const std::string& path) {
+  std::unique_ptr<tsl::ReadOnlyMemoryRegion> region;
+  TF_RETURN_IF_ERROR(env->NewReadOnlyMemoryRegionFromFile(path, &region));
+
+  absl::Span<const uint8_t> data(
+      reinterpret_cast<const uint8_t*>(region->data()), region->length());
+  return FromBuffer(data,
+                    std::shared_ptr<const tsl::ReadOnlyMemoryRegion>(
+                        std::move(region)));
+}
+
+std::vector<CpuAotImage::Section> CpuAotImage::sections(
+    SectionKind kind) const {
+  std::vector<Section> sections;
+  for (const Section& section : sections_) {
+    if (section.kind == kind) sections.push_back(section);
+  }
+  return sections;
+}
+
+absl::StatusOr<CpuAotImage::Section> CpuAotImage::section(
+    SectionKind kind) const {
+  std::vector<Section> found = sections(kind);
+  if (found.size() != 1) {
+    return InvalidArgument("Expected exactly one section of kind %d, got %d",
+                           static_cast<uint32_t>(kind), found.size());
+  }
+  return found.front();
+}
+
+}  // namespace xla::cpu
@@ -0,0 +1,120 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_CPU_CPU_AOT_IMAGE_H_
+#define XLA_SERVICE_CPU_CPU_AOT_IMAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/tsl/platform/env.h"
+
+namespace xla::cpu {
+
+// A flat image of the AOT compiled XLA:CPU executable that is designed to be
+// memory mapped from a file. Large parts of the compilation result (object
+// files and constants) are stored as raw aligned sections, and at load time
+// they are used directly from the mapped memory without parsing or copying.
+//
+// Image layout (all integers are little endian):
+//
+//   Header | SectionHeader[num_sections] | padding | section data ...
+//
+// The data of every section starts at an offset aligned to
+// `kSectionAlignment`, so that constants can be passed to the XLA:CPU
+// executable without copying (mapped memory is page aligned).
+class CpuAotImage {
+ public:
+  static constexpr char kMagic[8] = {'X', 'L', 'A', 'C', 'P', 'U', 'I', 'M'};
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kSectionAlignment = 64;
+
+  enum class SectionKind : uint32_t {
+    // Serialized CompilationResultProto without object files and without
+    // literals of the constants that are stored in the kConstant sections.
+    kCompilationResult = 1,
+
+    // Object file to be loaded by the ObjectLoader.
+    kObjFile = 2,
+
+    // Data of the constant allocation with index equal to section id.
+    kConstant = 3,
+  };
+
+  struct Section {
+    SectionKind kind;
+    int64_t id;
+    absl::Span<const uint8_t> data;
+  };
+
+  // Incrementally builds a serialized CpuAotImage.
+  class Builder {
+   public:
+    // Adds a section to the image. Data is copied into the builder.
+    void AddSection(SectionKind kind, int64_t id,
+                    absl::Span<const uint8_t> data);
+    void AddSection(SectionKind kind, int64_t id, absl::string_view data);
+
+    std::string Build() const;
+
+   private:
+    struct PendingSection {
+      SectionKind kind;
+      int64_t id;
+      std::string data;
+    };
+
+    std::vector<PendingSection> sections_;
+  };
+
+  // Creates an image from the `data` buffer. The `storage` keeps the buffer
+  // alive, and it's shared with all users of the image data (i.e. constant
+  // allocations that point directly into the image).
+  static absl::StatusOr<std::shared_ptr<const CpuAotImage>> FromBuffer(
+      absl::Span<const uint8_t> data, std::shared_ptr<const void> storage);
+
+  // Creates an image by memory mapping the file at `path`.
+  static absl::StatusOr<std::shared_ptr<const CpuAotImage>> MapFile(
+      tsl::Env* env, const std::string& path);
+
+  absl::Span<const Section> sections() const { return sections_; }
+
+  // Returns all sections of the given kind in the order they were added.
+  std::vector<Section> sections(SectionKind kind) const;
+
+  // Returns the only section of the given kind or an error.
+  absl::StatusOr<Section> section(SectionKind kind) const;
+
+  const std::shared_ptr<const void>& storage() const { return storage_; }
+
+ private:
+  CpuAotImage(std::vector<Section> sections,
+              std::shared_ptr<const void> storage)
+      : sections_(std::move(sections)), storage_(std::move(storage)) {}
+
+  std::vector<Section> sections_;
+  std::shared_ptr<const void> storage_;
+};
+
+}  // namespace xla::cpu
+
+#endif  // XLA_SERVICE_CPU_CPU_AOT_IMAGE_H_
@@ -0,0 +1,126 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/cpu/cpu_aot_image.h"
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+
+namespace xla::cpu {
+namespace {
+
+using SectionKind = CpuAotImage::SectionKind;
+
+static absl::string_view AsStringView(absl::Span<const uint8_t> data) {
+  return absl::string_view(reinterpret_cast<const char*>(data.data()),
+                           data.size());
+}
+
+// Copies serialized image into an aligned buffer.
+static absl::StatusOr<std::shared_ptr<const CpuAotImage>> FromString(
+    const std::string& image) {
+  std::shared_ptr<uint8_t[]> buffer(
+      new (std::align_val_t(CpuAotImage::kSectionAlignment))
+          uint8_t[image.size()],
+      [](uint8_t* ptr) {
+        ::operator delete[](ptr,
+                            std::align_val_t(CpuAotImage::kSectionAlignment));
+      });
+  std::memcpy(buffer.get(), image.data(), image.size());
+  return CpuAotImage::FromBuffer(
+      absl::MakeConstSpan(buffer.get(), image.size()), buffer);
+}
+
+TEST(CpuAotImageTest, BuildAndLoad) {
+  CpuAotImage::Builder builder;
+  builder.AddSection(SectionKind::kObjFile, 0, "obj0");
+  builder.AddSection(SectionKind::kObjFile, 0, "obj1");
+  builder.AddSection(SectionKind::kConstant, 3, "constant");
+  builder.AddSection(SectionKind::kCompilationResult, 0, "proto");
+
+  std::string serialized = builder.Build();
+  EXPECT_EQ(serialized.size() % CpuAotImage::kSectionAlignment, 0);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto image, FromString(serialized));
+  ASSERT_EQ(image->sections().size(), 4);
+
+  std::vector<CpuAotImage::Section> obj_files =
+      image->sections(SectionKind::kObjFile);
+  ASSERT_EQ(obj_files.size(), 2);
+  EXPECT_EQ(AsStringView(obj_files[0].data), "obj0");
+  EXPECT_EQ(AsStringView(obj_files[1].data), "obj1");
+
+  TF_ASSERT_OK_AND_ASSIGN(CpuAotImage::Section constant,
+                          image->section(SectionKind::kConstant));
+  EXPECT_EQ(constant.id, 3);
+  EXPECT_EQ(AsStringView(constant.data), "constant");
+
+  // All sections must be aligned, so we can use constants in place.
+  for (const CpuAotImage::Section& section : image->sections()) {
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(section.data.data()) %
+                  CpuAotImage::kSectionAlignment,
+              0);
+  }
+}
+
+TEST(CpuAotImageTest, MapFile) {
+  CpuAotImage::Builder builder;
+  builder.AddSection(SectionKind::kCompilationResult, 0, "proto");
+
+  tsl::Env* env = tsl::Env::Default();
+  std::string path;
+  ASSERT_TRUE(env->LocalTempFilename(&path));
+  TF_ASSERT_OK(tsl::WriteStringToFile(env, path, builder.Build()));
+
+  TF_ASSERT_OK_AND_ASSIGN(auto image, CpuAotImage::MapFile(env, path));
+  TF_ASSERT_OK_AND_ASSIGN(CpuAotImage::Section section,
+                          image->section(SectionKind::kCompilationResult));
+  EXPECT_EQ(AsStringView(section.data), "proto");
+
+  TF_ASSERT_OK(env->DeleteFile(path));
+}
+
+TEST(CpuAotImageTest, InvalidImage) {
+  CpuAotImage::Builder builder;
+  builder.AddSection(SectionKind::kObjFile, 0, "obj");
+  std::string serialized = builder.Build();
+
+  std::string bad_magic = serialized;
+  bad_magic[0] = 'Y';
+  EXPECT_EQ(FromString(bad_magic).status().code(),
+            absl::StatusCode::kInvalidArgument);
+
+  std::string truncated = serialized.substr(0, serialized.size() - 1);
+  EXPECT_EQ(FromString(truncated).status().code(),
+            absl::StatusCode::kInvalidArgument);
+
+  TF_ASSERT_OK_AND_ASSIGN(auto image, FromString(serialized));
+  EXPECT_FALSE(image->section(SectionKind::kConstant).ok());
+}
+
+}  // namespace
+}  // namespace xla::cpu
@@ -40,10 +40,12 @@ limitations under the License.
 #include "absl/memory/memory.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
@@ -87,9 +89,11 @@ limitations under the License.
 #include "xla/backends/cpu/codegen/execution_engine.h"
 #include "xla/backends/cpu/codegen/ir_compiler.h"
 #include "xla/backends/cpu/codegen/jit_compiler.h"
+#include "xla/backends/cpu/codegen/object_cache.h"
 #include "xla/backends/cpu/codegen/object_loader.h"
 #include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/backends/cpu/constant_allocation.h"
+#include "xla/backends/cpu/runtime/dot_lib.h"
 #include "xla/backends/cpu/runtime/function_library.h"
 #include "xla/backends/cpu/runtime/thunk.h"
 #include "xla/backends/cpu/runtime/thunk.pb.h"
@@ -129,6 +133,7 @@ limitations under the License.
 #include "xla/hlo/transforms/simplifiers/batch_dot_simplification.h"
 #include "xla/hlo/transforms/simplifiers/broadcast_canonicalizer.h"
 #include "xla/hlo/transforms/simplifiers/conditional_canonicalizer.h"
+#include "xla/hlo/transforms/simplifiers/convert_operand_folder.h"
 #include "xla/hlo/transforms/simplifiers/convolution_group_converter.h"
 #include "xla/hlo/transforms/simplifiers/dynamic_dimension_simplifier.h"
 #include "xla/hlo/transforms/simplifiers/flatten_call_graph.h"
@@ -165,6 +170,7 @@ limitations under the License.
 #include "xla/service/cpu/buffer_info_util.h"
 #include "xla/service/cpu/conv_canonicalization.h"
 #include "xla/service/cpu/cpu_aot_compilation_result.h"
+#include "xla/service/cpu/cpu_aot_image.h"
 #include "xla/service/cpu/cpu_executable.h"
 #include "xla/service/cpu/cpu_instruction_fusion.h"
 #include "xla/service/cpu/cpu_layout_assignment.h"
@@ -277,6 +283,33 @@ static cpu::JitCompiler::TaskRunner GetCompilationTaskRunner() {
   };
 }
 
+// Returns a per-process object cache for the directory configured in debug
+// options, or nullptr if the object cache is disabled.
+static std::shared_ptr<cpu::ObjectCache> GetObjectCache(
+    const DebugOptions& debug_options) {
+  const std::string& directory = debug_options.xla_cpu_object_cache_dir();
+  if (directory.empty()) return nullptr;
+
+  static absl::Mutex mu(absl::kConstInit);
+  static auto* caches =
+      new absl::flat_hash_map<std::string, std::shared_ptr<cpu::ObjectCache>>();
+
+  absl::MutexLock lock(&mu);
+  if (auto it = caches->find(directory); it != caches->end()) {
+    return it->second;
+  }
+
+  absl::StatusOr<std::unique_ptr<cpu::FileObjectCache>> cache =
+      cpu::FileObjectCache::Create(tsl::Env::Default(), directory);
+  if (!cache.ok()) {
+    LOG(WARNING) << "Failed to create XLA:CPU object cache in " << directory
+                 << ": " << cache.status();
+    return nullptr;
+  }
+
+  return (*caches)[directory] = *std::move(cache);
+}
+
 // For each computation in the module, determines whether that computation
 // calls a custom-call function, either directly or indirectly (e.g. because it
 // calls another computation that does).
@@ -498,6 +531,122 @@ std::unique_ptr<HloPassFix<HloPassPipeline>> CreateSimplificationPipeline(
   return pipeline;
 }
 
+// Returns true if `instr` is a dot that XLA:CPU executes as a weight-only
+// quantized matmul without upcasting weights to F32.
+bool IsWeightOnlyQuantizedDot(const HloInstruction* instr) {
+  return instr->opcode() == HloOpcode::kDot &&
+         cpu::IsWeightOnlyQuantizedDot(
+             instr->dot_dimension_numbers(), instr->operand(0)->shape(),
+             instr->operand(1)->shape(), instr->shape());
+}
+
+// Returns true if `instr` becomes a weight-only quantized dot after folding
+// converts of its operands, e.g. `f32 dot(f32 x, f32 convert(s8 w))`.
+bool IsFoldableIntoWeightOnlyQuantizedDot(const HloInstruction* instr) {
+  if (instr->opcode() != HloOpcode::kDot) return false;
+
+  auto folded_shape = [](const HloInstruction* operand) {
+    if (operand->opcode() != HloOpcode::kConvert) return operand->shape();
+    return ShapeUtil::ChangeElementType(
+        operand->shape(), operand->operand(0)->shape().element_type());
+  };
+
+  return cpu::IsWeightOnlyQuantizedDot(
+      instr->dot_dimension_numbers(), folded_shape(instr->operand(0)),
+      folded_shape(instr->operand(1)), instr->shape());
+}
+
+// Returns true if `instr` is a BF16 dot that XLA:CPU executes with AMX tile
+// instructions.
+bool IsAmxEligibleDot(const HloInstruction* instr) {
+  return instr->opcode() == HloOpcode::kDot &&
+         cpu::IsAmxEligibleDot(instr->dot_dimension_numbers(),
+                               instr->operand(0)->shape(),
+                               instr->operand(1)->shape(), instr->shape());
+}
+
+// Returns true if `instr` only moves BF16 elements around without doing any
+// arithmetic on them.
+bool IsBf16DataMovement(const HloInstruction& instr) {
+  switch (instr.opcode()) {
+    case HloOpcode::kBitcast:
+    case HloOpcode::kBroadcast:
+    case HloOpcode::kConcatenate:
+    case HloOpcode::kCopy:
+    case HloOpcode::kDynamicSlice:
+    case HloOpcode::kDynamicUpdateSlice:
+    case HloOpcode::kGather:
+    case HloOpcode::kPad:
+    case HloOpcode::kReshape:
+    case HloOpcode::kReverse:
+    case HloOpcode::kSelect:
+    case HloOpcode::kSlice:
+    case HloOpcode::kTranspose:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns true if `instr` is an elementwise op that XLA:CPU can compute in
+// BF16. LLVM computes each of them in F32 registers and rounds the result to
+// BF16, which is cheap with AVX512-BF16 conversion instructions.
+bool IsBf16Elementwise(const HloInstruction& instr) {
+  switch (instr.opcode()) {
+    case HloOpcode::kAbs:
+    case HloOpcode::kAdd:
+    case HloOpcode::kCompare:
+    case HloOpcode::kMaximum:
+    case HloOpcode::kMinimum:
+    case HloOpcode::kMultiply:
+    case HloOpcode::kNegate:
+    case HloOpcode::kSubtract:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Float support that keeps AMX eligible dots (if `amx_dot` is true), and data
+// movement and simple elementwise ops (if `native_bf16` is true) in BF16, and
+// upcasts all other BF16 operations to F32. Reductions are always upcasted, so
+// they keep accumulating in F32.
+class CpuBf16FloatSupport : public FloatSupport {
+ public:
+  CpuBf16FloatSupport(bool amx_dot, bool native_bf16,
+                      bool native_bf16_elementwise)
+      : FloatSupport(BF16),
+        amx_dot_(amx_dot),
+        native_bf16_(native_bf16),
+        native_bf16_elementwise_(native_bf16_elementwise) {}
+
+  bool SupportsLowPrecisionOperand(const HloInstruction& hlo,
+                                   int64_t operand_index) const override {
+    return FloatSupport::SupportsLowPrecisionOperand(hlo, operand_index) ||
+           IsSupported(hlo);
+  }
+
+  bool SupportsLowPrecisionOutput(const HloInstruction& hlo) const override {
+    return FloatSupport::SupportsLowPrecisionOutput(hlo) || IsSupported(hlo);
+  }
+
+  bool SupportsMixedPrecisions(const HloInstruction& hlo) const override {
+    return FloatSupport::SupportsMixedPrecisions(hlo) ||
+           (amx_dot_ && IsAmxEligibleDot(&hlo));
+  }
+
+ private:
+  bool IsSupported(const HloInstruction& hlo) const {
+    return (amx_dot_ && IsAmxEligibleDot(&hlo)) ||
+           (native_bf16_ && IsBf16DataMovement(hlo)) ||
+           (native_bf16_elementwise_ && IsBf16Elementwise(hlo));
+  }
+
+  bool amx_dot_;
+  bool native_bf16_;
+  bool native_bf16_elementwise_;
+};
+
 }  // namespace
 
 absl::Status CpuCompiler::RunHloPassesThroughLayoutAssn(
@@ -555,7 +704,34 @@ absl::Status CpuCompiler::RunHloPassesThroughLayoutAssn(
   AddHloVerifier(&pipeline);
   pipeline.AddPass<BatchedGatherScatterNormalizer>();
   pipeline.AddPass<ResultCaster>();
-  pipeline.AddPass<OperandUpcaster>();
+
+  const DebugOptions& debug_options = module->config().debug_options();
+
+  // Keep S8 and S4 weights of F32 dots in the original type, as we have a
+  // dedicated runtime kernel for weight-only quantized matmuls.
+  bool weight_only_quantized_dot =
+      debug_options.xla_cpu_experimental_weight_only_quantized_dot();
+  if (weight_only_quantized_dot) {
+    pipeline.AddPass<ConvertOperandFolding>(
+        IsFoldableIntoWeightOnlyQuantizedDot);
+  }
+
+  // Keep large BF16 dots in BF16 if the target CPU supports AMX BF16, as we
+  // have a dedicated runtime kernel for AMX matmuls.
+  bool amx_dot = is_thunk_runtime &&
+                 debug_options.xla_cpu_experimental_amx_dot() &&
+                 absl::StrContains(
+                     target_machine_features->get_target_feature_string(),
+                     "+amx-bf16");
+
+  if (weight_only_quantized_dot || amx_dot) {
+    pipeline.AddPass<OperandUpcaster>([=](const HloInstruction* instr) {
+      return !(weight_only_quantized_dot && IsWeightOnlyQuantizedDot(instr)) &&
+             !(amx_dot && IsAmxEligibleDot(instr));
+    });
+  } else {
+    pipeline.AddPass<OperandUpcaster>();
+  }
 
   // Expand random number generation.
   pipeline.AddPass<RngExpander>();
@@ -609,16 +785,30 @@ absl::Status CpuCompiler::RunHloPassesThroughLayoutAssn(
   // Convert BF16 and F8 operations to F32 and F16 respectively so that the CPU
   // backend can support BF16/F8 operations without directly implementing a
   // BF16/F8 lowering for most ops.
+  //
+  // With native BF16 enabled we keep data movement ops in BF16 on all CPUs,
+  // and simple elementwise ops on CPUs with fast BF16 conversions.
+  bool native_bf16 =
+      is_thunk_runtime && debug_options.xla_cpu_experimental_native_bf16();
+  bool native_bf16_elementwise =
+      native_bf16 &&
+      absl::StrContains(target_machine_features->get_target_feature_string(),
+                        "+avx512bf16");
+
   FloatSupport bf16_support(BF16);
+  CpuBf16FloatSupport cpu_bf16_support(amx_dot, native_bf16,
+                                       native_bf16_elementwise);
+  FloatSupport* thunks_bf16_support =
+      amx_dot || native_bf16 ? &cpu_bf16_support : &bf16_support;
 #if defined(INTEL_MKL)
   CpuFloatSupport onednn_bf16_support(BF16);
   if (!is_aot_compile && !is_thunk_runtime) {
     pipeline.AddPass<FloatNormalization>(&onednn_bf16_support);
   } else {
-    pipeline.AddPass<FloatNormalization>(&bf16_support);
+    pipeline.AddPass<FloatNormalization>(thunks_bf16_support);
   }
 #else
-  pipeline.AddPass<FloatNormalization>(&bf16_support);
+  pipeline.AddPass<FloatNormalization>(thunks_bf16_support);
 #endif
   FloatSupport f8e5m2_support(F8E5M2, F16);
   pipeline.AddPass<FloatNormalization>(&f8e5m2_support);
@@ -1359,6 +1549,7 @@ CpuCompiler::CompileCpuExecutable(std::unique_ptr<HloModule> module) {
       /*slp_vectorizer_disabled=*/options::SlpVectorizerDisabled(config),
       /*disable_loop_unrolling=*/options::DisableLoopUnrolling(config),
   };
+  ir_compiler_options.object_cache = GetObjectCache(debug_options);
 
   // Compiler hooks to intercept compiled LLVM IR modules.
   IrCompiler::CompilationHooks ir_compiler_hooks{
@@ -2425,6 +2616,31 @@ class CpuExecutableAotCompilationResult : public AotCompilationResult {
         new CpuExecutableAotCompilationResult(proto, std::move(module)));
   }
 
+  // Serializes compilation result as a flat CpuAotImage, that can be memory
+  // mapped and loaded without copying object files and constants.
+  absl::StatusOr<std::string> SerializeAsImage() const;
+
+  static absl::StatusOr<std::unique_ptr<CpuExecutableAotCompilationResult>>
+  FromImage(std::shared_ptr<const CpuAotImage> image) {
+    TF_ASSIGN_OR_RETURN(
+        CpuAotImage::Section section,
+        image->section(CpuAotImage::SectionKind::kCompilationResult));
+
+    CompilationResultProto proto;
+    if (!proto.ParseFromArray(section.data.data(), section.data.size())) {
+      return Internal("Failed to parse CpuAotImage compilation result.");
+    }
+
+    TF_ASSIGN_OR_RETURN(
+        std::unique_ptr<HloModule> module,
+        HloModule::CreateFromProtoWithConfig(proto.hlo_module()));
+
+    auto result = std::unique_ptr<CpuExecutableAotCompilationResult>(
+        new CpuExecutableAotCompilationResult(proto, std::move(module)));
+    result->image_ = std::move(image);
+    return result;
+  }
+
   absl::StatusOr<std::unique_ptr<Executable>> LoadExecutable(
       Compiler* compiler,
       const se::StreamExecutor* stream_exec) const&& override;
@@ -2471,10 +2687,92 @@ class CpuExecutableAotCompilationResult : public AotCompilationResult {
 
   CompilationResultProto proto_;
   std::unique_ptr<HloModule> module_;
+
+  // If compilation result was loaded from the image, object files and
+  // constants are stored in the image sections.
+  std::shared_ptr<const CpuAotImage> image_;
 };
 
 }  // namespace
 
+absl::StatusOr<std::string>
+CpuExecutableAotCompilationResult::SerializeAsImage() const {
+  CpuAotImage::Builder builder;
+
+  // Object files are stored as separate sections.
+  for (const std::string& obj_file : proto_.obj_files()) {
+    builder.AddSection(CpuAotImage::SectionKind::kObjFile, /*id=*/0, obj_file);
+  }
+
+  CompilationResultProto proto = proto_;
+  proto.clear_obj_files();
+
+  // Constants are supported only for thunks-based executables, as the
+  // classic executables embed constants into the object file.
+  if (proto_.obj_files_kind() == CompilationResultProto::KERNELS) {
+    TF_ASSIGN_OR_RETURN(
+        std::unique_ptr<HloModule> module,
+        HloModule::CreateFromProtoWithConfig(proto_.hlo_module()));
+
+    TF_ASSIGN_OR_RETURN(
+        std::unique_ptr<BufferAssignment> buffer_assignment,
+        BufferAssignment::FromProto(
+            proto_.buffer_assignment(), module.get(),
+            [](const BufferValue& buffer) {
+              return CpuExecutable::ShapeSizeBytes(buffer.shape());
+            },
+            /*can_share_buffer=*/nullptr));
+
+    TF_ASSIGN_OR_RETURN(std::vector<ConstantAllocation> constants,
+                        CreateConstantAllocations(*buffer_assignment));
+
+    for (const ConstantAllocation& constant : constants) {
+      se::DeviceMemoryBase data = constant.AsDeviceMemoryBase();
+      builder.AddSection(
+          CpuAotImage::SectionKind::kConstant, constant.index,
+          absl::MakeConstSpan(reinterpret_cast<const uint8_t*>(data.opaque()),
+                              data.size()));
+    }
+
+    // Find instructions that define values of constant allocations, and strip
+    // their literals from the HLO module, as we'll load them from the image.
+    absl::flat_hash_map<int64_t, int64_t> logical_buffer_instruction;
+    for (const auto& logical_buffer :
+         proto_.buffer_assignment().logical_buffers()) {
+      logical_buffer_instruction[logical_buffer.id()] =
+          logical_buffer.defined_at().instruction_id();
+    }
+
+    absl::flat_hash_set<int64_t> constant_instructions;
+    for (const auto& allocation :
+         proto_.buffer_assignment().buffer_allocations()) {
+      if (!allocation.is_constant()) continue;
+      for (const auto& assigned : allocation.assigned()) {
+        auto it =
+            logical_buffer_instruction.find(assigned.logical_buffer_id());
+        if (it != logical_buffer_instruction.end()) {
+          constant_instructions.insert(it->second);
+        }
+      }
+    }
+
+    HloModuleProto* hlo_module =
+        proto.mutable_hlo_module()->mutable_hlo_module();
+    for (auto& computation : *hlo_module->mutable_computations()) {
+      for (auto& instruction : *computation.mutable_instructions()) {
+        if (instruction.opcode() == HloOpcodeString(HloOpcode::kConstant) &&
+            constant_instructions.contains(instruction.id())) {
+          instruction.clear_literal();
+        }
+      }
+    }
+  }
+
+  builder.AddSection(CpuAotImage::SectionKind::kCompilationResult, /*id=*/0,
+                     proto.SerializeAsString());
+  return builder.Build();
+}
+
 absl::StatusOr<std::unique_ptr<Executable>>
 CpuExecutableAotCompilationResult::LoadExecutable(
     Compiler* compiler, const se::StreamExecutor* stream_exec) const&& {
@@ -2522,12 +2820,26 @@ CpuExecutableAotCompilationResult::LoadExecutable(
 
   // We might have an XLA:CPU executable that has only runtime thunks and
   // doesn't have any corresponding object files, and it's absolutely fine.
-  VLOG(2) << "Load XLA:CPU executable from " << proto_.obj_files_size()
-          << " object files; entry_function_name="
+  VLOG(2) << "Load XLA:CPU executable from "
+          << (image_ ? "memory mapped image" : "compilation result proto")
+          << "; entry_function_name="
           << proto_.entry_function_name();
 
+  // Object files are either stored in the compilation result proto, or in the
+  // image sections (in this case they are not copied out of the image).
+  std::vector<absl::string_view> obj_files;
+  if (image_) {
+    for (const CpuAotImage::Section& section :
+         image_->sections(CpuAotImage::SectionKind::kObjFile)) {
+      obj_files.emplace_back(reinterpret_cast<const char*>(section.data.data()),
+                             section.data.size());
+    }
+  } else {
+    obj_files.assign(proto_.obj_files().begin(), proto_.obj_files().end());
+  }
+
   size_t obj_file_index = 0;
-  for (auto& obj_file : proto_.obj_files()) {
+  for (absl::string_view obj_file : obj_files) {
     llvm::StringRef data(obj_file.data(), obj_file.size());
     TF_RETURN_IF_ERROR(
         object_loader.AddObjFile(llvm::MemoryBuffer::getMemBuffer(
@@ -2571,9 +2883,23 @@ CpuExecutableAotCompilationResult::LoadExecutable(
     TF_ASSIGN_OR_RETURN(std::unique_ptr<FunctionLibrary> function_library,
                         std::move(object_loader).Load(compiled_symbols));
 
-    // Create constant allocations from the buffer assignment.
-    TF_ASSIGN_OR_RETURN(std::vector<ConstantAllocation> constants,
-                        CreateConstantAllocations(*buffer_assignment));
+    // Create constant allocations from the buffer assignment, or point them
+    // directly into the image memory.
+    std::vector<ConstantAllocation> constants;
+    if (image_) {
+      absl::flat_hash_map<BufferAllocation::Index, absl::Span<const uint8_t>>
+          data;
+      for (const CpuAotImage::Section& section :
+           image_->sections(CpuAotImage::SectionKind::kConstant)) {
+        data[section.id] = section.data;
+      }
+      TF_ASSIGN_OR_RETURN(constants,
+                          CreateConstantAllocations(*buffer_assignment, data,
+                                                    image_->storage()));
+    } else {
+      TF_ASSIGN_OR_RETURN(constants,
+                          CreateConstantAllocations(*buffer_assignment));
+    }
 
     TF_ASSIGN_OR_RETURN(
         cpu_executable,
@@ -2644,6 +2970,21 @@ CpuCompiler::LoadAotCompilationResult(
   return CpuExecutableAotCompilationResult::FromString(serialized_aot_result);
 }
 
+absl::StatusOr<std::string> CpuCompiler::ExportAsImage(
+    Executable* executable) const {
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<AotCompilationResult> result,
+                      Export(executable));
+  return tensorflow::down_cast<CpuExecutableAotCompilationResult*>(
+             result.get())
+      ->SerializeAsImage();
+}
+
+absl::StatusOr<std::unique_ptr<AotCompilationResult>>
+CpuCompiler::LoadAotCompilationResultFromImage(
+    std::shared_ptr<const CpuAotImage> image) {
+  return CpuExecutableAotCompilationResult::FromImage(std::move(image));
+}
+
 absl::StatusOr<HloSchedule> CpuCompiler::CreateHloSchedule(
     const HloModule& hlo_module) const {
   // Select a memory scheduler optimized for concurrency vs minimal memory.
@@ -33,6 +33,7 @@ limitations under the License.
 #include "xla/service/buffer_assignment.h"
 #include "xla/service/compiler.h"
 #include "xla/service/cpu/cpu_aot_compilation_result.h"
+#include "xla/service/cpu/cpu_aot_image.h"
 #include "xla/service/cpu/executable.pb.h"
 #include "xla/service/executable.h"
 #include "xla/service/hlo.pb.h"
@@ -89,6 +90,14 @@ class CpuCompiler : public LLVMCompiler {
   absl::StatusOr<std::unique_ptr<AotCompilationResult>>
   LoadAotCompilationResult(const std::string& serialized_aot_result) override;
 
+  // Exports the executable as a flat CpuAotImage (see cpu_aot_image.h) that
+  // can be memory mapped and loaded with `LoadAotCompilationResultFromImage`
+  // without parsing and copying object files and constants.
+  absl::StatusOr<std::string> ExportAsImage(Executable* executable) const;
+
+  absl::StatusOr<std::unique_ptr<AotCompilationResult>>
+  LoadAotCompilationResultFromImage(std::shared_ptr<const CpuAotImage> image);
+
   absl::StatusOr<HloSchedule> CreateHloSchedule(
       const HloModule& hlo_module) const;
 
@@ -20,6 +20,7 @@ limitations under the License.
 #include <stdint.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <memory>
 #include <optional>
@@ -66,8 +67,10 @@ limitations under the License.
 #include "xla/stream_executor/device_memory.h"
 #include "xla/stream_executor/device_memory_allocator.h"
 #include "xla/stream_executor/host/host_stream.h"
+#include "xla/stream_executor/host/huge_pages.h"
 #include "xla/tsl/concurrency/async_value_ref.h"
 #include "xla/util.h"
+#include "xla/xla.pb.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/logging.h"
@@ -120,8 +123,21 @@ absl::StatusOr<std::unique_ptr<CpuExecutable>> CpuExecutable::Create(
       std::move(hlo_profile_index_map), std::move(assignment)));
   executable->function_library_ = std::move(function_library);
 
-  TF_ASSIGN_OR_RETURN(executable->thunks_,
-                      ThunkExecutor::Create(std::move(thunks)));
+  ThunkExecutor::Options thunk_executor_options;
+  if (executable->has_module()) {
+    const DebugOptions& debug_options =
+        executable->module().config().debug_options();
+    if (debug_options.xla_cpu_experimental_work_stealing_ready_queue()) {
+      thunk_executor_options.ready_queue_type =
+          ThunkExecutor::Options::ReadyQueueType::kWorkStealing;
+    }
+    thunk_executor_options.use_execute_state_pool =
+        debug_options.xla_cpu_experimental_execute_state_pool();
+  }
+
+  TF_ASSIGN_OR_RETURN(
+      executable->thunks_,
+      ThunkExecutor::Create(std::move(thunks), thunk_executor_options));
 
   // Re-index constants by their allocation index to allow efficient lookup.
   for (auto& constant : constants) {
@@ -158,7 +174,8 @@ static absl::StatusOr<MaybeOwningDeviceMemory> MemoryForAllocation(
     const BufferAllocation& allocation,
     absl::Span<const ExecutionInput> arguments,
     absl::Span<const ConstantAllocation> constants,
-    se::DeviceMemoryAllocator* memory_allocator, int device_ordinal) {
+    se::DeviceMemoryAllocator* memory_allocator, int device_ordinal,
+    bool use_huge_pages_for_temp_buffers) {
   VLOG(3) << allocation.ToString();
   if (allocation.is_entry_computation_parameter()) {
     se::DeviceMemoryBase out = arguments[allocation.parameter_number()]
@@ -187,6 +204,15 @@ static absl::StatusOr<MaybeOwningDeviceMemory> MemoryForAllocation(
   VLOG(3) << "buffer allocated " << buffer_size << " bytes [" << out->opaque()
           << "]";
 
+  // The memory comes from the client's allocator, so we can only advise huge
+  // pages for the part of it that is aligned to the huge page size.
+  if (use_huge_pages_for_temp_buffers &&
+      allocation.IsPreallocatedTempBuffer()) {
+    size_t advised_bytes =
+        se::host::AdviseHugePages(out->opaque(), buffer_size);
+    VLOG(3) << "advised huge pages for " << advised_bytes << " bytes";
+  }
+
   // Since the output buffer and all the temporary buffers were written into
   // by the JITed code, memory sanitizer has no way of knowing their memory was
   // initialized. Mark them initialized so that memory sanitizer doesn't flag
@@ -201,6 +227,12 @@ CpuExecutable::CreateBufferTable(se::DeviceMemoryAllocator* memory_allocator,
                                  absl::Span<ExecutionInput const> arguments) {
   std::vector<MaybeOwningDeviceMemory> buffers(
       assignment_->Allocations().size());
+  bool use_huge_pages_for_temp_buffers = false;
+  if (has_module()) {
+    const DebugOptions& debug_options = module().config().debug_options();
+    use_huge_pages_for_temp_buffers =
+        debug_options.xla_cpu_use_huge_pages_for_temp_buffers();
+  }
   VLOG(3) << "Allocating " << assignment_->Allocations().size()
           << " allocations for module " << module().name();
   for (BufferAllocation::Index i = 0; i < assignment_->Allocations().size();
@@ -208,7 +240,8 @@ CpuExecutable::CreateBufferTable(se::DeviceMemoryAllocator* memory_allocator,
     const BufferAllocation& allocation = assignment_->GetAllocation(i);
     TF_ASSIGN_OR_RETURN(buffers[i],
                         MemoryForAllocation(allocation, arguments, constants_,
-                                            memory_allocator, device_ordinal));
+                                            memory_allocator, device_ordinal,
+                                            use_huge_pages_for_temp_buffers));
   }
 
   if (VLOG_IS_ON(3)) {
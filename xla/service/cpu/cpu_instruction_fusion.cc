@@ -19,6 +19,7 @@ limitations under the License.
 
 #include "absl/algorithm/container.h"
 #include "absl/log/log.h"
+#include "xla/backends/cpu/runtime/dot_lib.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instructions.h"
@@ -58,6 +59,23 @@ bool IsNonComplexNonBatchedMatrixVectorDot(const HloInstruction* hlo) {
          hlo->dot_dimension_numbers().lhs_batch_dimensions_size() == 0;
 }
 
+// Weight-only quantized dots are implemented by the runtime kernel and can't be
+// emitted as a part of a loop fusion.
+bool IsWeightOnlyQuantizedDot(const HloInstruction* hlo) {
+  return hlo->opcode() == HloOpcode::kDot &&
+         cpu::IsWeightOnlyQuantizedDot(hlo->dot_dimension_numbers(),
+                                       hlo->operand(0)->shape(),
+                                       hlo->operand(1)->shape(), hlo->shape());
+}
+
+// AMX dots are implemented by the runtime kernel too.
+bool IsAmxEligibleDot(const HloInstruction* hlo) {
+  return hlo->opcode() == HloOpcode::kDot &&
+         cpu::IsAmxEligibleDot(hlo->dot_dimension_numbers(),
+                               hlo->operand(0)->shape(),
+                               hlo->operand(1)->shape(), hlo->shape());
+}
+
 bool HasExactlyOneUse(const HloInstruction& hlo_instr) {
   return hlo_instr.user_count() == 1 &&
          absl::c_count(hlo_instr.users().front()->operands(), &hlo_instr) == 1;
@@ -141,6 +159,15 @@ FusionDecision CpuInstructionFusion::ShouldFuse(HloInstruction* consumer,
     return FusionDecision::Forbid("Don't fuse large constants.");
   }
 
+  if (IsWeightOnlyQuantizedDot(producer) ||
+      IsWeightOnlyQuantizedDot(consumer)) {
+    return FusionDecision::Forbid("Don't fuse weight-only quantized dots.");
+  }
+
+  if (IsAmxEligibleDot(producer) || IsAmxEligibleDot(consumer)) {
+    return FusionDecision::Forbid("Don't fuse AMX dots.");
+  }
+
   if (CanBeOutputFused(producer, consumer)) {
     VLOG(2) << "Fusion OK: Can create output fusion.";
     return FusionDecision::Allow();
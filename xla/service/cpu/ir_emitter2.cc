@@ -57,6 +57,7 @@ limitations under the License.
 #include "mlir/IR/MLIRContext.h"
 #include "xla/backends/cpu/codegen/emitters/cpu_fusion_emitter.h"
 #include "xla/backends/cpu/codegen/emitters/cpu_fusion_emitter_config.h"
+#include "xla/backends/cpu/codegen/emitters/cpu_reduction_emitter.h"
 #include "xla/backends/cpu/codegen/emitters/cpu_scatter_emitter.h"
 #include "xla/backends/cpu/codegen/kernel_api_ir_builder.h"
 #include "xla/backends/cpu/codegen/symbol_name_util.h"
@@ -99,6 +100,7 @@ namespace {
 // fusion emitter.
 enum class FusionEmitterKind {
   kLoop,
+  kReduction,
   kScatter,
 };
 
@@ -110,6 +112,10 @@ FusionEmitterKind AnalyzeHloFusion(const HloFusionInstruction* fusion) {
   if (fusion->fused_expression_root()->opcode() == HloOpcode::kScatter) {
     return FusionEmitterKind::kScatter;
   }
+  if (fusion->fused_expression_root()->opcode() == HloOpcode::kReduce &&
+      CpuReductionFusion::IsSupported(*fusion)) {
+    return FusionEmitterKind::kReduction;
+  }
   return FusionEmitterKind::kLoop;
 }
 
@@ -148,6 +154,10 @@ bool IrEmitter2::IsSupportedByFusionEmitter(
   switch (fusion_emitter_kind) {
     case FusionEmitterKind::kScatter:
       return kFusionEmitterScatterEnabled;
+    case FusionEmitterKind::kReduction:
+      return hlo_module_.config()
+          .debug_options()
+          .xla_cpu_experimental_reduction_fusion_emitter();
     default:
       return false;
   }
@@ -214,6 +224,11 @@ absl::StatusOr<IrEmitter2::KernelInfo> IrEmitter2::EmitFusionWithFusionEmitters(
           &mlir_context, &module_->getContext(),
           nested_ir_emitter_->assignment(), fusion);
       break;
+    case FusionEmitterKind::kReduction:
+      emitter = std::make_unique<CpuReductionFusion>(
+          &mlir_context, &module_->getContext(),
+          nested_ir_emitter_->assignment(), fusion);
+      break;
     default:
       return Internal("Unimplemented fusion kind %d for instruction: %s",
                       fusion_emitter_kind, fusion->ToString());
@@ -391,8 +406,6 @@ absl::StatusOr<IrEmitter2::KernelInfo> IrEmitter2::EmitSliceToDynamicHostKernel(
 
 absl::StatusOr<IrEmitter2::KernelInfo>
 IrEmitter2::EmitDynamicUpdateSliceHostKernel(const HloInstruction* instr) {
-  DCHECK(CanUpdateDynamicSliceInPlace(instr));
-
   VLOG(2) << "Emit in-place dynamic-update-slice kernel: " << instr->name();
 
   TF_ASSIGN_OR_RETURN(KernelPrototype kernel_prototype,
@@ -125,7 +125,10 @@ class IrEmitter2 {
   absl::StatusOr<KernelInfo> EmitSliceToDynamicHostKernel(
       const HloInstruction* instr);
 
-  // Emits a host kernel for the given dynamic-update-slice instruction.
+  // Emits a host kernel for the given dynamic-update-slice instruction that
+  // writes the update into the result buffer in place. The kernel never reads
+  // the operand buffer, so if it doesn't share a slice with the result, the
+  // caller must copy the operand into the result buffer before the kernel runs.
   absl::StatusOr<KernelInfo> EmitDynamicUpdateSliceHostKernel(
       const HloInstruction* instr);
 
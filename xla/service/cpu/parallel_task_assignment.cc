@@ -22,7 +22,12 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
 #include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -39,6 +44,7 @@ limitations under the License.
 #include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/llvm_ir/dynamic_update_slice_util.h"
 #include "xla/shape_partition.h"
+#include "xla/shape_util.h"
 #include "xla/util.h"
 #include "tsl/platform/cpu_info.h"
 #include "tsl/platform/logging.h"  // IWYU pragma: keep
@@ -46,6 +52,47 @@ limitations under the License.
 
 namespace xla {
 namespace cpu {
+namespace {
+
+// Minimum amount of work per parallel task for memory-bound instructions.
+constexpr int64_t kMinBytesPerTask = 256LL << 10;
+
+// Returns the L2 cache size of the host in bytes, or kMinBytesPerTask if it
+// can't be detected.
+int64_t GetL2CacheSizeBytes() {
+  static const int64_t l2_cache_size = [] {
+#if defined(__linux__) && defined(_SC_LEVEL2_CACHE_SIZE)
+    long size = sysconf(_SC_LEVEL2_CACHE_SIZE);  // NOLINT(runtime/int)
+    if (size > 0) {
+      return std::max<int64_t>(size, kMinBytesPerTask);
+    }
+#endif
+    return kMinBytesPerTask;
+  }();
+  return l2_cache_size;
+}
+
+// Returns the maximum parallel task count for I/O bound instructions that
+// access `bytes_accessed` bytes.
+//
+// Small I/O bound instructions do not scale linearly with the number of
+// threads, so we limit them to a sub-linear scaling function (fit based on
+// empirical benchmark results). Instructions that stream through much more
+// memory than fits into the L2 caches of these threads are limited by memory
+// bandwidth instead, which takes many cores to saturate, so we allow enough
+// tasks for each task's tile to fit into the L2 cache of the thread running
+// it. This also keeps tiles in cache for consumers that run the same
+// partitioning (see ParallelTaskAssigner).
+int64_t GetMaxIoBoundParallelism(int64_t max_parallelism,
+                                 int64_t bytes_accessed) {
+  int64_t sublinear_parallelism =
+      std::ceil(std::sqrt(tsl::port::MaxParallelism()));
+  int64_t cache_tiles = CeilOfRatio(bytes_accessed, GetL2CacheSizeBytes());
+  return std::min(max_parallelism,
+                  std::max(sublinear_parallelism, cache_tiles));
+}
+
+}  // namespace
 
 class SimpleCostModel : public ParallelCostModel {
  public:
@@ -57,7 +104,7 @@ class SimpleCostModel : public ParallelCostModel {
   int64_t GetParallelTaskCount(HloInstruction* instruction) override {
     // Simple cost model based on hlo size and typical L2 cache size.
     const int64_t instruction_cost = shape_size_(instruction->shape());
-    const int64_t min_cost_per_thread = 256LL << 10;  // 256KB L2 Cache size.
+    const int64_t min_cost_per_thread = kMinBytesPerTask;
     // Return target parallel task count in [1, max_parallelism_].
     return std::min(
         max_parallelism_,
@@ -92,14 +139,14 @@ class DefaultCostModel : public ParallelCostModel {
         static_cast<float>(bytes_accessed);
     // Check for I/O bound instructions.
     if (flops_to_bytes_ratio <= 1.0) {
-      // Limit max parallelism for I/O bound instructions by assuming a
-      // sub-linear scaling function (fit based on empirical benchmark results).
+      // Limit max parallelism for I/O bound instructions based on how much
+      // memory they touch.
       // TODO(b/29630486) Develop system bandwidth model.
-      max_parallelism = std::min<int64_t>(
-          max_parallelism_, std::ceil(std::sqrt(tsl::port::MaxParallelism())));
+      max_parallelism =
+          GetMaxIoBoundParallelism(max_parallelism_, bytes_accessed);
       // Use bytes accessed cost and L2 cache size min per-thread cost.
       instruction_cost = bytes_accessed;
-      min_cost_per_thread = 256LL << 10;  // 256KB L2 Cache size.
+      min_cost_per_thread = kMinBytesPerTask;
     } else {
       // Use max parallelism for compute bound instructions.
       max_parallelism = max_parallelism_;
@@ -226,9 +273,13 @@ bool ParallelTaskAssigner::AssignParallelTasksHelper(
     HloModule* module, HloComputation* computation,
     const HloToParallelTasks& hlo_to_parallel_tasks) {
   bool changed = false;
-  // Snapshot set of instructions because outlining modifies the set below.
-  std::vector<HloInstruction*> instructions(computation->instructions().begin(),
-                                            computation->instructions().end());
+  // Partitions assigned to the outlined calls in 'computation'.
+  absl::flat_hash_map<const HloInstruction*, std::vector<int64_t>>
+      assigned_partitions;
+  // Snapshot instructions in post order because outlining modifies the set
+  // below, and consumers must be visited after their producers.
+  std::vector<HloInstruction*> instructions =
+      computation->MakeInstructionPostOrder();
   for (auto* instruction : instructions) {
     // Assign parallel tasks to sub-computations for While and Call HLOs.
     // TODO(b/27458679) Evaluate alternative intra-op parallelism placement,
@@ -252,6 +303,13 @@ bool ParallelTaskAssigner::AssignParallelTasksHelper(
     // Assign feasible dimension partitions (based on actual dimension sizes).
     auto dim_partition_counts = ShapePartitionAssigner(instruction->shape())
                                     .Run(target_parallel_task_count);
+    // Reuse the partitions of a producer if they are close to the target, so
+    // that task `i` reads the tile written by task `i` of the producer, which
+    // is still in the cache of the thread that runs both.
+    if (const std::vector<int64_t>* producer_partitions = GetAlignedPartitions(
+            instruction, target_parallel_task_count, assigned_partitions)) {
+      dim_partition_counts = *producer_partitions;
+    }
     const int64_t total_partition_count =
         ShapePartitionAssigner::GetTotalPartitionCount(dim_partition_counts);
     if (total_partition_count <= 1) {
@@ -271,6 +329,7 @@ bool ParallelTaskAssigner::AssignParallelTasksHelper(
                  tsl::protobuf::RepeatedFieldBackInserter(
                      backend_config.mutable_outer_dimension_partitions()));
     TF_CHECK_OK(new_root->set_backend_config(backend_config));
+    assigned_partitions[call] = dim_partition_counts;
 
     VLOG(2) << "Assigned parallel task count: " << total_partition_count
             << " to instruction: " << new_root->name()
@@ -280,6 +339,30 @@ bool ParallelTaskAssigner::AssignParallelTasksHelper(
   return changed;
 }
 
+const std::vector<int64_t>* ParallelTaskAssigner::GetAlignedPartitions(
+    const HloInstruction* instruction, int64_t target_parallel_task_count,
+    const absl::flat_hash_map<const HloInstruction*, std::vector<int64_t>>&
+        assigned_partitions) {
+  // Only instructions that read their operands at the output index.
+  if (!instruction->IsElementwise() && !instruction->IsLoopFusion()) {
+    return nullptr;
+  }
+  for (const HloInstruction* operand : instruction->operands()) {
+    auto it = assigned_partitions.find(operand);
+    if (it == assigned_partitions.end() ||
+        !ShapeUtil::SameDimensions(operand->shape(), instruction->shape())) {
+      continue;
+    }
+    const int64_t producer_task_count =
+        ShapePartitionAssigner::GetTotalPartitionCount(it->second);
+    if (producer_task_count <= 2 * target_parallel_task_count &&
+        target_parallel_task_count <= 2 * producer_task_count) {
+      return &it->second;
+    }
+  }
+  return nullptr;
+}
+
 void ParallelTaskAssigner::ComputeTargetParallelTasks(
     HloModule* module, HloToParallelTasks* hlo_to_parallel_tasks) {
   ParallelTaskAssignment parallel_task_assignment(max_parallelism_,
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
@@ -108,6 +109,14 @@ class ParallelTaskAssigner : public HloModulePass {
       HloModule* module, HloComputation* computation,
       const HloToParallelTasks& hlo_to_parallel_tasks);
 
+  // Returns the partitions assigned to a producer of 'instruction' that
+  // 'instruction' should reuse, so that its tasks read the tiles written by
+  // the same tasks of the producer, or nullptr if there is no such producer.
+  static const std::vector<int64_t>* GetAlignedPartitions(
+      const HloInstruction* instruction, int64_t target_parallel_task_count,
+      const absl::flat_hash_map<const HloInstruction*, std::vector<int64_t>>&
+          assigned_partitions);
+
   // Computes target parallel task counts (returned in 'parallel_task_counts')
   // for parallelizable instructions in 'module'.
   void ComputeTargetParallelTasks(HloModule* module,
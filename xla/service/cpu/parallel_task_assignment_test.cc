@@ -18,8 +18,10 @@ limitations under the License.
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "xla/backends/cpu/codegen/target_machine_features.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
@@ -28,6 +30,7 @@ limitations under the License.
 #include "xla/service/cpu/cpu_executable.h"
 #include "xla/service/cpu/target_machine_features_stub.h"
 #include "xla/service/hlo_cost_analysis.h"
+#include "xla/shape_partition.h"
 #include "xla/tests/hlo_test_base.h"
 #include "tsl/platform/statusor.h"
 
@@ -270,5 +273,65 @@ ENTRY main (input_x: f32[1000,1000], input_y: f32[1000,1000]) -> f32[1000,1000]
   EXPECT_FALSE(changed);
 }
 
+TEST_F(ParallelTaskAssignmentTest, LargeMemoryBoundOperationUsesAllThreads) {
+  // Streams through far more memory than fits into the L2 caches of
+  // `max_parallelism_` threads, so it is limited by memory bandwidth.
+  constexpr absl::string_view hlo_string = R"(
+    HloModule m
+    ENTRY e {
+      p0 = f32[8192,8192] parameter(0)
+      p1 = f32[8192,8192] parameter(1)
+      ROOT add = f32[8192,8192] add(p0, p1)
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> m,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, RunParallelTaskAssigner(m.get()));
+  EXPECT_TRUE(changed);
+
+  auto* add = FindInstruction(m.get(), HloOpcode::kAdd);
+  TF_ASSERT_OK_AND_ASSIGN(auto backend_config,
+                          add->backend_config<cpu::BackendConfig>());
+  std::vector<int64_t> partitions(
+      backend_config.outer_dimension_partitions().begin(),
+      backend_config.outer_dimension_partitions().end());
+  EXPECT_EQ(ShapePartitionAssigner::GetTotalPartitionCount(partitions),
+            ShapePartitionAssigner::GetTotalPartitionCount(
+                ShapePartitionAssigner(add->shape()).Run(max_parallelism_)));
+}
+
+TEST_F(ParallelTaskAssignmentTest, ConsumerReusesProducerPartitions) {
+  constexpr absl::string_view hlo_string = R"(
+    HloModule m
+    ENTRY e {
+      p0 = f32[8192,8192] parameter(0)
+      p1 = f32[8192,8192] parameter(1)
+      negate = f32[8192,8192] negate(p0)
+      ROOT add = f32[8192,8192] add(negate, p1)
+    }
+  )";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> m,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, RunParallelTaskAssigner(m.get()));
+  EXPECT_TRUE(changed);
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto negate_config,
+      FindInstruction(m.get(), HloOpcode::kNegate)
+          ->backend_config<cpu::BackendConfig>());
+  TF_ASSERT_OK_AND_ASSIGN(auto add_config,
+                          FindInstruction(m.get(), HloOpcode::kAdd)
+                              ->backend_config<cpu::BackendConfig>());
+  EXPECT_GT(negate_config.outer_dimension_partitions_size(), 0);
+  EXPECT_EQ(std::vector<int64_t>(
+                negate_config.outer_dimension_partitions().begin(),
+                negate_config.outer_dimension_partitions().end()),
+            std::vector<int64_t>(
+                add_config.outer_dimension_partitions().begin(),
+                add_config.outer_dimension_partitions().end()));
+}
+
 }  // namespace
 }  // namespace xla
@@ -0,0 +1,83 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/error_spec.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/xla.pb.h"
+
+namespace xla::cpu {
+namespace {
+
+// On CPUs without AMX BF16 support dots are upcasted to F32, and tests check
+// that results are the same with and without AMX dots enabled.
+class AmxDotTest : public HloTestBase {
+ protected:
+  DebugOptions GetDebugOptionsForTest() const override {
+    DebugOptions debug_options = HloTestBase::GetDebugOptionsForTest();
+    debug_options.set_xla_cpu_experimental_amx_dot(true);
+    return debug_options;
+  }
+};
+
+TEST_F(AmxDotTest, Bf16Dot) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule bf16_dot
+
+    ENTRY entry {
+      %lhs = bf16[100,64] parameter(0)
+      %rhs = bf16[64,70] parameter(1)
+      ROOT %dot = bf16[100,70] dot(%lhs, %rhs),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-2, 1e-2}));
+}
+
+TEST_F(AmxDotTest, Bf16DotWithF32Result) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule bf16_dot_f32_result
+
+    ENTRY entry {
+      %lhs = bf16[64,128] parameter(0)
+      %rhs = bf16[96,128] parameter(1)
+      ROOT %dot = f32[64,96] dot(%lhs, %rhs),
+        lhs_contracting_dims={1}, rhs_contracting_dims={1}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-2, 1e-2}));
+}
+
+TEST_F(AmxDotTest, BatchedBf16DotWithEpilogue) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule batched_bf16_dot
+
+    ENTRY entry {
+      %lhs = bf16[2,64,64] parameter(0)
+      %rhs = bf16[2,64,64] parameter(1)
+      %bias = bf16[2,64,64] parameter(2)
+      %dot = bf16[2,64,64] dot(%lhs, %rhs),
+        lhs_batch_dims={0}, rhs_batch_dims={0},
+        lhs_contracting_dims={2}, rhs_contracting_dims={1}
+      ROOT %add = bf16[2,64,64] add(%dot, %bias)
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-2, 1e-2}));
+}
+
+}  // namespace
+}  // namespace xla::cpu
@@ -24,12 +24,15 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_module_group.h"
 #include "xla/service/compiler.h"
+#include "xla/service/cpu/cpu_aot_image.h"
+#include "xla/service/cpu/cpu_compiler.h"
 #include "xla/service/executable.h"
 #include "xla/service/platform_util.h"
 #include "xla/stream_executor/platform.h"
 #include "xla/stream_executor/platform_manager.h"
 #include "xla/stream_executor/stream_executor.h"
 #include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/statusor.h"
 
 namespace xla::cpu {
@@ -69,6 +72,28 @@ class CpuAotCompilationTest : public HloTestBase {
     TF_ASSERT_OK_AND_ASSIGN(
         std::unique_ptr<Executable> executable,
         std::move(*loaded_aot_result).LoadExecutable(compiler, stream_exec));
+
+    // Export executable as a flat image, write it to a file and load it back
+    // via memory mapping.
+    auto* cpu_compiler = static_cast<CpuCompiler*>(compiler);
+    TF_ASSERT_OK_AND_ASSIGN(std::string image,
+                            cpu_compiler->ExportAsImage(executables[0].get()));
+
+    tsl::Env* env = tsl::Env::Default();
+    std::string path;
+    ASSERT_TRUE(env->LocalTempFilename(&path));
+    TF_ASSERT_OK(tsl::WriteStringToFile(env, path, image));
+
+    TF_ASSERT_OK_AND_ASSIGN(std::shared_ptr<const CpuAotImage> mapped_image,
+                            CpuAotImage::MapFile(env, path));
+    TF_ASSERT_OK_AND_ASSIGN(
+        std::unique_ptr<AotCompilationResult> image_aot_result,
+        cpu_compiler->LoadAotCompilationResultFromImage(mapped_image));
+    TF_ASSERT_OK_AND_ASSIGN(
+        std::unique_ptr<Executable> image_executable,
+        std::move(*image_aot_result).LoadExecutable(compiler, stream_exec));
+
+    TF_ASSERT_OK(env->DeleteFile(path));
   }
 };
 
@@ -99,4 +124,17 @@ TEST_F(CpuAotCompilationTest, ExportAndLoadExecutableNoKernels) {
   ExportAndLoad(hlo_string);
 }
 
+TEST_F(CpuAotCompilationTest, ExportAndLoadExecutableWithConstants) {
+  const absl::string_view hlo_string = R"(
+    HloModule Test
+
+    ENTRY main {
+      a = f32[2, 2]{1,0} parameter(0)
+      c = f32[2, 2]{1,0} constant({{1, 2}, {3, 4}})
+      ROOT b = f32[2, 2]{1,0} add(a, c)
+    })";
+
+  ExportAndLoad(hlo_string);
+}
+
 }  // namespace xla::cpu
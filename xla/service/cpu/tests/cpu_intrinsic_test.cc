@@ -170,7 +170,23 @@ IntrinsicTestSpec CpuUnaryIntrinsicTestCases[] = {
 
     IntrinsicTestSpec{
         HloOpcode::kLog, kTriple_android_arm, "",
-        R"(CHECK: fadd fast <4 x float> splat (float 0x3FBDE4A340000000)"}};
+        R"(CHECK: fadd fast <4 x float> splat (float 0x3FBDE4A340000000)"},
+
+    IntrinsicTestSpec{
+        HloOpcode::kSin, kTriple_x86_64, "",
+        R"(CHECK: <4 x float> {{.*}}splat (float 0xBF29943F20000000)"},
+
+    IntrinsicTestSpec{
+        HloOpcode::kSin, kTriple_x86_64, "+avx",
+        R"(CHECK: <8 x float> {{.*}}splat (float 0xBF29943F20000000)"},
+
+    IntrinsicTestSpec{
+        HloOpcode::kCos, kTriple_x86_64, "",
+        R"(CHECK: <4 x float> {{.*}}splat (float 0x3EF99EB9C0000000)"},
+
+    IntrinsicTestSpec{
+        HloOpcode::kCos, kTriple_x86_64, "+avx",
+        R"(CHECK: <8 x float> {{.*}}splat (float 0x3EF99EB9C0000000)"}};
 
 INSTANTIATE_TEST_SUITE_P(CpuUnaryIntrinsicTestInstantiation,
                          CpuUnaryIntrinsicTest,
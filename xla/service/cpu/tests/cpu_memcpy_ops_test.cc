@@ -0,0 +1,76 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/error_spec.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/test.h"
+
+namespace xla::cpu {
+namespace {
+
+// Tests for operations that the CPU backend emits as (parallel) memcpy
+// instead of elemental kernels.
+using CpuMemcpyOpsTest = HloTestBase;
+
+TEST_F(CpuMemcpyOpsTest, ConcatenateMajorDimension) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule concatenate
+
+    ENTRY entry {
+      %p0 = f32[1,256,1024] parameter(0)
+      %p1 = f32[1,128,1024] parameter(1)
+      %p2 = f32[1,256,1024] parameter(2)
+      ROOT %concatenate = f32[1,640,1024] concatenate(%p0, %p1, %p2),
+        dimensions={1}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{0, 0}));
+}
+
+TEST_F(CpuMemcpyOpsTest, ConcatenateMinorDimension) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule concatenate
+
+    ENTRY entry {
+      %p0 = f32[512,256] parameter(0)
+      %p1 = f32[512,768] parameter(1)
+      ROOT %concatenate = f32[512,1024] concatenate(%p0, %p1), dimensions={1}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{0, 0}));
+}
+
+TEST_F(CpuMemcpyOpsTest, DynamicUpdateSliceNotInPlace) {
+  // The parameter can't be updated in place, so the result buffer is
+  // initialized with a copy of it before the update.
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule dynamic_update_slice
+
+    ENTRY entry {
+      %cache = f32[8,1024,64] parameter(0)
+      %update = f32[8,1,64] parameter(1)
+      %zero = s32[] constant(0)
+      %position = s32[] constant(17)
+      ROOT %dus = f32[8,1024,64] dynamic-update-slice(%cache, %update,
+        %zero, %position, %zero)
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{0, 0}));
+}
+
+}  // namespace
+}  // namespace xla::cpu
@@ -0,0 +1,86 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/error_spec.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/xla.pb.h"
+
+namespace xla::cpu {
+namespace {
+
+// On CPUs without AVX512-BF16 support only data movement ops stay in BF16,
+// and tests check that results are the same with and without native BF16.
+class NativeBf16Test : public HloTestBase {
+ protected:
+  DebugOptions GetDebugOptionsForTest() const override {
+    DebugOptions debug_options = HloTestBase::GetDebugOptionsForTest();
+    debug_options.set_xla_cpu_experimental_native_bf16(true);
+    return debug_options;
+  }
+};
+
+TEST_F(NativeBf16Test, Transpose) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule bf16_transpose
+
+    ENTRY entry {
+      %p0 = bf16[64,128] parameter(0)
+      %transpose = bf16[128,64] transpose(%p0), dimensions={1,0}
+      ROOT %slice = bf16[100,64] slice(%transpose), slice={[0:100], [0:64]}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{0, 0}));
+}
+
+TEST_F(NativeBf16Test, Elementwise) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule bf16_elementwise
+
+    ENTRY entry {
+      %p0 = bf16[1024] parameter(0)
+      %p1 = bf16[1024] parameter(1)
+      %add = bf16[1024] add(%p0, %p1)
+      %mul = bf16[1024] multiply(%add, %p1)
+      %neg = bf16[1024] negate(%mul)
+      ROOT %max = bf16[1024] maximum(%neg, %p0)
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-2, 1e-2}));
+}
+
+TEST_F(NativeBf16Test, ReduceAccumulatesInF32) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule bf16_reduce
+
+    add {
+      %lhs = bf16[] parameter(0)
+      %rhs = bf16[] parameter(1)
+      ROOT %add = bf16[] add(%lhs, %rhs)
+    }
+
+    ENTRY entry {
+      %p0 = bf16[16,4096] parameter(0)
+      %zero = bf16[] constant(0)
+      ROOT %reduce = bf16[16] reduce(%p0, %zero), dimensions={1}, to_apply=add
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-2, 1e-2}));
+}
+
+}  // namespace
+}  // namespace xla::cpu
@@ -0,0 +1,83 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/error_spec.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/test.h"
+#include "xla/xla.pb.h"
+
+namespace xla::cpu {
+namespace {
+
+class WeightOnlyQuantizedDotTest : public HloTestBase {
+ protected:
+  DebugOptions GetDebugOptionsForTest() const override {
+    DebugOptions debug_options = HloTestBase::GetDebugOptionsForTest();
+    debug_options.set_xla_cpu_experimental_weight_only_quantized_dot(true);
+    return debug_options;
+  }
+};
+
+TEST_F(WeightOnlyQuantizedDotTest, S8Weights) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule s8_weights
+
+    ENTRY entry {
+      %x = f32[4,64] parameter(0)
+      %w = s8[64,32] parameter(1)
+      %scale = f32[32] parameter(2)
+      %w_f32 = f32[64,32] convert(%w)
+      %dot = f32[4,32] dot(%x, %w_f32),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+      %scale_broadcast = f32[4,32] broadcast(%scale), dimensions={1}
+      ROOT %result = f32[4,32] multiply(%dot, %scale_broadcast)
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-4, 1e-4}));
+}
+
+TEST_F(WeightOnlyQuantizedDotTest, S4WeightsTransposed) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule s4_weights_transposed
+
+    ENTRY entry {
+      %x = f32[1,64] parameter(0)
+      %w = s4[32,64] parameter(1)
+      %w_f32 = f32[32,64] convert(%w)
+      ROOT %dot = f32[1,32] dot(%x, %w_f32),
+        lhs_contracting_dims={1}, rhs_contracting_dims={1}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-4, 1e-4}));
+}
+
+TEST_F(WeightOnlyQuantizedDotTest, MixedPrecisionDot) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule mixed_precision_dot
+
+    ENTRY entry {
+      %w = s8[16,64] parameter(0)
+      %x = f32[64,3] parameter(1)
+      ROOT %dot = f32[16,3] dot(%w, %x),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-4, 1e-4}));
+}
+
+}  // namespace
+}  // namespace xla::cpu
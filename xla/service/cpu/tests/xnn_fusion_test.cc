@@ -99,6 +99,82 @@ TEST_F(XnnFusionTest, DotRhsTransposedAndMultiply) {
   EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-7}));
 }
 
+TEST_F(XnnFusionTest, DotBiasRelu) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule dot_bias_relu
+
+    xnn_fusion {
+      %lhs = f32[4,5] parameter(0)
+      %rhs = f32[5,6] parameter(1)
+      %bias = f32[6] parameter(2)
+      %dot = f32[4,6] dot(%lhs, %rhs),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+      %bias_broadcast = f32[4,6] broadcast(%bias), dimensions={1}
+      %add = f32[4,6] add(%dot, %bias_broadcast)
+      %zero = f32[] constant(0)
+      %zero_broadcast = f32[4,6] broadcast(%zero), dimensions={}
+      ROOT %relu = f32[4,6] maximum(%add, %zero_broadcast)
+    }
+
+    ENTRY entry {
+      %lhs = f32[4,5] parameter(0)
+      %rhs = f32[5,6] parameter(1)
+      %bias = f32[6] parameter(2)
+      ROOT %fusion = f32[4,6] fusion(%lhs, %rhs, %bias),
+        kind=kCustom, calls=xnn_fusion,
+        backend_config={"fusion_config": {kind: "__xnn_fusion"}}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-6}));
+}
+
+TEST_F(XnnFusionTest, DotSilu) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule dot_silu
+
+    xnn_fusion {
+      %lhs = f32[4,5] parameter(0)
+      %rhs = f32[5,6] parameter(1)
+      %dot = f32[4,6] dot(%lhs, %rhs),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0}
+      %logistic = f32[4,6] logistic(%dot)
+      ROOT %silu = f32[4,6] multiply(%dot, %logistic)
+    }
+
+    ENTRY entry {
+      %lhs = f32[4,5] parameter(0)
+      %rhs = f32[5,6] parameter(1)
+      ROOT %fusion = f32[4,6] fusion(%lhs, %rhs),
+        kind=kCustom, calls=xnn_fusion,
+        backend_config={"fusion_config": {kind: "__xnn_fusion"}}
+    })";
+
+  EXPECT_TRUE(RunAndCompare(kModuleStr, ErrorSpec{1e-5}));
+}
+
+TEST_F(XnnFusionTest, UnsupportedBroadcast) {
+  constexpr absl::string_view kModuleStr = R"(
+    HloModule unsupported_broadcast
+
+    xnn_fusion {
+      %x = f32[4,6] parameter(0)
+      %y = f32[4] parameter(1)
+      %broadcast = f32[4,6] broadcast(%y), dimensions={0}
+      ROOT %add = f32[4,6] add(%x, %broadcast)
+    }
+
+    ENTRY entry {
+      %x = f32[4,6] parameter(0)
+      %y = f32[4] parameter(1)
+      ROOT %fusion = f32[4,6] fusion(%x, %y), kind=kCustom, calls=xnn_fusion,
+        backend_config={"fusion_config": {kind: "__xnn_fusion"}}
+    })";
+
+  auto status = RunAndCompare(kModuleStr, ErrorSpec{0.0});
+  EXPECT_FALSE(status);
+  EXPECT_THAT(status.message(), HasSubstr("Unsupported XNNPACK broadcast"));
+}
+
 TEST_F(XnnFusionTest, UnsupportedDot) {
   constexpr absl::string_view kModuleStr = R"(
     HloModule unsupported_dot
@@ -126,16 +202,16 @@ TEST_F(XnnFusionTest, UnsupportedDot) {
 
 TEST_F(XnnFusionTest, UnsupportedOp) {
   constexpr absl::string_view kModuleStr = R"(
-    HloModule unsupported_sqrt
+    HloModule unsupported_cosine
 
     xnn_fusion {
       %x = f32[10] parameter(0)
-      ROOT %sqrt = f32[10] sqrt(%x)
+      ROOT %cosine = f32[10] cosine(%x)
     }
 
     ENTRY entry {
       %x = f32[10] parameter(0)
-      ROOT %sqrt = f32[10] fusion(%x), kind=kCustom, calls=xnn_fusion,
+      ROOT %cosine = f32[10] fusion(%x), kind=kCustom, calls=xnn_fusion,
         backend_config={"fusion_config": {kind: "__xnn_fusion"}}
     })";
 
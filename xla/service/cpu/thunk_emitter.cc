@@ -15,8 +15,10 @@ limitations under the License.
 
 #include "xla/service/cpu/thunk_emitter.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
@@ -46,8 +48,10 @@ limitations under the License.
 #include "xla/backends/cpu/runtime/convolution_thunk.h"
 #include "xla/backends/cpu/runtime/copy_thunk.h"
 #include "xla/backends/cpu/runtime/custom_call_thunk.h"
+#include "xla/backends/cpu/runtime/dot_lib.h"
 #include "xla/backends/cpu/runtime/dot_thunk.h"
 #include "xla/backends/cpu/runtime/fft_thunk.h"
+#include "xla/backends/cpu/runtime/gather_thunk.h"
 #include "xla/backends/cpu/runtime/infeed_thunk.h"
 #include "xla/backends/cpu/runtime/kernel_thunk.h"
 #include "xla/backends/cpu/runtime/logical_id_thunk.h"
@@ -235,7 +239,6 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitHloInstruction(
     case HloOpcode::kExp:
     case HloOpcode::kExpm1:
     case HloOpcode::kFloor:
-    case HloOpcode::kGather:
     case HloOpcode::kImag:
     case HloOpcode::kIota:
     case HloOpcode::kIsFinite:
@@ -293,6 +296,9 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitHloInstruction(
     case HloOpcode::kPad:
       return EmitPadKernelThunk(instruction);
 
+    case HloOpcode::kGather:
+      return EmitGatherThunk(instruction);
+
     case HloOpcode::kSlice:
     case HloOpcode::kDynamicSlice:
       return EmitSliceThunk(instruction);
@@ -577,8 +583,54 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitCallThunk(
   }
 }
 
+// Returns true if every operand of `concatenate` is copied into a single
+// contiguous range of the result buffer, which is the case when all operands
+// have the result layout and all dimensions that are more major than the
+// concatenate dimension have size one.
+static bool IsContiguousConcatenate(const HloInstruction* concatenate) {
+  const Shape& shape = concatenate->shape();
+  if (!shape.IsArray() || !shape.has_layout()) return false;
+
+  for (const HloInstruction* operand : concatenate->operands()) {
+    if (!LayoutUtil::Equal(operand->shape().layout(), shape.layout())) {
+      return false;
+    }
+  }
+
+  auto minor_to_major = shape.layout().minor_to_major();
+  auto it = absl::c_find(minor_to_major, concatenate->concatenate_dimension());
+  return std::all_of(std::next(it), minor_to_major.end(),
+                     [&](int64_t dim) { return shape.dimensions(dim) == 1; });
+}
+
 absl::StatusOr<ThunkSequence> ThunkEmitter::EmitConcatenateKernelThunk(
     const HloInstruction* instruction) {
+  // Large contiguous concatenates are emitted as a sequence of copy thunks
+  // into disjoint parts of the result buffer. Copies run concurrently with
+  // each other, and large copies are split across the intra-op thread pool.
+  static constexpr int64_t kMinConcatenateSizeForCopies = 1024 * 1024;
+  if (ShapeUtil::ByteSizeOf(instruction->shape()) >=
+          kMinConcatenateSizeForCopies &&
+      IsContiguousConcatenate(instruction)) {
+    TF_ASSIGN_OR_RETURN(auto result_buffer, GetAllocationSlice(instruction));
+
+    ThunkSequence thunks;
+    int64_t offset = 0;
+    for (const HloInstruction* operand : instruction->operands()) {
+      int64_t size = ShapeUtil::ByteSizeOf(operand->shape());
+      TF_ASSIGN_OR_RETURN(auto operand_buffer, GetAllocationSlice(operand));
+      BufferAllocation::Slice destination_buffer(
+          result_buffer.allocation(), result_buffer.offset() + offset, size);
+      TF_ASSIGN_OR_RETURN(
+          auto copy, CopyThunk::Create(ThunkInfo(instruction), operand_buffer,
+                                       operand->shape(), destination_buffer,
+                                       operand->shape()));
+      thunks.push_back(std::move(copy));
+      offset += size;
+    }
+    return thunks;
+  }
+
   ConcatenateKernelEmitter emitter(instruction, &buffer_assignment_,
                                    &target_machine_features_);
   TF_ASSIGN_OR_RETURN(KernelDefinition kernel_definition,
@@ -677,6 +729,28 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitCopyThunk(
                                       instruction->shape());
 }
 
+absl::StatusOr<ThunkSequence> ThunkEmitter::EmitGatherThunk(
+    const HloInstruction* instruction) {
+  const HloInstruction* operand = instruction->operand(0);
+  const HloInstruction* indices = instruction->operand(1);
+
+  // Gathers of whole rows (i.e. embedding lookups) are copied by a dedicated
+  // thunk, and all other gathers are lowered to elemental host kernels.
+  if (!GatherThunk::IsRowGather(operand->shape(), indices->shape(),
+                                instruction->shape(),
+                                instruction->gather_dimension_numbers(),
+                                instruction->gather_slice_sizes())) {
+    return EmitElementalKernelThunk(instruction);
+  }
+
+  TF_ASSIGN_OR_RETURN(auto operand_buffer, GetAllocationSlice(operand));
+  TF_ASSIGN_OR_RETURN(auto indices_buffer, GetAllocationSlice(indices));
+  TF_ASSIGN_OR_RETURN(auto output_buffer, GetAllocationSlice(instruction));
+  return ThunkSequence::Of<GatherThunk>(
+      ThunkInfo(instruction), operand_buffer, operand->shape(), indices_buffer,
+      indices->shape(), output_buffer, instruction->shape());
+}
+
 absl::StatusOr<ThunkSequence> ThunkEmitter::EmitElementalKernelThunk(
     const HloInstruction* instruction) {
   ElementalKernelEmitter emitter(instruction, &buffer_assignment_,
@@ -851,13 +925,42 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitDotThunk(
     const HloInstruction* instruction) {
   const HloInstruction* lhs = instruction->operand(0);
   const HloInstruction* rhs = instruction->operand(1);
+  const DotDimensionNumbers& dnums = instruction->dot_dimension_numbers();
+
+  // Weight-only quantized dots are always implemented by the DotThunk, as
+  // other dot implementations require operands of the same type. Large BF16
+  // dots (kept in BF16 only if AMX dots are enabled) also go to the DotThunk,
+  // which implements them with AMX tile instructions.
+  if (IsWeightOnlyQuantizedDot(dnums, lhs->shape(), rhs->shape(),
+                               instruction->shape()) ||
+      IsAmxEligibleDot(dnums, lhs->shape(), rhs->shape(),
+                       instruction->shape())) {
+    // DotThunk expects S4 weights packed two elements per byte.
+    for (const HloInstruction* operand : {lhs, rhs}) {
+      if (operand->shape().element_type() == S4 &&
+          operand->shape().layout().element_size_in_bits() != 4) {
+        return Unimplemented("Unsupported unpacked S4 dot operand: %s",
+                             operand->ToString());
+      }
+    }
+
+    TF_ASSIGN_OR_RETURN(BufferAllocation::Slice lhs_slice,
+                        GetAllocationSlice(lhs));
+    TF_ASSIGN_OR_RETURN(BufferAllocation::Slice rhs_slice,
+                        GetAllocationSlice(rhs));
+    TF_ASSIGN_OR_RETURN(BufferAllocation::Slice out_slice,
+                        GetAllocationSlice(instruction));
+
+    return ThunkSequence::Of<DotThunk>(
+        ThunkInfo(instruction), dnums, lhs_slice, lhs->shape(), rhs_slice,
+        rhs->shape(), out_slice, instruction->shape());
+  }
 
   TF_RETURN_IF_ERROR(ElementTypesSameAndSupported(
       *instruction, /*operands=*/{lhs, rhs},
       /*supported_types=*/
       {PRED, S8, U8, S16, U16, S32, U32, S64, U64, F16, F32, F64, C64, C128}));
 
-  const DotDimensionNumbers& dnums = instruction->dot_dimension_numbers();
   if (dnums.lhs_contracting_dimensions_size() != 1) {
     return Unimplemented(
         "Dot with multiple contracting dimensions is not implemented.");
@@ -909,7 +1012,12 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitDotThunk(
       }
 
       if (use_xnn) {
-        XnnDotThunk::Options options = {XnnShouldUseThreadPool(instruction)};
+        XnnDotThunk::Options options = {
+            XnnShouldUseThreadPool(instruction),
+            hlo_module_config_.debug_options()
+                .xla_cpu_experimental_numa_aware_parallel_loops(),
+            hlo_module_config_.debug_options()
+                .xla_cpu_experimental_adaptive_tile_size()};
         return ThunkSequence::Of<XnnDotThunk>(
             std::move(options), ThunkInfo(instruction), dnums, lhs_slice,
             lhs->shape(), rhs_slice, rhs->shape(), out_slice,
@@ -1109,17 +1217,41 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitSliceThunk(
 
 absl::StatusOr<ThunkSequence> ThunkEmitter::EmitDynamicUpdateSliceThunk(
     const HloInstruction* instruction) {
-  if (!ir_emitter_.CanUpdateDynamicSliceInPlace(instruction)) {
+  const HloInstruction* operand = instruction->operand(0);
+  const HloInstruction* update = instruction->operand(1);
+
+  // If the operand doesn't share a buffer with the result, we can still update
+  // the result in place after copying the operand into it. The copy is a
+  // (parallel) memcpy, which is a lot cheaper than an elemental kernel that
+  // selects between the operand and the update for every element. This is
+  // only profitable if the update doesn't overwrite the whole result.
+  bool in_place = ir_emitter_.CanUpdateDynamicSliceInPlace(instruction);
+  bool copy_and_update_in_place =
+      !in_place && ShapeUtil::ByteSizeOf(update->shape()) <
+                       ShapeUtil::ByteSizeOf(instruction->shape());
+
+  if (!in_place && !copy_and_update_in_place) {
     VLOG(2) << "Could not emit in-place dynamic-update-slice kernel: "
             << instruction->name();
     return EmitElementalKernelThunk(instruction);
   }
 
+  ThunkSequence thunks;
+  if (copy_and_update_in_place) {
+    VLOG(2) << "Copy operand to the result buffer to emit in-place "
+               "dynamic-update-slice kernel: "
+            << instruction->name();
+    TF_ASSIGN_OR_RETURN(thunks, EmitCopyThunk(instruction));
+  }
+
   TF_ASSIGN_OR_RETURN(
       auto kernel, ir_emitter_.EmitDynamicUpdateSliceHostKernel(instruction));
   TF_ASSIGN_OR_RETURN(auto buffers, GetHostKernelAllocationSlices(instruction));
 
-  return MakeKernelThunkSequence(instruction, buffers, kernel);
+  TF_ASSIGN_OR_RETURN(auto kernel_thunk,
+                      MakeKernelThunkSequence(instruction, buffers, kernel));
+  thunks.Append(std::move(kernel_thunk));
+  return thunks;
 }
 
 // Parse the sort comparator to determine the sort direction. Comparator is
@@ -1279,7 +1411,12 @@ absl::StatusOr<ThunkSequence> ThunkEmitter::EmitXnnFusionThunk(
   // Construct XNNPACK subgraph builder from the fusion computation.
   TF_ASSIGN_OR_RETURN(auto builder, EmitXnnFusionBuilder(computation));
 
-  XnnFusionThunk::Options options = {XnnShouldUseThreadPool(computation)};
+  XnnFusionThunk::Options options = {
+      XnnShouldUseThreadPool(computation),
+      hlo_module_config_.debug_options()
+          .xla_cpu_experimental_numa_aware_parallel_loops(),
+      hlo_module_config_.debug_options()
+          .xla_cpu_experimental_adaptive_tile_size()};
   return ThunkSequence::Of<XnnFusionThunk>(
       std::move(options), ThunkInfo(instruction), std::move(arguments),
       std::move(results),
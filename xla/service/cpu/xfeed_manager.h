@@ -22,7 +22,9 @@ limitations under the License.
 
 #include <cstdint>
 #include <deque>
+#include <functional>
 #include <string>
+#include <utility>
 
 #include "absl/status/statusor.h"
 #include "absl/synchronization/mutex.h"
@@ -95,6 +97,17 @@ class XfeedQueueManager {
   XfeedBuffer* current_buffer_ = nullptr;
 };
 
+// An outfed array passed to an outfeed callback. `data` points directly into
+// the buffers of the running computation and is only valid for the duration of
+// the callback.
+struct OutfeedData {
+  const Shape* shape;
+  absl::Span<const uint8_t> data;
+};
+
+// Callback that receives all arrays of a single outfeed operation at once.
+using OutfeedCallback = std::function<void(absl::Span<const OutfeedData>)>;
+
 // Client-side class used to enqueue infeed buffers.
 class XfeedManager {
  public:
@@ -103,9 +116,26 @@ class XfeedManager {
   XfeedQueueManager* infeed() { return &infeed_; }
   XfeedQueueManager* outfeed() { return &outfeed_; }
 
+  // Registers a callback that consumes outfeeds instead of the outfeed queue.
+  // Outfeed operations hand their buffers to the callback without waiting for
+  // the client to enqueue destination buffers and without copying them, which
+  // makes it a better fit for streaming metrics out of long-running loops.
+  //
+  // The callback is invoked from the thread executing the outfeed, must be
+  // thread-safe if multiple computations outfeed concurrently, and must not be
+  // changed while computations that outfeed are running.
+  void set_outfeed_callback(OutfeedCallback callback) {
+    outfeed_callback_ = std::move(callback);
+  }
+
+  const OutfeedCallback* outfeed_callback() const {
+    return outfeed_callback_ ? &outfeed_callback_ : nullptr;
+  }
+
  private:
   XfeedQueueManager infeed_ = {"infeed"};
   XfeedQueueManager outfeed_ = {"outfeed"};
+  OutfeedCallback outfeed_callback_;
 };
 
 int64_t GetByteSizeRequirement(const Shape& shape, int64_t pointer_size);
@@ -15,7 +15,9 @@ limitations under the License.
 
 #include "xla/service/dump.h"
 
+#include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -27,8 +29,11 @@ limitations under the License.
 
 #include "absl/algorithm/container.h"
 #include "absl/base/const_init.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/functional/any_invocable.h"
+#include "absl/hash/hash.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -56,6 +61,7 @@ limitations under the License.
 #include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/file_system.h"
 #include "xla/tsl/platform/file_system_helper.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 #include "tsl/platform/path.h"
 #include "tsl/platform/platform.h"
@@ -125,6 +131,9 @@ struct CanonicalDebugOptions {
         dump_include_timestamp(opts.xla_dump_include_timestamp()),
         dump_max_hlo_modules(opts.xla_dump_max_hlo_modules()),
         dump_compress_protos(opts.xla_dump_compress_protos()),
+        dump_compress_text(opts.xla_dump_compress_text()),
+        dump_async(opts.xla_dump_async()),
+        dump_skip_unchanged_modules(opts.xla_dump_skip_unchanged_modules()),
         dump_fdo_profiles(opts.xla_gpu_experimental_dump_fdo_profiles()),
         dump_mlir_pretty_form(opts.xla_dump_enable_mlir_pretty_form()),
         dump_full_hlo_config(opts.xla_dump_full_hlo_config()) {
@@ -250,6 +259,9 @@ struct CanonicalDebugOptions {
   bool dump_include_timestamp;
   int64_t dump_max_hlo_modules;
   bool dump_compress_protos;
+  bool dump_compress_text;
+  bool dump_async;
+  bool dump_skip_unchanged_modules;
   bool dump_fdo_profiles;
   bool dump_mlir_pretty_form;
   bool dump_full_hlo_config;
@@ -314,6 +326,65 @@ static absl::Status WriteStringToFile(tsl::Env* env, const std::string& fname,
   return gz_file.Close();
 }
 
+// Writes dump files on a background thread. Files are written in the order
+// they are scheduled. Scheduling blocks while too much data is pending, to
+// bound the memory held by the queue.
+class AsyncDumpWriter {
+ public:
+  static AsyncDumpWriter& Get() {
+    static AsyncDumpWriter* writer = new AsyncDumpWriter();
+    return *writer;
+  }
+
+  void Schedule(std::string file_path, std::string contents, bool compress) {
+    int64_t size = contents.size();
+    {
+      absl::MutexLock lock(&mu_);
+      mu_.Await(absl::Condition(this, &AsyncDumpWriter::CanSchedule));
+      pending_bytes_ += size;
+      ++pending_files_;
+    }
+    thread_pool_.Schedule([this, file_path = std::move(file_path),
+                           contents = std::move(contents), compress, size] {
+      absl::Status status = WriteStringToFile(tsl::Env::Default(), file_path,
+                                              contents, compress);
+      if (!status.ok()) {
+        LOG(ERROR) << "Could not write XLA debug data to " << file_path << ": "
+                   << status;
+      }
+      absl::MutexLock lock(&mu_);
+      pending_bytes_ -= size;
+      --pending_files_;
+    });
+  }
+
+  void Flush() {
+    absl::MutexLock lock(&mu_);
+    mu_.Await(absl::Condition(this, &AsyncDumpWriter::IsIdle));
+  }
+
+ private:
+  static constexpr int64_t kMaxPendingBytes = int64_t{1} << 30;
+
+  AsyncDumpWriter()
+      : thread_pool_(tsl::Env::Default(), "xla_dump", /*num_threads=*/1) {
+    std::atexit([] { AsyncDumpWriter::Get().Flush(); });
+  }
+
+  bool CanSchedule() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    return pending_bytes_ < kMaxPendingBytes || pending_files_ == 0;
+  }
+
+  bool IsIdle() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    return pending_files_ == 0;
+  }
+
+  tsl::thread::ThreadPool thread_pool_;
+  absl::Mutex mu_;
+  int64_t pending_bytes_ ABSL_GUARDED_BY(mu_) = 0;
+  int64_t pending_files_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
 static std::optional<std::string> GetDumpFilePath(
     string_view filename, const CanonicalDebugOptions& opts) {
   if (opts.dumping_to_stdout()) {
@@ -372,6 +443,12 @@ static std::optional<std::string> DumpToFileInDirImpl(
   auto file_path = GetDumpFilePath(filename, opts);
   if (!file_path) return std::nullopt;
 
+  if (opts.dump_async) {
+    AsyncDumpWriter::Get().Schedule(*file_path, std::string(contents),
+                                    compress);
+    return file_path;
+  }
+
   auto status =
       WriteStringToFile(tsl::Env::Default(), *file_path, contents, compress);
   if (!status.ok()) {
@@ -460,8 +537,14 @@ static std::vector<std::string> DumpHloModuleImpl(
   std::vector<std::optional<std::string>> file_paths;
 
   if (opts.dump_as_text) {
-    file_paths.push_back(DumpToFileInDirOrStdoutImpl(StrCat(filename, ".txt"),
-                                                     module.ToString(), opts));
+    if (opts.dump_compress_text && !opts.dumping_to_stdout()) {
+      file_paths.push_back(DumpToFileInDirImpl(StrCat(filename, ".txt.gz"),
+                                               module.ToString(), opts,
+                                               /*compress=*/true));
+    } else {
+      file_paths.push_back(DumpToFileInDirOrStdoutImpl(
+          StrCat(filename, ".txt"), module.ToString(), opts));
+    }
     if (buffer_assn) {
       DataProducer buffer_assignment;
       buffer_assignment.Append([&] { return buffer_assn->ToString(); });
@@ -613,11 +696,31 @@ static auto& module_id_to_step_number ABSL_GUARDED_BY(mu) =
 static auto& module_id_to_timestamp ABSL_GUARDED_BY(mu) =
     *new absl::flat_hash_map<int64_t, uint64_t>();
 
+// Maps a module's unique ID to the hash of the module when it was last dumped
+// between passes. Leaks like the maps above.
+static auto& module_id_to_dumped_hash ABSL_GUARDED_BY(mu) =
+    *new absl::flat_hash_map<int64_t, size_t>();
+
 int64_t StepNumberForModule(const HloModule& module) {
   absl::MutexLock lock(&mu);
   return module_id_to_step_number[module.unique_id()]++;
 }
 
+// Returns true if the module is dumped between passes for the first time or
+// has changed since its previous dump.
+bool ModuleChangedSinceLastDump(const HloModule& module) {
+  size_t hash = absl::HashOf(module);
+  absl::MutexLock lock(&mu);
+  auto [it, inserted] =
+      module_id_to_dumped_hash.try_emplace(module.unique_id(), hash);
+  if (inserted) {
+    return true;
+  }
+  bool changed = it->second != hash;
+  it->second = hash;
+  return changed;
+}
+
 }  // namespace
 
 // Get a timestamp which we can use as a filename prefix specific to this
@@ -794,6 +897,8 @@ std::vector<std::string> DumpHloModuleProtoIfEnabled(
   return {};
 }
 
+void FlushAsyncDumps() { AsyncDumpWriter::Get().Flush(); }
+
 bool DumpingEnabledForHloModule(string_view hlo_module_name,
                                 const DebugOptions& opts) {
   return CanonicalDebugOptions(opts).should_dump_module(hlo_module_name);
@@ -825,6 +930,12 @@ std::vector<std::string> DumpHloModuleBetweenPassesIfEnabled(
     return {};
   }
 
+  if (opts.dump_skip_unchanged_modules && !ModuleChangedSinceLastDump(module)) {
+    VLOG(1) << "Skipping dump of unchanged module " << module.name()
+            << " after pass " << after_pass_name;
+    return {};
+  }
+
   int64_t step_number = StepNumberForModule(module);
   std::string timestamp = TimestampFor(module);
 
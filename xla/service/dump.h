@@ -43,6 +43,9 @@ constexpr char kAfterOptimizationsDumpName[] = "after_optimizations";
 class BufferAssignment;
 class HloSnapshot;
 
+// Blocks until all dump files scheduled with --xla_dump_async are written.
+void FlushAsyncDumps();
+
 // Creates dir if doesn't exist (analogue of `mkdir -p`), tries to get around
 // race conditions by trying again on collision.
 absl::Status CreateDirIfNeeded(const std::string& dir, tsl::Env* env);
@@ -22,6 +22,9 @@ limitations under the License.
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include "absl/strings/match.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/parser/hlo_parser.h"
 #include "xla/runtime/large_hlo_snapshot_serialization/serialization.h"
 #include "xla/service/hlo_module_config.h"
@@ -127,6 +130,81 @@ TEST(DumpTest, DumpingToFileWorksWhenEnabled) {
   EXPECT_EQ(contents, real_contents);
 }
 
+TEST(DumpTest, AsyncDumpingWritesFilesAfterFlush) {
+  std::string filename = tsl::io::JoinPath(tsl::testing::TmpDir(), "async");
+  std::string contents = "hello";
+  DebugOptions options;
+  options.set_xla_dump_to(tsl::testing::TmpDir());
+  options.set_xla_dump_async(true);
+  DumpToFileInDir(options, "async", contents);
+  FlushAsyncDumps();
+
+  std::string real_contents;
+  TF_ASSERT_OK(
+      tsl::ReadFileToString(tsl::Env::Default(), filename, &real_contents));
+  EXPECT_EQ(contents, real_contents);
+}
+
+TEST(DumpHloIfEnabled, CompressedText) {
+  HloModuleConfig config;
+  DebugOptions options = config.debug_options();
+  auto env = tsl::Env::Default();
+  std::string dump_dir;
+  EXPECT_TRUE(env->LocalTempFilename(&dump_dir));
+  options.set_xla_dump_to(dump_dir);
+  options.set_xla_dump_hlo_as_text(true);
+  options.set_xla_dump_compress_text(true);
+  config.set_debug_options(options);
+  const char* kModuleStr = R"(
+    HloModule m
+    test {
+      p0 = s32[11] parameter(0)
+      ROOT x = s32[11] negate(p0)
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto m,
+                          ParseAndReturnUnverifiedModule(kModuleStr, config));
+  auto paths = DumpHloModuleIfEnabled(*m, "dump");
+  ASSERT_FALSE(paths.empty());
+  EXPECT_TRUE(absl::EndsWith(paths[0], ".txt.gz"));
+  std::string data;
+  TF_ASSERT_OK(tsl::ReadFileToString(env, paths[0], &data));
+  // Gzip magic number.
+  ASSERT_GE(data.size(), 2);
+  EXPECT_EQ(data.substr(0, 2), "\x1f\x8b");
+}
+
+TEST(DumpHloIfEnabled, SkipsUnchangedModulesBetweenPasses) {
+  HloModuleConfig config;
+  DebugOptions options = config.debug_options();
+  std::string dump_dir;
+  EXPECT_TRUE(tsl::Env::Default()->LocalTempFilename(&dump_dir));
+  options.set_xla_dump_to(dump_dir);
+  options.set_xla_dump_hlo_pass_re(".*");
+  options.set_xla_dump_skip_unchanged_modules(true);
+  config.set_debug_options(options);
+  const char* kModuleStr = R"(
+    HloModule m
+    test {
+      p0 = s32[11] parameter(0)
+      ROOT x = s32[11] negate(p0)
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto m,
+                          ParseAndReturnUnverifiedModule(kModuleStr, config));
+  EXPECT_FALSE(
+      DumpHloModuleBetweenPassesIfEnabled("pipeline", "b", "a", *m).empty());
+  EXPECT_TRUE(
+      DumpHloModuleBetweenPassesIfEnabled("pipeline", "c", "b", *m).empty());
+
+  HloComputation* computation = m->entry_computation();
+  HloInstruction* root = computation->root_instruction();
+  computation->set_root_instruction(computation->AddInstruction(
+      HloInstruction::CreateUnary(root->shape(), HloOpcode::kNegate, root)));
+  EXPECT_FALSE(
+      DumpHloModuleBetweenPassesIfEnabled("pipeline", "d", "c", *m).empty());
+}
+
 TEST(DumpTest, DumpProtobufToFileWhenEnabled) {
   HloModuleProto module;
   module.set_name("hello");
@@ -19,6 +19,7 @@ limitations under the License.
 #include <array>
 #include <cmath>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <utility>
@@ -43,6 +44,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_clone_context.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/pjrt/distributed/key_value_store_interface.h"
 #include "xla/service/dump.h"
 #include "xla/service/gpu/autotuning/autotuner_status_key.h"
 #include "xla/status_macros.h"
@@ -75,6 +77,8 @@ static auto& autotune_cache ABSL_GUARDED_BY(autotune_cache_mu) =
     *new AutotuneCacheMap();
 static AutotunerUtil::CacheStats autotune_cache_stats
     ABSL_GUARDED_BY(autotune_cache_mu);
+static auto& shared_autotune_cache ABSL_GUARDED_BY(autotune_cache_mu) =
+    *new std::shared_ptr<KeyValueStoreInterface>();
 
 absl::StatusOr<std::string> GetBase64EncodedSha256Hash(absl::string_view s) {
   llvm::SHA256 sha256;
@@ -161,6 +165,43 @@ absl::Status AddResultToFileBasedCacheIfEnabled(
   return default_env->RenameFile(temp_file_path, file_path);
 }
 
+// Prefix of keys in the shared key-value store, to avoid collisions with other
+// users of the store.
+constexpr absl::string_view kSharedCacheKeyPrefix = "xla_gpu_autotune_cache/";
+
+std::shared_ptr<KeyValueStoreInterface> GetSharedCache()
+    ABSL_LOCKS_EXCLUDED(autotune_cache_mu) {
+  absl::MutexLock lock(&autotune_cache_mu);
+  return shared_autotune_cache;
+}
+
+void AddResultToSharedCacheIfEnabled(
+    const AutotuneCacheKey& key, const AutotuneResult& result,
+    DebugOptions::AutotuneCacheMode autotune_cache_mode)
+    ABSL_LOCKS_EXCLUDED(autotune_cache_mu) {
+  std::shared_ptr<KeyValueStoreInterface> shared_cache = GetSharedCache();
+  if (shared_cache == nullptr ||
+      autotune_cache_mode == DebugOptions::AUTOTUNE_CACHE_MODE_READ) {
+    return;
+  }
+
+  absl::StatusOr<std::string> key_hash =
+      GetBase64EncodedSha256Hash(key.ToString());
+  if (!key_hash.ok()) {
+    LOG(WARNING) << "Failed to hash autotune cache key: " << key_hash.status();
+    return;
+  }
+
+  VLOG(1) << "Publishing autotune result to shared cache: " << *key_hash;
+  absl::Status status =
+      shared_cache->Set(absl::StrCat(kSharedCacheKeyPrefix, *key_hash),
+                        result.SerializeAsString());
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to publish autotune result to shared cache: "
+                 << status;
+  }
+}
+
 absl::StatusOr<ResultAndInserted> AddResultToCaches(
     const AutotuneCacheKey& key, AutotuneResult result,
     absl::string_view cache_dir,
@@ -170,6 +211,8 @@ absl::StatusOr<ResultAndInserted> AddResultToCaches(
   if (result_and_inserted.inserted) {
     TF_RETURN_IF_ERROR(AddResultToFileBasedCacheIfEnabled(
         key, result_and_inserted.result, cache_dir, autotune_cache_mode));
+    AddResultToSharedCacheIfEnabled(key, result_and_inserted.result,
+                                    autotune_cache_mode);
   }
   return result_and_inserted;
 }
@@ -214,6 +257,39 @@ TryToFindInFileBasedCacheIfEnabled(const AutotuneCacheKey& key,
   return result;
 }
 
+std::optional<AutotuneResult> TryToFindInSharedCacheIfEnabled(
+    const AutotuneCacheKey& key) ABSL_LOCKS_EXCLUDED(autotune_cache_mu) {
+  std::shared_ptr<KeyValueStoreInterface> shared_cache = GetSharedCache();
+  if (shared_cache == nullptr) {
+    return std::nullopt;
+  }
+
+  absl::StatusOr<std::string> key_hash =
+      GetBase64EncodedSha256Hash(key.ToString());
+  if (!key_hash.ok()) {
+    LOG(WARNING) << "Failed to hash autotune cache key: " << key_hash.status();
+    return std::nullopt;
+  }
+
+  absl::StatusOr<std::string> value =
+      shared_cache->TryGet(absl::StrCat(kSharedCacheKeyPrefix, *key_hash));
+  if (!value.ok()) {
+    if (!absl::IsNotFound(value.status())) {
+      LOG(WARNING) << "Failed to read autotune result from shared cache: "
+                   << value.status();
+    }
+    return std::nullopt;
+  }
+
+  AutotuneResult result;
+  if (!result.ParseFromString(*value)) {
+    LOG(WARNING) << "Failed to parse autotune result from shared cache: "
+                 << *key_hash;
+    return std::nullopt;
+  }
+  return result;
+}
+
 // Sort the results so that they're deterministic.
 void SortAutotuneResults(AutotuneResults* results) {
   std::sort(results->mutable_results()->pointer_begin(),
@@ -291,6 +367,12 @@ void SerializeAutotuneEntry(AutotuneResults* results, const AutotuneCacheKey& k,
   autotune_cache.clear();
 }
 
+/*static*/ void AutotunerUtil::SetSharedAutotuneCache(
+    std::shared_ptr<KeyValueStoreInterface> key_value_store) {
+  absl::MutexLock lock(&autotune_cache_mu);
+  shared_autotune_cache = std::move(key_value_store);
+}
+
 /*static*/ bool AutotunerUtil::ResultCacheIsEmpty() {
   absl::MutexLock lock(&autotune_cache_mu);
   return autotune_cache.empty();
@@ -362,7 +444,7 @@ AutotuneCacheKey::AutotuneCacheKey(absl::string_view model_str,
 }
 
 namespace {
-enum class CacheType { kNone, kInMemory, kOnDisk };
+enum class CacheType { kNone, kInMemory, kOnDisk, kShared };
 
 absl::StatusOr<std::pair<CacheType, std::optional<AutotuneResult>>>
 TryFindInAllCacheTypes(const AutotuneCacheKey& key, absl::string_view cache_dir)
@@ -379,6 +461,12 @@ TryFindInAllCacheTypes(const AutotuneCacheKey& key, absl::string_view cache_dir)
     return std::make_pair(CacheType::kOnDisk, opt_result);
   }
 
+  opt_result = TryToFindInSharedCacheIfEnabled(key);
+  if (opt_result.has_value()) {
+    AddResultToInMemoryCache(key, opt_result.value());
+    return std::make_pair(CacheType::kShared, opt_result);
+  }
+
   return std::make_pair(CacheType::kNone, std::nullopt);
 }
 
@@ -400,6 +488,9 @@ absl::StatusOr<std::optional<AutotuneResult>> TryFindInCache(
       case CacheType::kOnDisk:
         LOG(INFO) << "File-based autotune cache hit" << logged_key;
         break;
+      case CacheType::kShared:
+        LOG(INFO) << "Shared autotune cache hit" << logged_key;
+        break;
     }
   }
 
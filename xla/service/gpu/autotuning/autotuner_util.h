@@ -33,6 +33,7 @@ limitations under the License.
 #include "xla/autotune_results.pb.h"
 #include "xla/autotuning.pb.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/pjrt/distributed/key_value_store_interface.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/stream_executor/device_memory_allocator.h"
 #include "xla/stream_executor/stream_executor.h"
@@ -324,6 +325,15 @@ struct AutotunerUtil {
   // cache you're responsible for clearing the cache directory when you want to.
   static void ClearAutotuneResults();
 
+  // Sets a key-value store used as an autotune results cache shared between
+  // processes, e.g. all jobs compiling the same models. Results are looked up
+  // in it after the in-memory and file-based caches, and published to it after
+  // autotuning unless the cache mode is read-only. Errors from the store are
+  // logged and treated as cache misses. Passing nullptr disables the shared
+  // cache.
+  static void SetSharedAutotuneCache(
+      std::shared_ptr<KeyValueStoreInterface> key_value_store);
+
   // Warning: This only checks the in-memory cache. If you use a file based
   // cache, you're responsible for checking whether the cache directory is
   // empty.
@@ -337,13 +347,13 @@ struct AutotunerUtil {
   // Returns Cache statistics since the last call to ClearCacheStats or since
   // the program was started.
   //
-  // This method counts both in-memory and on disk caches. Every time the
+  // This method counts in-memory, on disk and shared caches. Every time the
   // Autotune() or IsInCache() methods are called, the key is looked up in the
-  // two caches, first in the in-memory cache, then in the on-disk cache. If the
-  // key is found in any of the two caches, the global cache_hits is
-  // incremented, otherwise cache_misses is incremented. Note that client code
-  // that first calls IsInCache() and then Autotune() in case of a miss, will
-  // actually cause cache_misses to be incremented twice.
+  // caches, first in the in-memory cache, then in the on-disk cache and then
+  // in the shared cache. If the key is found in any of the caches, the global
+  // cache_hits is incremented, otherwise cache_misses is incremented. Note that
+  // client code that first calls IsInCache() and then Autotune() in case of a
+  // miss, will actually cause cache_misses to be incremented twice.
   static CacheStats GetCacheStats();
 
   // Resets the global CacheStats that is returned by GetCacheStats().
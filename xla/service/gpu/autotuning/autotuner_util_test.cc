@@ -36,6 +36,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/utils/hlo_query.h"
+#include "xla/pjrt/distributed/in_memory_key_value_store.h"
 #include "xla/service/dump.h"
 #include "xla/service/gpu/autotuning/autotuner_status_key.h"
 #include "xla/stream_executor/device_description.h"
@@ -544,6 +545,58 @@ TEST_F(FileBasedCacheTest, AddResultDoesNotWriteTheFileInReadMode) {
             0);  // wasn't dumped to file based cache.
 }
 
+class SharedCacheTest : public FileBasedCacheTest {
+ protected:
+  void SetUp() override {
+    FileBasedCacheTest::SetUp();
+    AutotunerUtil::SetSharedAutotuneCache(shared_cache_);
+  }
+
+  void TearDown() override {
+    AutotunerUtil::SetSharedAutotuneCache(nullptr);
+    FileBasedCacheTest::TearDown();
+  }
+
+  std::shared_ptr<InMemoryKeyValueStore> shared_cache_ =
+      std::make_shared<InMemoryKeyValueStore>();
+};
+
+TEST_F(SharedCacheTest, AutotuneReadsResultPublishedByAnotherProcess) {
+  TF_ASSERT_OK(
+      AutotunerUtil::Autotune(dot_, GetConfig(), [&] { return result1_; })
+          .status());
+
+  // Simulate another process: it has no in-memory or file-based results.
+  AutotunerUtil::ClearAutotuneResults();
+  AutotunerUtil::ClearCacheStats();
+  TF_ASSERT_OK(tsl::Env::Default()->DeleteFile(GetCacheFilePath()));
+
+  bool cache_hit = true;
+  TF_ASSERT_OK_AND_ASSIGN(AutotuneResult result,
+                          AutotunerUtil::Autotune(dot_, GetConfig(), [&] {
+                            cache_hit = false;
+                            return result2_;
+                          }));
+
+  EXPECT_TRUE(cache_hit);
+  EXPECT_EQ(AutotunerUtil::GetCacheStats().cache_hits, 1);
+  EXPECT_EQ(AutotunerUtil::GetCacheStats().cache_misses, 0);
+  EXPECT_EQ(ToString(result), ToString(result1_));
+}
+
+TEST_F(SharedCacheTest, AddResultDoesNotPublishInReadMode) {
+  SetCacheMode(DebugOptions::AUTOTUNE_CACHE_MODE_READ);
+  TF_ASSERT_OK_AND_ASSIGN(
+      bool added,
+      AutotunerUtil::AddResult(GetCacheKey(), result1_, GetConfig()));
+  EXPECT_TRUE(added);
+
+  AutotunerUtil::ClearAutotuneResults();
+  TF_ASSERT_OK_AND_ASSIGN(bool is_in_cache,
+                          AutotunerUtil::IsInCache(GetCacheKey(), GetConfig()));
+  EXPECT_FALSE(is_in_cache);
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
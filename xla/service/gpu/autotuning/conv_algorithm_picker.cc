@@ -28,6 +28,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/cleanup/cleanup.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
@@ -105,6 +106,18 @@ Shape MaybeTupleElementShape(Shape shape, int64_t tuple_idx) {
   }
 }
 
+// Returns a key that is equal for convolutions that can share input/output
+// buffers during autotuning: those with the same operand and result shapes.
+std::string RedzoneBuffersKey(const HloInstruction& instr) {
+  std::string key;
+  for (const HloInstruction* operand : instr.operands()) {
+    absl::StrAppend(&key, ShapeUtil::HumanStringWithLayout(operand->shape()),
+                    ";");
+  }
+  absl::StrAppend(&key, ShapeUtil::HumanStringWithLayout(instr.shape()));
+  return key;
+}
+
 class ScratchAllocator : public se::ScratchAllocator {
  public:
   ScratchAllocator(int device_ordinal,
@@ -447,12 +460,7 @@ absl::StatusOr<AutotuneResult> GpuConvAlgorithmPicker::PickBestAlgorithmNoCache(
 absl::StatusOr<GpuConvAlgorithmPicker::AutotuneRuntimeArguments>
 GpuConvAlgorithmPicker::AutotuneRuntimeArguments::FromInstruction(
     const HloCustomCallInstruction* instr, const AutotuneConfig& config,
-    const DebugOptions& debug_options) {
-  TF_ASSIGN_OR_RETURN(auto rz_buffers,
-                      RedzoneBuffers::FromInstruction(
-                          *instr, config, debug_options,
-                          RedzoneBuffers::kAllInputsOutputsNoScratch));
-
+    std::shared_ptr<const RedzoneBuffers> rz_buffers) {
   // Get canonical HLO.
   std::string canonical_hlo(
       AutotuneCacheKey(config.GetDeviceDescription(), *instr).GetHlo());
@@ -468,6 +476,26 @@ GpuConvAlgorithmPicker::AutotuneRuntimeArguments::FromInstruction(
   return runtime_arguments;
 }
 
+absl::StatusOr<std::shared_ptr<const RedzoneBuffers>>
+GpuConvAlgorithmPicker::GetRedzoneBuffers(const HloCustomCallInstruction* instr,
+                                          const DebugOptions& debug_options) {
+  // Buffers are filled from a fixed seed, so sharing them between
+  // convolutions of the same shapes doesn't change what the algorithms see.
+  std::string key = RedzoneBuffersKey(*instr);
+  if (redzone_buffers_ == nullptr || key != redzone_buffers_key_) {
+    // Release the previous buffers before allocating new ones.
+    redzone_buffers_ = nullptr;
+    TF_ASSIGN_OR_RETURN(RedzoneBuffers rz_buffers,
+                        RedzoneBuffers::FromInstruction(
+                            *instr, config_, debug_options,
+                            RedzoneBuffers::kAllInputsOutputsNoScratch));
+    redzone_buffers_ =
+        std::make_shared<const RedzoneBuffers>(std::move(rz_buffers));
+    redzone_buffers_key_ = std::move(key);
+  }
+  return redzone_buffers_;
+}
+
 struct CudnnVersionRange {
   using TupleVersion = std::tuple<int, int, int>;
   TupleVersion begin;
@@ -624,9 +652,9 @@ absl::StatusOr<AutotuneResult> GpuConvAlgorithmPicker::AutotuneOneConvRunner(
   float min_time = std::numeric_limits<float>::max();
   absl::Status launch_status;
   std::vector<se::DeviceMemoryBase> operand_buffers =
-      runtime_arguments.rz_buffers.input_buffers();
+      runtime_arguments.rz_buffers->input_buffers();
   std::vector<se::DeviceMemoryBase> result_buffers =
-      runtime_arguments.rz_buffers.output_buffers();
+      runtime_arguments.rz_buffers->output_buffers();
 
   // Dry-run to warmup the plan.
   launch_status = RunGpuConv(config, operand_buffers, result_buffers,
@@ -695,7 +723,7 @@ absl::StatusOr<AutotuneResult> GpuConvAlgorithmPicker::AutotuneOneConvRunner(
   // Check for writes to redzones.
   TF_ASSIGN_OR_RETURN(
       bool input_output_allocator_redzone_clear,
-      CheckRedzones(runtime_arguments.rz_buffers.RedzoneAllocator(), stream,
+      CheckRedzones(runtime_arguments.rz_buffers->RedzoneAllocator(), stream,
                     "input/output", instr_str, &result));
 
   TF_ASSIGN_OR_RETURN(
@@ -743,7 +771,7 @@ absl::StatusOr<AutotuneResult> GpuConvAlgorithmPicker::AutotuneOneConvRunner(
       // array. If there are multiple outputs, the output shape is a tuple, in
       // which case get the shape of the i-th element.
       Shape output_shape = MaybeTupleElementShape(
-          runtime_arguments.rz_buffers.output_shape(), i);
+          runtime_arguments.rz_buffers->output_shape(), i);
       XLA_SCOPED_LOGGING_TIMER_LEVEL("BufferComparator::CompareEqual", 2);
       BufferComparator comparator(output_shape,
                                   debug_options.xla_gpu_autotune_gemm_rtol());
@@ -778,18 +806,22 @@ absl::StatusOr<AutotuneResult> GpuConvAlgorithmPicker::AutotuneOneConvRunner(
     }
   } else {
     XLA_SCOPED_LOGGING_TIMER_LEVEL("Memcpy Reference Result", 2);
+    auto reference_allocator = std::make_unique<se::RedzoneAllocator>(
+        stream, config_.GetAllocator(),
+        /*memory_limit=*/std::numeric_limits<int64_t>::max(),
+        /*redzone_size=*/0);
     std::vector<DeviceMemoryBase> reference_result_buffers(
         result_buffers.size());
     for (int i = 0; i < result_buffers.size(); ++i) {
       TF_ASSIGN_OR_RETURN(
           reference_result_buffers[i],
-          runtime_arguments.rz_buffers.RedzoneAllocator().AllocateBytes(
-              result_buffers[i].size()));
+          reference_allocator->AllocateBytes(result_buffers[i].size()));
       TF_RETURN_IF_ERROR(stream->Memcpy(&reference_result_buffers[i],
                                         result_buffers[i],
                                         result_buffers[i].size()));
     }
-    (*reference_result) = {alg, reference_result_buffers};
+    (*reference_result) = {alg, reference_result_buffers,
+                           std::move(reference_allocator)};
   }
 
   return result;
@@ -815,9 +847,11 @@ GpuConvAlgorithmPicker::PickBestAlgorithmNoCacheCuda(
   }
 
   std::vector<AlgorithmDesc> disabled_algos;
-  TF_ASSIGN_OR_RETURN(
-      AutotuneRuntimeArguments runtime_arguments,
-      AutotuneRuntimeArguments::FromInstruction(instr, config_, debug_options));
+  TF_ASSIGN_OR_RETURN(std::shared_ptr<const RedzoneBuffers> rz_buffers,
+                      GetRedzoneBuffers(instr, debug_options));
+  TF_ASSIGN_OR_RETURN(AutotuneRuntimeArguments runtime_arguments,
+                      AutotuneRuntimeArguments::FromInstruction(
+                          instr, config_, std::move(rz_buffers)));
   if (runtime_arguments.canonical_hlo.has_value()) {
     disabled_algos = GetDisabledConvAlgorithms(
         GetComputeCapability(stream_exec), GetCudnnVersion(stream_exec),
@@ -890,10 +924,10 @@ GpuConvAlgorithmPicker::PickBestAlgorithmNoCacheCuda(
       for (int i = 0; i < instr->operand_count(); i++) {
         *instr_log.add_operand_shapes() = instr->operand(i)->shape().ToProto();
         instr_log.add_operand_addresses(reinterpret_cast<uint64_t>(
-            runtime_arguments.rz_buffers.input_buffers()[i].opaque()));
+            runtime_arguments.rz_buffers->input_buffers()[i].opaque()));
       }
       for (se::DeviceMemoryBase result_buffer :
-           runtime_arguments.rz_buffers.output_buffers()) {
+           runtime_arguments.rz_buffers->output_buffers()) {
         instr_log.add_result_addresses(
             reinterpret_cast<uint64_t>(result_buffer.opaque()));
       }
@@ -1157,23 +1191,6 @@ absl::StatusOr<bool> GpuConvAlgorithmPicker::RunOnInstruction(
   return true;
 }
 
-absl::StatusOr<bool> GpuConvAlgorithmPicker::RunOnComputation(
-    HloComputation* computation) {
-  std::vector<HloInstruction*> convs;
-  for (HloInstruction* instr : computation->instructions()) {
-    if (IsCandidate(instr)) {
-      convs.push_back(instr);
-    }
-  }
-
-  bool changed = false;
-  for (HloInstruction* instr : convs) {
-    TF_ASSIGN_OR_RETURN(bool result, RunOnInstruction(instr));
-    changed |= result;
-  }
-  return changed;
-}
-
 absl::StatusOr<bool> GpuConvAlgorithmPicker::Run(
     HloModule* module,
     const absl::flat_hash_set<absl::string_view>& execution_threads) {
@@ -1186,10 +1203,37 @@ absl::StatusOr<bool> GpuConvAlgorithmPicker::Run(
     return false;
   }
 
-  bool changed = false;
+  std::vector<HloInstruction*> convs;
   for (HloComputation* computation :
        module->MakeNonfusionComputations(execution_threads)) {
-    TF_ASSIGN_OR_RETURN(bool result, RunOnComputation(computation));
+    for (HloInstruction* instr : computation->instructions()) {
+      if (IsCandidate(instr)) {
+        convs.push_back(instr);
+      }
+    }
+  }
+
+  // Autotune convolutions of the same shape class back to back, so that they
+  // can reuse the input/output buffers of the previous one.
+  std::vector<std::string> keys;
+  keys.reserve(convs.size());
+  for (const HloInstruction* instr : convs) {
+    keys.push_back(RedzoneBuffersKey(*instr));
+  }
+  std::vector<int> order(convs.size());
+  absl::c_iota(order, 0);
+  absl::c_stable_sort(order, [&](int a, int b) { return keys[a] < keys[b]; });
+
+#if (defined(GOOGLE_CUDA) && GOOGLE_CUDA)
+  absl::Cleanup release_redzone_buffers = [this] {
+    redzone_buffers_ = nullptr;
+    redzone_buffers_key_.clear();
+  };
+#endif
+
+  bool changed = false;
+  for (int i : order) {
+    TF_ASSIGN_OR_RETURN(bool result, RunOnInstruction(convs[i]));
     changed |= result;
   }
   return changed;
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef XLA_SERVICE_GPU_AUTOTUNING_CONV_ALGORITHM_PICKER_H_
 #define XLA_SERVICE_GPU_AUTOTUNING_CONV_ALGORITHM_PICKER_H_
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -100,7 +101,6 @@ class GpuConvAlgorithmPicker : public HloModulePass {
       const absl::flat_hash_set<absl::string_view>& execution_threads) override;
 
  private:
-  absl::StatusOr<bool> RunOnComputation(HloComputation* computation);
   absl::StatusOr<bool> RunOnInstruction(HloInstruction* instr);
 
   absl::StatusOr<AutotuneResult> PickBestAlgorithm(
@@ -114,6 +114,9 @@ class GpuConvAlgorithmPicker : public HloModulePass {
   struct ReferenceResult {
     stream_executor::dnn::AlgorithmDesc algorithm;
     std::vector<stream_executor::DeviceMemoryBase> buffers;
+    // Owns `buffers`. Kept apart from the input/output buffers so that those
+    // can be shared between convolutions.
+    std::unique_ptr<stream_executor::RedzoneAllocator> allocator;
   };
 
   // Execution environment for autotuning. Runtime autotuning requires runtime
@@ -121,15 +124,21 @@ class GpuConvAlgorithmPicker : public HloModulePass {
   // constructed from the autotuned instruction by FromInstruction.
   struct AutotuneRuntimeArguments {
     const HloModuleConfig hlo_module_config;
-    RedzoneBuffers rz_buffers;
+    std::shared_ptr<const RedzoneBuffers> rz_buffers;
     const GpuConvConfig gpu_conv_config;
     std::optional<std::string> canonical_hlo;
 
     static absl::StatusOr<AutotuneRuntimeArguments> FromInstruction(
         const HloCustomCallInstruction* instr, const AutotuneConfig& config,
-        const DebugOptions& debug_options);
+        std::shared_ptr<const RedzoneBuffers> rz_buffers);
   };
 
+  // Returns input/output buffers for `instr`. Convolutions with the same
+  // operand and result shapes run on the same buffers, so consecutive
+  // convolutions of one shape class only allocate and initialize them once.
+  absl::StatusOr<std::shared_ptr<const RedzoneBuffers>> GetRedzoneBuffers(
+      const HloCustomCallInstruction* instr, const DebugOptions& debug_options);
+
   absl::StatusOr<AutotuneResult> AutotuneOneConvRunner(
       GenericConvRunner* runner,
       std::optional<ReferenceResult>* reference_result,
@@ -147,6 +156,14 @@ class GpuConvAlgorithmPicker : public HloModulePass {
 
  private:
   AutotuneConfig config_;
+
+#if (defined(GOOGLE_CUDA) && GOOGLE_CUDA)
+  // Buffers of the most recently autotuned shape class, see GetRedzoneBuffers.
+  // Run() visits convolutions grouped by shape class and releases the buffers
+  // when it is done, so at most one set of buffers is alive at a time.
+  std::string redzone_buffers_key_;
+  std::shared_ptr<const RedzoneBuffers> redzone_buffers_;
+#endif
 };
 
 }  // namespace gpu
@@ -27,6 +27,7 @@ limitations under the License.
 #include "xla/hlo/transforms/simplifiers/tuple_simplifier.h"
 #include "xla/service/gpu/autotuning/autotuner_util.h"
 #include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/service/gpu/cublas_cudnn.h"
 #include "xla/service/gpu/stream_executor_util.h"
 #include "xla/service/gpu/transforms/conv_rewriter.h"
 #include "xla/service/gpu/transforms/cudnn_fused_conv_rewriter.h"
@@ -141,6 +142,58 @@ ENTRY main {
   }
 }
 
+TEST_F(GpuConvAlgorithmPickerTest, SetAlgorithmForConvsOfSameShapes) {
+  // conv_a and conv_b have the same operand and result shapes and share
+  // autotuning buffers, conv_c needs its own.
+  constexpr absl::string_view kHlo = R"(
+HloModule module
+
+ENTRY main {
+  input = f32[1,8,8,16] parameter(0)
+  filter = f32[3,3,16,16] parameter(1)
+  filter_1x1 = f32[1,1,16,16] parameter(2)
+  conv_a = f32[1,8,8,16] convolution(input, filter), window={size=3x3 pad=1_1x1_1}, dim_labels=b01f_01io->b01f
+  conv_c = f32[1,8,8,16] convolution(input, filter_1x1), window={size=1x1}, dim_labels=b01f_01io->b01f
+  conv_b = f32[1,8,8,16] convolution(input, filter), window={size=3x3 pad=0_2x0_2}, dim_labels=b01f_01io->b01f
+  ROOT tuple = (f32[1,8,8,16], f32[1,8,8,16], f32[1,8,8,16]) tuple(conv_a, conv_b, conv_c)
+})";
+  TF_ASSERT_OK_AND_ASSIGN(auto m, ParseAndReturnVerifiedModule(kHlo));
+
+  se::Platform* platform = PlatformUtil::GetDefaultPlatform().value();
+  TF_ASSERT_OK_AND_ASSIGN(std::vector<se::StreamExecutor*> executors,
+                          PlatformUtil::GetStreamExecutors(platform));
+  ASSERT_GT(executors.size(), 0);
+  se::StreamExecutor* stream_exec = executors[0];
+
+  const se::GpuComputeCapability& cc = backend()
+                                           .default_stream_executor()
+                                           ->GetDeviceDescription()
+                                           .gpu_compute_capability();
+  bool changed = false;
+  TF_ASSERT_OK_AND_ASSIGN(changed, RunHloPass(ConvRewriter(cc), m.get()));
+  ASSERT_TRUE(changed);
+
+  DebugOptions opts = DefaultDebugOptionsIgnoringFlags();
+  AutotuneConfig cfg{DeviceConfig{stream_exec, nullptr}, opts};
+  TF_ASSERT_OK_AND_ASSIGN(changed,
+                          RunHloPass(GpuConvAlgorithmPicker(cfg), m.get()));
+  ASSERT_TRUE(changed);
+
+  AutotuneResults results;
+  TF_ASSERT_OK(AutotunerUtil::SerializeAutotuneResults(&results));
+  EXPECT_EQ(results.results_size(), 3);
+  for (const HloInstruction* instr : m->entry_computation()->instructions()) {
+    if (!IsCustomCallToDnnConvolution(*instr)) {
+      continue;
+    }
+    TF_ASSERT_OK_AND_ASSIGN(GpuBackendConfig gpu_config,
+                            instr->backend_config<GpuBackendConfig>());
+    EXPECT_TRUE(
+        gpu_config.cudnn_conv_backend_config().algorithm().has_workspace_size())
+        << instr->ToString();
+  }
+}
+
 TEST_F(GpuConvAlgorithmPickerTest, SetAlgorithmGraphConvF8) {
   if (!GetCudaComputeCapability().IsAtLeast(
           se::CudaComputeCapability::kHopper)) {
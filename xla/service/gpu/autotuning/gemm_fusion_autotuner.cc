@@ -19,6 +19,7 @@ limitations under the License.
 #include <array>
 #include <atomic>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <optional>
 #include <string>
@@ -72,6 +73,7 @@ limitations under the License.
 #include "xla/service/gpu/kernels/custom_kernel_fusion_pattern.h"
 #include "xla/service/gpu/matmul_indexing_utils.h"
 #include "xla/service/gpu/matmul_utils.h"
+#include "xla/service/gpu/model/gpu_performance_model_base.h"
 #include "xla/service/gpu/split_k_gemm_rewriter.h"
 #include "xla/service/gpu/stream_executor_util.h"
 #include "xla/service/gpu/transforms/custom_kernel_fusion_rewriter.h"
@@ -92,8 +94,10 @@ limitations under the License.
 #include "xla/stream_executor/device_memory_allocator.h"
 #include "xla/stream_executor/gpu/redzone_allocator.h"
 #include "xla/stream_executor/integrations/tf_allocator_adapter.h"
+#include "xla/stream_executor/platform.h"
 #include "xla/stream_executor/semantic_version.h"
 #include "xla/stream_executor/stream.h"
+#include "xla/stream_executor/stream_executor.h"
 #include "xla/tools/hlo_decomposer.h"
 #include "xla/tsl/lib/core/bits.h"
 #include "xla/tsl/platform/env.h"
@@ -870,6 +874,69 @@ void ModifyPotentiallyFailingConfig(TritonGemmConfig& config, int minBitWidth,
   }
 }
 
+namespace {
+
+// Estimates the run time of `dot` tiled with `config` from the number of
+// waves of thread blocks, the padded amount of work and the memory traffic of
+// the tiles. This is only meant to rank configs against each other.
+absl::Duration EstimateTritonGemmRunTime(
+    const HloDotInstruction& dot, const TritonGemmConfig& config,
+    const se::DeviceDescription& device_info) {
+  const DotDimensionNumbers& dims = dot.dot_dimension_numbers();
+  const Shape& lhs_shape = dot.operand(0)->shape();
+  const Shape& rhs_shape = dot.operand(1)->shape();
+  int64_t batch = 1;
+  for (int64_t dim : dims.lhs_batch_dimensions()) {
+    batch *= lhs_shape.dimensions(dim);
+  }
+  int64_t k = 1;
+  for (int64_t dim : dims.lhs_contracting_dimensions()) {
+    k *= lhs_shape.dimensions(dim);
+  }
+  const int64_t batch_k = std::max<int64_t>(batch * k, 1);
+  const int64_t m = ShapeUtil::ElementsIn(lhs_shape) / batch_k;
+  const int64_t n = ShapeUtil::ElementsIn(rhs_shape) / batch_k;
+
+  const int64_t tiles_m = CeilOfRatio<int64_t>(m, config.block_m);
+  const int64_t tiles_n = CeilOfRatio<int64_t>(n, config.block_n);
+  const int64_t k_per_block = CeilOfRatio<int64_t>(k, config.split_k);
+  const int64_t num_blocks = batch * tiles_m * tiles_n * config.split_k;
+  const int64_t num_threads_per_block =
+      config.num_warps * device_info.threads_per_warp();
+
+  // Blocks run in waves of at most one block per core.
+  const int64_t active_blocks =
+      std::min<int64_t>(num_blocks, device_info.core_count());
+  const int64_t num_waves = CeilOfRatio<int64_t>(num_blocks, active_blocks);
+  const int64_t flops_per_wave =
+      2 * config.block_m * config.block_n * k_per_block * active_blocks;
+  absl::Duration compute_time =
+      num_waves * GpuPerformanceModelBase::ComputeTime(
+                      device_info, flops_per_wave, active_blocks,
+                      num_threads_per_block);
+
+  // Every block reads its lhs and rhs tiles, and split-K blocks write partial
+  // results.
+  const PrimitiveType element_type = lhs_shape.element_type();
+  const int64_t element_bytes =
+      ShapeUtil::ByteSizeOfPrimitiveType(element_type);
+  const int64_t bytes_net =
+      ShapeUtil::ByteSizeOf(lhs_shape) + ShapeUtil::ByteSizeOf(rhs_shape);
+  const int64_t bytes_total = num_blocks * (config.block_m + config.block_n) *
+                              k_per_block * element_bytes;
+  absl::Duration memory_access_time =
+      GpuPerformanceModelBase::ReadTimeWithDRAMHeuristic(
+          device_info, num_blocks, bytes_net, bytes_total, element_type,
+          /*hbm_bandwidth_utilization_rate=*/1.0) +
+      GpuPerformanceModelBase::WriteTime(
+          device_info, ShapeUtil::ByteSizeOf(dot.shape()) * config.split_k);
+
+  return GpuPerformanceModelBase::CombineComputeAndMemoryAccessTime(
+      compute_time, memory_access_time, GpuPerformanceModelOptions::Default());
+}
+
+}  // namespace
+
 absl::StatusOr<std::vector<TritonGemmConfig>>
 GemmFusionAutotunerImpl::GenerateTritonConfigs(const HloDotInstruction& dot) {
   // Retrieve the minimum bit-width participating in the dot. This is needed
@@ -959,6 +1026,41 @@ GemmFusionAutotunerImpl::GenerateTritonConfigs(const HloDotInstruction& dot) {
     if (added.insert(config).second) {
       result_configs.push_back(config);
     }
+
+    // Persistent programs only help if there is more than one wave of tiles.
+    if (debug_options_
+            .xla_gpu_experimental_enable_persistent_triton_gemm_autotuning() &&
+        config.split_k == 1 &&
+        result_size > kCoreCount * config.block_m * config.block_n) {
+      TritonGemmConfig persistent_config = config;
+      persistent_config.is_persistent = true;
+      if (added.insert(persistent_config).second) {
+        result_configs.push_back(persistent_config);
+      }
+    }
+  }
+
+  // Only keep the configs that the performance model ranks best.
+  const int64_t max_configs =
+      debug_options_.xla_gpu_experimental_autotune_max_triton_configs();
+  if (max_configs > 0 && result_configs.size() > max_configs) {
+    const se::DeviceDescription& device_info = config_.GetDeviceDescription();
+    std::vector<std::pair<absl::Duration, TritonGemmConfig>> ranked_configs;
+    ranked_configs.reserve(result_configs.size());
+    for (const TritonGemmConfig& config : result_configs) {
+      ranked_configs.push_back(
+          {EstimateTritonGemmRunTime(dot, config, device_info), config});
+    }
+    absl::c_stable_sort(ranked_configs, [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    });
+    VLOG(2) << "Pruned " << result_configs.size() - max_configs
+            << " Triton configs for " << dot.name()
+            << " using the performance model.";
+    result_configs.clear();
+    for (int i = 0; i < max_configs; ++i) {
+      result_configs.push_back(ranked_configs[i].second);
+    }
   }
   return result_configs;
 }
@@ -1117,13 +1219,13 @@ GemmFusionAutotunerImpl::CompileAll(AutotunerCompileUtil& compile_util,
 }
 
 absl::Status GemmFusionAutotunerImpl::CompareBuffers(
-    const HloFusionInstruction& fusion,
+    const AutotuneConfig& config, const HloFusionInstruction& fusion,
     const ScopedShapedBuffer& reference_buffer,
     const ScopedShapedBuffer& buffer, AutotuneResult& res) {
   const HloInstruction& root = *fusion.called_computation_root();
   BufferComparator comparator(root.shape(),
                               debug_options_.xla_gpu_autotune_gemm_rtol());
-  TF_ASSIGN_OR_RETURN(se::Stream* const stream, config_.GetStream());
+  TF_ASSIGN_OR_RETURN(se::Stream* const stream, config.GetStream());
 
   TF_ASSIGN_OR_RETURN(
       bool outputs_match,
@@ -1157,14 +1259,14 @@ absl::StatusOr<bool> GemmFusionAutotunerImpl::CheckRedZones(
 }
 
 absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
-    AutotunerCompileUtil& compile_util, const HloFusionInstruction& fusion,
-    const ExecutableCandidate& candidate,
+    const AutotuneConfig& config, AutotunerCompileUtil& compile_util,
+    const HloFusionInstruction& fusion, const ExecutableCandidate& candidate,
     std::optional<ScopedShapedBuffer>& reference_buffer) {
-  se::StreamExecutor* stream_exec = config_.GetExecutor();
+  se::StreamExecutor* stream_exec = config.GetExecutor();
   if (!stream_exec->SynchronizeAllActivity()) {
     return Internal("Failed to synchronize GPU for autotuning.");
   }
-  TF_ASSIGN_OR_RETURN(se::Stream* const stream, config_.GetStream());
+  TF_ASSIGN_OR_RETURN(se::Stream* const stream, config.GetStream());
 
   VLOG(5) << "Trying : " << ConfigToString(candidate.config);
   AutotuneResult res = FromConfig(candidate.config);
@@ -1172,7 +1274,7 @@ absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
   const HloComputation* fusion_computation = fusion.called_computation();
   TF_ASSIGN_OR_RETURN(auto rz_buffers,
                       RedzoneBuffers::FromInstruction(
-                          *fusion_computation->FusionInstruction(), config_,
+                          *fusion_computation->FusionInstruction(), config,
                           debug_options_, RedzoneBuffers::kAllInputs));
 
   TF_ASSIGN_OR_RETURN(
@@ -1190,7 +1292,7 @@ absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
   *res.mutable_run_time() =
       tsl::proto_utils::ToDurationProto(profiling_output.duration);
 
-  if (!config_.should_check_correctness()) {
+  if (!config.should_check_correctness()) {
     return res;
   }
 
@@ -1205,7 +1307,7 @@ absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
     TF_ASSIGN_OR_RETURN(bool rz_ok, CheckRedZones(rz_buffers, res));
     if (!rz_ok) return res;
 
-    TF_RETURN_IF_ERROR(CompareBuffers(fusion, *reference_buffer,
+    TF_RETURN_IF_ERROR(CompareBuffers(config, fusion, *reference_buffer,
                                       profiling_output.output, res));
   }
   return res;
@@ -1214,6 +1316,14 @@ absl::StatusOr<AutotuneResult> GemmFusionAutotunerImpl::MeasurePerformance(
 absl::StatusOr<std::vector<AutotuneResult>> GemmFusionAutotunerImpl::Profile(
     AutotunerCompileUtil& compile_util, const HloFusionInstruction& fusion,
     absl::Span<const ExecutableCandidate> candidates) {
+  return ProfileOnDevice(config_, compile_util, fusion, candidates);
+}
+
+absl::StatusOr<std::vector<AutotuneResult>>
+GemmFusionAutotunerImpl::ProfileOnDevice(
+    const AutotuneConfig& config, AutotunerCompileUtil& compile_util,
+    const HloFusionInstruction& fusion,
+    absl::Span<const ExecutableCandidate> candidates) {
   tsl::profiler::ScopedAnnotation annotation([&] {
     return absl::StrFormat("XlaAutotunerMeasurement:#hlo_op=%s#",
                            fusion.name());
@@ -1223,7 +1333,7 @@ absl::StatusOr<std::vector<AutotuneResult>> GemmFusionAutotunerImpl::Profile(
   std::optional<ScopedShapedBuffer> reference_buffer;
   for (int i = 0; i < candidates.size(); ++i) {
     absl::StatusOr<AutotuneResult> result = MeasurePerformance(
-        compile_util, fusion, candidates[i], reference_buffer);
+        config, compile_util, fusion, candidates[i], reference_buffer);
     // Treat register allocation error gracefully. If the compilation happens
     // with the driver during execution then the error could surface here.
     // It's enough to check this once here.
@@ -1250,6 +1360,106 @@ absl::StatusOr<std::vector<AutotuneResult>> GemmFusionAutotunerImpl::Profile(
   return results;
 }
 
+namespace {
+
+// Returns configs for up to `max_count` visible devices of the same platform
+// and model as the device of `config`, excluding that device.
+std::deque<AutotuneConfig> GetOtherProfilingDeviceConfigs(
+    const AutotuneConfig& config, const DebugOptions& debug_options,
+    int64_t max_count) {
+  std::deque<AutotuneConfig> configs;
+  se::StreamExecutor* stream_exec = config.GetExecutor();
+  se::Platform* platform = stream_exec->GetPlatform();
+  for (int i = 0;
+       i < platform->VisibleDeviceCount() && configs.size() < max_count; ++i) {
+    if (i == stream_exec->device_ordinal()) continue;
+    absl::StatusOr<se::StreamExecutor*> other = platform->ExecutorForDevice(i);
+    if (!other.ok()) {
+      VLOG(1) << "Skipping device " << i
+              << " for autotuning: " << other.status();
+      continue;
+    }
+    if (AutotuneCacheKey::DeviceDescriptionToCacheKey(
+            (*other)->GetDeviceDescription()) != config.GetModelStr()) {
+      VLOG(1) << "Skipping device " << i
+              << " for autotuning: different device model.";
+      continue;
+    }
+    configs.emplace_back(DeviceConfig{*other}, debug_options);
+  }
+  return configs;
+}
+
+}  // namespace
+
+absl::StatusOr<std::vector<std::vector<AutotuneResult>>>
+GemmFusionAutotunerImpl::ProfileAll(
+    AutotunerCompileUtil& compile_util,
+    absl::Span<const std::pair<const HloFusionInstruction*,
+                               const std::vector<ExecutableCandidate>*>>
+        fusions) {
+  std::vector<std::vector<AutotuneResult>> results;
+  results.reserve(fusions.size());
+
+  const int64_t num_profiling_devices =
+      debug_options_.xla_gpu_experimental_autotune_num_profiling_devices();
+  std::deque<AutotuneConfig> other_configs;
+  if (num_profiling_devices > 1 && fusions.size() > 1) {
+    other_configs = GetOtherProfilingDeviceConfigs(
+        config_, debug_options_,
+        std::min<int64_t>(num_profiling_devices, fusions.size()) - 1);
+  }
+
+  if (other_configs.empty()) {
+    for (const auto& [fusion, candidates] : fusions) {
+      TF_ASSIGN_OR_RETURN(std::vector<AutotuneResult> fusion_results,
+                          Profile(compile_util, *fusion, *candidates));
+      results.push_back(std::move(fusion_results));
+    }
+    return results;
+  }
+
+  // Compile utils keep references to allocators owned by `other_configs`.
+  std::vector<const AutotuneConfig*> configs = {&config_};
+  std::deque<AutotunerCompileUtil> other_compile_utils;
+  std::vector<AutotunerCompileUtil*> compile_utils = {&compile_util};
+  for (const AutotuneConfig& config : other_configs) {
+    TF_ASSIGN_OR_RETURN(AutotunerCompileUtil other_compile_util,
+                        AutotunerCompileUtil::Create(config, debug_options_));
+    other_compile_utils.push_back(std::move(other_compile_util));
+    configs.push_back(&config);
+    compile_utils.push_back(&other_compile_utils.back());
+  }
+  VLOG(1) << "Profiling " << fusions.size() << " fusions on "
+          << configs.size() << " devices.";
+
+  // All candidates of a fusion are profiled on the same device, so that they
+  // are compared against the same reference buffer.
+  std::vector<absl::StatusOr<std::vector<AutotuneResult>>> device_results(
+      fusions.size());
+  tsl::thread::ThreadPool profiling_pool(
+      tsl::Env::Default(), "xla_gpu_autotune_profiling", configs.size());
+  absl::BlockingCounter counter(configs.size());
+  for (int device = 0; device < configs.size(); ++device) {
+    profiling_pool.Schedule([&, device] {
+      for (int i = device; i < fusions.size(); i += configs.size()) {
+        device_results[i] =
+            ProfileOnDevice(*configs[device], *compile_utils[device],
+                            *fusions[i].first, *fusions[i].second);
+      }
+      counter.DecrementCount();
+    });
+  }
+  counter.Wait();
+
+  for (absl::StatusOr<std::vector<AutotuneResult>>& result : device_results) {
+    TF_ASSIGN_OR_RETURN(std::vector<AutotuneResult> fusion_results,
+                        std::move(result));
+    results.push_back(std::move(fusion_results));
+  }
+  return results;
+}
+
 std::vector<TritonGemmConfig>
 GemmFusionAutotunerImpl::GetExhaustiveTritonConfigs() const {
   std::vector<TritonGemmConfig> configs;
@@ -1333,15 +1543,25 @@ absl::Status GemmFusionAutotunerImpl::Autotune(
     });
   }
 
+  std::vector<std::pair<const HloFusionInstruction*,
+                        const std::vector<ExecutableCandidate>*>>
+      fusions;
+  fusions.reserve(executable_sets.size());
+  for (const auto& [fusion, candidates] : executable_sets) {
+    fusions.push_back({fusion, &candidates});
+  }
+  TF_ASSIGN_OR_RETURN(std::vector<std::vector<AutotuneResult>> fusion_results,
+                      ProfileAll(compile_util, fusions));
+
   AutotuningLogs autotuning_logs;
   int fusion_id = 0;
-  for (const auto& [fusion, candidates] : executable_sets) {
+  for (int i = 0; i < fusions.size(); ++i) {
+    const HloFusionInstruction* fusion = fusions[i].first;
     if (debug_options_.xla_gpu_dump_autotuned_gemm_fusions()) {
       TF_RETURN_IF_ERROR(DumpOriginalFusion(compile_util, *fusion, fusion_id));
     }
 
-    TF_ASSIGN_OR_RETURN(std::vector<AutotuneResult> results,
-                        Profile(compile_util, *fusion, candidates));
+    std::vector<AutotuneResult>& results = fusion_results[i];
 
     // The reference config (if it exists) will be the first in the results,
     // due to how sorting the variants work.
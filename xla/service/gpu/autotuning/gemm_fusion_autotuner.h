@@ -167,19 +167,40 @@ class GemmFusionAutotunerImpl {
   //
   // If the candidate is not cuBLAS, this will check the redzones and compare
   // the outputs with the reference buffer.
+  //
+  // The candidate runs on the device of `config`, which must be the device of
+  // `compile_util`.
   absl::StatusOr<AutotuneResult> MeasurePerformance(
-      AutotunerCompileUtil& compile_util, const HloFusionInstruction& fusion,
-      const ExecutableCandidate& candidate,
+      const AutotuneConfig& config, AutotunerCompileUtil& compile_util,
+      const HloFusionInstruction& fusion, const ExecutableCandidate& candidate,
       std::optional<ScopedShapedBuffer>& reference_buffer);
 
+  // Profile all executables for a fusion on the device of `config`.
+  absl::StatusOr<std::vector<AutotuneResult>> ProfileOnDevice(
+      const AutotuneConfig& config, AutotunerCompileUtil& compile_util,
+      const HloFusionInstruction& fusion,
+      absl::Span<const ExecutableCandidate> candidates);
+
+  // Profile executables of all fusions in `fusions`. Fusions are distributed
+  // across local devices if
+  // `xla_gpu_experimental_autotune_num_profiling_devices` is greater than one;
+  // each fusion is profiled on a single device. Results are in the order of
+  // `fusions`.
+  absl::StatusOr<std::vector<std::vector<AutotuneResult>>> ProfileAll(
+      AutotunerCompileUtil& compile_util,
+      absl::Span<const std::pair<const HloFusionInstruction*,
+                                 const std::vector<ExecutableCandidate>*>>
+          fusions);
+
   // Checks that the redzone buffers are correct, updates `res` otherwise.
   // Returns true if the redzones are correct, false otherwise.
   absl::StatusOr<bool> CheckRedZones(const RedzoneBuffers& rz_buffers,
                                      AutotuneResult& res);
 
-  // Compares the outputs of the fusion with the reference buffer.
-  // Updates `res` if the outputs do not match.
-  absl::Status CompareBuffers(const HloFusionInstruction& fusion,
+  // Compares the outputs of the fusion with the reference buffer on the device
+  // of `config`. Updates `res` if the outputs do not match.
+  absl::Status CompareBuffers(const AutotuneConfig& config,
+                              const HloFusionInstruction& fusion,
                               const ScopedShapedBuffer& reference_buffer,
                               const ScopedShapedBuffer& buffer,
                               AutotuneResult& res);
@@ -46,7 +46,10 @@ limitations under the License.
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Support/LLVM.h"
 #include "mlir/Support/LogicalResult.h"
+#include "xla/backends/gpu/runtime/copy_thunk.h"
+#include "xla/backends/gpu/runtime/memset_thunk.h"
 #include "xla/backends/gpu/runtime/sequential_thunk.h"
+#include "xla/backends/gpu/runtime/wait_for_streams_thunk.h"
 #include "xla/hlo/analysis/hlo_dataflow_analysis.h"
 #include "xla/hlo/analysis/hlo_ordering.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -208,7 +211,22 @@ absl::StatusOr<std::unique_ptr<SequentialThunk>> LowerHlo(
     uint64_t end_usecs = tsl::Env::Default()->NowMicros();
     RecordHloToLlvmDuration(end_usecs - start_usecs);
   }
-  return ir_emitter->ConsumeThunkSequence();
+
+  std::unique_ptr<SequentialThunk> thunk_sequence =
+      ir_emitter->ConsumeThunkSequence();
+  int64_t num_removed_waits =
+      RemoveRedundantWaitForStreamsThunks(thunk_sequence->thunks());
+  VLOG(2) << "Removed " << num_removed_waits
+          << " redundant stream synchronizations from " << hlo_module->name();
+  int64_t num_merged_copies =
+      MergeAdjacentDeviceToDeviceCopyThunks(thunk_sequence->thunks());
+  VLOG(2) << "Merged " << num_merged_copies
+          << " adjacent device-to-device copies in " << hlo_module->name();
+  int64_t num_merged_memsets =
+      MergeAdjacentMemsetThunks(thunk_sequence->thunks());
+  VLOG(2) << "Merged " << num_merged_memsets << " adjacent memsets in "
+          << hlo_module->name();
+  return thunk_sequence;
 }
 
 }  // namespace
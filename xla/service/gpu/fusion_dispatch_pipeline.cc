@@ -33,6 +33,7 @@ limitations under the License.
 #include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/pattern_matcher.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/xla.pb.h"
 
 namespace xla {
@@ -110,7 +111,8 @@ bool FusionWillBeHandledBetterByTriton(
 
 HloPassPipeline FusionDispatchPipeline(
     const se::DeviceDescription& device_description,
-    HloCostAnalysis::ShapeSizeFunction shape_size_fn) {
+    HloCostAnalysis::ShapeSizeFunction shape_size_fn,
+    tsl::thread::ThreadPool* thread_pool) {
   std::function<absl::StatusOr<bool>(const HloFusionInstruction*)>
       try_rewrite_fusion_if =
           [&device_description](
@@ -131,7 +133,8 @@ HloPassPipeline FusionDispatchPipeline(
   // to make sure the pass's run is recorded in the `HloModuleMetadata`.
   HloPassPipeline pipeline("fusion-dispatch-pipeline");
   pipeline.AddPass<FusionBlockLevelRewriter>(device_description, shape_size_fn,
-                                             std::move(try_rewrite_fusion_if));
+                                             std::move(try_rewrite_fusion_if),
+                                             thread_pool);
   pipeline.AddPass<FusionDynamicMemcpyRewriter>();
   return pipeline;
 }
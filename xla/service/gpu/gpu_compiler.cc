@@ -73,6 +73,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_schedule.h"
 #include "xla/hlo/pass/hlo_pass_fix.h"
 #include "xla/hlo/pass/hlo_pass_pipeline.h"
+#include "xla/hlo/transforms/activation_offload_annotator.h"
 #include "xla/hlo/transforms/collectives/all_gather_broadcast_reorder.h"
 #include "xla/hlo/transforms/collectives/all_reduce_contiguous.h"
 #include "xla/hlo/transforms/collectives/collective_permute_combiner.h"
@@ -98,6 +99,7 @@ limitations under the License.
 #include "xla/hlo/transforms/expanders/stochastic_convert_decomposer.h"
 #include "xla/hlo/transforms/host_offload_legalize.h"
 #include "xla/hlo/transforms/host_offloader.h"
+#include "xla/hlo/transforms/literal_canonicalizer.h"
 #include "xla/hlo/transforms/operand_upcaster.h"
 #include "xla/hlo/transforms/simplifiers/algebraic_simplifier.h"
 #include "xla/hlo/transforms/simplifiers/all_reduce_folder.h"
@@ -126,6 +128,7 @@ limitations under the License.
 #include "xla/hlo/transforms/simplifiers/zero_sized_hlo_elimination.h"
 #include "xla/hlo/transforms/while_loop_trip_count_annotator.h"
 #include "xla/hlo/utils/hlo_traversal.h"
+#include "xla/literal_pool.h"
 #include "xla/maybe_owning.h"
 #include "xla/service/all_reduce_promotion.h"
 #include "xla/service/all_reduce_reassociate.h"
@@ -185,6 +188,7 @@ limitations under the License.
 #include "xla/service/gpu/transforms/all_gather_dynamic_slice_simplifier.h"
 #include "xla/service/gpu/transforms/all_gather_optimizer.h"
 #include "xla/service/gpu/transforms/all_reduce_blueconnect.h"
+#include "xla/service/gpu/transforms/all_reduce_compressor.h"
 #include "xla/service/gpu/transforms/all_reduce_splitter.h"
 #include "xla/service/gpu/transforms/async_wrapper.h"
 #include "xla/service/gpu/transforms/collective_permute_cycle_decomposer.h"
@@ -196,10 +200,12 @@ limitations under the License.
 #include "xla/service/gpu/transforms/collectives/gpu_collective_combiner_utils.h"
 #include "xla/service/gpu/transforms/collectives/reduce_scatter_combiner.h"
 #include "xla/service/gpu/transforms/command_buffer_scheduling.h"
+#include "xla/service/gpu/transforms/concurrent_fusion_stream_assigner.h"
 #include "xla/service/gpu/transforms/conv_rewriter.h"
 #include "xla/service/gpu/transforms/cudnn_custom_call_converter.h"
 #include "xla/service/gpu/transforms/custom_kernel_fusion_rewriter.h"
 #include "xla/service/gpu/transforms/dot_algorithm_rewriter.h"
+#include "xla/service/gpu/transforms/dot_batcher.h"
 #include "xla/service/gpu/transforms/dot_dimension_sorter.h"
 #include "xla/service/gpu/transforms/dot_normalizer.h"
 #include "xla/service/gpu/transforms/dot_operand_converter.h"
@@ -218,6 +224,7 @@ limitations under the License.
 #include "xla/service/gpu/transforms/pipelined_p2p_rewriter.h"
 #include "xla/service/gpu/transforms/ragged_all_to_all_canonicalizer.h"
 #include "xla/service/gpu/transforms/ragged_all_to_all_decomposer.h"
+#include "xla/service/gpu/transforms/ragged_dot_rewriter.h"
 #include "xla/service/gpu/transforms/reduce_scatter_creator.h"
 #include "xla/service/gpu/transforms/reduction_degenerate_dim_remover.h"
 #include "xla/service/gpu/transforms/reduction_dimension_grouper.h"
@@ -624,7 +631,7 @@ absl::Status RunSPMDPasses(
   if (num_partitions > 1 && hlo_module->config().use_spmd_partitioning()) {
     HloPassPipeline spmd_pipeline("spmd-partitioner");
     AddSPMDPasses(hlo_module, layout_insensitive_algsimp_opts,
-                  gpu_target_config.device_description.gpu_compute_capability(),
+                  gpu_target_config.device_description,
                   spmd_pipeline,
 #ifdef PLATFORM_GOOGLE
                   [&](HloPassPipeline& pipeline) {
@@ -667,6 +674,7 @@ absl::Status RunOptimizationPasses(
   pipeline.AddPass<TopKSplitter>();
   pipeline.AddPass<TopkSpecializer>();
   pipeline.AddPass<TopkDecomposer>();
+  pipeline.AddPass<RaggedDotRewriter>();
 
   HloPredicate upcaster_filter = [&](const HloInstruction* instr) {
     const auto* cuda_cc = std::get_if<se::CudaComputeCapability>(
@@ -690,9 +698,12 @@ absl::Status RunOptimizationPasses(
   pipeline.AddPass<SubByteNormalization>(
       SubByteNormalization::SET_ELEMENT_SIZE);
 
-  // Expand random number generation.
+  // Expand random number generation. Philox bits are generated elementwise, so
+  // that they can be fused into their consumers (e.g. dropout masks) instead
+  // of being written to and read back from device memory.
   pipeline.AddPass<RngExpander>();
-  pipeline.AddPass<RngBitGeneratorExpander>(RandomAlgorithm::RNG_PHILOX);
+  pipeline.AddPass<RngBitGeneratorExpander>(RandomAlgorithm::RNG_PHILOX,
+                                            /*elementwise_philox=*/true);
 
   if (hlo_module->config().debug_options().xla_gpu_enable_cub_radix_sort()) {
     pipeline.AddPass<SortRewriter>();
@@ -716,6 +727,12 @@ absl::Status RunOptimizationPasses(
     }
     pipeline.AddPass<ScatterExpander>(
         ScatterExpander::kEliminateIndeterministicScatters);
+  } else if (int64_t min_updates_per_index =
+                 debug_options.xla_gpu_scatter_sort_min_updates_per_index();
+             min_updates_per_index > 0) {
+    // Combine colliding updates of heavily colliding scatters up front rather
+    // than serializing atomic updates on the same rows.
+    pipeline.AddPass<ScatterDeterminismExpander>(min_updates_per_index);
   }
   // Scatters unsupported on XLA:GPU are eliminated.
   pipeline.AddPass<GpuScatterExpander>();
@@ -845,6 +862,22 @@ absl::Status RunOptimizationPasses(
     pipeline.AddPass<HloDCE>();
   }();
 
+  // Stack the remaining independent small dots that DotMerger couldn't merge
+  // because they don't share an operand. This runs outside of the fixed point
+  // pipeline so that batched dots are not batched again.
+  if (debug_options.xla_gpu_experimental_enable_dot_batching()) {
+    pipeline.AddPass<DotBatcher>(
+        /*max_size_to_merge=*/int64_t{debug_options
+                                          .xla_gpu_dot_merger_threshold_mb()}
+            << 20,
+        [](const HloInstruction* dot_a, const HloInstruction* dot_b) {
+          return dot_a->backend_config<GpuBackendConfig>()
+                     ->operation_queue_id() ==
+                 dot_b->backend_config<GpuBackendConfig>()
+                     ->operation_queue_id();
+        });
+  }
+
   // ConvertMover and ReshapeMover fight with each other: ConvertMover wants
   // to move some converts down the graph, but ReshapeMover wants to move them
   // up the graph.  As a compromise, let ReshapeMover run to a fixed point,
@@ -940,6 +973,13 @@ absl::Status RunCollectiveOptimizationPasses(
         /*should_add_loop_invariant_op_in_chain=*/true,
         /*postprocess_pipelined_ops=*/AppendPipelinedInstruction,
     };
+    // Gathered weights of the next iteration are live while the current
+    // iteration computes, bound the extra memory if requested.
+    if (int64_t limit =
+            debug_options.xla_gpu_pipelined_all_gather_memory_limit_bytes();
+        limit > 0) {
+      config.max_pipelined_bytes_per_loop = limit;
+    }
     collectives_pipeline.AddPass<CollectivePipeliner>(config);
   }
   if (debug_options.xla_gpu_enable_pipelined_collectives() ||
@@ -969,6 +1009,13 @@ absl::Status RunCollectiveOptimizationPasses(
 
   collectives_pipeline.AddPass<ReduceScatterCreator>();
 
+  // Trades all-reduce precision for bandwidth. Runs after reduce-scatters were
+  // created, so that only all-reduces that are fully materialized are
+  // compressed.
+  if (debug_options.xla_gpu_experimental_enable_compressed_all_reduce()) {
+    collectives_pipeline.AddPass<AllReduceCompressor>(BF16);
+  }
+
   DebugOptions::PipelineParallelismOptLevel pipeline_parallelism_opt_level =
       debug_options.xla_gpu_experimental_pipeline_parallelism_opt_level();
   if (pipeline_parallelism_opt_level ==
@@ -1052,6 +1099,17 @@ absl::Status RunLayoutAssignmentPasses(
   // Layout assignment uses alias analysis, which requires the call graph to
   // be flattened.
   pipeline.AddPass<FlattenCallGraph>();
+  // Annotations for automatic activation offloading must be in place before
+  // layout assignment, like user provided ones.
+  const DebugOptions& debug_options = hlo_module->config().debug_options();
+  if (debug_options
+          .xla_gpu_experimental_activation_offloading_min_size_bytes() > 0) {
+    ActivationOffloadAnnotator::Options offload_options;
+    offload_options.min_size_in_bytes =
+        debug_options
+            .xla_gpu_experimental_activation_offloading_min_size_bytes();
+    pipeline.AddPass<ActivationOffloadAnnotator>(offload_options);
+  }
   ChannelLayoutConstraints layout_constraints;
   pipeline.AddPass<GpuLayoutAssignment>(
       hlo_module->mutable_entry_computation_layout(), gpu_version, dnn_version,
@@ -1067,6 +1125,10 @@ absl::Status RunLayoutAssignmentPasses(
   pipeline.AddPass<HostOffloadLegalize>(
       static_cast<int64_t>(stream_executor::MemoryType::kHost),
       /* after_layout= */ true);
+  // Canonicalize all literals larger than 1024 bytes in the module to reuse
+  // the same literal across multiple HLO modules.
+  pipeline.AddPass<LiteralCanonicalizer>(LiteralPool::Default(),
+                                         /*min_size_bytes=*/1024);
   return pipeline.Run(hlo_module).status();
 }
 
@@ -1175,7 +1237,12 @@ absl::Status RunPostFusionPasses(
           .debug_options()
           .xla_gpu_all_reduce_blueconnect_num_devices_per_host();
   if (blueconnect_num_devices_per_host > 0) {
-    pipeline.AddPass<AllReduceBlueConnect>(blueconnect_num_devices_per_host);
+    pipeline.AddPass<AllReduceBlueConnect>(
+        blueconnect_num_devices_per_host,
+        /*min_decomposition_bytes=*/
+        hlo_module->config()
+            .debug_options()
+            .xla_gpu_all_reduce_blueconnect_min_bytes());
   }
 
   AddDoubleBufferingPasses(*hlo_module, pipeline);
@@ -1199,9 +1266,16 @@ absl::Status RunPostFusionSimplificationPasses(
   pipeline.AddPass<HloComputationDeduplicator>(
       /*mark_fusion_duplications=*/true);
 
-  if (hlo_module->config()
-          .debug_options()
-          .xla_gpu_multi_streamed_windowed_einsum()) {
+  const DebugOptions& debug_options = hlo_module->config().debug_options();
+  if (debug_options.xla_gpu_experimental_enable_concurrent_fusions()) {
+    // Spread independent small fusions across the same number of compute
+    // streams that ExecutionStreamAssignment uses for async computations.
+    pipeline.AddPass<ConcurrentFusionStreamAssigner>(
+        gpu_target_config.device_description,
+        ExecutionStreamAssignmentOptions().number_of_execution_streams);
+  }
+  if (debug_options.xla_gpu_multi_streamed_windowed_einsum() ||
+      debug_options.xla_gpu_experimental_enable_concurrent_fusions()) {
     pipeline.AddPass<StreamAttributeAnnotator>(
         gpu_target_config.device_description);
     pipeline.AddPass<StreamAttributeAsyncWrapper>();
@@ -1828,8 +1902,15 @@ absl::StatusOr<std::unique_ptr<HloModule>> GpuCompiler::RunHloPasses(
   if (cuda_cc != nullptr && cuda_cc->IsAtLeastAmpere()) {
     // This needs to run after every pass affecting fusions, which includes
     // `CopyFusion`, which runs just before.
+    MaybeOwningThreadPool thread_pool = CreateMaybeOwningThreadPool(
+        /*parallelism=*/module->config()
+            .debug_options()
+            .xla_gpu_force_compilation_parallelism(),
+        /*default_thread_pool=*/options.thread_pool,
+        /*default_parallelism=*/1);
     TF_RETURN_IF_ERROR(
-        FusionDispatchPipeline(device_description, ShapeSizeBytesFunction())
+        FusionDispatchPipeline(device_description, ShapeSizeBytesFunction(),
+                               thread_pool.get_mutable())
             .Run(module.get())
             .status());
   }
@@ -35,6 +35,7 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
@@ -56,6 +57,7 @@ limitations under the License.
 #include "xla/service/gpu/buffer_allocations.h"
 #include "xla/service/gpu/gpu_constants.h"
 #include "xla/service/gpu/gpu_executable_run_options.h"
+#include "xla/service/gpu/metrics.h"
 #include "xla/service/gpu/resource_requests.h"
 #include "xla/service/gpu/stream_executor_util.h"
 #include "xla/service/hlo_value.h"
@@ -195,6 +197,36 @@ absl::Status RendezvousAfterInitialization(
     const ServiceExecutableRunOptions* run_options,
     const DebugOptions* debug_options);
 
+// Executes top-level thunks of the `thunk_sequence` one by one and records the
+// device time of each of them. Every thunk is timed with events recorded on
+// the main stream, and the host waits for the thunk to complete before
+// launching the next one, so the work that thunks launch on other streams is
+// attributed only if it's joined back into the main stream.
+absl::Status ExecuteThunksWithTiming(absl::string_view module_name,
+                                     SequentialThunk& thunk_sequence,
+                                     const Thunk::ExecuteParams& params) {
+  for (const std::unique_ptr<Thunk>& thunk : thunk_sequence.thunks()) {
+    if (params.mock_collectives && thunk->IsCollective()) {
+      continue;
+    }
+    std::optional<tsl::profiler::ScopedAnnotation> annotation =
+        GetKernelAnnotation(thunk->profile_annotation());
+
+    TF_ASSIGN_OR_RETURN(
+        std::unique_ptr<se::EventBasedTimer> timer,
+        params.stream->CreateEventBasedTimer(/*use_delay_kernel=*/false));
+    TF_RETURN_IF_ERROR(thunk->ExecuteOnStream(params));
+    TF_ASSIGN_OR_RETURN(absl::Duration elapsed, timer->GetElapsedDuration());
+
+    absl::string_view thunk_name = thunk->profile_annotation().empty()
+                                       ? Thunk::KindToString(thunk->kind())
+                                       : thunk->profile_annotation();
+    RecordThunkExecutionDuration(module_name, thunk_name,
+                                 absl::ToInt64Microseconds(elapsed));
+  }
+  return absl::OkStatus();
+}
+
 absl::Status ExecuteThunksImpl(
     const DebugOptions* debug_options, const std::string& module_name,
     ModuleIdentifier module_id, SequentialThunk& thunk_sequence,
@@ -347,10 +379,24 @@ absl::Status ExecuteThunksImpl(
 
   VLOG(1) << "[" << run_options->device_ordinal() << "] "
           << "Start GpuExecutable::ExecuteOnStream module: " << module_name;
-  TF_RETURN_IF_ERROR(thunk_sequence.ExecuteOnStream(execute_params));
+  if (debug_options && debug_options->xla_gpu_enable_thunk_timing()) {
+    TF_RETURN_IF_ERROR(
+        ExecuteThunksWithTiming(module_name, thunk_sequence, execute_params));
+  } else {
+    TF_RETURN_IF_ERROR(thunk_sequence.ExecuteOnStream(execute_params));
+  }
   VLOG(1) << "[" << run_options->device_ordinal() << "] "
           << "End GpuExecutable::ExecuteOnStream module: " << module_name;
 
+  // Temporary buffers are deallocated in the order of the main stream, and
+  // stream-ordered allocators (i.e. cudaMallocAsync) can hand out the freed
+  // memory to the next allocation right away. Join all additional compute
+  // streams into the main stream, so that the memory is not reused while
+  // kernels launched on them can still access it.
+  for (auto& [stream_id, stream] : execute_params.additional_compute_streams) {
+    TF_RETURN_IF_ERROR(main_stream->WaitFor(stream));
+  }
+
   return MaybeSyncAndProfile(run_options, execution_timer.get(),
                              block_host_until_done ? main_stream : nullptr);
 }
@@ -55,6 +55,7 @@ limitations under the License.
 #include "xla/service/gpu/gpu_latency_hiding_scheduler.h"
 #include "xla/service/gpu/ir_emission_utils.h"
 #include "xla/service/gpu/model/analytical_latency_estimator.h"
+#include "xla/service/gpu/model/collective_interpolator.h"
 #include "xla/service/gpu/model/sol_latency_estimator.h"
 #include "xla/service/gpu/transforms/async_collective_annotator.h"
 #include "xla/service/gpu/transforms/collectives/collective_ops_utils.h"
@@ -515,9 +516,26 @@ std::unique_ptr<LatencyEstimator> GetLatencyEstimator(
 
   if (options.xla_gpu_enable_analytical_sol_latency_estimator()) {
     LOG(INFO) << "Using Speed-of-Light (SoL) analytical latency estimator";
+    // Prefer measured collective latencies over the SoL model if collective
+    // perf tables are available.
+    std::unique_ptr<CollectiveInterpolator> collective_interpolator;
+    if (const std::string& perf_table_path =
+            options.xla_gpu_experimental_collective_perf_table_path();
+        !perf_table_path.empty()) {
+      absl::StatusOr<std::unique_ptr<CollectiveInterpolator>> interpolator =
+          CollectiveInterpolator::Create(perf_table_path, gpu_device_info);
+      if (interpolator.ok()) {
+        LOG(INFO) << "Using collective perf table: " << perf_table_path;
+        collective_interpolator = *std::move(interpolator);
+      } else {
+        LOG(WARNING) << "Failed to load collective perf table "
+                     << perf_table_path << ": " << interpolator.status();
+      }
+    }
     return std::make_unique<SolLatencyEstimator>(
         config, std::move(gpu_latency_estimator), gpu_device_info,
-        ShapeSizeBytesFunction(pointer_size), module.entry_computation());
+        ShapeSizeBytesFunction(pointer_size), module.entry_computation(),
+        collective_interpolator.get());
   }
   return gpu_latency_estimator;
 }
@@ -0,0 +1,115 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/gpu_spmd_partitioner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/log/log.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/call_graph.h"
+#include "xla/service/gpu/model/gpu_collective_performance_model.h"
+#include "xla/service/gpu/model/gpu_performance_model_base.h"
+#include "xla/service/gpu/model/sol_gpu_cost_model.h"
+#include "xla/service/hlo_cost_analysis.h"
+#include "xla/service/spmd/spmd_partitioner.h"
+#include "xla/shape_util.h"
+#include "xla/stream_executor/device_description.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla {
+namespace gpu {
+
+double GpuSpmdPartitioningVisitor::GetComputationTimeInMilliSec(
+    HloInstruction* hlo) {
+  const Shape& lhs_shape = hlo->operand(0)->shape();
+  const Shape& rhs_shape = hlo->operand(1)->shape();
+  int64_t flops;
+  if (hlo->opcode() == HloOpcode::kDot) {
+    flops = HloCostAnalysis::GetDotFlops(lhs_shape, hlo->shape(),
+                                         hlo->dot_dimension_numbers());
+  } else if (hlo->opcode() == HloOpcode::kConvolution) {
+    flops = HloCostAnalysis::GetConvolutionFlops(hlo, lhs_shape, rhs_shape,
+                                                 hlo->shape());
+  } else {
+    return 0.0;
+  }
+
+  // The partitioned dot is large enough to occupy the whole device, so its
+  // runtime is bounded by either the peak flops or the memory bandwidth.
+  absl::Duration compute_time = GpuPerformanceModelBase::ComputeTime(
+      device_info_, flops, /*num_blocks=*/device_info_.core_count(),
+      /*num_threads_per_block=*/device_info_.fpus_per_core());
+  int64_t bytes_accessed = ShapeUtil::ByteSizeOf(lhs_shape) +
+                           ShapeUtil::ByteSizeOf(rhs_shape) +
+                           ShapeUtil::ByteSizeOf(hlo->shape());
+  absl::Duration memory_time = absl::Seconds(
+      1.0 * bytes_accessed / device_info_.memory_bandwidth());
+  return absl::ToDoubleMilliseconds(std::max(compute_time, memory_time));
+}
+
+double GpuSpmdPartitioningVisitor::GetCommunicationTimeInMilliSec(
+    int64_t bytes, absl::Span<const ReplicaGroup> device_groups) {
+  int64_t num_devices = device_groups.empty()
+                            ? num_partitions()
+                            : device_groups[0].replica_ids_size();
+  if (num_devices < 2) {
+    return 0.0;
+  }
+
+  absl::Duration time =
+      GpuPerformanceWithCollectiveModel::kNcclKernelLaunchOverhead;
+  int64_t gpus_per_node = sol_config_.gpus_per_node;
+  if (gpus_per_node > 0 && num_devices > gpus_per_node) {
+    int num_nodes = (num_devices + gpus_per_node - 1) / gpus_per_node;
+    time += SolGPUCostModel(sol_config_)
+                .RingLatency(bytes, num_nodes,
+                             SolGPUCostModel::CollectiveType::kAllGather);
+  } else {
+    // A ring all-gather sends (n - 1) / n of the buffer over every link.
+    double bus_bandwidth_gbps =
+        GpuPerformanceWithCollectiveModel::GetNvlinkBw(
+            device_info_.cuda_compute_capability()) *
+        GpuPerformanceWithCollectiveModel::kMaxNumChannelsRing *
+        GpuPerformanceWithCollectiveModel::kRingAlgorithmDiscountFactor;
+    double bytes_on_link = 1.0 * bytes * (num_devices - 1) / num_devices;
+    time += absl::Seconds(bytes_on_link / (bus_bandwidth_gbps * 1e9));
+  }
+  VLOG(3) << "Estimated communication time for " << bytes << " bytes across "
+          << num_devices << " devices: " << time;
+  return absl::ToDoubleMilliseconds(time);
+}
+
+std::unique_ptr<spmd::SpmdPartitioningVisitor>
+GpuSpmdPartitioner::CreateVisitor(
+    HloComputation* computation, int64_t num_partitions, int64_t num_replicas,
+    const spmd::SPMDCollectiveOpsCreator& collective_ops_creator,
+    int64_t* next_channel_id, spmd::SpmdLogger* logger,
+    spmd::SpmdPartitionerOptions options, const CallGraph& call_graph) {
+  return std::make_unique<GpuSpmdPartitioningVisitor>(
+      computation, num_partitions, num_replicas, collective_ops_creator,
+      next_channel_id, logger, std::move(options), this, call_graph,
+      device_info_, SolGPUCostModel::GetConfig(computation->parent()));
+}
+
+}  // namespace gpu
+}  // namespace xla
@@ -0,0 +1,108 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_GPU_SPMD_PARTITIONER_H_
+#define XLA_SERVICE_GPU_GPU_SPMD_PARTITIONER_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/service/call_graph.h"
+#include "xla/service/gpu/model/sol_gpu_cost_model.h"
+#include "xla/service/spmd/spmd_partitioner.h"
+#include "xla/service/spmd/stateful_rng_spmd_partitioner.h"
+#include "xla/stream_executor/device_description.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla {
+namespace gpu {
+
+// SPMD partitioning visitor that estimates the cost of partitioned dots and
+// their collectives with GPU performance models. The dot handler uses these
+// estimates to decide whether windowed einsum loops can hide their
+// communication behind compute and which loop variant is the fastest.
+class GpuSpmdPartitioningVisitor
+    : public spmd::StatefulRngSpmdPartitioningVisitor {
+ public:
+  GpuSpmdPartitioningVisitor(
+      HloComputation* computation, int64_t num_partitions, int64_t num_replicas,
+      const spmd::SPMDCollectiveOpsCreator& collective_ops_creator,
+      int64_t* next_channel_id, spmd::SpmdLogger* logger,
+      spmd::SpmdPartitionerOptions options, spmd::SpmdPartitioner* partitioner,
+      const CallGraph& call_graph, const se::DeviceDescription& device_info,
+      const SolGPUCostModel::Config& sol_config)
+      : spmd::StatefulRngSpmdPartitioningVisitor(
+            computation, num_partitions, num_replicas, collective_ops_creator,
+            next_channel_id, logger, std::move(options), partitioner,
+            call_graph),
+        device_info_(device_info),
+        sol_config_(sol_config) {}
+
+  // Returns the roofline time of a dot or convolution.
+  double GetComputationTimeInMilliSec(HloInstruction* hlo) override;
+
+  // Returns the time of an all-gather of `bytes` within `device_groups`. Uses
+  // the speed-of-light model for collectives that span several nodes and the
+  // NVLink bandwidth otherwise.
+  double GetCommunicationTimeInMilliSec(
+      int64_t bytes, absl::Span<const ReplicaGroup> device_groups) override;
+
+ private:
+  const se::DeviceDescription& device_info_;
+  SolGPUCostModel::Config sol_config_;
+};
+
+// SPMD partitioner that picks dot partitioning strategies with the GPU
+// performance models, see GpuSpmdPartitioningVisitor.
+class GpuSpmdPartitioner : public spmd::StatefulRngSpmdPartitioner {
+ public:
+  GpuSpmdPartitioner(
+      int64_t num_partitions, int64_t num_replicas,
+      const se::DeviceDescription& device_info,
+      int64_t threshold_for_windowed_einsum_mib = 100000,
+      bool windowed_einsum_use_multiple_streams = false,
+      bool skip_checking_windowed_einsum_users = false,
+      bool disable_ag_rewrite_for_multiple_consumers = false,
+      std::optional<int64_t> total_bytes_windowed_einsum_threshold =
+          std::nullopt)
+      : spmd::StatefulRngSpmdPartitioner(
+            num_partitions, num_replicas, threshold_for_windowed_einsum_mib,
+            windowed_einsum_use_multiple_streams,
+            skip_checking_windowed_einsum_users,
+            disable_ag_rewrite_for_multiple_consumers,
+            total_bytes_windowed_einsum_threshold),
+        device_info_(device_info) {}
+
+ protected:
+  std::unique_ptr<spmd::SpmdPartitioningVisitor> CreateVisitor(
+      HloComputation* computation, int64_t num_partitions, int64_t num_replicas,
+      const spmd::SPMDCollectiveOpsCreator& collective_ops_creator,
+      int64_t* next_channel_id, spmd::SpmdLogger* logger,
+      spmd::SpmdPartitionerOptions options,
+      const CallGraph& call_graph) override;
+
+ private:
+  se::DeviceDescription device_info_;
+};
+
+}  // namespace gpu
+}  // namespace xla
+
+#endif  // XLA_SERVICE_GPU_GPU_SPMD_PARTITIONER_H_
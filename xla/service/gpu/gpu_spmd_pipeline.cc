@@ -34,6 +34,7 @@ limitations under the License.
 #include "xla/hlo/transforms/simplifiers/tuple_simplifier.h"
 #include "xla/service/conditional_simplifier.h"
 #include "xla/service/gather_expander.h"
+#include "xla/service/gpu/gpu_spmd_partitioner.h"
 #include "xla/service/gpu/transforms/algebraic_simplifier.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/service/scatter_expander.h"
@@ -44,6 +45,7 @@ limitations under the License.
 #include "xla/service/while_loop_constant_sinking.h"
 #include "xla/service/while_loop_simplifier.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/xla.pb.h"
 
 namespace xla {
 namespace gpu {
@@ -51,12 +53,14 @@ namespace gpu {
 void AddSPMDPasses(
     const HloModule* hlo_module,
     const AlgebraicSimplifierOptions& layout_insensitive_algsimp_opts,
-    const se::GpuComputeCapability& compute_capability,
+    const se::DeviceDescription& device_description,
     HloPassPipeline& spmd_pipeline,
     std::optional<const absl::FunctionRef<void(HloPassPipeline&)>>
         auto_sharding_func) {
   const int64_t num_partitions = hlo_module->config().num_partitions();
   CHECK_GE(num_partitions, 1);
+  const se::GpuComputeCapability& compute_capability =
+      device_description.gpu_compute_capability();
 
   HloPassPipeline& spmd_simplify =
       spmd_pipeline.AddPass<HloPassFix<HloPassPipeline>>("spmd-simplify");
@@ -111,16 +115,25 @@ void AddSPMDPasses(
             .debug_options()
             .xla_gpu_operand_bytes_threshold_for_windowed_einsum();
   }
-  spmd_pipeline.AddPass<spmd::StatefulRngSpmdPartitioner>(
-      num_partitions, hlo_module->config().replica_count(),
-      hlo_module->config()
-          .debug_options()
-          .xla_gpu_threshold_for_windowed_einsum_mib(),
-      hlo_module->config()
-          .debug_options()
-          .xla_gpu_multi_streamed_windowed_einsum(),
-      /*skip_checking_windowed_einsum_users=*/true,
-      /*disable_ag_rewrite_for_multiple_consumers=*/true, oper_size_threshold);
+  const DebugOptions& debug_options = hlo_module->config().debug_options();
+  if (debug_options.xla_gpu_experimental_enable_spmd_dot_cost_model()) {
+    spmd_pipeline.AddPass<GpuSpmdPartitioner>(
+        num_partitions, hlo_module->config().replica_count(),
+        device_description,
+        debug_options.xla_gpu_threshold_for_windowed_einsum_mib(),
+        debug_options.xla_gpu_multi_streamed_windowed_einsum(),
+        /*skip_checking_windowed_einsum_users=*/true,
+        /*disable_ag_rewrite_for_multiple_consumers=*/true,
+        oper_size_threshold);
+  } else {
+    spmd_pipeline.AddPass<spmd::StatefulRngSpmdPartitioner>(
+        num_partitions, hlo_module->config().replica_count(),
+        debug_options.xla_gpu_threshold_for_windowed_einsum_mib(),
+        debug_options.xla_gpu_multi_streamed_windowed_einsum(),
+        /*skip_checking_windowed_einsum_users=*/true,
+        /*disable_ag_rewrite_for_multiple_consumers=*/true,
+        oper_size_threshold);
+  }
   spmd_pipeline.AddPass<CollectivePermuteMotion>();
 }
 
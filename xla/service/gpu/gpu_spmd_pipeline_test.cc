@@ -28,6 +28,7 @@ limitations under the License.
 #include "xla/hlo/parser/hlo_parser.h"
 #include "xla/hlo/pass/hlo_pass_pipeline.h"
 #include "xla/hlo/transforms/simplifiers/algebraic_simplifier.h"
+#include "xla/service/gpu/gpu_device_info_for_tests.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/service/spmd/shardy/constants.h"
 #include "xla/shape_util.h"
@@ -59,9 +60,9 @@ class GpuSpmdPartitioningTest : public HloTestBase,
     }
 
     HloPassPipeline spmd_pipeline("spmd-partitioner");
-    se::CudaComputeCapability ampere(8, 0);
+    se::DeviceDescription ampere = TestGpuDeviceInfo::RTXA6000DeviceInfo(
+        se::CudaComputeCapability(8, 0));
     AlgebraicSimplifierOptions alg_simplifier_options;
-    // Ampere Core_count from tensorflow/compiler/xla/tools/hlo_opt/gpu_specs/.
     AddSPMDPasses(module.get(), alg_simplifier_options, ampere, spmd_pipeline,
                   std::nullopt);
     TF_RETURN_IF_ERROR(spmd_pipeline.Run(module.get()).status());
@@ -74,8 +75,12 @@ class GpuSpmdPartitioningTest : public HloTestBase,
 
   DebugOptions GetDebugOptionsForTest() const override {
     DebugOptions debug_options = HloTestBase::GetDebugOptionsForTest();
+    debug_options.set_xla_gpu_experimental_enable_spmd_dot_cost_model(
+        enable_dot_cost_model_);
     return debug_options;
   }
+
+  bool enable_dot_cost_model_ = false;
 };
 
 TEST_P(GpuSpmdPartitioningTest, DotWithEntryComputationLayout) {
@@ -102,6 +107,27 @@ TEST_P(GpuSpmdPartitioningTest, DotWithEntryComputationLayout) {
             ShapeUtil::MakeShapeWithDenseLayout(F32, {8, 24}, {1, 0}));
 }
 
+TEST_P(GpuSpmdPartitioningTest, WindowedEinsumWithDotCostModel) {
+  const char* const kHloModule = R"(
+  HloModule module
+
+  ENTRY main {
+    %p0 = bf16[4096,8192] parameter(0), sharding={devices=[4,1]<=[4]}
+    %p1 = bf16[8192,4096] parameter(1), sharding={devices=[1,4]<=[4]}
+    ROOT %dot = bf16[4096,4096] dot(%p0, %p1), lhs_contracting_dims={1},
+     rhs_contracting_dims={0}, sharding={devices=[1,4]<=[4]}
+  })";
+
+  enable_dot_cost_model_ = true;
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          PartitionComputation(kHloModule, /*num_devices=*/4));
+
+  // The dot is partitioned along the non-contracting dimension of the rhs and
+  // the lhs is gathered, either all at once or in a windowed einsum loop.
+  EXPECT_EQ(module->entry_computation()->root_instruction()->shape(),
+            ShapeUtil::MakeShape(BF16, {4096, 1024}));
+}
+
 std::string TestParamToString(
     const ::testing::TestParamInfo<bool>& param_info) {
   return param_info.param ? "Shardy" : "GSPMD";
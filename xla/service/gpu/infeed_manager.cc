@@ -16,20 +16,25 @@ limitations under the License.
 #include "xla/service/gpu/infeed_manager.h"
 
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <utility>
 
+#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "xla/literal.h"
 #include "xla/service/gpu/xfeed_queue.h"
 #include "xla/shape.h"
 #include "xla/shape_tree.h"
 #include "xla/shape_util.h"
-#include "xla/stream_executor/device_memory_handle.h"
+#include "xla/stream_executor/memory_allocation.h"
+#include "xla/stream_executor/stream_executor.h"
 #include "xla/util.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/statusor.h"
@@ -39,29 +44,46 @@ namespace gpu {
 
 constexpr int kMaxInfeedsInFlight = 8;
 
-InfeedManager::InfeedManager(se::StreamExecutor* executor)
-    : BlockingXfeedQueue(/*max_pending_xfeeds=*/kMaxInfeedsInFlight),
-      stream_(executor->CreateStream().value()) {
-  stream_->SetName("Infeed manager");
-}
+// Alignment of infeed buffers in the staging buffer.
+constexpr int64_t kStagingAlignment = 64;
 
-static absl::StatusOr<se::DeviceMemoryHandle> CopyBufferToDevice(
-    se::Stream* stream, int64_t size, const void* source) {
-  if (size > std::numeric_limits<int32_t>::max()) {
-    return InvalidArgument("GPU infeed of %d bytes exceeds maximum of %d bytes",
-                           size, std::numeric_limits<int32_t>::max());
+InfeedManager::InfeedManager(se::StreamExecutor* executor)
+    : BlockingXfeedQueue(/*max_pending_xfeeds=*/kMaxInfeedsInFlight) {}
+
+absl::StatusOr<std::unique_ptr<se::MemoryAllocation>>
+InfeedManager::AcquireStagingBuffer(se::StreamExecutor* executor,
+                                    int64_t size) {
+  {
+    absl::MutexLock lock(&staging_mu_);
+    auto it = absl::c_find_if(staging_buffers_, [&](const auto& staging) {
+      return staging->size() >= size;
+    });
+    if (it != staging_buffers_.end()) {
+      std::unique_ptr<se::MemoryAllocation> staging = std::move(*it);
+      staging_buffers_.erase(it);
+      return staging;
+    }
   }
 
-  if (size == 0) {
-    return InvalidArgument("Infeed shape needs 0 bytes");
-  }
+  VLOG(2) << "Allocate infeed staging buffer of " << size << " bytes";
+  return executor->HostMemoryAllocate(size);
+}
+
+void InfeedManager::ReleaseStagingBuffer(
+    std::unique_ptr<se::MemoryAllocation> staging) {
+  if (staging == nullptr) return;
 
-  se::StreamExecutor* executor = stream->parent();
-  se::DeviceMemoryHandle buffer(executor,
-                                executor->AllocateArray<uint8_t>(size));
-  TF_RETURN_IF_ERROR(stream->Memcpy(buffer.memory_ptr(), source, size));
+  absl::MutexLock lock(&staging_mu_);
+  staging_buffers_.push_back(std::move(staging));
 
-  return std::move(buffer);
+  // Pending infeeds and the one consumed by the device bound the number of
+  // staging buffers in use, drop the smallest buffers beyond that.
+  if (staging_buffers_.size() > static_cast<size_t>(kMaxInfeedsInFlight) + 1) {
+    auto smallest = absl::c_min_element(
+        staging_buffers_,
+        [](const auto& a, const auto& b) { return a->size() < b->size(); });
+    staging_buffers_.erase(smallest);
+  }
 }
 
 absl::Status InfeedManager::TransferLiteralToInfeed(
@@ -70,30 +92,42 @@ absl::Status InfeedManager::TransferLiteralToInfeed(
   VLOG(2) << "Transferring literal to infeed with shape: "
           << ShapeUtil::HumanString(literal_shape);
 
-  BlockUntilEnqueueSlotAvailable();
-
-  // For a tuple, we transfer each of its elements to the device and enqueue the
-  // resulting destination device addresses with the infeed manager.
-  ShapeTree<se::DeviceMemoryHandle> buffer_tree(literal_shape);
-  for (auto& leaf : buffer_tree.leaves()) {
+  // For a tuple, we stage each of its elements at its own offset in a single
+  // pinned host buffer.
+  ShapeTree<absl::Span<const uint8_t>> leaves(literal_shape);
+  ShapeTree<int64_t> offsets(literal_shape);
+  int64_t staging_size = 0;
+  for (auto& leaf : offsets.leaves()) {
     const Shape& sub_shape = ShapeUtil::GetSubshape(literal_shape, leaf.first);
     CHECK(sub_shape.IsArray()) << ShapeUtil::HumanStringWithLayout(sub_shape);
-    TF_ASSIGN_OR_RETURN(
-        leaf.second,
-        CopyBufferToDevice(stream(), ShapeUtil::ByteSizeOf(sub_shape),
-                           literal.untyped_data(leaf.first)));
+    int64_t size = ShapeUtil::ByteSizeOf(sub_shape);
+    if (size > std::numeric_limits<int32_t>::max()) {
+      return InvalidArgument(
+          "GPU infeed of %d bytes exceeds maximum of %d bytes", size,
+          std::numeric_limits<int32_t>::max());
+    }
+    if (size == 0) {
+      return InvalidArgument("Infeed shape needs 0 bytes");
+    }
+    leaf.second = staging_size;
+    staging_size += RoundUpTo(size, kStagingAlignment);
   }
 
-  // TODO(b/30467474): Since this stream is shared across different infeed
-  // requests, blocking on the stream might be heavy-handed. Figure out if
-  // finer-grained acknowledgement is possible.
-  absl::Status block_status = stream()->BlockHostUntilDone();
-  if (!block_status.ok()) {
-    return Internal("Failed to complete data transfer on stream %p: %s",
-                    stream(), block_status.message());
+  BlockUntilEnqueueSlotAvailable();
+
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<se::MemoryAllocation> staging,
+                      AcquireStagingBuffer(executor, staging_size));
+  uint8_t* staging_data = static_cast<uint8_t*>(staging->opaque());
+
+  for (auto& leaf : leaves.leaves()) {
+    const Shape& sub_shape = ShapeUtil::GetSubshape(literal_shape, leaf.first);
+    int64_t size = ShapeUtil::ByteSizeOf(sub_shape);
+    uint8_t* data = staging_data + offsets.element(leaf.first);
+    std::memcpy(data, literal.untyped_data(leaf.first), size);
+    leaf.second = absl::MakeConstSpan(data, size);
   }
 
-  EnqueueDestination(std::move(buffer_tree));
+  EnqueueDestination(InfeedBuffers{std::move(leaves), std::move(staging)});
   return absl::OkStatus();
 }
 
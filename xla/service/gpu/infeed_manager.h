@@ -20,13 +20,19 @@ limitations under the License.
 #ifndef XLA_SERVICE_GPU_INFEED_MANAGER_H_
 #define XLA_SERVICE_GPU_INFEED_MANAGER_H_
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "xla/literal.h"
 #include "xla/service/gpu/xfeed_queue.h"
 #include "xla/shape_tree.h"
-#include "xla/stream_executor/device_memory_handle.h"
+#include "xla/stream_executor/memory_allocation.h"
 #include "xla/stream_executor/stream_executor.h"
 
 namespace xla {
@@ -38,26 +44,44 @@ namespace gpu {
 //
 // Current limitations:
 // * Does not handle multiple devices/replicas.
-//
-// * Buffer space on GPU is allocated on every infeed enqueue request,
-// and it does not handle the case when it runs out of
-// memory. Potential solution is to pre-allocate a fixed amount of
-// memory and block when that memory is full.
+
+// Host buffers of a single infeed request, staged in pinned host memory. Infeed
+// thunks copy them directly into the destination device buffers, and must give
+// the staging buffer back with `InfeedManager::ReleaseStagingBuffer` once the
+// copies are complete.
+struct InfeedBuffers {
+  // Infeed buffers for all leaves of the infeed shape, pointing into `staging`.
+  ShapeTree<absl::Span<const uint8_t>> leaves;
+  std::unique_ptr<se::MemoryAllocation> staging;
+};
 
 // Client-side class used to enqueue infeed buffers.
-class InfeedManager
-    : public BlockingXfeedQueue<ShapeTree<se::DeviceMemoryHandle>> {
+//
+// Literals are copied into pinned host staging buffers that are recycled
+// between infeed requests, so in steady state infeeds don't allocate host or
+// device memory, and the device copy is a single DMA transfer from pinned
+// memory into the destination buffer. The number of pending infeeds (and so
+// the number of staging buffers) is bounded, and infeed requests block until
+// the device consumes earlier ones.
+class InfeedManager : public BlockingXfeedQueue<InfeedBuffers> {
  public:
   explicit InfeedManager(se::StreamExecutor* executor);
 
   absl::Status TransferLiteralToInfeed(se::StreamExecutor* executor,
                                        const LiteralSlice& literal);
 
+  // Returns a staging buffer of a consumed infeed request back to the pool.
+  void ReleaseStagingBuffer(std::unique_ptr<se::MemoryAllocation> staging);
+
  private:
-  se::Stream* stream() const { return stream_.get(); }
+  // Returns a pinned host buffer of at least `size` bytes from the pool, or
+  // allocates a new one.
+  absl::StatusOr<std::unique_ptr<se::MemoryAllocation>> AcquireStagingBuffer(
+      se::StreamExecutor* executor, int64_t size);
 
-  // Stream used to enqueue infeed device copies.
-  std::unique_ptr<se::Stream> stream_;
+  absl::Mutex staging_mu_;
+  std::vector<std::unique_ptr<se::MemoryAllocation>> staging_buffers_
+      ABSL_GUARDED_BY(staging_mu_);
 };
 
 }  // namespace gpu
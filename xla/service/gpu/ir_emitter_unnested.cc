@@ -581,7 +581,9 @@ absl::Status IrEmitterUnnested::EmitCommandBufferThunk(
       std::move(cmd_sequence), Thunk::ThunkInfo::WithProfileAnnotation(instr),
       std::move(thunk_sequence),
       ir_emitter_context_->debug_options()
-          .xla_enable_command_buffers_during_profiling()));
+          .xla_enable_command_buffers_during_profiling(),
+      ir_emitter_context_->debug_options()
+          .xla_gpu_command_buffer_cache_size()));
 
   return absl::OkStatus();
 }
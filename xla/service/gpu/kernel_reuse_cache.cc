@@ -19,11 +19,13 @@ limitations under the License.
 #include <utility>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -99,16 +101,18 @@ absl::Status KernelReuseCache::Load(const CompilationCacheProto& proto) {
           se::ClusterDim{entry.cluster_dim().x(), entry.cluster_dim().y(),
                          entry.cluster_dim().z()};
     }
-    TF_RET_CHECK(
-        cache_
-            .insert(
-                {entry.fingerprint(),
-                 Entry{name,
-                       LaunchDimensions{
-                           entry.launch_dimensions().num_blocks(),
-                           entry.launch_dimensions().num_threads_per_block()},
-                       cluster_dim, entry.shmem_bytes(), entry.binary()}})
-            .second);
+    Entry cache_entry{
+        name,
+        LaunchDimensions{entry.launch_dimensions().num_blocks(),
+                         entry.launch_dimensions().num_threads_per_block()},
+        cluster_dim, entry.shmem_bytes(), entry.binary()};
+    // A cache file shared by several compilations may have been written
+    // before deduplication by fingerprint; reuse the first kernel we see.
+    bool inserted =
+        cache_.insert({entry.fingerprint(), std::move(cache_entry)}).second;
+    if (!inserted) {
+      VLOG(5) << "Not loading duplicate kernel " << name;
+    }
   }
 
   return absl::OkStatus();
@@ -159,22 +163,42 @@ absl::Status UpdateDiskKernelCache(
     }
   }
   auto entries = disk_cache.mutable_entries();
+  // The file can be shared by compilations of different modules and by
+  // different processes, so kernels with the same fingerprint may have been
+  // stored under another name since the file was loaded.
+  absl::flat_hash_set<std::string> disk_fingerprints;
+  for (const auto& [name, entry] : *entries) {
+    disk_fingerprints.insert(entry.fingerprint());
+  }
   int stored_kernel_count = 0;
   for (const auto& [name, binary] : binaries_to_cache) {
     auto it_current = current_cache.entries().find(name);
     TF_RET_CHECK(it_current != current_cache.entries().end());
-    auto [it_disk, inserted] = entries->insert({name, it_current->second});
-    TF_RET_CHECK(inserted);
     TF_RET_CHECK(!binary.empty());
+    if (!disk_fingerprints.insert(it_current->second.fingerprint()).second) {
+      VLOG(5) << "Kernel " << name << " is already in the cache file.";
+      continue;
+    }
+    auto [it_disk, inserted] = entries->insert({name, it_current->second});
+    if (!inserted) {
+      VLOG(5) << "Not caching " << name
+              << ": the name is used by a different kernel in the cache file.";
+      continue;
+    }
     it_disk->second.set_binary(reinterpret_cast<const char*>(binary.data()),
                                binary.size());
     VLOG(5) << "Cached kernel: " << name << ": " << binary.size();
     ++stored_kernel_count;
   }
   if (stored_kernel_count > 0) {
-    TF_RETURN_IF_ERROR(tsl::WriteStringToFile(tsl::Env::Default(),
-                                              std::string(path),
+    // Write to a temporary file and rename it, so that concurrent readers
+    // never see a partially written cache file.
+    tsl::Env* env = tsl::Env::Default();
+    std::string temp_path =
+        absl::StrCat(path, ".tmp_", absl::GetCurrentTimeNanos());
+    TF_RETURN_IF_ERROR(tsl::WriteStringToFile(env, temp_path,
                                               disk_cache.SerializeAsString()));
+    TF_RETURN_IF_ERROR(env->RenameFile(temp_path, std::string(path)));
     VLOG(2) << "Stored " << stored_kernel_count << " / "
             << binaries_to_cache.size() << " kernels in the cache file.";
   }
@@ -60,7 +60,7 @@ TEST_F(KernelReuseTest, UpdatingDiskKernelCacheWorks) {
   {
     const CompilationCacheProto proto = [](std::string kernel_name) {
       KernelReuseCache cache;
-      auto [result, was_cached] = cache.GetWithStatus("fingerprint", [&]() {
+      auto [result, was_cached] = cache.GetWithStatus("fingerprint2", [&]() {
         return KernelReuseCache::Entry{.kernel_name = kernel_name};
       });
       return cache.Export();
@@ -77,6 +77,40 @@ TEST_F(KernelReuseTest, UpdatingDiskKernelCacheWorks) {
   EXPECT_EQ(proto.entries_size(), 2);
 }
 
+TEST_F(KernelReuseTest, DiskKernelCacheDeduplicatesByFingerprint) {
+  std::string cache_file_path;
+  CHECK(tsl::Env::Default()->LocalTempFilename(&cache_file_path));
+  auto export_cache = [](std::string kernel_name) {
+    KernelReuseCache cache;
+    auto [result, was_cached] = cache.GetWithStatus("fingerprint", [&]() {
+      return KernelReuseCache::Entry{.kernel_name = kernel_name};
+    });
+    return cache.Export();
+  };
+  TF_EXPECT_OK(UpdateDiskKernelCache(cache_file_path, /*do_append=*/false,
+                                     export_cache("k1"),
+                                     {{.name = "k1", .binary = {5, 6}}}));
+  // Another compilation emitted the same kernel under a different name.
+  TF_EXPECT_OK(UpdateDiskKernelCache(cache_file_path, /*do_append=*/true,
+                                     export_cache("k2"),
+                                     {{.name = "k2", .binary = {5, 6}}}));
+  std::string serialized;
+  TF_EXPECT_OK(
+      tsl::ReadFileToString(tsl::Env::Default(), cache_file_path, &serialized));
+  CompilationCacheProto proto;
+  EXPECT_TRUE(proto.ParseFromString(serialized));
+  EXPECT_EQ(proto.entries_size(), 1);
+  EXPECT_TRUE(proto.entries().contains("k1"));
+
+  KernelReuseCache cache;
+  TF_EXPECT_OK(cache.Load(proto));
+  auto [result, was_cached] = cache.GetWithStatus(
+      "fingerprint", []() { return KernelReuseCache::Entry{}; });
+  TF_EXPECT_OK(result);
+  EXPECT_TRUE(was_cached);
+  EXPECT_EQ(result.value()->kernel_name, "k1");
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
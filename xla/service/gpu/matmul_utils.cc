@@ -792,7 +792,8 @@ absl::StatusOr<se::gpu::BlasLt::Epilogue> AsBlasLtEpilogue(
 
   return TritonGemmConfig(proto.block_m(), proto.block_n(), proto.block_k(),
                           proto.split_k(), proto.num_stages(),
-                          proto.num_warps(), proto.num_ctas());
+                          proto.num_warps(), proto.num_ctas(),
+                          proto.is_persistent());
 }
 
 AutotuneResult::TritonGemmKey TritonGemmConfig::ToProto() const {
@@ -804,6 +805,7 @@ AutotuneResult::TritonGemmKey TritonGemmConfig::ToProto() const {
   key.set_num_stages(num_stages);
   key.set_num_warps(num_warps);
   key.set_num_ctas(num_ctas);
+  key.set_is_persistent(is_persistent);
   return key;
 }
 
@@ -811,7 +813,8 @@ std::string TritonGemmConfig::ToString() const {
   return absl::StrCat("{block_m:", block_m, ",block_n:", block_n,
                       ",block_k:", block_k, ",split_k:", split_k,
                       ",num_stages:", num_stages, ",num_warps:", num_warps,
-                      ",num_ctas:", num_ctas, "}");
+                      ",num_ctas:", num_ctas,
+                      is_persistent ? ",is_persistent:true" : "", "}");
 }
 
 absl::StatusOr<bool> IsMatrixMultiplicationTooSmallForRewriting(
@@ -156,14 +156,16 @@ absl::StatusOr<se::gpu::BlasLt::Epilogue> AsBlasLtEpilogue(
 struct TritonGemmConfig {
   constexpr TritonGemmConfig() = default;
   constexpr TritonGemmConfig(int block_m, int block_n, int block_k, int split_k,
-                             int num_stages, int num_warps, int num_ctas = 1)
+                             int num_stages, int num_warps, int num_ctas = 1,
+                             bool is_persistent = false)
       : block_m(block_m),
         block_n(block_n),
         block_k(block_k),
         split_k(split_k),
         num_stages(num_stages),
         num_warps(num_warps),
-        num_ctas(num_ctas) {}
+        num_ctas(num_ctas),
+        is_persistent(is_persistent) {}
   int block_m = 0;
   int block_n = 0;
   int block_k = 0;
@@ -172,6 +174,9 @@ struct TritonGemmConfig {
   int num_warps = 0;
   // Number of blocks in a block cluster.
   int num_ctas = 0;
+  // Whether to launch at most one wave of programs, each of which loops over
+  // several output tiles, instead of one program per tile.
+  bool is_persistent = false;
 
   // When adding new members, please update all methods, such as ToTuple,
   // FromProto, ToProto, ToString, etc. Updating ToTuple is not enough.
@@ -183,7 +188,7 @@ struct TritonGemmConfig {
  private:
   auto ToTuple() const {
     return std::make_tuple(block_m, block_n, block_k, split_k, num_stages,
-                           num_warps, num_ctas);
+                           num_warps, num_ctas, is_persistent);
   }
 
  public:
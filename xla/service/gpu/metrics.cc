@@ -51,6 +51,31 @@ auto* gpu_compiler_stacktrace_count = tsl::monitoring::Counter<1>::New(
     "/xla/service/gpu/compiler_stacktrace_count",
     "The number of times a compiler stacktrace was called.", "stacktrace");
 
+auto* command_buffer_update_commands = tsl::monitoring::Counter<1>::New(
+    "/xla/service/gpu/command_buffer_update_commands",
+    "The number of commands updated or skipped during command buffer updates.",
+    "status");
+
+auto* gpu_clique_creation_time_usecs_histogram =
+    tsl::monitoring::Sampler<1>::New(
+        {"/xla/service/gpu/clique_creation_time_usecs_histogram",
+         "The wall-clock time spent on creating GPU clique communicators in "
+         "microseconds.",
+         "method"},
+        // These exponential buckets cover the following range:
+        // Minimum: 1 ms
+        // Maximum: 1 ms * 2 ^ 19 == ~8.7 minutes
+        {tsl::monitoring::Buckets::Exponential(1000, 2, 20)});
+
+auto* thunk_execution_time_usecs_histogram = tsl::monitoring::Sampler<2>::New(
+    {"/xla/service/gpu/thunk_execution_time_usecs_histogram",
+     "The device time spent on executing a thunk in microseconds.", "module",
+     "thunk"},
+    // These exponential buckets cover the following range:
+    // Minimum: 1 us
+    // Maximum: 1 us * 2 ^ 29 == ~9 minutes
+    {tsl::monitoring::Buckets::Exponential(1, 2, 30)});
+
 }  // namespace
 
 void RecordHloPassesDuration(const uint64_t time_usecs) {
@@ -136,4 +161,28 @@ int GetGpuCompilerStacktraceCount(absl::string_view stacktrace) {
       ->value();
 }
 
+void RecordCommandBufferUpdate(int64_t num_updated_commands,
+                               int64_t num_skipped_commands) {
+  static auto* updated = command_buffer_update_commands->GetCell("updated");
+  static auto* skipped = command_buffer_update_commands->GetCell("skipped");
+  updated->IncrementBy(num_updated_commands);
+  skipped->IncrementBy(num_skipped_commands);
+}
+
+void RecordGpuCliqueCreationDuration(bool split, uint64_t time_usecs) {
+  static auto* create_cell =
+      gpu_clique_creation_time_usecs_histogram->GetCell("create");
+  static auto* split_cell =
+      gpu_clique_creation_time_usecs_histogram->GetCell("split");
+  (split ? split_cell : create_cell)->Add(time_usecs);
+}
+
+void RecordThunkExecutionDuration(absl::string_view module_name,
+                                  absl::string_view thunk_name,
+                                  uint64_t time_usecs) {
+  thunk_execution_time_usecs_histogram
+      ->GetCell(std::string(module_name), std::string(thunk_name))
+      ->Add(time_usecs);
+}
+
 }  // namespace xla
@@ -61,6 +61,21 @@ void RecordGpuCompilerStacktrace();
 // stacktrace.
 int GetGpuCompilerStacktraceCount(absl::string_view stacktrace);
 
+// Records the number of commands updated and skipped (because none of their
+// buffers changed) when updating a command buffer.
+void RecordCommandBufferUpdate(int64_t num_updated_commands,
+                               int64_t num_skipped_commands);
+
+// Records the wall-clock time spent on creating communicators for a GPU
+// clique, either from scratch or by splitting a parent clique.
+void RecordGpuCliqueCreationDuration(bool split, uint64_t time_usecs);
+
+// Records the device time spent on executing a thunk of the given module. Only
+// recorded when thunk timing is enabled (`xla_gpu_enable_thunk_timing`).
+void RecordThunkExecutionDuration(absl::string_view module_name,
+                                  absl::string_view thunk_name,
+                                  uint64_t time_usecs);
+
 }  // namespace xla
 
 #endif  // XLA_SERVICE_GPU_METRICS_H_
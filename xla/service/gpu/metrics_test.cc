@@ -45,6 +45,41 @@ TEST(MetricsTest, RecordsGpuCompilerStacktrace) {
       1);
 }
 
+TEST(MetricsTest, RecordsGpuCliqueCreationDuration) {
+  const std::string kGpuCliqueCreationMetricName =
+      "/xla/service/gpu/clique_creation_time_usecs_histogram";
+
+  RecordGpuCliqueCreationDuration(/*split=*/false, 1000);
+  RecordGpuCliqueCreationDuration(/*split=*/true, 100);
+
+  tsl::monitoring::CollectionRegistry::CollectMetricsOptions options;
+  std::unique_ptr<tsl::monitoring::CollectedMetrics> metrics =
+      tsl::monitoring::CollectionRegistry::Default()->CollectMetrics(options);
+
+  ASSERT_TRUE(metrics->point_set_map.find(kGpuCliqueCreationMetricName) !=
+              metrics->point_set_map.end());
+  EXPECT_EQ(metrics->point_set_map[kGpuCliqueCreationMetricName]->points.size(),
+            2);
+}
+
+TEST(MetricsTest, RecordsThunkExecutionDuration) {
+  const std::string kThunkExecutionTimeMetricName =
+      "/xla/service/gpu/thunk_execution_time_usecs_histogram";
+
+  RecordThunkExecutionDuration("module", "fusion.1", 10);
+  RecordThunkExecutionDuration("module", "fusion.1", 20);
+  RecordThunkExecutionDuration("module", "fusion.2", 30);
+
+  tsl::monitoring::CollectionRegistry::CollectMetricsOptions options;
+  std::unique_ptr<tsl::monitoring::CollectedMetrics> metrics =
+      tsl::monitoring::CollectionRegistry::Default()->CollectMetrics(options);
+
+  ASSERT_TRUE(metrics->point_set_map.find(kThunkExecutionTimeMetricName) !=
+              metrics->point_set_map.end());
+  EXPECT_EQ(
+      metrics->point_set_map[kThunkExecutionTimeMetricName]->points.size(), 2);
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstdint>
 #include <memory>
 #include <optional>
+#include <string>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
@@ -26,6 +27,7 @@ limitations under the License.
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "xla/hlo/ir/collective_device_list.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
@@ -36,6 +38,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/service/gpu/model/hlo_op_profile.pb.h"
+#include "xla/service/gpu/model/hlo_op_profiles.h"
 #include "xla/service/gpu/model/interpolator.h"
 #include "xla/service/gpu/transforms/collectives/collective_ops_utils.h"
 #include "xla/service/hlo.pb.h"
@@ -43,6 +46,7 @@ limitations under the License.
 #include "xla/shape.h"
 #include "xla/shape_util.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/tsl/platform/statusor.h"
 
@@ -272,6 +276,23 @@ CollectiveInterpolator::Create(HloInstructionProfileList profiles,
       new CollectiveInterpolator(profiles, interpolators, device_info));
 }
 
+/*static*/ absl::StatusOr<std::unique_ptr<CollectiveInterpolator>>
+CollectiveInterpolator::Create(absl::string_view perf_table_path,
+                               const se::DeviceDescription& device_info) {
+  DeviceHloInstructionProfiles profile;
+  std::string path(perf_table_path);
+
+  TF_RETURN_IF_ERROR(tsl::Env::Default()->FileExists(path));
+  TF_RETURN_IF_ERROR(
+      tsl::ReadTextOrBinaryProto(tsl::Env::Default(), path, &profile));
+  std::string key = HloOpProfiles::GetProfileName(device_info);
+
+  if (!profile.entries().contains(key)) {
+    return absl::NotFoundError(absl::StrCat("Cannot find key: ", key));
+  }
+  return Create(profile.entries().at(key), device_info);
+}
+
 std::optional<absl::Duration> CollectiveInterpolator::EstimatedRuntime(
     HloCollectiveInstruction& instr) {
   GpuHloCostAnalysis analysis(GpuHloCostAnalysis::Options(), device_info_);
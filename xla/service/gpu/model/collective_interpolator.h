@@ -23,6 +23,7 @@ limitations under the License.
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_clone_context.h"
 #include "xla/hlo/ir/hlo_instructions.h"
@@ -58,6 +59,12 @@ class CollectiveInterpolator {
       HloInstructionProfileList profiles,
       const se::DeviceDescription& device_info);
 
+  // Creates an interpolator from the profiles collected for `device_info` in
+  // the perf table stored at `perf_table_path`.
+  static absl::StatusOr<std::unique_ptr<CollectiveInterpolator>> Create(
+      absl::string_view perf_table_path,
+      const se::DeviceDescription& device_info);
+
   // Constructs the semantically correct module from the profile.
   // Usually the root instruction of the entry computation is of interest and is
   // directly related to the `profile`d information.
@@ -16,6 +16,7 @@ limitations under the License.
 #include "xla/service/gpu/model/gpu_indexing_performance_model.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <utility>
@@ -28,6 +29,8 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "absl/synchronization/blocking_counter.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "llvm/Support/MathExtras.h"
@@ -53,6 +56,7 @@ limitations under the License.
 #include "xla/stream_executor/device_description.h"
 #include "xla/tsl/platform/status.h"
 #include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
 
 namespace xla {
@@ -191,6 +195,7 @@ int64_t GpuPerformanceModelWithIndexingAnalysis::FlopsPerElement(
   // Get the FLOPs per element for elementwise operations that only depend on
   // the element type.
   if (instr->IsElementwise()) {
+    absl::MutexLock lock(&cost_analysis_mutex_);
     return cost_analysis_.GetFlopsPerElementwiseOpElement(
         instr->shape().element_type(), instr->opcode());
   }
@@ -220,6 +225,7 @@ int64_t GpuPerformanceModelWithIndexingAnalysis::FlopsPerElement(
   }
 
   // Encountered unexpected instruction, call to GpuHloCostAnalysis.
+  absl::MutexLock lock(&cost_analysis_mutex_);
   TF_CHECK_OK(
       cost_analysis_.RevisitInstruction(const_cast<HloInstruction*>(instr)));
 
@@ -595,9 +601,54 @@ GpuPerformanceModelWithIndexingAnalysis::GetLaunchDimensionsForTiledFusion(
           static_cast<uint64_t>(num_warps * WarpSize(device_info))};
 }
 
+absl::StatusOr<std::optional<TiledRunTimeData>>
+GpuPerformanceModelWithIndexingAnalysis::EstimateRunTimeForTiling(
+    const HloFusionAdaptor& fusion_adaptor,
+    const SymbolicTileAnalysis& analysis,
+    const SymbolicTileAnalysis::Tiling& tiling) {
+  // TODO(b/372454662): This needs to be adjusted if we want to support more
+  // than one "real root" (i.e. a root without users).
+  // Currently ComputeTiledHloInstructions() may fail and return an
+  // Unimplemented error for cases of multi-output fusion that we do not
+  // support yet.
+  auto maybe_tiled_hlo_computation = analysis.ComputeTiledHloInstructions(
+      tiling, /*constraints_are_known_satisfied=*/true);
+  if (!maybe_tiled_hlo_computation.ok()) {
+    if (maybe_tiled_hlo_computation.status().code() ==
+            absl::StatusCode::kUnimplemented &&
+        absl::StrContains(maybe_tiled_hlo_computation.status().message(),
+                          "multi-output fusion")) {
+      return std::nullopt;
+    }
+    return maybe_tiled_hlo_computation.status();
+  }
+
+  auto tiled_hlo_computation = std::move(maybe_tiled_hlo_computation.value());
+  LaunchDimensions launch_dimensions =
+      GetLaunchDimensionsForTiledFusion(tiled_hlo_computation, *device_info_);
+
+  TF_ASSIGN_OR_RETURN(
+      EstimateRunTimeData estimate_run_time_data,
+      EstimateRunTimeForTiledHloComputation(
+          fusion_adaptor, tiled_hlo_computation, launch_dimensions));
+
+  BlockLevelParameters block_level_parameters;
+  auto tiled_roots = tiled_hlo_computation.GetRoots();
+  block_level_parameters.output_tile_sizes.reserve(tiled_roots.size());
+  for (auto tiled_root : tiled_roots) {
+    block_level_parameters.output_tile_sizes.emplace_back(
+        tiled_root->tile_sizes().begin(), tiled_root->tile_sizes().end());
+  }
+  block_level_parameters.num_warps =
+      launch_dimensions.num_threads_per_block() / WarpSize(*device_info_);
+
+  return TiledRunTimeData{estimate_run_time_data, block_level_parameters};
+}
+
 absl::StatusOr<TiledRunTimeDataOrError>
 GpuPerformanceModelWithIndexingAnalysis::TryFindBestTilingForFusion(
-    const HloFusionAdaptor& fusion_adaptor) {
+    const HloFusionAdaptor& fusion_adaptor,
+    tsl::thread::ThreadPool* thread_pool) {
   SymbolicTileAnalysisOrError analysis_or_error =
       SymbolicTileAnalysis::AnalyzeFusion(
           fusion_adaptor, mlir_context_,
@@ -613,53 +664,64 @@ GpuPerformanceModelWithIndexingAnalysis::TryFindBestTilingForFusion(
 
   TF_ASSIGN_OR_RETURN(auto tilings, analysis.GetGoodTilings());
 
-  std::optional<TiledRunTimeData> best_tiled_run_time_data;
-
-  for (const auto& tiling : tilings) {
-    // TODO(b/372454662): This needs to be adjusted if we want to support more
-    // than one "real root" (i.e. a root without users).
-    // Currently ComputeTiledHloInstructions() may fail and return an
-    // Unimplemented error for cases of multi-output fusion that we do not
-    // support yet.
-    auto maybe_tiled_hlo_computation =
-        analysis.ComputeTiledHloInstructions(tiling);
-    if (!maybe_tiled_hlo_computation.ok()) {
-      if (maybe_tiled_hlo_computation.status().code() ==
-              absl::StatusCode::kUnimplemented &&
-          absl::StrContains(maybe_tiled_hlo_computation.status().message(),
-                            "multi-output fusion")) {
-        continue;
-      }
-      return maybe_tiled_hlo_computation.status();
+  // Tilings whose output tile doesn't fit in registers are estimated to take
+  // infinite time, so don't build their tiled computations unless there is
+  // nothing else.
+  std::vector<SymbolicTileAnalysis::Tiling> candidate_tilings;
+  candidate_tilings.reserve(tilings.size());
+  std::optional<SymbolicTileAnalysis::Tiling> first_spilling_tiling;
+  for (SymbolicTileAnalysis::Tiling& tiling : tilings) {
+    if (DoesTileFitsInRegisters(GetPaddedTileSize(tiling), *device_info_)) {
+      candidate_tilings.push_back(std::move(tiling));
+    } else if (!first_spilling_tiling.has_value()) {
+      first_spilling_tiling = std::move(tiling);
     }
+  }
 
-    auto tiled_hlo_computation = std::move(maybe_tiled_hlo_computation.value());
-    LaunchDimensions launch_dimensions =
-        GetLaunchDimensionsForTiledFusion(tiled_hlo_computation, *device_info_);
-
-    TF_ASSIGN_OR_RETURN(
-        EstimateRunTimeData estimate_run_time_data,
-        EstimateRunTimeForTiledHloComputation(
-            fusion_adaptor, tiled_hlo_computation, launch_dimensions));
+  // The estimates are independent of each other, so evaluate them in
+  // parallel if possible and pick the best one in the original order.
+  std::vector<absl::StatusOr<std::optional<TiledRunTimeData>>> estimates(
+      candidate_tilings.size());
+  auto estimate = [&](size_t i) {
+    estimates[i] = EstimateRunTimeForTiling(fusion_adaptor, analysis,
+                                            candidate_tilings[i]);
+  };
+  if (thread_pool != nullptr && candidate_tilings.size() > 1) {
+    absl::BlockingCounter counter(candidate_tilings.size());
+    for (size_t i = 0; i < candidate_tilings.size(); ++i) {
+      thread_pool->Schedule([&, i] {
+        estimate(i);
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+  } else {
+    for (size_t i = 0; i < candidate_tilings.size(); ++i) {
+      estimate(i);
+    }
+  }
 
+  std::optional<TiledRunTimeData> best_tiled_run_time_data;
+  for (absl::StatusOr<std::optional<TiledRunTimeData>>& estimate : estimates) {
+    TF_ASSIGN_OR_RETURN(std::optional<TiledRunTimeData> tiled_run_time_data,
+                        std::move(estimate));
+    if (!tiled_run_time_data.has_value()) {
+      continue;
+    }
     if (!best_tiled_run_time_data.has_value() ||
-        estimate_run_time_data.exec_time <
+        tiled_run_time_data->runtime_data.exec_time <
             best_tiled_run_time_data->runtime_data.exec_time) {
-      BlockLevelParameters block_level_parameters;
-      auto tiled_roots = tiled_hlo_computation.GetRoots();
-      block_level_parameters.output_tile_sizes.reserve(tiled_roots.size());
-      for (auto tiled_root : tiled_roots) {
-        block_level_parameters.output_tile_sizes.emplace_back(
-            tiled_root->tile_sizes().begin(), tiled_root->tile_sizes().end());
-      }
-      block_level_parameters.num_warps =
-          launch_dimensions.num_threads_per_block() / WarpSize(*device_info_);
-
-      best_tiled_run_time_data =
-          TiledRunTimeData{estimate_run_time_data, block_level_parameters};
+      best_tiled_run_time_data = std::move(tiled_run_time_data);
     }
   }
 
+  if (!best_tiled_run_time_data.has_value() &&
+      first_spilling_tiling.has_value()) {
+    TF_ASSIGN_OR_RETURN(best_tiled_run_time_data,
+                        EstimateRunTimeForTiling(fusion_adaptor, analysis,
+                                                 *first_spilling_tiling));
+  }
+
   if (!best_tiled_run_time_data.has_value()) {
     return FusionDecision::Forbid("No valid tilings found.");
   }
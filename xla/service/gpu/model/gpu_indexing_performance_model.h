@@ -18,10 +18,13 @@ limitations under the License.
 
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <variant>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "mlir/IR/MLIRContext.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -38,6 +41,7 @@ limitations under the License.
 #include "xla/service/instruction_fusion.h"
 #include "xla/shape.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/tsl/platform/threadpool.h"
 
 namespace xla {
 namespace gpu {
@@ -113,14 +117,19 @@ class GpuPerformanceModelWithIndexingAnalysis : public GpuPerformanceModelBase {
 
   // Estimates the best tile sizes for the given fusion. Iterates over all the
   // good tile sizes provided by SymbolicTileAnalysis, estimates the run time
-  // for each of them.
+  // for each of them. Tilings whose output tile doesn't fit in registers are
+  // only estimated if no other tiling is valid.
+  //
+  // If `thread_pool` is not null, the tilings are estimated on it. The calling
+  // thread must not belong to `thread_pool`.
   //
   // Returns status if there is an error that we can't recover from.
   // Returns FusionDecision if the fusion can't be tiled or there are no valid
   // block level parameters.
   // Otherwise returns block level parameters that give the best execution time.
   absl::StatusOr<TiledRunTimeDataOrError> TryFindBestTilingForFusion(
-      const HloFusionAdaptor& fusion_adaptor);
+      const HloFusionAdaptor& fusion_adaptor,
+      tsl::thread::ThreadPool* thread_pool = nullptr);
 
   // Returns an estimate how many FLOPs will be used to produce one element of
   // the output.
@@ -129,11 +138,21 @@ class GpuPerformanceModelWithIndexingAnalysis : public GpuPerformanceModelBase {
  private:
   int64_t GetShapeSizeRecursive(const Shape& shape) const;
 
+  // Returns the estimated run time and block level parameters of `fusion`
+  // tiled with `tiling`, or std::nullopt if the tiling is not supported.
+  absl::StatusOr<std::optional<TiledRunTimeData>> EstimateRunTimeForTiling(
+      const HloFusionAdaptor& fusion_adaptor,
+      const SymbolicTileAnalysis& analysis,
+      const SymbolicTileAnalysis::Tiling& tiling);
+
   const HloOpProfiles::HloOpProfile* hlo_op_profile_;
   const se::DeviceDescription* device_info_;
   HloFusionAnalysisCache* fusion_analysis_cache_;
   HloCostAnalysis::ShapeSizeFunction shape_size_;
-  GpuHloCostAnalysis cost_analysis_;
+  // Guards `cost_analysis_`, which FlopsPerElement() updates when it visits
+  // an instruction it has no closed form for.
+  absl::Mutex cost_analysis_mutex_;
+  GpuHloCostAnalysis cost_analysis_ ABSL_GUARDED_BY(cost_analysis_mutex_);
   mlir::MLIRContext* mlir_context_;
 };
 
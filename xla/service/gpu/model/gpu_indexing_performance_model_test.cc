@@ -45,6 +45,8 @@ limitations under the License.
 #include "xla/stream_executor/device_description.h"
 #include "xla/tests/hlo_test_base.h"
 #include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "tsl/platform/status_matchers.h"
 #include "tsl/platform/statusor.h"
 
@@ -499,6 +501,58 @@ ENTRY main {
       1);
 }
 
+TEST_F(GpuIndexingPerformanceModelTest,
+       EstimateBestTiling_WithThreadPool_MatchesSequentialSearch) {
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(R"(
+HloModule m
+
+add {
+  Arg_0 = f32[] parameter(0)
+  Arg_1 = f32[] parameter(1)
+  ROOT add = f32[] add(Arg_0, Arg_1)
+}
+
+triton_softmax_computation {
+  param_0 = f32[512,911]{1,0} parameter(0)
+  param_1 = f32[911]{0} parameter(1)
+  broadcast_0 = f32[512,911]{1,0} broadcast(param_1), dimensions={1}
+  multiply_0 = f32[512,911]{1,0} multiply(param_0, broadcast_0)
+  constant_0 = f32[] constant(0)
+  reduce_0 = f32[512]{0} reduce(multiply_0, constant_0), dimensions={1}, to_apply=add
+  broadcast_4 = f32[512,911]{1,0} broadcast(reduce_0), dimensions={0}
+  ROOT multiply = f32[512,911]{1,0} multiply(multiply_0, broadcast_4)
+}
+
+ENTRY main {
+  param_0 = f32[512,911]{1,0} parameter(0)
+  param_1 = f32[911]{0} parameter(1)
+  ROOT triton_softmax = f32[512,911]{1,0} fusion(param_0, param_1), kind=kCustom, calls=triton_softmax_computation, backend_config={"fusion_backend_config": {"kind":"__triton"}}
+}
+)"));
+  auto fusion_adaptor = HloFusionAdaptor::ForInstruction(
+      module->entry_computation()->root_instruction());
+
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto sequential_result,
+      indexing_cost_model_.TryFindBestTilingForFusion(*fusion_adaptor));
+  tsl::thread::ThreadPool thread_pool(tsl::Env::Default(), "test",
+                                      /*num_threads=*/4);
+  TF_ASSERT_OK_AND_ASSIGN(auto parallel_result,
+                          indexing_cost_model_.TryFindBestTilingForFusion(
+                              *fusion_adaptor, &thread_pool));
+
+  ASSERT_TRUE(std::holds_alternative<TiledRunTimeData>(sequential_result));
+  ASSERT_TRUE(std::holds_alternative<TiledRunTimeData>(parallel_result));
+  const auto& sequential = std::get<TiledRunTimeData>(sequential_result);
+  const auto& parallel = std::get<TiledRunTimeData>(parallel_result);
+  EXPECT_EQ(parallel.block_level_parameters.output_tile_sizes,
+            sequential.block_level_parameters.output_tile_sizes);
+  EXPECT_EQ(parallel.block_level_parameters.num_warps,
+            sequential.block_level_parameters.num_warps);
+  EXPECT_EQ(parallel.runtime_data.exec_time,
+            sequential.runtime_data.exec_time);
+}
+
 // This test means to catch integer overflow errors when run with ASan build.
 // The checks below are just sanity checks for values.
 TEST_F(
@@ -321,6 +321,16 @@ GpuPerformanceModel::EstimateRunTimesForMultiOutputFusion(
   return {time_unfused, time_fused};
 }
 
+/*static*/
+bool GpuPerformanceModel::IsLaunchBound(
+    const HloInstruction* instr, const se::DeviceDescription& device_info,
+    const GpuHloCostAnalysis* cost_analysis,
+    const GpuPerformanceModelOptions& config) {
+  EstimateRunTimeData data =
+      EstimateRunTimeForInstruction(instr, device_info, cost_analysis, config);
+  return data.exec_time <= kKernelLaunchOverhead;
+}
+
 /*static*/
 void GpuPerformanceModel::RecordEstimatedRunTime(
     HloInstruction* instruction, const se::DeviceDescription& device_info,
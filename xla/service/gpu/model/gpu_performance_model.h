@@ -67,6 +67,14 @@ class GpuPerformanceModel : public GpuPerformanceModelBase {
       const se::DeviceDescription& device_info,
       const GpuHloCostAnalysis* cost_analysis);
 
+  // Returns true if the estimated execution time of `instr` does not exceed the
+  // kernel launch overhead, i.e. launching `instr` as a separate kernel is
+  // dominated by the launch itself.
+  static bool IsLaunchBound(const HloInstruction* instr,
+                            const se::DeviceDescription& device_info,
+                            const GpuHloCostAnalysis* cost_analysis,
+                            const GpuPerformanceModelOptions& config);
+
   // Writes estimated execution time to FusionBackendConfig.reification_cost.
   static void RecordEstimatedRunTime(HloInstruction* instruction,
                                      const se::DeviceDescription& device_info,
@@ -299,21 +299,29 @@ absl::Duration GpuPerformanceModelBase::ReadTimeWithDRAMHeuristic(
 
   // Two things can happed on re-reading the buffer:
   //   - If the buffer fits into cache, the L1/L2 cache speedup is applied.
-  //   - If the buffer doesn't fit, it will be read from DRAM and the same
-  //     coalessing waste factor is applied.
-  float rest_bandwidth = gpu_device_info.memory_bandwidth();
-  if (n_bytes_net < gpu_device_info.l2_cache_size()) {
-    rest_bandwidth *= kL2CacheSpeedup;
-    if (n_bytes_net <
-        gpu_device_info.l1_cache_size_per_SM() * gpu_device_info.core_count()) {
-      rest_bandwidth *= kL1CacheSpeedup;
-    }
-  } else {
-    rest_bandwidth *= hbm_bandwidth_utilization_rate;
+  //   - If the buffer doesn't fit, only the part of it that stays resident in
+  //     L2 is re-read from cache. The rest is read from DRAM again and the
+  //     same coalessing waste factor is applied.
+  const int64_t l2_cache_size = gpu_device_info.l2_cache_size();
+  float cache_bandwidth = gpu_device_info.memory_bandwidth() * kL2CacheSpeedup;
+  if (n_bytes_net <
+      gpu_device_info.l1_cache_size_per_SM() * gpu_device_info.core_count()) {
+    cache_bandwidth *= kL1CacheSpeedup;
+  }
+  float miss_bandwidth =
+      gpu_device_info.memory_bandwidth() * hbm_bandwidth_utilization_rate;
+
+  // Assuming re-reads are spread uniformly over the buffer, the fraction of
+  // them that hit in L2 is the fraction of the buffer that fits in L2.
+  double l2_hit_rate = 1.0;
+  if (n_bytes_net >= l2_cache_size) {
+    l2_hit_rate = l2_cache_size > 0 ? 1.0 * l2_cache_size / n_bytes_net : 0.0;
   }
 
   dram_bandwidth = AdjustBandwidth(gpu_device_info, dram_bandwidth, num_blocks);
-  rest_bandwidth = AdjustBandwidth(gpu_device_info, rest_bandwidth, num_blocks);
+  cache_bandwidth =
+      AdjustBandwidth(gpu_device_info, cache_bandwidth, num_blocks);
+  miss_bandwidth = AdjustBandwidth(gpu_device_info, miss_bandwidth, num_blocks);
 
   // n_bytes_net > n_bytes_total can happen when we compute read time of
   // shared operand. This is a flaw in the interface that should be fixed.
@@ -321,9 +329,12 @@ absl::Duration GpuPerformanceModelBase::ReadTimeWithDRAMHeuristic(
 
   // Number of bytes that we be re-read, potentially from cache.
   int64_t n_bytes_read_cache = n_bytes_total - n_bytes_read_dram;
+  double n_bytes_cache_hit = n_bytes_read_cache * l2_hit_rate;
+  double n_bytes_cache_miss = n_bytes_read_cache - n_bytes_cache_hit;
 
   return absl::Seconds(n_bytes_read_dram / dram_bandwidth) +
-         absl::Seconds(n_bytes_read_cache / rest_bandwidth);
+         absl::Seconds(n_bytes_cache_hit / cache_bandwidth) +
+         absl::Seconds(n_bytes_cache_miss / miss_bandwidth);
 }
 
 /*static*/
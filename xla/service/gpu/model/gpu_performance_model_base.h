@@ -210,8 +210,10 @@ class GpuPerformanceModelBase {
   // given GPU.
   //
   // Assumes that the first n_bytes_net are always read from DRAM, but next
-  // reads can be cached. Restricts the effective HBM bandwidth using the
-  // utilization rate passed as a parameter to model not-fully-coalesced reads.
+  // reads can be cached. If n_bytes_net doesn't fit into L2, only the resident
+  // fraction of the re-reads hits in cache. Restricts the effective HBM
+  // bandwidth using the utilization rate passed as a parameter to model
+  // not-fully-coalesced reads.
   static absl::Duration ReadTimeWithDRAMHeuristic(
       const se::DeviceDescription& gpu_device_info, int64_t num_blocks,
       int64_t n_bytes_net, int64_t n_bytes_total, PrimitiveType element_type,
@@ -15,10 +15,12 @@ limitations under the License.
 
 #include "xla/service/gpu/model/gpu_performance_model_base.h"
 
+#include <cstdint>
 #include <memory>
 
 #include <gtest/gtest.h>
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/testlib/test_helpers.h"
@@ -27,6 +29,7 @@ limitations under the License.
 #include "xla/service/gpu/hlo_fusion_analysis.h"
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/xla_data.pb.h"
 #include "xla/tests/hlo_test_base.h"
 #include "tsl/platform/statusor.h"
 
@@ -279,6 +282,31 @@ ENTRY e {
   EXPECT_EQ(launch_dimensions.num_threads_per_block(), 128);
 }
 
+TEST_F(GpuPerformanceModelBaseTest,
+       ReadTimeWithDRAMHeuristic_PartiallyResidentInL2) {
+  const int64_t l2_cache_size = device_info_.l2_cache_size();
+  const int64_t num_blocks = 1024;
+  auto read_time = [&](int64_t n_bytes_net, int64_t n_bytes_total) {
+    return GpuPerformanceModelBase::ReadTimeWithDRAMHeuristic(
+        device_info_, num_blocks, n_bytes_net, n_bytes_total, F32,
+        /*hbm_bandwidth_utilization_rate=*/1.0);
+  };
+
+  // A buffer twice the size of L2 read twice: half of the re-reads hit in L2,
+  // so the second read is faster than the first but slower than re-reading a
+  // buffer that fits into L2 entirely.
+  const int64_t n_bytes = 2 * l2_cache_size;
+  absl::Duration first_read = read_time(n_bytes, n_bytes);
+  absl::Duration second_read = read_time(n_bytes, 2 * n_bytes) - first_read;
+  EXPECT_LT(second_read, first_read);
+
+  absl::Duration cached_second_read =
+      (read_time(l2_cache_size / 2, l2_cache_size) -
+       read_time(l2_cache_size / 2, l2_cache_size / 2)) *
+      4;
+  EXPECT_GT(second_read, cached_second_read);
+}
+
 }  // namespace
 }  // namespace gpu
 }  // namespace xla
@@ -148,6 +148,43 @@ ENTRY e {
   EXPECT_NEAR(absl::ToInt64Microseconds(indexing_t.time_unfused), 1, 1);
 }
 
+TEST_F(GpuPerformanceModelTest, IsLaunchBound) {
+  absl::string_view hlo_string = R"(
+HloModule m
+
+f_small {
+  p0 = f32[1000] parameter(0)
+  p1 = f32[1000] parameter(1)
+  ROOT b0 = f32[1000] add(p0, p1)
+}
+
+f_large {
+  c0 = f32[] constant(0)
+  ROOT b0 = f32[10000000] broadcast(c0)
+}
+
+ENTRY e {
+  p0 = f32[1000] parameter(0)
+  p1 = f32[1000] parameter(1)
+  small = f32[1000] fusion(p0, p1), kind=kLoop, calls=f_small
+  large = f32[10000000] fusion(), kind=kLoop, calls=f_large
+  ROOT t = (f32[1000], f32[10000000]) tuple(small, large)
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  ASSERT_IS_OK(module->entry_computation()->Accept(&analysis_));
+
+  auto config = GpuPerformanceModelOptions::Default(
+      &fusion_analysis_cache_, &gpu_performance_model_cache_);
+  HloInstruction* small = FindInstruction(module.get(), "small");
+  HloInstruction* large = FindInstruction(module.get(), "large");
+  EXPECT_TRUE(GpuPerformanceModel::IsLaunchBound(small, device_info_,
+                                                 &analysis_, config));
+  EXPECT_FALSE(GpuPerformanceModel::IsLaunchBound(large, device_info_,
+                                                  &analysis_, config));
+}
+
 TEST_F(GpuPerformanceModelTest, LargeReadWrite) {
   absl::string_view hlo_string = R"(
 HloModule m
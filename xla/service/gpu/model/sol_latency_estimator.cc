@@ -17,16 +17,21 @@ limitations under the License.
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <utility>
 
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/time/time.h"
 #include "xla/hlo/analysis/hlo_dataflow_analysis.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/utils/hlo_query.h"
 #include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/service/gpu/model/collective_interpolator.h"
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/service/gpu/model/gpu_performance_model.h"
 #include "xla/service/gpu/model/gpu_performance_model_base.h"
@@ -53,6 +58,20 @@ int GetNumGpus(const HloInstruction& instr) {
   return size;
 }
 
+// Returns the collective started by the async collective start `instr`, or
+// nullptr if `instr` doesn't start a collective supported by the
+// `CollectiveInterpolator`.
+HloCollectiveInstruction* GetAsyncCollective(HloInstruction* instr) {
+  if (!hlo_query::IsAsyncCollectiveStartOp(instr)) {
+    return nullptr;
+  }
+  if (instr->opcode() == HloOpcode::kAsyncStart) {
+    return DynCast<HloCollectiveInstruction>(
+        instr->async_wrapped_instruction());
+  }
+  return DynCast<HloCollectiveInstruction>(instr);
+}
+
 }  // namespace
 
 /*static*/ absl::Duration SolLatencyEstimator::ComputeCollectiveTime(
@@ -158,6 +177,14 @@ LatencyEstimator::TimeCost SolLatencyEstimator::GetLatencyBetween(
   }
 
   if (IsAsyncPair(from, target)) {
+    if (auto it = interpolated_collective_times_.find(&from.GetInstr());
+        it != interpolated_collective_times_.end()) {
+      double coll_time = absl::ToDoubleMicroseconds(it->second);
+      VLOG(10) << "[SoL] Collective perf table interpolated latency between "
+               << from.GetInstr().name() << " and " << target.GetInstr().name()
+               << " to be: " << coll_time << " us.";
+      return coll_time;
+    }
     double coll_time = absl::ToDoubleMicroseconds(
         ComputeCollectiveTime(from.GetInstr(), gpu_info_, shape_size_function_,
                               sol_flags_, *cost_analysis_));
@@ -193,7 +220,8 @@ SolLatencyEstimator::SolLatencyEstimator(
     std::unique_ptr<LatencyEstimator> latency_estimator,
     const se::DeviceDescription& gpu_info,
     HloCostAnalysis::ShapeSizeFunction shape_size_function,
-    HloComputation* computation)
+    HloComputation* computation,
+    CollectiveInterpolator* collective_interpolator)
     : config_(config),
       gpu_info_(gpu_info),
       latency_estimator_(std::move(latency_estimator)),
@@ -212,6 +240,22 @@ SolLatencyEstimator::SolLatencyEstimator(
       sol_flags_.rtt == absl::ZeroDuration() || sol_flags_.gpus_per_node == 0) {
     LOG(WARNING) << "[SoL] Failed to parse SoL system config options.";
   }
+  if (collective_interpolator == nullptr) {
+    return;
+  }
+  for (HloComputation* comp :
+       computation->parent()->MakeNonfusionComputations()) {
+    for (HloInstruction* instr : comp->instructions()) {
+      HloCollectiveInstruction* collective = GetAsyncCollective(instr);
+      if (collective == nullptr) {
+        continue;
+      }
+      if (std::optional<absl::Duration> exec_time =
+              collective_interpolator->EstimatedRuntime(*collective)) {
+        interpolated_collective_times_[instr] = *exec_time;
+      }
+    }
+  }
 }
 
 }  // namespace gpu
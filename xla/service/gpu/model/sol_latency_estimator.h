@@ -19,9 +19,11 @@ limitations under the License.
 #include <memory>
 #include <optional>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/service/gpu/model/collective_interpolator.h"
 #include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/service/gpu/model/sol_gpu_cost_model.h"
 #include "xla/service/hlo_cost_analysis.h"
@@ -35,11 +37,17 @@ class SolLatencyEstimator : public LatencyEstimator {
  public:
   // Implementation of SolLatencyEstimator using HloAnalysis and
   // GPUPerformanceModel to estimate latencies for instructions.
-  SolLatencyEstimator(const SchedulerConfig& config,
-                      std::unique_ptr<LatencyEstimator> latency_estimator,
-                      const se::DeviceDescription& gpu_info,
-                      HloCostAnalysis::ShapeSizeFunction shape_size_function,
-                      HloComputation* computation);
+  //
+  // If `collective_interpolator` is not null, latencies of async collectives
+  // are interpolated from the measured collective perf table, and the SoL
+  // model is used only for collectives not covered by the table.
+  SolLatencyEstimator(
+      const SchedulerConfig& config,
+      std::unique_ptr<LatencyEstimator> latency_estimator,
+      const se::DeviceDescription& gpu_info,
+      HloCostAnalysis::ShapeSizeFunction shape_size_function,
+      HloComputation* computation,
+      CollectiveInterpolator* collective_interpolator = nullptr);
 
   TimeCost GetLatencyBetween(const HloGraphNode& from,
                              const HloGraphNode& target) const override;
@@ -69,6 +77,11 @@ class SolLatencyEstimator : public LatencyEstimator {
   std::unique_ptr<LatencyEstimator> latency_estimator_;
   HloCostAnalysis::ShapeSizeFunction shape_size_function_;
   const SolGPUCostModel::Config sol_flags_;
+
+  // Latencies of async collective start instructions interpolated from the
+  // collective perf table.
+  absl::flat_hash_map<const HloInstruction*, absl::Duration>
+      interpolated_collective_times_;
 };
 
 }  // namespace gpu
@@ -453,6 +453,10 @@ absl::StatusOr<int64_t> GetRealRootIndex(
 
   std::vector<SymbolicTiledHloInstruction*> worklist = {root_tiled_hlo};
 
+  // Instructions of a fusion often share their indexing (e.g. chains of
+  // elementwise ops), so the same maps are composed and simplified repeatedly.
+  IndexingMapCache indexing_map_cache;
+
   while (!worklist.empty()) {
     auto tiled_hlo_instruction = worklist.back();
     worklist.pop_back();
@@ -473,15 +477,15 @@ absl::StatusOr<int64_t> GetRealRootIndex(
       CHECK_EQ(operand_indexing_map_set.size(), 1);  // Crash OK
 
       IndexingMap operand_indexing_map =
-          ComposeIndexingMaps(tiled_hlo_instruction->indexing_map(),
-                              *operand_indexing_map_set.begin());
+          indexing_map_cache.Compose(tiled_hlo_instruction->indexing_map(),
+                                     *operand_indexing_map_set.begin());
       if (operand_indexing_map.IsUndefined()) {
         return FusionDecision::Forbid(
                    "Couldn't derive indexing map for instruction ")
                << tiled_hlo_instruction->hlo()->ToString() << " and operand "
                << operand.instruction().ToString();
       }
-      operand_indexing_map.Simplify();
+      indexing_map_cache.Simplify(operand_indexing_map);
       operand_indexing_map.RescaleSymbols();
       operand_indexing_map.RemoveUnusedSymbols();
 
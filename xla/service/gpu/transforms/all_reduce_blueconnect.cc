@@ -235,10 +235,21 @@ TryDecomposeReplicaGroups(const HloAllReduceInstruction& all_reduce,
 // When applied repeatedly, this transformation will reproduce the same pattern
 // as described in the BlueConnect paper.
 absl::StatusOr<bool> TryDecomposeAllReduce(HloAllReduceInstruction* all_reduce,
-                                           size_t num_devices_per_host) {
+                                           size_t num_devices_per_host,
+                                           int64_t min_decomposition_bytes) {
   TF_RET_CHECK(all_reduce);
   TF_RET_CHECK(!all_reduce->has_sharding());
 
+  int64_t all_reduce_bytes = 0;
+  for (const HloInstruction* operand : all_reduce->operands()) {
+    all_reduce_bytes += ShapeUtil::ByteSizeOf(operand->shape());
+  }
+  if (all_reduce_bytes < min_decomposition_bytes) {
+    VLOG(2) << "Skip decomposing " << all_reduce->name() << " of "
+            << all_reduce_bytes << " bytes";
+    return false;
+  }
+
   HloComputation& computation = *all_reduce->parent();  // never null
   PrimitiveType element_type = all_reduce->operand(0)->shape().element_type();
 
@@ -324,7 +335,7 @@ absl::StatusOr<bool> TryDecomposeAllReduce(HloAllReduceInstruction* all_reduce,
   // Try to apply decomposition recursively.
   TF_RETURN_IF_ERROR(
       TryDecomposeAllReduce(Cast<HloAllReduceInstruction>(new_all_reduce),
-                            num_devices_per_host)
+                            num_devices_per_host, min_decomposition_bytes)
           .status());
   return true;
 }
@@ -363,7 +374,8 @@ absl::StatusOr<bool> AllReduceBlueConnect::Run(
   for (HloAllReduceInstruction* all_reduce : all_reduces) {
     TF_ASSIGN_OR_RETURN(
         bool all_reduce_changed,
-        TryDecomposeAllReduce(all_reduce, num_devices_per_host_));
+        TryDecomposeAllReduce(all_reduce, num_devices_per_host_,
+                              min_decomposition_bytes_));
     changed |= all_reduce_changed;
   }
 
@@ -17,6 +17,7 @@ limitations under the License.
 #define XLA_SERVICE_GPU_TRANSFORMS_ALL_REDUCE_BLUECONNECT_H_
 
 #include <cstddef>
+#include <cstdint>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/statusor.h"
@@ -35,10 +36,18 @@ namespace xla {
 // This algorithm attempts to minimize the number of levels of network hierarchy
 // traversed for as much data transfer as possible. This implementation assumes
 // that host IDs are ordered corresponding to network hierarchy.
+//
+// All-reduces smaller than `min_decomposition_bytes` are left alone: they are
+// bound by latency rather than bandwidth, and the decomposition replaces one
+// collective with three. The threshold also applies to the all-reduces
+// created by the decomposition, so it bounds the number of hierarchy levels
+// a large all-reduce is decomposed into.
 class AllReduceBlueConnect : public HloModulePass {
  public:
-  explicit AllReduceBlueConnect(size_t num_devices_per_host)
-      : num_devices_per_host_(num_devices_per_host) {}
+  explicit AllReduceBlueConnect(size_t num_devices_per_host,
+                                int64_t min_decomposition_bytes = 0)
+      : num_devices_per_host_(num_devices_per_host),
+        min_decomposition_bytes_(min_decomposition_bytes) {}
 
   absl::string_view name() const override { return "all-reduce-blueconnect"; }
 
@@ -49,6 +58,7 @@ class AllReduceBlueConnect : public HloModulePass {
 
  private:
   size_t num_devices_per_host_;
+  int64_t min_decomposition_bytes_;
 };
 
 }  // namespace xla
@@ -410,5 +410,71 @@ ENTRY %comp {
   EXPECT_THAT(pass.Run(module.get()), IsOkAndHolds(false));
 }
 
+TEST_F(AllReduceBlueConnectTest, SmallAllReduceUnchanged) {
+  constexpr absl::string_view hlo_string = R"(
+HloModule module
+
+%add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY %comp {
+  p0 = f32[4,4] parameter(0)
+  ROOT crs = f32[4,4] all-reduce(p0), to_apply=add
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  SetModuleConfig(*module, /*replica_count=*/8);
+
+  AllReduceBlueConnect pass(/*num_devices_per_host=*/4,
+                            /*min_decomposition_bytes=*/65);
+  EXPECT_THAT(pass.Run(module.get()), IsOkAndHolds(false));
+}
+
+TEST_F(AllReduceBlueConnectTest, MinDecompositionBytesLimitsStages) {
+  // Same as TwoStage, but the all-reduce created by the first stage is too
+  // small to be decomposed again.
+  constexpr absl::string_view hlo_string = R"(
+HloModule module
+
+%add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY %comp {
+  p0 = f32[4,4] parameter(0)
+  ROOT crs = f32[4,4] all-reduce(p0), to_apply=add
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  SetModuleConfig(*module, /*replica_count=*/16);
+
+  AllReduceBlueConnect pass(/*num_devices_per_host=*/4,
+                            /*min_decomposition_bytes=*/64);
+  EXPECT_THAT(pass.Run(module.get()), IsOkAndHolds(true));
+
+  std::vector<std::vector<int64_t>> scatter_gather_groups = {
+      {0, 1, 2, 3}, {4, 5, 6, 7}, {8, 9, 10, 11}, {12, 13, 14, 15}};
+  std::vector<std::vector<int64_t>> new_all_reduce_groups = {
+      {0, 4, 8, 12}, {1, 5, 9, 13}, {2, 6, 10, 14}, {3, 7, 11, 15}};
+
+  auto bitcast = m::Bitcast(m::Parameter(0)).WithShape(F32, {16});
+  auto reduce_scatter = m::ReduceScatter(bitcast)
+                            .WithShape(F32, {4})
+                            .WithReplicaGroups(scatter_gather_groups);
+  auto all_reduce = m::AllReduce(reduce_scatter)
+                        .WithShape(F32, {4})
+                        .WithReplicaGroups(new_all_reduce_groups);
+  auto all_gather = m::AllGather(all_reduce)
+                        .WithShape(F32, {16})
+                        .WithReplicaGroups(scatter_gather_groups);
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Bitcast(all_gather).WithShape(F32, {4, 4})));
+}
+
 }  // namespace
 }  // namespace xla
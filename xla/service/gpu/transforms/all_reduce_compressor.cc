@@ -0,0 +1,183 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/all_reduce_compressor.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/hlo/utils/hlo_query.h"
+#include "xla/literal_util.h"
+#include "xla/primitive_util.h"
+#include "xla/service/collective_ops_utils.h"
+#include "xla/service/hlo_creation_utils.h"
+#include "xla/service/hlo_module_config.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::gpu {
+namespace {
+
+// Returns the number of devices in each replica group of `all_reduce`. Returns
+// nullopt if replica groups have different sizes, or if the all-reduce group
+// mode can't be expressed with an all-to-all.
+std::optional<int64_t> GetGroupSize(const HloAllReduceInstruction* all_reduce) {
+  const HloModuleConfig& config = all_reduce->GetModule()->config();
+
+  absl::StatusOr<CollectiveOpGroupMode> group_mode =
+      GetCollectiveOpGroupMode(all_reduce);
+  if (!group_mode.ok()) return std::nullopt;
+
+  // All-to-all supports only cross-replica and cross-partition modes, and the
+  // latter matches flattened ids if there is a single replica.
+  bool cross_replica = *group_mode == CollectiveOpGroupMode::kCrossReplica;
+  bool cross_partition =
+      *group_mode == CollectiveOpGroupMode::kFlattenedID &&
+      config.replica_count() == 1;
+  if (!cross_replica && !cross_partition) {
+    VLOG(1) << "Skip AllReduceCompressor because of unsupported "
+               "CollectiveOpGroupMode "
+            << CollectiveOpGroupModeToString(*group_mode);
+    return std::nullopt;
+  }
+
+  const std::vector<ReplicaGroup>& replica_groups =
+      all_reduce->replica_groups();
+  if (replica_groups.empty()) {
+    return cross_replica ? config.replica_count() : config.num_partitions();
+  }
+
+  int64_t group_size = replica_groups[0].replica_ids_size();
+  for (const ReplicaGroup& replica_group : replica_groups) {
+    if (replica_group.replica_ids_size() != group_size) return std::nullopt;
+  }
+  return group_size;
+}
+
+absl::StatusOr<bool> TryCompressAllReduce(HloAllReduceInstruction* all_reduce,
+                                          PrimitiveType compressed_type) {
+  const Shape& shape = all_reduce->shape();
+  if (!shape.IsArray() || all_reduce->constrain_layout()) return false;
+
+  PrimitiveType element_type = shape.element_type();
+  if (!primitive_util::IsFloatingPointType(element_type) ||
+      primitive_util::BitWidth(element_type) <=
+          primitive_util::BitWidth(compressed_type)) {
+    return false;
+  }
+
+  if (MatchReductionComputation(all_reduce->to_apply()) != ReductionKind::SUM) {
+    return false;
+  }
+
+  std::optional<int64_t> group_size = GetGroupSize(all_reduce);
+  if (!group_size.has_value() || *group_size < 2) return false;
+
+  // Each device reduces one contiguous chunk of the flattened operand.
+  int64_t num_elements = ShapeUtil::ElementsIn(shape);
+  if (num_elements % *group_size != 0) return false;
+  int64_t chunk_size = num_elements / *group_size;
+
+  VLOG(3) << "Compress all-reduce " << all_reduce->name() << " to "
+          << primitive_util::LowercasePrimitiveTypeName(compressed_type)
+          << "; group_size=" << *group_size;
+
+  HloComputation* computation = all_reduce->parent();
+
+  int64_t next_channel_id = hlo_query::NextChannelId(*computation->parent());
+  auto get_channel_id = [&]() -> std::optional<int64_t> {
+    if (all_reduce->channel_id().has_value()) {
+      return next_channel_id++;
+    }
+    return std::nullopt;
+  };
+
+  // Send every chunk of the compressed operand to the device that reduces it.
+  TF_ASSIGN_OR_RETURN(HloInstruction * chunks,
+                      MakeReshapeHlo({*group_size, chunk_size},
+                                     all_reduce->mutable_operand(0)));
+  HloInstruction* compressed = MakeConvertToHlo(chunks, compressed_type);
+  HloInstruction* all_to_all =
+      computation->AddInstruction(HloInstruction::CreateAllToAll(
+          compressed->shape(), {compressed}, all_reduce->device_list(),
+          /*constrain_layout=*/false, get_channel_id(),
+          /*split_dimension=*/0));
+
+  // Accumulate received chunks in the original type.
+  HloInstruction* received = MakeConvertToHlo(all_to_all, element_type);
+  HloInstruction* zero = computation->AddInstruction(
+      HloInstruction::CreateConstant(LiteralUtil::Zero(element_type)));
+  TF_ASSIGN_OR_RETURN(HloInstruction * reduced,
+                      MakeReduceHlo(received, zero, /*dimensions=*/{0},
+                                    HloOpcode::kAdd));
+
+  // Gather reduced chunks from all devices.
+  HloInstruction* compressed_reduced =
+      MakeConvertToHlo(reduced, compressed_type);
+  HloInstruction* all_gather =
+      computation->AddInstruction(HloInstruction::CreateAllGather(
+          ShapeUtil::MakeShape(compressed_type, {num_elements}),
+          {compressed_reduced}, /*all_gather_dimension=*/0,
+          all_reduce->device_list(), /*constrain_layout=*/false,
+          get_channel_id(), all_reduce->use_global_device_ids()));
+
+  HloInstruction* gathered = MakeConvertToHlo(all_gather, element_type);
+  TF_ASSIGN_OR_RETURN(HloInstruction * replacement,
+                      MakeReshapeHlo(shape, gathered));
+
+  TF_RETURN_IF_ERROR(all_reduce->CopyAllControlDepsTo(chunks, replacement));
+  TF_RETURN_IF_ERROR(all_reduce->DropAllControlDeps());
+  TF_RETURN_IF_ERROR(computation->ReplaceInstruction(all_reduce, replacement));
+  return true;
+}
+
+}  // namespace
+
+absl::StatusOr<bool> AllReduceCompressor::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  std::vector<HloAllReduceInstruction*> all_reduces;
+  for (HloComputation* computation :
+       module->MakeNonfusionComputations(execution_threads)) {
+    for (HloInstruction* instruction : computation->instructions()) {
+      if (HloPredicateIsOp<HloOpcode::kAllReduce>(instruction)) {
+        all_reduces.push_back(Cast<HloAllReduceInstruction>(instruction));
+      }
+    }
+  }
+
+  bool changed = false;
+  for (HloAllReduceInstruction* all_reduce : all_reduces) {
+    TF_ASSIGN_OR_RETURN(bool all_reduce_changed,
+                        TryCompressAllReduce(all_reduce, compressed_type_));
+    changed |= all_reduce_changed;
+  }
+  return changed;
+}
+
+}  // namespace xla::gpu
@@ -0,0 +1,60 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_TRANSFORMS_ALL_REDUCE_COMPRESSOR_H_
+#define XLA_SERVICE_GPU_TRANSFORMS_ALL_REDUCE_COMPRESSOR_H_
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::gpu {
+
+// Decomposes sum all-reduces of wide floating point types into collectives
+// that transfer data in a narrower `compressed_type`, while accumulating
+// partial sums in the original type:
+//
+// 1. convert to `compressed_type`
+// 2. all-to-all, which sends each chunk of the input to the device
+//    responsible for reducing it
+// 3. convert back and reduce the received chunks in the original type
+// 4. convert to `compressed_type` and all-gather the reduced chunks
+// 5. convert back to the original type
+//
+// This halves the amount of data transferred for f32 all-reduces compressed to
+// bf16, at the expense of precision, and is meant for bandwidth bound gradient
+// reductions across hosts.
+class AllReduceCompressor : public HloModulePass {
+ public:
+  explicit AllReduceCompressor(PrimitiveType compressed_type = BF16)
+      : compressed_type_(compressed_type) {}
+
+  absl::string_view name() const override { return "all-reduce-compressor"; }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  PrimitiveType compressed_type_;
+};
+
+}  // namespace xla::gpu
+
+#endif  // XLA_SERVICE_GPU_TRANSFORMS_ALL_REDUCE_COMPRESSOR_H_
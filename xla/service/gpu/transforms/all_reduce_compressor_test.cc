@@ -0,0 +1,151 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/all_reduce_compressor.h"
+
+#include <memory>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/pattern_matcher_gmock.h"
+#include "xla/service/pattern_matcher.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla_data.pb.h"
+#include "tsl/platform/status_matchers.h"
+
+namespace xla::gpu {
+namespace {
+
+using ::tsl::testing::IsOkAndHolds;
+namespace m = ::xla::match;
+
+using AllReduceCompressorTest = HloTestBase;
+
+TEST_F(AllReduceCompressorTest, CompressesCrossReplicaAllReduce) {
+  constexpr absl::string_view hlo_string = R"(
+HloModule module, replica_count=4
+
+add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY main {
+  p0 = f32[4,8] parameter(0)
+  ROOT all-reduce = f32[4,8] all-reduce(p0), replica_groups={}, to_apply=add
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  EXPECT_THAT(AllReduceCompressor(BF16).Run(module.get()), IsOkAndHolds(true));
+
+  auto reshape = m::Reshape(m::Parameter(0)).WithShape(F32, {4, 8});
+  auto all_to_all = m::AllToAll(m::Convert(reshape).WithShape(BF16, {4, 8}))
+                        .WithShape(BF16, {4, 8});
+  auto reduce = m::Reduce(m::Convert(all_to_all).WithShape(F32, {4, 8}),
+                          m::Constant())
+                    .WithShape(F32, {8});
+  auto all_gather = m::AllGather(m::Convert(reduce).WithShape(BF16, {8}))
+                        .WithShape(BF16, {32});
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Reshape(m::Convert(all_gather).WithShape(F32, {32}))
+                             .WithShape(F32, {4, 8})));
+}
+
+TEST_F(AllReduceCompressorTest, CompressesFlattenedIdAllReduce) {
+  constexpr absl::string_view hlo_string = R"(
+HloModule module, num_partitions=4
+
+add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY main {
+  p0 = f32[16] parameter(0)
+  ROOT all-reduce = f32[16] all-reduce(p0), channel_id=1,
+    replica_groups={{0,1},{2,3}}, use_global_device_ids=true, to_apply=add
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  EXPECT_THAT(AllReduceCompressor(BF16).Run(module.get()), IsOkAndHolds(true));
+
+  auto all_to_all = m::AllToAll().WithShape(BF16, {2, 8});
+  auto all_gather =
+      m::AllGather(m::Convert(m::Reduce(m::Convert(all_to_all), m::Constant())))
+          .WithShape(BF16, {16});
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Reshape(m::Convert(all_gather))));
+}
+
+TEST_F(AllReduceCompressorTest, SkipsNarrowAndNonSumAllReduces) {
+  constexpr absl::string_view hlo_string = R"(
+HloModule module, replica_count=4
+
+add {
+  lhs = bf16[] parameter(0)
+  rhs = bf16[] parameter(1)
+  ROOT add = bf16[] add(lhs, rhs)
+}
+
+max {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT max = f32[] maximum(lhs, rhs)
+}
+
+ENTRY main {
+  p0 = bf16[16] parameter(0)
+  p1 = f32[16] parameter(1)
+  all-reduce.0 = bf16[16] all-reduce(p0), replica_groups={}, to_apply=add
+  all-reduce.1 = f32[16] all-reduce(p1), replica_groups={}, to_apply=max
+  ROOT tuple = (bf16[16], f32[16]) tuple(all-reduce.0, all-reduce.1)
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  EXPECT_THAT(AllReduceCompressor(BF16).Run(module.get()),
+              IsOkAndHolds(false));
+}
+
+TEST_F(AllReduceCompressorTest, SkipsIndivisibleAllReduce) {
+  constexpr absl::string_view hlo_string = R"(
+HloModule module, replica_count=4
+
+add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY main {
+  p0 = f32[6] parameter(0)
+  ROOT all-reduce = f32[6] all-reduce(p0), replica_groups={}, to_apply=add
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  EXPECT_THAT(AllReduceCompressor(BF16).Run(module.get()),
+              IsOkAndHolds(false));
+}
+
+}  // namespace
+}  // namespace xla::gpu
@@ -15,10 +15,12 @@ limitations under the License.
 
 #include "xla/service/gpu/transforms/collectives/all_reduce_combiner.h"
 
+#include <cstdint>
 #include <optional>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/functional/bind_front.h"
+#include "absl/log/log.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "xla/hlo/ir/hlo_instruction.h"
@@ -103,9 +105,21 @@ absl::StatusOr<bool> GpuAllReduceCombiner::Run(
     changed |= combined;
   }
 
-  // Use default combiner thresholds after we combine pipelined collectives.
-  // The rest is combined by the parent pass code.
+  // Use default combiner thresholds after we combine pipelined collectives,
+  // or the one suggested by the cost model if enabled. The rest is combined by
+  // the parent pass code.
   combine_threshold_in_bytes_ = default_combine_threshold_in_bytes_;
+  if (module->config()
+          .debug_options()
+          .xla_gpu_experimental_enable_cost_model_combiner_threshold()) {
+    if (std::optional<int64_t> threshold =
+            ComputeCostModelAllReduceCombinerThreshold(*module, device_info_,
+                                                       pointer_size_)) {
+      VLOG(1) << "Using cost model all-reduce combiner threshold: "
+              << *threshold << " bytes";
+      combine_threshold_in_bytes_ = *threshold;
+    }
+  }
   TF_ASSIGN_OR_RETURN(bool combined_rest,
                       AllReduceCombiner::Run(module, execution_threads));
   changed |= combined_rest;
@@ -13,14 +13,17 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
@@ -31,8 +34,12 @@ limitations under the License.
 #include "xla/service/collective_utils.h"
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/gpu_hlo_schedule.h"
+#include "xla/service/gpu/gpu_latency_hiding_scheduler.h"
+#include "xla/service/gpu/model/gpu_collective_performance_model.h"
+#include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
 #include "xla/service/gpu/transforms/collectives/collective_ops_utils.h"
 #include "xla/service/gpu/transforms/collectives/convert_async_collectives_to_sync.h"
+#include "xla/shape_util.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/tsl/platform/errors.h"
 #include "xla/util.h"
@@ -55,6 +62,10 @@ int64_t GetDefaultValue(HloOpcode opcode) {
 
 static constexpr const char* kCollectiveIdAttr = "collective_id";
 
+// Ratio of the modelled transfer time of a combined all-reduce to the kernel
+// launch overhead at which we stop combining.
+static constexpr int64_t kCostModelCombinerLaunchOverheadRatio = 10;
+
 std::string CollectiveId(const HloInstruction* instr) {
   return absl::StrCat(instr->unique_id());
 }
@@ -145,6 +156,55 @@ int64_t ComputeSuggestedCombinerThreshold(
   return MaxAvailableMemory(module, device_info) - peak_memory_bytes;
 }
 
+std::optional<int64_t> ComputeCostModelAllReduceCombinerThreshold(
+    const HloModule& module, const se::DeviceDescription& device_info,
+    int64_t pointer_size) {
+  constexpr absl::Duration kLaunchOverhead =
+      GpuPerformanceWithCollectiveModel::kNcclKernelLaunchOverhead;
+
+  // Pick the threshold of the all-reduce with the fastest modelled link, so
+  // that launches are amortized on every link.
+  std::optional<int64_t> threshold;
+  for (const HloComputation* computation : module.MakeNonfusionComputations()) {
+    GpuHloCostAnalysis cost_analysis(
+        GpuHloCostAnalysis::Options{ShapeSizeBytesFunction(pointer_size),
+                                    /*per_second_rates=*/{},
+                                    /*min_latencies_seconds=*/{},
+                                    /*count_multiple_input_accesses=*/true},
+        device_info);
+    if (!computation->Accept(&cost_analysis).ok()) {
+      VLOG(1) << "Cannot run cost analysis on computation: "
+              << computation->name();
+      continue;
+    }
+    for (const HloInstruction* instr : computation->instructions()) {
+      if (!HloPredicateIsOp<HloOpcode::kAllReduce, HloOpcode::kAllReduceStart>(
+              instr) ||
+          cost_analysis.NumOfDevices(*instr) <= 1) {
+        continue;
+      }
+      absl::Duration transfer_time =
+          GpuPerformanceWithCollectiveModel::ComputeCollectiveTime(
+              *instr, &cost_analysis, device_info) -
+          kLaunchOverhead;
+      int64_t bytes = 0;
+      for (const HloInstruction* operand : instr->operands()) {
+        bytes += ShapeUtil::ByteSizeOfElements(operand->shape());
+      }
+      if (transfer_time <= absl::ZeroDuration() || bytes == 0) {
+        continue;
+      }
+      auto instr_threshold = static_cast<int64_t>(
+          bytes * kCostModelCombinerLaunchOverheadRatio *
+          absl::FDivDuration(kLaunchOverhead, transfer_time));
+      VLOG(2) << "Cost model combiner threshold for " << instr->name() << ": "
+              << instr_threshold << " bytes";
+      threshold = std::max(threshold.value_or(0), instr_threshold);
+    }
+  }
+  return threshold;
+}
+
 absl::Status AppendPipelinedInstruction(HloInstruction* instr,
                                         HloInstruction* new_while_instr) {
   if (!IsCollective(instr)) {
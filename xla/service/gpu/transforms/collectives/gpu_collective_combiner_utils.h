@@ -17,6 +17,7 @@ limitations under the License.
 #define XLA_SERVICE_GPU_TRANSFORMS_COLLECTIVES_GPU_COLLECTIVE_COMBINER_UTILS_H_
 
 #include <cstdint>
+#include <optional>
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
@@ -48,6 +49,17 @@ int64_t ComputeSuggestedCombinerThreshold(
     const HloModule& module, const se::DeviceDescription& device_info,
     HloOpcode collective_opcode, int64_t pointer_size);
 
+// Suggests an all-reduce combiner threshold from the collective performance
+// model. Combining all-reduces saves a kernel launch per combined op, but
+// delays their users and leaves less room to overlap them with compute. The
+// suggested threshold is the size at which the modelled transfer time reaches
+// `kCostModelCombinerLaunchOverheadRatio` times the launch overhead, beyond
+// which combining barely amortizes launches further. Returns nullopt if
+// `module` has no all-reduces across multiple devices.
+std::optional<int64_t> ComputeCostModelAllReduceCombinerThreshold(
+    const HloModule& module, const se::DeviceDescription& device_info,
+    int64_t pointer_size);
+
 // Adds information that `instr` has been pipelined to the
 // `CollectiveBackendInfo`. It is up to the caller to decide when to invoke
 // this.
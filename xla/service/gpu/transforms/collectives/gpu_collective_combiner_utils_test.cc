@@ -31,6 +31,7 @@ limitations under the License.
 #include "xla/hlo/utils/hlo_query.h"
 #include "xla/service/collective_pipeliner.h"
 #include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/service/gpu/gpu_device_info_for_tests.h"
 #include "xla/service/hlo_module_config.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/tests/hlo_test_base.h"
@@ -104,6 +105,55 @@ TEST_F(CollectiveCombinerUtilsTest,
   EXPECT_EQ(suggested_threshold, 6712);
 }
 
+TEST_F(CollectiveCombinerUtilsTest,
+       ComputeCostModelAllReduceCombinerThresholdUsesAllReduces) {
+  absl::string_view kHloText = R"(
+  HloModule m, replica_count=8
+
+  add {
+    a = f32[] parameter(0)
+    b = f32[] parameter(1)
+    ROOT _ = f32[] add(a, b)
+  }
+
+  ENTRY ar {
+    p0 = f32[1024,1024] parameter(0)
+    ROOT _ = f32[1024,1024] all-reduce(p0), replica_groups={}, to_apply=add
+  })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHloText));
+  std::optional<int64_t> threshold =
+      ComputeCostModelAllReduceCombinerThreshold(
+          *module, TestGpuDeviceInfo::RTXA6000DeviceInfo(),
+          /*pointer_size=*/8);
+
+  ASSERT_TRUE(threshold.has_value());
+  EXPECT_GT(*threshold, 0);
+}
+
+TEST_F(CollectiveCombinerUtilsTest,
+       ComputeCostModelAllReduceCombinerThresholdSkipsSingleDevice) {
+  absl::string_view kHloText = R"(
+  HloModule m
+
+  add {
+    a = f32[] parameter(0)
+    b = f32[] parameter(1)
+    ROOT _ = f32[] add(a, b)
+  }
+
+  ENTRY ar {
+    p0 = f32[1024,1024] parameter(0)
+    ROOT _ = f32[1024,1024] all-reduce(p0), replica_groups={}, to_apply=add
+  })";
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHloText));
+  EXPECT_EQ(ComputeCostModelAllReduceCombinerThreshold(
+                *module, TestGpuDeviceInfo::RTXA6000DeviceInfo(),
+                /*pointer_size=*/8),
+            std::nullopt);
+}
+
 TEST_F(CollectiveCombinerUtilsTest,
        AppendPipelinedInstructionAppendsPipelinedInstructionInfoForward) {
   // This is just a canonical IR which makes it easy to pipeline a collective
@@ -30,6 +30,7 @@ limitations under the License.
 #include "absl/container/flat_hash_set.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/span.h"
 #include "xla/ffi/ffi_api.h"
@@ -44,6 +45,9 @@ limitations under the License.
 #include "xla/service/gpu/cublas_cudnn.h"
 #include "xla/service/gpu/hlo_fusion_analysis.h"
 #include "xla/service/gpu/ir_emission_utils.h"
+#include "xla/service/gpu/model/gpu_hlo_cost_analysis.h"
+#include "xla/service/gpu/model/gpu_performance_model.h"
+#include "xla/service/gpu/model/gpu_performance_model_base.h"
 #include "xla/service/gpu/variant_visitor.h"
 #include "xla/shape.h"
 #include "xla/shape_util.h"
@@ -97,6 +101,18 @@ static bool IsNoOp(const HloInstruction* hlo) {
 // done operation is not part of the same command buffer, we would change the
 // execution semantics and create additional synchronization point.
 
+// Collective permutes can be captured into command buffers only when peer
+// transfers use collectives, because memcpy-based transfers synchronize with
+// peers on the host.
+static bool IsCollectivePermuteCommand(const HloInstruction* hlo,
+                                       const CommandBufferConfig& config) {
+  return config.enabled_commands.contains(DebugOptions::COLLECTIVES) &&
+         !hlo->GetModule()
+              ->config()
+              .debug_options()
+              .xla_gpu_use_memcpy_local_p2p();
+}
+
 static bool IsAsyncStartCommand(const HloInstruction* hlo,
                                 const CommandBufferConfig& config) {
   if (HloPredicateIsOp<HloOpcode::kAllReduceStart, HloOpcode::kAllGatherStart>(
@@ -104,6 +120,10 @@ static bool IsAsyncStartCommand(const HloInstruction* hlo,
     return config.enabled_commands.contains(DebugOptions::COLLECTIVES);
   }
 
+  if (HloPredicateIsOp<HloOpcode::kCollectivePermuteStart>(hlo)) {
+    return IsCollectivePermuteCommand(hlo, config);
+  }
+
   if (HloPredicateIsOp<HloOpcode::kAsyncStart>(hlo)) {
     if (IsCublasGemm(*hlo->async_wrapped_instruction())) {
       return config.enabled_commands.contains(DebugOptions::CUBLAS);
@@ -122,7 +142,8 @@ static bool IsAsyncStartCommand(const HloInstruction* hlo,
       }
     }
     if (hlo->async_wrapped_opcode() == HloOpcode::kReduceScatter ||
-        hlo->async_wrapped_opcode() == HloOpcode::kAllToAll) {
+        hlo->async_wrapped_opcode() == HloOpcode::kAllToAll ||
+        hlo->async_wrapped_opcode() == HloOpcode::kCollectiveBroadcast) {
       return config.enabled_commands.contains(DebugOptions::COLLECTIVES);
     }
   }
@@ -141,6 +162,10 @@ static bool IsAsyncDoneCommand(const HloInstruction* hlo,
     return config.enabled_commands.contains(DebugOptions::COLLECTIVES);
   }
 
+  if (HloPredicateIsOp<HloOpcode::kCollectivePermuteDone>(hlo)) {
+    return IsCollectivePermuteCommand(hlo, config);
+  }
+
   if (HloPredicateIsOp<HloOpcode::kAsyncDone>(hlo)) {
     if (IsCublasGemm(*hlo->async_wrapped_instruction())) {
       return config.enabled_commands.contains(DebugOptions::CUBLAS);
@@ -159,7 +184,8 @@ static bool IsAsyncDoneCommand(const HloInstruction* hlo,
       }
     }
     if (hlo->async_wrapped_opcode() == HloOpcode::kReduceScatter ||
-        hlo->async_wrapped_opcode() == HloOpcode::kAllToAll) {
+        hlo->async_wrapped_opcode() == HloOpcode::kAllToAll ||
+        hlo->async_wrapped_opcode() == HloOpcode::kCollectiveBroadcast) {
       return config.enabled_commands.contains(DebugOptions::COLLECTIVES);
     }
   }
@@ -169,8 +195,8 @@ static bool IsAsyncDoneCommand(const HloInstruction* hlo,
 
 // Finds an async-done HLO operation corresponding on an async-start one.
 static HloInstruction* FindAsyncDoneCommand(const HloInstruction* start) {
-  if (HloPredicateIsOp<HloOpcode::kAllReduceStart, HloOpcode::kAllGatherStart>(
-          start)) {
+  if (HloPredicateIsOp<HloOpcode::kAllReduceStart, HloOpcode::kAllGatherStart,
+                       HloOpcode::kCollectivePermuteStart>(start)) {
     CHECK(start->users().size() == 1);  // NOLINT, checked by HLO verifier
     return start->users().front();
   } else if (HloPredicateIsOp<HloOpcode::kAsyncStart>(start)) {
@@ -367,25 +393,57 @@ static void RemoveTrailingNoOps(HloInstructionSequence& seq) {
 // Discovering sequences of compatible Hlo instructions
 //===----------------------------------------------------------------------===//
 
+// Returns loop fusions in `computation` that the GPU performance model
+// estimates to be dominated by the kernel launch overhead.
+static absl::StatusOr<absl::flat_hash_set<const HloInstruction*>>
+FindLaunchBoundFusions(HloComputation* computation,
+                       const se::DeviceDescription& device_description) {
+  GpuHloCostAnalysis cost_analysis(GpuHloCostAnalysis::Options(),
+                                   device_description);
+  TF_RETURN_IF_ERROR(computation->Accept(&cost_analysis));
+
+  absl::flat_hash_set<const HloInstruction*> launch_bound_fusions;
+  for (const HloInstruction* instr : computation->instructions()) {
+    if (instr->opcode() != HloOpcode::kFusion ||
+        instr->fusion_kind() != HloInstruction::FusionKind::kLoop) {
+      continue;
+    }
+    if (GpuPerformanceModel::IsLaunchBound(
+            instr, device_description, &cost_analysis,
+            GpuPerformanceModelOptions::Default())) {
+      launch_bound_fusions.insert(instr);
+    }
+  }
+  return launch_bound_fusions;
+}
+
 // The input is a scheduled sequence of instructions. This function collects
 // subsequences that will be extracted as command buffers.
 std::vector<HloInstructionSequence>
 CommandBufferScheduling::CollectCommandBufferSequences(
     const HloInstructionSequence schedule, const CommandBufferConfig& config,
-    int32_t min_num_commands) {
+    int32_t min_num_commands,
+    const absl::flat_hash_set<const HloInstruction*>& launch_bound_fusions) {
   std::vector<HloInstructionSequence> sequences;
 
   HloInstructionSequence current_seq;
   int64_t num_commands_in_current_seq = 0;
+  int64_t num_launch_bound_in_current_seq = 0;
 
-  // Adds `current_seq` to `sequences` if it has enough commands in it.
+  // Adds `current_seq` to `sequences` if it has enough commands in it, or if
+  // it is a chain of launch-bound fusions that is cheaper to launch at once.
   auto collect_current_seq = [&]() {
-    if (num_commands_in_current_seq >= std::max(1, min_num_commands)) {
+    bool is_launch_bound_seq =
+        num_commands_in_current_seq > 1 &&
+        num_launch_bound_in_current_seq == num_commands_in_current_seq;
+    if (num_commands_in_current_seq >= std::max(1, min_num_commands) ||
+        is_launch_bound_seq) {
       RemoveTrailingNoOps(current_seq);
       sequences.push_back(std::move(current_seq));
     }
     current_seq = HloInstructionSequence();
     num_commands_in_current_seq = 0;
+    num_launch_bound_in_current_seq = 0;
   };
 
   auto& instructions = schedule.instructions();
@@ -504,6 +562,7 @@ CommandBufferScheduling::CollectCommandBufferSequences(
     if (IsCommand(inst, config) &&
         check_dynamic_slice_operand_not_from_seq(current_seq, inst)) {
       num_commands_in_current_seq++;
+      num_launch_bound_in_current_seq += launch_bound_fusions.contains(inst);
       current_seq.push_back(inst);
       continue;
     }
@@ -842,6 +901,7 @@ absl::StatusOr<bool> CommandBufferScheduling::Run(
   // Erase command buffer cmd types that are not supported by the gpu runtime.
   static constexpr auto kRequireConditionals = {DebugOptions::CONDITIONAL,
                                                 DebugOptions::WHILE};
+  static constexpr auto kRequireWhileConditionals = {DebugOptions::WHILE};
   static constexpr auto kRequireTracing = {
       DebugOptions::CUBLAS, DebugOptions::CUBLASLT, DebugOptions::CUDNN,
       DebugOptions::CUSTOM_CALL, DebugOptions::COLLECTIVES};
@@ -875,6 +935,13 @@ absl::StatusOr<bool> CommandBufferScheduling::Run(
       erase(kRequireTracing);       // cuStreamBeginCaptureToGraph
       erase(kRequireConditionals);  // on-device control flow
     }
+    // While loops with a device-side predicate run as a single graph launch,
+    // and we only enable them with CUDA 12.4+ conditional while nodes.
+    if (std::min(device_description_.runtime_version(),
+                 device_description_.driver_version()) <
+        se::SemanticVersion{12, 4, 0}) {
+      erase(kRequireWhileConditionals);  // on-device while loops
+    }
   };
   auto erase_rocm = [&](const se::RocmComputeCapability& rocm_comp) {
     erase(kRequireConditionals);  // on-device control flow
@@ -900,10 +967,17 @@ absl::StatusOr<bool> CommandBufferScheduling::Run(
     TF_ASSIGN_OR_RETURN(bool changed_, MoveParametersAndConstantsToFront(comp));
     changed |= changed_;
 
+    absl::flat_hash_set<const HloInstruction*> launch_bound_fusions;
+    if (debug_options.xla_gpu_graph_capture_launch_bound_fusions()) {
+      TF_ASSIGN_OR_RETURN(launch_bound_fusions,
+                          FindLaunchBoundFusions(comp, device_description_));
+    }
+
     std::vector<HloInstructionSequence> sequences =
         CollectCommandBufferSequences(
             module->schedule().sequence(comp), config,
-            debug_options.xla_gpu_graph_min_graph_size());
+            debug_options.xla_gpu_graph_min_graph_size(),
+            launch_bound_fusions);
 
     for (const HloInstructionSequence& seq : sequences) {
       TF_ASSIGN_OR_RETURN(CommandBuffer command_buffer,
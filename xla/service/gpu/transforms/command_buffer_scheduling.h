@@ -91,9 +91,14 @@ class CommandBufferScheduling : public HloModulePass {
       HloModule* module,
       const absl::flat_hash_set<absl::string_view>& execution_threads) override;
 
+  // Collects sequences of commands with at least `min_num_commands` commands.
+  // Shorter sequences are collected too if they have more than one command and
+  // all commands are in `launch_bound_fusions`.
   static std::vector<HloInstructionSequence> CollectCommandBufferSequences(
       HloInstructionSequence schedule, const CommandBufferConfig& config,
-      int32_t min_num_commands = 1);
+      int32_t min_num_commands = 1,
+      const absl::flat_hash_set<const HloInstruction*>& launch_bound_fusions =
+          {});
 
   // Moves kParameter and kConstant instructions in a computation to
   // the beginning of the computation. This simplifies the construction of
@@ -20,6 +20,7 @@ limitations under the License.
 #include <vector>
 
 #include <gtest/gtest.h>
+#include "absl/container/flat_hash_set.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/ir/hlo_schedule.h"
@@ -32,6 +33,7 @@ limitations under the License.
 #include "xla/service/hlo_module_config.h"
 #include "xla/service/hlo_runner_interface.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/stream_executor/semantic_version.h"
 #include "xla/tests/hlo_test_base.h"
 #include "xla/tsl/lib/core/status_test_util.h"
 #include "tsl/platform/status.h"
@@ -267,6 +269,40 @@ TEST_F(CommandBufferSchedulingTest, AllGatherStartFollowedByDone) {
                             });
 }
 
+TEST_F(CommandBufferSchedulingTest, CollectivePermuteStartFollowedByDone) {
+  const char* hlo = R"(
+    HloModule TestModule, is_scheduled=true
+
+    ENTRY %main (a: s32[4]) -> s32[4] {
+      %a = s32[4] parameter(0)
+
+      %start = (s32[4]{0}, s32[4]{0}) collective-permute-start(%a),
+        channel_id=555, source_target_pairs={{0,1},{1,0}},
+        backend_config={"collective_backend_config": {"is_sync":true,"no_parallel_custom_call":false}}
+
+      ROOT %done = s32[4]{0} collective-permute-done(%start)
+    })";
+
+  const char* expected = R"(
+    CHECK: %command_buffer ([[P0:.+]]: s32[4]) -> s32[4] {
+    CHECK:   %[[P0]] = s32[4]{0} parameter(0)
+    CHECK:   %[[START:.+]] = {{.*}} collective-permute-start(%[[P0]])
+    CHECK:   ROOT %[[DONE:.+]] = s32[4]{0} collective-permute-done(%[[START]])
+    CHECK: }
+
+    CHECK: ENTRY %main (a: s32[4]) -> s32[4] {
+    CHECK:   %[[A:.+]] = s32[4]{0} parameter(0)
+    CHECK:   ROOT %[[CALL:.+]] = s32[4]{0} call(%[[A]]),
+    CHECK:     to_apply=%command_buffer
+    CHECK: })";
+
+  RunAndFilecheckHloRewrite(hlo, CommandBufferScheduling(device_desc()),
+                            expected, [](HloModule* module) {
+                              EXPECT_TRUE(module->has_schedule());
+                              TF_CHECK_OK(module->schedule().Verify());
+                            });
+}
+
 TEST_F(CommandBufferSchedulingTest, ReduceScatterStartFollowedByDone) {
   const char* hlo = R"(
     HloModule TestModule, is_scheduled=true
@@ -526,6 +562,73 @@ TEST_F(CommandBufferSchedulingTest, CollectCommandBufferSequence) {
   EXPECT_EQ(seq_1[1]->opcode(), HloOpcode::kFusion);
 }
 
+TEST_F(CommandBufferSchedulingTest, CollectLaunchBoundCommandBufferSequence) {
+  const char* hlo = R"(
+      HloModule TestModule, is_scheduled=true
+
+      %fused_computation(param_0: s32[], param_1: s32[]) -> s32[] {
+        %p0 = s32[] parameter(0)
+        %p1 = s32[] parameter(1)
+        ROOT %add = s32[] add(s32[] %p0, s32[] %p1)
+      }
+
+      %fused_computation.1(param_0: s32[], param_1: s32[]) -> s32[] {
+        %p0 = s32[] parameter(0)
+        %p1 = s32[] parameter(1)
+        ROOT %add = s32[] add(s32[] %p0, s32[] %p1)
+      }
+
+      %fused_computation.2(param_0: s32[], param_1: s32[]) -> s32[] {
+        %p0 = s32[] parameter(0)
+        %p1 = s32[] parameter(1)
+        ROOT %add = s32[] add(s32[] %p0, s32[] %p1)
+      }
+
+      %fused_computation.3(param_0: s32[], param_1: s32[]) -> s32[] {
+        %p0 = s32[] parameter(0)
+        %p1 = s32[] parameter(1)
+        ROOT %add = s32[] add(s32[] %p0, s32[] %p1)
+      }
+
+      ENTRY %main (a: s32[], b: s32[]) -> s32[] {
+        %a = s32[] parameter(0)
+        %b = s32[] parameter(1)
+        %fusion = s32[] fusion(s32[] %a, s32[] %b), kind=kLoop, calls=%fused_computation
+        %fusion.1 = s32[] fusion(s32[] %fusion, s32[] %b), kind=kLoop, calls=%fused_computation.1
+        %custom-call = s32[] custom-call(s32[] %fusion.1, s32[] %b), custom_call_target="some target"
+        %fusion.2 = s32[] fusion(s32[] %custom-call, s32[] %a), kind=kLoop, calls=%fused_computation.2
+        ROOT %fusion.3 = s32[] fusion(s32[] %custom-call, s32[] %fusion.2), kind=kLoop, calls=%fused_computation.3
+      })";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerifiedHloModule> module,
+                          ParseAndReturnVerifiedModule(hlo));
+
+  HloInstructionSequence seq;
+  for (HloInstruction* x : module->entry_computation()->instructions()) {
+    seq.push_back(x);
+  }
+
+  CommandBufferScheduling::CommandBufferConfig config{
+      {DebugOptions::FUSION}, {}, device_desc()};
+
+  // Only the sequence of launch-bound fusions is shorter than the minimum
+  // number of commands and still collected.
+  absl::flat_hash_set<const HloInstruction*> launch_bound_fusions = {
+      FindInstruction(module.get(), "fusion.2"),
+      FindInstruction(module.get(), "fusion.3")};
+
+  std::vector<HloInstructionSequence> command_buffer_sequences =
+      CommandBufferScheduling::CollectCommandBufferSequences(
+          seq, config, /*min_num_commands=*/3, launch_bound_fusions);
+  ASSERT_EQ(command_buffer_sequences.size(), 1);
+
+  std::vector<HloInstruction*> seq_0 =
+      command_buffer_sequences[0].instructions();
+  ASSERT_EQ(seq_0.size(), 2);
+  EXPECT_EQ(seq_0[0]->name(), "fusion.2");
+  EXPECT_EQ(seq_0[1]->name(), "fusion.3");
+}
+
 TEST_F(CommandBufferSchedulingTest, MoveParametersToFront) {
   const char* hlo = R"(
       HloModule TestModule, is_scheduled=true
@@ -884,6 +987,64 @@ TEST_F(CommandBufferSchedulingTest, While) {
                             });
 }
 
+TEST_F(CommandBufferSchedulingTest, WhileRequiresCuda124) {
+  const char* hlo = R"(
+    HloModule TestModule, is_scheduled=true
+
+    %fused_computation (param_0: f32[1]) -> f32[1] {
+      %param_0 = f32[1]{0} parameter(0)
+      ROOT %copy.5 = f32[1]{0} copy(f32[1]{0} %param_0)
+    }
+
+    %fused_computation.1 (param_0.1: f32[1], param_1: f32[1]) -> f32[1] {
+      %param_0.1 = f32[1]{0} parameter(0)
+      %param_1 = f32[1]{0} parameter(1)
+      ROOT %add.2 = f32[1]{0} add(f32[1]{0} %param_0.1, f32[1]{0} %param_1)
+    }
+
+    %fused_computation.2 (param_0.2: f32[1], param_1.1: f32[1]) -> pred[1] {
+      %param_0.2 = f32[1]{0} parameter(0)
+      %param_1.1 = f32[1]{0} parameter(1)
+      ROOT %compare.3 = pred[1]{0} compare(f32[1]{0} %param_0.2, f32[1]{0} %param_1.1), direction=LT
+    }
+
+    %body (Arg_.3: f32[1]) -> f32[1] {
+      %constant_4 = f32[1]{0} constant({1})
+      %Arg_.3 = f32[1]{0} parameter(0)
+      ROOT %wrapped_add.1 = f32[1]{0} fusion(f32[1]{0} %Arg_.3, f32[1]{0} %constant_4), kind=kLoop, calls=%fused_computation.1
+    }
+
+    %cond (Arg_.11: f32[1]) -> pred[] {
+      %constant = f32[1]{0} constant({100})
+      %Arg_.11 = f32[1]{0} parameter(0)
+      %wrapped_compare.2 = pred[1]{0} fusion(f32[1]{0} %Arg_.11, f32[1]{0} %constant), kind=kLoop, calls=%fused_computation.2
+      ROOT %bitcast = pred[] bitcast(pred[1]{0} %wrapped_compare.2)
+    }
+
+    ENTRY %main.18 (Arg_0.1: f32[1]) -> f32[] {
+      %Arg_0.1 = f32[1]{0} parameter(0), sharding={replicated}
+      %wrapped_copy.4 = f32[1]{0} fusion(f32[1]{0} %Arg_0.1), kind=kLoop, calls=%fused_computation
+      %while.16 = f32[1]{0} while(f32[1]{0} %wrapped_copy.4), condition=%cond, body=%body
+      ROOT %bitcast.1 = f32[] bitcast(f32[1]{0} %while.16)
+    })";
+
+  // CUDA 12.3 supports conditional nodes, but while loops stay outside of
+  // command buffers and evaluate the predicate on the host.
+  se::DeviceDescription device_desc = this->device_desc();
+  device_desc.set_runtime_version(se::SemanticVersion{12, 3, 0});
+  device_desc.set_driver_version(se::SemanticVersion{12, 3, 0});
+
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(hlo));
+  CommandBufferScheduling pass(device_desc);
+  TF_ASSERT_OK(RunHloPass(&pass, module.get()).status());
+
+  bool has_while = false;
+  for (HloInstruction* instr : module->entry_computation()->instructions()) {
+    has_while |= instr->opcode() == HloOpcode::kWhile;
+  }
+  EXPECT_TRUE(has_while) << module->ToString();
+}
+
 TEST_F(CommandBufferSchedulingTest, Conditional) {
   const auto& gpu_desc = GetGpuComputeCapability();
   if (std::holds_alternative<se::RocmComputeCapability>(gpu_desc)) {
@@ -0,0 +1,128 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/concurrent_fusion_stream_assigner.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/backends/gpu/runtime/thunk.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/shape_util.h"
+#include "xla/stream_executor/device_description.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla::gpu {
+namespace {
+
+// Returns true if `instr` is a fusion that can run on a non-default stream and
+// doesn't produce enough elements to occupy all threads of the device.
+bool IsSmallFusion(const HloInstruction* instr,
+                   const se::DeviceDescription& device_description) {
+  if (HloPredicateIsNotOp<HloOpcode::kFusion>(instr) ||
+      instr->HasSideEffect() || instr->HasControlDependencies()) {
+    return false;
+  }
+
+  HloInstruction::FusionKind kind =
+      Cast<HloFusionInstruction>(instr)->fusion_kind();
+  if (kind != HloInstruction::FusionKind::kLoop &&
+      kind != HloInstruction::FusionKind::kInput) {
+    return false;
+  }
+
+  absl::StatusOr<GpuBackendConfig> gpu_config =
+      instr->backend_config<GpuBackendConfig>();
+  if (!gpu_config.ok() || gpu_config->operation_queue_id() !=
+                              Thunk::kDefaultExecutionStreamId.value()) {
+    return false;
+  }
+
+  int64_t num_threads = device_description.core_count() *
+                        device_description.threads_per_core_limit();
+  return ShapeUtil::ElementsInRecursive(instr->shape()) < num_threads;
+}
+
+}  // namespace
+
+absl::StatusOr<bool> ConcurrentFusionStreamAssigner::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  if (num_streams_ < 1) {
+    return false;
+  }
+
+  bool changed = false;
+  for (HloComputation* computation :
+       module->MakeNonfusionComputations(execution_threads)) {
+    if (computation->IsAsyncComputation()) {
+      continue;
+    }
+
+    // Depth of an instruction is the largest number of small fusions on a
+    // path from the computation parameters to it (inclusive). If one small
+    // fusion depends on another one, its depth is strictly larger.
+    absl::flat_hash_map<const HloInstruction*, int64_t> depth;
+    std::vector<std::vector<HloInstruction*>> levels;
+
+    for (HloInstruction* instr : computation->MakeInstructionPostOrder()) {
+      int64_t instr_depth = 0;
+      for (const HloInstruction* operand : instr->operands()) {
+        instr_depth = std::max(instr_depth, depth[operand]);
+      }
+      for (const HloInstruction* predecessor : instr->control_predecessors()) {
+        instr_depth = std::max(instr_depth, depth[predecessor]);
+      }
+      if (IsSmallFusion(instr, device_description_)) {
+        if (levels.size() <= instr_depth) {
+          levels.resize(instr_depth + 1);
+        }
+        levels[instr_depth++].push_back(instr);
+      }
+      depth[instr] = instr_depth;
+    }
+
+    for (const std::vector<HloInstruction*>& level : levels) {
+      // Keep the first fusion on the default stream, and spread the rest of
+      // them across additional streams.
+      for (int64_t i = 1; i < level.size(); ++i) {
+        HloInstruction* fusion = level[i];
+        TF_ASSIGN_OR_RETURN(GpuBackendConfig gpu_config,
+                            fusion->backend_config<GpuBackendConfig>());
+        gpu_config.set_operation_queue_id(1 + (i - 1) % num_streams_);
+        TF_RETURN_IF_ERROR(fusion->set_backend_config(gpu_config));
+        VLOG(3) << "Assign fusion " << fusion->name() << " to operation queue "
+                << gpu_config.operation_queue_id();
+        changed = true;
+      }
+    }
+  }
+  return changed;
+}
+
+}  // namespace xla::gpu
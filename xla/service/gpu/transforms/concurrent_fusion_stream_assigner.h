@@ -0,0 +1,62 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_TRANSFORMS_CONCURRENT_FUSION_STREAM_ASSIGNER_H_
+#define XLA_SERVICE_GPU_TRANSFORMS_CONCURRENT_FUSION_STREAM_ASSIGNER_H_
+
+#include <cstdint>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+#include "xla/stream_executor/device_description.h"
+
+namespace xla::gpu {
+
+// Finds groups of independent fusions that are too small to fill the GPU on
+// their own, and annotates all but one fusion in each group with a non-default
+// operation_queue_id, so that StreamAttributeAnnotator and
+// StreamAttributeAsyncWrapper run them asynchronously on additional compute
+// streams.
+//
+// Fusions are grouped by their depth in the dataflow graph, counting only
+// candidate fusions on the path. Fusions with the same depth can't reach each
+// other, so they can run concurrently. Fusions of a group are spread across
+// `num_streams` additional streams, the first fusion stays on the default one.
+class ConcurrentFusionStreamAssigner : public HloModulePass {
+ public:
+  ConcurrentFusionStreamAssigner(
+      const se::DeviceDescription& device_description, int64_t num_streams)
+      : device_description_(device_description), num_streams_(num_streams) {}
+
+  absl::string_view name() const override {
+    return "concurrent-fusion-stream-assigner";
+  }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  const se::DeviceDescription& device_description_;
+  int64_t num_streams_;
+};
+
+}  // namespace xla::gpu
+
+#endif  // XLA_SERVICE_GPU_TRANSFORMS_CONCURRENT_FUSION_STREAM_ASSIGNER_H_
@@ -0,0 +1,129 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/concurrent_fusion_stream_assigner.h"
+
+#include <cstdint>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/service/gpu/backend_configs.pb.h"
+#include "xla/service/gpu/gpu_device_info_for_tests.h"
+#include "xla/stream_executor/device_description.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla::gpu {
+namespace {
+
+class ConcurrentFusionStreamAssignerTest : public HloTestBase {
+ protected:
+  int64_t GetQueueId(const HloModule& module, absl::string_view name) {
+    const HloInstruction* instr = FindInstruction(&module, name);
+    return instr->backend_config<GpuBackendConfig>()->operation_queue_id();
+  }
+
+  const se::DeviceDescription device_description_ =
+      TestGpuDeviceInfo::RTXA6000DeviceInfo();
+};
+
+TEST_F(ConcurrentFusionStreamAssignerTest, AssignsIndependentFusions) {
+  constexpr absl::string_view kHloString = R"(
+  HloModule module
+
+  f {
+    p = f32[128] parameter(0)
+    ROOT e = f32[128] exponential(p)
+  }
+
+  ENTRY entry {
+    p0 = f32[128] parameter(0)
+    p1 = f32[128] parameter(1)
+    p2 = f32[128] parameter(2)
+    f0 = f32[128] fusion(p0), kind=kLoop, calls=f
+    f1 = f32[128] fusion(p1), kind=kLoop, calls=f
+    f2 = f32[128] fusion(p2), kind=kLoop, calls=f
+    ROOT tuple = (f32[128], f32[128], f32[128]) tuple(f0, f1, f2)
+  })";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+
+  ConcurrentFusionStreamAssigner assigner(device_description_,
+                                          /*num_streams=*/2);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, assigner.Run(module.get()));
+  EXPECT_TRUE(changed);
+
+  EXPECT_EQ(GetQueueId(*module, "f0"), 0);
+  EXPECT_EQ(GetQueueId(*module, "f1"), 1);
+  EXPECT_EQ(GetQueueId(*module, "f2"), 2);
+}
+
+TEST_F(ConcurrentFusionStreamAssignerTest, KeepsDependentFusions) {
+  constexpr absl::string_view kHloString = R"(
+  HloModule module
+
+  f {
+    p = f32[128] parameter(0)
+    ROOT e = f32[128] exponential(p)
+  }
+
+  ENTRY entry {
+    p0 = f32[128] parameter(0)
+    f0 = f32[128] fusion(p0), kind=kLoop, calls=f
+    n0 = f32[128] negate(f0)
+    ROOT f1 = f32[128] fusion(n0), kind=kLoop, calls=f
+  })";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+
+  ConcurrentFusionStreamAssigner assigner(device_description_,
+                                          /*num_streams=*/2);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, assigner.Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
+TEST_F(ConcurrentFusionStreamAssignerTest, KeepsLargeFusions) {
+  constexpr absl::string_view kHloString = R"(
+  HloModule module
+
+  f {
+    p = f32[16777216] parameter(0)
+    ROOT e = f32[16777216] exponential(p)
+  }
+
+  ENTRY entry {
+    p0 = f32[16777216] parameter(0)
+    p1 = f32[16777216] parameter(1)
+    f0 = f32[16777216] fusion(p0), kind=kLoop, calls=f
+    f1 = f32[16777216] fusion(p1), kind=kLoop, calls=f
+    ROOT tuple = (f32[16777216], f32[16777216]) tuple(f0, f1)
+  })";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(kHloString));
+
+  ConcurrentFusionStreamAssigner assigner(device_description_,
+                                          /*num_streams=*/2);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, assigner.Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
+}  // namespace
+}  // namespace xla::gpu
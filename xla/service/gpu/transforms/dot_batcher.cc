@@ -0,0 +1,245 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/dot_batcher.h"
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
+#include "absl/log/log.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/protobuf_util.h"
+#include "xla/service/graphcycles/graphcycles.h"
+#include "xla/service/hlo_creation_utils.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla::gpu {
+namespace {
+
+bool IsBatchingCandidate(const HloInstruction* instr,
+                         int64_t max_size_to_merge) {
+  if (instr->opcode() != HloOpcode::kDot) return false;
+  const auto* dot = Cast<HloDotInstruction>(instr);
+  if (dot->sparse_operands() > 0 || dot->HasControlDependencies() ||
+      !dot->shape().IsArray()) {
+    return false;
+  }
+  int64_t size = ShapeUtil::ByteSizeOf(dot->shape()) +
+                 ShapeUtil::ByteSizeOf(dot->operand(0)->shape()) +
+                 ShapeUtil::ByteSizeOf(dot->operand(1)->shape());
+  return size <= max_size_to_merge;
+}
+
+// Returns true if `a` and `b` compute the same kind of dot, i.e. stacking their
+// operands along a new major dimension yields a valid batched dot.
+bool AreBatchable(const HloInstruction* a, const HloInstruction* b) {
+  return ShapeUtil::Equal(a->shape(), b->shape()) &&
+         ShapeUtil::Equal(a->operand(0)->shape(), b->operand(0)->shape()) &&
+         ShapeUtil::Equal(a->operand(1)->shape(), b->operand(1)->shape()) &&
+         protobuf_util::ProtobufEquals(a->dot_dimension_numbers(),
+                                       b->dot_dimension_numbers()) &&
+         protobuf_util::ProtobufEquals(a->precision_config(),
+                                       b->precision_config());
+}
+
+// Stacks operand `operand_index` of all `dots` along a new major dimension.
+absl::StatusOr<HloInstruction*> StackOperands(
+    absl::Span<HloInstruction* const> dots, int64_t operand_index) {
+  std::vector<HloInstruction*> reshapes;
+  reshapes.reserve(dots.size());
+  for (HloInstruction* dot : dots) {
+    HloInstruction* operand = dot->mutable_operand(operand_index);
+    TF_ASSIGN_OR_RETURN(
+        HloInstruction * reshape,
+        MakeReshapeHlo(ShapeUtil::PrependMajorDimension(1, operand->shape()),
+                       operand));
+    reshapes.push_back(reshape);
+  }
+  return MakeConcatHlo(reshapes, /*dimension=*/0);
+}
+
+// Replaces `dots` with slices of a single batched dot. Returns the new dot.
+absl::StatusOr<HloInstruction*> BatchDots(
+    absl::Span<HloInstruction* const> dots) {
+  HloInstruction* first = dots.front();
+  HloComputation* comp = first->parent();
+  VLOG(3) << "Batching " << dots.size() << " dots like " << first->ToString();
+
+  TF_ASSIGN_OR_RETURN(HloInstruction * lhs, StackOperands(dots, 0));
+  TF_ASSIGN_OR_RETURN(HloInstruction * rhs, StackOperands(dots, 1));
+
+  // Shift all dimensions by one and make the new major dimension the leading
+  // batch dimension, so that it also becomes the major output dimension.
+  const DotDimensionNumbers& dnums = first->dot_dimension_numbers();
+  DotDimensionNumbers batched_dnums;
+  batched_dnums.add_lhs_batch_dimensions(0);
+  batched_dnums.add_rhs_batch_dimensions(0);
+  for (int64_t dim : dnums.lhs_batch_dimensions()) {
+    batched_dnums.add_lhs_batch_dimensions(dim + 1);
+  }
+  for (int64_t dim : dnums.rhs_batch_dimensions()) {
+    batched_dnums.add_rhs_batch_dimensions(dim + 1);
+  }
+  for (int64_t dim : dnums.lhs_contracting_dimensions()) {
+    batched_dnums.add_lhs_contracting_dimensions(dim + 1);
+  }
+  for (int64_t dim : dnums.rhs_contracting_dimensions()) {
+    batched_dnums.add_rhs_contracting_dimensions(dim + 1);
+  }
+
+  HloInstruction* batched = comp->AddInstruction(HloInstruction::CreateDot(
+      ShapeUtil::PrependMajorDimension(dots.size(), first->shape()), lhs, rhs,
+      batched_dnums, first->precision_config()));
+  first->SetupDerivedInstruction(batched);
+
+  const Shape& shape = first->shape();
+  std::vector<int64_t> start(shape.dimensions_size() + 1, 0);
+  std::vector<int64_t> limit(shape.dimensions().begin(),
+                             shape.dimensions().end());
+  limit.insert(limit.begin(), 1);
+  std::vector<int64_t> strides(shape.dimensions_size() + 1, 1);
+  for (int64_t i = 0; i < dots.size(); ++i) {
+    start[0] = i;
+    limit[0] = i + 1;
+    TF_ASSIGN_OR_RETURN(HloInstruction * slice,
+                        MakeSliceHlo(batched, start, limit, strides));
+    TF_ASSIGN_OR_RETURN(HloInstruction * reshape,
+                        MakeReshapeHlo(dots[i]->shape(), slice));
+    TF_RETURN_IF_ERROR(dots[i]->ReplaceAllUsesWith(reshape));
+  }
+  return batched;
+}
+
+absl::StatusOr<bool> BatchDotsInComputation(
+    HloComputation* comp, int64_t max_size_to_merge,
+    const std::function<bool(const HloInstruction*, const HloInstruction*)>&
+        can_merge) {
+  // Group batchable dots. Groups are kept in post order of their first dot so
+  // that the pass is deterministic.
+  std::vector<std::vector<HloInstruction*>> groups;
+  for (HloInstruction* instr : comp->MakeInstructionPostOrder()) {
+    if (!IsBatchingCandidate(instr, max_size_to_merge)) continue;
+    auto it = absl::c_find_if(groups, [&](const auto& group) {
+      return AreBatchable(group.front(), instr);
+    });
+    if (it == groups.end()) {
+      groups.push_back({instr});
+    } else {
+      it->push_back(instr);
+    }
+  }
+  absl::erase_if(groups, [](const auto& group) { return group.size() < 2; });
+  if (groups.empty()) {
+    return false;
+  }
+
+  // Build a dependency graph representing the whole computation.
+  GraphCycles graph;
+  absl::flat_hash_map<HloInstruction*, int32_t> graph_ids_map;
+  auto graph_id = [&](HloInstruction* instr) {
+    auto [it, inserted] = graph_ids_map.emplace(instr, -1);
+    if (inserted) {
+      it->second = graph.NewNode();
+    }
+    return it->second;
+  };
+  for (HloInstruction* instr : comp->MakeInstructionPostOrder()) {
+    int32_t id = graph_id(instr);
+    for (HloInstruction* operand : instr->operands()) {
+      CHECK(graph.InsertEdge(graph_id(operand), id));
+    }
+    for (HloInstruction* control_pred : instr->control_predecessors()) {
+      CHECK(graph.InsertEdge(graph_id(control_pred), id));
+    }
+  }
+
+  std::vector<HloInstruction*> dead_instrs;
+  for (std::vector<HloInstruction*>& group : groups) {
+    // Greedily split the group into batches of mutually independent dots.
+    while (group.size() >= 2) {
+      std::vector<HloInstruction*> batch = {group.front()};
+      std::vector<HloInstruction*> rest;
+      for (int64_t i = 1; i < group.size(); ++i) {
+        HloInstruction* dot = group[i];
+        int32_t dot_id = graph_id(dot);
+        // Perform reachability checks last since they can be expensive.
+        bool independent =
+            can_merge(batch.front(), dot) &&
+            absl::c_none_of(batch, [&](HloInstruction* other) {
+              int32_t other_id = graph_id(other);
+              return graph.IsReachableNonConst(other_id, dot_id) ||
+                     graph.IsReachableNonConst(dot_id, other_id);
+            });
+        (independent ? batch : rest).push_back(dot);
+      }
+      group = std::move(rest);
+      if (batch.size() < 2) continue;
+
+      TF_ASSIGN_OR_RETURN(HloInstruction * batched, BatchDots(batch));
+      // The batched dot depends on everything the batched dots depend on, and
+      // all their users now depend on it.
+      int32_t batched_id = graph_id(batched);
+      for (HloInstruction* dot : batch) {
+        int32_t dot_id = graph_id(dot);
+        graph.InsertEdge(dot_id, batched_id);
+        for (int32_t succ : graph.SuccessorsCopy(dot_id)) {
+          if (succ != batched_id) graph.InsertEdge(batched_id, succ);
+        }
+        dead_instrs.push_back(dot);
+      }
+    }
+  }
+
+  // Now it's finally safe to delete the old instructions from the graph.
+  for (HloInstruction* instr : dead_instrs) {
+    TF_RETURN_IF_ERROR(comp->RemoveInstruction(instr));
+  }
+  return !dead_instrs.empty();
+}
+
+}  // namespace
+
+absl::StatusOr<bool> DotBatcher::Run(
+    HloModule* module,
+    const absl::flat_hash_set<absl::string_view>& execution_threads) {
+  bool changed = false;
+  for (HloComputation* comp :
+       module->MakeNonfusionComputations(execution_threads)) {
+    TF_ASSIGN_OR_RETURN(bool changed_computation,
+                        BatchDotsInComputation(comp, max_size_to_merge_,
+                                               can_merge_));
+    changed |= changed_computation;
+  }
+  return changed;
+}
+
+}  // namespace xla::gpu
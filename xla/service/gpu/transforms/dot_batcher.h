@@ -0,0 +1,77 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_TRANSFORMS_DOT_BATCHER_H_
+#define XLA_SERVICE_GPU_TRANSFORMS_DOT_BATCHER_H_
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/pass/hlo_pass_interface.h"
+
+namespace xla::gpu {
+
+// Merges independent dots with identical operand shapes and dimension numbers
+// into a single batched dot. Transforms
+//
+//   x = f32[8,16] dot(f32[8,32] a, f32[32,16] b)
+//   y = f32[8,16] dot(f32[8,32] c, f32[32,16] d)
+//
+// into
+//
+//   lhs = f32[2,8,32] concatenate(reshape(a), reshape(c))
+//   rhs = f32[2,32,16] concatenate(reshape(b), reshape(d))
+//   z = f32[2,8,16] dot(lhs, rhs), lhs_batch_dims={0}, rhs_batch_dims={0}
+//   x = reshape(slice(z))
+//   y = reshape(slice(z))
+//
+// This replaces many small GEMM launches (e.g. per-head projections or LoRA
+// adapters) with a single one, at the cost of copying the operands. Unlike
+// DotMerger, the dots don't need to share an operand. The dots must not
+// transitively depend on each other, and each must have at most
+// `max_size_to_merge` input+output bytes.
+class DotBatcher : public HloModulePass {
+ public:
+  explicit DotBatcher(
+      int64_t max_size_to_merge,
+      std::function<bool(const HloInstruction* a, const HloInstruction* b)>
+          can_merge = [](const HloInstruction* dot_a,
+                         const HloInstruction* dot_b) -> bool { return true; })
+      : max_size_to_merge_(max_size_to_merge),
+        can_merge_(std::move(can_merge)) {}
+
+  absl::string_view name() const override { return "dot-batcher"; }
+
+  using HloPassInterface::Run;
+  absl::StatusOr<bool> Run(
+      HloModule* module,
+      const absl::flat_hash_set<absl::string_view>& execution_threads) override;
+
+ private:
+  int64_t max_size_to_merge_;
+  // Predicate function for backend-specific compatibility check.
+  std::function<bool(const HloInstruction* dot_a, const HloInstruction* dot_b)>
+      can_merge_;
+};
+
+}  // namespace xla::gpu
+
+#endif  // XLA_SERVICE_GPU_TRANSFORMS_DOT_BATCHER_H_
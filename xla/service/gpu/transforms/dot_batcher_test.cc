@@ -0,0 +1,149 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/dot_batcher.h"
+
+#include <cstdint>
+#include <memory>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/testlib/pattern_matcher_gmock.h"
+#include "xla/service/pattern_matcher.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/platform/statusor.h"
+#include "tsl/platform/status_matchers.h"
+
+namespace xla::gpu {
+namespace {
+
+using ::tsl::testing::IsOkAndHolds;
+namespace m = ::xla::match;
+
+constexpr int64_t kMaxSize = 1 << 20;
+
+using DotBatcherTest = HloTestBase;
+
+TEST_F(DotBatcherTest, BatchesIndependentDots) {
+  constexpr absl::string_view hlo_string = R"(
+HloModule module
+
+ENTRY main {
+  p0 = f32[8,32] parameter(0)
+  p1 = f32[32,16] parameter(1)
+  p2 = f32[8,32] parameter(2)
+  p3 = f32[32,16] parameter(3)
+  dot0 = f32[8,16] dot(p0, p1),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  dot1 = f32[8,16] dot(p2, p3),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  ROOT tuple = (f32[8,16], f32[8,16]) tuple(dot0, dot1)
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  EXPECT_THAT(DotBatcher(kMaxSize).Run(module.get()), IsOkAndHolds(true));
+
+  const HloInstruction* dot = nullptr;
+  auto batched = m::Dot(&dot, m::Concatenate(m::Reshape(m::Parameter(0)),
+                                             m::Reshape(m::Parameter(2))),
+                        m::Concatenate(m::Reshape(m::Parameter(1)),
+                                       m::Reshape(m::Parameter(3))))
+                     .WithShape(F32, {2, 8, 16});
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Tuple(m::Reshape(m::Slice(batched)),
+                                  m::Reshape(m::Slice(batched)))));
+  EXPECT_THAT(dot->dot_dimension_numbers().lhs_batch_dimensions(),
+              ::testing::ElementsAre(0));
+  EXPECT_THAT(dot->dot_dimension_numbers().lhs_contracting_dimensions(),
+              ::testing::ElementsAre(2));
+  EXPECT_THAT(dot->dot_dimension_numbers().rhs_contracting_dimensions(),
+              ::testing::ElementsAre(1));
+}
+
+TEST_F(DotBatcherTest, DoesNotBatchDependentDots) {
+  constexpr absl::string_view hlo_string = R"(
+HloModule module
+
+ENTRY main {
+  p0 = f32[16,16] parameter(0)
+  p1 = f32[16,16] parameter(1)
+  dot0 = f32[16,16] dot(p0, p1),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  neg = f32[16,16] negate(dot0)
+  ROOT dot1 = f32[16,16] dot(neg, p1),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  EXPECT_THAT(DotBatcher(kMaxSize).Run(module.get()), IsOkAndHolds(false));
+}
+
+TEST_F(DotBatcherTest, DoesNotBatchMismatchingOrLargeDots) {
+  constexpr absl::string_view hlo_string = R"(
+HloModule module
+
+ENTRY main {
+  p0 = f32[8,32] parameter(0)
+  p1 = f32[32,16] parameter(1)
+  p2 = f32[8,32] parameter(2)
+  p3 = f32[32,8] parameter(3)
+  p4 = f32[128,128] parameter(4)
+  dot0 = f32[8,16] dot(p0, p1),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  dot1 = f32[8,8] dot(p2, p3),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  dot2 = f32[128,128] dot(p4, p4),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  dot3 = f32[128,128] dot(p4, p4),
+    lhs_contracting_dims={0}, rhs_contracting_dims={0}
+  ROOT tuple = (f32[8,16], f32[8,8], f32[128,128], f32[128,128])
+    tuple(dot0, dot1, dot2, dot3)
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  EXPECT_THAT(DotBatcher(kMaxSize).Run(module.get()), IsOkAndHolds(false));
+}
+
+TEST_F(DotBatcherTest, RespectsSizeThreshold) {
+  constexpr absl::string_view hlo_string = R"(
+HloModule module
+
+ENTRY main {
+  p0 = f32[64,64] parameter(0)
+  p1 = f32[64,64] parameter(1)
+  dot0 = f32[64,64] dot(p0, p1),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  dot1 = f32[64,64] dot(p1, p0),
+    lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  ROOT tuple = (f32[64,64], f32[64,64]) tuple(dot0, dot1)
+})";
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+
+  // Each dot reads and writes 3 * 16KiB.
+  EXPECT_THAT(DotBatcher(/*max_size_to_merge=*/16 << 10).Run(module.get()),
+              IsOkAndHolds(false));
+  EXPECT_THAT(DotBatcher(/*max_size_to_merge=*/48 << 10).Run(module.get()),
+              IsOkAndHolds(true));
+}
+
+}  // namespace
+}  // namespace xla::gpu
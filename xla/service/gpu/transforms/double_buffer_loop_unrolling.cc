@@ -30,9 +30,11 @@ limitations under the License.
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_clone_context.h"
+#include "xla/hlo/ir/hlo_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/ir/hlo_instruction_utils.h"
 #include "xla/hlo/ir/hlo_instructions.h"
@@ -42,8 +44,11 @@ limitations under the License.
 #include "xla/hlo/transforms/simplifiers/flatten_call_graph.h"
 #include "xla/hlo/utils/hlo_query.h"
 #include "xla/service/collective_ops_utils.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
 #include "xla/status_macros.h"
 #include "xla/util.h"
+#include "xla/xla.pb.h"
 #include "xla/xla_data.pb.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/status.h"
@@ -525,18 +530,105 @@ absl::StatusOr<bool> DoubleBufferingUnroll(HloInstruction* while_instr,
 
 // Function performs double buffering unrolling strategy iff there is any
 // collective operation within a body computation.
+// Upper bound on the number of instructions in the fully unrolled loop body.
+// Bounds the code size and compile time impact of automatic full unrolling.
+constexpr int64_t kAutoFullUnrollMaxInstructions = 2048;
+
+// Kernels that read and write less than this number of bytes on average have
+// an execution time comparable to the kernel launch overhead (a few
+// microseconds at HBM bandwidth), and loops of such kernels are launch bound.
+constexpr int64_t kLaunchBoundBytesPerKernel = 1 << 20;
+
+// Returns true if `instr` does not launch any work on device.
+bool IsNoOp(const HloInstruction* instr) {
+  return HloPredicateIsOp<HloOpcode::kParameter, HloOpcode::kGetTupleElement,
+                          HloOpcode::kTuple, HloOpcode::kConstant,
+                          HloOpcode::kBitcast, HloOpcode::kAfterAll>(instr);
+}
+
+int64_t ByteSizeOfArrays(const Shape& shape) {
+  int64_t size = 0;
+  ShapeUtil::ForEachLeafShape(shape, [&](const Shape& leaf, const ShapeIndex&) {
+    if (leaf.IsArray()) size += ShapeUtil::ByteSizeOfElements(leaf);
+  });
+  return size;
+}
+
+// A coarse model of the cost of a single while loop iteration.
+struct LoopIterationCost {
+  int64_t num_instructions = 0;
+  int64_t num_kernels = 0;
+  int64_t bytes_accessed = 0;
+  bool has_collectives = false;
+  bool command_buffer_compatible = true;
+};
+
+LoopIterationCost EstimateLoopIterationCost(const HloComputation* body) {
+  LoopIterationCost cost;
+  for (const HloInstruction* instr : body->instructions()) {
+    ++cost.num_instructions;
+    cost.has_collectives |=
+        hlo_query::IsCollectiveCommunicationOp(instr->opcode());
+    if (IsNoOp(instr)) continue;
+
+    ++cost.num_kernels;
+    cost.command_buffer_compatible &=
+        instr->opcode() != HloOpcode::kCustomCall &&
+        !instr->HasSideEffectNoRecurse();
+    cost.bytes_accessed += ByteSizeOfArrays(instr->shape());
+    for (const HloInstruction* operand : instr->operands()) {
+      cost.bytes_accessed += ByteSizeOfArrays(operand->shape());
+    }
+  }
+  return cost;
+}
+
+// Returns true if the loop will be executed as a command buffer with a
+// conditional node, in which case per-iteration kernel launch overheads are
+// amortized by the command buffer and unrolling doesn't help.
+bool IsCommandBufferLoop(const HloModule* module,
+                         const LoopIterationCost& cost) {
+  const auto& types =
+      module->config().debug_options().xla_gpu_enable_command_buffer();
+  return cost.command_buffer_compatible &&
+         absl::c_linear_search(types, DebugOptions::WHILE) &&
+         absl::c_linear_search(types, DebugOptions::FUSION);
+}
+
+// Picks the unrolling strategy for a loop based on a simple cost model:
+//
+//   (1) Loops with collectives are double buffered to overlap communication
+//       of one iteration with compute of another.
+//   (2) Launch bound loops (small kernels that don't amortize the launch
+//       overhead), that will not be captured into command buffers, are fully
+//       unrolled if the unrolled body stays within code size bounds.
+//   (3) Everything else is left as is.
 absl::StatusOr<bool> AutoUnroll(HloInstruction* while_instr,
-                                HloModule* module) {
+                                HloModule* module, int64_t trip_count) {
   CHECK_EQ(while_instr->opcode(), HloOpcode::kWhile);
 
-  bool any_collective_present = absl::c_any_of(
-      while_instr->while_body()->MakeInstructionPostOrder(),
-      [](HloInstruction* instr) {
-        return hlo_query::IsCollectiveCommunicationOp(instr->opcode());
-      });
-  if (any_collective_present) {
+  LoopIterationCost cost = EstimateLoopIterationCost(while_instr->while_body());
+
+  if (cost.has_collectives) {
     return DoubleBufferingUnroll(while_instr, module);
   }
+
+  bool launch_bound =
+      cost.num_kernels > 0 &&
+      cost.bytes_accessed <= cost.num_kernels * kLaunchBoundBytesPerKernel;
+  bool fits_code_size =
+      trip_count * cost.num_instructions <= kAutoFullUnrollMaxInstructions;
+
+  VLOG(2) << absl::StrFormat(
+      "Auto unroll %s: trip_count=%d, #instructions=%d, #kernels=%d, "
+      "bytes_accessed=%d, launch_bound=%v, fits_code_size=%v",
+      while_instr->name(), trip_count, cost.num_instructions, cost.num_kernels,
+      cost.bytes_accessed, launch_bound, fits_code_size);
+
+  if (launch_bound && fits_code_size && !IsCommandBufferLoop(module, cost)) {
+    return FullyUnroll(while_instr, module);
+  }
+
   return false;  // IR not changed.
 }
 
@@ -573,7 +665,9 @@ absl::StatusOr<bool> DoubleBufferLoopUnrolling::Run(
     } else if (unroll_strategy_ == UnrollStrategy::kDoubleBuffer) {
       TF_ASSIGN_OR_RETURN(changed, DoubleBufferingUnroll(while_instr, module));
     } else if (unroll_strategy_ == UnrollStrategy::kAuto) {
-      TF_ASSIGN_OR_RETURN(changed, AutoUnroll(while_instr, module));
+      TF_ASSIGN_OR_RETURN(
+          changed,
+          AutoUnroll(while_instr, module, config.known_trip_count().n()));
     } else {
       LOG(FATAL) << absl::StrCat("Unhandled unrolling strategy: ",
                                  unroll_strategy_);
@@ -43,6 +43,14 @@ namespace gpu {
 //   passes (like `WhileLoopSimplifier`) to simplify/get rid of the while loop
 //   eventually.
 //
+// With `kAuto` strategy:
+//   This pass picks the strategy for each loop using a simple cost model.
+//   Loops with collectives are double buffered to overlap communication with
+//   compute. Loops without collectives that are bound by kernel launch
+//   overheads (small kernels) and will not execute as command buffers are
+//   fully unrolled if the unrolled loop body stays within a code size bound.
+//   All other loops are not changed.
+//
 // Note that this pass will flatten the call graph if any loop has been
 // unrolled.
 class DoubleBufferLoopUnrolling : public HloModulePass {
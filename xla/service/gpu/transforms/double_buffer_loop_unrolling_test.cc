@@ -156,6 +156,93 @@ ENTRY main {
   EXPECT_EQ(config.known_trip_count().n(), 10);
 }
 
+TEST_F(GpuLoopDoubleBufferTransformerTest,
+       AutoFullyUnrollLaunchBoundLoopWithoutCommandBuffers) {
+  absl::string_view kModuleString = R"(
+HloModule m
+condition {
+  input_tuple = (f32[128], s32[]) parameter(0)
+  cond = s32[] get-tuple-element(input_tuple), index=1
+  trip_count = s32[] constant(10)
+  ROOT done = pred[] compare(cond, trip_count), direction=LT
+}
+
+body {
+  input_tuple = (f32[128], s32[]) parameter(0)
+  data = f32[128] get-tuple-element(input_tuple), index=0
+  cond = s32[] get-tuple-element(input_tuple), index=1
+  add = f32[128] add(data, data)
+  one = s32[] constant(1)
+  cond_plus_1 = s32[] add(cond, one)
+  ROOT output_tuple = (f32[128], s32[]) tuple(add, cond_plus_1)
+}
+
+ENTRY main {
+  param_0 = f32[128] parameter(0)
+  param_1 = s32[] constant(0)
+  tuple = (f32[128], s32[]) tuple(param_0, param_1)
+  ROOT while = (f32[128], s32[]) while(tuple), condition=condition, body=body, backend_config={"known_trip_count":{"n":"10"}}
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<xla::HloModule> module,
+                          ParseAndReturnVerifiedModule(kModuleString));
+  // Without command buffers every loop iteration pays kernel launch overheads.
+  module->mutable_config()
+      .mutable_debug_options()
+      .clear_xla_gpu_enable_command_buffer();
+
+  DoubleBufferLoopUnrolling unroller(
+      DoubleBufferLoopUnrolling::UnrollStrategy::kAuto);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, unroller.Run(module.get()));
+  EXPECT_TRUE(changed);
+
+  HloInstruction* while_instruction = hlo_query::GetFirstInstructionWithOpcode(
+      *module->entry_computation(), HloOpcode::kWhile);
+  TF_ASSERT_OK_AND_ASSIGN(
+      WhileLoopBackendConfig config,
+      while_instruction->backend_config<WhileLoopBackendConfig>());
+  EXPECT_EQ(config.known_trip_count().n(), 1);
+}
+
+TEST_F(GpuLoopDoubleBufferTransformerTest, DoNotAutoUnrollBandwidthBoundLoop) {
+  absl::string_view kModuleString = R"(
+HloModule m
+condition {
+  input_tuple = (f32[1024,1024], s32[]) parameter(0)
+  cond = s32[] get-tuple-element(input_tuple), index=1
+  trip_count = s32[] constant(10)
+  ROOT done = pred[] compare(cond, trip_count), direction=LT
+}
+
+body {
+  input_tuple = (f32[1024,1024], s32[]) parameter(0)
+  data = f32[1024,1024] get-tuple-element(input_tuple), index=0
+  cond = s32[] get-tuple-element(input_tuple), index=1
+  add = f32[1024,1024] add(data, data)
+  one = s32[] constant(1)
+  cond_plus_1 = s32[] add(cond, one)
+  ROOT output_tuple = (f32[1024,1024], s32[]) tuple(add, cond_plus_1)
+}
+
+ENTRY main {
+  param_0 = f32[1024,1024] parameter(0)
+  param_1 = s32[] constant(0)
+  tuple = (f32[1024,1024], s32[]) tuple(param_0, param_1)
+  ROOT while = (f32[1024,1024], s32[]) while(tuple), condition=condition, body=body, backend_config={"known_trip_count":{"n":"10"}}
+})";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<xla::HloModule> module,
+                          ParseAndReturnVerifiedModule(kModuleString));
+  module->mutable_config()
+      .mutable_debug_options()
+      .clear_xla_gpu_enable_command_buffer();
+
+  DoubleBufferLoopUnrolling unroller(
+      DoubleBufferLoopUnrolling::UnrollStrategy::kAuto);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, unroller.Run(module.get()));
+  EXPECT_FALSE(changed);
+}
+
 TEST_F(GpuLoopDoubleBufferTransformerTest, FullUnrollOddTripCountTest) {
   const char* const kModuleString = R"(
 HloModule all_gather_overlapping
@@ -41,6 +41,7 @@ limitations under the License.
 #include "xla/service/hlo_cost_analysis.h"
 #include "xla/service/instruction_fusion.h"
 #include "xla/stream_executor/device_description.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/statusor.h"
 
@@ -54,7 +55,8 @@ using ::mlir::MLIRContext;
 absl::StatusOr<bool> ProcessFusionInstruction(
     HloFusionInstruction* fusion_instruction,
     const se::DeviceDescription& device_info,
-    HloCostAnalysis::ShapeSizeFunction shape_size, MLIRContext* ctx) {
+    HloCostAnalysis::ShapeSizeFunction shape_size, MLIRContext* ctx,
+    tsl::thread::ThreadPool* thread_pool) {
   const HloComputation* fusion_computation =
       fusion_instruction->fused_instructions_computation();
   if (CodegenDecision can_codegen = IsTritonSupportedComputation(
@@ -84,7 +86,8 @@ absl::StatusOr<bool> ProcessFusionInstruction(
 
   TF_ASSIGN_OR_RETURN(
       TiledRunTimeDataOrError tiled_runtime_data_or_error,
-      indexing_performance_model.TryFindBestTilingForFusion(*fusion_adaptor));
+      indexing_performance_model.TryFindBestTilingForFusion(*fusion_adaptor,
+                                                            thread_pool));
 
   if (const auto* fusion_decision =
           std::get_if<FusionDecision>(&tiled_runtime_data_or_error)) {
@@ -145,8 +148,9 @@ absl::StatusOr<bool> FusionBlockLevelRewriter::Run(
     }
 
     TF_ASSIGN_OR_RETURN(
-        bool changed, ProcessFusionInstruction(fusion_instruction, device_info_,
-                                               shape_size_, &ctx));
+        bool changed,
+        ProcessFusionInstruction(fusion_instruction, device_info_, shape_size_,
+                                 &ctx, thread_pool_));
 
     has_changed |= changed;
   }
@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstdint>
 #include <initializer_list>
 #include <memory>
+#include <optional>
 #include <tuple>
 #include <utility>
 #include <variant>
@@ -28,6 +29,7 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_casting_utils.h"
 #include "xla/hlo/ir/hlo_computation.h"
@@ -36,6 +38,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/layout.h"
 #include "xla/layout_util.h"
+#include "xla/permutation_util.h"
 #include "xla/primitive_util.h"
 #include "xla/service/gpu/backend_configs.pb.h"
 #include "xla/service/gpu/cublas_cudnn.h"
@@ -576,10 +579,69 @@ absl::Status GpuLayoutAssignment::AddBackendConstraints(
   return absl::OkStatus();
 }
 
+std::optional<Shape> GpuLayoutAssignment::GetCopyFreeDotOperandShape(
+    const HloInstruction* dot, int64_t operand) const {
+  std::vector<const HloInstruction*> transposes;
+  const HloInstruction* source = dot->operand(operand);
+  while (source->opcode() == HloOpcode::kTranspose) {
+    transposes.push_back(source);
+    source = source->operand(0);
+  }
+  if (!source->shape().IsArray()) {
+    return std::nullopt;
+  }
+  absl::StatusOr<const LogicalBuffer*> buffer =
+      points_to_analysis_->GetBufferDefinedAt(source, /*index=*/{});
+  if (!buffer.ok()) {
+    return std::nullopt;
+  }
+  const BufferLayoutConstraint* constraint =
+      GetBufferLayoutConstraint(**buffer);
+  if (constraint == nullptr) {
+    return std::nullopt;
+  }
+
+  // Walk from the constrained buffer towards the dot and pick the layout that
+  // makes each transpose a bitcast.
+  Layout layout = constraint->layout();
+  for (auto it = transposes.rbegin(); it != transposes.rend(); ++it) {
+    const HloInstruction* transpose = *it;
+    std::vector<int64_t> inverse_dimensions =
+        InversePermutation(transpose->dimensions());
+    std::vector<int64_t> minor_to_major(transpose->shape().dimensions_size());
+    for (int64_t i = 0; i < minor_to_major.size(); ++i) {
+      minor_to_major[i] = inverse_dimensions[LayoutUtil::Minor(layout, i)];
+    }
+    layout = LayoutUtil::MakeLayout(minor_to_major);
+  }
+
+  Shape shape = dot->operand(operand)->shape();
+  *shape.mutable_layout() = layout;
+  return shape;
+}
+
 absl::Status GpuLayoutAssignment::SetDotOperandLayout(
     const HloInstruction* instruction, int64_t operand,
     absl::Span<const int64_t> batch_dims, absl::Span<const int64_t> row_dims,
     absl::Span<const int64_t> col_dims) {
+  // Avoid copies in front of the dot if a layout of the operand that doesn't
+  // need one is supported by the matmul.
+  if (instruction->GetModule()
+          ->config()
+          .debug_options()
+          .xla_gpu_experimental_copy_aware_dot_operand_layouts()) {
+    std::optional<Shape> copy_free_shape =
+        GetCopyFreeDotOperandShape(instruction, operand);
+    if (copy_free_shape.has_value() &&
+        MatrixLayout::For(*copy_free_shape, batch_dims, row_dims, col_dims)
+            .ok()) {
+      VLOG(3) << "Using copy-free layout "
+              << ShapeUtil::HumanStringWithLayout(*copy_free_shape)
+              << " for operand " << operand << " of " << instruction->name();
+      return SetOperandLayout(*copy_free_shape, instruction, operand);
+    }
+  }
+
   Shape shape = instruction->operand(operand)->shape();
 
   // First, try to use the existing layout, if present.
@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <cstdint>
 #include <initializer_list>
+#include <optional>
 
 #include "absl/status/status.h"
 #include "absl/types/span.h"
@@ -25,6 +26,7 @@ limitations under the License.
 #include "xla/hlo/ir/hlo_instructions.h"
 #include "xla/service/computation_layout.h"
 #include "xla/service/layout_assignment.h"
+#include "xla/shape.h"
 #include "xla/stream_executor/device_description.h"
 #include "xla/stream_executor/dnn.h"
 
@@ -59,6 +61,13 @@ class GpuLayoutAssignment : public LayoutAssignment {
       const HloInstruction* instruction, int64_t operand,
       std::initializer_list<absl::Span<const int64_t>> dim_groups);
 
+  // Returns the shape of `operand` of `dot` with the layout that makes the
+  // chain of transposes producing it bitcasts of a buffer whose layout is
+  // already constrained, e.g. an entry parameter. Using this layout for the
+  // dot operand avoids a physical transpose of the operand.
+  std::optional<Shape> GetCopyFreeDotOperandShape(const HloInstruction* dot,
+                                                  int64_t operand) const;
+
   absl::Status SetDotOperandLayout(const HloInstruction* instruction,
                                    int64_t operand,
                                    absl::Span<const int64_t> batch_dims,
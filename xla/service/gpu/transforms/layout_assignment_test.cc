@@ -237,6 +237,39 @@ TEST_F(LayoutAssignmentTest, DotOperandInconsistentDimLayouts) {
                         m::Op().WithShape(F32, {6, 5, 3, 4}, {3, 2, 0, 1}))));
 }
 
+TEST_F(LayoutAssignmentTest, CopyAwareDotOperandLayoutMakesTransposeBitcast) {
+  const char* hlo_text = R"(
+  HloModule DotLayout
+  ENTRY dot {
+    p0 = f32[5,3,2]{2,1,0} parameter(0)
+    p1 = f32[5,3,4]{2,1,0} parameter(1)
+    transpose = f32[5,2,3] transpose(p0), dimensions={0,2,1}
+    ROOT dot = f32[5,2,4]{2,1,0} dot(transpose, p1),
+      lhs_batch_dims={0}, lhs_contracting_dims={2},
+      rhs_batch_dims={0}, rhs_contracting_dims={1}
+  })";
+
+  TF_ASSERT_OK_AND_ASSIGN(std::unique_ptr<HloModule> module,
+                          ParseAndReturnVerifiedModule(hlo_text));
+  DebugOptions debug_options = module->config().debug_options();
+  debug_options.set_xla_gpu_experimental_copy_aware_dot_operand_layouts(true);
+  module->mutable_config().set_debug_options(debug_options);
+
+  ComputationLayout computation_layout(
+      module->entry_computation()->ComputeProgramShape(),
+      /*ignore_layouts=*/false);
+  GpuLayoutAssignment layout_assignment(
+      &computation_layout, GetGpuComputeCapability(), GetDnnVersion(),
+      GetDeviceDescription());
+
+  // The column-major lhs layout turns the transpose into a bitcast of p0.
+  EXPECT_THAT(layout_assignment.Run(module.get()), IsOkAndHolds(true));
+  EXPECT_THAT(module->entry_computation()->root_instruction(),
+              GmockMatch(m::Dot(m::Transpose(m::Parameter(0))
+                                    .WithShape(F32, {5, 2, 3}, {1, 2, 0}),
+                                m::Op().WithShape(F32, {5, 3, 4}, {2, 1, 0}))));
+}
+
 TEST_F(LayoutAssignmentTest, TransposedDotLayout) {
   const char* hlo_text = R"(
   HloModule DotLayout
@@ -172,9 +172,11 @@ class PriorityFusionQueue {
                                      .xla_dump_fusion_visualization();
 
     // Initializes the priority queue.
+    std::vector<HloInstruction*> post_order =
+        computation->MakeInstructionPostOrder();
+    TF_CHECK_OK(UpdatePerformanceModelCaches(post_order));
     std::vector<HloInstruction*> instructions;
-    for (auto* instruction : computation->MakeInstructionPostOrder()) {
-      TF_CHECK_OK(UpdatePerformanceModelCache(instruction));
+    for (auto* instruction : post_order) {
       if (HloPredicateIsOp<HloOpcode::kParameter>(instruction) ||
           instruction->user_count() == 0 || !instruction->IsFusible() ||
           HloPredicateIsOp<HloOpcode::kTuple, HloOpcode::kGetTupleElement>(
@@ -216,8 +218,9 @@ class PriorityFusionQueue {
     }
   }
 
-  std::vector<Priority> ComputePriorities(
-      const std::vector<HloInstruction*>& instructions) {
+  // Calls `fn` for every index in [0, n), on the thread pool if there is one,
+  // and waits for all calls to finish.
+  void ParallelFor(size_t n, const std::function<void(size_t)>& fn) {
     auto schedule_or_run = [this](std::function<void()> fn) {
       if (thread_pool_) {
         thread_pool_->Schedule(std::move(fn));
@@ -225,16 +228,22 @@ class PriorityFusionQueue {
         fn();
       }
     };
-    absl::BlockingCounter counter(instructions.size());
-    std::vector<Priority> priorities(instructions.size());
-
-    for (size_t i = 0; i < instructions.size(); ++i) {
+    absl::BlockingCounter counter(n);
+    for (size_t i = 0; i < n; ++i) {
       schedule_or_run([&, i] {
-        priorities[i] = CalculateProducerPriority(instructions[i]);
+        fn(i);
         counter.DecrementCount();
       });
     }
     counter.Wait();
+  }
+
+  std::vector<Priority> ComputePriorities(
+      const std::vector<HloInstruction*>& instructions) {
+    std::vector<Priority> priorities(instructions.size());
+    ParallelFor(instructions.size(), [&](size_t i) {
+      priorities[i] = CalculateProducerPriority(instructions[i]);
+    });
     return priorities;
   }
 
@@ -292,19 +301,33 @@ class PriorityFusionQueue {
     return absl::OkStatus();
   }
 
+  // Updates the performance model cache for all `producers` in parallel. The
+  // estimates of different instructions don't depend on each other, and all
+  // caches they use are thread-safe.
+  absl::Status UpdatePerformanceModelCaches(
+      const std::vector<HloInstruction*>& producers) {
+    std::vector<absl::Status> statuses(producers.size());
+    ParallelFor(producers.size(), [&](size_t i) {
+      statuses[i] = UpdatePerformanceModelCache(producers[i]);
+    });
+    for (const absl::Status& status : statuses) {
+      TF_RETURN_IF_ERROR(status);
+    }
+    return absl::OkStatus();
+  }
+
   // Update priorities of all affected ops.
   absl::Status UpdatePriorities() {
     // Revisit costs of all updated ops. It's important to update cost analysis
     // before recalculating priorities.
-    for (auto instruction : to_update_priority_) {
+    std::vector<HloInstruction*> instructions(to_update_priority_.begin(),
+                                              to_update_priority_.end());
+    for (auto instruction : instructions) {
       TF_RETURN_IF_ERROR(cost_analysis_.RevisitInstruction(instruction));
     }
-    for (auto producer : to_update_priority_) {
-      TF_RETURN_IF_ERROR(UpdatePerformanceModelCache(producer));
-    }
+    TF_RETURN_IF_ERROR(UpdatePerformanceModelCaches(instructions));
 
-    ComputeAndSetPriorities(std::vector<HloInstruction*>{
-        to_update_priority_.begin(), to_update_priority_.end()});
+    ComputeAndSetPriorities(instructions);
 
     to_update_priority_.clear();
     operands_to_new_consumers_.clear();
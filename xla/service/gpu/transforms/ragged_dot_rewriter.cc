@@ -0,0 +1,145 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/ragged_dot_rewriter.h"
+
+#include <cstdint>
+
+#include "absl/status/statusor.h"
+#include "xla/comparison_util.h"
+#include "xla/hlo/ir/hlo_casting_utils.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_instructions.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/literal_util.h"
+#include "xla/service/hlo_creation_utils.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/xla_data.pb.h"
+#include "tsl/platform/statusor.h"
+
+namespace xla::gpu {
+
+bool RaggedDotRewriter::InstructionMatchesPattern(HloInstruction* instruction) {
+  if (HloPredicateIsNotOp<HloOpcode::kRaggedDot>(instruction)) {
+    return false;
+  }
+  const RaggedDotDimensionNumbers& ragged_dnums =
+      Cast<HloRaggedDotInstruction>(instruction)
+          ->ragged_dot_dimension_numbers();
+  const DotDimensionNumbers& dnums = ragged_dnums.dot_dimension_numbers();
+
+  // We only support the [m,k], [g,k,n], [g] -> [m,n] form without batch
+  // dimensions, where the ragged dimension is the lhs non-contracting one.
+  if (instruction->operand(0)->shape().dimensions_size() != 2 ||
+      instruction->operand(1)->shape().dimensions_size() != 3 ||
+      instruction->operand(2)->shape().dimensions_size() != 1 ||
+      dnums.lhs_batch_dimensions_size() != 0 ||
+      dnums.lhs_contracting_dimensions_size() != 1 ||
+      dnums.rhs_contracting_dimensions_size() != 1 ||
+      ragged_dnums.lhs_ragged_dimensions_size() != 1 ||
+      ragged_dnums.rhs_group_dimensions_size() != 1) {
+    return false;
+  }
+  return ragged_dnums.lhs_ragged_dimensions(0) !=
+         dnums.lhs_contracting_dimensions(0);
+}
+
+absl::StatusOr<HloInstruction*> RaggedDotRewriter::ExpandInstruction(
+    HloInstruction* instruction) {
+  auto* ragged_dot = Cast<HloRaggedDotInstruction>(instruction);
+  HloComputation* computation = ragged_dot->parent();
+  HloInstruction* lhs = ragged_dot->mutable_operand(0);
+  HloInstruction* rhs = ragged_dot->mutable_operand(1);
+  HloInstruction* group_sizes = ragged_dot->mutable_operand(2);
+
+  const RaggedDotDimensionNumbers& ragged_dnums =
+      ragged_dot->ragged_dot_dimension_numbers();
+  const DotDimensionNumbers& dnums = ragged_dnums.dot_dimension_numbers();
+
+  int64_t lhs_ragged_dim = ragged_dnums.lhs_ragged_dimensions(0);
+  int64_t rhs_group_dim = ragged_dnums.rhs_group_dimensions(0);
+  int64_t rhs_contracting_dim = dnums.rhs_contracting_dimensions(0);
+  int64_t rhs_non_contracting_dim = 3 - rhs_group_dim - rhs_contracting_dim;
+
+  int64_t num_rows = lhs->shape().dimensions(lhs_ragged_dim);
+  int64_t num_groups = rhs->shape().dimensions(rhs_group_dim);
+
+  // In a regular dot the rhs group dimension is a non-contracting dimension,
+  // and it follows the lhs non-contracting dimension in the result.
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * dot,
+      MakeDotHlo(lhs, rhs, dnums, ragged_dot->precision_config(),
+                 ragged_dot->shape().element_type()));
+  int64_t dot_group_dim = rhs_group_dim < rhs_non_contracting_dim ? 1 : 2;
+
+  // Compute group ends as an inclusive prefix sum of group sizes:
+  //   ends[i] = sum(select(iota_j <= iota_i, group_sizes[j], 0), dims={j})
+  PrimitiveType index_type = group_sizes->shape().element_type();
+  HloInstruction* index_zero = computation->AddInstruction(
+      HloInstruction::CreateConstant(LiteralUtil::Zero(index_type)));
+
+  Shape groups_by_groups =
+      ShapeUtil::MakeShape(index_type, {num_groups, num_groups});
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * preceding,
+      MakeCompareHlo(ComparisonDirection::kLe,
+                     MakeIotaHlo(computation, groups_by_groups, 1),
+                     MakeIotaHlo(computation, groups_by_groups, 0)));
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * preceding_sizes,
+      MakeSelectHlo(preceding,
+                    MakeBroadcastHlo(group_sizes, {1}, groups_by_groups),
+                    MakeBroadcastHlo(index_zero, {}, groups_by_groups)));
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * ends,
+      MakeReduceHlo(preceding_sizes, index_zero, {1}, HloOpcode::kAdd));
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * starts,
+      MakeBinaryHlo(HloOpcode::kSubtract, ends, group_sizes));
+
+  // Rows that belong to each group: starts[g] <= row < ends[g]. Rows past the
+  // last group do not belong to any group, and their results are zeros.
+  Shape rows_by_groups =
+      ShapeUtil::MakeShape(index_type, {num_rows, num_groups});
+  HloInstruction* rows = MakeIotaHlo(computation, rows_by_groups, 0);
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * after_start,
+      MakeCompareHlo(ComparisonDirection::kGe, rows,
+                     MakeBroadcastHlo(starts, {1}, rows_by_groups)));
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * before_end,
+      MakeCompareHlo(ComparisonDirection::kLt, rows,
+                     MakeBroadcastHlo(ends, {1}, rows_by_groups)));
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * mask,
+      MakeBinaryHlo(HloOpcode::kAnd, after_start, before_end));
+
+  // Every row belongs to at most one group, so the sum over groups selects the
+  // product with the group's rhs.
+  HloInstruction* zero = computation->AddInstruction(
+      HloInstruction::CreateConstant(
+          LiteralUtil::Zero(dot->shape().element_type())));
+  TF_ASSIGN_OR_RETURN(
+      HloInstruction * selected,
+      MakeSelectHlo(
+          MakeBroadcastHlo(mask, {0, dot_group_dim},
+                           ShapeUtil::ChangeElementType(dot->shape(), PRED)),
+          dot, MakeBroadcastHlo(zero, {}, dot->shape())));
+  return MakeReduceHlo(selected, zero, {dot_group_dim}, HloOpcode::kAdd);
+}
+
+}  // namespace xla::gpu
@@ -0,0 +1,58 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_SERVICE_GPU_TRANSFORMS_RAGGED_DOT_REWRITER_H_
+#define XLA_SERVICE_GPU_TRANSFORMS_RAGGED_DOT_REWRITER_H_
+
+#include <utility>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/transforms/expanders/op_expander_pass.h"
+#include "xla/util.h"
+
+namespace xla::gpu {
+
+// Rewrites a ragged dot with a ragged non-contracting lhs dimension, i.e.
+// [m,k], [g,k,n], [g] -> [m,n], into a single dot of the lhs with all groups
+// of the rhs, followed by a selection of the group that each lhs row belongs
+// to:
+//
+//   dot = [m,g,n] dot([m,k], [g,k,n])
+//   ends = prefix_sum(group_sizes), starts = ends - group_sizes
+//   mask = [m,g] starts[g] <= iota(m) < ends[g]
+//   result = [m,n] reduce(select(broadcast(mask), dot, 0), dims={g})
+//
+// Group sizes stay on device, so experts of a mixture-of-experts layer run as
+// one large GEMM without host synchronization, at the cost of computing the
+// product of each row with every group.
+class RaggedDotRewriter : public OpExpanderPass {
+ public:
+  explicit RaggedDotRewriter(HloPredicate extra_filter = nullptr)
+      : OpExpanderPass(std::move(extra_filter)) {}
+
+  absl::string_view name() const override { return "ragged_dot_rewriter"; }
+
+ protected:
+  bool InstructionMatchesPattern(HloInstruction* instruction) override;
+
+  absl::StatusOr<HloInstruction*> ExpandInstruction(
+      HloInstruction* instruction) override;
+};
+
+}  // namespace xla::gpu
+
+#endif  // XLA_SERVICE_GPU_TRANSFORMS_RAGGED_DOT_REWRITER_H_
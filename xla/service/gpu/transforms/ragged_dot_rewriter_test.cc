@@ -0,0 +1,102 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/service/gpu/transforms/ragged_dot_rewriter.h"
+
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/testlib/pattern_matcher_gmock.h"
+#include "xla/service/pattern_matcher.h"
+#include "xla/tests/hlo_test_base.h"
+#include "tsl/platform/status_matchers.h"
+#include "tsl/platform/statusor.h"
+#include "tsl/platform/test.h"
+
+namespace xla::gpu {
+namespace {
+
+namespace m = ::xla::match;
+
+using RaggedDotRewriterTest = HloTestBase;
+using ::tsl::testing::IsOkAndHolds;
+
+TEST_F(RaggedDotRewriterTest, RaggedNonContractingDim) {
+  constexpr char kHlo[] = R"(
+    HloModule test
+
+    ENTRY main {
+      p0 = bf16[11,5] parameter(0)
+      p1 = bf16[3,5,7] parameter(1)
+      p2 = s32[3] parameter(2)
+      ROOT r = f32[11,7] ragged-dot(p0, p1, p2),
+        lhs_contracting_dims={1}, rhs_contracting_dims={1},
+        lhs_ragged_dims={0}, rhs_group_dims={0}
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto m, ParseAndReturnVerifiedModule(kHlo));
+  EXPECT_THAT(RaggedDotRewriter().Run(m.get()), IsOkAndHolds(true));
+  EXPECT_THAT(
+      m->entry_computation()->root_instruction(),
+      GmockMatch(
+          m::Reduce(m::Select(m::Broadcast(m::And()),
+                              m::Dot(m::Parameter(0), m::Parameter(1))
+                                  .WithShape(F32, {11, 3, 7}),
+                              m::Broadcast(m::Constant())),
+                    m::Constant())
+              .WithShape(F32, {11, 7})));
+}
+
+TEST_F(RaggedDotRewriterTest, RaggedNonContractingDimWithMinorGroupDim) {
+  constexpr char kHlo[] = R"(
+    HloModule test
+
+    ENTRY main {
+      p0 = f32[5,11] parameter(0)
+      p1 = f32[5,7,3] parameter(1)
+      p2 = s64[3] parameter(2)
+      ROOT r = f32[11,7] ragged-dot(p0, p1, p2),
+        lhs_contracting_dims={0}, rhs_contracting_dims={0},
+        lhs_ragged_dims={1}, rhs_group_dims={2}
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto m, ParseAndReturnVerifiedModule(kHlo));
+  EXPECT_THAT(RaggedDotRewriter().Run(m.get()), IsOkAndHolds(true));
+  EXPECT_THAT(
+      m->entry_computation()->root_instruction(),
+      GmockMatch(m::Reduce(m::Select(m::Broadcast(),
+                                     m::Dot().WithShape(F32, {11, 7, 3}),
+                                     m::Broadcast()),
+                           m::Constant())
+                     .WithShape(F32, {11, 7})));
+}
+
+TEST_F(RaggedDotRewriterTest, RaggedContractingDimIsNotRewritten) {
+  constexpr char kHlo[] = R"(
+    HloModule test
+
+    ENTRY main {
+      p0 = f32[11,5] parameter(0)
+      p1 = f32[5,7] parameter(1)
+      p2 = s32[3] parameter(2)
+      ROOT r = f32[3,11,7] ragged-dot(p0, p1, p2),
+        lhs_contracting_dims={1}, rhs_contracting_dims={0},
+        lhs_ragged_dims={1}
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto m, ParseAndReturnVerifiedModule(kHlo));
+  EXPECT_THAT(RaggedDotRewriter().Run(m.get()), IsOkAndHolds(false));
+}
+
+}  // namespace
+}  // namespace xla::gpu
@@ -172,7 +172,9 @@ void GraphCycles::RemoveEdge(int32_t x, int32_t y) {
 }
 
 static bool ForwardDFS(GraphCycles::Rep* r, int32_t n, int32_t upper_bound);
-static void BackwardDFS(GraphCycles::Rep* r, int32_t n, int32_t lower_bound);
+static bool ContinueForwardDFS(GraphCycles::Rep* r, int32_t upper_bound);
+static void BackwardDFS(GraphCycles::Rep* r, absl::Span<const int32_t> roots,
+                        int32_t lower_bound);
 static void Reorder(GraphCycles::Rep* r);
 static void Sort(absl::Span<const Node>, std::vector<int32_t>* delta);
 static void MoveToList(GraphCycles::Rep* r, std::vector<int32_t>* src,
@@ -210,19 +212,26 @@ bool GraphCycles::InsertEdge(int32_t x, int32_t y) {
     ClearVisitedBits(r, r->deltaf_);
     return false;
   }
-  BackwardDFS(r, x, ny->rank);
+  BackwardDFS(r, {x}, ny->rank);
   Reorder(r);
   return true;
 }
 
 static bool ForwardDFS(GraphCycles::Rep* r, int32_t n, int32_t upper_bound) {
-  // Avoid recursion since stack space might be limited.
-  // We instead keep a stack of nodes to visit.
   r->deltaf_.clear();
   r->stack_.clear();
   r->stack_.push_back(n);
+  return ContinueForwardDFS(r, upper_bound);
+}
+
+// Runs a forward DFS from the nodes already on r->stack_, appending visited
+// nodes to r->deltaf_. Returns false if it reaches the node of rank
+// `upper_bound`.
+static bool ContinueForwardDFS(GraphCycles::Rep* r, int32_t upper_bound) {
+  // Avoid recursion since stack space might be limited.
+  // We instead keep a stack of nodes to visit.
   while (!r->stack_.empty()) {
-    n = r->stack_.back();
+    int32_t n = r->stack_.back();
     r->stack_.pop_back();
     Node* nn = &r->nodes_[n];
     if (nn->visited) continue;
@@ -244,12 +253,12 @@ static bool ForwardDFS(GraphCycles::Rep* r, int32_t n, int32_t upper_bound) {
   return true;
 }
 
-static void BackwardDFS(GraphCycles::Rep* r, int32_t n, int32_t lower_bound) {
+static void BackwardDFS(GraphCycles::Rep* r, absl::Span<const int32_t> roots,
+                        int32_t lower_bound) {
   r->deltab_.clear();
-  r->stack_.clear();
-  r->stack_.push_back(n);
+  r->stack_.assign(roots.begin(), roots.end());
   while (!r->stack_.empty()) {
-    n = r->stack_.back();
+    int32_t n = r->stack_.back();
     r->stack_.pop_back();
     Node* nn = &r->nodes_[n];
     if (nn->visited) continue;
@@ -373,51 +382,95 @@ bool GraphCycles::IsReachableNonConst(int32_t x, int32_t y) {
   return reachable;
 }
 
+// Returns whether `b` is reachable from `a` other than through the edge a->b.
+static bool IsReachableWithoutEdge(GraphCycles::Rep* r, int32_t a, int32_t b) {
+  // Any other path to `b` only goes through nodes ranked before it.
+  const int32_t upper_bound = r->nodes_[b].rank;
+  r->deltaf_.clear();
+  r->stack_.clear();
+  for (int32_t w : r->node_io_[a].out.GetSequence()) {
+    if (w != b && r->nodes_[w].rank < upper_bound) {
+      r->stack_.push_back(w);
+    }
+  }
+  bool reachable = !ContinueForwardDFS(r, upper_bound);
+
+  // Clear any visited markers left by ContinueForwardDFS.
+  ClearVisitedBits(r, r->deltaf_);
+  return reachable;
+}
+
 bool GraphCycles::CanContractEdge(int32_t a, int32_t b) {
   CHECK(HasEdge(a, b)) << "No edge exists from " << a << " to " << b;
-  RemoveEdge(a, b);
-  bool reachable = IsReachableNonConst(a, b);
-  // Restore the graph to its original state.
-  InsertEdge(a, b);
   // If reachable, then contracting edge will cause cycle.
-  return !reachable;
+  return !IsReachableWithoutEdge(rep_, a, b);
 }
 
 std::optional<int32_t> GraphCycles::ContractEdge(int32_t a, int32_t b) {
   CHECK(HasEdge(a, b));
-  RemoveEdge(a, b);
-
-  if (IsReachableNonConst(a, b)) {
-    // Restore the graph to its original state.
-    InsertEdge(a, b);
+  Rep* r = rep_;
+  if (IsReachableWithoutEdge(r, a, b)) {
     return std::nullopt;
   }
+  RemoveEdge(a, b);
 
-  if (rep_->node_io_[b].in.Size() + rep_->node_io_[b].out.Size() >
-      rep_->node_io_[a].in.Size() + rep_->node_io_[a].out.Size()) {
+  if (r->node_io_[b].in.Size() + r->node_io_[b].out.Size() >
+      r->node_io_[a].in.Size() + r->node_io_[a].out.Size()) {
     // Swap "a" and "b" to minimize copying.
     std::swap(a, b);
   }
 
-  NodeIO* nb_io = &rep_->node_io_[b];
+  // The merged node takes the rank of the edge source, which precedes all
+  // successors of both nodes. The removed node keeps the other rank, so the
+  // ranks in use stay a permutation.
+  if (r->nodes_[b].rank < r->nodes_[a].rank) {
+    std::swap(r->nodes_[a].rank, r->nodes_[b].rank);
+  }
+
+  NodeIO* nb_io = &r->node_io_[b];
   OrderedNodeSet out = std::move(nb_io->out);
   OrderedNodeSet in = std::move(nb_io->in);
   for (int32_t y : out.GetSequence()) {
-    rep_->node_io_[y].in.Erase(b);
+    r->node_io_[y].in.Erase(b);
   }
   for (int32_t y : in.GetSequence()) {
-    rep_->node_io_[y].out.Erase(b);
+    r->node_io_[y].out.Erase(b);
   }
-  rep_->free_nodes_.push_back(b);
+  r->free_nodes_.push_back(b);
 
-  rep_->node_io_[a].out.Reserve(rep_->node_io_[a].out.Size() + out.Size());
+  // The contraction can't create a cycle, so add the edges without checking
+  // them one by one.
+  NodeIO* na_io = &r->node_io_[a];
+  na_io->out.Reserve(na_io->out.Size() + out.Size());
   for (int32_t y : out.GetSequence()) {
-    InsertEdge(a, y);
+    if (na_io->out.Insert(y)) {
+      r->node_io_[y].in.Insert(a);
+    }
   }
-
-  rep_->node_io_[a].in.Reserve(rep_->node_io_[a].in.Size() + in.Size());
+  na_io->in.Reserve(na_io->in.Size() + in.Size());
   for (int32_t y : in.GetSequence()) {
-    InsertEdge(y, a);
+    if (na_io->in.Insert(y)) {
+      r->node_io_[y].out.Insert(a);
+    }
+  }
+
+  // Only predecessors of the edge target can now be ranked after the merged
+  // node. Move all of them before it with a single reordering, instead of
+  // running the search for each inserted edge.
+  const int32_t lower_bound = r->nodes_[a].rank;
+  int32_t upper_bound = lower_bound;
+  std::vector<int32_t> roots;
+  for (int32_t y : na_io->in.GetSequence()) {
+    if (r->nodes_[y].rank > lower_bound) {
+      roots.push_back(y);
+      upper_bound = std::max(upper_bound, r->nodes_[y].rank);
+    }
+  }
+  if (!roots.empty()) {
+    CHECK(ForwardDFS(r, a, upper_bound))
+        << "Contracting edge " << a << "->" << b << " created a cycle";
+    BackwardDFS(r, roots, lower_bound);
+    Reorder(r);
   }
 
   // Note, if the swap happened it might be what originally was called "b".
@@ -18,6 +18,7 @@ limitations under the License.
 #include "xla/service/graphcycles/graphcycles.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 #include <optional>
@@ -27,6 +28,7 @@ limitations under the License.
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/random/random.h"
+#include "absl/types/span.h"
 #include "tsl/platform/logging.h"
 #include "tsl/platform/test.h"
 #include "tsl/platform/test_benchmark.h"
@@ -496,6 +498,24 @@ TEST_F(GraphCyclesTest, ContractEdge) {
   EXPECT_TRUE(g_.HasEdge(2, 4));
 }
 
+TEST_F(GraphCyclesTest, ContractEdgeReordersPredecessors) {
+  // After contracting 1->4, node 3 precedes the merged node and node 2
+  // follows it, so their ranks must be swapped.
+  ASSERT_TRUE(AddEdge(1, 4));
+  ASSERT_TRUE(AddEdge(1, 2));
+  ASSERT_TRUE(AddEdge(3, 4));
+  ASSERT_TRUE(AddEdge(2, 5));
+  ASSERT_TRUE(AddEdge(5, 6));
+
+  std::optional<int32_t> merged = g_.ContractEdge(1, 4);
+  ASSERT_TRUE(merged.has_value());
+  CHECK(g_.CheckInvariants());
+  EXPECT_TRUE(g_.HasEdge(3, *merged));
+  EXPECT_TRUE(g_.HasEdge(*merged, 2));
+  EXPECT_TRUE(g_.IsReachable(3, 6));
+  EXPECT_FALSE(AddEdge(6, 3));
+}
+
 TEST_F(GraphCyclesTest, CanContractEdge) {
   ASSERT_TRUE(AddEdge(1, 2));
   ASSERT_TRUE(AddEdge(1, 3));
@@ -557,6 +577,45 @@ static void BM_ContractEdge(::testing::benchmark::State &state) {
 }
 BENCHMARK(BM_ContractEdge)->Arg(1000)->Arg(10000);
 
+// Contracts random edges of a DAG where each node has a few successors among
+// the next few hundred nodes, similar to what fusion passes do on large HLO
+// graphs.
+static void BM_ContractRandomEdges(::testing::benchmark::State &state) {
+  const int num_nodes = state.range(0);
+  constexpr int kBranchFactor = 8;
+  constexpr int kWindow = 256;
+
+  absl::BitGen bitgen;
+  while (state.KeepRunningBatch(num_nodes)) {
+    state.PauseTiming();
+    xla::GraphCycles g;
+    std::vector<int32_t> nodes;
+    nodes.reserve(num_nodes);
+    for (int i = 0; i < num_nodes; i++) {
+      nodes.push_back(g.NewNode());
+    }
+    for (int i = 0; i < num_nodes - 1; i++) {
+      int max = std::min(kWindow, num_nodes - 1 - i);
+      for (int b = 0; b < kBranchFactor; b++) {
+        int j = i + 1 + absl::Uniform(bitgen, 0, max);
+        CHECK(g.InsertEdge(nodes[i], nodes[j]));
+      }
+    }
+
+    state.ResumeTiming();
+    for (int i = 0; i < num_nodes; i++) {
+      // Nodes removed by earlier contractions have no successors.
+      int32_t a = nodes[absl::Uniform(bitgen, 0, num_nodes)];
+      absl::Span<const int32_t> successors = g.Successors(a);
+      if (successors.empty()) continue;
+      int32_t b = successors[absl::Uniform<size_t>(bitgen, 0,
+                                                   successors.size())];
+      benchmark::DoNotOptimize(g.ContractEdge(a, b));
+    }
+  }
+}
+BENCHMARK(BM_ContractRandomEdges)->Arg(1000)->Arg(10000);
+
 static void BM_IsReachableNonConst(testing::benchmark::State &state) {
   const int num_nodes = state.range(0);
 
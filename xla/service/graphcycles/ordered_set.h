@@ -16,8 +16,12 @@ limitations under the License.
 #ifndef XLA_SERVICE_GRAPHCYCLES_ORDERED_SET_H_
 #define XLA_SERVICE_GRAPHCYCLES_ORDERED_SET_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/types/span.h"
 #include "tsl/platform/logging.h"
@@ -28,6 +32,10 @@ namespace xla {
 // inserts/deletes, so as long as the inserts/deletes happen in the same
 // sequence, the set will have the same iteration order.
 //
+// Small sets, which are the common case for node adjacency lists, are kept
+// only in a vector and searched linearly. The index is built once the set
+// grows past kMaxLinearSearchSize elements.
+//
 // Assumes that T can be cheaply copied for simplicity.
 template <typename T>
 class OrderedSet {
@@ -35,6 +43,16 @@ class OrderedSet {
   // Inserts `value` into the ordered set.  Returns true if the value was not
   // present in the set before the insertion.
   bool Insert(T value) {
+    if (value_to_index_.empty()) {
+      if (absl::c_linear_search(value_sequence_, value)) {
+        return false;
+      }
+      value_sequence_.push_back(value);
+      if (value_sequence_.size() > kMaxLinearSearchSize) {
+        BuildIndex();
+      }
+      return true;
+    }
     bool new_insertion =
         value_to_index_.insert({value, value_sequence_.size()}).second;
     if (new_insertion) {
@@ -46,6 +64,13 @@ class OrderedSet {
   // Removes `value` from the set.  Assumes `value` is already present in the
   // set.
   void Erase(T value) {
+    if (value_to_index_.empty()) {
+      auto it = absl::c_find(value_sequence_, value);
+      DCHECK(it != value_sequence_.end());
+      std::swap(*it, value_sequence_.back());
+      value_sequence_.pop_back();
+      return;
+    }
     auto it = value_to_index_.find(value);
     DCHECK(it != value_to_index_.end());
 
@@ -59,7 +84,9 @@ class OrderedSet {
   }
 
   void Reserve(size_t new_size) {
-    value_to_index_.reserve(new_size);
+    if (new_size > kMaxLinearSearchSize) {
+      value_to_index_.reserve(new_size);
+    }
     value_sequence_.reserve(new_size);
   }
 
@@ -68,16 +95,31 @@ class OrderedSet {
     value_sequence_.clear();
   }
 
-  bool Contains(T value) const { return value_to_index_.contains(value); }
+  bool Contains(T value) const {
+    if (value_to_index_.empty()) {
+      return absl::c_linear_search(value_sequence_, value);
+    }
+    return value_to_index_.contains(value);
+  }
   size_t Size() const { return value_sequence_.size(); }
 
   absl::Span<T const> GetSequence() const { return value_sequence_; }
 
  private:
+  static constexpr size_t kMaxLinearSearchSize = 16;
+
+  void BuildIndex() {
+    value_to_index_.reserve(value_sequence_.size());
+    for (size_t i = 0; i < value_sequence_.size(); ++i) {
+      value_to_index_[value_sequence_[i]] = i;
+    }
+  }
+
   // The stable order that we maintain through insertions and deletions.
   std::vector<T> value_sequence_;
 
-  // Maps values to their indices in `value_sequence_`.
+  // Maps values to their indices in `value_sequence_`. Empty while the set is
+  // small enough to search `value_sequence_` directly.
   absl::flat_hash_map<T, int> value_to_index_;
 };
 }  // namespace xla
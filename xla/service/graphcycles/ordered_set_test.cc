@@ -99,6 +99,29 @@ TEST(OrderedSetTest, Clear) {
   EXPECT_EQ(ordered_set.GetSequence(), expected_sequence);
 }
 
+TEST(OrderedSetTest, GrowAndShrink) {
+  OrderedSet<int> ordered_set;
+  for (int i = 0; i < 40; i++) {
+    EXPECT_TRUE(ordered_set.Insert(i));
+    EXPECT_FALSE(ordered_set.Insert(i));
+  }
+  for (int i = 0; i < 40; i += 2) {
+    ordered_set.Erase(i);
+  }
+
+  EXPECT_EQ(ordered_set.Size(), 20);
+  for (int i = 0; i < 40; i++) {
+    EXPECT_EQ(ordered_set.Contains(i), i % 2 == 1);
+  }
+  while (ordered_set.Size() > 0) {
+    int value = ordered_set.GetSequence().back();
+    EXPECT_EQ(value % 2, 1);
+    ordered_set.Erase(value);
+    EXPECT_FALSE(ordered_set.Contains(value));
+  }
+  EXPECT_EQ(ordered_set.Size(), 0);
+}
+
 TEST(OrderedSetTest, LargeInsertions) {
   const int kSize = 50 * 9000;
 
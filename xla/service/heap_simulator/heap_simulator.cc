@@ -836,26 +836,21 @@ bool BufferIntervalTree::Remove(int64_t start, int64_t end,
   }
   // Found the node to be deleted, enter deletion sequence.
 
-  // Recursively traverse the parents of node and fix up the `subtree_end`
-  // invariant of a node. Recursive lambda need an explicit
-  // std::function declaration.
-  std::function<void(BufferIntervalTreeNode*)> fix_up =
-      [&](BufferIntervalTreeNode* node) {
-        if (node == nullptr) {
-          return;
-        }
-        node->subtree_end = node->end;
-        if (node->left) {
-          node->subtree_end =
-              std::max(node->subtree_end, node->left->subtree_end);
-        }
-        if (node->right) {
-          node->subtree_end =
-              std::max(node->subtree_end, node->right->subtree_end);
-        }
-        // Recursively go up.
-        fix_up(node->parent);
-      };
+  // Traverse the parents of node and fix up the `subtree_end` invariant of
+  // each node.
+  auto fix_up = [](BufferIntervalTreeNode* node) {
+    for (; node != nullptr; node = node->parent) {
+      node->subtree_end = node->end;
+      if (node->left) {
+        node->subtree_end =
+            std::max(node->subtree_end, node->left->subtree_end);
+      }
+      if (node->right) {
+        node->subtree_end =
+            std::max(node->subtree_end, node->right->subtree_end);
+      }
+    }
+  };
 
   if (to_delete->right == nullptr) {
     // to_delete has no right child, simply move up left child of to_delete if
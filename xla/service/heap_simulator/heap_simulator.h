@@ -19,9 +19,9 @@ limitations under the License.
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <functional>
 #include <iostream>
-#include <list>
 #include <memory>
 #include <optional>
 #include <string>
@@ -427,7 +427,9 @@ class BufferIntervalTree {
       int64_t start, int64_t end) const;
 
   BufferIntervalTreeNode* root_ = nullptr;
-  std::list<BufferIntervalTreeNode> node_storage_;
+  // Nodes are never erased before the whole tree is destroyed, so a deque
+  // keeps them stable in memory while storing them in contiguous blocks.
+  std::deque<BufferIntervalTreeNode> node_storage_;
 };
 
 // An iterator that is passed to
@@ -390,6 +390,29 @@ ENTRY %axpy.v5 (alpha: f32[], x: f32[2,4], y: f32[2,4]) -> f32[2,4] {
   ASSERT_FALSE(module_copy->has_schedule());
 }
 
+TEST_F(HloModuleTest, CreateFromProtoReleasesLiterals) {
+  const std::string text = R"(
+HloModule constant_module
+
+ENTRY %main (x: f32[4]) -> f32[4] {
+  %x = f32[4]{0} parameter(0)
+  %constant = f32[4]{0} constant({1, 2, 3, 4})
+  ROOT %add = f32[4]{0} add(f32[4]{0} %x, f32[4]{0} %constant)
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(text));
+  HloModuleProto proto = module->ToProto();
+  TF_ASSERT_OK_AND_ASSIGN(
+      auto module_copy,
+      HloModule::CreateFromProto(std::move(proto), module->config()));
+  for (const HloComputationProto& computation : proto.computations()) {
+    for (const HloInstructionProto& instruction : computation.instructions()) {
+      EXPECT_FALSE(instruction.has_literal()) << instruction.name();
+    }
+  }
+  EXPECT_EQ(module_copy->ToString(), module->ToString());
+}
+
 TEST_F(HloModuleTest, ProtoSerializationWithSchedule) {
   const std::string text = R"(
 HloModule axpy_module, is_scheduled=true
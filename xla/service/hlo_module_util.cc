@@ -94,7 +94,11 @@ absl::StatusOr<std::unique_ptr<HloModule>> ReadModuleFromBinaryProtoFile(
   HloProto proto;
   TF_RETURN_IF_ERROR(
       tsl::ReadBinaryProto(tsl::Env::Default(), std::string(filename), &proto));
-  return CreateModuleFromProto(proto.hlo_module(), debug_options);
+  TF_ASSIGN_OR_RETURN(HloModuleConfig config,
+                      HloModule::CreateModuleConfigFromProto(proto.hlo_module(),
+                                                             debug_options));
+  return HloModule::CreateFromProto(std::move(*proto.mutable_hlo_module()),
+                                    config);
 }
 
 absl::StatusOr<std::unique_ptr<HloModule>> ReadModuleFromHloTextFile(
@@ -113,7 +117,11 @@ absl::StatusOr<std::unique_ptr<HloModule>> ReadModuleFromTextProtoFile(
   HloProto proto;
   TF_RETURN_IF_ERROR(
       tsl::ReadTextProto(tsl::Env::Default(), std::string(hlo_file), &proto));
-  return CreateModuleFromProto(proto.hlo_module(), debug_options);
+  TF_ASSIGN_OR_RETURN(HloModuleConfig config,
+                      HloModule::CreateModuleConfigFromProto(proto.hlo_module(),
+                                                             debug_options));
+  return HloModule::CreateFromProto(std::move(*proto.mutable_hlo_module()),
+                                    config);
 }
 
 absl::StatusOr<std::unique_ptr<HloModule>> ReadModuleFromModuleBinaryProtofile(
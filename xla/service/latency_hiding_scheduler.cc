@@ -840,24 +840,37 @@ DefaultSchedulerCore::ScheduleCandidate InitializeCandidate(
 
 namespace {
 
-// Find the num hops to the closest selective resource overlap in ready set that
-// provided node can be scheduled in between.
-int64_t GetNumHopsToClosestSelectiveOverlap(
-    const DefaultSchedulerCore::ReadyQueueSet& ready_set,
-    const HloGraphNode* node) {
-  int64_t num_hops_to_closest_selective_resource_occupier =
-      std::numeric_limits<int64_t>::max();
-  for (const HloGraphNode* n : ready_set) {
-    // Skip the node itself.
-    if (n == node) {
-      continue;
+// Number of hops to the closest selective resource overlap in the ready set
+// that a node can be scheduled in between. The two smallest distances are
+// computed once for the whole ready set so that the distance for any node
+// (which excludes the node itself) can be queried in constant time instead of
+// scanning the ready set for every comparison.
+class SelectiveOverlapDistances {
+ public:
+  explicit SelectiveOverlapDistances(
+      const DefaultSchedulerCore::ReadyQueueSet& ready_set) {
+    for (const HloGraphNode* n : ready_set) {
+      int64_t num_hops = n->GetNumHopsToClosestSelectiveResourceOccupier();
+      if (num_hops < min_num_hops_) {
+        second_min_num_hops_ = min_num_hops_;
+        min_num_hops_ = num_hops;
+        min_node_ = n;
+      } else if (num_hops < second_min_num_hops_) {
+        second_min_num_hops_ = num_hops;
+      }
     }
-    num_hops_to_closest_selective_resource_occupier =
-        std::min(num_hops_to_closest_selective_resource_occupier,
-                 n->GetNumHopsToClosestSelectiveResourceOccupier());
   }
-  return num_hops_to_closest_selective_resource_occupier;
-}
+
+  int64_t GetNumHopsToClosestSelectiveOverlap(const HloGraphNode* node) const {
+    // Skip the node itself.
+    return node == min_node_ ? second_min_num_hops_ : min_num_hops_;
+  }
+
+ private:
+  const HloGraphNode* min_node_ = nullptr;
+  int64_t min_num_hops_ = std::numeric_limits<int64_t>::max();
+  int64_t second_min_num_hops_ = std::numeric_limits<int64_t>::max();
+};
 
 // Comparator for the ready set. This class represents the priority policies
 // for the nodes in the ready set. The policy can be whatever is appropriate to
@@ -874,7 +887,14 @@ class ReadySetLt {
       DefaultSchedulerCore::TargetSchedulingRule early_target_scheduling_rule)
       : sched_state_(*sched_state),
         target_scheduling_rule_(target_scheduling_rule),
-        early_target_scheduling_rule_(early_target_scheduling_rule) {}
+        early_target_scheduling_rule_(early_target_scheduling_rule) {
+    // The ready set doesn't change while the comparator is alive, so compute
+    // selective overlap distances only once.
+    if (sched_state_.config.enable_selective_resources &&
+        sched_state_.selective_resource_releasers.empty()) {
+      selective_overlap_distances_.emplace(sched_state_.ready_set);
+    }
+  }
   // The comparison here implements the priority for the nodes in the ready set.
   DefaultSchedulerCore::CandidateResult operator()(
       DefaultSchedulerCore::ScheduleCandidate& a,
@@ -1127,12 +1147,13 @@ class ReadySetLt {
     // If there are no selective overlaps open currently and there will be
     // overlaps opened in the near future, hold off scheduling instructions
     // that are valuable for selective overlaps.
-    if (sched_state_.config.enable_selective_resources &&
-        sched_state_.selective_resource_releasers.empty()) {
+    if (selective_overlap_distances_.has_value()) {
       int64_t distance_to_selective_overlap_for_a =
-          GetNumHopsToClosestSelectiveOverlap(sched_state_.ready_set, a.node);
+          selective_overlap_distances_->GetNumHopsToClosestSelectiveOverlap(
+              a.node);
       int64_t distance_to_selective_overlap_for_b =
-          GetNumHopsToClosestSelectiveOverlap(sched_state_.ready_set, b.node);
+          selective_overlap_distances_->GetNumHopsToClosestSelectiveOverlap(
+              b.node);
       // If a is valuable for selective overlap and there is a selective
       // overlap in the near future a can be scheduled inside, hold off
       // scheduling a and schedule b instead. Same logic applies in reverse.
@@ -1186,6 +1207,7 @@ class ReadySetLt {
   DefaultSchedulerCore::TargetSchedulingRule early_target_scheduling_rule_;
   DefaultSchedulerCore::OverlapLimitRule
       scheduling_instruction_crosses_overlap_limit_;
+  std::optional<SelectiveOverlapDistances> selective_overlap_distances_;
 
   int ReadyIfScheduled(const HloGraphNode& gn) const {
     int ready_nodes_if_scheduled = 0;
@@ -2816,6 +2838,13 @@ absl::StatusOr<bool> LatencyHidingScheduler::Run(
     saved_schedules[computation] = std::move(new_schedule);
   }
   uint64_t initial_memory_limit = scheduler_core_->GetMemoryLimit();
+  // Reruns with lower memory limits trade overlap for memory. If none of them
+  // fits in the initial limit, keep the schedule with the lowest memory peak
+  // instead of the most conservative one, as lowering the limit further does
+  // not necessarily reduce the peak.
+  int64_t best_memory_peak = scheduler_core_->GetMemoryPeak();
+  absl::flat_hash_map<HloComputation*, std::vector<HloInstruction*>>
+      best_schedules = saved_schedules;
   for (int64_t iter = 0;
        iter < scheduler_core_->GetRerunTimes() &&
        scheduler_core_->GetMemoryPeak() > initial_memory_limit;
@@ -2833,15 +2862,19 @@ absl::StatusOr<bool> LatencyHidingScheduler::Run(
                           scheduler_core_->ScheduleComputation(computation));
       saved_schedules[computation] = std::move(new_schedule);
     }
+    if (scheduler_core_->GetMemoryPeak() < best_memory_peak) {
+      best_memory_peak = scheduler_core_->GetMemoryPeak();
+      best_schedules = saved_schedules;
+    }
   }
   LOG(INFO) << "LatencyHidingScheduler current memory usage: "
-            << scheduler_core_->GetMemoryPeak()
+            << best_memory_peak
             << " bytes. Current limit: " << scheduler_core_->GetMemoryLimit();
   for (HloComputation* computation : computations_to_schedule) {
     VLOG(1) << "Statistics before scheduling:";
     LogScheduleStatistics(computation);
     module->schedule().set_sequence(
-        computation, absl::MakeConstSpan(saved_schedules[computation]));
+        computation, absl::MakeConstSpan(best_schedules[computation]));
     VLOG(1) << "Statistics after scheduling:";
     LogScheduleStatistics(computation);
   }
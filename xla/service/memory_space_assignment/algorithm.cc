@@ -345,6 +345,16 @@ CrossProgramPrefetches FindCrossProgramPrefetches(
                options.buffer_interval_comparator
            ? options.buffer_interval_comparator
            : &default_comparator);
+  CostAnalysis::Cache cost_analysis_cache;
+  std::optional<MemoryBoundednessBufferIntervalComparator>
+      memory_boundedness_comparator;
+  if (options.cross_program_prefetch_by_memory_boundedness &&
+      options.cost_analysis != nullptr) {
+    memory_boundedness_comparator.emplace(*options.cost_analysis,
+                                          &cost_analysis_cache,
+                                          options.msa_sort_order_overrides);
+    comparator = &*memory_boundedness_comparator;
+  }
   absl::c_sort(cross_program_prefetches.candidates,
                comparator->GetComparisonFunctor());
 
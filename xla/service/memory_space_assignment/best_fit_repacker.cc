@@ -132,6 +132,8 @@ Step 5: Update AllocationBlocks with the repacking placements
 #include "absl/log/log.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/comparison_util.h"
 #include "xla/service/heap_simulator/allocation_block.h"
@@ -169,6 +171,21 @@ const SlicedAllocationData* GetSlicedAllocationDataPointer(
   return &(*sliced_allocation_data);
 }
 
+// The order in which buffers are placed during repacking. All orders break
+// ties using the remaining keys and then the buffer itself.
+enum class RepackOrder {
+  // Longest live range first, then largest size.
+  kDurationFirst,
+  // Largest size first, then longest live range.
+  kSizeFirst,
+  // Earliest start time first, then largest size.
+  kStartTimeFirst,
+};
+
+// Orders that are tried, in turn, if the default order does not fit.
+constexpr RepackOrder kAlternativeRepackOrders[] = {
+    RepackOrder::kSizeFirst, RepackOrder::kStartTimeFirst};
+
 // A slice-aware best-fit repacker.
 class BestFitRepacker
     : public GlobalDecreasingSizeBestFitHeap<AllocationBlock> {
@@ -177,11 +194,13 @@ class BestFitRepacker
       const memory_space_assignment::MemorySpaceAssignmentBestFitRepacker::
           BestFitRepackOptions& options,
       SliceTimePermutationIterator::Ty slice_time_permutation_iterator_type,
-      int64_t max_size, int64_t alignment)
+      int64_t max_size, int64_t alignment,
+      RepackOrder order = RepackOrder::kDurationFirst)
       : GlobalDecreasingSizeBestFitHeap<AllocationBlock>(
             alignment, kCustom,
-            (options.buffer_interval_compare ? options.buffer_interval_compare
-                                             : DefaultBufferIntervalCompare()),
+            (options.buffer_interval_compare
+                 ? options.buffer_interval_compare
+                 : BufferIntervalCompareForOrder(order)),
             slice_time_permutation_iterator_type),
         validate_(options.validate),
         max_size_(max_size) {}
@@ -302,27 +321,66 @@ class BestFitRepacker
     }();
   }
 
+  // Returns the end time of the full buffer interval of x, extended to cover
+  // all of its colocations.
+  int64_t FullBufferIntervalEnd(const BufferInterval& x) const {
+    int64_t full_buffer_interval_end =
+        full_buffer_interval_map_.at(x.buffer).end;
+
+    // GetTranstivieColocations must be called on BufferIntervals from
+    // buffer_intervals_.
+    for (auto colocation : GetTransitiveColocations(x)) {
+      full_buffer_interval_end =
+          std::max(full_buffer_interval_end,
+                   full_buffer_interval_map_.at(colocation).end);
+    }
+    return full_buffer_interval_end;
+  }
+
   BufferIntervalCompare DefaultBufferIntervalCompare() const {
     return LessThanByKey([this](const BufferInterval& x) {
       const BufferInterval& full_buffer_interval =
           full_buffer_interval_map_.at(x.buffer);
-      int64_t full_buffer_interval_end = full_buffer_interval.end;
-
-      // GetTranstivieColocations must be called on BufferIntervals from
-      // buffer_intervals_.
-      for (auto colocation : GetTransitiveColocations(x)) {
-        full_buffer_interval_end =
-            std::max(full_buffer_interval_end,
-                     full_buffer_interval_map_.at(colocation).end);
-      }
 
       // Sort by duration (descending), size (descending), buffer (ascending).
       return std::make_tuple(
-          full_buffer_interval.start - full_buffer_interval_end,
+          full_buffer_interval.start - FullBufferIntervalEnd(x),
           -full_buffer_interval.size, std::cref(*full_buffer_interval.buffer));
     });
   }
 
+  BufferIntervalCompare BufferIntervalCompareForOrder(
+      RepackOrder order) const {
+    switch (order) {
+      case RepackOrder::kDurationFirst:
+        break;
+      case RepackOrder::kSizeFirst:
+        return LessThanByKey([this](const BufferInterval& x) {
+          const BufferInterval& full_buffer_interval =
+              full_buffer_interval_map_.at(x.buffer);
+
+          // Sort by size (descending), duration (descending), buffer
+          // (ascending).
+          return std::make_tuple(
+              -full_buffer_interval.size,
+              full_buffer_interval.start - FullBufferIntervalEnd(x),
+              std::cref(*full_buffer_interval.buffer));
+        });
+      case RepackOrder::kStartTimeFirst:
+        return LessThanByKey([this](const BufferInterval& x) {
+          const BufferInterval& full_buffer_interval =
+              full_buffer_interval_map_.at(x.buffer);
+
+          // Sort by start time (ascending), size (descending), buffer
+          // (ascending).
+          return std::make_tuple(full_buffer_interval.start,
+                                 -full_buffer_interval.size,
+                                 std::cref(*full_buffer_interval.buffer));
+        });
+    }
+    return DefaultBufferIntervalCompare();
+  }
+
   // CommitChunks() does the following:
   // 1) Commits chunks to interval_tree_.
   // 2) Updates the entries in new_offsets_ and new_repacked_slicing_ for
@@ -637,7 +695,31 @@ absl::StatusOr<bool> MemorySpaceAssignmentBestFitRepacker::Repack(
   BestFitRepacker best_fit_repacker = BestFitRepacker(
       options_, slice_time_permutation_iterator_type_, max_size_, alignment_);
   best_fit_repacker.ImportAllocationBlocks(allocations);
-  return best_fit_repacker.Repack();
+  if (best_fit_repacker.Repack()) {
+    return true;
+  }
+  if (!options_.try_alternative_orders ||
+      options_.buffer_interval_compare != nullptr) {
+    return false;
+  }
+
+  // Failed repacking attempts leave the allocation blocks untouched, so we can
+  // retry with a fresh repacker for each alternative order.
+  absl::Time deadline = absl::Now() + options_.alternative_orders_time_budget;
+  for (RepackOrder order : kAlternativeRepackOrders) {
+    if (absl::Now() >= deadline) {
+      VLOG(1) << "Repacking time budget exhausted";
+      break;
+    }
+    BestFitRepacker alternative_repacker =
+        BestFitRepacker(options_, slice_time_permutation_iterator_type_,
+                        max_size_, alignment_, order);
+    alternative_repacker.ImportAllocationBlocks(allocations);
+    if (alternative_repacker.Repack()) {
+      return true;
+    }
+  }
+  return false;
 }
 
 }  // namespace memory_space_assignment
@@ -20,6 +20,7 @@ limitations under the License.
 #include <utility>
 
 #include "absl/status/statusor.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/service/heap_simulator/allocation_block.h"
 #include "xla/service/heap_simulator/heap_simulator.h"
@@ -45,6 +46,14 @@ class MemorySpaceAssignmentBestFitRepacker
     // Specify the comparison function used for determining the order in which
     // buffers will be allocated, during repacking.
     BufferIntervalCompare buffer_interval_compare = nullptr;
+
+    // If the repacking does not fit with the default buffer order, retry it
+    // with alternative buffer orders until one of them fits or the time
+    // budget runs out. The budget is checked between attempts, so it bounds
+    // the number of retries rather than interrupting one. Ignored if
+    // buffer_interval_compare is set.
+    bool try_alternative_orders = false;
+    absl::Duration alternative_orders_time_budget = absl::Milliseconds(100);
   };
 
   MemorySpaceAssignmentBestFitRepacker(
@@ -507,4 +507,31 @@ TEST_F(MemorySpaceAssignmentBestFitRepackerTest,
                 {{AllocatedSlice{2, 2, 11}, AllocatedSlice{3, 4, 16}}})));
 }
 
+
+TEST_F(MemorySpaceAssignmentBestFitRepackerTest, AlternativeOrderFits) {
+  // Placing the longest block A first pushes B up, and C no longer fits in the
+  // hole below B. Placing the largest block C first fits all blocks in 5.
+  std::vector<AllocationBlock*> allocation_blocks;
+  // Block A
+  allocation_blocks.push_back(MakeAllocationBlock(3, 8, 2));
+  // Block B
+  allocation_blocks.push_back(MakeAllocationBlock(8, 9, 1));
+  // Block C
+  allocation_blocks.push_back(MakeAllocationBlock(9, 9, 4));
+
+  repacker_ = memory_space_assignment::MemorySpaceAssignmentBestFitRepacker(
+      5, 1, SliceTimePermutationIterator::Ty::kAll, options_);
+  EXPECT_FALSE(*repacker_.Repack(absl::MakeSpan(allocation_blocks)));
+  EXPECT_EQ(allocation_blocks[0]->offset, -1);
+
+  options_.try_alternative_orders = true;
+  repacker_ = memory_space_assignment::MemorySpaceAssignmentBestFitRepacker(
+      5, 1, SliceTimePermutationIterator::Ty::kAll, options_);
+  EXPECT_TRUE(*repacker_.Repack(absl::MakeSpan(allocation_blocks)));
+
+  EXPECT_EQ(allocation_blocks[0]->offset, 0);
+  EXPECT_EQ(allocation_blocks[1]->offset, 4);
+  EXPECT_EQ(allocation_blocks[2]->offset, 0);
+}
+
 }  // namespace xla
@@ -415,11 +415,15 @@ MemorySpaceAssignment::RunMemorySpaceAssignment(
   TF_RETURN_IF_ERROR(VerifyAndExportHeapSimulatorTrace(
       *alias,
       runtime_simulator.has_value() ? &alt_mem_bytes_occupied : nullptr));
-  if (VLOG_IS_ON(2) && runtime_simulator.has_value()) {
+  if ((VLOG_IS_ON(2) || options_.simulate_elapsed_time) &&
+      runtime_simulator.has_value()) {
     float estimated_time = runtime_simulator->SimulateElapsedTime(
         module_, allocations_, &alt_mem_bytes_occupied);
-    LOG(INFO) << "Estimated elapsed time with async copies (sec): "
-              << estimated_time;
+    VLOG(2) << "Estimated elapsed time with async copies (sec): "
+            << estimated_time;
+    if (options_.simulate_elapsed_time) {
+      preset_assignments_->set_estimated_elapsed_time(estimated_time);
+    }
   }
   if (VLOG_IS_ON(3)) {
     LOG(INFO) << "Module after memory space assignment: ";
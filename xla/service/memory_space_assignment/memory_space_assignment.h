@@ -180,6 +180,7 @@ Useful logging and error messages
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -258,6 +259,16 @@ class PresetAssignments {
     return assignment_info_;
   }
 
+  // The elapsed time of the module estimated by the runtime simulator after
+  // memory space assignment. Only set if Options::simulate_elapsed_time is
+  // true and a cost analysis is provided.
+  std::optional<float> estimated_elapsed_time() const {
+    return estimated_elapsed_time_;
+  }
+  void set_estimated_elapsed_time(float estimated_elapsed_time) {
+    estimated_elapsed_time_ = estimated_elapsed_time;
+  }
+
   // Get debugging information.
   std::string buffer_info_str() const { return buffer_info_str_; }
   std::string allocation_info_str() const { return allocation_info_str_; }
@@ -273,6 +284,7 @@ class PresetAssignments {
   std::string buffer_info_str_;
   std::string allocation_info_str_;
   std::string instruction_schedule_str_;
+  std::optional<float> estimated_elapsed_time_;
 };
 
 // MemorySpaceAssignment assigns memory spaces (default or alternate) to each
@@ -10040,6 +10040,63 @@ TEST_F(MemorySpaceAssignmentTest, MultiCrossProgramPrefetchTest) {
                             op::Parameter(2))));
 }
 
+TEST_F(MemorySpaceAssignmentTest, SimulateElapsedTime) {
+  absl::string_view hlo_string = R"(
+HloModule module, is_scheduled=true
+
+ENTRY entry {
+  p0 = f32[8,8] parameter(0)
+  p1 = f32[8,8] parameter(1)
+  negate0 = f32[8,8] negate(p0)
+  negate1 = f32[8,8] negate(negate0)
+  ROOT add = f32[8,8] add(negate1, p1)
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  Options options = DefaultMemorySpaceOptions();
+  std::unique_ptr<PresetAssignments> preset_assignments =
+      AssignMemorySpaceUsingCostAnalysis(module.get(), options);
+  EXPECT_FALSE(preset_assignments->estimated_elapsed_time().has_value());
+
+  TF_ASSERT_OK_AND_ASSIGN(module, ParseAndReturnVerifiedModule(hlo_string));
+  options.simulate_elapsed_time = true;
+  preset_assignments =
+      AssignMemorySpaceUsingCostAnalysis(module.get(), options);
+  ASSERT_TRUE(preset_assignments->estimated_elapsed_time().has_value());
+  EXPECT_GT(*preset_assignments->estimated_elapsed_time(), 0);
+}
+
+TEST_F(MemorySpaceAssignmentTest,
+       MultiCrossProgramPrefetchByMemoryBoundednessTest) {
+  absl::string_view hlo_string = R"(
+HloModule module, is_scheduled=true
+
+ENTRY entry {
+  lhs = f32[8,8] parameter(0)
+  first_weight = f32[8,4] parameter(1)
+  second_weight = f32[4,2] parameter(2)
+  first_dot = f32[8,4] dot(lhs, first_weight), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+  ROOT second_dot = f32[8,2] dot(first_dot, second_weight), lhs_contracting_dims={1}, rhs_contracting_dims={0}
+}
+)";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(hlo_string));
+  Options options = DefaultMemorySpaceOptions();
+  options.max_cross_program_prefetches = -1;
+  options.cross_program_prefetch_by_memory_boundedness = true;
+  options.max_size_in_bytes = 256;
+  options.alignment_in_bytes = 8;
+  options.verify = true;
+  AssignMemorySpaceUsingCostAnalysis(module.get(), options);
+
+  auto cross_program_prefetches = module->CrossProgramPrefetches();
+  ASSERT_EQ(cross_program_prefetches.size(), 2);
+  EXPECT_THAT(std::vector<int64_t>({cross_program_prefetches[0].parameter,
+                                    cross_program_prefetches[1].parameter}),
+              UnorderedElementsAre(1, 2));
+}
+
 TEST_F(MemorySpaceAssignmentTest, CrossProgramPrefetchTupleTest) {
   HloComputation::Builder builder(TestName());
 
@@ -271,6 +271,13 @@ struct Options {
   // buffers.
   bool verify = false;
 
+  // If true and cost_analysis is set, the runtime simulator estimates the
+  // elapsed time of the module after memory space assignment and reports it
+  // in PresetAssignments::estimated_elapsed_time(). This allows callers to
+  // compare alternative options, e.g., prefetch interval picker overlap
+  // ratios, and keep the best one.
+  bool simulate_elapsed_time = false;
+
   // If not nullptr, this function is called to dump debugging information.
   // The first argument is appended to the file name and the second argument
   // is the contents of the file.
@@ -284,6 +291,12 @@ struct Options {
   // prefetch across program boundaries.
   bool default_cross_program_prefetch_heuristic = false;
 
+  // If true and cost_analysis is set, rank cross-program prefetch candidates
+  // by their memory boundedness, i.e., the benefit of placing them in the
+  // alternate memory, instead of by size. Takes precedence over
+  // default_cross_program_prefetch_heuristic.
+  bool cross_program_prefetch_by_memory_boundedness = false;
+
   // Enable cross-program prefetch freeing optimization where the
   // cross-program-prefetched buffer can be reused.
   bool enable_cross_program_prefetch_freeing = true;
@@ -20,6 +20,7 @@ limitations under the License.
 #include <optional>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
@@ -901,15 +902,52 @@ bool CheckOutputDependency(HloComputation* to_apply, int operand_size) {
   return true;
 }
 
+// Returns the number of distinct window start positions that the scatter
+// indices can address in the operand.
+int64_t NumPossibleScatterIndices(const HloScatterInstruction* scatter) {
+  const ScatterDimensionNumbers& dim_numbers =
+      scatter->scatter_dimension_numbers();
+  const Shape& operand_shape = scatter->scatter_operands()[0]->shape();
+  const Shape& updates_shape = scatter->scatter_updates()[0]->shape();
+
+  // Window sizes of operand dimensions, which are 1 for inserted and batching
+  // dimensions.
+  std::vector<int64_t> window_sizes(operand_shape.dimensions_size(), 1);
+  int64_t update_window_dim = 0;
+  for (int64_t i = 0; i < operand_shape.dimensions_size(); ++i) {
+    if (absl::c_linear_search(dim_numbers.inserted_window_dims(), i) ||
+        absl::c_linear_search(dim_numbers.input_batching_dims(), i)) {
+      continue;
+    }
+    window_sizes[i] = updates_shape.dimensions(
+        dim_numbers.update_window_dims(update_window_dim++));
+  }
+
+  int64_t num_possible_indices = 1;
+  for (int64_t operand_dim : dim_numbers.scatter_dims_to_operand_dims()) {
+    num_possible_indices *=
+        std::max<int64_t>(1, operand_shape.dimensions(operand_dim) -
+                                 window_sizes[operand_dim] + 1);
+  }
+  return num_possible_indices;
+}
+
 }  // namespace
 
 bool ScatterDeterminismExpander::InstructionMatchesPattern(
     HloInstruction* inst) {
   auto* scatter = DynCast<HloScatterInstruction>(inst);
-
-  return (scatter != nullptr) && !IsScatterDeterministic(scatter) &&
-         CheckOutputDependency(scatter->to_apply(),
-                               scatter->scatter_operands().size());
+  if (scatter == nullptr || IsScatterDeterministic(scatter) ||
+      !CheckOutputDependency(scatter->to_apply(),
+                             scatter->scatter_operands().size())) {
+    return false;
+  }
+  if (min_updates_per_index_.has_value() &&
+      ScatterIndicesCount(scatter) <
+          *min_updates_per_index_ * NumPossibleScatterIndices(scatter)) {
+    return false;
+  }
+  return true;
 }
 
 }  // namespace xla
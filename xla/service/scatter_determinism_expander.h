@@ -16,6 +16,12 @@ limitations under the License.
 #ifndef XLA_SERVICE_SCATTER_DETERMINISM_EXPANDER_H_
 #define XLA_SERVICE_SCATTER_DETERMINISM_EXPANDER_H_
 
+#include <cstdint>
+#include <optional>
+
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/transforms/expanders/op_expander_pass.h"
 
 namespace xla {
@@ -24,9 +30,18 @@ namespace xla {
 // ensures the scatter results to be determininstic. Note that the computation
 // after the expansion still contains a scatter operation, but it does not have
 // duplicated indices and hence the results are guaranteed to be deterministic.
+//
+// Since the expanded scatter combines colliding updates before writing them, it
+// also avoids serializing atomic updates on hot rows, e.g. in embedding
+// gradient scatters with skewed indices. If `min_updates_per_index` is set,
+// only scatters with at least that many updates per possible distinct index
+// are expanded, so the pass can be used as an optimization for scatters that
+// are statically known to collide heavily.
 class ScatterDeterminismExpander : public OpExpanderPass {
  public:
-  explicit ScatterDeterminismExpander() = default;
+  explicit ScatterDeterminismExpander(
+      std::optional<int64_t> min_updates_per_index = std::nullopt)
+      : min_updates_per_index_(min_updates_per_index) {}
 
   absl::string_view name() const override {
     return "scatter_determinism_expander";
@@ -37,6 +52,9 @@ class ScatterDeterminismExpander : public OpExpanderPass {
 
   absl::StatusOr<HloInstruction*> ExpandInstruction(
       HloInstruction* inst) override;
+
+ private:
+  std::optional<int64_t> min_updates_per_index_;
 };
 
 }  // namespace xla
@@ -178,6 +178,48 @@ TEST_F(ScatterDeterminismExpanderTest, DoNotEliminateScatterWithOneUpdate) {
   EXPECT_FALSE(result);
 }
 
+TEST_F(ScatterDeterminismExpanderTest,
+       EliminateOnlyHeavilyCollidingScatterWithMinUpdatesPerIndex) {
+  const char* const kModuleStr = R"(
+    HloModule scatter_determinism_expander
+
+    scatter_computation {
+      arg1.173 = f32[] parameter(1)
+      arg0.172 = f32[] parameter(0)
+      ROOT add.48 = f32[] add(arg0.172, arg1.173)
+    }
+
+    ENTRY scatter_add_computation {
+      operand = f32[16,8] parameter(0)
+      indices = s32[256,1] parameter(1)
+      updates = f32[256,8] parameter(2)
+      ROOT scatter.48 = f32[16,8] scatter(operand, indices, updates),
+        update_window_dims={1}, inserted_window_dims={0},
+        scatter_dims_to_operand_dims={0}, index_vector_dim=1,
+        to_apply=scatter_computation
+    })";
+
+  {
+    TF_ASSERT_OK_AND_ASSIGN(auto module,
+                            ParseAndReturnVerifiedModule(kModuleStr));
+    // 256 updates into 16 rows, i.e. 16 updates per index.
+    ScatterDeterminismExpander scatter_determinism_expander(
+        /*min_updates_per_index=*/32);
+    TF_ASSERT_OK_AND_ASSIGN(
+        bool result, RunHloPass(&scatter_determinism_expander, module.get()));
+    EXPECT_FALSE(result);
+  }
+  {
+    TF_ASSERT_OK_AND_ASSIGN(auto module,
+                            ParseAndReturnVerifiedModule(kModuleStr));
+    ScatterDeterminismExpander scatter_determinism_expander(
+        /*min_updates_per_index=*/16);
+    TF_ASSERT_OK_AND_ASSIGN(
+        bool result, RunHloPass(&scatter_determinism_expander, module.get()));
+    EXPECT_TRUE(result);
+  }
+}
+
 TEST_F(ScatterDeterminismExpanderTest, ScalarScatterAddCorrectnessTest) {
   const char* const kModuleStr = R"(
     HloModule scatter_determinism_expander
@@ -2847,6 +2847,16 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
   absl::flat_hash_set<const HloInstruction*> already_inferred_from_users;
   bool changed_last_iter = true;
   const bool may_merge_partial = is_spmd_ && aggressiveness > 0;
+  // Propagation only updates shardings and never changes the graph, so the
+  // post order of every computation can be computed once for all iterations.
+  // On large modules rebuilding it in every iteration dominates the runtime.
+  std::vector<std::pair<const HloComputation*, std::vector<HloInstruction*>>>
+      computation_post_orders;
+  for (const HloComputation* computation :
+       module->computations(execution_threads)) {
+    computation_post_orders.emplace_back(
+        computation, computation->MakeInstructionPostOrder());
+  }
   while (changed_last_iter) {
     changed_last_iter = false;
     int64_t inferred_from_shard_group_counter = 0;
@@ -2854,11 +2864,11 @@ absl::StatusOr<bool> ShardingPropagation::RunToFixPoint(
     int64_t inferred_from_user_counter = 0;
     int64_t instruction_counter = 0;
     int64_t already_sharded_counter = 0;
-    for (const HloComputation* computation :
-         module->computations(execution_threads)) {
+    for (const auto& computation_post_order : computation_post_orders) {
+      const HloComputation* computation = computation_post_order.first;
+      const std::vector<HloInstruction*>& instructions =
+          computation_post_order.second;
       VLOG(2) << "Consider computation: " << computation->name();
-      std::vector<HloInstruction*> instructions =
-          computation->MakeInstructionPostOrder();
 
       instruction_counter += instructions.size();
       already_sharded_counter += absl::c_count_if(
@@ -69,7 +69,9 @@ int main(int argc, char* argv[]) {
       tsl::Flag("gpu_target_config",
                 &options.gpu_options.gpu_target_config_path,
                 "The path to a text-format GpuTargetConfig. If not provided, "
-                "an attached GPU will be used."),
+                "an attached GPU will be used. A comma-separated list of "
+                "paths compiles for every target and writes a "
+                "MultiTargetAotCompilationResult to --output_file."),
       tsl::Flag("autotune_results", &options.gpu_options.autotune_results_path,
                 "The path to AutotuneResults, optional when compiling for"
                 " GPU. Only used if autotuning is enabled in XLA_FLAGS."),
@@ -226,6 +226,11 @@ Shape* Shape::add_tuple_shapes() {
 }
 
 bool Shape::Equal::operator()(const Shape& lhs, const Shape& rhs) {
+  // A shape is equal to itself under any combination of ignored properties.
+  if (&lhs == &rhs) {
+    return true;
+  }
+
   if (lhs.IsTuple()) {
     return rhs.IsTuple() &&
            absl::c_equal(
@@ -255,16 +260,23 @@ bool Shape::Equal::operator()(const Shape& lhs, const Shape& rhs) {
       VLOG(3) << "CompareShapes: lhs rank != rhs rank";
       return false;
     }
-    for (int i = 0; i < lhs.dimensions_size(); ++i) {
-      if (ignore_dynamic_dimension_ &&
-          (lhs.is_unbounded_dynamic_dimension(i) ||
-           rhs.is_unbounded_dynamic_dimension(i))) {
-        continue;
-      }
-      if (lhs.dimensions(i) != rhs.dimensions(i)) {
+    if (!ignore_dynamic_dimension_) {
+      // Fast path: compare all dimensions at once.
+      if (lhs.dimensions() != rhs.dimensions()) {
         VLOG(3) << "CompareShapes: lhs dimensions != rhs dimensions";
         return false;
       }
+    } else {
+      for (int i = 0; i < lhs.dimensions_size(); ++i) {
+        if (lhs.is_unbounded_dynamic_dimension(i) ||
+            rhs.is_unbounded_dynamic_dimension(i)) {
+          continue;
+        }
+        if (lhs.dimensions(i) != rhs.dimensions(i)) {
+          VLOG(3) << "CompareShapes: lhs dimensions != rhs dimensions";
+          return false;
+        }
+      }
     }
   } else {
     if (!ShapeUtil::SameRank(lhs, rhs)) {
@@ -304,14 +316,10 @@ bool Shape::Equal::operator()(const Shape& lhs, const Shape& rhs) {
     }
   }
 
-  if (!ignore_dynamic_dimension_) {
-    for (int i = 0; i < lhs.dimensions_size(); ++i) {
-      if (lhs.is_dynamic_dimension(i) != rhs.is_dynamic_dimension(i)) {
-        VLOG(3)
-            << "CompareShapes: lhs and rhs have different dynamic dimensions.";
-        return false;
-      }
-    }
+  if (!ignore_dynamic_dimension_ &&
+      lhs.dynamic_dimensions() != rhs.dynamic_dimensions()) {
+    VLOG(3) << "CompareShapes: lhs and rhs have different dynamic dimensions.";
+    return false;
   }
   return true;
 }
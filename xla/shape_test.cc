@@ -126,6 +126,23 @@ TEST_F(ShapeTest, EqualityTest) {
             ShapeUtil::MakeShapeWithDenseLayout(F32, {23, 44}, {1, 0}));
 }
 
+TEST_F(ShapeTest, EqualDynamicDimensions) {
+  Shape dynamic_matrix = matrix_;
+  dynamic_matrix.set_dynamic_dimension(1, true);
+  EXPECT_NE(matrix_, dynamic_matrix);
+  EXPECT_TRUE(Shape::Equal().IgnoreDynamicDimension()(matrix_, dynamic_matrix));
+
+  Shape unbounded_matrix = matrix_;
+  unbounded_matrix.set_unbounded_dynamic_dimension(0);
+  EXPECT_NE(matrix_, unbounded_matrix);
+  EXPECT_TRUE(
+      Shape::Equal().IgnoreDynamicDimension()(matrix_, unbounded_matrix));
+
+  // Shapes are always equal to themselves.
+  EXPECT_EQ(unbounded_matrix, unbounded_matrix);
+  EXPECT_EQ(nested_tuple_, nested_tuple_);
+}
+
 TEST_F(ShapeTest, AreAllLeavesIntegers) {
   EXPECT_FALSE(opaque_.AreAllLeavesIntegers());
   EXPECT_FALSE(token_.AreAllLeavesIntegers());
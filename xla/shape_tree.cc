@@ -17,6 +17,8 @@ limitations under the License.
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <utility>
 
 #include "absl/log/check.h"
 #include "xla/shape.h"
@@ -26,34 +28,46 @@ limitations under the License.
 namespace xla {
 namespace internal {
 
-IndexTable::IndexTable(const Shape& shape) : entries_(1) {
+IndexTable::IndexTable(const Shape& shape) {
+  if (!shape.IsTuple()) {
+    // All array shapes have the same single-entry index table. The aliasing
+    // constructor with an empty owner gives a shared pointer without a control
+    // block, so copies of it don't touch any reference counts.
+    static const Entries* const kLeafEntries = new Entries{Entry{0}};
+    entries_ = std::shared_ptr<const Entries>(std::shared_ptr<const void>(),
+                                              kLeafEntries);
+    return;
+  }
+
+  auto entries = std::make_shared<Entries>(1);
+  entries->reserve(ShapeUtil::SubshapeCount(shape));
   size_t next_node_id = 0;
-  CreateEntry(entries_[0], shape, next_node_id);
+  CreateEntry(*entries, 0, shape, next_node_id);
+  entries_ = std::move(entries);
 }
 
-// TODO(cjfj): Index table cache?.
-void IndexTable::CreateEntry(Entry& entry, const Shape& shape,
-                             size_t& next_node_id) {
-  entry.node_id = next_node_id++;
+void IndexTable::CreateEntry(Entries& entries, size_t entry_id,
+                             const Shape& shape, size_t& next_node_id) {
+  entries[entry_id].node_id = next_node_id++;
   if (!shape.IsTuple()) return;
 
   // The nodes are in depth-first pre-order. However, in order to efficiently
   // lookup indices, we generate the index table using breadth-first.
-  size_t children_start_id = entries_.size();
-  entry.children_start_id = children_start_id;
+  size_t children_start_id = entries.size();
+  entries[entry_id].children_start_id = children_start_id;
   // Add entry for children first, before recursing, so they are consecutive.
-  entries_.resize(entries_.size() + shape.tuple_shapes_size());
+  entries.resize(entries.size() + shape.tuple_shapes_size());
   for (size_t i = 0; i < shape.tuple_shapes_size(); ++i) {
-    CreateEntry(entries_[children_start_id + i], shape.tuple_shapes(i),
+    CreateEntry(entries, children_start_id + i, shape.tuple_shapes(i),
                 next_node_id);
   }
 }
 
 const IndexTable::Entry& IndexTable::operator[](ShapeIndexView index) const {
-  const Entry* result = &entries_.front();
+  const Entry* result = &entries_->front();
   for (int64_t i : index) {
     CHECK_GE(result->children_start_id, 0);
-    result = &entries_[result->children_start_id + i];
+    result = &(*entries_)[result->children_start_id + i];
   }
   return *result;
 }
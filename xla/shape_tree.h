@@ -41,6 +41,10 @@ namespace xla {
 
 namespace internal {
 
+// Index table for ShapeTree node lookups. Entries are immutable once built and
+// shared between copies of the table, so copying a ShapeTree (or mapping it to
+// a tree of a different type) doesn't rebuild or copy the index. Array shapes
+// share a single static table and don't allocate at all.
 class IndexTable {
  public:
   // Use indices, rather than pointers, so index table can be copied between
@@ -55,14 +59,17 @@ class IndexTable {
   IndexTable() = default;
   explicit IndexTable(const Shape& shape);
 
-  bool empty() const { return entries_.empty(); }
+  bool empty() const { return entries_ == nullptr; }
 
   const Entry& operator[](ShapeIndexView index) const;
 
  private:
-  void CreateEntry(Entry& entry, const Shape& shape, size_t& next_node_id);
+  using Entries = absl::InlinedVector<Entry, 1>;
 
-  absl::InlinedVector<Entry, 1> entries_;
+  static void CreateEntry(Entries& entries, size_t entry_id,
+                          const Shape& shape, size_t& next_node_id);
+
+  std::shared_ptr<const Entries> entries_;
 };
 
 }  // namespace internal
@@ -290,8 +297,7 @@ class ShapeTree {
       result_nodes.push_back({node.first, func(node.second)});
     }
 
-    ShapeTree<U> result(shape_, std::move(result_nodes));
-    result.index_table_ = index_table_;
+    ShapeTree<U> result(shape_, std::move(result_nodes), index_table_);
     result.shape_storage_ = shape_storage_;
     return result;
   }
@@ -306,8 +312,7 @@ class ShapeTree {
       result_nodes.push_back({node.first, std::move(result)});
     }
 
-    ShapeTree<U> result(shape_, std::move(result_nodes));
-    result.index_table_ = index_table_;
+    ShapeTree<U> result(shape_, std::move(result_nodes), index_table_);
     result.shape_storage_ = shape_storage_;
     return result;
   }
@@ -372,7 +377,12 @@ class ShapeTree {
   }
 
   ShapeTree(const Shape* shape, Nodes nodes)
-      : nodes_(std::move(nodes)), index_table_(*shape), shape_(shape) {
+      : ShapeTree(shape, std::move(nodes), IndexTable(*shape)) {}
+
+  ShapeTree(const Shape* shape, Nodes nodes, IndexTable index_table)
+      : nodes_(std::move(nodes)),
+        index_table_(std::move(index_table)),
+        shape_(shape) {
     DCHECK_EQ(nodes_.size(), ShapeUtil::SubshapeCount(*shape));
   }
 
@@ -390,7 +400,8 @@ class ShapeTree {
   Nodes nodes_;
 
   // Index table for node lookups. Each entry contains the index of the first
-  // child of the node at that index, or -1 for leaf nodes. Evaluated lazily.
+  // child of the node at that index, or -1 for leaf nodes. Shared with the
+  // trees this one was copied or mapped from.
   IndexTable index_table_;
 
   // If we own our Shape, this field contains it, and shape_ is a pointer into
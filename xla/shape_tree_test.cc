@@ -413,6 +413,27 @@ TEST_F(ShapeTreeTest, CopyAssignWithPointerToShape) {
   EXPECT_EQ(&dest.shape(), &nested_tuple_shape_);
 }
 
+TEST_F(ShapeTreeTest, MapSharesIndexTable) {
+  ShapeTree<int> source(&nested_tuple_shape_, 0);
+  *source.mutable_element({1, 0}) = 10;
+  *source.mutable_element({2, 0, 1}) = 42;
+
+  ShapeTree<int64_t> mapped =
+      source.Map<int64_t>([](const int& value) { return value * 2; });
+  EXPECT_EQ(mapped.element({}), 0);
+  EXPECT_EQ(mapped.element({1, 0}), 20);
+  EXPECT_EQ(mapped.element({2, 0, 1}), 84);
+  EXPECT_TRUE(mapped.IsLeaf({2, 1}));
+  EXPECT_FALSE(mapped.IsLeaf({2, 0}));
+
+  // Mutating a copy doesn't affect the tree it was copied from.
+  ShapeTree<int64_t> copy = mapped;
+  *copy.mutable_element({1, 0}) = 1;
+  EXPECT_EQ(mapped.element({1, 0}), 20);
+  EXPECT_EQ(copy.element({1, 0}), 1);
+  EXPECT_EQ(copy.element({2, 0, 1}), 84);
+}
+
 TEST_F(ShapeTreeTest, IterateSimple) {
   ShapeTree<int> t(nested_tuple_shape_, 42);
   int num_nodes = 0;
@@ -253,6 +253,7 @@ std::ostream& operator<<(std::ostream& out, const ShapeIndex& shape_index) {
   const int ndims = dimensions.size();
   auto layout = shape->mutable_layout();
   auto* minor_to_major = layout->mutable_minor_to_major();
+  minor_to_major->reserve(ndims);
   int64_t static_extent_product = dense_shape_size;
   bool any_overflows = false;
   for (int i = 0; i < ndims; i++) {
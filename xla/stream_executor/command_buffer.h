@@ -77,6 +77,16 @@ class CommandBuffer {
   //
   enum class Mode { kPrimary, kNested };
 
+  // A position in the sequence of commands recorded into a command buffer.
+  // Updates must visit recorded commands in the same order as they were
+  // recorded at construction time, and a checkpoint taken at construction time
+  // allows an update to skip over commands that do not need to be updated.
+  struct Checkpoint {
+    int64_t num_commands = 0;
+    int64_t num_barriers = 0;
+    int64_t num_conditionals = 0;
+  };
+
   friend absl::string_view ModeToString(Mode mode) {
     switch (mode) {
       case CommandBuffer::Mode::kPrimary:
@@ -184,6 +194,14 @@ class CommandBuffer {
   // before it can be executed.
   virtual absl::Status Update() = 0;
 
+  // Returns a checkpoint after the last recorded (or updated) command.
+  virtual Checkpoint checkpoint() const = 0;
+
+  // Skips updating all previously recorded commands up to the `checkpoint`,
+  // which keep the parameters they were recorded with. Command buffer must be
+  // in kUpdate state.
+  virtual absl::Status SkipUpdatesTo(const Checkpoint& checkpoint) = 0;
+
   // Returns command buffer execution mode.
   virtual Mode mode() const = 0;
 
@@ -32,6 +32,7 @@ limitations under the License.
 #include "xla/stream_executor/platform.h"
 #include "xla/stream_executor/platform/initialize.h"
 #include "xla/stream_executor/platform_manager.h"
+#include "xla/tsl/platform/env.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/status.h"
 
@@ -42,6 +43,13 @@ namespace {
 // Actually performs the work of CUDA initialization. Wrapped up in one-time
 // execution guard.
 static absl::Status InternalInit() {
+  // XLA links all kernels of an executable into a single module, and many of
+  // them may never run (e.g. kernels in rarely taken conditional branches), so
+  // ask the driver to load kernels on their first launch instead of when the
+  // module is loaded. This must happen before cuInit, and an explicit user
+  // setting takes precedence.
+  tsl::setenv("CUDA_MODULE_LOADING", "LAZY", /*overwrite=*/0);
+
   absl::Status status =
       cuda::ToStatus(cuInit(0 /* = flags */), "Failed call to cuInit");
   if (status.ok()) {
@@ -653,6 +653,41 @@ absl::Status GpuCommandBuffer::Update() {
   return absl::OkStatus();
 }
 
+CommandBuffer::Checkpoint GpuCommandBuffer::checkpoint() const {
+  if (state_ == State::kUpdate) {
+    return Checkpoint{update_state_.node_idx, update_state_.barrier_idx,
+                      update_state_.conditional_idx};
+  }
+  return Checkpoint{static_cast<int64_t>(nodes_.size()),
+                    static_cast<int64_t>(barriers_.size()),
+                    static_cast<int64_t>(conditional_command_buffers_.size())};
+}
+
+absl::Status GpuCommandBuffer::SkipUpdatesTo(const Checkpoint& checkpoint) {
+  if (state_ != State::kUpdate) return UnsupportedStateError(state_);
+
+  // Command buffer updates can't change the structure of the underlying gpu
+  // graph, and we can only skip forward to a checkpoint of a recorded command.
+  Checkpoint recorded = {
+      static_cast<int64_t>(nodes_.size()),
+      static_cast<int64_t>(barriers_.size()),
+      static_cast<int64_t>(conditional_command_buffers_.size())};
+
+  if (checkpoint.num_commands < update_state_.node_idx ||
+      checkpoint.num_commands > recorded.num_commands ||
+      checkpoint.num_barriers < update_state_.barrier_idx ||
+      checkpoint.num_barriers > recorded.num_barriers ||
+      checkpoint.num_conditionals < update_state_.conditional_idx ||
+      checkpoint.num_conditionals > recorded.num_conditionals) {
+    return absl::InternalError("Command buffer checkpoint out of range");
+  }
+
+  update_state_.node_idx = checkpoint.num_commands;
+  update_state_.barrier_idx = checkpoint.num_barriers;
+  update_state_.conditional_idx = checkpoint.num_conditionals;
+  return absl::OkStatus();
+}
+
 absl::Span<const GpuCommandBuffer::GpuGraphNodeInfo> GpuCommandBuffer::nodes()
     const {
   return nodes_;
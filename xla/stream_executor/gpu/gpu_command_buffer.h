@@ -135,6 +135,9 @@ class GpuCommandBuffer : public CommandBuffer {
   absl::Status Update() override;
   absl::Status Submit(Stream* stream) override;
 
+  Checkpoint checkpoint() const override;
+  absl::Status SkipUpdatesTo(const Checkpoint& checkpoint) override;
+
   Mode mode() const override { return mode_; }
   State state() const override { return state_; }
 
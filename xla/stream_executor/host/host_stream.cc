@@ -20,39 +20,106 @@ limitations under the License.
 #include <string.h>
 
 #include <cfenv>  // NOLINT
+#include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <memory>
 #include <queue>
 #include <utility>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/functional/any_invocable.h"
 #include "absl/log/check.h"
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
 #include "absl/synchronization/notification.h"
+#include "absl/time/time.h"
 #include "xla/stream_executor/device_memory.h"
 #include "xla/stream_executor/event.h"
 #include "xla/stream_executor/host/host_event.h"
 #include "xla/stream_executor/stream.h"
 #include "xla/stream_executor/stream_common.h"
 #include "tsl/platform/denormal.h"
+#include "tsl/platform/env.h"
 #include "tsl/platform/setround.h"
 
 namespace stream_executor {
 namespace host {
+namespace {
+
+// Threads running the tasks of all host streams.
+//
+// Host stream tasks may block on other streams (see WaitFor), so a task never
+// waits for a busy thread: if no thread is idle, a new one is started. Threads
+// exit after being idle for a while, so the number of threads follows the
+// number of streams that are busy at the same time rather than the number of
+// streams.
+class HostStreamThreadPool {
+ public:
+  static HostStreamThreadPool& Get() {
+    static auto* const pool = new HostStreamThreadPool();
+    return *pool;
+  }
+
+  void Schedule(absl::AnyInvocable<void() &&> task) {
+    {
+      absl::MutexLock lock(&mu_);
+      tasks_.push_back(std::move(task));
+      if (tasks_.size() <= num_idle_threads_) {
+        return;
+      }
+    }
+    tsl::Env::Default()->SchedClosure([this]() { WorkLoop(); });
+  }
+
+ private:
+  static constexpr absl::Duration kIdleTimeout = absl::Seconds(1);
+
+  void WorkLoop() {
+    // Set denormal and rounding behavior to match the default TF ThreadPool
+    // behavior.
+    // TODO(phawkins, jlebar): it's not clear this is the best place to set
+    // this.
+    tsl::port::ScopedFlushDenormal flush;
+    tsl::port::ScopedSetRound round(FE_TONEAREST);
+    while (true) {
+      absl::AnyInvocable<void() &&> task;
+      {
+        absl::MutexLock lock(&mu_);
+        ++num_idle_threads_;
+        bool has_task = mu_.AwaitWithTimeout(
+            absl::Condition(this, &HostStreamThreadPool::HasTasks),
+            kIdleTimeout);
+        --num_idle_threads_;
+        if (!has_task) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      std::move(task)();
+    }
+  }
+
+  bool HasTasks() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    return !tasks_.empty();
+  }
+
+  absl::Mutex mu_;
+  std::deque<absl::AnyInvocable<void() &&>> tasks_ ABSL_GUARDED_BY(mu_);
+  size_t num_idle_threads_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace
 
 HostStream::HostStream(StreamExecutor* executor)
-    : StreamCommon(executor),
-      thread_(tsl::Env::Default()->StartThread({}, "host_executor",
-                                               [this]() { WorkLoop(); })) {}
+    : StreamCommon(executor), state_(std::make_shared<State>()) {}
 
 HostStream::~HostStream() {
-  {
-    absl::MutexLock lock(&mu_);
-    work_queue_.push(nullptr);
-  }
-  // thread_'s destructor blocks until the thread finishes running.
-  thread_.reset();
+  // Run all pending tasks before the stream goes away.
+  absl::Notification done;
+  EnqueueTask([&done]() { done.Notify(); });
+  done.WaitForNotification();
   parent()->DeallocateStream(this);
 }
 
@@ -145,32 +212,31 @@ absl::Status HostStream::DoHostCallbackWithStatus(
 bool HostStream::EnqueueTaskWithStatus(
     absl::AnyInvocable<absl::Status() &&> task) {
   CHECK(task != nullptr);
-  absl::MutexLock lock(&mu_);
-  work_queue_.push(std::move(task));
+  {
+    absl::MutexLock lock(&state_->mu);
+    state_->work_queue.push(std::move(task));
+    if (state_->draining) {
+      return true;
+    }
+    state_->draining = true;
+  }
+  HostStreamThreadPool::Get().Schedule([state = state_]() { Drain(state); });
   return true;
 }
 
-bool HostStream::WorkAvailable() { return !work_queue_.empty(); }
-
-void HostStream::WorkLoop() {
-  // Set denormal and rounding behavior to match the default TF ThreadPool
-  // behavior.
-  // TODO(phawkins, jlebar): it's not clear this is the best place to set this.
-  tsl::port::ScopedFlushDenormal flush;
-  tsl::port::ScopedSetRound round(FE_TONEAREST);
+void HostStream::Drain(const std::shared_ptr<State>& state) {
   while (true) {
     std::queue<absl::AnyInvocable<absl::Status() &&>> queue;
     {
-      absl::MutexLock lock(&mu_);
-      mu_.Await(absl::Condition(this, &HostStream::WorkAvailable));
-      std::swap(queue, work_queue_);
-    }
-    while (!queue.empty()) {
-      absl::AnyInvocable<absl::Status() &&>& fn = queue.front();
-      if (!fn) {
+      absl::MutexLock lock(&state->mu);
+      if (state->work_queue.empty()) {
+        state->draining = false;
         return;
       }
-      status_.Update(std::move(fn)());
+      std::swap(queue, state->work_queue);
+    }
+    while (!queue.empty()) {
+      state->status.Update(std::move(queue.front())());
       queue.pop();
     }
   }
@@ -179,12 +245,12 @@ void HostStream::WorkLoop() {
 absl::Status HostStream::BlockUntilDone() {
   absl::Notification done;
   absl::Status status;
-  EnqueueTask([&done, &status, this]() {
-    // This task is always executed synchronously before 'status_' is updated
+  EnqueueTask([&done, &status, state = state_.get()]() {
+    // This task is always executed synchronously before 'status' is updated
     // with the result of the task (always OK() in this case), so we don't need
-    // to worry about locking access to 'status_'.
-    status = status_;
-    status_ = absl::OkStatus();
+    // to worry about locking access to 'status'.
+    status = state->status;
+    state->status = absl::OkStatus();
     done.Notify();
   });
   done.WaitForNotification();
@@ -31,14 +31,15 @@ limitations under the License.
 #include "xla/stream_executor/stream.h"
 #include "xla/stream_executor/stream_common.h"
 #include "xla/stream_executor/stream_executor.h"
-#include "tsl/platform/env.h"
-#include "tsl/platform/thread_annotations.h"
 
 namespace stream_executor {
 namespace host {
 
 // Class declaration for Stream type that enqueues tasks onto a host/CPU-based
 // execution context (as opposed to a GPU device), HostExecutor.
+//
+// Tasks of a stream run in FIFO order on a thread pool shared by all host
+// streams, so idle streams don't hold on to a thread.
 class HostStream : public StreamCommon {
  public:
   explicit HostStream(StreamExecutor* executor);
@@ -74,15 +75,23 @@ class HostStream : public StreamCommon {
   absl::Status DoHostCallbackWithStatus(
       absl::AnyInvocable<absl::Status() &&> callback) override;
 
- protected:
-  bool WorkAvailable() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
-  void WorkLoop();
-
-  absl::Mutex mu_;
-  std::queue<absl::AnyInvocable<absl::Status() &&>> work_queue_
-      ABSL_GUARDED_BY(mu_);
-  std::unique_ptr<tsl::Thread> thread_;
-  absl::Status status_;
+ private:
+  // Pending tasks of the stream. Shared with the thread draining the queue so
+  // that the stream can be destroyed as soon as its last task has run.
+  struct State {
+    absl::Mutex mu;
+    std::queue<absl::AnyInvocable<absl::Status() &&>> work_queue
+        ABSL_GUARDED_BY(mu);
+    // Whether a thread is scheduled to drain `work_queue`.
+    bool draining ABSL_GUARDED_BY(mu) = false;
+    // Only accessed by the thread draining the queue.
+    absl::Status status;
+  };
+
+  // Runs the tasks in `state` until its queue is empty.
+  static void Drain(const std::shared_ptr<State>& state);
+
+  std::shared_ptr<State> state_;
 };
 
 }  // namespace host
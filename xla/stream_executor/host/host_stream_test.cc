@@ -13,9 +13,16 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
+#include "absl/algorithm/container.h"
 #include "absl/status/status.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "xla/stream_executor/platform.h"
 #include "xla/stream_executor/platform_manager.h"
 #include "xla/stream_executor/stream.h"
@@ -75,3 +82,48 @@ TEST(HostStream, ReportsFirstHostCallbackError) {
   // "error 2" is just lost.
   ASSERT_EQ(stream->BlockHostUntilDone().message(), "error 1");
 }
+
+TEST(HostStream, RunsPendingTasksOnDestruction) {
+  se::Platform* platform =
+      se::PlatformManager::PlatformWithName("Host").value();
+  se::StreamExecutor* executor = platform->ExecutorForDevice(0).value();
+  TF_ASSERT_OK_AND_ASSIGN(auto stream, executor->CreateStream());
+  bool ran = false;
+  TF_ASSERT_OK(stream->DoHostCallback([&ran]() {
+    absl::SleepFor(absl::Milliseconds(10));
+    ran = true;
+  }));
+  stream.reset();
+  EXPECT_TRUE(ran);
+}
+
+TEST(HostStream, ManyStreamsWaitingOnEachOther) {
+  se::Platform* platform =
+      se::PlatformManager::PlatformWithName("Host").value();
+  se::StreamExecutor* executor = platform->ExecutorForDevice(0).value();
+  constexpr int kNumStreams = 64;
+  std::vector<std::unique_ptr<se::Stream>> streams;
+  for (int i = 0; i < kNumStreams; ++i) {
+    TF_ASSERT_OK_AND_ASSIGN(auto stream, executor->CreateStream());
+    streams.push_back(std::move(stream));
+  }
+
+  // Each stream blocks a thread until the previous one is done.
+  absl::Mutex mu;
+  std::vector<int> order;
+  for (int i = 0; i < kNumStreams; ++i) {
+    if (i > 0) {
+      TF_ASSERT_OK(streams[i]->WaitFor(streams[i - 1].get()));
+    }
+    TF_ASSERT_OK(streams[i]->DoHostCallback([i, &mu, &order]() {
+      absl::MutexLock lock(&mu);
+      order.push_back(i);
+    }));
+  }
+  TF_ASSERT_OK(streams.back()->BlockHostUntilDone());
+
+  absl::MutexLock lock(&mu);
+  std::vector<int> expected(kNumStreams);
+  absl::c_iota(expected, 0);
+  EXPECT_EQ(order, expected);
+}
@@ -0,0 +1,143 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/stream_executor/host/huge_pages.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "absl/strings/string_view.h"
+#include "tsl/platform/mem.h"
+
+namespace stream_executor::host {
+namespace {
+
+std::atomic<int64_t> num_allocations{0};
+std::atomic<int64_t> advised_bytes{0};
+std::atomic<int64_t> failed_advices{0};
+
+uintptr_t RoundDown(uintptr_t value) { return value & ~(kHugePageSize - 1); }
+uintptr_t RoundUp(uintptr_t value) {
+  return RoundDown(value + kHugePageSize - 1);
+}
+
+// Advises huge pages for a range aligned to the huge page size.
+size_t AdviseAligned(uintptr_t begin, uintptr_t end) {
+  if (begin >= end) {
+    return 0;
+  }
+#if defined(MADV_HUGEPAGE)
+  if (madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) ==
+      0) {
+    advised_bytes.fetch_add(end - begin, std::memory_order_relaxed);
+    return end - begin;
+  }
+  VLOG(3) << "Failed to advise huge pages for " << (end - begin)
+          << " bytes at " << reinterpret_cast<void*>(begin);
+#endif
+  failed_advices.fetch_add(1, std::memory_order_relaxed);
+  return 0;
+}
+
+}  // namespace
+
+void* HugePageAllocate(size_t size) {
+  size_t allocation_size = RoundUp(std::max<size_t>(size, 1));
+  void* ptr = tsl::port::AlignedMalloc(allocation_size, kHugePageSize);
+  if (ptr == nullptr) {
+    return nullptr;
+  }
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+  AdviseAligned(begin, begin + allocation_size);
+  return ptr;
+}
+
+void HugePageFree(void* ptr) { tsl::port::AlignedFree(ptr); }
+
+size_t AdviseHugePages(void* ptr, size_t size) {
+  uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+  return AdviseAligned(RoundUp(begin), RoundDown(begin + size));
+}
+
+HugePageStats GetHugePageStats() {
+  HugePageStats stats;
+  stats.num_allocations = num_allocations.load(std::memory_order_relaxed);
+  stats.advised_bytes = advised_bytes.load(std::memory_order_relaxed);
+  stats.failed_advices = failed_advices.load(std::memory_order_relaxed);
+  return stats;
+}
+
+absl::StatusOr<size_t> GetHugePageBackedBytes(const void* ptr, size_t size) {
+#if defined(__linux__)
+  // /proc/self/smaps lists every mapping as a "begin-end perms ..." header
+  // line followed by "Key: value kB" lines, including "AnonHugePages".
+  std::ifstream smaps("/proc/self/smaps");
+  if (!smaps.is_open()) {
+    return absl::UnavailableError("Can't open /proc/self/smaps");
+  }
+
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+  const uintptr_t end = begin + size;
+  size_t backed_bytes = 0;
+  size_t overlap = 0;  // Overlap of the current mapping with the range
+
+  std::string line;
+  while (std::getline(smaps, line)) {
+    std::vector<absl::string_view> fields =
+        absl::StrSplit(line, ' ', absl::SkipEmpty());
+    if (fields.empty()) {
+      continue;
+    }
+
+    std::vector<absl::string_view> bounds = absl::StrSplit(fields[0], '-');
+    uint64_t mapping_begin, mapping_end;
+    if (bounds.size() == 2 && absl::SimpleHexAtoi(bounds[0], &mapping_begin) &&
+        absl::SimpleHexAtoi(bounds[1], &mapping_end)) {
+      uintptr_t overlap_begin = std::max<uintptr_t>(begin, mapping_begin);
+      uintptr_t overlap_end = std::min<uintptr_t>(end, mapping_end);
+      overlap = overlap_begin < overlap_end ? overlap_end - overlap_begin : 0;
+      continue;
+    }
+
+    uint64_t kilobytes;
+    if (overlap > 0 && fields.size() >= 2 && fields[0] == "AnonHugePages:" &&
+        absl::SimpleAtoi(fields[1], &kilobytes)) {
+      // The kernel only reports huge pages per mapping, and the mapping may
+      // extend past the range.
+      backed_bytes += std::min<size_t>(kilobytes * 1024, overlap);
+    }
+  }
+  return backed_bytes;
+#else
+  return absl::UnimplementedError("Huge page usage is only reported on Linux");
+#endif
+}
+
+}  // namespace stream_executor::host
@@ -0,0 +1,69 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_STREAM_EXECUTOR_HOST_HUGE_PAGES_H_
+#define XLA_STREAM_EXECUTOR_HOST_HUGE_PAGES_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "absl/status/statusor.h"
+
+// Helpers for backing large host buffers (CPU executable temp buffers, pinned
+// host memory pools for GPUs) with transparent huge pages. Multi-GB working
+// sets touched with 4K pages spend a lot of time in TLB misses, and 2MB pages
+// cut the number of TLB entries they need by 512x.
+//
+// Huge pages are only a hint to the kernel: if transparent huge pages are
+// disabled, or no huge pages are available, memory is backed by regular pages.
+
+namespace stream_executor::host {
+
+// Size of a transparent huge page on x86-64 and (most) aarch64 kernels.
+inline constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+// Allocates `size` bytes aligned to the huge page size and advises the kernel
+// to back them with huge pages. The allocation is padded to a multiple of the
+// huge page size, so the last huge page is not shared with other allocations.
+// Returns nullptr if the allocation fails. Memory must be freed with
+// `HugePageFree`.
+void* HugePageAllocate(size_t size);
+
+// Frees memory allocated by `HugePageAllocate`.
+void HugePageFree(void* ptr);
+
+// Advises the kernel to back the huge pages that lie entirely inside
+// [ptr, ptr + size) with transparent huge pages. Use this for memory that is
+// allocated by someone else. Returns the number of advised bytes.
+size_t AdviseHugePages(void* ptr, size_t size);
+
+// Process-wide counters of huge page requests.
+struct HugePageStats {
+  int64_t num_allocations = 0;  // Number of `HugePageAllocate` calls
+  int64_t advised_bytes = 0;    // Bytes advised by allocations and advices
+  int64_t failed_advices = 0;   // Advices rejected by the kernel
+};
+
+HugePageStats GetHugePageStats();
+
+// Returns how many bytes of [ptr, ptr + size) are actually backed by
+// transparent huge pages, according to the kernel's accounting of the memory
+// mappings that contain the range. Returns an error on platforms that don't
+// report huge page usage.
+absl::StatusOr<size_t> GetHugePageBackedBytes(const void* ptr, size_t size);
+
+}  // namespace stream_executor::host
+
+#endif  // XLA_STREAM_EXECUTOR_HOST_HUGE_PAGES_H_
@@ -0,0 +1,70 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/stream_executor/host/huge_pages.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <gtest/gtest.h>
+#include "absl/status/statusor.h"
+
+namespace stream_executor::host {
+namespace {
+
+TEST(HugePagesTest, AllocateIsAligned) {
+  constexpr size_t kSize = 4 * kHugePageSize + 1;
+  HugePageStats before = GetHugePageStats();
+
+  void* ptr = HugePageAllocate(kSize);
+  ASSERT_NE(ptr, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % kHugePageSize, 0);
+  std::memset(ptr, 1, kSize);
+
+  HugePageStats after = GetHugePageStats();
+  EXPECT_EQ(after.num_allocations, before.num_allocations + 1);
+  // The allocation is padded to a multiple of the huge page size.
+  if (after.failed_advices == before.failed_advices) {
+    EXPECT_EQ(after.advised_bytes, before.advised_bytes + 5 * kHugePageSize);
+  }
+
+  absl::StatusOr<size_t> backed_bytes = GetHugePageBackedBytes(ptr, kSize);
+  if (backed_bytes.ok()) {
+    EXPECT_LE(*backed_bytes, kSize);
+  }
+  HugePageFree(ptr);
+}
+
+TEST(HugePagesTest, AdviseOnlyAlignedPages) {
+  void* ptr = std::malloc(3 * kHugePageSize);
+  ASSERT_NE(ptr, nullptr);
+
+  uintptr_t begin = reinterpret_cast<uintptr_t>(ptr);
+  size_t advised_bytes = AdviseHugePages(ptr, 3 * kHugePageSize);
+  EXPECT_EQ(advised_bytes % kHugePageSize, 0);
+  EXPECT_LE(advised_bytes, 3 * kHugePageSize);
+  if (begin % kHugePageSize != 0) {
+    EXPECT_LE(advised_bytes, 2 * kHugePageSize);
+  }
+
+  // Ranges smaller than a huge page are never advised.
+  EXPECT_EQ(AdviseHugePages(ptr, kHugePageSize / 2), 0);
+  std::free(ptr);
+}
+
+}  // namespace
+}  // namespace stream_executor::host
@@ -72,6 +72,16 @@ TEST(TileAssignmentTest, V1V2Equivalence) {
   EXPECT_EQ(absl::HashOf(v1), absl::HashOf(v2));
 }
 
+TEST(TileAssignmentTest, V1V2LastDeviceMismatch) {
+  Array3D<int64_t> array(
+      {{{0, 8, 4, 12}, {1, 9, 5, 13}}, {{2, 10, 6, 14}, {3, 11, 7, 16}}});
+  TileAssignment v1(std::make_shared<const Array<int64_t>>(array));
+  TileAssignment v2({2, 2, 4}, {2, 2, 4}, {2, 1, 0});
+  EXPECT_NE(v1, v2);
+  EXPECT_NE(v2, v1);
+  EXPECT_NE(v2, TileAssignment({2, 8}, {2, 2, 4}, {2, 1, 0}));
+}
+
 TEST(TileAssignmentTest, CopyConstruction) {
   TileAssignment tile({2, 2, 4}, {2, 2, 4}, {2, 1, 0});
   TileAssignment copied(tile);
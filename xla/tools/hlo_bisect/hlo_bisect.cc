@@ -13,16 +13,29 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/time/time.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/plugin/xla_cpu/cpu_client_options.h"
+#include "xla/pjrt/plugin/xla_cpu/xla_cpu_pjrt_client.h"
 #include "xla/tools/hlo_bisect/hlo_bisect_utils.h"
 #include "xla/tsl/util/command_line_flags.h"
 #include "tsl/platform/init_main.h"
 
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+#include "xla/pjrt/plugin/xla_gpu/xla_gpu_client_options.h"
+#include "xla/pjrt/plugin/xla_gpu/xla_gpu_pjrt_client.h"
+#endif
+
 const char* const kUsage = R"(
 Given an HloModule that manifests an XLA bug, either crashes the compiler or
 an execution engine on a platform or produces observable different results on
@@ -56,8 +69,25 @@ struct BisectOptions {
   std::string reference_platform = "Interpreter";
   float abs_error = 0.01;
   float rel_error = 0.1;
+  float time_threshold_ms = 0;
+  int64_t timing_repeats = 5;
 };
 
+// Returns a PjRt client for timing modules on the test platform.
+absl::StatusOr<std::unique_ptr<xla::PjRtClient>> GetTimingClient(
+    const std::string& platform) {
+  if (platform == "CPU" || platform == "Host") {
+    return xla::GetXlaPjrtCpuClient(xla::CpuClientOptions());
+  }
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  if (platform == "CUDA" || platform == "ROCM") {
+    return xla::GetXlaPjrtGpuClient(xla::GpuClientOptions());
+  }
+#endif
+  return absl::InvalidArgumentError(
+      absl::StrCat("Timing is not supported on platform: ", platform));
+}
+
 int main(int argc, char** argv) {
   BisectOptions opts;
   std::vector<tsl::Flag> flag_list = {
@@ -91,6 +121,13 @@ int main(int argc, char** argv) {
       tsl::Flag("rel_error", &opts.rel_error,
                 "The relative error bound used when comparing the test and "
                 "reference results."),
+      tsl::Flag("time_threshold_ms", &opts.time_threshold_ms,
+                "If positive, bisect a performance problem: keep reducing the "
+                "HLO module as long as its median execution time on the test "
+                "platform is at least this many milliseconds."),
+      tsl::Flag("timing_repeats", &opts.timing_repeats,
+                "Number of timed executions of each candidate module when "
+                "--time_threshold_ms is set."),
   };
   xla::AppendDebugOptionsFlags(&flag_list);
 
@@ -120,7 +157,16 @@ int main(int argc, char** argv) {
   std::tie(module, inputs) = std::move(values_or_status).value();
 
   std::unique_ptr<xla::bisect::BugCheckerInterface> bug_checker;
-  if (opts.script.empty()) {
+  if (opts.time_threshold_ms > 0) {
+    auto client = GetTimingClient(opts.test_platform);
+    if (!client.ok()) {
+      LOG(ERROR) << "Failed to create client: " << client.status();
+      return 1;
+    }
+    bug_checker = std::make_unique<xla::bisect::TimingChecker>(
+        std::move(client).value(), module.get(), std::move(inputs),
+        absl::Milliseconds(opts.time_threshold_ms), opts.timing_repeats);
+  } else if (opts.script.empty()) {
     bug_checker = std::make_unique<xla::bisect::MiscompareChecker>(
         module.get(), std::move(inputs), opts.test_platform,
         opts.reference_platform,
@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "xla/tools/hlo_bisect/hlo_bisect_state.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <iterator>
 #include <memory>
 #include <string>
@@ -31,6 +33,7 @@ limitations under the License.
 #include "xla/hlo/transforms/simplifiers/hlo_dce.h"
 #include "xla/literal_util.h"
 #include "xla/util.h"
+#include "tsl/platform/fingerprint.h"
 
 namespace xla {
 namespace bisect {
@@ -143,8 +146,28 @@ bool InstructionNotReplaceableWithConstant(HloInstruction* instruction) {
          instruction->opcode() == HloOpcode::kParameter;
 }
 
+// Returns the fingerprint of a candidate module. Constants are printed in full,
+// as modules that differ only in constant values may behave differently.
+uint64_t GetCandidateFingerprint(const HloModule& module) {
+  return tsl::Fingerprint64(
+      module.ToString(HloPrintOptions::Canonical()
+                          .set_print_large_constants(true)
+                          .set_print_backend_config(true)));
+}
+
 }  // namespace
 
+absl::StatusOr<std::vector<bool>> BugCheckerInterface::RunBatch(
+    absl::Span<const HloModule* const> modules) {
+  std::vector<bool> results;
+  results.reserve(modules.size());
+  for (const HloModule* module : modules) {
+    TF_ASSIGN_OR_RETURN(bool has_bug, Run(*module));
+    results.push_back(has_bug);
+  }
+  return results;
+}
+
 absl::StatusOr<bool> HloBisectState::ShouldProcess() {
   // Running the unmodified module should trigger the bug checker.
   return RunModule(*module_);
@@ -193,6 +216,58 @@ absl::StatusOr<bool> HloBisectState::RunModule(const HloModule& module) {
   return bug_result;
 }
 
+absl::StatusOr<std::vector<bool>> HloBisectState::RunModules(
+    absl::Span<const HloModule* const> modules) {
+  std::vector<bool> results(modules.size());
+  std::vector<uint64_t> fingerprints;
+  std::vector<const HloModule*> new_modules;
+  std::vector<int64_t> new_indices;
+  fingerprints.reserve(modules.size());
+  for (int64_t i = 0; i < modules.size(); ++i) {
+    fingerprints.push_back(GetCandidateFingerprint(*modules[i]));
+    auto it = candidate_results_.find(fingerprints.back());
+    if (it != candidate_results_.end()) {
+      VLOG(3) << "Reusing bug checker result: " << it->second;
+      results[i] = it->second;
+    } else {
+      new_modules.push_back(modules[i]);
+      new_indices.push_back(i);
+    }
+  }
+
+  // A single candidate also gets the instruction values from the bug checker.
+  std::vector<bool> new_results;
+  if (new_modules.size() == 1) {
+    TF_ASSIGN_OR_RETURN(bool has_bug, RunModule(*new_modules.front()));
+    new_results.push_back(has_bug);
+  } else if (!new_modules.empty()) {
+    for (const HloModule* module : new_modules) {
+      VLOG(3) << "Modified module: " << module->ToString();
+    }
+    TF_ASSIGN_OR_RETURN(new_results, bug_checker_->RunBatch(new_modules));
+    if (new_results.size() != new_modules.size()) {
+      return InternalStrCat("The checker returned ", new_results.size(),
+                            " results for ", new_modules.size(),
+                            " modules");
+    }
+    for (int64_t i = 0; i < new_modules.size(); ++i) {
+      VLOG(3) << "Bug checker result: " << new_results[i];
+      if (!new_results[i]) {
+        for (const HloInstruction* instr :
+             new_modules[i]->entry_computation()->instructions()) {
+          foldable_instructions_.emplace(instr->name());
+        }
+      }
+    }
+  }
+
+  for (int64_t i = 0; i < new_indices.size(); ++i) {
+    results[new_indices[i]] = new_results[i];
+    candidate_results_[fingerprints[new_indices[i]]] = new_results[i];
+  }
+  return results;
+}
+
 absl::StatusOr<bool> HloBisectState::TrimByOutputs() {
   // Only available if the root instruction is a tuple.
   HloInstruction* root_instruction =
@@ -202,17 +277,23 @@ absl::StatusOr<bool> HloBisectState::TrimByOutputs() {
     return false;
   }
 
-  // Run the modified module and return the error state.
-  auto run_modified = [&](int64_t start, int64_t end) -> absl::StatusOr<bool> {
+  // Create the modified module keeping only the outputs in [start, end].
+  auto make_modified =
+      [&](int64_t start,
+          int64_t end) -> absl::StatusOr<std::unique_ptr<HloModule>> {
     std::unique_ptr<HloModule> new_module = module_->Clone(/*suffix=*/"");
     HloInstruction* const* new_operands =
         new_module->entry_computation()->root_instruction()->operands().begin();
     TF_RETURN_IF_ERROR(MorphModuleWithOutputs(
         new_module.get(),
         absl::MakeSpan(new_operands + start, end - start + 1)));
-    return RunModule(*new_module);
+    return new_module;
   };
 
+  // If the bug checker can evaluate candidates concurrently, run both halves
+  // at once instead of only running the upper half when the lower one passes.
+  const bool run_halves_together = bug_checker_->MaxParallelism() > 1;
+
   // Binary search for the operands range that exhibits a bug.
   int64_t bisect_low = 0;
   int64_t bisect_high = root_instruction->operand_count() - 1;
@@ -220,16 +301,27 @@ absl::StatusOr<bool> HloBisectState::TrimByOutputs() {
     int64_t cur = bisect_low + (bisect_high - bisect_low) / 2;
     VLOG(2) << "Number of outputs: " << (cur - bisect_low + 1) << " ["
             << bisect_low << ".." << cur << "]";
-    TF_ASSIGN_OR_RETURN(bool has_bug, run_modified(bisect_low, cur));
-    if (has_bug) {
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<HloModule> low_module,
+                        make_modified(bisect_low, cur));
+    std::unique_ptr<HloModule> high_module;
+    std::vector<const HloModule*> candidates = {low_module.get()};
+    if (run_halves_together) {
+      TF_ASSIGN_OR_RETURN(high_module, make_modified(cur + 1, bisect_high));
+      candidates.push_back(high_module.get());
+    }
+    TF_ASSIGN_OR_RETURN(std::vector<bool> has_bug, RunModules(candidates));
+    if (has_bug[0]) {
       bisect_high = cur;
+      continue;
+    }
+    if (!run_halves_together) {
+      TF_ASSIGN_OR_RETURN(high_module, make_modified(cur + 1, bisect_high));
+      TF_ASSIGN_OR_RETURN(has_bug, RunModules({high_module.get()}));
+    }
+    if (has_bug.back()) {
+      bisect_low = cur + 1;
     } else {
-      TF_ASSIGN_OR_RETURN(has_bug, run_modified(cur + 1, bisect_high));
-      if (has_bug) {
-        bisect_low = cur + 1;
-      } else {
-        break;
-      }
+      break;
     }
   }
 
@@ -253,20 +345,46 @@ absl::StatusOr<bool> HloBisectState::TrimByInstructions() {
   int64_t upper_bound = computation->instruction_count() -
                         computation->root_instruction()->shape().IsTuple();
 
-  // Binary search for the instructions range that exhibits a bug.
+  // Search for the instructions range that exhibits a bug. Each step splits
+  // the range at as many points as the bug checker can evaluate concurrently
+  // (a binary search if it evaluates one candidate at a time).
+  const int64_t num_splits =
+      std::max<int64_t>(bug_checker_->MaxParallelism(), 1);
   int64_t bisect_low = computation->num_parameters() - 1;
   int64_t bisect_high = upper_bound;
   while (bisect_low + 1 < bisect_high) {
-    int64_t cur = bisect_low + (bisect_high - bisect_low) / 2;
-    VLOG(2) << "Number of instructions: " << cur << " (of "
-            << computation->instruction_count() << ")";
-    std::unique_ptr<HloModule> new_module = module_->Clone(/*suffix=*/"");
-    TF_RETURN_IF_ERROR(MorphModuleWithInstructions(new_module.get(), cur));
-    TF_ASSIGN_OR_RETURN(bool has_bug, RunModule(*new_module));
-    if (has_bug) {
-      bisect_high = cur;
+    std::vector<int64_t> split_points;
+    for (int64_t i = 1; i <= num_splits; ++i) {
+      int64_t cur =
+          bisect_low + (bisect_high - bisect_low) * i / (num_splits + 1);
+      if (cur > bisect_low && cur < bisect_high &&
+          (split_points.empty() || split_points.back() != cur)) {
+        split_points.push_back(cur);
+      }
+    }
+
+    std::vector<std::unique_ptr<HloModule>> new_modules;
+    std::vector<const HloModule*> candidates;
+    for (int64_t cur : split_points) {
+      VLOG(2) << "Number of instructions: " << cur << " (of "
+              << computation->instruction_count() << ")";
+      new_modules.push_back(module_->Clone(/*suffix=*/""));
+      TF_RETURN_IF_ERROR(
+          MorphModuleWithInstructions(new_modules.back().get(), cur));
+      candidates.push_back(new_modules.back().get());
+    }
+    TF_ASSIGN_OR_RETURN(std::vector<bool> has_bug, RunModules(candidates));
+
+    // The bug shows up in all prefixes at least as long as the first buggy one.
+    auto first_buggy = absl::c_find(has_bug, true);
+    if (first_buggy == has_bug.end()) {
+      bisect_low = split_points.back();
     } else {
-      bisect_low = cur;
+      int64_t index = std::distance(has_bug.begin(), first_buggy);
+      bisect_high = split_points[index];
+      if (index > 0) {
+        bisect_low = split_points[index - 1];
+      }
     }
   }
 
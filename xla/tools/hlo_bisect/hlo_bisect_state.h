@@ -16,14 +16,17 @@ limitations under the License.
 #ifndef XLA_TOOLS_HLO_BISECT_HLO_BISECT_STATE_H_
 #define XLA_TOOLS_HLO_BISECT_HLO_BISECT_STATE_H_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/literal.h"
 
@@ -43,6 +46,17 @@ class BugCheckerInterface {
   // Returns mapping of instruction names to their results after the run
   // (empty if this information is unavailable).
   virtual absl::flat_hash_map<std::string, Literal> GetResults() = 0;
+
+  // Returns the number of modules the checker can evaluate concurrently, e.g.
+  // the number of local devices it runs candidates on.
+  virtual int64_t MaxParallelism() const { return 1; }
+
+  // Returns, for each of `modules`, true if it has a bug we're interested in.
+  // Checkers that can evaluate candidates concurrently should override this;
+  // the default runs them one at a time. GetResults() is not meaningful after
+  // a batched run.
+  virtual absl::StatusOr<std::vector<bool>> RunBatch(
+      absl::Span<const HloModule* const> modules);
 };
 
 // Trims down an HloModule that manifests a bug to a smaller module that
@@ -68,6 +82,13 @@ class HloBisectState {
   // available. Returns true if `module` has a bug.
   absl::StatusOr<bool> RunModule(const HloModule& module);
 
+  // Runs the candidate modules, concurrently if the bug checker supports it,
+  // and updates the foldable instructions data. Results of candidates that
+  // were evaluated before are reused. Returns true for the modules that have a
+  // bug.
+  absl::StatusOr<std::vector<bool>> RunModules(
+      absl::Span<const HloModule* const> modules);
+
   // Trims the entry computation by reducing the total number of outputs.
   // Returns a boolean to indicate whether the computation has been reduced.
   absl::StatusOr<bool> TrimByOutputs();
@@ -88,6 +109,8 @@ class HloBisectState {
   BugCheckerInterface* bug_checker_;
   absl::flat_hash_set<std::string> foldable_instructions_;
   absl::flat_hash_map<std::string, Literal> foldable_instructions_values_;
+  // Bug checker results keyed by the fingerprint of the candidate module.
+  absl::flat_hash_map<uint64_t, bool> candidate_results_;
 };
 
 }  // namespace bisect
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/tools/hlo_bisect/hlo_bisect_state.h"
 
+#include <cstdint>
 #include <initializer_list>
 #include <string>
 #include <utility>
@@ -22,6 +23,7 @@ limitations under the License.
 
 #include "absl/algorithm/container.h"
 #include "absl/status/statusor.h"
+#include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/hlo/ir/hlo_opcode.h"
 #include "xla/hlo/testlib/pattern_matcher_gmock.h"
@@ -59,6 +61,29 @@ class TestBugSearch : public BugCheckerInterface {
   std::vector<HloOpcode> opcodes_;
 };
 
+// Test bug checker that evaluates several candidates per batch.
+class ParallelTestBugSearch : public TestBugSearch {
+ public:
+  ParallelTestBugSearch(std::initializer_list<HloOpcode> opcodes,
+                        int64_t max_parallelism)
+      : TestBugSearch(opcodes), max_parallelism_(max_parallelism) {}
+
+  int64_t MaxParallelism() const override { return max_parallelism_; }
+
+  absl::StatusOr<std::vector<bool>> RunBatch(
+      absl::Span<const HloModule* const> modules) override {
+    EXPECT_LE(static_cast<int64_t>(modules.size()), max_parallelism_);
+    ++num_batches_;
+    return TestBugSearch::RunBatch(modules);
+  }
+
+  int64_t num_batches() const { return num_batches_; }
+
+ private:
+  int64_t max_parallelism_;
+  int64_t num_batches_ = 0;
+};
+
 Literal CreateLiteral(float value) {
   Literal result = Literal::CreateFromShape(ShapeUtil::MakeShape(F32, {}));
   result.PopulateWithValue(value);
@@ -112,6 +137,58 @@ TEST_F(HloBisectStateTest, TrimByInstructions) {
       GmockMatch(m::Multiply(m::Broadcast(m::Parameter(0)), m::Parameter(1))));
 }
 
+TEST_F(HloBisectStateTest, TrimByOutputsInParallel) {
+  const char* kModuleStr = R"(
+    HloModule test_module
+    ENTRY test_computation {
+      p1 = s32[8] parameter(0)
+      p2 = s32[8] parameter(1)
+      a = s32[8] add(p1, p2)
+      b = s32[8] multiply(p1, p2)
+      c = s32[8] subtract(p1, p2)
+      ROOT sum = tuple(a, b, c)
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kModuleStr));
+  ParallelTestBugSearch bug_checker({HloOpcode::kMultiply},
+                                    /*max_parallelism=*/2);
+  HloBisectState bisect(std::move(module), &bug_checker);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, bisect.TrimEntryComputation());
+  EXPECT_TRUE(changed);
+  EXPECT_GT(bug_checker.num_batches(), 0);
+  auto reduced_module = std::move(bisect).GetResult();
+  EXPECT_THAT(reduced_module->entry_computation()->root_instruction(),
+              GmockMatch(m::Multiply(m::Parameter(0), m::Parameter(1))));
+}
+
+TEST_F(HloBisectStateTest, TrimByInstructionsInParallel) {
+  const char* kModuleStr = R"(
+    HloModule axpy_module
+    ENTRY axpy_computation {
+      alpha = f32[] parameter(0)
+      broadcast = f32[10] broadcast(alpha), dimensions={}
+      x = f32[10] parameter(1)
+      ax = f32[10] multiply(broadcast, x)
+      y = f32[10] parameter(2)
+      negate = f32[10] negate(y)
+      ROOT add = f32[10] add(ax, negate)
+    }
+  )";
+  TF_ASSERT_OK_AND_ASSIGN(auto module,
+                          ParseAndReturnVerifiedModule(kModuleStr));
+  ParallelTestBugSearch bug_checker(
+      {HloOpcode::kMultiply, HloOpcode::kBroadcast}, /*max_parallelism=*/3);
+  HloBisectState bisect(std::move(module), &bug_checker);
+  TF_ASSERT_OK_AND_ASSIGN(bool changed, bisect.TrimEntryComputation());
+  EXPECT_TRUE(changed);
+  EXPECT_GT(bug_checker.num_batches(), 0);
+  auto reduced_module = std::move(bisect).GetResult();
+  EXPECT_THAT(
+      reduced_module->entry_computation()->root_instruction(),
+      GmockMatch(m::Multiply(m::Broadcast(m::Parameter(0)), m::Parameter(1))));
+}
+
 TEST_F(HloBisectStateTest, TrimByUsingRandomConstants) {
   const char* kModuleStr = R"(
     HloModule test_module
@@ -15,16 +15,27 @@ limitations under the License.
 
 #include "xla/tools/hlo_bisect/hlo_bisect_utils.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <random>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/cleanup/cleanup.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "xla/error_spec.h"
+#include "xla/hlo/builder/xla_computation.h"
 #include "xla/hlo/ir/hlo_instruction.h"
 #include "xla/hlo/parser/hlo_parser.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
 #include "xla/service/dump.h"
 #include "xla/service/hlo.pb.h"
 #include "xla/service/hlo_module_util.h"
@@ -35,8 +46,13 @@ limitations under the License.
 #include "xla/tests/literal_test_util.h"
 #include "xla/tests/test_utils.h"
 #include "xla/tools/prepare_reference_module.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
 #include "xla/tsl/platform/subprocess.h"
+#include "xla/tsl/platform/threadpool.h"
 #include "xla/util.h"
+#include "tsl/platform/fingerprint.h"
 #include "tsl/platform/path.h"
 
 namespace xla {
@@ -298,6 +314,131 @@ absl::flat_hash_map<std::string, Literal> ScriptChecker::GetResults() {
   return {};
 }
 
+TimingChecker::TimingChecker(std::unique_ptr<PjRtClient> client,
+                             HloModule* module,
+                             std::vector<Literal>&& input_data,
+                             absl::Duration threshold, int64_t num_repeats)
+    : client_(std::move(client)),
+      threshold_(threshold),
+      num_repeats_(std::max<int64_t>(num_repeats, 1)) {
+  CHECK(!client_->addressable_devices().empty());
+  if (input_data.empty()) {
+    std::minstd_rand0 rng_engine;
+    absl::StatusOr<std::vector<Literal>> input_status =
+        MakeFakeArguments(module, &rng_engine);
+    CHECK(input_status.ok());
+    input_data_ = std::move(input_status).value();
+  } else {
+    VLOG(2) << "Using provided input data";
+    input_data_ = std::move(input_data);
+  }
+}
+
+absl::StatusOr<bool> TimingChecker::Run(const HloModule& module) {
+  TF_ASSIGN_OR_RETURN(std::vector<bool> results, RunBatch({&module}));
+  return results.front();
+}
+
+absl::flat_hash_map<std::string, Literal> TimingChecker::GetResults() {
+  return {};
+}
+
+int64_t TimingChecker::MaxParallelism() const {
+  return client_->addressable_device_count();
+}
+
+absl::StatusOr<std::vector<bool>> TimingChecker::RunBatch(
+    absl::Span<const HloModule* const> modules) {
+  absl::Span<PjRtDevice* const> devices = client_->addressable_devices();
+  std::vector<absl::StatusOr<absl::Duration>> times(
+      modules.size(), absl::UnknownError("Module was not timed"));
+  {
+    // Candidates beyond the number of devices share a device, which skews
+    // their timings, so HloBisectState never batches more than that.
+    tsl::thread::ThreadPool pool(tsl::Env::Default(), "hlo_bisect_timing",
+                                 std::min(modules.size(), devices.size()));
+    for (size_t i = 0; i < modules.size(); ++i) {
+      pool.Schedule([&, i] {
+        times[i] = TimeModule(*modules[i], devices[i % devices.size()]);
+      });
+    }
+  }
+
+  std::vector<bool> results;
+  results.reserve(modules.size());
+  for (absl::StatusOr<absl::Duration>& time : times) {
+    TF_RETURN_IF_ERROR(time.status());
+    VLOG(2) << "Median execution time: " << absl::FormatDuration(*time)
+            << " (threshold: " << absl::FormatDuration(threshold_) << ")";
+    results.push_back(/*has_bug=*/*time >= threshold_);
+  }
+  return results;
+}
+
+absl::StatusOr<absl::Duration> TimingChecker::TimeModule(
+    const HloModule& module, PjRtDevice* device) {
+  TF_ASSIGN_OR_RETURN(std::shared_ptr<PjRtLoadedExecutable> executable,
+                      GetOrCompile(module));
+
+  TF_ASSIGN_OR_RETURN(PjRtMemorySpace * memory_space,
+                      device->default_memory_space());
+  std::vector<std::unique_ptr<PjRtBuffer>> buffers;
+  std::vector<PjRtBuffer*> arguments;
+  for (const Literal& literal : input_data_) {
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtBuffer> buffer,
+                        client_->BufferFromHostLiteral(literal, memory_space));
+    TF_RETURN_IF_ERROR(buffer->GetReadyFuture().Await());
+    arguments.push_back(buffer.get());
+    buffers.push_back(std::move(buffer));
+  }
+
+  // The first execution is a warmup and is not timed.
+  std::vector<absl::Duration> times;
+  times.reserve(num_repeats_);
+  for (int64_t i = 0; i <= num_repeats_; ++i) {
+    absl::Time start = absl::Now();
+    TF_ASSIGN_OR_RETURN(std::vector<std::unique_ptr<PjRtBuffer>> results,
+                        executable->ExecuteSharded(arguments, device,
+                                                   ExecuteOptions()));
+    for (const std::unique_ptr<PjRtBuffer>& result : results) {
+      TF_RETURN_IF_ERROR(result->GetReadyFuture().Await());
+    }
+    if (i > 0) {
+      times.push_back(absl::Now() - start);
+    }
+  }
+  auto median = times.begin() + times.size() / 2;
+  absl::c_nth_element(times, median);
+  return *median;
+}
+
+absl::StatusOr<std::shared_ptr<PjRtLoadedExecutable>>
+TimingChecker::GetOrCompile(const HloModule& module) {
+  const uint64_t fingerprint = tsl::Fingerprint64(
+      module.ToString(HloPrintOptions::Canonical()
+                          .set_print_large_constants(true)
+                          .set_print_backend_config(true)));
+  {
+    absl::MutexLock lock(&mu_);
+    auto it = executables_.find(fingerprint);
+    if (it != executables_.end()) {
+      return it->second;
+    }
+  }
+
+  // Compile outside of the lock so that a batch of candidates compiles
+  // concurrently. Candidates can run on any device, so compile them portably.
+  CompileOptions options;
+  options.compile_portable_executable = true;
+  TF_ASSIGN_OR_RETURN(
+      std::unique_ptr<PjRtLoadedExecutable> executable,
+      client_->CompileAndLoad(XlaComputation(module.ToProto()), options));
+
+  absl::MutexLock lock(&mu_);
+  return executables_.try_emplace(fingerprint, std::move(executable))
+      .first->second;
+}
+
 absl::StatusOr<std::unique_ptr<HloModule>> BisectRunner::RunEntry() {
   HloBisectState hlo_bisect(std::move(module_), bug_checker_.get());
   TF_ASSIGN_OR_RETURN(bool has_bug, hlo_bisect.ShouldProcess());
@@ -23,10 +23,17 @@ limitations under the License.
 #include <utility>
 #include <vector>
 
+#include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
 #include "xla/error_spec.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/literal.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
 #include "xla/service/hlo_runner_interface.h"
 #include "xla/tools/hlo_bisect/hlo_bisect_state.h"
 
@@ -68,6 +75,40 @@ class ScriptChecker : public BugCheckerInterface {
   std::string path_to_script_;
 };
 
+// Considers an HLO module to be buggy if its median execution time on the
+// client's devices is at least `threshold`, for bisecting performance
+// regressions. Each distinct module is compiled once and the executable is
+// reused across runs, and a batch of candidates is timed concurrently with one
+// candidate per addressable device.
+class TimingChecker : public BugCheckerInterface {
+ public:
+  TimingChecker(std::unique_ptr<PjRtClient> client, HloModule* module,
+                std::vector<Literal>&& input_data, absl::Duration threshold,
+                int64_t num_repeats);
+  absl::StatusOr<bool> Run(const HloModule& module) override;
+  absl::flat_hash_map<std::string, Literal> GetResults() override;
+  int64_t MaxParallelism() const override;
+  absl::StatusOr<std::vector<bool>> RunBatch(
+      absl::Span<const HloModule* const> modules) override;
+
+  // Returns the median execution time of `module` on `device`.
+  absl::StatusOr<absl::Duration> TimeModule(const HloModule& module,
+                                            PjRtDevice* device);
+
+ private:
+  absl::StatusOr<std::shared_ptr<PjRtLoadedExecutable>> GetOrCompile(
+      const HloModule& module);
+
+  std::unique_ptr<PjRtClient> client_;
+  std::vector<Literal> input_data_;
+  absl::Duration threshold_;
+  int64_t num_repeats_;
+
+  absl::Mutex mu_;
+  absl::flat_hash_map<uint64_t, std::shared_ptr<PjRtLoadedExecutable>>
+      executables_ ABSL_GUARDED_BY(mu_);
+};
+
 // Runner class for the bisect tool.
 class BisectRunner {
  public:
@@ -0,0 +1,196 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/hlo_hotspot_extractor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/match.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_computation.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/literal.h"
+#include "xla/python/xplane_to_profile_instructions.h"
+#include "xla/service/hlo.pb.h"
+#include "xla/tests/test_utils.h"
+#include "xla/tools/hlo_decomposer.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/util.h"
+#include "tsl/platform/path.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+#include "tsl/profiler/protobuf/xplane.pb.h"
+
+namespace xla {
+namespace {
+
+// Separates the module fingerprint from the instruction name in profile
+// entries.
+constexpr absl::string_view kCostNameSep = "::";
+
+// Returns the instruction name of a profile entry.
+absl::string_view GetInstructionName(absl::string_view cost_name) {
+  size_t pos = cost_name.rfind(kCostNameSep);
+  return pos == absl::string_view::npos
+             ? cost_name
+             : cost_name.substr(pos + kCostNameSep.size());
+}
+
+// Instructions that don't execute anything on their own.
+bool IsTrivial(const HloInstruction* instruction) {
+  switch (instruction->opcode()) {
+    case HloOpcode::kParameter:
+    case HloOpcode::kConstant:
+    case HloOpcode::kTuple:
+    case HloOpcode::kGetTupleElement:
+    case HloOpcode::kBitcast:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+absl::StatusOr<tensorflow::profiler::ProfiledInstructionsProto> LoadProfile(
+    const std::string& path) {
+  tsl::Env* env = tsl::Env::Default();
+  tensorflow::profiler::ProfiledInstructionsProto profile;
+  if (env->IsDirectory(path).ok()) {
+    TF_RETURN_IF_ERROR(
+        ConvertXplaneUnderLogdirToProfiledInstructionsProto(path, &profile));
+  } else if (absl::EndsWith(path, "xplane.pb")) {
+    tensorflow::profiler::XSpace xspace;
+    TF_RETURN_IF_ERROR(tsl::ReadBinaryProto(env, path, &xspace));
+    TF_RETURN_IF_ERROR(
+        ConvertXplaneToProfiledInstructionsProto({xspace}, &profile));
+  } else if (absl::EndsWith(path, ".pbtxt")) {
+    TF_RETURN_IF_ERROR(tsl::ReadTextProto(env, path, &profile));
+  } else {
+    TF_RETURN_IF_ERROR(tsl::ReadBinaryProto(env, path, &profile));
+  }
+  return profile;
+}
+
+std::vector<std::pair<const HloInstruction*, double>> FindHottestInstructions(
+    const HloModule& module,
+    const tensorflow::profiler::ProfiledInstructionsProto& profile,
+    int64_t top_n) {
+  // The same instruction can be profiled under several fingerprints, keep the
+  // highest cost.
+  absl::flat_hash_map<absl::string_view, double> costs;
+  for (const auto& cost : profile.costs()) {
+    double& max_cost = costs[GetInstructionName(cost.name())];
+    max_cost = std::max(max_cost, cost.cost_us());
+  }
+
+  std::vector<std::pair<const HloInstruction*, double>> hottest;
+  for (const HloComputation* computation :
+       module.MakeNonfusionComputations()) {
+    for (const HloInstruction* instruction : computation->instructions()) {
+      if (IsTrivial(instruction)) {
+        continue;
+      }
+      auto it = costs.find(instruction->name());
+      if (it != costs.end()) {
+        hottest.emplace_back(instruction, it->second);
+      }
+    }
+  }
+
+  // Sort by decreasing cost, and by name for a deterministic order.
+  absl::c_sort(hottest, [](const auto& a, const auto& b) {
+    if (a.second != b.second) {
+      return a.second > b.second;
+    }
+    return a.first->name() < b.first->name();
+  });
+  if (static_cast<int64_t>(hottest.size()) > top_n) {
+    hottest.resize(top_n);
+  }
+  return hottest;
+}
+
+absl::StatusOr<std::vector<Hotspot>> ExtractHotspots(
+    const HloModule& module,
+    const tensorflow::profiler::ProfiledInstructionsProto& profile,
+    int64_t top_n) {
+  std::vector<Hotspot> hotspots;
+  for (const auto& [instruction, cost_us] :
+       FindHottestInstructions(module, profile, top_n)) {
+    Hotspot hotspot;
+    hotspot.instruction_name = std::string(instruction->name());
+    hotspot.cost_us = cost_us;
+    hotspot.module = ExtractInstructionIntoNewModule(*instruction);
+    hotspot.module->mutable_config().set_debug_options(
+        module.config().debug_options());
+
+    TF_ASSIGN_OR_RETURN(hotspot.arguments,
+                        MakeFakeArguments(hotspot.module.get()));
+    for (int64_t i = 0; i < instruction->operand_count(); ++i) {
+      const HloInstruction* operand = instruction->operand(i);
+      if (operand->opcode() == HloOpcode::kConstant) {
+        hotspot.arguments[i] = operand->literal().Clone();
+      }
+    }
+    hotspots.push_back(std::move(hotspot));
+  }
+  return hotspots;
+}
+
+absl::Status WriteHotspots(absl::Span<const Hotspot> hotspots,
+                           absl::string_view output_dir) {
+  tsl::Env* env = tsl::Env::Default();
+  TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(std::string(output_dir)));
+  for (size_t rank = 0; rank < hotspots.size(); ++rank) {
+    const Hotspot& hotspot = hotspots[rank];
+    std::string path = tsl::io::JoinPath(
+        output_dir, SanitizeFileName(absl::StrFormat(
+                        "%02d_%s", rank, hotspot.instruction_name)));
+
+    TF_RETURN_IF_ERROR(tsl::WriteStringToFile(
+        env, absl::StrCat(path, ".hlo"),
+        hotspot.module->ToString(HloPrintOptions::Canonical()
+                                     .set_print_large_constants(true)
+                                     .set_print_backend_config(true))));
+
+    HloSnapshot snapshot;
+    *snapshot.mutable_hlo()->mutable_hlo_module() = hotspot.module->ToProto();
+    for (const Literal& argument : hotspot.arguments) {
+      *snapshot.add_arguments() = argument.ToProto();
+    }
+    TF_RETURN_IF_ERROR(tsl::WriteBinaryProto(
+        env, absl::StrCat(path, ".snapshot.pb"), snapshot));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace xla
@@ -0,0 +1,78 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_TOOLS_HLO_HOTSPOT_EXTRACTOR_H_
+#define XLA_TOOLS_HLO_HOTSPOT_EXTRACTOR_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/span.h"
+#include "xla/hlo/ir/hlo_instruction.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/literal.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+
+namespace xla {
+
+// An expensive instruction of a profiled module, extracted into a standalone
+// module that can be run on its own.
+struct Hotspot {
+  std::string instruction_name;
+  double cost_us = 0.0;
+  std::unique_ptr<HloModule> module;
+  // Arguments of `module`: operands that are constants in the original module
+  // keep their values, other ones get fake values that respect the way the
+  // instruction uses them (e.g. in-bounds gather indices).
+  std::vector<Literal> arguments;
+};
+
+// Loads a profile from `path`: a directory with profiles (`*.xplane.pb`), an
+// XSpace (`*.xplane.pb`), or a ProfiledInstructionsProto in text (`*.pbtxt`) or
+// binary format.
+absl::StatusOr<tensorflow::profiler::ProfiledInstructionsProto> LoadProfile(
+    const std::string& path);
+
+// Returns the `top_n` instructions of the non-fusion computations of `module`
+// with the highest cost in `profile`, most expensive first. Profile entries
+// may be prefixed by a module fingerprint ("<fingerprint>::<name>"), as
+// produced by ConvertXplaneToProfiledInstructionsProto.
+std::vector<std::pair<const HloInstruction*, double>> FindHottestInstructions(
+    const HloModule& module,
+    const tensorflow::profiler::ProfiledInstructionsProto& profile,
+    int64_t top_n);
+
+// Extracts the `top_n` most expensive instructions of `module` (fusions, loops
+// and other top-level instructions) into standalone modules with inputs.
+absl::StatusOr<std::vector<Hotspot>> ExtractHotspots(
+    const HloModule& module,
+    const tensorflow::profiler::ProfiledInstructionsProto& profile,
+    int64_t top_n);
+
+// Writes every hotspot to `output_dir` as `<rank>_<instruction>.hlo` (HLO text)
+// and `<rank>_<instruction>.snapshot.pb` (HloSnapshot including the
+// arguments), both runnable with run_hlo_module or the multihost HLO runner.
+absl::Status WriteHotspots(absl::Span<const Hotspot> hotspots,
+                           absl::string_view output_dir);
+
+}  // namespace xla
+
+#endif  // XLA_TOOLS_HLO_HOTSPOT_EXTRACTOR_H_
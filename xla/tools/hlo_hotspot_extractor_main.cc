@@ -0,0 +1,110 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// A tool for extracting the most expensive instructions of a profiled HLO
+// module into standalone HLO benchmarks.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "xla/debug_options_flags.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/tools/hlo_hotspot_extractor.h"
+#include "xla/tools/hlo_module_loader.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/util/command_line_flags.h"
+#include "tsl/platform/init_main.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+
+namespace {
+
+const char* const kUsage = R"(
+    This tool extracts the most expensive fusions and other top-level
+    instructions of a profiled HLO module into standalone HLO modules with
+    inputs, to reproduce performance problems in isolation.
+
+    Usage:
+
+      bazel run hlo_hotspot_extractor -- --hlo=path/to/module.hlo \
+        --profile=path/to/profile.xplane.pb --top_n=5 --output_dir=/tmp/hot
+
+    The profile is an XSpace, a directory of XSpaces or a
+    ProfiledInstructionsProto. Every hotspot is written as HLO text and as an
+    HloSnapshot with its arguments, e.g.:
+
+      bazel run //xla/tools/multihost_hlo_runner:hlo_runner_main -- \
+        --input_format=snapshot_proto_binary /tmp/hot/00_fusion.snapshot.pb
+    )";
+
+absl::Status ExtractHotspots(const std::string& hlo, const std::string& profile,
+                             int64_t top_n, const std::string& output_dir) {
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<xla::HloModule> module,
+                      xla::LoadModuleFromFile(hlo));
+  TF_ASSIGN_OR_RETURN(tensorflow::profiler::ProfiledInstructionsProto costs,
+                      xla::LoadProfile(profile));
+  TF_ASSIGN_OR_RETURN(std::vector<xla::Hotspot> hotspots,
+                      xla::ExtractHotspots(*module, costs, top_n));
+  if (hotspots.empty()) {
+    return absl::NotFoundError(
+        absl::StrCat("No instruction of ", module->name(),
+                     " was found in the profile"));
+  }
+  for (const xla::Hotspot& hotspot : hotspots) {
+    LOG(INFO) << hotspot.instruction_name << ": " << hotspot.cost_us << "us";
+  }
+  return xla::WriteHotspots(hotspots, output_dir);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string hlo;
+  std::string profile;
+  int64_t top_n = 10;
+  std::string output_dir = "/tmp/hlo_hotspots";
+  std::vector<tsl::Flag> flag_list = {
+      tsl::Flag("hlo", &hlo, "The profiled HLO module."),
+      tsl::Flag("profile", &profile, "The profile of the HLO module."),
+      tsl::Flag("top_n", &top_n, "Number of instructions to extract."),
+      tsl::Flag("output_dir", &output_dir,
+                "The directory to write the extracted modules to."),
+  };
+  xla::AppendDebugOptionsFlags(&flag_list);
+  const std::string usage_string =
+      absl::StrCat(kUsage, "\n\n", tsl::Flags::Usage(argv[0], flag_list));
+  bool parse_ok = tsl::Flags::Parse(&argc, argv, flag_list);
+  tsl::port::InitMain(usage_string.c_str(), &argc, &argv);
+
+  if (!parse_ok) {
+    LOG(QFATAL) << usage_string;
+  }
+  if (hlo.empty() || profile.empty()) {
+    LOG(QFATAL) << "Must specify --hlo and --profile";
+  }
+
+  absl::Status status = ExtractHotspots(hlo, profile, top_n, output_dir);
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return 1;
+  }
+  return 0;
+}
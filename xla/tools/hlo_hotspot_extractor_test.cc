@@ -0,0 +1,116 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/hlo_hotspot_extractor.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/strings/string_view.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/ir/hlo_opcode.h"
+#include "xla/tests/hlo_test_base.h"
+#include "xla/tsl/lib/core/status_test_util.h"
+#include "xla/tsl/platform/env.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/tsl/platform/test.h"
+#include "tsl/platform/path.h"
+#include "tsl/profiler/protobuf/profiled_instructions.pb.h"
+
+namespace xla {
+namespace {
+
+using HloHotspotExtractorTest = HloTestBase;
+
+constexpr absl::string_view kHlo = R"(
+  HloModule m
+
+  fused_computation {
+    p0 = f32[16] parameter(0)
+    p1 = f32[16] parameter(1)
+    ROOT multiply = f32[16] multiply(p0, p1)
+  }
+
+  ENTRY e {
+    p0 = f32[16] parameter(0)
+    c = f32[16] constant({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15})
+    fusion = f32[16] fusion(p0, c), kind=kLoop, calls=fused_computation
+    negate = f32[16] negate(fusion)
+    ROOT add = f32[16] add(negate, p0)
+  })";
+
+tensorflow::profiler::ProfiledInstructionsProto MakeProfile() {
+  tensorflow::profiler::ProfiledInstructionsProto profile;
+  auto add_cost = [&](absl::string_view name, double cost_us) {
+    auto* cost = profile.add_costs();
+    cost->set_name(std::string(name));
+    cost->set_cost_us(cost_us);
+  };
+  add_cost("1234::fusion", 30.0);
+  add_cost("negate", 10.0);
+  add_cost("add", 20.0);
+  // Instructions of fused computations are not extracted on their own.
+  add_cost("multiply", 100.0);
+  return profile;
+}
+
+TEST_F(HloHotspotExtractorTest, FindsHottestInstructions) {
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHlo));
+  auto hottest = FindHottestInstructions(*module, MakeProfile(), /*top_n=*/2);
+  ASSERT_EQ(hottest.size(), 2);
+  EXPECT_EQ(hottest[0].first->name(), "fusion");
+  EXPECT_EQ(hottest[0].second, 30.0);
+  EXPECT_EQ(hottest[1].first->name(), "add");
+}
+
+TEST_F(HloHotspotExtractorTest, ExtractsHotspotsWithConstantArguments) {
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHlo));
+  TF_ASSERT_OK_AND_ASSIGN(std::vector<Hotspot> hotspots,
+                          ExtractHotspots(*module, MakeProfile(), /*top_n=*/1));
+  ASSERT_EQ(hotspots.size(), 1);
+  const Hotspot& hotspot = hotspots[0];
+  EXPECT_EQ(hotspot.instruction_name, "fusion");
+  EXPECT_EQ(hotspot.module->entry_computation()->num_parameters(), 2);
+  ASSERT_EQ(hotspot.arguments.size(), 2);
+  EXPECT_EQ(hotspot.arguments[1],
+            module->entry_computation()
+                ->GetInstructionWithName("c")
+                ->literal());
+}
+
+TEST_F(HloHotspotExtractorTest, WritesRunnableHotspots) {
+  TF_ASSERT_OK_AND_ASSIGN(auto module, ParseAndReturnVerifiedModule(kHlo));
+  TF_ASSERT_OK_AND_ASSIGN(std::vector<Hotspot> hotspots,
+                          ExtractHotspots(*module, MakeProfile(), /*top_n=*/3));
+  std::string output_dir = tsl::io::JoinPath(tsl::testing::TmpDir(), "hot");
+  TF_ASSERT_OK(WriteHotspots(hotspots, output_dir));
+
+  tsl::Env* env = tsl::Env::Default();
+  TF_EXPECT_OK(env->FileExists(tsl::io::JoinPath(output_dir, "00_fusion.hlo")));
+  TF_EXPECT_OK(env->FileExists(
+      tsl::io::JoinPath(output_dir, "02_negate.snapshot.pb")));
+
+  std::string hlo;
+  TF_ASSERT_OK(tsl::ReadFileToString(
+      env, tsl::io::JoinPath(output_dir, "01_add.hlo"), &hlo));
+  TF_ASSERT_OK_AND_ASSIGN(auto extracted, ParseAndReturnVerifiedModule(hlo));
+  EXPECT_EQ(extracted->entry_computation()->root_instruction()->opcode(),
+            HloOpcode::kAdd);
+}
+
+}  // namespace
+}  // namespace xla
@@ -133,7 +133,9 @@ absl::StatusOr<std::unique_ptr<HloModule>> LoadModuleFromData(
       config_modifier_hook(&config);
     }
     TF_ASSIGN_OR_RETURN(
-        module, HloModule::CreateFromProto(proto.hlo().hlo_module(), config));
+        module,
+        HloModule::CreateFromProto(
+            std::move(*proto.mutable_hlo()->mutable_hlo_module()), config));
   }
   return std::move(module);
 }
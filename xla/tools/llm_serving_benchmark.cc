@@ -0,0 +1,481 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/llm_serving_benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "absl/strings/str_replace.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
+#include "absl/types/span.h"
+#include "xla/hlo/builder/xla_computation.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/parser/hlo_parser.h"
+#include "xla/literal.h"
+#include "xla/literal_util.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/pjrt_executable.h"
+#include "xla/shape.h"
+#include "xla/shape_util.h"
+#include "xla/tsl/framework/allocator.h"
+#include "xla/tsl/platform/errors.h"
+#include "xla/tsl/platform/statusor.h"
+#include "xla/xla_data.pb.h"
+
+namespace xla {
+
+namespace {
+
+// Number of parameters of a step that precede the per-layer parameters:
+// tokens, position and the embedding table.
+constexpr int64_t kNumGlobalParameters = 3;
+// Number of parameters of every layer: wq, wk, wv, wo, w1, w2 and the K and V
+// caches.
+constexpr int64_t kNumLayerParameters = 8;
+constexpr int64_t kNumLayerWeights = 6;
+
+constexpr char kStepHeader[] = R"(
+HloModule transformer_step_t$T, input_output_alias={ $ALIASES }
+
+max {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT max = f32[] maximum(lhs, rhs)
+}
+
+add {
+  lhs = f32[] parameter(0)
+  rhs = f32[] parameter(1)
+  ROOT add = f32[] add(lhs, rhs)
+}
+
+ENTRY e {
+  tokens = s32[$B,$T] parameter(0)
+  pos = s32[] parameter(1)
+  embedding = f32[$V,$H] parameter(2)
+  x0 = f32[$B,$T,$H] gather(embedding, tokens), offset_dims={2},
+    collapsed_slice_dims={0}, start_index_map={0}, index_vector_dim=2,
+    slice_sizes={1,$H}
+
+  zero = s32[] constant(0)
+  zero_f = f32[] constant(0)
+  zero_ffn = f32[$B,$T,$F] broadcast(zero_f), dimensions={}
+  neg_inf = f32[] constant(-inf)
+  neg_inf_b = f32[$B,$T,$S] broadcast(neg_inf), dimensions={}
+  scale = f32[] constant($SCALE)
+  scale_b = f32[$B,$T,$S] broadcast(scale), dimensions={}
+
+  key_pos = s32[$B,$T,$S] iota(), iota_dimension=2
+  query_offset = s32[$B,$T,$S] iota(), iota_dimension=1
+  pos_b = s32[$B,$T,$S] broadcast(pos), dimensions={}
+  query_pos = s32[$B,$T,$S] add(query_offset, pos_b)
+  mask = pred[$B,$T,$S] compare(key_pos, query_pos), direction=LE
+)";
+
+constexpr char kStepLayer[] = R"(
+  l$L_wq = f32[$H,$H] parameter($P0)
+  l$L_wk = f32[$H,$H] parameter($P1)
+  l$L_wv = f32[$H,$H] parameter($P2)
+  l$L_wo = f32[$H,$H] parameter($P3)
+  l$L_w1 = f32[$H,$F] parameter($P4)
+  l$L_w2 = f32[$F,$H] parameter($P5)
+  l$L_k_cache = f32[$B,$S,$H] parameter($P6)
+  l$L_v_cache = f32[$B,$S,$H] parameter($P7)
+
+  l$L_q = f32[$B,$T,$H] dot(x$L, l$L_wq), lhs_contracting_dims={2},
+    rhs_contracting_dims={0}
+  l$L_k = f32[$B,$T,$H] dot(x$L, l$L_wk), lhs_contracting_dims={2},
+    rhs_contracting_dims={0}
+  l$L_v = f32[$B,$T,$H] dot(x$L, l$L_wv), lhs_contracting_dims={2},
+    rhs_contracting_dims={0}
+  l$L_k_cache_new = f32[$B,$S,$H] dynamic-update-slice(l$L_k_cache, l$L_k,
+    zero, pos, zero)
+  l$L_v_cache_new = f32[$B,$S,$H] dynamic-update-slice(l$L_v_cache, l$L_v,
+    zero, pos, zero)
+
+  l$L_scores = f32[$B,$T,$S] dot(l$L_q, l$L_k_cache_new), lhs_batch_dims={0},
+    lhs_contracting_dims={2}, rhs_batch_dims={0}, rhs_contracting_dims={2}
+  l$L_scaled = f32[$B,$T,$S] multiply(l$L_scores, scale_b)
+  l$L_masked = f32[$B,$T,$S] select(mask, l$L_scaled, neg_inf_b)
+  l$L_max = f32[$B,$T] reduce(l$L_masked, neg_inf), dimensions={2},
+    to_apply=max
+  l$L_max_b = f32[$B,$T,$S] broadcast(l$L_max), dimensions={0,1}
+  l$L_shifted = f32[$B,$T,$S] subtract(l$L_masked, l$L_max_b)
+  l$L_exp = f32[$B,$T,$S] exponential(l$L_shifted)
+  l$L_sum = f32[$B,$T] reduce(l$L_exp, zero_f), dimensions={2}, to_apply=add
+  l$L_sum_b = f32[$B,$T,$S] broadcast(l$L_sum), dimensions={0,1}
+  l$L_probs = f32[$B,$T,$S] divide(l$L_exp, l$L_sum_b)
+  l$L_attn = f32[$B,$T,$H] dot(l$L_probs, l$L_v_cache_new),
+    lhs_batch_dims={0}, lhs_contracting_dims={2}, rhs_batch_dims={0},
+    rhs_contracting_dims={1}
+  l$L_o = f32[$B,$T,$H] dot(l$L_attn, l$L_wo), lhs_contracting_dims={2},
+    rhs_contracting_dims={0}
+  l$L_x = f32[$B,$T,$H] add(x$L, l$L_o)
+
+  l$L_h = f32[$B,$T,$F] dot(l$L_x, l$L_w1), lhs_contracting_dims={2},
+    rhs_contracting_dims={0}
+  l$L_relu = f32[$B,$T,$F] maximum(l$L_h, zero_ffn)
+  l$L_m = f32[$B,$T,$H] dot(l$L_relu, l$L_w2), lhs_contracting_dims={2},
+    rhs_contracting_dims={0}
+  x$NEXT = f32[$B,$T,$H] add(l$L_x, l$L_m)
+)";
+
+constexpr char kStepFooter[] = R"(
+  last = f32[$B,1,$H] slice(x$N), slice={[0:$B], [$LAST:$T], [0:$H]}
+  last_2d = f32[$B,$H] reshape(last)
+  logits = f32[$B,$V] dot(last_2d, embedding), lhs_contracting_dims={1},
+    rhs_contracting_dims={1}
+  ROOT result = (f32[$B,$V], $CACHE_SHAPES) tuple(logits, $CACHES)
+}
+)";
+
+absl::Status ValidateOptions(const LlmServingBenchmarkOptions& options) {
+  for (auto [name, value] : {
+           std::make_pair("batch_size", options.batch_size),
+           std::make_pair("prompt_length", options.prompt_length),
+           std::make_pair("num_decode_steps", options.num_decode_steps),
+           std::make_pair("num_layers", options.num_layers),
+           std::make_pair("hidden_size", options.hidden_size),
+           std::make_pair("ffn_size", options.ffn_size),
+           std::make_pair("vocab_size", options.vocab_size),
+       }) {
+    if (value <= 0) {
+      return absl::InvalidArgumentError(
+          absl::StrCat(name, " must be positive, got ", value));
+    }
+  }
+  if (options.num_warmup_requests < 0) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("num_warmup_requests must be non-negative, got ",
+                     options.num_warmup_requests));
+  }
+  return absl::OkStatus();
+}
+
+int64_t MaxSequenceLength(const LlmServingBenchmarkOptions& options) {
+  return options.prompt_length + options.num_decode_steps;
+}
+
+absl::StatusOr<std::unique_ptr<PjRtLoadedExecutable>> CompileStep(
+    PjRtClient* client, const LlmServingBenchmarkOptions& options,
+    int64_t num_tokens) {
+  TF_ASSIGN_OR_RETURN(
+      std::unique_ptr<HloModule> module,
+      ParseAndReturnUnverifiedModule(
+          GetTransformerStepHloText(options, num_tokens)));
+  return client->CompileAndLoad(XlaComputation(module->ToProto()),
+                                CompileOptions());
+}
+
+// Picks the most likely next token of every sequence from `logits`.
+absl::StatusOr<Literal> GreedySample(PjRtBuffer* logits) {
+  TF_ASSIGN_OR_RETURN(std::shared_ptr<Literal> literal,
+                      logits->ToLiteralSync());
+  const int64_t batch_size = literal->shape().dimensions(0);
+  const int64_t vocab_size = literal->shape().dimensions(1);
+  absl::Span<const float> data = literal->data<float>();
+
+  Literal tokens(ShapeUtil::MakeShape(S32, {batch_size, 1}));
+  for (int64_t b = 0; b < batch_size; ++b) {
+    auto row = data.subspan(b * vocab_size, vocab_size);
+    tokens.Set<int32_t>({b, 0},
+                        std::distance(row.begin(), absl::c_max_element(row)));
+  }
+  return tokens;
+}
+
+// Device buffers of the model: the embedding table, the weights of every
+// layer and the KV caches.
+struct ModelBuffers {
+  std::unique_ptr<PjRtBuffer> embedding;
+  std::vector<std::unique_ptr<PjRtBuffer>> weights;
+  std::vector<std::unique_ptr<PjRtBuffer>> caches;
+};
+
+class LlmServer {
+ public:
+  LlmServer(PjRtClient* client, PjRtDevice* device,
+            PjRtMemorySpace* memory_space,
+            const LlmServingBenchmarkOptions& options,
+            PjRtLoadedExecutable* prefill, PjRtLoadedExecutable* decode)
+      : client_(client),
+        device_(device),
+        memory_space_(memory_space),
+        options_(options),
+        prefill_(prefill),
+        decode_(decode) {}
+
+  absl::Status Initialize() {
+    std::minstd_rand0 engine;
+    const int64_t h = options_.hidden_size;
+    const int64_t f = options_.ffn_size;
+    TF_ASSIGN_OR_RETURN(
+        model_.embedding,
+        RandomBuffer(ShapeUtil::MakeShape(F32, {options_.vocab_size, h}),
+                     engine));
+    for (int64_t i = 0; i < options_.num_layers; ++i) {
+      for (const Shape& shape : {ShapeUtil::MakeShape(F32, {h, h}),
+                                 ShapeUtil::MakeShape(F32, {h, h}),
+                                 ShapeUtil::MakeShape(F32, {h, h}),
+                                 ShapeUtil::MakeShape(F32, {h, h}),
+                                 ShapeUtil::MakeShape(F32, {h, f}),
+                                 ShapeUtil::MakeShape(F32, {f, h})}) {
+        TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtBuffer> weight,
+                            RandomBuffer(shape, engine));
+        model_.weights.push_back(std::move(weight));
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  absl::StatusOr<LlmServingBenchmarkResult> Serve() {
+    // Sequences start with empty caches.
+    model_.caches.clear();
+    Shape cache_shape = ShapeUtil::MakeShape(
+        F32, {options_.batch_size, MaxSequenceLength(options_),
+              options_.hidden_size});
+    for (int64_t i = 0; i < 2 * options_.num_layers; ++i) {
+      TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtBuffer> cache,
+                          ToDevice(Literal::CreateFromShape(cache_shape)));
+      model_.caches.push_back(std::move(cache));
+    }
+
+    std::minstd_rand0 engine;
+    std::uniform_int_distribution<int32_t> dist(0, options_.vocab_size - 1);
+    Literal prompt(ShapeUtil::MakeShape(
+        S32, {options_.batch_size, options_.prompt_length}));
+    for (int32_t& token : prompt.data<int32_t>()) {
+      token = dist(engine);
+    }
+
+    LlmServingBenchmarkResult result;
+
+    absl::Time start = absl::Now();
+    TF_ASSIGN_OR_RETURN(Literal tokens, Step(prefill_, prompt, 0));
+    result.time_to_first_token = absl::Now() - start;
+
+    std::vector<absl::Duration> latencies;
+    latencies.reserve(options_.num_decode_steps);
+    for (int64_t i = 0; i < options_.num_decode_steps; ++i) {
+      absl::Time step_start = absl::Now();
+      TF_ASSIGN_OR_RETURN(tokens,
+                          Step(decode_, tokens, options_.prompt_length + i));
+      latencies.push_back(absl::Now() - step_start);
+    }
+
+    absl::Duration decode_time;
+    for (absl::Duration latency : latencies) {
+      decode_time += latency;
+    }
+    absl::c_sort(latencies);
+    result.mean_token_latency = decode_time / options_.num_decode_steps;
+    result.p99_token_latency =
+        latencies[std::min<int64_t>(latencies.size() - 1,
+                                    std::ceil(0.99 * latencies.size()) - 1)];
+    result.tokens_per_second =
+        options_.batch_size * options_.num_decode_steps /
+        absl::ToDoubleSeconds(decode_time);
+    return result;
+  }
+
+ private:
+  absl::StatusOr<std::unique_ptr<PjRtBuffer>> ToDevice(
+      const Literal& literal) {
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtBuffer> buffer,
+                        client_->BufferFromHostLiteral(literal, memory_space_));
+    // `literal` may go out of scope, wait for the transfer to read it.
+    TF_RETURN_IF_ERROR(buffer->GetReadyFuture().Await());
+    return buffer;
+  }
+
+  absl::StatusOr<std::unique_ptr<PjRtBuffer>> RandomBuffer(
+      const Shape& shape, std::minstd_rand0& engine) {
+    TF_ASSIGN_OR_RETURN(Literal literal,
+                        LiteralUtil::CreateRandomLiteral<F32>(
+                            shape, &engine, /*mean=*/0.0f, /*stddev=*/0.02f));
+    return ToDevice(literal);
+  }
+
+  // Runs one step of `executable` for `tokens` at `position`, replaces the KV
+  // caches with the updated ones and returns the next tokens.
+  absl::StatusOr<Literal> Step(PjRtLoadedExecutable* executable,
+                               const Literal& tokens, int32_t position) {
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtBuffer> tokens_buffer,
+                        ToDevice(tokens));
+    TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtBuffer> position_buffer,
+                        ToDevice(LiteralUtil::CreateR0<int32_t>(position)));
+
+    std::vector<PjRtBuffer*> args = {tokens_buffer.get(),
+                                     position_buffer.get(),
+                                     model_.embedding.get()};
+    for (int64_t i = 0; i < options_.num_layers; ++i) {
+      for (int64_t j = 0; j < kNumLayerWeights; ++j) {
+        args.push_back(model_.weights[i * kNumLayerWeights + j].get());
+      }
+      args.push_back(model_.caches[2 * i].get());
+      args.push_back(model_.caches[2 * i + 1].get());
+    }
+
+    ExecuteOptions execute_options;
+    execute_options.untuple_result = true;
+    TF_ASSIGN_OR_RETURN(
+        std::vector<std::unique_ptr<PjRtBuffer>> results,
+        executable->ExecuteSharded(args, device_, execute_options));
+    if (results.size() != 1 + model_.caches.size()) {
+      return absl::InternalError(
+          absl::StrCat("Expected ", 1 + model_.caches.size(),
+                       " results, got ", results.size()));
+    }
+
+    // Caches are donated to the step, continue with the updated ones.
+    for (size_t i = 0; i < model_.caches.size(); ++i) {
+      model_.caches[i] = std::move(results[i + 1]);
+    }
+    return GreedySample(results[0].get());
+  }
+
+  PjRtClient* client_;
+  PjRtDevice* device_;
+  PjRtMemorySpace* memory_space_;
+  LlmServingBenchmarkOptions options_;
+  PjRtLoadedExecutable* prefill_;
+  PjRtLoadedExecutable* decode_;
+  ModelBuffers model_;
+};
+
+// Returns the device memory footprint of `executable` according to its
+// buffer assignment.
+std::optional<int64_t> CompiledFootprint(
+    const PjRtLoadedExecutable& executable) {
+  absl::StatusOr<CompiledMemoryStats> stats =
+      executable.GetCompiledMemoryStats();
+  if (!stats.ok()) {
+    return std::nullopt;
+  }
+  return stats->argument_size_in_bytes + stats->output_size_in_bytes -
+         stats->alias_size_in_bytes + stats->temp_size_in_bytes;
+}
+
+}  // namespace
+
+std::string LlmServingBenchmarkResult::ToString() const {
+  return absl::StrFormat(
+      "time to first token: %s, mean token latency: %s, p99 token latency: "
+      "%s, tokens/s: %.1f, peak memory: %s",
+      absl::FormatDuration(time_to_first_token),
+      absl::FormatDuration(mean_token_latency),
+      absl::FormatDuration(p99_token_latency), tokens_per_second,
+      peak_memory_bytes.has_value() ? absl::StrCat(*peak_memory_bytes, " bytes")
+                                    : "unknown");
+}
+
+std::string GetTransformerStepHloText(const LlmServingBenchmarkOptions& options,
+                                      int64_t num_tokens) {
+  std::vector<std::string> aliases;
+  std::vector<std::string> cache_shapes;
+  std::vector<std::string> caches;
+  std::string layers;
+  for (int64_t i = 0; i < options.num_layers; ++i) {
+    int64_t first_parameter = kNumGlobalParameters + i * kNumLayerParameters;
+    std::vector<std::pair<std::string, std::string>> replacements = {
+        {"$L", absl::StrCat(i)}, {"$NEXT", absl::StrCat(i + 1)}};
+    for (int64_t j = 0; j < kNumLayerParameters; ++j) {
+      replacements.push_back(
+          {absl::StrCat("$P", j), absl::StrCat(first_parameter + j)});
+    }
+    absl::StrAppend(&layers, absl::StrReplaceAll(kStepLayer, replacements));
+
+    for (int64_t j : {0, 1}) {
+      aliases.push_back(
+          absl::StrFormat("{%d}: (%d, {}, may-alias)", 1 + 2 * i + j,
+                          first_parameter + kNumLayerWeights + j));
+      cache_shapes.push_back("f32[$B,$S,$H]");
+    }
+    caches.push_back(absl::StrCat("l", i, "_k_cache_new"));
+    caches.push_back(absl::StrCat("l", i, "_v_cache_new"));
+  }
+
+  std::string hlo = absl::StrCat(
+      absl::StrReplaceAll(kStepHeader,
+                          {{"$ALIASES", absl::StrJoin(aliases, ", ")}}),
+      layers,
+      absl::StrReplaceAll(kStepFooter,
+                          {{"$CACHE_SHAPES", absl::StrJoin(cache_shapes, ", ")},
+                           {"$CACHES", absl::StrJoin(caches, ", ")}}));
+
+  return absl::StrReplaceAll(
+      hlo, {{"$B", absl::StrCat(options.batch_size)},
+            {"$T", absl::StrCat(num_tokens)},
+            {"$S", absl::StrCat(MaxSequenceLength(options))},
+            {"$H", absl::StrCat(options.hidden_size)},
+            {"$F", absl::StrCat(options.ffn_size)},
+            {"$V", absl::StrCat(options.vocab_size)},
+            {"$N", absl::StrCat(options.num_layers)},
+            {"$LAST", absl::StrCat(num_tokens - 1)},
+            {"$SCALE", absl::StrCat(1.0 / std::sqrt(options.hidden_size))}});
+}
+
+absl::StatusOr<LlmServingBenchmarkResult> RunLlmServingBenchmark(
+    PjRtClient* client, const LlmServingBenchmarkOptions& options) {
+  TF_RETURN_IF_ERROR(ValidateOptions(options));
+
+  PjRtDevice* device = client->addressable_devices().front();
+  TF_ASSIGN_OR_RETURN(PjRtMemorySpace * memory_space,
+                      device->default_memory_space());
+
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtLoadedExecutable> prefill,
+                      CompileStep(client, options, options.prompt_length));
+  TF_ASSIGN_OR_RETURN(std::unique_ptr<PjRtLoadedExecutable> decode,
+                      CompileStep(client, options, /*num_tokens=*/1));
+
+  LlmServer server(client, device, memory_space, options, prefill.get(),
+                   decode.get());
+  TF_RETURN_IF_ERROR(server.Initialize());
+  for (int64_t i = 0; i < options.num_warmup_requests; ++i) {
+    TF_RETURN_IF_ERROR(server.Serve().status());
+  }
+  TF_ASSIGN_OR_RETURN(LlmServingBenchmarkResult result, server.Serve());
+
+  if (absl::StatusOr<tsl::AllocatorStats> stats = device->GetAllocatorStats();
+      stats.ok()) {
+    result.peak_memory_bytes = stats->peak_bytes_in_use;
+  } else {
+    std::optional<int64_t> prefill_footprint = CompiledFootprint(*prefill);
+    std::optional<int64_t> decode_footprint = CompiledFootprint(*decode);
+    if (prefill_footprint.has_value() && decode_footprint.has_value()) {
+      result.peak_memory_bytes =
+          std::max(*prefill_footprint, *decode_footprint);
+    }
+  }
+  return result;
+}
+
+}  // namespace xla
@@ -0,0 +1,82 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef XLA_TOOLS_LLM_SERVING_BENCHMARK_H_
+#define XLA_TOOLS_LLM_SERVING_BENCHMARK_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "absl/status/statusor.h"
+#include "absl/time/time.h"
+#include "xla/pjrt/pjrt_client.h"
+
+namespace xla {
+
+// Configuration of a synthetic decoder-only transformer and of the request
+// that is served with it.
+struct LlmServingBenchmarkOptions {
+  int64_t batch_size = 1;
+  int64_t prompt_length = 128;
+  int64_t num_decode_steps = 32;
+
+  int64_t num_layers = 2;
+  int64_t hidden_size = 256;
+  int64_t ffn_size = 1024;
+  int64_t vocab_size = 1024;
+
+  // Number of untimed requests served before the measured one.
+  int64_t num_warmup_requests = 1;
+};
+
+struct LlmServingBenchmarkResult {
+  // Time from submitting the prompt to having the first generated token on
+  // the host, i.e. the prefill latency.
+  absl::Duration time_to_first_token;
+  // Mean and 99th percentile latency of a single decode step.
+  absl::Duration mean_token_latency;
+  absl::Duration p99_token_latency;
+  // Generated tokens per second during decode, across the whole batch.
+  double tokens_per_second = 0;
+  // Peak device memory in use, from the device allocator if it keeps stats or
+  // else the largest compiled memory footprint of the prefill and decode
+  // programs.
+  std::optional<int64_t> peak_memory_bytes;
+
+  std::string ToString() const;
+};
+
+// Returns the HLO text of one step of the transformer that processes
+// `num_tokens` tokens per sequence starting at a position passed as a
+// parameter, and updates the KV caches in place. Prefill uses
+// `num_tokens = prompt_length` and decode uses `num_tokens = 1`.
+//
+// Parameters: tokens s32[batch, num_tokens], position s32[], the embedding
+// table, and for every layer its six weights followed by its K and V caches.
+// Returns a tuple of the logits of the last token and the updated caches.
+std::string GetTransformerStepHloText(const LlmServingBenchmarkOptions& options,
+                                      int64_t num_tokens);
+
+// Serves a request with a prefill step followed by `num_decode_steps` decode
+// steps on the first addressable device of `client`. Generated tokens are
+// picked greedily on the host, like an inference server that samples on the
+// host would do.
+absl::StatusOr<LlmServingBenchmarkResult> RunLlmServingBenchmark(
+    PjRtClient* client, const LlmServingBenchmarkOptions& options);
+
+}  // namespace xla
+
+#endif  // XLA_TOOLS_LLM_SERVING_BENCHMARK_H_
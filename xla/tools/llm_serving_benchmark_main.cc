@@ -0,0 +1,110 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// A tool for benchmarking prefill and decode of a synthetic transformer
+// through PjRt.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "xla/debug_options_flags.h"
+#include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/plugin/xla_cpu/cpu_client_options.h"
+#include "xla/pjrt/plugin/xla_cpu/xla_cpu_pjrt_client.h"
+#include "xla/tools/llm_serving_benchmark.h"
+#include "xla/tsl/util/command_line_flags.h"
+#include "tsl/platform/init_main.h"
+
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+#include "xla/pjrt/plugin/xla_gpu/xla_gpu_client_options.h"
+#include "xla/pjrt/plugin/xla_gpu/xla_gpu_pjrt_client.h"
+#endif
+
+namespace {
+
+const char* const kUsage = R"(
+    This tool serves a request with a synthetic decoder-only transformer
+    through PjRt and reports end-to-end serving metrics.
+
+    Usage:
+
+      bazel run llm_serving_benchmark_main -- --platform=cpu --prompt_length=128
+
+    Output:
+      time to first token: 12.3ms, mean token latency: 1.2ms, ...
+    )";
+
+absl::StatusOr<std::unique_ptr<xla::PjRtClient>> GetClient(
+    const std::string& platform) {
+  if (platform == "cpu") {
+    return xla::GetXlaPjrtCpuClient(xla::CpuClientOptions());
+  }
+#if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
+  if (platform == "gpu") {
+    return xla::GetXlaPjrtGpuClient(xla::GpuClientOptions());
+  }
+#endif
+  return absl::InvalidArgumentError(
+      absl::StrCat("Unsupported platform: ", platform));
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::string platform = "cpu";
+  xla::LlmServingBenchmarkOptions options;
+  std::vector<tsl::Flag> flag_list = {
+      tsl::Flag("platform", &platform, "cpu or gpu"),
+      tsl::Flag("batch_size", &options.batch_size, "sequences per request"),
+      tsl::Flag("prompt_length", &options.prompt_length,
+                "tokens processed by prefill"),
+      tsl::Flag("num_decode_steps", &options.num_decode_steps,
+                "tokens generated by decode"),
+      tsl::Flag("num_layers", &options.num_layers, "transformer layers"),
+      tsl::Flag("hidden_size", &options.hidden_size, "model dimension"),
+      tsl::Flag("ffn_size", &options.ffn_size, "feed-forward dimension"),
+      tsl::Flag("vocab_size", &options.vocab_size, "vocabulary size"),
+      tsl::Flag("num_warmup_requests", &options.num_warmup_requests,
+                "untimed requests served first"),
+  };
+  xla::AppendDebugOptionsFlags(&flag_list);
+  const std::string usage_string =
+      absl::StrCat(kUsage, "\n\n", tsl::Flags::Usage(argv[0], flag_list));
+  bool parse_ok = tsl::Flags::Parse(&argc, argv, flag_list);
+  tsl::port::InitMain(usage_string.c_str(), &argc, &argv);
+
+  if (!parse_ok) {
+    LOG(QFATAL) << usage_string;
+  }
+
+  absl::StatusOr<std::unique_ptr<xla::PjRtClient>> client = GetClient(platform);
+  if (!client.ok()) {
+    LOG(ERROR) << client.status();
+    return 1;
+  }
+  absl::StatusOr<xla::LlmServingBenchmarkResult> result =
+      xla::RunLlmServingBenchmark(client->get(), options);
+  if (!result.ok()) {
+    LOG(ERROR) << result.status();
+    return 1;
+  }
+  LOG(INFO) << result->ToString();
+  return 0;
+}
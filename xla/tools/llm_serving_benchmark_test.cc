@@ -0,0 +1,81 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tools/llm_serving_benchmark.h"
+
+#include <memory>
+
+#include <gtest/gtest.h>
+#include "absl/time/time.h"
+#include "xla/hlo/ir/hlo_input_output_alias_config.h"
+#include "xla/hlo/ir/hlo_module.h"
+#include "xla/hlo/parser/hlo_parser.h"
+#include "xla/pjrt/plugin/xla_cpu/cpu_client_options.h"
+#include "xla/pjrt/plugin/xla_cpu/xla_cpu_pjrt_client.h"
+#include "xla/tsl/platform/statusor.h"
+
+namespace xla {
+namespace {
+
+LlmServingBenchmarkOptions TinyModel() {
+  LlmServingBenchmarkOptions options;
+  options.batch_size = 2;
+  options.prompt_length = 4;
+  options.num_decode_steps = 3;
+  options.num_layers = 2;
+  options.hidden_size = 8;
+  options.ffn_size = 16;
+  options.vocab_size = 32;
+  return options;
+}
+
+TEST(LlmServingBenchmarkTest, StepAliasesKvCaches) {
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<HloModule> module,
+      ParseAndReturnUnverifiedModule(
+          GetTransformerStepHloText(TinyModel(), /*num_tokens=*/1)));
+
+  // Tokens, position, embedding and 8 parameters per layer.
+  EXPECT_EQ(module->entry_computation()->num_parameters(), 3 + 2 * 8);
+  const HloInputOutputAliasConfig& aliases =
+      module->input_output_alias_config();
+  ASSERT_TRUE(aliases.GetAliasedParameter({1}).has_value());
+  EXPECT_EQ(aliases.GetAliasedParameter({1})->parameter_number, 9);
+  ASSERT_TRUE(aliases.GetAliasedParameter({4}).has_value());
+  EXPECT_EQ(aliases.GetAliasedParameter({4})->parameter_number, 18);
+}
+
+TEST(LlmServingBenchmarkTest, ServesRequestOnCpu) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetXlaPjrtCpuClient(CpuClientOptions()));
+  TF_ASSERT_OK_AND_ASSIGN(LlmServingBenchmarkResult result,
+                          RunLlmServingBenchmark(client.get(), TinyModel()));
+
+  EXPECT_GT(result.time_to_first_token, absl::ZeroDuration());
+  EXPECT_GT(result.mean_token_latency, absl::ZeroDuration());
+  EXPECT_GE(result.p99_token_latency, result.mean_token_latency);
+  EXPECT_GT(result.tokens_per_second, 0);
+  ASSERT_TRUE(result.peak_memory_bytes.has_value());
+  EXPECT_GT(*result.peak_memory_bytes, 0);
+}
+
+TEST(LlmServingBenchmarkTest, RejectsInvalidOptions) {
+  TF_ASSERT_OK_AND_ASSIGN(auto client, GetXlaPjrtCpuClient(CpuClientOptions()));
+  LlmServingBenchmarkOptions options = TinyModel();
+  options.num_decode_steps = 0;
+  EXPECT_FALSE(RunLlmServingBenchmark(client.get(), options).ok());
+}
+
+}  // namespace
+}  // namespace xla
@@ -30,12 +30,14 @@ limitations under the License.
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "mlir/Dialect/Func/Extensions/AllExtensions.h"
 #include "xla/client/executable_build_options.h"
@@ -1579,4 +1581,68 @@ const tensorflow::profiler::XSpace* GPURunnerProfiler::GetXSpace() {
   return xspace_.get();
 }
 
+std::string ExecutionTimeStats::ToString() const {
+  return absl::StrFormat("repeats=%d min=%s median=%s mean=%s max=%s",
+                         num_timed_repeats, absl::FormatDuration(min),
+                         absl::FormatDuration(median),
+                         absl::FormatDuration(mean), absl::FormatDuration(max));
+}
+
+absl::StatusOr<ExecutionTimeStats> ComputeExecutionTimeStats(
+    absl::Span<const ExecutionProfile> execution_profiles,
+    int64_t num_warmup_repeats) {
+  if (num_warmup_repeats < 0 ||
+      num_warmup_repeats >=
+          static_cast<int64_t>(execution_profiles.size())) {
+    return InvalidArgument(
+        "Expected fewer warmup repeats than profiled repeats, got %d warmup "
+        "repeats and %d profiles",
+        num_warmup_repeats, execution_profiles.size());
+  }
+
+  std::vector<absl::Duration> times;
+  times.reserve(execution_profiles.size() - num_warmup_repeats);
+  for (const ExecutionProfile& profile :
+       execution_profiles.subspan(num_warmup_repeats)) {
+    times.push_back(absl::Nanoseconds(profile.compute_time_ns()));
+  }
+  absl::c_sort(times);
+
+  ExecutionTimeStats stats;
+  stats.num_timed_repeats = times.size();
+  stats.min = times.front();
+  stats.max = times.back();
+  stats.median = times[times.size() / 2];
+  if (times.size() % 2 == 0) {
+    stats.median = (stats.median + times[times.size() / 2 - 1]) / 2;
+  }
+  for (absl::Duration time : times) {
+    stats.mean += time;
+  }
+  stats.mean /= static_cast<int64_t>(times.size());
+  return stats;
+}
+
+absl::StatusOr<std::vector<absl::Duration>> ExchangeMedianExecutionTimes(
+    KeyValueStoreInterface& kv_store, absl::string_view key, int task_id,
+    int num_nodes, absl::Duration median, absl::Duration timeout) {
+  TF_RETURN_IF_ERROR(
+      kv_store.Set(absl::StrCat(key, "/", task_id),
+                   absl::StrCat(absl::ToInt64Nanoseconds(median))));
+
+  std::vector<absl::Duration> medians;
+  medians.reserve(num_nodes);
+  for (int i = 0; i < num_nodes; ++i) {
+    TF_ASSIGN_OR_RETURN(std::string value,
+                        kv_store.Get(absl::StrCat(key, "/", i), timeout));
+    int64_t median_ns;
+    if (!absl::SimpleAtoi(value, &median_ns)) {
+      return Internal("Invalid median execution time of task %d: %s", i,
+                      value);
+    }
+    medians.push_back(absl::Nanoseconds(median_ns));
+  }
+  return medians;
+}
+
 }  // namespace xla
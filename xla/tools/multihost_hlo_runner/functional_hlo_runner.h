@@ -29,6 +29,7 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xla/client/executable_build_options.h"
 #include "xla/hlo/ir/hlo_module.h"
@@ -502,6 +503,32 @@ std::string AbslUnparseFlag(FunctionalHloRunner::ModuleOutputMode output_mode);
 
 void AddShardingAnnotationsToSpmdPartitionedModule(HloModule* hlo_module);
 
+// Statistics of the execution times of the timed repeats of a run.
+struct ExecutionTimeStats {
+  int64_t num_timed_repeats = 0;
+  absl::Duration min;
+  absl::Duration median;
+  absl::Duration mean;
+  absl::Duration max;
+
+  std::string ToString() const;
+};
+
+// Computes statistics of the device execution times (`compute_time_ns`) of
+// `execution_profiles`, one per repeat, ignoring the first
+// `num_warmup_repeats` of them.
+absl::StatusOr<ExecutionTimeStats> ComputeExecutionTimeStats(
+    absl::Span<const ExecutionProfile> execution_profiles,
+    int64_t num_warmup_repeats);
+
+// Publishes the `median` execution time of task `task_id` in `kv_store` under
+// `key` and returns the median execution times of all `num_nodes` tasks,
+// indexed by task id. Waits up to `timeout` for the other tasks to publish
+// theirs, so every task of a multi-host run has to call it.
+absl::StatusOr<std::vector<absl::Duration>> ExchangeMedianExecutionTimes(
+    KeyValueStoreInterface& kv_store, absl::string_view key, int task_id,
+    int num_nodes, absl::Duration median, absl::Duration timeout);
+
 }  // namespace xla
 
 #endif  // XLA_TOOLS_MULTIHOST_HLO_RUNNER_FUNCTIONAL_HLO_RUNNER_H_
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "xla/tools/multihost_hlo_runner/functional_hlo_runner.h"
 
+#include <cstdint>
 #include <cstdlib>
 #include <memory>
 #include <random>
@@ -33,6 +34,7 @@ limitations under the License.
 #include "xla/debug_options_flags.h"
 #include "xla/hlo/testlib/filecheck.h"
 #include "xla/pjrt/pjrt_client.h"
+#include "xla/pjrt/distributed/in_memory_key_value_store.h"
 #include "xla/pjrt/pjrt_executable.h"
 #include "xla/pjrt/plugin/xla_gpu/xla_gpu_client_options.h"
 #include "xla/runtime/large_hlo_snapshot_serialization/serialization.h"
@@ -666,6 +668,42 @@ TEST_F(FunctionalHloRunnerTest, FixFakeArguments) {
       /*arguments=*/{}, /*engine=*/&engine));
 }
 
+ExecutionProfile ProfileWithComputeTime(int64_t compute_time_ns) {
+  ExecutionProfile profile;
+  profile.set_compute_time_ns(compute_time_ns);
+  return profile;
+}
+
+TEST(FunctionalHloRunnerTest, ComputeExecutionTimeStatsSkipsWarmup) {
+  std::vector<ExecutionProfile> profiles = {
+      ProfileWithComputeTime(1000), ProfileWithComputeTime(40),
+      ProfileWithComputeTime(10), ProfileWithComputeTime(30),
+      ProfileWithComputeTime(20)};
+  TF_ASSERT_OK_AND_ASSIGN(ExecutionTimeStats stats,
+                          ComputeExecutionTimeStats(profiles,
+                                                    /*num_warmup_repeats=*/1));
+  EXPECT_EQ(stats.num_timed_repeats, 4);
+  EXPECT_EQ(stats.min, absl::Nanoseconds(10));
+  EXPECT_EQ(stats.median, absl::Nanoseconds(25));
+  EXPECT_EQ(stats.mean, absl::Nanoseconds(25));
+  EXPECT_EQ(stats.max, absl::Nanoseconds(40));
+
+  EXPECT_FALSE(ComputeExecutionTimeStats(profiles, /*num_warmup_repeats=*/5)
+                   .ok());
+}
+
+TEST(FunctionalHloRunnerTest, ExchangeMedianExecutionTimes) {
+  InMemoryKeyValueStore kv_store;
+  TF_ASSERT_OK(kv_store.Set("medians/1", "300"));
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::vector<absl::Duration> medians,
+      ExchangeMedianExecutionTimes(kv_store, "medians", /*task_id=*/0,
+                                   /*num_nodes=*/2, absl::Nanoseconds(100),
+                                   absl::Seconds(1)));
+  EXPECT_THAT(medians, ::testing::ElementsAre(absl::Nanoseconds(100),
+                                              absl::Nanoseconds(300)));
+}
+
 TEST(FunctionalHloRunnerTest, TestHloUnoptimizedSnapshotDeSerialization) {
   std::string path_to_text_hlo =
       GetHloPath("sharded_unoptimized_hlo_snapshot.pbtxt");
@@ -23,6 +23,7 @@ limitations under the License.
 #include <string>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
@@ -99,6 +100,7 @@ struct HloRunnerConfig {
   bool remove_infeed_outfeed = true;
   bool compile_as_stablehlo = false;
   int32_t num_repeats = 1;
+  int32_t num_warmup_repeats = 1;
   std::string execution_options_path = "";
   int64_t gpu_client_initialization_timeout_sec = 300;
   float gpu_client_mem_fraction = xla::GpuAllocatorConfig{}.memory_fraction;
@@ -288,6 +290,33 @@ static absl::Status RunMultihostHloRunner(int argc, char** argv,
                 << " duration=" << execution_profiles[i].compute_time_ns()
                 << "ns" << std::endl;
     }
+    if (static_cast<int64_t>(execution_profiles.size()) >
+        opts.num_warmup_repeats) {
+      TF_ASSIGN_OR_RETURN(ExecutionTimeStats stats,
+                          ComputeExecutionTimeStats(execution_profiles,
+                                                    opts.num_warmup_repeats));
+      std::cout << "## Execution time summary, file=" << hlo_file
+                << " task=" << opts.task_id << " " << stats.ToString()
+                << std::endl;
+      if (opts.num_nodes > 1 && env.kv_store != nullptr) {
+        TF_ASSIGN_OR_RETURN(
+            std::vector<absl::Duration> medians,
+            ExchangeMedianExecutionTimes(
+                *env.kv_store, absl::StrCat("hlo_runner_median/", c),
+                opts.task_id, opts.num_nodes, stats.median,
+                absl::Seconds(opts.gpu_client_initialization_timeout_sec)));
+        for (int i = 0; i < medians.size(); ++i) {
+          std::cout << "## Median execution time, file=" << hlo_file
+                    << " task=" << i
+                    << " median=" << absl::FormatDuration(medians[i])
+                    << std::endl;
+        }
+        auto [fastest, slowest] = absl::c_minmax_element(medians);
+        std::cout << "## Cross-host skew, file=" << hlo_file
+                  << " skew=" << absl::FormatDuration(*slowest - *fastest)
+                  << std::endl;
+      }
+    }
   }
   return absl::OkStatus();
 }
@@ -357,6 +386,11 @@ int main(int argc, char** argv) {
                 "PjRt for compilation."),
       tsl::Flag("num_repeats", &opts.num_repeats,
                 "Repeatedly execute the HLO for this many times."),
+      tsl::Flag("num_warmup_repeats", &opts.num_warmup_repeats,
+                "Number of initial repeats excluded from the execution time "
+                "summary printed with --profile_execution. With "
+                "--num_nodes > 1 the summary includes the median of every "
+                "task and the cross-host skew."),
       tsl::Flag("execution_options_path", &opts.execution_options_path,
                 "A path to a protobuf text file which stores the "
                 "ExecutionOptions message for this HLO module."),
@@ -27,9 +27,12 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/ascii.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/str_cat.h"
+#include "absl/strings/str_split.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/mutex.h"
+#include "absl/types/span.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/IR/BuiltinOps.h"
@@ -56,6 +59,7 @@ limitations under the License.
 #include "xla/service/symbol_repository.h"
 #include "xla/service/xla_compile_result.pb.h"
 #include "xla/shape.h"
+#include "xla/stream_executor/device_description.pb.h"
 #include "xla/stream_executor/platform_manager.h"
 #include "xla/stream_executor/stream_executor.h"
 #include "xla/stream_executor/stream_executor_memory_allocator.h"
@@ -132,6 +136,80 @@ static absl::StatusOr<std::string> CompileGpuExecutable(
   return executables[0]->module().ToString();
 }
 
+// Returns a string identifying the compute capability of `device_info`, or an
+// empty string if it has none.
+static std::string ComputeCapabilityKey(
+    const stream_executor::GpuDeviceInfoProto& device_info) {
+  switch (device_info.compute_capability_case()) {
+    case stream_executor::GpuDeviceInfoProto::kCudaComputeCapability:
+      return absl::StrCat(
+          "cuda:", device_info.cuda_compute_capability().major(), ".",
+          device_info.cuda_compute_capability().minor());
+    case stream_executor::GpuDeviceInfoProto::kRocmComputeCapability:
+      return absl::StrCat(
+          "rocm:", device_info.rocm_compute_capability().gcn_arch_name());
+    default:
+      return "";
+  }
+}
+
+absl::StatusOr<std::string> CompileMultiTargetGpuExecutable(
+    std::unique_ptr<HloModule> hlo_module,
+    absl::Span<const Compiler::TargetConfig> target_configs,
+    CompilationResult& result) {
+  if (target_configs.empty()) {
+    return absl::InvalidArgumentError("At least one target is required");
+  }
+  MultiTargetAotCompilationResult executables;
+  absl::flat_hash_set<std::string> compute_capabilities;
+  for (const Compiler::TargetConfig& target_config : target_configs) {
+    stream_executor::GpuDeviceInfoProto device_info =
+        target_config.device_description.ToGpuProto();
+    std::string compute_capability = ComputeCapabilityKey(device_info);
+    if (compute_capability.empty()) {
+      return absl::InvalidArgumentError(
+          "GpuTargetConfig does not specify a compute capability");
+    }
+    if (!compute_capabilities.insert(compute_capability).second) {
+      return absl::InvalidArgumentError(absl::StrCat(
+          "Duplicate target for compute capability ", compute_capability));
+    }
+
+    // HLO optimizations on GPU depend on the target, so every target starts
+    // from the unoptimized module.
+    CompilationResult target_result;
+    TF_ASSIGN_OR_RETURN(
+        std::string aot_result,
+        CompileGpuExecutable(hlo_module->Clone(/*suffix=*/""), target_config,
+                             target_result));
+    if (!result.has_hlo_module()) {
+      *result.mutable_hlo_module() =
+          std::move(*target_result.mutable_hlo_module());
+    }
+
+    MultiTargetAotCompilationResult::Target* target =
+        executables.add_targets();
+    *target->mutable_gpu_device_info() = std::move(device_info);
+    target->set_aot_compilation_result(std::move(aot_result));
+  }
+  return executables.SerializeAsString();
+}
+
+absl::StatusOr<absl::string_view> SelectTargetAotCompilationResult(
+    const MultiTargetAotCompilationResult& executables,
+    const stream_executor::GpuDeviceInfoProto& device_info) {
+  std::string compute_capability = ComputeCapabilityKey(device_info);
+  for (const MultiTargetAotCompilationResult::Target& target :
+       executables.targets()) {
+    if (ComputeCapabilityKey(target.gpu_device_info()) == compute_capability) {
+      return target.aot_compilation_result();
+    }
+  }
+  return absl::NotFoundError(
+      absl::StrCat("No executable was compiled for compute capability ",
+                   compute_capability));
+}
+
 absl::StatusOr<std::string> CompileExecutable(
     std::unique_ptr<HloModule> hlo_module, BackendType backend,
     std::optional<Compiler::TargetConfig> target_config,
@@ -218,6 +296,20 @@ ReadModuleFromSymbolRepo(absl::string_view symbol_repo,
   return mod;
 }
 
+static absl::StatusOr<Compiler::TargetConfig> ReadGpuTargetConfig(
+    absl::string_view gpu_target_config_path) {
+  std::string gpu_target_config_string;
+  TF_RETURN_IF_ERROR(tsl::ReadFileToString(tsl::Env::Default(),
+                                           std::string(gpu_target_config_path),
+                                           &gpu_target_config_string));
+  stream_executor::GpuTargetConfigProto gpu_target_config_proto;
+  if (!tsl::protobuf::TextFormat::ParseFromString(gpu_target_config_string,
+                                                  &gpu_target_config_proto)) {
+    return FailedPrecondition("Failed to parse GpuTargetConfigProto");
+  }
+  return Compiler::TargetConfig(gpu_target_config_proto);
+}
+
 static std::unique_ptr<Compiler::TargetConfig> ReadTargetConfigFromModule(
     HloModuleAndMetadata* mod, BackendType backend) {
   if (backend == BackendType::kGpu) {
@@ -307,24 +399,26 @@ absl::Status XlaCompileMain(const XlaCompileOptions& options) {
   });
   // Run AOT compilation.
   std::optional<Compiler::TargetConfig> cfg = std::nullopt;
+  // Only set when compiling for more than one target.
+  std::vector<Compiler::TargetConfig> multi_target_configs;
   if (backend == BackendType::kGpu) {
     if (absl::string_view gpu_target_config_path =
             options.gpu_options.gpu_target_config_path;
         !gpu_target_config_path.empty()) {
-      // Parse GpuTargetConfig.
-      std::string gpu_target_config_string;
-      TF_RETURN_IF_ERROR(tsl::ReadFileToString(
-          tsl::Env::Default(), std::string(gpu_target_config_path),
-          &gpu_target_config_string));
-      stream_executor::GpuTargetConfigProto gpu_target_config_proto;
-
-      if (!tsl::protobuf::TextFormat::ParseFromString(
-              gpu_target_config_string, &gpu_target_config_proto)) {
-        return FailedPrecondition("Failed to parse GpuTargetConfigProto");
+      for (absl::string_view path :
+           absl::StrSplit(gpu_target_config_path, ',', absl::SkipEmpty())) {
+        TF_ASSIGN_OR_RETURN(Compiler::TargetConfig config,
+                            ReadGpuTargetConfig(path));
+        multi_target_configs.push_back(std::move(config));
+      }
+      if (multi_target_configs.empty()) {
+        return absl::InvalidArgumentError("No GpuTargetConfig path given");
       }
-
       target_config =
-          std::make_unique<Compiler::TargetConfig>(gpu_target_config_proto);
+          std::make_unique<Compiler::TargetConfig>(multi_target_configs[0]);
+      if (multi_target_configs.size() == 1) {
+        multi_target_configs.clear();
+      }
 
       if (absl::string_view autotune_results_path =
               options.gpu_options.autotune_results_path;
@@ -339,8 +433,13 @@ absl::Status XlaCompileMain(const XlaCompileOptions& options) {
               ? std::nullopt
               : std::make_optional(*std::move(target_config));
   }
-  auto result = CompileExecutable(std::move(hlo_module), backend,
-                                  std::move(cfg), compilation_result);
+  absl::StatusOr<std::string> result =
+      multi_target_configs.empty() || options.gpu_options.use_attached_device
+          ? CompileExecutable(std::move(hlo_module), backend, std::move(cfg),
+                              compilation_result)
+          : CompileMultiTargetGpuExecutable(std::move(hlo_module),
+                                            multi_target_configs,
+                                            compilation_result);
   *compilation_result.mutable_status() = tsl::StatusToProto(result.status());
   if (!result.ok()) {
     return result.status();
@@ -23,10 +23,12 @@ limitations under the License.
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/span.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/service/compiler.h"
 #include "xla/service/symbol_repository.h"
 #include "xla/service/xla_compile_result.pb.h"
+#include "xla/stream_executor/device_description.pb.h"
 #include "xla/util.h"
 
 namespace xla {
@@ -43,6 +45,22 @@ absl::StatusOr<std::string> CompileExecutable(
     std::optional<Compiler::TargetConfig> target_config,
     CompilationResult& result);
 
+// Compiles the provided module ahead of time for each of the given GPU targets
+// and returns a serialized MultiTargetAotCompilationResult holding one
+// executable per target. Targets must have distinct compute capabilities. The
+// post-optimization module for the first target is stored in the result.
+absl::StatusOr<std::string> CompileMultiTargetGpuExecutable(
+    std::unique_ptr<HloModule> hlo_module,
+    absl::Span<const Compiler::TargetConfig> target_configs,
+    CompilationResult& result);
+
+// Returns the serialized AotCompilationResult in `executables` that was
+// compiled for the compute capability of `device_info`, ready to be passed to
+// Compiler::LoadAotCompilationResult.
+absl::StatusOr<absl::string_view> SelectTargetAotCompilationResult(
+    const MultiTargetAotCompilationResult& executables,
+    const stream_executor::GpuDeviceInfoProto& device_info);
+
 // Merges the measured duration into compilation_result and writes
 // compilation_result to result_output_file in the wire format.
 absl::Status WriteResultFile(absl::string_view result_output_file,
@@ -70,6 +88,8 @@ struct XlaCompileOptions {
 
   // GPU-specific options.
   struct GpuOptions {
+    // A comma-separated list of paths. With more than one target, the output
+    // file holds a serialized MultiTargetAotCompilationResult.
     std::string gpu_target_config_path;
     bool use_attached_device = false;
     std::string autotune_results_path;
@@ -17,12 +17,15 @@ limitations under the License.
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/status/status.h"
 #include "xla/hlo/ir/hlo_module.h"
 #include "xla/service/gpu/autotuning/autotuner_util.h"
 #include "xla/service/gpu/gpu_symbol_repository.h"
+#include "xla/service/compiler.h"
 #include "xla/service/platform_util.h"
 #include "xla/service/symbol_repository.h"
 #include "xla/service/xla_compile_result.pb.h"
@@ -45,6 +48,7 @@ namespace {
 using ::testing::IsEmpty;
 using ::testing::Not;
 using ::tsl::testing::IsOkAndHolds;
+using ::tsl::testing::StatusIs;
 
 class XlaCompileLibTest : public HloTestBase {
  protected:
@@ -84,6 +88,59 @@ TEST_F(XlaCompileLibTest, CompilesForGpuWithoutDevice) {
   EXPECT_TRUE(result.has_hlo_module()) << result.DebugString();
 }
 
+TEST_F(XlaCompileLibTest, CompilesForMultipleGpuTargets) {
+  const std::string target_config_path =
+      tsl::io::JoinPath(tsl::testing::XlaSrcRoot(), "service",
+                        "xla_aot_compile_test_gpu_target_config.prototxt");
+  stream_executor::GpuTargetConfigProto target_config;
+  TF_ASSERT_OK(tsl::ReadTextProto(tsl::Env::Default(), target_config_path,
+                                  &target_config));
+  stream_executor::GpuTargetConfigProto other_target_config = target_config;
+  other_target_config.mutable_gpu_device_info()
+      ->mutable_cuda_compute_capability()
+      ->set_major(7);
+
+  std::vector<Compiler::TargetConfig> target_configs;
+  target_configs.emplace_back(target_config);
+  target_configs.emplace_back(other_target_config);
+  CompilationResult result;
+  TF_ASSERT_OK_AND_ASSIGN(
+      std::string serialized,
+      CompileMultiTargetGpuExecutable(std::move(module_), target_configs,
+                                      result));
+  EXPECT_TRUE(result.has_hlo_module()) << result.DebugString();
+
+  MultiTargetAotCompilationResult executables;
+  ASSERT_TRUE(executables.ParseFromString(serialized));
+  ASSERT_EQ(executables.targets_size(), 2);
+  EXPECT_THAT(SelectTargetAotCompilationResult(
+                  executables, other_target_config.gpu_device_info()),
+              IsOkAndHolds(executables.targets(1).aot_compilation_result()));
+
+  stream_executor::GpuDeviceInfoProto unknown_device =
+      target_config.gpu_device_info();
+  unknown_device.mutable_cuda_compute_capability()->set_major(5);
+  EXPECT_THAT(SelectTargetAotCompilationResult(executables, unknown_device),
+              StatusIs(absl::StatusCode::kNotFound));
+}
+
+TEST_F(XlaCompileLibTest, MultipleGpuTargetsMustDiffer) {
+  const std::string target_config_path =
+      tsl::io::JoinPath(tsl::testing::XlaSrcRoot(), "service",
+                        "xla_aot_compile_test_gpu_target_config.prototxt");
+  stream_executor::GpuTargetConfigProto target_config;
+  TF_ASSERT_OK(tsl::ReadTextProto(tsl::Env::Default(), target_config_path,
+                                  &target_config));
+
+  std::vector<Compiler::TargetConfig> target_configs;
+  target_configs.emplace_back(target_config);
+  target_configs.emplace_back(target_config);
+  CompilationResult result;
+  EXPECT_THAT(CompileMultiTargetGpuExecutable(std::move(module_),
+                                              target_configs, result),
+              StatusIs(absl::StatusCode::kInvalidArgument));
+}
+
 TEST_F(XlaCompileLibTest, MainForGpu) {
   const std::string module_file =
       tsl::io::JoinPath(tsl::testing::TmpDir(), "module.txt");
@@ -21,6 +21,7 @@ limitations under the License.
 #include <limits>
 #include <utility>
 
+#include "absl/algorithm/container.h"
 #include "absl/base/optimization.h"
 #include "absl/container/inlined_vector.h"
 #include "absl/functional/any_invocable.h"
@@ -70,11 +71,39 @@ void AsyncValue::NotifyAvailable(State available_state) {
 }
 
 void AsyncValue::RunWaiters(WaiterListNode* list) {
+  // Waiters bound to an executor are collected into per-executor batches, so
+  // that executor can schedule all of them at once. In practice all waiters
+  // use the same executor, so we optimize for a single batch.
+  struct Batch {
+    Executor* executor;
+    absl::InlinedVector<Executor::Task, 4> tasks;
+  };
+  absl::InlinedVector<Batch, 1> batches;
+
   while (list) {
     WaiterListNode* node = list;
-    (*node)();
     list = node->next;
-    delete node;
+
+    if (ABSL_PREDICT_TRUE(node->executor == nullptr)) {
+      (*node)();
+      delete node;
+      continue;
+    }
+
+    auto batch = absl::c_find_if(batches, [&](const Batch& candidate) {
+      return candidate.executor == node->executor;
+    });
+    if (batch == batches.end()) {
+      batch = &batches.emplace_back(Batch{node->executor, {}});
+    }
+    batch->tasks.push_back([node] {
+      (*node)();
+      delete node;
+    });
+  }
+
+  for (Batch& batch : batches) {
+    batch.executor->ExecuteBatch(absl::MakeSpan(batch.tasks));
   }
 }
 
@@ -94,8 +123,8 @@ void AsyncValue::EnqueueWaiterListNode(WaiterListNode* waiter,
     if (waiters_and_state.state() == State::kConcrete ||
         waiters_and_state.state() == State::kError) {
       DCHECK(waiters_and_state.waiter() == nullptr);
-      (*waiter)();
-      delete waiter;
+      waiter->next = nullptr;
+      RunWaiters(waiter);
       return;
     }
     // Update the waiter to point to the new head of the waiter list.
@@ -269,6 +269,14 @@ class AsyncValue {
     virtual ~Executor() = default;
 
     virtual void Execute(Task task) = 0;
+
+    // Executes a batch of tasks that became ready at the same time, i.e. all
+    // waiters of an async value that were bound to this executor. By default
+    // every task is executed individually, executors that can more efficiently
+    // schedule (or run) multiple tasks at once can override this method.
+    virtual void ExecuteBatch(absl::Span<Task> tasks) {
+      for (Task& task : tasks) Execute(std::move(task));
+    }
   };
 
  protected:
@@ -376,6 +384,11 @@ class AsyncValue {
     virtual void operator()() = 0;
 
     WaiterListNode* next = nullptr;
+
+    // If not null, the waiter must be invoked on the given executor. When the
+    // async value becomes available, all waiters bound to the same executor are
+    // passed to it as a single batch.
+    Executor* executor = nullptr;
   };
 
   // The waiter list and the state are compacted into one single atomic word as
@@ -483,7 +496,8 @@ class AsyncValue {
                              WaitersAndState waiters_and_state);
 
   template <typename Waiter>
-  void EnqueueWaiter(Waiter&& waiter, WaitersAndState waiters_and_state) {
+  void EnqueueWaiter(Waiter&& waiter, WaitersAndState waiters_and_state,
+                     Executor* executor = nullptr) {
     static_assert(std::is_invocable_v<Waiter>, "Waiter must be invocable");
 
     struct Node final : public WaiterListNode {
@@ -492,8 +506,9 @@ class AsyncValue {
       Waiter waiter;
     };
 
-    EnqueueWaiterListNode(new Node{std::forward<Waiter>(waiter)},
-                          waiters_and_state);
+    auto* node = new Node{std::forward<Waiter>(waiter)};
+    node->executor = executor;
+    EnqueueWaiterListNode(node, waiters_and_state);
   }
 
   // This is a global counter of the number of AsyncValue instances currently
@@ -1034,11 +1049,7 @@ void AsyncValue::AndThen(Executor& executor, Waiter&& waiter) {
     return;
   }
 
-  EnqueueWaiter(
-      [&executor, waiter = std::forward<Waiter>(waiter)] {
-        executor.Execute(std::move(waiter));
-      },
-      waiters_and_state);
+  EnqueueWaiter(std::forward<Waiter>(waiter), waiters_and_state, &executor);
 }
 
 inline void AsyncValue::Destroy() {
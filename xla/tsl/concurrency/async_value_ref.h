@@ -1263,6 +1263,25 @@ AsyncValueOwningRef<T> MakeAvailableAsyncValueRef(
           std::forward<Args>(args)...));
 }
 
+// Returns an available AsyncValueRef holding a default-constructed `T` from a
+// per-process storage with a static duration. Returned async value is not
+// reference counted, so it can be returned from hot paths that complete
+// synchronously without a heap allocation or an atomic reference count update.
+// It can be safely compared using pointer equality.
+//
+// Because the value is shared by all callers, it should be used only for
+// stateless types (i.e. events like tsl::Chain) that are never mutated.
+template <typename T>
+AsyncValueRef<T> GetAvailableAsyncValueRefSingleton() {
+  static_assert(std::is_empty_v<T>,
+                "Available async value singleton must be a stateless type");
+  static AsyncValueOwningRef<T>* singleton = [] {
+    auto* storage = new internal::AsyncValueStorage<T>();
+    return new AsyncValueOwningRef<T>(MakeAvailableAsyncValueRef<T>(*storage));
+  }();
+  return singleton->AsRef();
+}
+
 }  // namespace tsl
 
 #endif  // XLA_TSL_CONCURRENCY_ASYNC_VALUE_REF_H_
@@ -66,6 +66,19 @@ TEST(AsyncValueRefTest, MakeAvailableStatusOr) {
   EXPECT_EQ(**value, 42);
 }
 
+TEST(AsyncValueRefTest, AvailableSingleton) {
+  struct Event {};
+
+  AsyncValueRef<Event> event0 = GetAvailableAsyncValueRefSingleton<Event>();
+  AsyncValueRef<Event> event1 = GetAvailableAsyncValueRefSingleton<Event>();
+  EXPECT_TRUE(event0.IsConcrete());
+  EXPECT_EQ(event0.GetAsyncValue(), event1.GetAsyncValue());
+
+  // Singleton is not reference counted, and taking copies is a no-op.
+  AsyncValueRef<Event> event2 = event0;
+  EXPECT_EQ(event0.GetAsyncValue()->NumRef(), 1);
+}
+
 TEST(AsyncValueRefTest, ImplicitStatusConversion) {
   auto error = []() -> AsyncValueRef<WrappedInt32> {
     return absl::InternalError("Error");
@@ -493,6 +506,31 @@ TEST(AsyncValueRefTest, MakeAsyncValueRef) {
   }
 }
 
+TEST(AsyncValueRefTest, AndThenOnExecutorIsBatched) {
+  struct BatchingExecutor : public DeferredExecutor {
+    void ExecuteBatch(absl::Span<Task> batch) final {
+      ++num_batches;
+      for (Task& task : batch) Execute(std::move(task));
+    }
+    size_t num_batches = 0;
+  };
+
+  AsyncValueRef<int32_t> ref = MakeConstructedAsyncValueRef<int32_t>(42);
+
+  BatchingExecutor executor;
+  std::atomic<int32_t> counter = 0;
+  for (size_t i = 0; i < 10; ++i) {
+    ref.AndThen(executor, [&] { ++counter; });
+  }
+  ref.AndThen([&] { ++counter; });
+
+  ref.SetStateConcrete();
+  EXPECT_EQ(counter, 1);
+  EXPECT_EQ(executor.num_batches, 1);
+  EXPECT_EQ(executor.Quiesce(), 10);
+  EXPECT_EQ(counter, 11);
+}
+
 TEST(AsyncValueRefTest, MapAvailableOnExecutor) {
   AsyncValueRef<int32_t> ref = MakeAvailableAsyncValueRef<int32_t>(42);
 
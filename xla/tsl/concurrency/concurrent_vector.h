@@ -22,6 +22,7 @@ limitations under the License.
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <new>
 #include <vector>
 
 #include "absl/synchronization/mutex.h"
@@ -152,11 +153,21 @@ class ConcurrentVector {
     uint64_t Encode() const { return (size << 32) | last_allocated; }
   };
 
+  // Keep the state read by all readers and the mutex contended by writers in
+  // separate cache lines, so that writers waiting on the mutex do not
+  // invalidate the state cache line on every read.
+  static constexpr size_t kAtomicAlignment =
+#if defined(__cpp_lib_hardware_interference_size)
+      std::hardware_destructive_interference_size;
+#else
+      64;
+#endif
+
   // Stores/loads to/from this atomic used to enforce happens-before
   // relationship between emplace_back and operator[].
-  std::atomic<uint64_t> state_;
+  alignas(kAtomicAlignment) std::atomic<uint64_t> state_;
 
-  absl::Mutex mutex_;
+  alignas(kAtomicAlignment) absl::Mutex mutex_;
 
   // ConcurrentVector does not support inserting more than 2^64 elements,
   // which should be more than enough for any reasonable use case.
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "xla/tsl/platform/env.h"
 #include "xla/tsl/platform/test.h"
+#include "xla/tsl/platform/test_benchmark.h"
 #include "xla/tsl/platform/threadpool.h"
 
 namespace tsl {
@@ -101,4 +102,45 @@ TEST(ConcurrentVectorTest, TwoWritersTwoReaders) {
   pool.Schedule(reader);
 }
 
+//===----------------------------------------------------------------------===//
+// Performance benchmarks below
+//===----------------------------------------------------------------------===//
+
+static void BM_EmplaceBack(benchmark::State& state) {
+  static ConcurrentVector<int64_t>* vec = nullptr;
+  if (state.thread_index() == 0) vec = new ConcurrentVector<int64_t>(1);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vec->emplace_back(42));
+  }
+
+  if (state.thread_index() == 0) {
+    delete vec;
+    vec = nullptr;
+  }
+}
+
+// ConcurrentVector never frees previously allocated buffers, so we bound the
+// number of iterations to keep memory usage under control.
+BENCHMARK(BM_EmplaceBack)
+    ->ThreadRange(1, 8)
+    ->Iterations(1 << 18)
+    ->UseRealTime();
+
+static void BM_Read(benchmark::State& state) {
+  static ConcurrentVector<int64_t>* vec = [] {
+    auto* vec = new ConcurrentVector<int64_t>(1);
+    for (int64_t i = 0; i < 1024; ++i) vec->emplace_back(i);
+    return vec;
+  }();
+
+  size_t index = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize((*vec)[index]);
+    index = (index + 1) % vec->size();
+  }
+}
+
+BENCHMARK(BM_Read)->ThreadRange(1, 8)->UseRealTime();
+
 }  // namespace tsl
@@ -16,6 +16,7 @@ limitations under the License.
 #include "xla/tsl/framework/allocator_retry.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <optional>
 
@@ -69,6 +70,7 @@ void* AllocatorRetry::AllocateRaw(
   absl::Time deadline;
   bool first = true;
   while (true) {
+    uint64_t num_deallocs = num_deallocs_.load();
     if (void* ptr = alloc_func(alignment, num_bytes, false); ptr != nullptr) {
       return ptr;
     }
@@ -81,7 +83,13 @@ void* AllocatorRetry::AllocateRaw(
     if (now < deadline) {
       tracker.Enable();
       absl::MutexLock l(&mu_);
-      memory_returned_.WaitWithDeadline(&mu_, deadline);
+      // Register as a waiter before re-checking for deallocations, so that a
+      // concurrent NotifyDealloc() either is seen here or sees us and signals.
+      num_waiters_.fetch_add(1);
+      while (num_deallocs_.load() == num_deallocs &&
+             !memory_returned_.WaitWithDeadline(&mu_, deadline)) {
+      }
+      num_waiters_.fetch_sub(1);
     } else {
       return alloc_func(alignment, num_bytes, true);
     }
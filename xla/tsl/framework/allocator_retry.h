@@ -16,7 +16,9 @@ limitations under the License.
 #ifndef XLA_TSL_FRAMEWORK_ALLOCATOR_RETRY_H_
 #define XLA_TSL_FRAMEWORK_ALLOCATOR_RETRY_H_
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 
 #include "absl/base/thread_annotations.h"
@@ -51,10 +53,20 @@ class AllocatorRetry {
   Env* env_;
   absl::Mutex mu_;
   absl::CondVar memory_returned_ ABSL_GUARDED_BY(mu_);
+
+  // Number of deallocations so far, and number of threads waiting for one.
+  // Together they let NotifyDealloc() skip `mu_` when nobody is waiting, which
+  // is the common case and keeps deallocation off a second global lock.
+  std::atomic<uint64_t> num_deallocs_{0};
+  std::atomic<int64_t> num_waiters_{0};
 };
 
 // Implementation details below
 inline void AllocatorRetry::NotifyDealloc() {
+  num_deallocs_.fetch_add(1);
+  if (num_waiters_.load() == 0) {
+    return;
+  }
   absl::MutexLock l(&mu_);
   memory_returned_.SignalAll();
 }
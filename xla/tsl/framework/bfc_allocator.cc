@@ -580,7 +580,7 @@ void* BFCAllocator::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
     Bin* b = BinFromIndex(bin_num);
     for (auto citer = b->free_chunks.begin(); citer != b->free_chunks.end();
          ++citer) {
-      const BFCAllocator::ChunkHandle h = (*citer);
+      BFCAllocator::ChunkHandle h = (*citer);
       BFCAllocator::Chunk* chunk = ChunkFromHandle(h);
       DCHECK(!chunk->in_use());
       if (freed_before > 0 && freed_before < chunk->freed_at_count) {
@@ -603,7 +603,18 @@ void* BFCAllocator::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
         if (chunk->size >= rounded_bytes * 2 ||
             static_cast<int64_t>(chunk->size) - rounded_bytes >=
                 max_internal_fragmentation_bytes) {
-          SplitChunk(h, rounded_bytes);
+          if (rounded_bytes <= opts_.small_allocation_threshold) {
+            // Carve small allocations from the end of the free chunk, so they
+            // pack together at the top of the region instead of splitting the
+            // large free chunks used by big allocations.
+            SplitChunk(h, chunk->size - rounded_bytes);
+            ChunkHandle h_tail = ChunkFromHandle(h)->next;
+            RemoveFreeChunkFromBin(h_tail);
+            InsertFreeChunkIntoBin(h);
+            h = h_tail;
+          } else {
+            SplitChunk(h, rounded_bytes);
+          }
           chunk = ChunkFromHandle(h);  // Update chunk pointer in case it moved
         }
 
@@ -1209,6 +1220,7 @@ MemoryDump BFCAllocator::RecordMemoryMapInternal() {
   }
 
   mas->set_fragmentation_metric(GetFragmentation());
+  mas->set_largest_free_chunk_size(LargestFreeChunk());
 
 #ifdef TENSORFLOW_MEM_DEBUG
   // Record the recent size history
@@ -1227,7 +1239,9 @@ MemoryDump BFCAllocator::RecordMemoryMapInternal() {
 
 std::optional<AllocatorStats> BFCAllocator::GetStats() {
   absl::MutexLock l(&mutex_);
-  return stats_;
+  AllocatorStats stats = stats_;
+  stats.largest_free_block_bytes = LargestFreeChunk();
+  return stats;
 }
 
 bool BFCAllocator::ClearStats() {
@@ -73,6 +73,12 @@ class BFCAllocator : public Allocator {
     // Controls when a chunk should be split, if its size exceeds the requested
     // allocation size.
     double fragmentation_fraction = 0;
+
+    // Allocations of at most this many bytes (after rounding) are carved from
+    // the end of a free chunk rather than its start. This keeps small,
+    // frequent allocations away from the large contiguous free space needed
+    // by big allocations in long-running processes. 0 disables it.
+    size_t small_allocation_threshold = 0;
   };
   BFCAllocator(std::unique_ptr<SubAllocator> sub_allocator, size_t total_memory,
                const string& name, const Options& opts);
@@ -146,6 +146,12 @@ class ServingDeviceSelector {
 
   virtual ~ServingDeviceSelector() = default;
 
+  // Helper to estimate the time until the core becomes idle in nanoseconds.
+  // Only considers queues with priority at least as high as 'priority'.
+  static int64_t EstimateTimeTillIdleNs(const DeviceState& device_state,
+                                        int32_t priority, int64_t min_exec_time,
+                                        int64_t now_ns);
+
   // Reserves a device according to a given selection policy. The reserved
   // device will be freed when the lifetime of the returned `DeviceReservation`
   // object ends.
@@ -183,11 +189,6 @@ class ServingDeviceSelector {
                               int32_t priority,
                               std::optional<int64_t>& min_exec_time,
                               bool had_error, int64_t now_ns);
-  // Helper to estimate the time until the core becomes idle in nanoseconds.
-  // Only considers queues with priority at least as high as 'priority'.
-  static int64_t EstimateTimeTillIdleNs(const DeviceState& device_state,
-                                        int32_t priority, int64_t min_exec_time,
-                                        int64_t now_ns);
 
  private:
   friend DeviceReservation;
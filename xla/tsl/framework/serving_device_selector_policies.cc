@@ -15,8 +15,11 @@ limitations under the License.
 #include "xla/tsl/framework/serving_device_selector_policies.h"
 
 #include <atomic>
+#include <cstdint>
+#include <limits>
 
 #include "absl/strings/string_view.h"
+#include "absl/time/clock.h"
 #include "xla/tsl/framework/serving_device_selector.h"
 
 namespace tsl {
@@ -28,4 +31,40 @@ int RoundRobinPolicy::SelectDevice(
   return ordinal_.fetch_add(1, std::memory_order_relaxed) % num_devices;
 }
 
+int LeastExpectedTimeTillIdlePolicy::SelectDevice(
+    absl::string_view program_fingerprint,
+    const ServingDeviceSelector::DeviceStates& device_states) {
+  const int num_devices = device_states.states.size();
+  const int start =
+      ordinal_.fetch_add(1, std::memory_order_relaxed) % num_devices;
+  const int64_t now_ns = absl::GetCurrentTimeNanos();
+
+  int best_device = start;
+  int64_t best_time_till_idle_ns = std::numeric_limits<int64_t>::max();
+  int64_t best_num_programs = std::numeric_limits<int64_t>::max();
+  for (int i = 0; i < num_devices; ++i) {
+    const int device = (start + i) % num_devices;
+    const ServingDeviceSelector::DeviceState& state =
+        device_states.states[device];
+    // Programs of all priorities occupy the device.
+    const int32_t lowest_priority = state.enqueued_programs.size() - 1;
+    const int64_t time_till_idle_ns =
+        ServingDeviceSelector::EstimateTimeTillIdleNs(
+            state, lowest_priority, /*min_exec_time=*/0, now_ns);
+    int64_t num_programs = state.unknown_fingerprint_requests;
+    for (int32_t p = 0; p <= lowest_priority; ++p) {
+      num_programs += state.enqueued_programs[p].size() +
+                      state.scheduled_programs[p].size();
+    }
+    if (time_till_idle_ns < best_time_till_idle_ns ||
+        (time_till_idle_ns == best_time_till_idle_ns &&
+         num_programs < best_num_programs)) {
+      best_device = device;
+      best_time_till_idle_ns = time_till_idle_ns;
+      best_num_programs = num_programs;
+    }
+  }
+  return best_device;
+}
+
 }  // namespace tsl
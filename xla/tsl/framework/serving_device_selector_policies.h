@@ -16,13 +16,16 @@ limitations under the License.
 #define XLA_TSL_FRAMEWORK_SERVING_DEVICE_SELECTOR_POLICIES_H_
 
 #include <atomic>
+#include <cstdint>
 
+#include "absl/strings/string_view.h"
 #include "xla/tsl/framework/serving_device_selector.h"
 
 namespace tsl {
 
 enum class ServingDeviceSelectorPolicy {
   kRoundRobin,
+  kLeastExpectedTimeTillIdle,
 };
 
 class RoundRobinPolicy : public ServingDeviceSelector::Policy {
@@ -37,6 +40,22 @@ class RoundRobinPolicy : public ServingDeviceSelector::Policy {
   std::atomic<uint64_t> ordinal_;
 };
 
+// Selects the device expected to become idle first, using the running average
+// execution time of every queued program. Ties, e.g. between idle devices, are
+// broken by the number of queued programs and then round robin, so that load
+// still spreads evenly before execution times are known.
+class LeastExpectedTimeTillIdlePolicy : public ServingDeviceSelector::Policy {
+ public:
+  LeastExpectedTimeTillIdlePolicy() : ordinal_(0) {}
+
+  int SelectDevice(
+      absl::string_view program_fingerprint,
+      const ServingDeviceSelector::DeviceStates& device_states) override;
+
+ private:
+  std::atomic<uint64_t> ordinal_;
+};
+
 }  // namespace tsl
 
 #endif  // XLA_TSL_FRAMEWORK_SERVING_DEVICE_SELECTOR_POLICIES_H_
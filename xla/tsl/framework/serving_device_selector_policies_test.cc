@@ -0,0 +1,97 @@
+/* Copyright 2025 The OpenXLA Authors.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "xla/tsl/framework/serving_device_selector_policies.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include "absl/time/clock.h"
+#include "xla/tsl/framework/serving_device_selector.h"
+
+namespace tsl {
+namespace {
+
+using DeviceState = ServingDeviceSelector::DeviceState;
+
+DeviceState IdleDeviceState() {
+  DeviceState state;
+  state.unknown_fingerprint_requests = 0;
+  return state;
+}
+
+void Enqueue(DeviceState& state,
+             const ServingDeviceSelector::ExecutionInfo* execution_info) {
+  state.enqueued_programs[0].push_back(
+      {"fingerprint", /*priority=*/0, /*req_id=*/-1, execution_info,
+       /*prefetch_results=*/0});
+  state.last_started_ns = absl::GetCurrentTimeNanos();
+}
+
+TEST(RoundRobinPolicyTest, CyclesThroughDevices) {
+  std::vector<DeviceState> states(3, IdleDeviceState());
+  ServingDeviceSelector::DeviceStates device_states{states};
+  RoundRobinPolicy policy;
+  EXPECT_EQ(policy.SelectDevice("fp", device_states), 0);
+  EXPECT_EQ(policy.SelectDevice("fp", device_states), 1);
+  EXPECT_EQ(policy.SelectDevice("fp", device_states), 2);
+  EXPECT_EQ(policy.SelectDevice("fp", device_states), 0);
+}
+
+TEST(LeastExpectedTimeTillIdlePolicyTest, PrefersDeviceWithLessQueuedWork) {
+  ServingDeviceSelector::ExecutionInfo slow;
+  slow.AddTime(int64_t{1} << 40, 0);
+  ServingDeviceSelector::ExecutionInfo fast;
+  fast.AddTime(int64_t{1} << 30, 0);
+
+  std::vector<DeviceState> states(3, IdleDeviceState());
+  Enqueue(states[0], &slow);
+  Enqueue(states[1], &fast);
+  Enqueue(states[1], &fast);
+  Enqueue(states[2], &slow);
+  ServingDeviceSelector::DeviceStates device_states{states};
+
+  LeastExpectedTimeTillIdlePolicy policy;
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(policy.SelectDevice("fp", device_states), 1);
+  }
+}
+
+TEST(LeastExpectedTimeTillIdlePolicyTest, BreaksTiesByQueueLength) {
+  // Programs without a recorded execution time contribute no expected time.
+  ServingDeviceSelector::ExecutionInfo unknown;
+
+  std::vector<DeviceState> states(2, IdleDeviceState());
+  Enqueue(states[0], &unknown);
+  states[1].unknown_fingerprint_requests = 2;
+  ServingDeviceSelector::DeviceStates device_states{states};
+
+  LeastExpectedTimeTillIdlePolicy policy;
+  EXPECT_EQ(policy.SelectDevice("fp", device_states), 0);
+  EXPECT_EQ(policy.SelectDevice("fp", device_states), 0);
+}
+
+TEST(LeastExpectedTimeTillIdlePolicyTest, SpreadsLoadAcrossIdleDevices) {
+  std::vector<DeviceState> states(3, IdleDeviceState());
+  ServingDeviceSelector::DeviceStates device_states{states};
+  LeastExpectedTimeTillIdlePolicy policy;
+  EXPECT_EQ(policy.SelectDevice("fp", device_states), 0);
+  EXPECT_EQ(policy.SelectDevice("fp", device_states), 1);
+  EXPECT_EQ(policy.SelectDevice("fp", device_states), 2);
+}
+
+}  // namespace
+}  // namespace tsl